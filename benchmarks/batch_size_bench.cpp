@@ -0,0 +1,142 @@
+/**
+ * @brief Chosen vs fixed DEFAULT_VECTOR_SIZE batch size over pipelines of 1 to 256 columns.
+ *
+ * Every pipeline is scan -> filter -> projection (col + col for every column) -> SUM per column,
+ * over the same number of bytes, so wider pipelines have fewer rows. The fixed and the chosen
+ * size take turns for a few runs each, and the fastest run of each is reported. From 32 columns on
+ * both run DEFAULT_VECTOR_SIZE, their spread shows the noise of the machine.
+ *
+ * Usage: batch_size_bench [threads] [megabytes]
+ */
+
+#include "electricdb/execution/engine/pipeline_builder.h"
+#include "electricdb/execution/expressions/binary_expression.h"
+#include "electricdb/execution/expressions/leaf_expression.h"
+#include "electricdb/execution/operators/aggregate/hash_aggregate.h"
+#include "electricdb/execution/operators/filter/filter.h"
+#include "electricdb/execution/operators/out/out.h"
+#include "electricdb/execution/operators/projection/projection.h"
+#include "electricdb/execution/operators/scan/scan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace electricdb;
+
+static constexpr int RUNS = 15;
+
+/** @brief scan -> filter -> projection -> SUM over every INT64 column of `table` */
+struct Plan {
+	explicit Plan(const std::vector<Vector> &table) : scan(table) {
+		const size_t columns = table.size() - 1;
+		std::vector<LogicalType> types(columns, LogicalType::INT64);
+		types.push_back(LogicalType::BOOL);
+
+		flag = std::make_unique<ColumnExpr>(static_cast<uint32_t>(columns), LogicalType::BOOL);
+		filter = std::make_unique<PhysicalFilter>(types, flag.get());
+		filter->AddChild(&scan);
+
+		std::vector<Expression *> projections;
+		std::vector<AggregateSpec> sums;
+		for (uint32_t c = 0; c < columns; c++) {
+			Expression *column =
+					owned.emplace_back(std::make_unique<ColumnExpr>(c, LogicalType::INT64)).get();
+			projections.push_back(
+					owned.emplace_back(std::make_unique<AddExpr>(column, column)).get());
+			sums.push_back({AggregateType::SUM, c});
+		}
+		projection = std::make_unique<PhysicalProjection>(projections);
+		projection->AddChild(filter.get());
+
+		aggregate = std::make_unique<PhysicalHashAggregate>(projection->Types(),
+															std::vector<uint32_t>{}, sums);
+		aggregate->AddChild(projection.get());
+		result = std::make_unique<PhysicalResultCollector>(aggregate->Types());
+		result->AddChild(aggregate.get());
+	}
+
+	/**
+	 * @brief Run the plan once and return its time in milliseconds
+	 *
+	 * @param batch_size Batch size for every pipeline, 0 to let each pipeline choose
+	 * @param chosen Batch size the scan pipeline ran with
+	 */
+	double Run(Scheduler &scheduler, uint32_t batch_size, uint32_t &chosen) {
+		PipelineBuilder builder(*result);
+		if (batch_size)
+			for (const auto &pipeline : builder.Pipelines())
+				pipeline->SetBatchSize(batch_size);
+
+		const auto start = std::chrono::steady_clock::now();
+		builder.Execute(scheduler);
+		const auto end = std::chrono::steady_clock::now();
+
+		chosen = builder.Pipelines()[0]->BatchSize();
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	PhysicalColumnScan scan;
+	std::unique_ptr<ColumnExpr> flag;
+	std::unique_ptr<PhysicalFilter> filter;
+	std::vector<std::unique_ptr<Expression>> owned;
+	std::unique_ptr<PhysicalProjection> projection;
+	std::unique_ptr<PhysicalHashAggregate> aggregate;
+	std::unique_ptr<PhysicalResultCollector> result;
+};
+
+int main(int argc, char **argv) {
+	const uint32_t threads = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 0;
+	const size_t megabytes = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 512;
+	Scheduler scheduler(threads);
+
+	std::printf("threads=%u data=%zuMB\n", scheduler.WorkerCount(), megabytes);
+	std::printf("%8s %10s %12s %12s %8s %8s\n", "columns", "rows", "fixed_ms", "chosen_ms", "chosen",
+				"speedup");
+
+	for (size_t columns : {1, 2, 4, 8, 16, 32, 64, 128, 256}) {
+		const auto rows = static_cast<uint32_t>((megabytes << 20) / (columns * sizeof(int64_t)));
+
+		Arena arena;
+		std::vector<Vector> table;
+		for (size_t c = 0; c < columns; c++) {
+			Vector &vec = table.emplace_back(LogicalType::INT64, rows, arena);
+			vec.SetSize(rows);
+			for (uint32_t i = 0; i < rows; i++)
+				vec.Data<int64_t>()[i] = static_cast<int64_t>(i ^ c);
+		}
+		Vector &flag = table.emplace_back(LogicalType::BOOL, rows, arena);
+		flag.SetSize(rows);
+		for (uint32_t i = 0; i < rows; i++)
+			flag.Data<bool>()[i] = (i * 2654435761u) % 10 < 7;
+
+		/**
+		 * Alternate the two sizes, and which of them runs first, so that noise from other
+		 * processes and warm caches hit both alike
+		 */
+		Plan plan(table);
+		uint32_t fixed_size = 0;
+		uint32_t chosen_size = 0;
+		double fixed = 0;
+		double chosen = 0;
+		for (int run = 0; run < RUNS; run++) {
+			double fixed_ms = 0;
+			double chosen_ms = 0;
+			if (run % 2 == 0) {
+				fixed_ms = plan.Run(scheduler, DEFAULT_VECTOR_SIZE, fixed_size);
+				chosen_ms = plan.Run(scheduler, 0, chosen_size);
+			} else {
+				chosen_ms = plan.Run(scheduler, 0, chosen_size);
+				fixed_ms = plan.Run(scheduler, DEFAULT_VECTOR_SIZE, fixed_size);
+			}
+			fixed = run == 0 ? fixed_ms : std::min(fixed, fixed_ms);
+			chosen = run == 0 ? chosen_ms : std::min(chosen, chosen_ms);
+		}
+		std::printf("%8zu %10u %12.2f %12.2f %8u %7.2fx\n", columns, rows, fixed, chosen,
+					chosen_size, fixed / chosen);
+	}
+	return 0;
+}
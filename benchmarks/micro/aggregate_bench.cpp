@@ -0,0 +1,60 @@
+#include "bench_util.h"
+#include "electricdb/execution/operators/aggregate/hash_aggregate.h"
+
+#include <benchmark/benchmark.h>
+
+namespace electricdb {
+
+/** @brief A batch of (key, value) with range(0) distinct keys, and the dictionary of the keys */
+struct GroupedBatch {
+	explicit GroupedBatch(benchmark::State &state)
+		: dictionary(LogicalType::INT64, static_cast<uint32_t>(state.range(0)), arena),
+		  codes(arena, BENCH_ROWS) {
+		const auto distinct = static_cast<uint32_t>(state.range(0));
+		dictionary.SetSize(distinct);
+		for (uint32_t i = 0; i < distinct; i++)
+			dictionary.Data<int64_t>()[i] = int64_t{1000003} * i;
+
+		chunk.emplace_back(LogicalType::INT64, BENCH_ROWS, arena);
+		chunk.emplace_back(LogicalType::INT64, BENCH_ROWS, arena);
+		FillRandom<int64_t>(chunk[1], 0, 1);
+		std::mt19937_64 rng(7);
+		chunk[0].SetSize(BENCH_ROWS);
+		for (idx_t i = 0; i < BENCH_ROWS; i++) {
+			codes.Set(i, rng() % distinct);
+			chunk[0].Data<int64_t>()[i] = dictionary.Data<int64_t>()[codes.Get(i)];
+		}
+	}
+
+	Arena arena;
+	Vector dictionary;
+	SelectionVector codes;
+	std::vector<Vector> chunk;
+};
+
+static void RunSink(benchmark::State &state, const std::vector<Vector> &chunk) {
+	PhysicalHashAggregate aggregate({LogicalType::INT64, LogicalType::INT64}, {0},
+									{{AggregateType::SUM, 1}, {AggregateType::COUNT_STAR}});
+	ExecutionContext ctx;
+	auto local = aggregate.InitLocalSink();
+	for (auto _ : state)
+		aggregate.Sink(ctx, *local, chunk);
+	state.SetItemsProcessed(state.iterations() * BENCH_ROWS);
+}
+
+/** @brief GROUP BY a flat INT64 column, every row hashes and probes its key */
+static void BM_HashAggregateGroupByValues(benchmark::State &state) {
+	GroupedBatch batch(state);
+	RunSink(state, batch.chunk);
+}
+BENCHMARK(BM_HashAggregateGroupByValues)->Arg(20)->Arg(1000);
+
+/** @brief The same GROUP BY on a dictionary vector, only distinct codes probe */
+static void BM_HashAggregateGroupByCodes(benchmark::State &state) {
+	GroupedBatch batch(state);
+	batch.chunk[0].ReferenceDictionary(batch.dictionary, batch.codes.Data(), BENCH_ROWS);
+	RunSink(state, batch.chunk);
+}
+BENCHMARK(BM_HashAggregateGroupByCodes)->Arg(20)->Arg(1000);
+
+} // namespace electricdb
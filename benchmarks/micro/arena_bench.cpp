@@ -0,0 +1,47 @@
+#include "electricdb/util/arena.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+
+namespace electricdb {
+
+/** @brief Bump allocations of range(0) bytes, resetting the arena every 1024 allocations */
+static void BM_ArenaAllocate(benchmark::State &state) {
+	const auto size = static_cast<size_t>(state.range(0));
+	Arena arena;
+	uint32_t allocations = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(arena.Allocate(size));
+		if (++allocations == 1024) {
+			arena.Reset();
+			allocations = 0;
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ArenaAllocate)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+/** @brief The same pattern served by malloc/free, for comparison */
+static void BM_MallocFree(benchmark::State &state) {
+	const auto size = static_cast<size_t>(state.range(0));
+	for (auto _ : state) {
+		void *ptr = std::malloc(size);
+		benchmark::DoNotOptimize(ptr);
+		std::free(ptr);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MallocFree)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+/** @brief Allocations above the block size, which get a block of their own */
+static void BM_ArenaAllocateOversized(benchmark::State &state) {
+	Arena arena(4096);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(arena.Allocate(static_cast<size_t>(state.range(0))));
+		arena.Reset();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ArenaAllocateOversized)->Arg(8192)->Arg(1 << 20);
+
+} // namespace electricdb
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "electricdb/common/constants.h"
+#include "electricdb/execution/vector/vector.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace electricdb {
+
+/** @brief Rows per benchmarked batch, the engine's default vector size */
+constexpr idx_t BENCH_ROWS = DEFAULT_VECTOR_SIZE;
+
+/**
+ * @brief Fill `vec` with BENCH_ROWS random non-zero values, about `null_percent` of them null
+ *
+ */
+template <typename T>
+void FillRandom(Vector &vec, int64_t null_percent, uint64_t seed) {
+	std::mt19937_64 rng(seed);
+	std::uniform_int_distribution<int> percent(0, 99);
+	vec.SetSize(BENCH_ROWS);
+	vec.ClearNulls();
+	T *data = vec.Data<T>();
+	for (idx_t i = 0; i < BENCH_ROWS; i++) {
+		data[i] = static_cast<T>(rng() % 1000 + 1);
+		if (percent(rng) < null_percent)
+			vec.SetNull(i);
+	}
+}
+
+/**
+ * @brief Ascending positions of about `percent` of `count` rows, chosen at random
+ *
+ */
+inline std::vector<sel_t> RandomSelection(idx_t count, int64_t percent, uint64_t seed) {
+	std::mt19937_64 rng(seed);
+	std::uniform_int_distribution<int> draw(0, 99);
+	std::vector<sel_t> rows;
+	for (idx_t i = 0; i < count; i++) {
+		if (draw(rng) < percent)
+			rows.push_back(i);
+	}
+	return rows;
+}
+
+/**
+ * @brief Copy `rows` into a selection vector allocated in `arena`, sized to the selected rows
+ *
+ */
+inline SelectionVector MakeSelection(Arena &arena, const std::vector<sel_t> &rows) {
+	SelectionVector sel(arena, static_cast<idx_t>(rows.size()));
+	for (idx_t i = 0; i < rows.size(); i++)
+		sel.Set(i, rows[i]);
+	return sel;
+}
+
+} // namespace electricdb
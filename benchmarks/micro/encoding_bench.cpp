@@ -0,0 +1,195 @@
+#include "electricdb/common/constants.h"
+#include "electricdb/execution/operators/aggregate/aggregate.h"
+#include "electricdb/storage/encoding/delta.h"
+#include "electricdb/storage/encoding/dictionary.h"
+#include "electricdb/storage/encoding/for.h"
+#include "electricdb/storage/encoding/plain.h"
+#include "electricdb/storage/encoding/rle.h"
+#include "electricdb/util/arena.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace electricdb {
+
+/** @brief Values per decoded chunk, a row group */
+static constexpr uint32_t CHUNK_ROWS = DEFAULT_ROW_GROUP_SIZE;
+
+/** @brief INT64 chunk of random values below 2^width above a large reference */
+static Vector RandomChunk(Arena &arena, unsigned width) {
+	std::mt19937_64 rng(7);
+	Vector vec(LogicalType::INT64, CHUNK_ROWS, arena);
+	vec.SetSize(CHUNK_ROWS);
+	const uint64_t mask = width >= 64 ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+	for (uint32_t i = 0; i < CHUNK_ROWS; i++)
+		vec.Data<int64_t>()[i] = static_cast<int64_t>((uint64_t{1} << 40) + (rng() & mask));
+	return vec;
+}
+
+/** @brief Memcpy of the plain values, the floor of any decode */
+static void BM_PlainDecode(benchmark::State &state) {
+	Arena arena;
+	const Vector vec = RandomChunk(arena, 64);
+	std::vector<uint64_t> encoded(CHUNK_ROWS);
+	PlainEncoding::Encode(vec, reinterpret_cast<uint8_t *>(encoded.data()));
+	Vector out(LogicalType::INT64, CHUNK_ROWS, arena);
+	for (auto _ : state) {
+		PlainEncoding::Decode(reinterpret_cast<uint8_t *>(encoded.data()), CHUNK_ROWS, out);
+		benchmark::DoNotOptimize(out.RawData());
+	}
+	state.SetItemsProcessed(state.iterations() * CHUNK_ROWS);
+	state.SetBytesProcessed(state.iterations() * CHUNK_ROWS * int64_t{sizeof(int64_t)});
+}
+BENCHMARK(BM_PlainDecode);
+
+/** @brief Unpack a frame-of-reference chunk, range(0) is the bit width */
+static void BM_ForDecode(benchmark::State &state) {
+	Arena arena;
+	const Vector vec = RandomChunk(arena, static_cast<unsigned>(state.range(0)));
+	std::vector<uint64_t> encoded((ForEncoding::EncodedSize(vec) + 7) / 8);
+	ForEncoding::Encode(vec, reinterpret_cast<uint8_t *>(encoded.data()));
+	Vector out(LogicalType::INT64, CHUNK_ROWS, arena);
+	for (auto _ : state) {
+		ForEncoding::Decode(reinterpret_cast<uint8_t *>(encoded.data()), CHUNK_ROWS, out);
+		benchmark::DoNotOptimize(out.RawData());
+	}
+	state.SetItemsProcessed(state.iterations() * CHUNK_ROWS);
+	/** Decoded bytes, comparable with BM_PlainDecode */
+	state.SetBytesProcessed(state.iterations() * CHUNK_ROWS * int64_t{sizeof(int64_t)});
+}
+BENCHMARK(BM_ForDecode)->Arg(0)->Arg(3)->Arg(8)->Arg(17)->Arg(32)->Arg(45)->Arg(64);
+
+/**
+ * @brief Decode a chunk of timestamps one second apart with up to range(0) microseconds of
+ * jitter: unpack the differences and prefix-sum them
+ */
+static void BM_DeltaDecode(benchmark::State &state) {
+	Arena arena;
+	std::mt19937_64 rng(7);
+	Vector vec(LogicalType::INT64, CHUNK_ROWS, arena);
+	vec.SetSize(CHUNK_ROWS);
+	const auto jitter = static_cast<uint64_t>(state.range(0)) + 1;
+	for (uint32_t i = 0; i < CHUNK_ROWS; i++)
+		vec.Data<int64_t>()[i] = 1700000000000000 + int64_t{1000000} * i +
+								 static_cast<int64_t>(rng() % jitter);
+	std::vector<uint64_t> encoded((DeltaEncoding::EncodedSize(vec) + 7) / 8);
+	DeltaEncoding::Encode(vec, reinterpret_cast<uint8_t *>(encoded.data()));
+	Vector out(LogicalType::INT64, CHUNK_ROWS, arena);
+	for (auto _ : state) {
+		DeltaEncoding::Decode(reinterpret_cast<uint8_t *>(encoded.data()), CHUNK_ROWS, out);
+		benchmark::DoNotOptimize(out.RawData());
+	}
+	state.SetItemsProcessed(state.iterations() * CHUNK_ROWS);
+	state.SetBytesProcessed(state.iterations() * CHUNK_ROWS * int64_t{sizeof(int64_t)});
+	state.counters["bytes_per_value"] =
+			static_cast<double>(encoded.size() * sizeof(uint64_t)) / CHUNK_ROWS;
+}
+BENCHMARK(BM_DeltaDecode)->Arg(0)->Arg(1000);
+
+/** @brief Chunk of range(0) distinct values, an IN list of a tenth of them */
+static void FillDictionaryChunk(benchmark::State &state, Vector &vec, ColumnPredicate &predicate) {
+	const auto distinct = static_cast<uint64_t>(state.range(0));
+	std::mt19937_64 rng(7);
+	vec.SetSize(CHUNK_ROWS);
+	for (uint32_t i = 0; i < CHUNK_ROWS; i++)
+		vec.Data<int64_t>()[i] = static_cast<int64_t>(1000 * (rng() % distinct));
+	predicate.kind = ColumnPredicate::Kind::IN;
+	for (uint64_t v = 0; v < distinct; v += 10) {
+		Value value;
+		value.SetType(LogicalType::INT64);
+		value.Set<int64_t>(static_cast<int64_t>(1000 * v));
+		predicate.values.push_back(value);
+	}
+}
+
+/** @brief Filter a dictionary chunk on its codes, range(0) is the number of distinct values */
+static void BM_DictionarySelect(benchmark::State &state) {
+	Arena arena;
+	Vector vec(LogicalType::INT64, CHUNK_ROWS, arena);
+	ColumnPredicate predicate;
+	FillDictionaryChunk(state, vec, predicate);
+	std::vector<uint64_t> encoded((DictionaryEncoding::EncodedSize(vec) + 7) / 8);
+	const auto *data = reinterpret_cast<const uint8_t *>(encoded.data());
+	DictionaryEncoding::Encode(vec, reinterpret_cast<uint8_t *>(encoded.data()));
+	SelectionVector sel(arena, CHUNK_ROWS);
+	for (auto _ : state) {
+		const CodeSet codes = DictionaryEncoding::QualifyingCodes(data, LogicalType::INT64,
+																  predicate);
+		benchmark::DoNotOptimize(DictionaryEncoding::Select(data, CHUNK_ROWS, codes, nullptr, sel));
+	}
+	state.SetItemsProcessed(state.iterations() * CHUNK_ROWS);
+}
+BENCHMARK(BM_DictionarySelect)->Arg(16)->Arg(100)->Arg(4096);
+
+/** @brief The same filter on decoded values, what the scan did without the dictionary */
+static void BM_DictionaryDecodeThenFilter(benchmark::State &state) {
+	Arena arena;
+	Vector vec(LogicalType::INT64, CHUNK_ROWS, arena);
+	ColumnPredicate predicate;
+	FillDictionaryChunk(state, vec, predicate);
+	std::vector<uint64_t> encoded((DictionaryEncoding::EncodedSize(vec) + 7) / 8);
+	const auto *data = reinterpret_cast<const uint8_t *>(encoded.data());
+	DictionaryEncoding::Encode(vec, reinterpret_cast<uint8_t *>(encoded.data()));
+	Vector out(LogicalType::INT64, CHUNK_ROWS, arena);
+	SelectionVector sel(arena, CHUNK_ROWS);
+	for (auto _ : state) {
+		DictionaryEncoding::Decode(data, CHUNK_ROWS, out);
+		idx_t selected = 0;
+		for (uint32_t i = 0; i < CHUNK_ROWS; i++) {
+			sel.Data()[selected] = i;
+			selected += predicate.Matches(out.Data<int64_t>()[i]) ? 1 : 0;
+		}
+		benchmark::DoNotOptimize(selected);
+	}
+	state.SetItemsProcessed(state.iterations() * CHUNK_ROWS);
+}
+BENCHMARK(BM_DictionaryDecodeThenFilter)->Arg(16)->Arg(100)->Arg(4096);
+
+/** @brief INT64 chunk of sorted values that change every range(0) rows, RLE encoded */
+static std::vector<uint64_t> SortedRleChunk(benchmark::State &state, Arena &arena) {
+	const auto run = static_cast<uint32_t>(state.range(0));
+	Vector vec(LogicalType::INT64, CHUNK_ROWS, arena);
+	vec.SetSize(CHUNK_ROWS);
+	for (uint32_t i = 0; i < CHUNK_ROWS; i++)
+		vec.Data<int64_t>()[i] = 19000 + i / run;
+	std::vector<uint64_t> encoded((RleEncoding::EncodedSize(vec) + 7) / 8);
+	RleEncoding::Encode(vec, reinterpret_cast<uint8_t *>(encoded.data()));
+	return encoded;
+}
+
+/** @brief SUM over the (value, run length) pairs of an RLE chunk, range(0) is the run length */
+static void BM_RleSumRuns(benchmark::State &state) {
+	Arena arena;
+	const std::vector<uint64_t> encoded = SortedRleChunk(state, arena);
+	const auto *data = reinterpret_cast<const uint8_t *>(encoded.data());
+	const AggregateFunction sum({AggregateType::SUM, 0}, LogicalType::INT64);
+	RunChunk runs(LogicalType::INT64, CHUNK_ROWS, arena);
+	for (auto _ : state) {
+		AggregateState result;
+		RleEncoding::DecodeRuns(data, runs.values, runs.lengths);
+		sum.UpdateRuns(result, runs.values, runs.lengths, runs.Size());
+		benchmark::DoNotOptimize(result.int_value);
+	}
+	state.SetItemsProcessed(state.iterations() * CHUNK_ROWS);
+}
+BENCHMARK(BM_RleSumRuns)->Arg(1)->Arg(16)->Arg(4096);
+
+/** @brief The same SUM after expanding the runs, what a scan of decoded values costs */
+static void BM_RleDecodeThenSum(benchmark::State &state) {
+	Arena arena;
+	const std::vector<uint64_t> encoded = SortedRleChunk(state, arena);
+	const auto *data = reinterpret_cast<const uint8_t *>(encoded.data());
+	const AggregateFunction sum({AggregateType::SUM, 0}, LogicalType::INT64);
+	Vector out(LogicalType::INT64, CHUNK_ROWS, arena);
+	for (auto _ : state) {
+		AggregateState result;
+		RleEncoding::Decode(data, CHUNK_ROWS, out);
+		sum.Update(result, out, 0, CHUNK_ROWS);
+		benchmark::DoNotOptimize(result.int_value);
+	}
+	state.SetItemsProcessed(state.iterations() * CHUNK_ROWS);
+}
+BENCHMARK(BM_RleDecodeThenSum)->Arg(1)->Arg(16)->Arg(4096);
+
+} // namespace electricdb
@@ -0,0 +1,80 @@
+#include "electricdb/execution/engine/pipeline_builder.h"
+#include "electricdb/execution/operators/aggregate/hash_aggregate.h"
+#include "electricdb/execution/operators/out/out.h"
+#include "electricdb/execution/operators/scan/file_scan.h"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+namespace electricdb {
+
+/** @brief 4 INT64 columns of FILE_ROWS rows, 128 MB */
+constexpr uint32_t FILE_ROWS = 4 << 20;
+constexpr size_t FILE_COLUMNS = 4;
+
+/** @brief Path of the benchmark's column file, written on first use and removed at exit */
+static const std::string &BenchFile() {
+	static const std::string path = [] {
+		const std::string file = "/tmp/electricdb_file_scan_bench.edb";
+		std::vector<ColumnSchema> schema;
+		for (size_t c = 0; c < FILE_COLUMNS; c++)
+			schema.push_back({"c" + std::to_string(c), LogicalType::INT64});
+		ColumnFileWriter writer(file, schema);
+
+		Arena arena;
+		std::vector<Vector> columns;
+		for (size_t c = 0; c < FILE_COLUMNS; c++)
+			columns.emplace_back(LogicalType::INT64, DEFAULT_ROW_GROUP_SIZE, arena);
+		for (uint32_t start = 0; start < FILE_ROWS; start += DEFAULT_ROW_GROUP_SIZE) {
+			const uint32_t count = std::min<uint32_t>(DEFAULT_ROW_GROUP_SIZE, FILE_ROWS - start);
+			for (size_t c = 0; c < FILE_COLUMNS; c++) {
+				columns[c].SetSize(count);
+				for (uint32_t i = 0; i < count; i++)
+					columns[c].Data<int64_t>()[i] = static_cast<int64_t>((start + i) * (c + 1));
+			}
+			writer.Append(columns);
+		}
+		writer.Finish();
+		std::atexit([] { std::remove("/tmp/electricdb_file_scan_bench.edb"); });
+		return file;
+	}();
+	return path;
+}
+
+/** @brief SUM over every column, range(0) is the FileScanMode. DIRECT bypasses the warm cache. */
+static void BM_FileScanSum(benchmark::State &state) {
+	const auto mode = static_cast<FileScanMode>(state.range(0));
+	ColumnFileReader reader(BenchFile());
+	Scheduler scheduler(1);
+
+	std::vector<idx_t> column_ids;
+	std::vector<AggregateSpec> aggregates;
+	for (idx_t c = 0; c < FILE_COLUMNS; c++) {
+		column_ids.push_back(c);
+		aggregates.push_back({AggregateType::SUM, c});
+	}
+
+	for (auto _ : state) {
+		PhysicalFileScan scan(reader, column_ids, mode);
+		PhysicalHashAggregate sum(scan.Types(), {}, aggregates);
+		sum.AddChild(&scan);
+		PhysicalResultCollector result(sum.Types());
+		result.AddChild(&sum);
+		PipelineBuilder(result).Execute(scheduler);
+		benchmark::DoNotOptimize(result.Count());
+	}
+	state.SetBytesProcessed(state.iterations() * int64_t{FILE_ROWS} * FILE_COLUMNS * 8);
+}
+BENCHMARK(BM_FileScanSum)
+		->Arg(static_cast<int64_t>(FileScanMode::READ))
+		->Arg(static_cast<int64_t>(FileScanMode::MMAP))
+		->Arg(static_cast<int64_t>(FileScanMode::DIRECT))
+		->ArgName("mode")
+		->UseRealTime()
+		->Unit(benchmark::kMillisecond);
+
+} // namespace electricdb
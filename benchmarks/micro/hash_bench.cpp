@@ -0,0 +1,89 @@
+#include "electricdb/util/hash.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace electricdb {
+
+/** @brief Keys hashed per iteration, enough to hide the loop overhead */
+static constexpr size_t HASH_KEYS = 1024;
+
+static std::vector<uint64_t> RandomKeys() {
+	std::mt19937_64 rng(10);
+	std::vector<uint64_t> keys(HASH_KEYS);
+	for (auto &key : keys)
+		key = rng();
+	return keys;
+}
+
+static void BM_HashU64(benchmark::State &state) {
+	const std::vector<uint64_t> keys = RandomKeys();
+	for (auto _ : state) {
+		uint64_t acc = 0;
+		for (uint64_t key : keys)
+			acc ^= Hash::u64(key);
+		benchmark::DoNotOptimize(acc);
+	}
+	state.SetItemsProcessed(state.iterations() * HASH_KEYS);
+}
+BENCHMARK(BM_HashU64);
+
+static void BM_HashI32(benchmark::State &state) {
+	const std::vector<uint64_t> keys = RandomKeys();
+	for (auto _ : state) {
+		uint64_t acc = 0;
+		for (uint64_t key : keys)
+			acc ^= Hash::i32(static_cast<int32_t>(key));
+		benchmark::DoNotOptimize(acc);
+	}
+	state.SetItemsProcessed(state.iterations() * HASH_KEYS);
+}
+BENCHMARK(BM_HashI32);
+
+/** @brief Multi-column keys as the hash aggregate and join build them */
+static void BM_HashCombine(benchmark::State &state) {
+	const std::vector<uint64_t> keys = RandomKeys();
+	for (auto _ : state) {
+		uint64_t acc = 0;
+		for (size_t i = 0; i + 1 < HASH_KEYS; i += 2)
+			acc ^= Hash::combine(Hash::u64(keys[i]), Hash::u64(keys[i + 1]));
+		benchmark::DoNotOptimize(acc);
+	}
+	state.SetItemsProcessed(state.iterations() * HASH_KEYS / 2);
+}
+BENCHMARK(BM_HashCombine);
+
+/** @brief Byte strings of range(0) bytes */
+static void BM_HashBytes(benchmark::State &state) {
+	const auto length = static_cast<size_t>(state.range(0));
+	std::mt19937_64 rng(11);
+	std::string data(length * 64, '\0');
+	for (auto &c : data)
+		c = static_cast<char>(rng());
+	for (auto _ : state) {
+		uint64_t acc = 0;
+		for (size_t offset = 0; offset < data.size(); offset += length)
+			acc ^= Hash::bytes(data.data() + offset, length);
+		benchmark::DoNotOptimize(acc);
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+BENCHMARK(BM_HashBytes)->RangeMultiplier(4)->Range(4, 1024);
+
+static void BM_HashString(benchmark::State &state) {
+	std::vector<std::string> strings;
+	for (size_t i = 0; i < HASH_KEYS; i++)
+		strings.push_back("customer#" + std::to_string(i * 7919));
+	for (auto _ : state) {
+		uint64_t acc = 0;
+		for (const auto &str : strings)
+			acc ^= Hash::string(str);
+		benchmark::DoNotOptimize(acc);
+	}
+	state.SetItemsProcessed(state.iterations() * HASH_KEYS);
+}
+BENCHMARK(BM_HashString);
+
+} // namespace electricdb
@@ -0,0 +1,107 @@
+#include "bench_util.h"
+#include "electricdb/execution/context/execution_context.h"
+#include "electricdb/execution/expressions/binary_expression.h"
+#include "electricdb/execution/expressions/type_dispatch.h"
+#include "electricdb/execution/expressions/unary_expression.h"
+
+#include <benchmark/benchmark.h>
+
+namespace electricdb {
+
+/**
+ * @brief Inputs of one dispatch benchmark: two random batches with range(0) percent nulls and,
+ * below 100, a selection of range(1) percent of the rows
+ *
+ */
+template <typename T>
+struct DispatchInput {
+	DispatchInput(LogicalType type, const benchmark::State &state)
+		: lhs(type, BENCH_ROWS, arena), rhs(type, BENCH_ROWS, arena), out(type, BENCH_ROWS, arena),
+		  rows(RandomSelection(BENCH_ROWS, state.range(1), 9)), sel(MakeSelection(arena, rows)) {
+		FillRandom<T>(lhs, state.range(0), 7);
+		FillRandom<T>(rhs, state.range(0), 8);
+		out.SetSize(BENCH_ROWS);
+		if (state.range(1) < 100)
+			ctx.SetSelection(&sel);
+	}
+
+	/** @brief Rows the kernel visits per call */
+	int64_t Rows() const {
+		return ctx.Selection() ? static_cast<int64_t>(rows.size()) : BENCH_ROWS;
+	}
+
+	Arena arena;
+	ExecutionContext ctx;
+	Vector lhs;
+	Vector rhs;
+	Vector out;
+	std::vector<sel_t> rows;
+	SelectionVector sel;
+};
+
+template <typename T, LogicalType TYPE>
+static void BM_UnaryTypeDispatch(benchmark::State &state) {
+	DispatchInput<T> input(TYPE, state);
+	for (auto _ : state) {
+		UnaryTypeDispatch<NegateOp>(input.ctx, input.out, input.lhs);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * input.Rows());
+}
+
+template <typename T, LogicalType TYPE>
+static void BM_BinaryTypeDispatch(benchmark::State &state) {
+	DispatchInput<T> input(TYPE, state);
+	for (auto _ : state) {
+		BinaryTypeDispatch<AddOp>(input.ctx, input.out, input.lhs, input.rhs);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * input.Rows());
+}
+
+static void BM_UnaryBoolDispatch(benchmark::State &state) {
+	DispatchInput<bool> input(LogicalType::BOOL, state);
+	for (auto _ : state) {
+		UnaryBoolDispatch<NotOp>(input.ctx, input.out, input.lhs);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * input.Rows());
+}
+
+template <typename T, LogicalType TYPE>
+static void BM_ConstantDispatch(benchmark::State &state) {
+	DispatchInput<T> input(TYPE, state);
+	Value value;
+	value.SetType(TYPE);
+	value.Set<T>(T(42));
+	for (auto _ : state) {
+		ConstantDispatch(input.ctx, input.out, value);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * input.Rows());
+}
+
+/** @brief Null percentages crossed with selectivities, 100 meaning no selection vector */
+static void DispatchArgs(benchmark::internal::Benchmark *bench) {
+	bench->ArgsProduct({{0, 10, 50}, {10, 50, 100}})->ArgNames({"null", "sel"});
+}
+
+BENCHMARK_TEMPLATE(BM_UnaryTypeDispatch, int32_t, LogicalType::INT32)->Apply(DispatchArgs);
+BENCHMARK_TEMPLATE(BM_UnaryTypeDispatch, int64_t, LogicalType::INT64)->Apply(DispatchArgs);
+BENCHMARK_TEMPLATE(BM_UnaryTypeDispatch, float, LogicalType::FLOAT)->Apply(DispatchArgs);
+BENCHMARK_TEMPLATE(BM_UnaryTypeDispatch, double, LogicalType::DOUBLE)->Apply(DispatchArgs);
+
+BENCHMARK_TEMPLATE(BM_BinaryTypeDispatch, int32_t, LogicalType::INT32)->Apply(DispatchArgs);
+BENCHMARK_TEMPLATE(BM_BinaryTypeDispatch, int64_t, LogicalType::INT64)->Apply(DispatchArgs);
+BENCHMARK_TEMPLATE(BM_BinaryTypeDispatch, float, LogicalType::FLOAT)->Apply(DispatchArgs);
+BENCHMARK_TEMPLATE(BM_BinaryTypeDispatch, double, LogicalType::DOUBLE)->Apply(DispatchArgs);
+
+BENCHMARK(BM_UnaryBoolDispatch)->Apply(DispatchArgs);
+
+BENCHMARK_TEMPLATE(BM_ConstantDispatch, int32_t, LogicalType::INT32)->Apply(DispatchArgs);
+BENCHMARK_TEMPLATE(BM_ConstantDispatch, int64_t, LogicalType::INT64)->Apply(DispatchArgs);
+BENCHMARK_TEMPLATE(BM_ConstantDispatch, float, LogicalType::FLOAT)->Apply(DispatchArgs);
+BENCHMARK_TEMPLATE(BM_ConstantDispatch, double, LogicalType::DOUBLE)->Apply(DispatchArgs);
+BENCHMARK_TEMPLATE(BM_ConstantDispatch, bool, LogicalType::BOOL)->Apply(DispatchArgs);
+
+} // namespace electricdb
@@ -0,0 +1,104 @@
+#include "bench_util.h"
+#include "electricdb/execution/vector/nullmask.h"
+#include "electricdb/execution/vector/selection_vector.h"
+#include "electricdb/execution/vector/vector.h"
+
+#include <benchmark/benchmark.h>
+
+namespace electricdb {
+
+/** @brief Mark range(0) percent of a batch null, then clear the mask */
+static void BM_NullMaskSet(benchmark::State &state) {
+	Arena arena;
+	NullMask mask(arena, BENCH_ROWS);
+	const std::vector<sel_t> nulls = RandomSelection(BENCH_ROWS, state.range(0), 1);
+	for (auto _ : state) {
+		for (sel_t row : nulls)
+			mask.SetNull(row);
+		benchmark::ClobberMemory();
+		mask.Reset();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(nulls.size()));
+}
+BENCHMARK(BM_NullMaskSet)->Arg(0)->Arg(1)->Arg(10)->Arg(50)->Arg(100)->ArgName("null");
+
+/** @brief Test every row of a batch with range(0) percent nulls */
+static void BM_NullMaskIsNull(benchmark::State &state) {
+	Arena arena;
+	NullMask mask(arena, BENCH_ROWS);
+	for (sel_t row : RandomSelection(BENCH_ROWS, state.range(0), 1))
+		mask.SetNull(row);
+	for (auto _ : state) {
+		idx_t count = 0;
+		for (idx_t i = 0; i < BENCH_ROWS; i++)
+			count += mask.IsNull(i) ? 1 : 0;
+		benchmark::DoNotOptimize(count);
+	}
+	state.SetItemsProcessed(state.iterations() * BENCH_ROWS);
+}
+BENCHMARK(BM_NullMaskIsNull)->Arg(0)->Arg(1)->Arg(10)->Arg(50)->Arg(100)->ArgName("null");
+
+/** @brief Complement of a selection of range(0) percent of a batch */
+static void BM_SelectionVectorInvert(benchmark::State &state) {
+	Arena arena;
+	const std::vector<sel_t> rows = RandomSelection(BENCH_ROWS, state.range(0), 2);
+	const SelectionVector src = MakeSelection(arena, rows);
+	SelectionVector dst(arena, BENCH_ROWS);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(SelectionVector::Invert(src, dst, BENCH_ROWS,
+														 static_cast<idx_t>(rows.size())));
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * BENCH_ROWS);
+}
+BENCHMARK(BM_SelectionVectorInvert)->Arg(1)->Arg(10)->Arg(50)->Arg(90)->Arg(99)->ArgName("sel");
+
+/** @brief Cut a batch into zero-copy slices of range(0) rows */
+static void BM_VectorSlice(benchmark::State &state) {
+	Arena arena;
+	Vector vec(LogicalType::INT64, BENCH_ROWS, arena);
+	FillRandom<int64_t>(vec, 0, 3);
+	Vector slice(LogicalType::INT64, 0, arena);
+	const auto rows = static_cast<uint32_t>(state.range(0));
+	for (auto _ : state) {
+		for (uint32_t offset = 0; offset + rows <= BENCH_ROWS; offset += rows) {
+			vec.Slice(slice, offset, rows);
+			benchmark::DoNotOptimize(slice.RawData());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * (BENCH_ROWS / rows));
+}
+BENCHMARK(BM_VectorSlice)->Arg(1)->Arg(64)->Arg(512)->ArgName("rows");
+
+/** @brief Compact the rows of a selection of range(1) percent, range(0) percent of input null */
+static void BM_VectorGather(benchmark::State &state) {
+	Arena arena;
+	Vector source(LogicalType::INT64, BENCH_ROWS, arena);
+	FillRandom<int64_t>(source, state.range(0), 4);
+	const std::vector<sel_t> rows = RandomSelection(BENCH_ROWS, state.range(1), 5);
+	const SelectionVector sel = MakeSelection(arena, rows);
+	Vector target(LogicalType::INT64, BENCH_ROWS, arena);
+	for (auto _ : state) {
+		target.Gather(source, sel, static_cast<uint32_t>(rows.size()));
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(rows.size()));
+}
+BENCHMARK(BM_VectorGather)->ArgsProduct({{0, 10, 50}, {10, 50, 90}})->ArgNames({"null", "sel"});
+
+/** @brief Copy a whole batch with range(0) percent nulls */
+static void BM_VectorCopy(benchmark::State &state) {
+	Arena arena;
+	Vector source(LogicalType::INT64, BENCH_ROWS, arena);
+	FillRandom<int64_t>(source, state.range(0), 6);
+	Vector target(LogicalType::INT64, BENCH_ROWS, arena);
+	target.SetSize(BENCH_ROWS);
+	for (auto _ : state) {
+		target.Copy(source, 0, BENCH_ROWS);
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * BENCH_ROWS * sizeof(int64_t));
+}
+BENCHMARK(BM_VectorCopy)->Arg(0)->Arg(10)->Arg(50)->ArgName("null");
+
+} // namespace electricdb
@@ -0,0 +1,37 @@
+#include "electricdb/execution/engine/batch_size.h"
+#include "electricdb/common/constants.h"
+
+#include <unistd.h>
+
+namespace electricdb {
+
+/** @brief Used where sysconf() does not know the L2 size (e.g. some containers and non-glibc) */
+static constexpr size_t FALLBACK_L2_SIZE = 256 * 1024;
+
+size_t BatchCacheBudget() {
+	static const size_t budget = []() {
+		long l2 = -1;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+		l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+		const size_t size = l2 > 0 ? static_cast<size_t>(l2) : FALLBACK_L2_SIZE;
+		return size / 2;
+	}();
+	return budget;
+}
+
+size_t RowWidth(const std::vector<LogicalType> &types) {
+	size_t bits = 0;
+	for (auto type : types)
+		bits += 8 * GetTypeSize(type) + 1;
+	return (bits + 7) / 8;
+}
+
+uint32_t GrowBatchSize(size_t row_width, size_t cache_bytes) {
+	size_t batch_size = MAX_VECTOR_SIZE;
+	while (batch_size > DEFAULT_VECTOR_SIZE && batch_size * row_width > cache_bytes)
+		batch_size /= 2;
+	return static_cast<uint32_t>(batch_size);
+}
+
+} // namespace electricdb
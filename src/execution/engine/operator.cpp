@@ -0,0 +1,101 @@
+#include "electricdb/execution/engine/operator.h"
+
+#include <stdexcept>
+
+namespace electricdb {
+
+const char *PhysicalOperatorTypeName(PhysicalOperatorType type) {
+	switch (type) {
+	case PhysicalOperatorType::COLUMN_SCAN:
+		return "COLUMN_SCAN";
+	case PhysicalOperatorType::FILE_SCAN:
+		return "FILE_SCAN";
+	case PhysicalOperatorType::FILTER:
+		return "FILTER";
+	case PhysicalOperatorType::PROJECTION:
+		return "PROJECTION";
+	case PhysicalOperatorType::HASH_AGGREGATE:
+		return "HASH_AGGREGATE";
+	case PhysicalOperatorType::HASH_JOIN:
+		return "HASH_JOIN";
+	case PhysicalOperatorType::ORDER_BY:
+		return "ORDER_BY";
+	case PhysicalOperatorType::TOP_N:
+		return "TOP_N";
+	case PhysicalOperatorType::STREAMING_AGGREGATE:
+		return "STREAMING_AGGREGATE";
+	case PhysicalOperatorType::WINDOW:
+		return "WINDOW";
+	case PhysicalOperatorType::RESULT_COLLECTOR:
+		return "RESULT_COLLECTOR";
+	}
+	return "UNKNOWN";
+}
+
+PhysicalOperator::PhysicalOperator(PhysicalOperatorType type, std::vector<LogicalType> types)
+	: type_(type), types_(std::move(types)) {}
+
+std::unique_ptr<OperatorState> PhysicalOperator::InitOperatorState() const {
+	return std::make_unique<OperatorState>();
+}
+
+OperatorResult PhysicalOperator::Execute(ExecutionContext &, const std::vector<Vector> &,
+										 std::vector<Vector> &, OperatorState &) const {
+	throw std::runtime_error("Operator is not a streaming operator!");
+}
+
+uint64_t PhysicalOperator::SourceRowCount() const {
+	throw std::runtime_error("Operator is not a source!");
+}
+
+std::unique_ptr<LocalSourceState> PhysicalOperator::InitLocalSource() const {
+	return std::make_unique<LocalSourceState>();
+}
+
+void PhysicalOperator::GetData(ExecutionContext &, LocalSourceState &, uint64_t, idx_t,
+							   std::vector<Vector> &) const {
+	throw std::runtime_error("Operator is not a source!");
+}
+
+std::unique_ptr<LocalSinkState> PhysicalOperator::InitLocalSink() const {
+	throw std::runtime_error("Operator is not a sink!");
+}
+
+void PhysicalOperator::Sink(ExecutionContext &, LocalSinkState &, const std::vector<Vector> &) {
+	throw std::runtime_error("Operator is not a sink!");
+}
+
+void PhysicalOperator::Combine(LocalSinkState &) {
+	throw std::runtime_error("Operator is not a sink!");
+}
+
+void PhysicalOperator::Finalize(Scheduler &, const CancellationToken *) {}
+
+void PhysicalOperator::Abort() {}
+
+std::vector<Vector> PhysicalOperator::MakeChunk(const std::vector<LogicalType> &types,
+												uint32_t capacity, Arena &arena) {
+	std::vector<Vector> chunk;
+	chunk.reserve(types.size());
+	for (auto type : types)
+		chunk.emplace_back(type, capacity, arena);
+	return chunk;
+}
+
+void PhysicalOperator::FlattenColumns(const std::vector<Vector> &input,
+									  const std::vector<uint32_t> &columns,
+									  std::vector<Vector> &flat, std::vector<Vector> &view) {
+	for (size_t c = 0; c < input.size(); c++)
+		view[c].Reference(input[c]);
+	for (uint32_t c : columns) {
+		/** A column listed twice is flat after its first turn */
+		if (!view[c].IsDictionary())
+			continue;
+		flat[c].Reset();
+		flat[c].SetSize(input[c].Size());
+		flat[c].Copy(input[c], 0, input[c].Size());
+		view[c].Reference(flat[c]);
+	}
+}
+
+} // namespace electricdb
@@ -0,0 +1,285 @@
+#include "electricdb/execution/engine/pipeline.h"
+#include "electricdb/execution/engine/batch_size.h"
+#include "electricdb/util/trace.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace electricdb {
+
+Pipeline::Pipeline(PhysicalOperator *sink) : sink_(sink) {}
+
+bool Pipeline::IsReady() const noexcept {
+	return std::all_of(dependencies_.begin(), dependencies_.end(),
+					   [](const Pipeline *dependency) { return dependency->IsFinished(); });
+}
+
+std::shared_ptr<Task> Pipeline::Schedule(Scheduler &scheduler, const CancellationToken *token) {
+	if (!source_ || !sink_)
+		throw std::runtime_error("Pipeline requires a source and a sink!");
+	if (!IsReady())
+		throw std::runtime_error("Pipeline scheduled before its dependencies finished!");
+
+	locals_.clear();
+	locals_.resize(scheduler.WorkerCount());
+	token_ = token;
+	batch_size_ = requested_batch_size_ ? requested_batch_size_ : GrowBatchSize(LiveRowWidth());
+
+	/**
+	 * Sequential sources are read as a single morsel, in order. Morsels follow the source's own
+	 * layout if it has one, otherwise they hold whole batches.
+	 */
+	const uint64_t rows = source_->SourceRowCount();
+	uint64_t morsel_size = std::max<uint64_t>(rows, 1);
+	if (source_->ParallelSource()) {
+		morsel_size = source_->SourceMorselSize();
+		if (morsel_size == 0)
+			morsel_size = (DEFAULT_MORSEL_SIZE + batch_size_ - 1) / batch_size_ * batch_size_;
+	}
+
+	TRACE_ASYNC_BEGIN("pipeline", "pipeline", reinterpret_cast<uintptr_t>(this));
+	return scheduler.Submit(
+			[this](ExecutionContext &ctx, uint32_t worker_id, const Morsel &morsel) {
+				ExecuteMorsel(ctx, worker_id, morsel);
+			},
+			rows, morsel_size, token);
+}
+
+void Pipeline::SetBatchSize(uint32_t batch_size) {
+	if (batch_size == 0)
+		throw std::runtime_error("Batch size must not be 0!");
+	requested_batch_size_ = batch_size;
+}
+
+size_t Pipeline::LiveRowWidth() const {
+	size_t width = source_ ? RowWidth(source_->Types()) : 0;
+	for (auto *op : operators_)
+		width += RowWidth(op->Types());
+	return width;
+}
+
+void Pipeline::Finish(Scheduler &scheduler) {
+	TRACE_SCOPE("pipeline", "finish", scheduler.WorkerCount());
+	Stopwatch wall;
+	Stopwatch cpu(StopwatchClock::THREAD_CPU);
+	wall.start();
+	cpu.start();
+
+	for (auto &local : locals_) {
+		if (local)
+			sink_->Combine(*local->sink);
+	}
+	sink_->Finalize(scheduler, token_);
+
+	if (profile_)
+		MergeProfile(wall.elapsed_ns(), cpu.elapsed_ns());
+	locals_.clear();
+	finished_ = true;
+	TRACE_ASYNC_END("pipeline", "pipeline", reinterpret_cast<uintptr_t>(this));
+}
+
+const PhysicalOperator *Pipeline::StageOperator(size_t stage) const {
+	if (stage == 0)
+		return source_;
+	return stage <= operators_.size() ? operators_[stage - 1] : sink_;
+}
+
+void Pipeline::MergeProfile(uint64_t finish_wall_ns, uint64_t finish_cpu_ns) {
+	const size_t stages = operators_.size() + 2;
+	std::vector<OperatorMetrics> merged(stages);
+
+	for (auto &local : locals_) {
+		if (!local)
+			continue;
+		for (size_t stage = 0; stage < stages; stage++) {
+			OperatorMetrics &metrics = local->metrics[stage];
+			metrics.wall_ns += local->wall[stage].elapsed_ns();
+			metrics.cpu_ns += local->cpu[stage].elapsed_ns();
+			merged[stage].Merge(metrics);
+			/** Counted per worker here, Merge() keeps the maximum over pipelines */
+			merged[stage].threads++;
+		}
+	}
+	merged.back().wall_ns += finish_wall_ns;
+	merged.back().cpu_ns += finish_cpu_ns;
+
+	for (size_t stage = 0; stage < stages; stage++)
+		(*profile_)[StageOperator(stage)].Merge(merged[stage]);
+}
+
+/** @brief Add the events counted between `begin` and `end` to `metrics` */
+static void AddHardwareCounters(const PerfSample &begin, const PerfSample &end,
+								OperatorMetrics &metrics) {
+	auto delta = [&](PerfEvent event) {
+		const auto i = static_cast<size_t>(event);
+		/** Scaled values of a multiplexed group are estimates and may go backwards */
+		return end[i] > begin[i] ? end[i] - begin[i] : 0;
+	};
+	metrics.cycles += delta(PerfEvent::CYCLES);
+	metrics.instructions += delta(PerfEvent::INSTRUCTIONS);
+	metrics.llc_misses += delta(PerfEvent::LLC_MISSES);
+	metrics.branch_misses += delta(PerfEvent::BRANCH_MISSES);
+}
+
+void Pipeline::BeginStage(ExecutionContext &ctx, LocalState &local, size_t stage) const {
+	if (!profile_)
+		return;
+	local.arena_mark = ctx.GetArena().bytes_used();
+	ctx.SetMetrics(&local.metrics[stage]);
+	local.wall[stage].start();
+	local.cpu[stage].start();
+	if (local.perf)
+		local.perf_mark = local.perf->Read();
+}
+
+void Pipeline::EndStage(ExecutionContext &ctx, LocalState &local, size_t stage) const {
+	if (!profile_)
+		return;
+	OperatorMetrics &metrics = local.metrics[stage];
+	if (local.perf)
+		AddHardwareCounters(local.perf_mark, local.perf->Read(), metrics);
+	local.cpu[stage].stop();
+	local.wall[stage].stop();
+	ctx.SetMetrics(nullptr);
+
+	metrics.batches++;
+	const uint64_t used = ctx.GetArena().bytes_used();
+	metrics.bytes_allocated += used > local.arena_mark ? used - local.arena_mark : 0;
+}
+
+void Pipeline::Abort() {
+	/** Only scheduled pipelines that did not finish have local states */
+	if (!locals_.empty())
+		TRACE_ASYNC_END("pipeline", "pipeline", reinterpret_cast<uintptr_t>(this));
+	locals_.clear();
+	sink_->Abort();
+}
+
+void Pipeline::Execute(Scheduler &scheduler, const CancellationToken *token) {
+	try {
+		Schedule(scheduler, token)->Wait();
+	} catch (...) {
+		Abort();
+		throw;
+	}
+	Finish(scheduler);
+}
+
+Pipeline::LocalState &Pipeline::GetLocalState(uint32_t worker_id) {
+	auto &local = locals_[worker_id];
+	if (local)
+		return *local;
+
+	local = std::make_unique<LocalState>();
+	Arena &arena = local->arena;
+	local->source = source_->InitLocalSource();
+	local->chunks.push_back(PhysicalOperator::MakeChunk(source_->Types(), batch_size_, arena));
+	for (auto *op : operators_) {
+		local->states.push_back(op->InitOperatorState());
+		local->chunks.push_back(PhysicalOperator::MakeChunk(op->Types(), batch_size_, arena));
+	}
+	local->sink = sink_->InitLocalSink();
+
+	if (profile_) {
+		const size_t stages = operators_.size() + 2;
+		local->metrics.resize(stages);
+		local->wall.resize(stages);
+		local->cpu.resize(stages, Stopwatch(StopwatchClock::THREAD_CPU));
+		/** Opened here since the counters belong to the calling thread, the worker's */
+		if (hardware_counters_) {
+			local->perf = std::make_unique<PerfCounters>();
+			if (!local->perf->Available())
+				local->perf.reset();
+		}
+	}
+	return *local;
+}
+
+void Pipeline::ExecuteMorsel(ExecutionContext &ctx, uint32_t worker_id, const Morsel &morsel) {
+	LocalState &local = GetLocalState(worker_id);
+
+	/**
+	 * The worker's context goes back to its own vector size however the morsel ends, and keeps no
+	 * pointer into this query, whose token and profile may be gone before the next one runs
+	 */
+	struct Restore {
+		ExecutionContext &ctx;
+		uint32_t vector_size;
+		~Restore() {
+			ctx.SetVectorSize(vector_size);
+			ctx.SetToken(nullptr);
+			ctx.SetMetrics(nullptr);
+		}
+	} restore{ctx, ctx.VectorSize()};
+	ctx.SetVectorSize(batch_size_);
+	ctx.SetToken(token_);
+	local.sink->morsel_index = morsel.begin;
+
+	for (uint64_t offset = morsel.begin; offset < morsel.end;) {
+		/** A cancelled query gives up its core after at most one batch */
+		if (token_)
+			token_->ThrowIfCancelled();
+
+		const auto count = static_cast<idx_t>(std::min<uint64_t>(batch_size_, morsel.end - offset));
+		BeginStage(ctx, local, 0);
+		source_->GetData(ctx, *local.source, offset, count, local.chunks[0]);
+		EndStage(ctx, local, 0);
+		if (profile_)
+			local.metrics[0].rows_out += count;
+
+		local.sink->batch_index = offset;
+		Push(ctx, local, 0);
+		offset += count;
+
+		/** Reuse the same scratch memory for every batch, it is still in cache */
+		ctx.Reset();
+	}
+}
+
+/**
+ * @brief Expand the dictionary and run vectors of `chunk` that `op` does not take as they are
+ *
+ */
+static void FlattenDictionaries(const PhysicalOperator &op, std::vector<Vector> &chunk) {
+	for (size_t c = 0; c < chunk.size(); c++) {
+		if ((chunk[c].IsDictionary() && !op.AcceptsDictionary(c)) ||
+			(chunk[c].IsRuns() && !op.AcceptsRuns(c)))
+			chunk[c].Flatten();
+	}
+}
+
+void Pipeline::Push(ExecutionContext &ctx, LocalState &local, size_t level) {
+	const std::vector<Vector> &chunk = local.chunks[level];
+	if (chunk.empty() || chunk[0].Size() == 0)
+		return;
+	FlattenDictionaries(level == operators_.size() ? *sink_ : *operators_[level],
+						local.chunks[level]);
+
+	if (level == operators_.size()) {
+		BeginStage(ctx, local, level + 1);
+		sink_->Sink(ctx, *local.sink, chunk);
+		EndStage(ctx, local, level + 1);
+		if (profile_)
+			local.metrics[level + 1].rows_in += chunk[0].Size();
+		return;
+	}
+
+	OperatorResult result;
+	bool resumed = false;
+	do {
+		std::vector<Vector> &output = local.chunks[level + 1];
+		BeginStage(ctx, local, level + 1);
+		result = operators_[level]->Execute(ctx, chunk, output, *local.states[level]);
+		EndStage(ctx, local, level + 1);
+		if (profile_) {
+			OperatorMetrics &metrics = local.metrics[level + 1];
+			/** A resumed input was counted on its first call */
+			metrics.rows_in += resumed ? 0 : chunk[0].Size();
+			metrics.rows_out += output.empty() ? 0 : output[0].Size();
+		}
+		resumed = true;
+		Push(ctx, local, level + 1);
+	} while (result == OperatorResult::HAVE_MORE_OUTPUT);
+}
+
+} // namespace electricdb
@@ -0,0 +1,142 @@
+#include "electricdb/execution/engine/pipeline_builder.h"
+
+#include <exception>
+#include <stdexcept>
+
+namespace electricdb {
+
+PipelineBuilder::PipelineBuilder(PhysicalOperator &root) : root_(root) {
+	if (!root.IsSink() || root.Children().size() != 1)
+		throw std::runtime_error("The root of a plan must be a sink with one input!");
+	Build(root, *root.Children()[0]);
+}
+
+Pipeline *PipelineBuilder::Build(PhysicalOperator &sink, PhysicalOperator &input) {
+	auto pipeline = std::make_unique<Pipeline>(&sink);
+	Pipeline *result = pipeline.get();
+
+	std::vector<PhysicalOperator *> operators;
+	Walk(*result, input, operators);
+	for (auto it = operators.rbegin(); it != operators.rend(); ++it)
+		result->AddOperator(*it);
+
+	/** Added after the pipelines built by Walk(), which are its dependencies */
+	pipelines_.push_back(std::move(pipeline));
+	return result;
+}
+
+void PipelineBuilder::Walk(Pipeline &pipeline, PhysicalOperator &op,
+						   std::vector<PhysicalOperator *> &operators) {
+	const auto &children = op.Children();
+
+	if (op.IsSink() && op.IsSource()) {
+		if (children.size() != 1)
+			throw std::runtime_error("A pipeline breaker must have exactly one input!");
+		pipeline.SetSource(&op);
+		pipeline.AddDependency(Build(op, *children[0]));
+		return;
+	}
+
+	if (op.IsSink()) {
+		if (children.size() != 2)
+			throw std::runtime_error("A join must have a probe and a build input!");
+		pipeline.AddDependency(Build(op, *children[1]));
+		operators.push_back(&op);
+		Walk(pipeline, *children[0], operators);
+		return;
+	}
+
+	if (op.IsSource()) {
+		pipeline.SetSource(&op);
+		return;
+	}
+
+	if (children.size() != 1)
+		throw std::runtime_error("A streaming operator must have exactly one input!");
+	operators.push_back(&op);
+	Walk(pipeline, *children[0], operators);
+}
+
+void PipelineBuilder::EnableProfiling(bool hardware_counters) {
+	profile_ = std::make_unique<OperatorProfile>();
+	for (auto &pipeline : pipelines_)
+		pipeline->EnableProfiling(profile_.get(), hardware_counters);
+}
+
+ProfileNode PipelineBuilder::ProfileOperator(const PhysicalOperator &op) const {
+	ProfileNode node;
+	node.name = PhysicalOperatorTypeName(op.Type());
+	if (profile_) {
+		auto it = profile_->find(&op);
+		if (it != profile_->end())
+			node.metrics = it->second;
+	}
+	for (const auto *child : op.Children())
+		node.children.push_back(ProfileOperator(*child));
+	return node;
+}
+
+QueryProfile PipelineBuilder::Profile() const {
+	return QueryProfile(ProfileOperator(root_), wall_ns_);
+}
+
+void PipelineBuilder::Execute(Scheduler &scheduler, const CancellationToken *token) {
+	if (profile_)
+		profile_->clear();
+	Stopwatch wall;
+	wall.start();
+
+	try {
+		Run(scheduler, token);
+		wall_ns_ = wall.elapsed_ns();
+	} catch (...) {
+		/** Free memory and spill files now, not when the plan is destroyed */
+		for (auto &pipeline : pipelines_)
+			pipeline->Abort();
+		throw;
+	}
+}
+
+void PipelineBuilder::Run(Scheduler &scheduler, const CancellationToken *token) {
+	std::vector<Pipeline *> remaining;
+	for (auto &pipeline : pipelines_)
+		remaining.push_back(pipeline.get());
+
+	while (!remaining.empty()) {
+		std::vector<Pipeline *> ready;
+		std::vector<Pipeline *> blocked;
+		for (auto *pipeline : remaining)
+			(pipeline->IsReady() ? ready : blocked).push_back(pipeline);
+		if (ready.empty())
+			throw std::runtime_error("Pipeline dependencies contain a cycle!");
+
+		if (token)
+			token->ThrowIfCancelled();
+
+		std::vector<std::shared_ptr<Task>> tasks;
+		for (auto *pipeline : ready)
+			tasks.push_back(pipeline->Schedule(scheduler, token));
+
+		/** Wait for all tasks before rethrowing, they reference the pipelines */
+		std::exception_ptr error;
+		for (auto &task : tasks) {
+			try {
+				task->Wait();
+			} catch (...) {
+				if (!error)
+					error = std::current_exception();
+			}
+		}
+		if (error)
+			std::rethrow_exception(error);
+
+		for (auto *pipeline : ready) {
+			if (token)
+				token->ThrowIfCancelled();
+			pipeline->Finish(scheduler);
+		}
+		remaining = std::move(blocked);
+	}
+}
+
+} // namespace electricdb
@@ -0,0 +1,199 @@
+#include "electricdb/execution/engine/scheduler.h"
+#include "electricdb/util/trace.h"
+
+#include <algorithm>
+#include <string>
+
+namespace electricdb {
+
+Task::Task(MorselFunction function, uint64_t row_count, uint64_t morsel_size,
+		   const CancellationToken *token)
+	: function_(std::move(function)), morsel_size_(std::max<uint64_t>(morsel_size, 1)),
+	  token_(token), remaining_(row_count) {}
+
+void Task::Execute(ExecutionContext &context, uint32_t worker_id, const Morsel &morsel) {
+	if (!failed_.load(std::memory_order_relaxed)) {
+		try {
+			/** Recorded before the morsel counts as done, so Wait() returns after the event */
+			TRACE_SCOPE("scheduler", "morsel", morsel.end - morsel.begin);
+			if (token_)
+				token_->ThrowIfCancelled();
+			function_(context, worker_id, morsel);
+		} catch (...) {
+			std::lock_guard<std::mutex> guard(lock_);
+			if (!error_)
+				error_ = std::current_exception();
+			failed_.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	const uint64_t rows = morsel.end - morsel.begin;
+	if (remaining_.fetch_sub(rows, std::memory_order_acq_rel) == rows) {
+		std::lock_guard<std::mutex> guard(lock_);
+		done_.notify_all();
+	}
+}
+
+void Task::Wait() {
+	std::unique_lock<std::mutex> lock(lock_);
+	done_.wait(lock, [this]() { return IsDone(); });
+	if (error_)
+		std::rethrow_exception(error_);
+}
+
+Scheduler::Scheduler(uint32_t num_workers) {
+	if (num_workers == 0)
+		num_workers = std::max(1u, std::thread::hardware_concurrency());
+
+	/** All workers exist before the first thread starts looking for victims */
+	for (uint32_t i = 0; i < num_workers; i++)
+		workers_.push_back(std::make_unique<Worker>());
+	for (uint32_t i = 0; i < num_workers; i++)
+		workers_[i]->thread = std::thread([this, i]() { WorkerLoop(i); });
+}
+
+Scheduler::~Scheduler() {
+	{
+		std::lock_guard<std::mutex> guard(sleep_lock_);
+		stop_ = true;
+	}
+	wake_.notify_all();
+	for (auto &worker : workers_)
+		worker->thread.join();
+}
+
+std::shared_ptr<Task> Scheduler::Submit(MorselFunction function, uint64_t row_count,
+										uint64_t morsel_size, const CancellationToken *token) {
+	auto task = std::make_shared<Task>(std::move(function), row_count, morsel_size, token);
+	if (row_count == 0)
+		return task;
+
+	/** One contiguous range of whole morsels per worker, morsels are carved off lazily */
+	const uint64_t morsels = (row_count + task->MorselSize() - 1) / task->MorselSize();
+	const uint64_t ranges = std::min<uint64_t>(workers_.size(), morsels);
+	const uint32_t first = next_worker_.fetch_add(1, std::memory_order_relaxed);
+
+	auto boundary = [&](uint64_t r) {
+		return std::min(row_count, morsels * r / ranges * task->MorselSize());
+	};
+	for (uint64_t r = 0; r < ranges; r++) {
+		Worker &worker = *workers_[(first + r) % workers_.size()];
+		Push(worker, {task, boundary(r), boundary(r + 1)});
+	}
+
+	Wake(true);
+	return task;
+}
+
+void Scheduler::Run(MorselFunction function, uint64_t row_count, uint64_t morsel_size,
+					const CancellationToken *token) {
+	Submit(std::move(function), row_count, morsel_size, token)->Wait();
+}
+
+void Scheduler::Push(Worker &worker, Range range) {
+	std::lock_guard<std::mutex> guard(worker.lock);
+	worker.queue.push_back(std::move(range));
+	pending_.fetch_add(1, std::memory_order_release);
+}
+
+void Scheduler::Wake(bool all) {
+	/** Taking the lock orders the queued work before the predicate check of a worker going idle */
+	{
+		std::lock_guard<std::mutex> guard(sleep_lock_);
+	}
+	if (all)
+		wake_.notify_all();
+	else
+		wake_.notify_one();
+}
+
+bool Scheduler::PopLocal(Worker &worker, std::shared_ptr<Task> &task, Morsel &morsel) {
+	std::lock_guard<std::mutex> guard(worker.lock);
+	if (worker.queue.empty())
+		return false;
+
+	Range &front = worker.queue.front();
+	task = front.task;
+	/** A failed or cancelled task gives up the rest of the range at once */
+	const uint64_t rows = task->Skipping() ? front.end - front.begin : task->MorselSize();
+	morsel = {front.begin, std::min(front.end, front.begin + rows)};
+	front.begin = morsel.end;
+
+	if (front.begin == front.end) {
+		worker.queue.pop_front();
+		pending_.fetch_sub(1, std::memory_order_release);
+	} else if (worker.queue.size() > 1) {
+		/** Let the next range (possibly of another query) go first */
+		worker.queue.push_back(std::move(front));
+		worker.queue.pop_front();
+	}
+	return true;
+}
+
+bool Scheduler::Steal(uint32_t id) {
+	const auto count = static_cast<uint32_t>(workers_.size());
+
+	for (uint32_t k = 1; k < count; k++) {
+		Worker &victim = *workers_[(id + k) % count];
+		Range stolen{};
+		bool split = false;
+		{
+			std::lock_guard<std::mutex> guard(victim.lock);
+			if (victim.queue.empty())
+				continue;
+
+			/** The back range was touched least recently by its owner */
+			Range &back = victim.queue.back();
+			const uint64_t rows = back.end - back.begin;
+			const uint64_t morsel_size = back.task->MorselSize();
+			if (rows >= 2 * morsel_size) {
+				/** Split on a morsel boundary so morsels keep holding whole batches */
+				const uint64_t mid = back.begin + rows / 2 / morsel_size * morsel_size;
+				stolen = {back.task, mid, back.end};
+				back.end = mid;
+				split = true;
+			} else {
+				stolen = std::move(back);
+				victim.queue.pop_back();
+				pending_.fetch_sub(1, std::memory_order_release);
+			}
+		}
+
+		TRACE_INSTANT("scheduler", "steal", stolen.end - stolen.begin);
+		Push(*workers_[id], std::move(stolen));
+		steals_.fetch_add(1, std::memory_order_relaxed);
+
+		/** A split leaves more work behind than this worker can take, let another one help */
+		if (split)
+			Wake(false);
+		return true;
+	}
+	return false;
+}
+
+void Scheduler::WorkerLoop(uint32_t id) {
+	Worker &worker = *workers_[id];
+	std::shared_ptr<Task> task;
+	Morsel morsel{};
+	TRACE_THREAD_NAME("worker " + std::to_string(id));
+
+	while (true) {
+		if (PopLocal(worker, task, morsel)) {
+			task->Execute(worker.context, id, morsel);
+			worker.context.Reset();
+			task.reset();
+			continue;
+		}
+		if (Steal(id))
+			continue;
+
+		TRACE_SCOPE("scheduler", "idle", 0);
+		std::unique_lock<std::mutex> lock(sleep_lock_);
+		auto has_work = [this]() { return pending_.load(std::memory_order_acquire) > 0; };
+		wake_.wait(lock, [&]() { return stop_ || has_work(); });
+		if (stop_ && !has_work())
+			return;
+	}
+}
+
+} // namespace electricdb
@@ -40,6 +40,13 @@ LogicalType AddExpr::Type() const {
 	return left_->Type();
 }
 
+void AddExpr::CollectColumns(std::vector<uint32_t> &columns) const {
+	if (left_)
+		left_->CollectColumns(columns);
+	if (right_)
+		right_->CollectColumns(columns);
+}
+
 SubExpr::SubExpr(Expression *left, Expression *right) : left_(left), right_(right) {}
 
 void SubExpr::Execute(ExecutionContext &ctx, Vector &result) {
@@ -76,6 +83,13 @@ LogicalType SubExpr::Type() const {
 	return left_->Type();
 }
 
+void SubExpr::CollectColumns(std::vector<uint32_t> &columns) const {
+	if (left_)
+		left_->CollectColumns(columns);
+	if (right_)
+		right_->CollectColumns(columns);
+}
+
 MultExpr::MultExpr(Expression *left, Expression *right) : left_(left), right_(right) {}
 
 void MultExpr::Execute(ExecutionContext &ctx, Vector &result) {
@@ -112,6 +126,13 @@ LogicalType MultExpr::Type() const {
 	return left_->Type();
 }
 
+void MultExpr::CollectColumns(std::vector<uint32_t> &columns) const {
+	if (left_)
+		left_->CollectColumns(columns);
+	if (right_)
+		right_->CollectColumns(columns);
+}
+
 DivExpr::DivExpr(Expression *left, Expression *right) : left_(left), right_(right) {}
 
 void DivExpr::Execute(ExecutionContext &ctx, Vector &result) {
@@ -147,4 +168,11 @@ LogicalType DivExpr::Type() const {
 
 	return left_->Type();
 }
+
+void DivExpr::CollectColumns(std::vector<uint32_t> &columns) const {
+	if (left_)
+		left_->CollectColumns(columns);
+	if (right_)
+		right_->CollectColumns(columns);
+}
 } // namespace electricdb
\ No newline at end of file
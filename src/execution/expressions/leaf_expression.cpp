@@ -17,6 +17,10 @@ LogicalType ColumnExpr::Type() const {
 	return type_;
 }
 
+void ColumnExpr::CollectColumns(std::vector<uint32_t> &columns) const {
+	columns.push_back(column_idx_);
+}
+
 ConstantExpr::ConstantExpr(const Value &value) : value_(value) {}
 
 void ConstantExpr::Execute(ExecutionContext &ctx, Vector &result) {
@@ -36,4 +40,6 @@ void ConstantExpr::Execute(ExecutionContext &ctx, Vector &result) {
 LogicalType ConstantExpr::Type() const {
 	return value_.GetType();
 }
+
+void ConstantExpr::CollectColumns(std::vector<uint32_t> &) const {}
 } // namespace electricdb
\ No newline at end of file
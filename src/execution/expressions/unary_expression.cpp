@@ -24,6 +24,10 @@ LogicalType NotExpr::Type() const {
 	return LogicalType::BOOL;
 }
 
+void NotExpr::CollectColumns(std::vector<uint32_t> &columns) const {
+	child_->CollectColumns(columns);
+}
+
 NegateExpr::NegateExpr(Expression *child) : child_(child) {}
 
 void NegateExpr::Execute(ExecutionContext &ctx, Vector &result) {
@@ -44,4 +48,8 @@ LogicalType NegateExpr::Type() const {
 	return child_->Type();
 }
 
+void NegateExpr::CollectColumns(std::vector<uint32_t> &columns) const {
+	child_->CollectColumns(columns);
+}
+
 } // namespace electricdb
\ No newline at end of file
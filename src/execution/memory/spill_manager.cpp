@@ -0,0 +1,35 @@
+#include "electricdb/execution/memory/spill_manager.h"
+
+#include <unistd.h>
+
+namespace electricdb {
+
+SpillFile::SpillFile(SpillManager &manager, std::string path)
+	: manager_(manager),
+	  file_(std::move(path), FILE_READ | FILE_WRITE | FILE_CREATE | FILE_TRUNCATE) {}
+
+SpillFile::~SpillFile() {
+	const std::string path = file_.Path();
+	file_.Close();
+	File::Remove(path);
+	manager_.bytes_on_disk_.fetch_sub(size_, std::memory_order_relaxed);
+}
+
+void SpillFile::Append(const void *data, size_t size) {
+	file_.Write(data, size, size_);
+	size_ += size;
+	manager_.bytes_spilled_.fetch_add(size, std::memory_order_relaxed);
+	manager_.bytes_on_disk_.fetch_add(size, std::memory_order_relaxed);
+}
+
+SpillManager::SpillManager(std::string directory) : directory_(std::move(directory)) {}
+
+std::unique_ptr<SpillFile> SpillManager::CreateSpillFile() {
+	const uint64_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
+	std::string path = directory_ + "/electricdb_spill_" + std::to_string(::getpid()) + "_" +
+					   std::to_string(reinterpret_cast<uintptr_t>(this)) + "_" +
+					   std::to_string(id) + ".tmp";
+	return std::make_unique<SpillFile>(*this, std::move(path));
+}
+
+} // namespace electricdb
@@ -0,0 +1,402 @@
+#include "electricdb/execution/operators/aggregate/aggregate.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace electricdb {
+
+static LogicalType ResolveResultType(AggregateType type, LogicalType input_type) {
+	switch (type) {
+	case AggregateType::COUNT_STAR:
+	case AggregateType::COUNT:
+		return LogicalType::INT64;
+	case AggregateType::SUM:
+		if (input_type == LogicalType::INT32 || input_type == LogicalType::INT64)
+			return LogicalType::INT64;
+		if (input_type == LogicalType::FLOAT || input_type == LogicalType::DOUBLE)
+			return LogicalType::DOUBLE;
+		break;
+	case AggregateType::AVG:
+		if (input_type != LogicalType::BOOL && input_type != LogicalType::STRING &&
+			input_type != LogicalType::INVALID)
+			return LogicalType::DOUBLE;
+		break;
+	case AggregateType::MIN:
+	case AggregateType::MAX:
+		if (input_type != LogicalType::STRING && input_type != LogicalType::INVALID)
+			return input_type;
+		break;
+	}
+	throw std::runtime_error("Unsupported aggregate input type!");
+}
+
+AggregateFunction::AggregateFunction(AggregateSpec spec, LogicalType input_type)
+	: spec_(spec), input_type_(input_type),
+	  result_type_(ResolveResultType(spec.type, input_type)) {}
+
+/**
+ * @brief Fold rows [begin, end) of a typed column into `state`
+ *
+ */
+template <typename T, AggregateType TYPE>
+static void UpdateLoop(AggregateState &state, const Vector &input, idx_t begin, idx_t end) {
+	/** Integers accumulate exactly in int64, everything else (and AVG) in double */
+	using Acc = std::conditional_t<std::is_integral_v<T> && TYPE != AggregateType::AVG, int64_t,
+								   double>;
+
+	const T *data = input.Data<T>();
+	const bool has_nulls = input.HasNulls();
+
+	Acc acc;
+	if constexpr (std::is_same_v<Acc, int64_t>)
+		acc = state.int_value;
+	else
+		acc = state.double_value;
+	int64_t count = state.count;
+
+	for (idx_t i = begin; i < end; i++) {
+		if (has_nulls && input.IsNull(i))
+			continue;
+		const auto v = static_cast<Acc>(data[i]);
+		if constexpr (TYPE == AggregateType::SUM || TYPE == AggregateType::AVG)
+			acc += v;
+		else if constexpr (TYPE == AggregateType::MIN)
+			acc = (count == 0 || v < acc) ? v : acc;
+		else if constexpr (TYPE == AggregateType::MAX)
+			acc = (count == 0 || v > acc) ? v : acc;
+		count++;
+	}
+
+	if constexpr (std::is_same_v<Acc, int64_t>)
+		state.int_value = acc;
+	else
+		state.double_value = acc;
+	state.count = count;
+}
+
+template <AggregateType TYPE>
+static void UpdateTyped(AggregateState &state, const Vector &input, idx_t begin, idx_t end) {
+	switch (input.Type()) {
+	case LogicalType::INT32:
+		UpdateLoop<int32_t, TYPE>(state, input, begin, end);
+		break;
+	case LogicalType::INT64:
+		UpdateLoop<int64_t, TYPE>(state, input, begin, end);
+		break;
+	case LogicalType::FLOAT:
+		UpdateLoop<float, TYPE>(state, input, begin, end);
+		break;
+	case LogicalType::DOUBLE:
+		UpdateLoop<double, TYPE>(state, input, begin, end);
+		break;
+	case LogicalType::BOOL:
+		if constexpr (TYPE == AggregateType::MIN || TYPE == AggregateType::MAX) {
+			UpdateLoop<bool, TYPE>(state, input, begin, end);
+			break;
+		}
+		[[fallthrough]];
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+void AggregateFunction::Update(AggregateState &state, const Vector &input, idx_t begin,
+							   idx_t end) const {
+	switch (spec_.type) {
+	case AggregateType::COUNT_STAR:
+		state.count += end - begin;
+		break;
+	case AggregateType::COUNT:
+		if (!input.HasNulls()) {
+			state.count += end - begin;
+			break;
+		}
+		for (idx_t i = begin; i < end; i++)
+			state.count += input.IsNull(i) ? 0 : 1;
+		break;
+	case AggregateType::SUM:
+		UpdateTyped<AggregateType::SUM>(state, input, begin, end);
+		break;
+	case AggregateType::AVG:
+		UpdateTyped<AggregateType::AVG>(state, input, begin, end);
+		break;
+	case AggregateType::MIN:
+		UpdateTyped<AggregateType::MIN>(state, input, begin, end);
+		break;
+	case AggregateType::MAX:
+		UpdateTyped<AggregateType::MAX>(state, input, begin, end);
+		break;
+	}
+}
+
+/**
+ * @brief Fold runs of a typed column into `state`, one step per run
+ *
+ */
+template <typename T, AggregateType TYPE>
+static void UpdateRunsLoop(AggregateState &state, const Vector &values, const uint32_t *lengths,
+						   idx_t runs) {
+	using Acc = std::conditional_t<std::is_integral_v<T> && TYPE != AggregateType::AVG, int64_t,
+								   double>;
+
+	const T *data = values.Data<T>();
+	const bool has_nulls = values.HasNulls();
+
+	Acc acc;
+	if constexpr (std::is_same_v<Acc, int64_t>)
+		acc = state.int_value;
+	else
+		acc = state.double_value;
+	int64_t count = state.count;
+
+	for (idx_t r = 0; r < runs; r++) {
+		if (has_nulls && values.IsNull(r))
+			continue;
+		const auto v = static_cast<Acc>(data[r]);
+		if constexpr (TYPE == AggregateType::SUM || TYPE == AggregateType::AVG)
+			acc += v * static_cast<Acc>(lengths[r]);
+		else if constexpr (TYPE == AggregateType::MIN)
+			acc = (count == 0 || v < acc) ? v : acc;
+		else if constexpr (TYPE == AggregateType::MAX)
+			acc = (count == 0 || v > acc) ? v : acc;
+		count += lengths[r];
+	}
+
+	if constexpr (std::is_same_v<Acc, int64_t>)
+		state.int_value = acc;
+	else
+		state.double_value = acc;
+	state.count = count;
+}
+
+template <AggregateType TYPE>
+static void UpdateRunsTyped(AggregateState &state, const Vector &values, const uint32_t *lengths,
+							idx_t runs) {
+	switch (values.Type()) {
+	case LogicalType::INT32:
+		UpdateRunsLoop<int32_t, TYPE>(state, values, lengths, runs);
+		break;
+	case LogicalType::INT64:
+		UpdateRunsLoop<int64_t, TYPE>(state, values, lengths, runs);
+		break;
+	case LogicalType::FLOAT:
+		UpdateRunsLoop<float, TYPE>(state, values, lengths, runs);
+		break;
+	case LogicalType::DOUBLE:
+		UpdateRunsLoop<double, TYPE>(state, values, lengths, runs);
+		break;
+	case LogicalType::BOOL:
+		if constexpr (TYPE == AggregateType::MIN || TYPE == AggregateType::MAX) {
+			UpdateRunsLoop<bool, TYPE>(state, values, lengths, runs);
+			break;
+		}
+		[[fallthrough]];
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+void AggregateFunction::UpdateRuns(AggregateState &state, const Vector &values,
+								   const uint32_t *lengths, idx_t runs) const {
+	switch (spec_.type) {
+	case AggregateType::COUNT_STAR:
+		for (idx_t r = 0; r < runs; r++)
+			state.count += lengths[r];
+		break;
+	case AggregateType::COUNT: {
+		const bool has_nulls = values.HasNulls();
+		for (idx_t r = 0; r < runs; r++)
+			state.count += (has_nulls && values.IsNull(r)) ? 0 : lengths[r];
+		break;
+	}
+	case AggregateType::SUM:
+		UpdateRunsTyped<AggregateType::SUM>(state, values, lengths, runs);
+		break;
+	case AggregateType::AVG:
+		UpdateRunsTyped<AggregateType::AVG>(state, values, lengths, runs);
+		break;
+	case AggregateType::MIN:
+		UpdateRunsTyped<AggregateType::MIN>(state, values, lengths, runs);
+		break;
+	case AggregateType::MAX:
+		UpdateRunsTyped<AggregateType::MAX>(state, values, lengths, runs);
+		break;
+	}
+}
+
+/**
+ * @brief Fold each row of a typed column into the state of its group
+ *
+ */
+template <typename T, AggregateType TYPE>
+static void ScatterLoop(AggregateState *states, size_t stride, const uint32_t *groups,
+						const Vector &input, idx_t count) {
+	const T *data = input.Data<T>();
+	const bool has_nulls = input.HasNulls();
+
+	for (idx_t i = 0; i < count; i++) {
+		if (has_nulls && input.IsNull(i))
+			continue;
+		AggregateState &state = states[static_cast<size_t>(groups[i]) * stride];
+		if constexpr (TYPE == AggregateType::AVG ||
+					  (TYPE == AggregateType::SUM && !std::is_integral_v<T>)) {
+			state.double_value += static_cast<double>(data[i]);
+		} else if constexpr (TYPE == AggregateType::SUM) {
+			state.int_value += static_cast<int64_t>(data[i]);
+		} else if constexpr (std::is_integral_v<T>) {
+			const auto v = static_cast<int64_t>(data[i]);
+			const bool take =
+					TYPE == AggregateType::MIN ? v < state.int_value : v > state.int_value;
+			state.int_value = (state.count == 0 || take) ? v : state.int_value;
+		} else {
+			const auto v = static_cast<double>(data[i]);
+			const bool take =
+					TYPE == AggregateType::MIN ? v < state.double_value : v > state.double_value;
+			state.double_value = (state.count == 0 || take) ? v : state.double_value;
+		}
+		state.count++;
+	}
+}
+
+template <AggregateType TYPE>
+static void ScatterTyped(AggregateState *states, size_t stride, const uint32_t *groups,
+						 const Vector &input, idx_t count) {
+	switch (input.Type()) {
+	case LogicalType::INT32:
+		ScatterLoop<int32_t, TYPE>(states, stride, groups, input, count);
+		break;
+	case LogicalType::INT64:
+		ScatterLoop<int64_t, TYPE>(states, stride, groups, input, count);
+		break;
+	case LogicalType::FLOAT:
+		ScatterLoop<float, TYPE>(states, stride, groups, input, count);
+		break;
+	case LogicalType::DOUBLE:
+		ScatterLoop<double, TYPE>(states, stride, groups, input, count);
+		break;
+	case LogicalType::BOOL:
+		if constexpr (TYPE == AggregateType::MIN || TYPE == AggregateType::MAX) {
+			ScatterLoop<bool, TYPE>(states, stride, groups, input, count);
+			break;
+		}
+		[[fallthrough]];
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+void AggregateFunction::Scatter(AggregateState *states, size_t stride, const uint32_t *groups,
+								const Vector &input, idx_t count) const {
+	switch (spec_.type) {
+	case AggregateType::COUNT_STAR:
+		for (idx_t i = 0; i < count; i++)
+			states[static_cast<size_t>(groups[i]) * stride].count++;
+		break;
+	case AggregateType::COUNT: {
+		const bool has_nulls = input.HasNulls();
+		for (idx_t i = 0; i < count; i++)
+			states[static_cast<size_t>(groups[i]) * stride].count +=
+					(has_nulls && input.IsNull(i)) ? 0 : 1;
+		break;
+	}
+	case AggregateType::SUM:
+		ScatterTyped<AggregateType::SUM>(states, stride, groups, input, count);
+		break;
+	case AggregateType::AVG:
+		ScatterTyped<AggregateType::AVG>(states, stride, groups, input, count);
+		break;
+	case AggregateType::MIN:
+		ScatterTyped<AggregateType::MIN>(states, stride, groups, input, count);
+		break;
+	case AggregateType::MAX:
+		ScatterTyped<AggregateType::MAX>(states, stride, groups, input, count);
+		break;
+	}
+}
+
+void AggregateFunction::Combine(AggregateState &target, const AggregateState &source) const {
+	const bool integral = input_type_ == LogicalType::INT32 || input_type_ == LogicalType::INT64 ||
+						  input_type_ == LogicalType::BOOL;
+
+	switch (spec_.type) {
+	case AggregateType::COUNT_STAR:
+	case AggregateType::COUNT:
+		break;
+	case AggregateType::SUM:
+		target.int_value += source.int_value;
+		target.double_value += source.double_value;
+		break;
+	case AggregateType::AVG:
+		target.double_value += source.double_value;
+		break;
+	case AggregateType::MIN:
+	case AggregateType::MAX: {
+		if (source.count == 0)
+			break;
+		if (target.count == 0) {
+			target.int_value = source.int_value;
+			target.double_value = source.double_value;
+			break;
+		}
+		const bool is_min = spec_.type == AggregateType::MIN;
+		if (integral) {
+			target.int_value = is_min ? std::min(target.int_value, source.int_value)
+									  : std::max(target.int_value, source.int_value);
+		} else {
+			target.double_value = is_min ? std::min(target.double_value, source.double_value)
+										 : std::max(target.double_value, source.double_value);
+		}
+		break;
+	}
+	}
+	target.count += source.count;
+}
+
+void AggregateFunction::Finalize(const AggregateState &state, Vector &result, idx_t row) const {
+	if (spec_.type == AggregateType::COUNT_STAR || spec_.type == AggregateType::COUNT) {
+		result.Data<int64_t>()[row] = state.count;
+		return;
+	}
+	if (state.count == 0) {
+		result.SetNull(row);
+		return;
+	}
+
+	switch (spec_.type) {
+	case AggregateType::SUM:
+		if (result_type_ == LogicalType::INT64)
+			result.Data<int64_t>()[row] = state.int_value;
+		else
+			result.Data<double>()[row] = state.double_value;
+		return;
+	case AggregateType::AVG:
+		result.Data<double>()[row] = state.double_value / static_cast<double>(state.count);
+		return;
+	default:
+		break;
+	}
+
+	/** MIN / MAX keep the input type */
+	switch (result_type_) {
+	case LogicalType::INT32:
+		result.Data<int32_t>()[row] = static_cast<int32_t>(state.int_value);
+		break;
+	case LogicalType::INT64:
+		result.Data<int64_t>()[row] = state.int_value;
+		break;
+	case LogicalType::FLOAT:
+		result.Data<float>()[row] = static_cast<float>(state.double_value);
+		break;
+	case LogicalType::DOUBLE:
+		result.Data<double>()[row] = state.double_value;
+		break;
+	case LogicalType::BOOL:
+		result.Data<bool>()[row] = state.int_value != 0;
+		break;
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+} // namespace electricdb
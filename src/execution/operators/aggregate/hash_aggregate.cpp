@@ -0,0 +1,364 @@
+#include "electricdb/execution/operators/aggregate/hash_aggregate.h"
+#include "electricdb/util/hash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace electricdb {
+
+/**
+ * @brief Groups stored row-wise: a fixed-width key, its hash and one state per aggregate.
+ *
+ * A key holds a null byte followed by the value bytes for every group column, with zeroed value
+ * bytes for nulls and float values in canonical form (see CanonicalizeFloat()), so equal keys
+ * compare equal with memcmp.
+ */
+struct GroupedAggregateTable {
+	static constexpr uint32_t EMPTY = UINT32_MAX;
+
+	GroupedAggregateTable(size_t key_width, size_t aggregate_count)
+		: key_width(key_width), aggregate_count(aggregate_count), slots(1024, EMPTY) {}
+
+	uint32_t GroupCount() const noexcept { return static_cast<uint32_t>(hashes.size()); }
+
+	const uint8_t *Key(uint32_t group) const { return keys.data() + group * key_width; }
+
+	AggregateState *States(uint32_t group) { return states.data() + group * aggregate_count; }
+
+	/** @brief Group of `key`, created with fresh states if it does not exist yet */
+	uint32_t FindOrCreate(const uint8_t *key, uint64_t hash) {
+		/** Keep the load factor at or below 1/2 */
+		if ((hashes.size() + 1) * 2 > slots.size())
+			Grow();
+
+		const size_t mask = slots.size() - 1;
+		for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+			probe_steps++;
+			const uint32_t group = slots[slot];
+			if (group == EMPTY) {
+				slots[slot] = GroupCount();
+				keys.insert(keys.end(), key, key + key_width);
+				hashes.push_back(hash);
+				states.resize(states.size() + aggregate_count);
+				return slots[slot];
+			}
+			if (hashes[group] == hash &&
+				(key_width == 0 || std::memcmp(Key(group), key, key_width) == 0))
+				return group;
+		}
+	}
+
+	void Grow() {
+		slots.assign(slots.size() * 2, EMPTY);
+		const size_t mask = slots.size() - 1;
+		for (uint32_t group = 0; group < GroupCount(); group++) {
+			size_t slot = hashes[group] & mask;
+			while (slots[slot] != EMPTY)
+				slot = (slot + 1) & mask;
+			slots[slot] = group;
+		}
+	}
+
+	size_t key_width;
+	size_t aggregate_count;
+	std::vector<uint8_t> keys;
+	std::vector<uint64_t> hashes;
+	std::vector<AggregateState> states;
+	std::vector<uint32_t> slots;
+	/** @brief Slots visited by FindOrCreate() so far */
+	uint64_t probe_steps = 0;
+};
+
+struct HashAggregateSinkState : public LocalSinkState {
+	explicit HashAggregateSinkState(GroupedAggregateTable table) : table(std::move(table)) {}
+
+	GroupedAggregateTable table;
+	/** @brief Keys and groups of the chunk being sunk */
+	std::vector<uint8_t> keys;
+	std::vector<uint32_t> groups;
+	/** @brief Group of every dictionary code of the chunk being sunk, EMPTY until looked up */
+	std::vector<uint32_t> code_groups;
+};
+
+PhysicalHashAggregate::PhysicalHashAggregate(std::vector<LogicalType> input_types,
+											 std::vector<uint32_t> group_columns,
+											 std::vector<AggregateSpec> aggregates)
+	: PhysicalOperator(PhysicalOperatorType::HASH_AGGREGATE, {}),
+	  input_types_(std::move(input_types)), group_columns_(std::move(group_columns)) {
+	size_t key_width = 0;
+	for (auto column : group_columns_) {
+		if (column >= input_types_.size() || input_types_[column] == LogicalType::STRING)
+			throw std::runtime_error("Unsupported group column!");
+		types_.push_back(input_types_[column]);
+		key_width += 1 + GetTypeSize(input_types_[column]);
+	}
+	for (const auto &spec : aggregates) {
+		const bool has_input = spec.type != AggregateType::COUNT_STAR;
+		if (has_input && spec.column_idx >= input_types_.size())
+			throw std::runtime_error("Aggregate column out of range!");
+		functions_.emplace_back(spec, has_input ? input_types_[spec.column_idx]
+												: LogicalType::INVALID);
+		types_.push_back(functions_.back().ResultType());
+	}
+	table_ = std::make_unique<GroupedAggregateTable>(key_width, functions_.size());
+}
+
+PhysicalHashAggregate::~PhysicalHashAggregate() = default;
+
+bool PhysicalHashAggregate::AcceptsDictionary(idx_t column) const {
+	if (group_columns_.size() != 1 || group_columns_[0] != column)
+		return false;
+	return std::all_of(functions_.begin(), functions_.end(), [column](const auto &function) {
+		const AggregateSpec &spec = function.Spec();
+		return spec.type == AggregateType::COUNT_STAR || spec.type == AggregateType::COUNT ||
+			   spec.column_idx != column;
+	});
+}
+
+std::unique_ptr<LocalSinkState> PhysicalHashAggregate::InitLocalSink() const {
+	return std::make_unique<HashAggregateSinkState>(
+			GroupedAggregateTable(table_->key_width, functions_.size()));
+}
+
+/**
+ * @brief Rewrite the float key value at `value` the way its sort key sees it, so that equal keys
+ * (see KeyEquals()) have equal bits: -0.0 becomes 0.0 and every NaN the one quiet NaN
+ *
+ */
+template <typename T>
+static void CanonicalizeFloat(uint8_t *value) {
+	T v;
+	std::memcpy(&v, value, sizeof(T));
+	if (v == T(0))
+		v = T(0);
+	else if (std::isnan(v))
+		v = std::numeric_limits<T>::quiet_NaN();
+	std::memcpy(value, &v, sizeof(T));
+}
+
+static void CanonicalizeKey(LogicalType type, uint8_t *value) {
+	if (type == LogicalType::FLOAT)
+		CanonicalizeFloat<float>(value);
+	else if (type == LogicalType::DOUBLE)
+		CanonicalizeFloat<double>(value);
+}
+
+/**
+ * @brief Write the null byte and value of every row of `column` into the keys at `offset`
+ *
+ */
+static void EncodeColumn(const Vector &column, idx_t count, uint8_t *keys, size_t key_width,
+						 size_t offset) {
+	const LogicalType type = column.Type();
+	const size_t width = GetTypeSize(type);
+	const auto *data = static_cast<const uint8_t *>(column.RawData());
+	const bool has_nulls = column.HasNulls();
+	const bool is_float = type == LogicalType::FLOAT || type == LogicalType::DOUBLE;
+
+	for (idx_t i = 0; i < count; i++) {
+		uint8_t *key = keys + i * key_width + offset;
+		const bool is_null = has_nulls && column.IsNull(i);
+		key[0] = is_null ? 1 : 0;
+		if (is_null) {
+			std::memset(key + 1, 0, width);
+			continue;
+		}
+		std::memcpy(key + 1, data + i * width, width);
+		if (is_float)
+			CanonicalizeKey(type, key + 1);
+	}
+}
+
+/**
+ * @brief Find or create the group of every row of a dictionary vector. Codes are looked up in
+ * the table the first time a row has them, so entries no row refers to create no group. A
+ * dictionary with more entries than the batch has rows is not worth a group per code, its rows
+ * are looked up one by one.
+ *
+ * @return idx_t Number of table lookups
+ */
+static idx_t FindGroupsByCode(const Vector &column, idx_t count, HashAggregateSinkState &local) {
+	GroupedAggregateTable &table = local.table;
+	const Vector &dictionary = column.Dictionary();
+	const size_t width = GetTypeSize(column.Type());
+	const auto *entries = static_cast<const uint8_t *>(dictionary.RawData());
+	const sel_t *codes = column.Codes();
+	uint8_t *key = local.keys.data();
+
+	const bool by_code = dictionary.Size() <= count;
+	if (by_code)
+		local.code_groups.assign(dictionary.Size(), GroupedAggregateTable::EMPTY);
+	uint32_t null_group = GroupedAggregateTable::EMPTY;
+	idx_t lookups = 0;
+	/** Entries such as 0.0 and -0.0 are distinct codes of one group */
+	auto find = [&](sel_t code) {
+		key[0] = 0;
+		std::memcpy(key + 1, entries + static_cast<size_t>(code) * width, width);
+		CanonicalizeKey(column.Type(), key + 1);
+		lookups++;
+		return table.FindOrCreate(key, Hash::key(key, table.key_width));
+	};
+	for (idx_t i = 0; i < count; i++) {
+		if (column.HasNulls() && column.IsNull(i)) {
+			if (null_group == GroupedAggregateTable::EMPTY) {
+				key[0] = 1;
+				std::memset(key + 1, 0, width);
+				null_group = table.FindOrCreate(key, Hash::key(key, table.key_width));
+				lookups++;
+			}
+			local.groups[i] = null_group;
+			continue;
+		}
+		if (!by_code) {
+			local.groups[i] = find(codes[i]);
+			continue;
+		}
+		uint32_t &group = local.code_groups[codes[i]];
+		if (group == GroupedAggregateTable::EMPTY)
+			group = find(codes[i]);
+		local.groups[i] = group;
+	}
+	return lookups;
+}
+
+void PhysicalHashAggregate::Sink(ExecutionContext &ctx, LocalSinkState &state,
+								 const std::vector<Vector> &chunk) {
+	auto &local = static_cast<HashAggregateSinkState &>(state);
+	GroupedAggregateTable &table = local.table;
+	const idx_t count = chunk[0].Size();
+	const size_t key_width = table.key_width;
+
+	local.keys.resize(count * key_width);
+	local.groups.resize(count);
+
+	if (group_columns_.empty()) {
+		/** A single group, no keys to hash */
+		const uint8_t empty_key = 0;
+		std::fill(local.groups.begin(), local.groups.end(),
+				  table.FindOrCreate(&empty_key, Hash::key(&empty_key, 0)));
+		UpdateAggregates(table, chunk, local.groups.data(), count);
+		return;
+	}
+
+	const uint64_t steps = table.probe_steps;
+	if (chunk[group_columns_[0]].IsDictionary()) {
+		/** Only distinct codes probe the table */
+		const idx_t lookups = FindGroupsByCode(chunk[group_columns_[0]], count, local);
+		if (auto *metrics = ctx.Metrics()) {
+			metrics->probes += lookups;
+			metrics->probe_steps += table.probe_steps - steps;
+		}
+		UpdateAggregates(table, chunk, local.groups.data(), count);
+		return;
+	}
+
+	size_t offset = 0;
+	for (auto column : group_columns_) {
+		EncodeColumn(chunk[column], count, local.keys.data(), key_width, offset);
+		offset += 1 + GetTypeSize(chunk[column].Type());
+	}
+
+	for (idx_t i = 0; i < count; i++) {
+		const uint8_t *key = local.keys.data() + i * key_width;
+		local.groups[i] = table.FindOrCreate(key, Hash::key(key, key_width));
+	}
+	if (auto *metrics = ctx.Metrics()) {
+		metrics->probes += count;
+		metrics->probe_steps += table.probe_steps - steps;
+	}
+
+	UpdateAggregates(table, chunk, local.groups.data(), count);
+}
+
+void PhysicalHashAggregate::UpdateAggregates(GroupedAggregateTable &table,
+											 const std::vector<Vector> &chunk,
+											 const uint32_t *groups, idx_t count) const {
+	/** Groups are all created, so the state array no longer moves */
+	for (size_t a = 0; a < functions_.size(); a++) {
+		const AggregateFunction &function = functions_[a];
+		const Vector &input = chunk[function.Spec().type == AggregateType::COUNT_STAR
+											? 0
+											: function.Spec().column_idx];
+		/** Run vectors only come without group columns, every row is in the first group */
+		if (input.IsRuns()) {
+			const Vector &values = input.RunValues();
+			AggregateState &state =
+					table.states[static_cast<size_t>(groups[0]) * functions_.size() + a];
+			function.UpdateRuns(state, values, input.RunLengths(), values.Size());
+			continue;
+		}
+		function.Scatter(table.states.data() + a, functions_.size(), groups, input, count);
+	}
+}
+
+void PhysicalHashAggregate::Combine(LocalSinkState &state) {
+	GroupedAggregateTable &local = static_cast<HashAggregateSinkState &>(state).table;
+
+	std::lock_guard<std::mutex> guard(lock_);
+	for (uint32_t group = 0; group < local.GroupCount(); group++) {
+		const uint32_t target = table_->FindOrCreate(local.Key(group), local.hashes[group]);
+		AggregateState *target_states = table_->States(target);
+		const AggregateState *source_states = local.States(group);
+		for (size_t a = 0; a < functions_.size(); a++)
+			functions_[a].Combine(target_states[a], source_states[a]);
+	}
+}
+
+void PhysicalHashAggregate::Finalize(Scheduler &, const CancellationToken *) {
+	/** An aggregate without GROUP BY produces one row, even over no input */
+	if (group_columns_.empty() && table_->GroupCount() == 0) {
+		const uint8_t empty_key = 0;
+		table_->FindOrCreate(&empty_key, Hash::key(&empty_key, 0));
+	}
+}
+
+void PhysicalHashAggregate::Abort() {
+	table_ = std::make_unique<GroupedAggregateTable>(table_->key_width, functions_.size());
+}
+
+uint64_t PhysicalHashAggregate::SourceRowCount() const {
+	return table_->GroupCount();
+}
+
+/**
+ * @brief Decode column `offset` of the keys of groups [first, first + count) into `out`
+ *
+ */
+static void DecodeColumn(const GroupedAggregateTable &table, uint32_t first, idx_t count,
+						 size_t offset, Vector &out) {
+	const size_t width = GetTypeSize(out.Type());
+	auto *data = static_cast<uint8_t *>(out.RawData());
+
+	for (idx_t i = 0; i < count; i++) {
+		const uint8_t *key = table.Key(first + i) + offset;
+		std::memcpy(data + i * width, key + 1, width);
+		if (key[0])
+			out.SetNull(i);
+	}
+}
+
+void PhysicalHashAggregate::GetData(ExecutionContext &, LocalSourceState &, uint64_t offset,
+									idx_t count, std::vector<Vector> &out) const {
+	for (auto &vec : out) {
+		vec.SetSize(count);
+		vec.ClearNulls();
+	}
+
+	const auto first = static_cast<uint32_t>(offset);
+	size_t key_offset = 0;
+	for (size_t g = 0; g < group_columns_.size(); g++) {
+		DecodeColumn(*table_, first, count, key_offset, out[g]);
+		key_offset += 1 + GetTypeSize(out[g].Type());
+	}
+
+	for (size_t a = 0; a < functions_.size(); a++) {
+		Vector &result = out[group_columns_.size() + a];
+		for (idx_t i = 0; i < count; i++)
+			functions_[a].Finalize(table_->States(first + i)[a], result, i);
+	}
+}
+
+} // namespace electricdb
@@ -0,0 +1,135 @@
+#include "electricdb/execution/operators/aggregate/physical_streaming_aggregate.h"
+
+#include <algorithm>
+
+namespace electricdb {
+
+struct StreamingAggregateSinkState : public LocalSinkState {
+	std::unique_ptr<Arena> arena = std::make_unique<Arena>();
+	/** @brief Output of Execute(), reused for every sunk chunk */
+	std::vector<Vector> scratch;
+	/** @brief One range per morsel this worker sank, the last is the current one */
+	std::vector<StreamingAggregateRange> ranges;
+};
+
+PhysicalStreamingAggregate::PhysicalStreamingAggregate(std::vector<LogicalType> input_types,
+													   std::vector<uint32_t> group_columns,
+													   const std::vector<AggregateSpec> &aggregates)
+	: PhysicalOperator(PhysicalOperatorType::STREAMING_AGGREGATE, {}),
+	  aggregate_(std::move(input_types), std::move(group_columns), aggregates) {
+	types_ = aggregate_.OutputTypes();
+}
+
+std::unique_ptr<LocalSinkState> PhysicalStreamingAggregate::InitLocalSink() const {
+	return std::make_unique<StreamingAggregateSinkState>();
+}
+
+/**
+ * @brief Append the first `count` groups of `groups` to `chunks`, filling the room left in the
+ * last chunk before allocating one of `capacity` rows
+ *
+ */
+static void AppendGroups(const std::vector<LogicalType> &types, const std::vector<Vector> &groups,
+						 idx_t count, idx_t capacity, Arena &arena,
+						 std::vector<std::vector<Vector>> &chunks) {
+	for (idx_t done = 0; done < count;) {
+		if (chunks.empty() || chunks.back()[0].Size() == chunks.back()[0].Capacity())
+			chunks.push_back(PhysicalOperator::MakeChunk(types, capacity, arena));
+		auto &chunk = chunks.back();
+		const idx_t target = chunk[0].Size();
+		const idx_t n = std::min<idx_t>(count - done, chunk[0].Capacity() - target);
+		for (size_t c = 0; c < chunk.size(); c++) {
+			chunk[c].SetSize(target + n);
+			chunk[c].Copy(groups[c], done, n, target);
+		}
+		done += n;
+	}
+}
+
+void PhysicalStreamingAggregate::Sink(ExecutionContext &ctx, LocalSinkState &state,
+									  const std::vector<Vector> &chunk) {
+	auto &local = static_cast<StreamingAggregateSinkState &>(state);
+	if (local.ranges.empty() || local.ranges.back().begin != local.morsel_index) {
+		StreamingAggregateRange range;
+		range.begin = local.morsel_index;
+		range.state = aggregate_.InitState();
+		range.state.hold_first_group = true;
+		local.ranges.push_back(std::move(range));
+	}
+	auto &range = local.ranges.back();
+
+	const idx_t count = chunk[0].Size();
+	if (local.scratch.empty() || local.scratch[0].Capacity() < count)
+		local.scratch = MakeChunk(types_, std::max<idx_t>(count, ctx.VectorSize()), *local.arena);
+
+	const idx_t groups = aggregate_.Execute(range.state, chunk, local.scratch);
+	AppendGroups(types_, local.scratch, groups, ctx.VectorSize(), *local.arena, range.chunks);
+}
+
+void PhysicalStreamingAggregate::Combine(LocalSinkState &state) {
+	auto &local = static_cast<StreamingAggregateSinkState &>(state);
+
+	std::lock_guard<std::mutex> guard(lock_);
+	for (auto &range : local.ranges)
+		ranges_.push_back(std::move(range));
+	arenas_.push_back(std::move(local.arena));
+	local.ranges.clear();
+}
+
+void PhysicalStreamingAggregate::Finalize(Scheduler &, const CancellationToken *) {
+	std::sort(ranges_.begin(), ranges_.end(),
+			  [](const StreamingAggregateRange &a, const StreamingAggregateRange &b) {
+				  return a.begin < b.begin;
+			  });
+
+	/** The groups at the boundaries go into chunks of their own, between those of the ranges */
+	arenas_.push_back(std::make_unique<Arena>());
+	Arena &arena = *arenas_.back();
+	auto append = [&](std::vector<Vector> chunk) {
+		if (chunk[0].Size() == 0)
+			return;
+		starts_.push_back(starts_.back() + chunk[0].Size());
+		chunks_.push_back(std::move(chunk));
+	};
+
+	StreamingAggregateState state = aggregate_.InitState();
+	for (auto &range : ranges_) {
+		std::vector<Vector> boundary = MakeChunk(types_, 2, arena);
+		aggregate_.Continue(state, range.state, boundary);
+		append(std::move(boundary));
+		for (auto &chunk : range.chunks)
+			append(std::move(chunk));
+	}
+	std::vector<Vector> last = MakeChunk(types_, 1, arena);
+	aggregate_.Flush(state, last);
+	append(std::move(last));
+	ranges_.clear();
+}
+
+void PhysicalStreamingAggregate::Abort() {
+	ranges_.clear();
+	chunks_.clear();
+	arenas_.clear();
+	starts_.assign(1, 0);
+}
+
+void PhysicalStreamingAggregate::GetData(ExecutionContext &, LocalSourceState &, uint64_t offset,
+										 idx_t count, std::vector<Vector> &out) const {
+	for (auto &vec : out) {
+		vec.Reset();
+		vec.SetSize(count);
+	}
+	for (idx_t target = 0; target < count;) {
+		const auto chunk = static_cast<size_t>(
+				std::upper_bound(starts_.begin(), starts_.end(), offset + target) -
+				starts_.begin() - 1);
+		const auto row = static_cast<idx_t>(offset + target - starts_[chunk]);
+		const auto n = static_cast<idx_t>(
+				std::min<uint64_t>(count - target, starts_[chunk + 1] - offset - target));
+		for (size_t c = 0; c < out.size(); c++)
+			out[c].Copy(chunks_[chunk][c], row, n, target);
+		target += n;
+	}
+}
+
+} // namespace electricdb
@@ -0,0 +1,344 @@
+#include "electricdb/execution/operators/aggregate/streaming_aggregate.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace electricdb {
+
+/**
+ * @brief Set boundaries[i] to 1 where row i of `col` differs from row i - 1
+ *
+ */
+template <typename T>
+static void MarkColumn(const Vector &col, idx_t count, uint8_t *boundaries) {
+	const T *data = col.Data<T>();
+
+	if (!col.HasNulls()) {
+		for (idx_t i = 1; i < count; i++)
+			boundaries[i] |= static_cast<uint8_t>(!KeyEquals(data[i], data[i - 1]));
+		return;
+	}
+
+	for (idx_t i = 1; i < count; i++) {
+		const bool cur_null = col.IsNull(i);
+		const bool prev_null = col.IsNull(i - 1);
+		const bool differs =
+			cur_null != prev_null || (!cur_null && !KeyEquals(data[i], data[i - 1]));
+		boundaries[i] |= static_cast<uint8_t>(differs);
+	}
+}
+
+/** @brief Whether the first row of `col` equals the group value stored at `value` */
+template <typename T>
+static bool FirstRowEquals(const Vector &col, const uint8_t *value) {
+	T stored;
+	std::memcpy(&stored, value, sizeof(T));
+	return KeyEquals(col.Data<T>()[0], stored);
+}
+
+/** @brief Whether the group values stored at `a` and `b` are equal */
+template <typename T>
+static bool StoredEquals(const uint8_t *a, const uint8_t *b) {
+	T a_value;
+	T b_value;
+	std::memcpy(&a_value, a, sizeof(T));
+	std::memcpy(&b_value, b, sizeof(T));
+	return KeyEquals(a_value, b_value);
+}
+
+StreamingAggregateOperator::StreamingAggregateOperator(std::vector<LogicalType> types,
+													   std::vector<uint32_t> group_columns,
+													   const std::vector<AggregateSpec> &aggregates)
+	: types_(std::move(types)), group_columns_(std::move(group_columns)) {
+	for (uint32_t column : group_columns_) {
+		if (column >= types_.size())
+			throw std::runtime_error("Group column does not exist!");
+		group_offsets_.push_back(group_width_);
+		group_width_ += GetTypeSize(types_[column]);
+		output_types_.push_back(types_[column]);
+	}
+
+	for (const auto &spec : aggregates) {
+		LogicalType input_type = LogicalType::INVALID;
+		if (spec.type != AggregateType::COUNT_STAR) {
+			if (spec.column_idx >= types_.size())
+				throw std::runtime_error("Aggregate input column does not exist!");
+			input_type = types_[spec.column_idx];
+		}
+		aggregates_.emplace_back(spec, input_type);
+		output_types_.push_back(aggregates_.back().ResultType());
+	}
+}
+
+StreamingAggregateState StreamingAggregateOperator::InitState() const {
+	StreamingAggregateState state;
+	state.group_values.resize(group_width_);
+	state.group_nulls.resize(group_columns_.size());
+	state.aggregates.resize(aggregates_.size());
+	state.first_values.resize(group_width_);
+	state.first_nulls.resize(group_columns_.size());
+	state.first_aggregates.resize(aggregates_.size());
+	return state;
+}
+
+void StreamingAggregateOperator::MarkBoundaries(StreamingAggregateState &state,
+												const std::vector<Vector> &chunk,
+												idx_t count) const {
+	state.boundaries.assign(count, 0);
+	uint8_t *boundaries = state.boundaries.data();
+
+	for (uint32_t column : group_columns_) {
+		const Vector &col = chunk[column];
+		switch (col.Type()) {
+		case LogicalType::INT32:
+			MarkColumn<int32_t>(col, count, boundaries);
+			break;
+		case LogicalType::INT64:
+			MarkColumn<int64_t>(col, count, boundaries);
+			break;
+		case LogicalType::FLOAT:
+			MarkColumn<float>(col, count, boundaries);
+			break;
+		case LogicalType::DOUBLE:
+			MarkColumn<double>(col, count, boundaries);
+			break;
+		case LogicalType::BOOL:
+			MarkColumn<bool>(col, count, boundaries);
+			break;
+		default:
+			throw std::runtime_error("Unsupported type!");
+		}
+	}
+}
+
+bool StreamingAggregateOperator::ContinuesOpenGroup(const StreamingAggregateState &state,
+													const std::vector<Vector> &chunk) const {
+	for (size_t g = 0; g < group_columns_.size(); g++) {
+		const Vector &col = chunk[group_columns_[g]];
+		const bool is_null = col.HasNulls() && col.IsNull(0);
+		if (is_null != static_cast<bool>(state.group_nulls[g]))
+			return false;
+		if (is_null)
+			continue;
+
+		const uint8_t *value = state.group_values.data() + group_offsets_[g];
+		bool equal;
+		switch (col.Type()) {
+		case LogicalType::INT32:
+			equal = FirstRowEquals<int32_t>(col, value);
+			break;
+		case LogicalType::INT64:
+			equal = FirstRowEquals<int64_t>(col, value);
+			break;
+		case LogicalType::FLOAT:
+			equal = FirstRowEquals<float>(col, value);
+			break;
+		case LogicalType::DOUBLE:
+			equal = FirstRowEquals<double>(col, value);
+			break;
+		case LogicalType::BOOL:
+			equal = FirstRowEquals<bool>(col, value);
+			break;
+		default:
+			throw std::runtime_error("Unsupported type!");
+		}
+		if (!equal)
+			return false;
+	}
+	return true;
+}
+
+void StreamingAggregateOperator::OpenGroup(StreamingAggregateState &state,
+										   const std::vector<Vector> &chunk, idx_t row) const {
+	for (size_t g = 0; g < group_columns_.size(); g++) {
+		const Vector &col = chunk[group_columns_[g]];
+		const uint32_t width = GetTypeSize(col.Type());
+		std::memcpy(state.group_values.data() + group_offsets_[g],
+					col.RawData() + static_cast<size_t>(row) * width, width);
+		state.group_nulls[g] = (col.HasNulls() && col.IsNull(row)) ? 1 : 0;
+	}
+	std::fill(state.aggregates.begin(), state.aggregates.end(), AggregateState{});
+	state.has_open_group = true;
+}
+
+void StreamingAggregateOperator::EmitGroup(const StreamingAggregateState &state,
+										   std::vector<Vector> &out, idx_t row) const {
+	for (size_t g = 0; g < group_columns_.size(); g++) {
+		Vector &vec = out[g];
+		const uint32_t width = GetTypeSize(vec.Type());
+		std::memcpy(vec.RawData() + static_cast<size_t>(row) * width,
+					state.group_values.data() + group_offsets_[g], width);
+		if (state.group_nulls[g])
+			vec.SetNull(row);
+	}
+	for (size_t a = 0; a < aggregates_.size(); a++)
+		aggregates_[a].Finalize(state.aggregates[a], out[group_columns_.size() + a], row);
+}
+
+void StreamingAggregateOperator::CloseGroup(StreamingAggregateState &state,
+											std::vector<Vector> &out, idx_t &emitted) const {
+	if (state.hold_first_group && !state.has_first_group) {
+		/** Swapped, the open group's buffers are overwritten by the next OpenGroup() */
+		state.first_values.swap(state.group_values);
+		state.first_nulls.swap(state.group_nulls);
+		state.first_aggregates.swap(state.aggregates);
+		state.has_first_group = true;
+	} else {
+		EmitGroup(state, out, emitted++);
+	}
+	state.has_open_group = false;
+}
+
+bool StreamingAggregateOperator::StoredKeysEqual(const uint8_t *a_values, const uint8_t *a_nulls,
+												 const uint8_t *b_values,
+												 const uint8_t *b_nulls) const {
+	for (size_t g = 0; g < group_columns_.size(); g++) {
+		if (a_nulls[g] != b_nulls[g])
+			return false;
+		if (a_nulls[g])
+			continue;
+
+		const uint8_t *a = a_values + group_offsets_[g];
+		const uint8_t *b = b_values + group_offsets_[g];
+		bool equal;
+		switch (types_[group_columns_[g]]) {
+		case LogicalType::INT32:
+			equal = StoredEquals<int32_t>(a, b);
+			break;
+		case LogicalType::INT64:
+			equal = StoredEquals<int64_t>(a, b);
+			break;
+		case LogicalType::FLOAT:
+			equal = StoredEquals<float>(a, b);
+			break;
+		case LogicalType::DOUBLE:
+			equal = StoredEquals<double>(a, b);
+			break;
+		case LogicalType::BOOL:
+			equal = StoredEquals<bool>(a, b);
+			break;
+		default:
+			throw std::runtime_error("Unsupported type!");
+		}
+		if (!equal)
+			return false;
+	}
+	return true;
+}
+
+idx_t StreamingAggregateOperator::Execute(StreamingAggregateState &state,
+										  const std::vector<Vector> &chunk,
+										  std::vector<Vector> &out) const {
+	if (chunk.empty() || chunk[0].Size() == 0)
+		return 0;
+
+	const idx_t count = chunk[0].Size();
+#ifndef NDEBUG
+	assert(out.size() == output_types_.size());
+	assert(out[0].Capacity() >= count);
+#endif
+	for (auto &vec : out) {
+		vec.SetSize(vec.Capacity());
+		vec.ClearNulls();
+	}
+
+	MarkBoundaries(state, chunk, count);
+	const uint8_t *boundaries = state.boundaries.data();
+
+	idx_t emitted = 0;
+	if (state.has_open_group && !ContinuesOpenGroup(state, chunk))
+		CloseGroup(state, out, emitted);
+
+	idx_t start = 0;
+	while (start < count) {
+		/** The next boundary after `start`, found with a byte scan over the boundary flags */
+		const void *next = std::memchr(boundaries + start + 1, 1, count - start - 1);
+		const idx_t end =
+				next ? static_cast<idx_t>(static_cast<const uint8_t *>(next) - boundaries) : count;
+
+		if (!state.has_open_group)
+			OpenGroup(state, chunk, start);
+		for (size_t a = 0; a < aggregates_.size(); a++) {
+			const Vector &input = chunk[aggregates_[a].Spec().column_idx];
+			aggregates_[a].Update(state.aggregates[a], input, start, end);
+		}
+
+		/** The last run of the chunk stays open, the next chunk may continue it */
+		if (end < count)
+			CloseGroup(state, out, emitted);
+		start = end;
+	}
+
+	for (auto &vec : out)
+		vec.SetSize(emitted);
+	return emitted;
+}
+
+idx_t StreamingAggregateOperator::Flush(StreamingAggregateState &state,
+										std::vector<Vector> &out) const {
+	if (!state.has_open_group)
+		return 0;
+
+	for (auto &vec : out) {
+		vec.SetSize(1);
+		vec.ClearNulls();
+	}
+	EmitGroup(state, out, 0);
+	state.has_open_group = false;
+	return 1;
+}
+
+idx_t StreamingAggregateOperator::Continue(StreamingAggregateState &state,
+										   StreamingAggregateState &next,
+										   std::vector<Vector> &out) const {
+#ifndef NDEBUG
+	assert(!state.hold_first_group);
+	assert(out[0].Capacity() >= 2);
+#endif
+	for (auto &vec : out) {
+		vec.SetSize(2);
+		vec.ClearNulls();
+	}
+
+	/** Without a held first group `next` is one group, open at both ends */
+	const bool has_first = next.has_first_group;
+	auto &values = has_first ? next.first_values : next.group_values;
+	auto &nulls = has_first ? next.first_nulls : next.group_nulls;
+	auto &aggregates = has_first ? next.first_aggregates : next.aggregates;
+
+	idx_t emitted = 0;
+	if (has_first || next.has_open_group) {
+		if (state.has_open_group && StoredKeysEqual(state.group_values.data(),
+													state.group_nulls.data(), values.data(),
+													nulls.data())) {
+			for (size_t a = 0; a < aggregates_.size(); a++)
+				aggregates_[a].Combine(state.aggregates[a], aggregates[a]);
+		} else {
+			if (state.has_open_group)
+				EmitGroup(state, out, emitted++);
+			state.group_values.swap(values);
+			state.group_nulls.swap(nulls);
+			state.aggregates.swap(aggregates);
+			state.has_open_group = true;
+		}
+	}
+
+	/** The first group of `next` ends inside it, the open group of `next` may go on */
+	if (has_first) {
+		EmitGroup(state, out, emitted++);
+		state.group_values.swap(next.group_values);
+		state.group_nulls.swap(next.group_nulls);
+		state.aggregates.swap(next.aggregates);
+		state.has_open_group = next.has_open_group;
+	}
+	next.has_first_group = false;
+	next.has_open_group = false;
+
+	for (auto &vec : out)
+		vec.SetSize(emitted);
+	return emitted;
+}
+
+} // namespace electricdb
@@ -0,0 +1,205 @@
+#include "electricdb/execution/operators/filter/filter.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace electricdb {
+
+/**
+ * @brief Selection of the qualifying rows, sized for the largest chunk seen so far
+ *
+ */
+struct FilterState : public OperatorState {
+	Arena arena;
+	SelectionVector sel;
+	/** @brief The chunk the predicate sees, with flat copies of the dictionary columns it reads */
+	std::vector<Vector> flat;
+	std::vector<Vector> view;
+	/** @brief Gathered codes of the dictionary columns, one per column */
+	std::vector<SelectionVector> codes;
+	/** @brief 1 for every dictionary entry that satisfies the predicate */
+	std::vector<uint8_t> qualifies;
+	/** @brief Values and lengths of the qualifying runs, when the predicate reads a run vector */
+	std::vector<Vector> run_values;
+	std::vector<uint32_t> run_lengths;
+	SelectionVector runs;
+	idx_t capacity = 0;
+};
+
+PhysicalFilter::PhysicalFilter(std::vector<LogicalType> types, Expression *predicate)
+	: PhysicalOperator(PhysicalOperatorType::FILTER, std::move(types)), predicate_(predicate) {
+	if (!predicate_ || predicate_->Type() != LogicalType::BOOL)
+		throw std::runtime_error("Filter predicate must be of type BOOL!");
+	predicate_->CollectColumns(columns_);
+	std::sort(columns_.begin(), columns_.end());
+	columns_.erase(std::unique(columns_.begin(), columns_.end()), columns_.end());
+}
+
+std::unique_ptr<OperatorState> PhysicalFilter::InitOperatorState() const {
+	return std::make_unique<FilterState>();
+}
+
+/**
+ * @brief Evaluate the predicate once per entry of the dictionary vector `column`, then select
+ * the rows whose code qualifies. NULL rows never do.
+ *
+ */
+static idx_t SelectByCode(ExecutionContext &ctx, Expression &predicate, uint32_t column,
+						  const std::vector<Vector> &input, FilterState &filter) {
+	const Vector &rows = input[column];
+	const Vector &dictionary = rows.Dictionary();
+	const idx_t entries = dictionary.Size();
+	const idx_t count = rows.Size();
+	/** Only NULL rows in a chunk without entries */
+	if (entries == 0)
+		return 0;
+
+	/** The predicate reads no other column of the view */
+	filter.view[column].Reference(dictionary);
+	ctx.SetInput(&filter.view);
+	Vector &mask = ctx.GetTempVector(LogicalType::BOOL);
+	mask.SetSize(entries);
+	predicate.Execute(ctx, mask);
+
+	const bool *values = mask.Data<bool>();
+	filter.qualifies.resize(entries);
+	for (idx_t i = 0; i < entries; i++)
+		filter.qualifies[i] = (values[i] && !(mask.HasNulls() && mask.IsNull(i))) ? 1 : 0;
+
+	const uint8_t *qualifies = filter.qualifies.data();
+	const sel_t *codes = rows.Codes();
+	sel_t *sel = filter.sel.Data();
+	idx_t selected = 0;
+	if (!rows.HasNulls()) {
+		for (idx_t i = 0; i < count; i++) {
+			sel[selected] = i;
+			selected += qualifies[codes[i]];
+		}
+	} else {
+		for (idx_t i = 0; i < count; i++) {
+			sel[selected] = i;
+			selected += rows.IsNull(i) ? 0 : qualifies[codes[i]];
+		}
+	}
+	return selected;
+}
+
+/**
+ * @brief Evaluate the predicate once per run of the run vector `column`, then select the rows of
+ * the qualifying runs. The values and lengths of those runs are kept in `filter.run_values` and
+ * `filter.run_lengths`.
+ *
+ */
+static idx_t SelectByRun(ExecutionContext &ctx, Expression &predicate, uint32_t column,
+						 const std::vector<Vector> &input, FilterState &filter) {
+	const Vector &rows = input[column];
+	const Vector &values = rows.RunValues();
+	const uint32_t *lengths = rows.RunLengths();
+	const idx_t runs = values.Size();
+
+	/** The predicate reads no other column of the view */
+	filter.view[column].Reference(values);
+	ctx.SetInput(&filter.view);
+	Vector &mask = ctx.GetTempVector(LogicalType::BOOL);
+	mask.SetSize(runs);
+	predicate.Execute(ctx, mask);
+
+	const bool *qualifies = mask.Data<bool>();
+	sel_t *sel = filter.sel.Data();
+	sel_t *kept_runs = filter.runs.Data();
+	idx_t selected = 0;
+	idx_t kept = 0;
+	for (idx_t r = 0, start = 0; r < runs; start += lengths[r++]) {
+		if (!qualifies[r] || (mask.HasNulls() && mask.IsNull(r)))
+			continue;
+		for (idx_t i = 0; i < lengths[r]; i++)
+			sel[selected++] = start + i;
+		kept_runs[kept] = r;
+		filter.run_lengths[kept++] = lengths[r];
+	}
+	filter.run_values[0].Gather(values, filter.runs, kept);
+	return selected;
+}
+
+OperatorResult PhysicalFilter::Execute(ExecutionContext &ctx, const std::vector<Vector> &input,
+									   std::vector<Vector> &output, OperatorState &state) const {
+	auto &filter = static_cast<FilterState &>(state);
+	const idx_t count = input[0].Size();
+	if (filter.capacity < count) {
+		filter.sel = SelectionVector(filter.arena, count);
+		filter.flat = MakeChunk(types_, count, filter.arena);
+		filter.view = MakeChunk(types_, count, filter.arena);
+		filter.codes.clear();
+		for (size_t c = 0; c < types_.size(); c++)
+			filter.codes.emplace_back(filter.arena, count);
+		filter.run_values.clear();
+		if (columns_.size() == 1)
+			filter.run_values.emplace_back(types_[columns_[0]], count, filter.arena);
+		filter.run_lengths.resize(count);
+		filter.runs = SelectionVector(filter.arena, count);
+		filter.capacity = count;
+	}
+
+	sel_t *sel = filter.sel.Data();
+	idx_t selected = 0;
+	const bool runs = columns_.size() == 1 && input[columns_[0]].IsRuns();
+	const bool dictionaries = std::any_of(columns_.begin(), columns_.end(),
+										  [&input](uint32_t c) { return input[c].IsDictionary(); });
+	if (runs) {
+		selected = SelectByRun(ctx, *predicate_, columns_[0], input, filter);
+	} else if (dictionaries && columns_.size() == 1 &&
+		input[columns_[0]].Dictionary().Size() <= count) {
+		selected = SelectByCode(ctx, *predicate_, columns_[0], input, filter);
+	} else {
+		if (dictionaries) {
+			FlattenColumns(input, columns_, filter.flat, filter.view);
+			ctx.SetInput(&filter.view);
+		} else {
+			ctx.SetInput(&input);
+		}
+		Vector &mask = ctx.GetTempVector(LogicalType::BOOL);
+		mask.SetSize(count);
+		predicate_->Execute(ctx, mask);
+
+		const bool *values = mask.Data<bool>();
+		if (!mask.HasNulls()) {
+			for (idx_t i = 0; i < count; i++) {
+				sel[selected] = i;
+				selected += values[i] ? 1 : 0;
+			}
+		} else {
+			for (idx_t i = 0; i < count; i++) {
+				sel[selected] = i;
+				selected += (values[i] && !mask.IsNull(i)) ? 1 : 0;
+			}
+		}
+	}
+
+	for (size_t c = 0; c < output.size(); c++) {
+		const Vector &column = input[c];
+		if (column.IsRuns()) {
+			/** Only the predicate column, its qualifying runs are passed on whole */
+			output[c].ReferenceRuns(filter.run_values[0], filter.run_lengths.data(), selected);
+			continue;
+		}
+		if (!column.IsDictionary()) {
+			output[c].Gather(column, filter.sel, selected);
+			continue;
+		}
+		/** Gather the codes, the dictionary is shared */
+		const sel_t *codes = column.Codes();
+		sel_t *gathered = filter.codes[c].Data();
+		for (idx_t i = 0; i < selected; i++)
+			gathered[i] = codes[sel[i]];
+		output[c].ReferenceDictionary(column.Dictionary(), gathered, selected);
+		if (!column.HasNulls())
+			continue;
+		for (idx_t i = 0; i < selected; i++) {
+			if (column.IsNull(sel[i]))
+				output[c].SetNull(i);
+		}
+	}
+	return OperatorResult::NEED_MORE_INPUT;
+}
+
+} // namespace electricdb
@@ -0,0 +1,230 @@
+#include "electricdb/execution/operators/join/join.h"
+#include "electricdb/util/hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace electricdb {
+
+struct HashJoinSinkState : public LocalSinkState {
+	std::vector<uint8_t> rows;
+	std::vector<uint64_t> hashes;
+	/** @brief Keys and null-key flags of the chunk being sunk */
+	std::vector<uint8_t> keys;
+	std::vector<uint8_t> valid;
+};
+
+/**
+ * @brief Probe position within the current input chunk, kept across HAVE_MORE_OUTPUT
+ *
+ */
+struct HashJoinProbeState : public OperatorState {
+	Arena arena;
+	/** @brief Whether the current input chunk still has matches to emit */
+	bool active = false;
+	idx_t row = 0;
+	std::vector<uint8_t> keys;
+	std::vector<uint8_t> valid;
+	/** @brief Next build row to check per probe row */
+	std::vector<uint32_t> candidates;
+	SelectionVector probe_sel;
+	std::vector<uint32_t> build_rows;
+	idx_t capacity = 0;
+};
+
+PhysicalHashJoin::PhysicalHashJoin(std::vector<LogicalType> probe_types,
+								   std::vector<LogicalType> build_types,
+								   std::vector<uint32_t> probe_keys,
+								   std::vector<uint32_t> build_keys)
+	: PhysicalOperator(PhysicalOperatorType::HASH_JOIN, probe_types),
+	  probe_types_(std::move(probe_types)), build_types_(std::move(build_types)),
+	  probe_keys_(std::move(probe_keys)), build_keys_(std::move(build_keys)) {
+	if (probe_keys_.empty() || probe_keys_.size() != build_keys_.size())
+		throw std::runtime_error("Join requires matching probe and build keys!");
+
+	for (size_t k = 0; k < probe_keys_.size(); k++) {
+		if (probe_keys_[k] >= probe_types_.size() || build_keys_[k] >= build_types_.size())
+			throw std::runtime_error("Join key out of range!");
+		const LogicalType type = probe_types_[probe_keys_[k]];
+		if (type != build_types_[build_keys_[k]] || type == LogicalType::STRING)
+			throw std::runtime_error("Unsupported join key types!");
+		key_width_ += GetTypeSize(type);
+	}
+
+	row_width_ = key_width_;
+	for (auto type : build_types_) {
+		if (type == LogicalType::STRING)
+			throw std::runtime_error("Unsupported type!");
+		types_.push_back(type);
+		row_width_ += 1 + GetTypeSize(type);
+	}
+}
+
+void PhysicalHashJoin::EncodeKeys(const std::vector<Vector> &chunk,
+								  const std::vector<uint32_t> &key_columns, uint8_t *keys,
+								  uint8_t *valid) const {
+	const idx_t count = chunk[0].Size();
+	std::memset(valid, 1, count);
+
+	size_t offset = 0;
+	for (auto column : key_columns) {
+		const Vector &vec = chunk[column];
+		const size_t width = GetTypeSize(vec.Type());
+		const uint8_t *data = vec.RawData();
+		const bool has_nulls = vec.HasNulls();
+
+		for (idx_t i = 0; i < count; i++) {
+			std::memcpy(keys + i * key_width_ + offset, data + i * width, width);
+			if (has_nulls && vec.IsNull(i))
+				valid[i] = 0;
+		}
+		offset += width;
+	}
+}
+
+std::unique_ptr<LocalSinkState> PhysicalHashJoin::InitLocalSink() const {
+	return std::make_unique<HashJoinSinkState>();
+}
+
+void PhysicalHashJoin::Sink(ExecutionContext &, LocalSinkState &state,
+							const std::vector<Vector> &chunk) {
+	auto &local = static_cast<HashJoinSinkState &>(state);
+	const idx_t count = chunk[0].Size();
+
+	local.keys.resize(count * key_width_);
+	local.valid.resize(count);
+	EncodeKeys(chunk, build_keys_, local.keys.data(), local.valid.data());
+
+	for (idx_t i = 0; i < count; i++) {
+		if (!local.valid[i])
+			continue;
+
+		const uint8_t *key = local.keys.data() + i * key_width_;
+		const size_t start = local.rows.size();
+		local.rows.resize(start + row_width_);
+		uint8_t *row = local.rows.data() + start;
+		std::memcpy(row, key, key_width_);
+		row += key_width_;
+
+		for (const auto &vec : chunk) {
+			const size_t width = GetTypeSize(vec.Type());
+			row[0] = vec.IsNull(i) ? 1 : 0;
+			std::memcpy(row + 1, vec.RawData() + i * width, width);
+			row += 1 + width;
+		}
+		local.hashes.push_back(Hash::key(key, key_width_));
+	}
+}
+
+void PhysicalHashJoin::Combine(LocalSinkState &state) {
+	auto &local = static_cast<HashJoinSinkState &>(state);
+
+	std::lock_guard<std::mutex> guard(lock_);
+	rows_.insert(rows_.end(), local.rows.begin(), local.rows.end());
+	hashes_.insert(hashes_.end(), local.hashes.begin(), local.hashes.end());
+	local.rows.clear();
+	local.hashes.clear();
+}
+
+void PhysicalHashJoin::Finalize(Scheduler &, const CancellationToken *) {
+	size_t buckets = 1;
+	while (buckets < 2 * hashes_.size())
+		buckets *= 2;
+
+	heads_.assign(buckets, EMPTY);
+	next_.resize(hashes_.size());
+	const size_t mask = buckets - 1;
+	for (uint32_t row = 0; row < hashes_.size(); row++) {
+		uint32_t &head = heads_[hashes_[row] & mask];
+		next_[row] = head;
+		head = row;
+	}
+}
+
+void PhysicalHashJoin::Abort() {
+	std::vector<uint8_t>().swap(rows_);
+	std::vector<uint64_t>().swap(hashes_);
+	std::vector<uint32_t>().swap(heads_);
+	std::vector<uint32_t>().swap(next_);
+}
+
+std::unique_ptr<OperatorState> PhysicalHashJoin::InitOperatorState() const {
+	return std::make_unique<HashJoinProbeState>();
+}
+
+OperatorResult PhysicalHashJoin::Execute(ExecutionContext &ctx, const std::vector<Vector> &input,
+										 std::vector<Vector> &output, OperatorState &state) const {
+	auto &probe = static_cast<HashJoinProbeState &>(state);
+	const idx_t count = input[0].Size();
+	const idx_t capacity = output[0].Capacity();
+
+	if (probe.capacity < capacity) {
+		probe.probe_sel = SelectionVector(probe.arena, capacity);
+		probe.build_rows.resize(capacity);
+		probe.capacity = capacity;
+	}
+
+	/** A new input chunk: look up the bucket of every probe row */
+	if (!probe.active) {
+		probe.keys.resize(count * key_width_);
+		probe.valid.resize(count);
+		probe.candidates.resize(count);
+		EncodeKeys(input, probe_keys_, probe.keys.data(), probe.valid.data());
+
+		const size_t mask = heads_.size() - 1;
+		for (idx_t i = 0; i < count; i++) {
+			const uint64_t hash = Hash::key(probe.keys.data() + i * key_width_, key_width_);
+			probe.candidates[i] = probe.valid[i] ? heads_[hash & mask] : EMPTY;
+		}
+		probe.row = 0;
+		probe.active = true;
+		if (auto *metrics = ctx.Metrics())
+			metrics->probes += count;
+	}
+
+	sel_t *probe_sel = probe.probe_sel.Data();
+	idx_t matches = 0;
+	uint64_t steps = 0;
+	for (; probe.row < count && matches < capacity; probe.row++) {
+		const uint8_t *key = probe.keys.data() + probe.row * key_width_;
+		uint32_t &candidate = probe.candidates[probe.row];
+		for (; candidate != EMPTY && matches < capacity; candidate = next_[candidate]) {
+			steps++;
+			if (std::memcmp(rows_.data() + candidate * row_width_, key, key_width_) != 0)
+				continue;
+			probe_sel[matches] = probe.row;
+			probe.build_rows[matches] = candidate;
+			matches++;
+		}
+		/** The output is full in the middle of a chain, resume at this row */
+		if (candidate != EMPTY)
+			break;
+	}
+	probe.active = probe.row < count;
+	if (auto *metrics = ctx.Metrics())
+		metrics->probe_steps += steps;
+
+	for (size_t c = 0; c < probe_types_.size(); c++)
+		output[c].Gather(input[c], probe.probe_sel, matches);
+
+	size_t offset = key_width_;
+	for (size_t b = 0; b < build_types_.size(); b++) {
+		Vector &out = output[probe_types_.size() + b];
+		const size_t width = GetTypeSize(out.Type());
+		uint8_t *data = out.RawData();
+		out.SetSize(matches);
+		out.ClearNulls();
+		for (idx_t j = 0; j < matches; j++) {
+			const uint8_t *value = rows_.data() + probe.build_rows[j] * row_width_ + offset;
+			std::memcpy(data + j * width, value + 1, width);
+			if (value[0])
+				out.SetNull(j);
+		}
+		offset += 1 + width;
+	}
+
+	return probe.active ? OperatorResult::HAVE_MORE_OUTPUT : OperatorResult::NEED_MORE_INPUT;
+}
+
+} // namespace electricdb
@@ -0,0 +1,59 @@
+#include "electricdb/execution/operators/out/out.h"
+
+#include <algorithm>
+
+namespace electricdb {
+
+struct ResultCollectorSinkState : public LocalSinkState {
+	std::unique_ptr<Arena> arena = std::make_unique<Arena>();
+	std::vector<std::pair<uint64_t, std::vector<Vector>>> batches;
+};
+
+PhysicalResultCollector::PhysicalResultCollector(std::vector<LogicalType> types)
+	: PhysicalOperator(PhysicalOperatorType::RESULT_COLLECTOR, std::move(types)) {}
+
+std::unique_ptr<LocalSinkState> PhysicalResultCollector::InitLocalSink() const {
+	return std::make_unique<ResultCollectorSinkState>();
+}
+
+void PhysicalResultCollector::Sink(ExecutionContext &, LocalSinkState &state,
+								   const std::vector<Vector> &chunk) {
+	auto &local = static_cast<ResultCollectorSinkState &>(state);
+	const idx_t count = chunk[0].Size();
+
+	std::vector<Vector> copy = MakeChunk(types_, count, *local.arena);
+	for (size_t c = 0; c < copy.size(); c++) {
+		copy[c].SetSize(count);
+		copy[c].Copy(chunk[c], 0, count);
+	}
+	local.batches.emplace_back(local.batch_index, std::move(copy));
+}
+
+void PhysicalResultCollector::Combine(LocalSinkState &state) {
+	auto &local = static_cast<ResultCollectorSinkState &>(state);
+
+	std::lock_guard<std::mutex> guard(lock_);
+	for (auto &[batch_index, chunk] : local.batches)
+		batches_.push_back({batch_index, std::move(chunk)});
+	arenas_.push_back(std::move(local.arena));
+	local.batches.clear();
+}
+
+void PhysicalResultCollector::Finalize(Scheduler &, const CancellationToken *) {
+	/** Chunks of one batch come from one worker, which appended them in order */
+	std::stable_sort(batches_.begin(), batches_.end(), [](const Batch &a, const Batch &b) {
+		return a.batch_index < b.batch_index;
+	});
+
+	count_ = 0;
+	for (const auto &batch : batches_)
+		count_ += batch.chunk[0].Size();
+}
+
+void PhysicalResultCollector::Abort() {
+	batches_.clear();
+	arenas_.clear();
+	count_ = 0;
+}
+
+} // namespace electricdb
@@ -0,0 +1,110 @@
+#include "electricdb/execution/operators/projection/projection.h"
+
+#include <algorithm>
+
+namespace electricdb {
+
+/**
+ * @brief Result buffers of the computed columns, sized for the largest chunk seen so far
+ *
+ */
+struct ProjectionState : public OperatorState {
+	Arena arena;
+	std::vector<Vector> buffers;
+	/** @brief Results of expressions evaluated on dictionary entries, and their buffers */
+	std::vector<Vector> entries;
+	std::vector<Vector> entry_buffers;
+	/** @brief The chunk expressions see, with flat copies of the dictionary columns they read */
+	std::vector<Vector> flat;
+	std::vector<Vector> view;
+	idx_t capacity = 0;
+};
+
+static std::vector<LogicalType> ExpressionTypes(const std::vector<Expression *> &expressions) {
+	std::vector<LogicalType> types;
+	for (auto *expr : expressions)
+		types.push_back(expr->Type());
+	return types;
+}
+
+PhysicalProjection::PhysicalProjection(std::vector<Expression *> expressions)
+	: PhysicalOperator(PhysicalOperatorType::PROJECTION, ExpressionTypes(expressions)),
+	  expressions_(std::move(expressions)) {
+	for (auto *expr : expressions_) {
+		std::vector<uint32_t> columns;
+		expr->CollectColumns(columns);
+		std::sort(columns.begin(), columns.end());
+		columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+		columns_.push_back(std::move(columns));
+	}
+}
+
+std::unique_ptr<OperatorState> PhysicalProjection::InitOperatorState() const {
+	return std::make_unique<ProjectionState>();
+}
+
+OperatorResult PhysicalProjection::Execute(ExecutionContext &ctx, const std::vector<Vector> &input,
+										   std::vector<Vector> &output,
+										   OperatorState &state) const {
+	auto &projection = static_cast<ProjectionState &>(state);
+	const idx_t count = input[0].Size();
+	if (projection.capacity < count) {
+		std::vector<LogicalType> input_types;
+		for (const auto &vec : input)
+			input_types.push_back(vec.Type());
+		projection.buffers = MakeChunk(types_, count, projection.arena);
+		projection.entries = MakeChunk(types_, count, projection.arena);
+		projection.entry_buffers = MakeChunk(types_, count, projection.arena);
+		projection.flat = MakeChunk(input_types, count, projection.arena);
+		projection.view = MakeChunk(input_types, count, projection.arena);
+		projection.capacity = count;
+	}
+
+	for (size_t i = 0; i < expressions_.size(); i++) {
+		/** Point the output at an owned buffer first, a column reference replaces it again */
+		Vector &buffer = projection.buffers[i];
+		buffer.SetSize(count);
+		buffer.ClearNulls();
+		output[i].Reference(buffer);
+
+		const std::vector<uint32_t> &columns = columns_[i];
+		const bool dictionaries =
+				std::any_of(columns.begin(), columns.end(),
+							[&input](uint32_t c) { return input[c].IsDictionary(); });
+		if (!dictionaries) {
+			ctx.SetInput(&input);
+			expressions_[i]->Execute(ctx, output[i]);
+			continue;
+		}
+		const Vector &column = input[columns[0]];
+		if (columns.size() > 1 || column.Dictionary().Size() > count) {
+			FlattenColumns(input, columns, projection.flat, projection.view);
+			ctx.SetInput(&projection.view);
+			expressions_[i]->Execute(ctx, output[i]);
+			continue;
+		}
+
+		/** Evaluate on the entries, the rows keep their codes */
+		const Vector &dictionary = column.Dictionary();
+		Vector &entries = projection.entries[i];
+		projection.entry_buffers[i].SetSize(dictionary.Size());
+		projection.entry_buffers[i].ClearNulls();
+		entries.Reference(projection.entry_buffers[i]);
+		projection.view[columns[0]].Reference(dictionary);
+		ctx.SetInput(&projection.view);
+		expressions_[i]->Execute(ctx, entries);
+
+		const sel_t *codes = column.Codes();
+		output[i].ReferenceDictionary(entries, codes, count);
+		if (!column.HasNulls() && !entries.HasNulls())
+			continue;
+		for (idx_t r = 0; r < count; r++) {
+			if ((column.HasNulls() && column.IsNull(r)) ||
+				(entries.HasNulls() && entries.IsNull(codes[r])))
+				output[i].SetNull(r);
+		}
+	}
+	return OperatorResult::NEED_MORE_INPUT;
+}
+
+} // namespace electricdb
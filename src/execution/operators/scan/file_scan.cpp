@@ -0,0 +1,559 @@
+#include "electricdb/execution/operators/scan/file_scan.h"
+#include "electricdb/execution/operators/sort/physical_top_n.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace electricdb {
+
+static constexpr idx_t NO_ROW_GROUP = std::numeric_limits<idx_t>::max();
+
+/**
+ * @brief Per-worker scan state. READ and DIRECT keep the decoded chunks of one row group, or
+ * with a buffer manager pin them and view them. MMAP keeps the vectors that view the mapping,
+ * buffers for batches that span two row groups and the decoded encoded chunks. Filtered scans
+ * also keep the qualifying rows of one row group, scans that produce dictionary vectors the
+ * entries and codes of the dictionary chunks in `columns`, scans that produce run vectors the
+ * runs of the RLE chunks in `columns` and the runs of the current batch.
+ */
+struct FileScanState : public LocalSourceState {
+	Arena arena;
+	/** @brief Aligned fetch buffers of the row group being loaded, DIRECT only */
+	Arena io;
+	/** @brief Row group in `columns` or `views` (READ, DIRECT) or last one prefetched (MMAP) */
+	idx_t row_group = NO_ROW_GROUP;
+	std::vector<Vector> columns;
+	std::vector<Vector> views;
+	std::vector<Vector> buffers;
+	/** @brief Chunks `views` point into, with a buffer manager */
+	std::vector<BufferHandle> pins;
+	/** @brief Token of the batch being produced, observed while waiting for pins */
+	const CancellationToken *token = nullptr;
+	/** @brief Row group decoded into each of `columns`, MMAP only */
+	std::vector<idx_t> decoded;
+	idx_t capacity = 0;
+	/** @brief Row group whose qualifying rows are the first `selected` of `selection` */
+	idx_t selected_group = NO_ROW_GROUP;
+	idx_t selected = 0;
+	SelectionVector selection;
+	/** @brief Rows that pass one more filter, intersected into `selection` */
+	SelectionVector matches;
+	/** @brief Qualifying rows of the batch piece being gathered */
+	SelectionVector batch;
+	std::vector<DictionaryChunk> dictionaries;
+	std::vector<RunChunk> runs;
+	/** @brief Row after each run of the run vectors in `columns`, one list per column */
+	std::vector<std::vector<uint32_t>> run_ends;
+	/** @brief Values and lengths of the runs a batch overlaps, one per column */
+	std::vector<Vector> batch_runs;
+	std::vector<std::vector<uint32_t>> batch_lengths;
+};
+
+static std::vector<LogicalType> ColumnTypes(const ColumnFileReader &reader,
+											const std::vector<idx_t> &column_ids) {
+	const FileMetadata &metadata = reader.Metadata();
+	std::vector<LogicalType> types;
+	for (idx_t id : column_ids) {
+		if (id >= metadata.columns.size())
+			throw std::runtime_error("Column out of range!");
+		types.push_back(metadata.columns[id].type);
+	}
+	return types;
+}
+
+PhysicalFileScan::PhysicalFileScan(const ColumnFileReader &reader, std::vector<idx_t> column_ids,
+								   FileScanMode mode, uint64_t direct_threshold)
+	: PhysicalOperator(PhysicalOperatorType::FILE_SCAN, ColumnTypes(reader, column_ids)),
+	  reader_(reader), column_ids_(std::move(column_ids)), mode_(mode) {
+	uint64_t rows = 0;
+	for (const auto &row_group : reader_.Metadata().row_groups) {
+		row_group_starts_.push_back(rows);
+		rows += row_group.row_count;
+		max_row_group_ = std::max(max_row_group_, row_group.row_count);
+		for (idx_t id : column_ids_)
+			scan_bytes_ += row_group.columns[id].size;
+	}
+	row_group_starts_.push_back(rows);
+
+	if (mode_ == FileScanMode::AUTO)
+		mode_ = scan_bytes_ >= direct_threshold ? FileScanMode::DIRECT : FileScanMode::MMAP;
+	if (mode_ == FileScanMode::DIRECT) {
+		for (idx_t group = 0; group < reader_.RowGroupCount(); group++) {
+			uint64_t bytes = 0;
+			for (const ChunkRead &read : reader_.PlanReads(group, column_ids_))
+				bytes += ColumnFileReader::DirectReadSize(read);
+			max_fetch_bytes_ = std::max(max_fetch_bytes_, bytes);
+		}
+	}
+
+	if (mode_ == FileScanMode::MMAP) {
+		mapping_ = MappedFile(reader_.Path());
+		mapping_.Advise(AccessHint::SEQUENTIAL);
+	}
+}
+
+void PhysicalFileScan::EnablePrefetch(AsyncReader &io, uint32_t depth, uint64_t max_bytes) {
+	if (mode_ != FileScanMode::READ && mode_ != FileScanMode::DIRECT)
+		throw std::runtime_error("Only READ and DIRECT scans prefetch!");
+	if (buffers_)
+		throw std::runtime_error("Scans through a buffer manager do not prefetch!");
+	if (Filtered())
+		throw std::runtime_error("Filtered scans do not prefetch!");
+	if (dictionary_vectors_)
+		throw std::runtime_error("Dictionary vector scans do not prefetch!");
+	if (run_vectors_)
+		throw std::runtime_error("Run vector scans do not prefetch!");
+	prefetcher_ = std::make_unique<ChunkPrefetcher>(reader_, column_ids_, io, depth, max_bytes,
+													mode_ == FileScanMode::DIRECT);
+}
+
+void PhysicalFileScan::EnableBufferManager(BufferManager &buffers, uint32_t workers) {
+	if (mode_ != FileScanMode::READ && mode_ != FileScanMode::DIRECT)
+		throw std::runtime_error("Only READ and DIRECT scans use a buffer manager!");
+	if (prefetcher_)
+		throw std::runtime_error("Prefetching scans do not use a buffer manager!");
+	if (dictionary_vectors_)
+		throw std::runtime_error("Dictionary vector scans do not use a buffer manager!");
+	if (run_vectors_)
+		throw std::runtime_error("Run vector scans do not use a buffer manager!");
+
+	/** Every worker pins a whole row group, in frames as the buffer manager counts them */
+	const uint64_t frame = buffers.FrameSize();
+	uint64_t max_frames = 0;
+	for (idx_t g = 0; g < reader_.Metadata().row_groups.size(); g++) {
+		uint64_t frames = 0;
+		for (idx_t id : column_ids_)
+			frames += std::max<uint64_t>((reader_.DecodedChunkSize(g, id) + frame - 1) / frame, 1);
+		max_frames = std::max(max_frames, frames);
+	}
+	if (max_frames * frame * workers > buffers.MemoryLimit())
+		throw std::runtime_error("Buffer manager cannot hold a row group per worker!");
+	buffers_ = &buffers;
+	file_id_ = buffers.RegisterFile(reader_.Path());
+}
+
+void PhysicalFileScan::AddFilter(idx_t column, ColumnPredicate predicate) {
+	if (column >= column_ids_.size())
+		throw std::runtime_error("Column out of range!");
+	if (!predicate.Fits(types_[column]))
+		throw std::runtime_error("Predicate does not match the column type!");
+	if (prefetcher_)
+		throw std::runtime_error("Filtered scans do not prefetch!");
+	filters_.push_back({column, std::move(predicate)});
+}
+
+void PhysicalFileScan::SetTopN(idx_t column, const PhysicalTopN &top_n) {
+	if (column >= column_ids_.size())
+		throw std::runtime_error("Column out of range!");
+	if (top_n.Types()[top_n.BoundaryColumn()] != types_[column])
+		throw std::runtime_error("Top-N key does not match the column type!");
+	if (prefetcher_)
+		throw std::runtime_error("Filtered scans do not prefetch!");
+	top_n_ = &top_n;
+	top_n_column_ = column;
+}
+
+void PhysicalFileScan::EnableDictionaryVectors() {
+	if (mode_ != FileScanMode::READ && mode_ != FileScanMode::DIRECT)
+		throw std::runtime_error("Only READ and DIRECT scans produce dictionary vectors!");
+	if (prefetcher_)
+		throw std::runtime_error("Prefetching scans produce no dictionary vectors!");
+	if (buffers_)
+		throw std::runtime_error("Scans through a buffer manager produce no dictionary vectors!");
+	dictionary_vectors_ = true;
+}
+
+void PhysicalFileScan::EnableRunVectors() {
+	if (mode_ != FileScanMode::READ && mode_ != FileScanMode::DIRECT)
+		throw std::runtime_error("Only READ and DIRECT scans produce run vectors!");
+	if (prefetcher_)
+		throw std::runtime_error("Prefetching scans produce no run vectors!");
+	if (buffers_)
+		throw std::runtime_error("Scans through a buffer manager produce no run vectors!");
+	run_vectors_ = true;
+}
+
+std::unique_ptr<LocalSourceState> PhysicalFileScan::InitLocalSource() const {
+	auto state = std::make_unique<FileScanState>();
+	if (Filtered()) {
+		state->selection = SelectionVector(state->arena, max_row_group_);
+		state->matches = SelectionVector(state->arena, max_row_group_);
+	}
+	if (buffers_) {
+		state->views = MakeChunk(types_, max_row_group_, state->arena);
+		return state;
+	}
+	if (mode_ == FileScanMode::MMAP) {
+		/** Filtered batches are gathered from views of whole row groups */
+		if (Filtered())
+			state->views = MakeChunk(types_, max_row_group_, state->arena);
+		return state;
+	}
+	state->columns = MakeChunk(types_, max_row_group_, state->arena);
+	if (dictionary_vectors_) {
+		for (LogicalType type : types_)
+			state->dictionaries.emplace_back(type, max_row_group_, state->arena);
+	}
+	if (run_vectors_) {
+		for (LogicalType type : types_)
+			state->runs.emplace_back(type, max_row_group_, state->arena);
+		state->run_ends.resize(types_.size());
+		state->batch_runs = MakeChunk(types_, max_row_group_, state->arena);
+		state->batch_lengths.resize(types_.size());
+	}
+	if (mode_ == FileScanMode::DIRECT && !prefetcher_) {
+		/** One block holds every fetch of a row group, so Reset() keeps it for the next one */
+		size_t block = DIRECT_IO_ALIGNMENT;
+		while (block < max_fetch_bytes_ + DIRECT_IO_ALIGNMENT)
+			block <<= 1;
+		state->io = Arena(block);
+	}
+	return state;
+}
+
+idx_t PhysicalFileScan::RowGroupOf(uint64_t row) const {
+	const auto it = std::upper_bound(row_group_starts_.begin(), row_group_starts_.end(), row);
+	return static_cast<idx_t>(it - row_group_starts_.begin()) - 1;
+}
+
+void PhysicalFileScan::GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset,
+							   idx_t count, std::vector<Vector> &out) const {
+	static_cast<FileScanState &>(state).token = ctx.Token();
+	if (Filtered())
+		FilterData(state, offset, count, out);
+	else if (mode_ == FileScanMode::MMAP)
+		MapData(state, offset, count, out);
+	else
+		ReadData(state, offset, count, out);
+
+	if (auto *metrics = ctx.Metrics()) {
+		for (LogicalType type : types_)
+			metrics->bytes_read += static_cast<uint64_t>(count) * GetTypeSize(type);
+	}
+}
+
+/**
+ * @brief Set the null flags of rows [row, row + count) of a mapped chunk on `out`, from `target`
+ *
+ */
+static void MapNulls(const ColumnChunkMeta &chunk, const uint8_t *data, uint32_t row,
+					 idx_t count, Vector &out, idx_t target) {
+	if (!chunk.null_count)
+		return;
+	for (idx_t i = 0; i < count; i++) {
+		const uint32_t r = row + i;
+		if (data[r / 8] & (1U << (r % 8)))
+			out.SetNull(target + i);
+	}
+}
+
+void PhysicalFileScan::LoadRowGroup(LocalSourceState &state, idx_t row_group) const {
+	auto &scan = static_cast<FileScanState &>(state);
+	scan.row_group = NO_ROW_GROUP;
+	if (buffers_) {
+		PinRowGroup(scan, row_group);
+	} else if (mode_ == FileScanMode::MMAP) {
+		const RowGroupMeta &group = reader_.Metadata().row_groups[row_group];
+		for (size_t c = 0; c < column_ids_.size(); c++) {
+			const ColumnChunkMeta &chunk = group.columns[column_ids_[c]];
+			scan.views[c].ReferenceExternal(MappedValues(scan, row_group, c), group.row_count);
+			MapNulls(chunk, mapping_.Data() + chunk.offset, 0, group.row_count, scan.views[c], 0);
+		}
+	} else if (prefetcher_) {
+		prefetcher_->Read(row_group, scan.columns);
+	} else {
+		auto *dictionaries = dictionary_vectors_ ? &scan.dictionaries : nullptr;
+		/** Filters gather their rows, which run vectors do not support */
+		auto *runs = run_vectors_ && !Filtered() ? &scan.runs : nullptr;
+		if (mode_ == FileScanMode::DIRECT) {
+			scan.io.Reset();
+			reader_.ReadColumns(row_group, column_ids_, scan.columns, scan.io, true, dictionaries,
+								runs);
+		} else {
+			reader_.ReadColumns(row_group, column_ids_, scan.columns, dictionaries, runs);
+		}
+		for (size_t c = 0; runs && c < scan.columns.size(); c++) {
+			if (!scan.columns[c].IsRuns())
+				continue;
+			const Vector &values = scan.columns[c].RunValues();
+			const uint32_t *lengths = scan.columns[c].RunLengths();
+			scan.run_ends[c].resize(values.Size());
+			std::partial_sum(lengths, lengths + values.Size(), scan.run_ends[c].begin());
+		}
+	}
+	scan.row_group = row_group;
+}
+
+/**
+ * @brief Point `out` at the runs of the run vector `columns[c]` that overlap rows
+ * [row, row + count), the first and the last one trimmed to those rows
+ *
+ */
+static void SliceRuns(FileScanState &scan, size_t c, uint32_t row, idx_t count, Vector &out) {
+	const Vector &column = scan.columns[c];
+	const std::vector<uint32_t> &ends = scan.run_ends[c];
+	const auto first = static_cast<uint32_t>(
+			std::upper_bound(ends.begin(), ends.end(), row) - ends.begin());
+	const auto last = static_cast<uint32_t>(
+			std::upper_bound(ends.begin(), ends.end(), row + count - 1) - ends.begin());
+	const uint32_t runs = last - first + 1;
+
+	Vector &values = scan.batch_runs[c];
+	values.Reset();
+	values.SetSize(runs);
+	values.Copy(column.RunValues(), first, runs, 0);
+	std::vector<uint32_t> &lengths = scan.batch_lengths[c];
+	lengths.resize(runs);
+	for (uint32_t r = first; r <= last; r++) {
+		const uint32_t start = std::max(r == 0 ? 0 : ends[r - 1], row);
+		const uint32_t end = std::min<uint64_t>(ends[r], row + count);
+		lengths[r - first] = end - start;
+	}
+	out.ReferenceRuns(values, lengths.data(), static_cast<uint32_t>(count));
+}
+
+void PhysicalFileScan::ReadData(LocalSourceState &state, uint64_t offset, idx_t count,
+								std::vector<Vector> &out) const {
+	auto &scan = static_cast<FileScanState &>(state);
+	for (auto &vec : out) {
+		vec.Reset();
+		vec.SetSize(count);
+	}
+
+	for (idx_t target = 0; target < count;) {
+		const idx_t group = RowGroupOf(offset + target);
+		if (group != scan.row_group)
+			LoadRowGroup(scan, group);
+
+		const auto row = static_cast<uint32_t>(offset + target - row_group_starts_[group]);
+		const auto n = static_cast<idx_t>(
+				std::min<uint64_t>(count - target, row_group_starts_[group + 1] - offset - target));
+		const std::vector<Vector> &columns = buffers_ ? scan.views : scan.columns;
+		for (size_t c = 0; c < out.size(); c++) {
+			if (columns[c].IsRuns() && n == count) {
+				SliceRuns(scan, c, row, n, out[c]);
+				continue;
+			}
+			if (!columns[c].IsDictionary() || n != count) {
+				out[c].Copy(columns[c], row, n, target);
+				continue;
+			}
+			/** The whole batch is in this row group, refer to its codes */
+			out[c].ReferenceDictionary(columns[c].Dictionary(), columns[c].Codes() + row, n);
+			if (!columns[c].HasNulls())
+				continue;
+			for (idx_t i = 0; i < n; i++) {
+				if (columns[c].IsNull(row + i))
+					out[c].SetNull(i);
+			}
+		}
+		target += n;
+	}
+}
+
+void PhysicalFileScan::PinRowGroup(LocalSourceState &state, idx_t row_group) const {
+	auto &scan = static_cast<FileScanState &>(state);
+	const RowGroupMeta &group = reader_.Metadata().row_groups[row_group];
+	const bool direct = mode_ == FileScanMode::DIRECT;
+
+	/** Unpin the previous row group first, its frames may be needed for this one */
+	scan.pins.clear();
+	for (size_t c = 0; c < column_ids_.size(); c++) {
+		const idx_t id = column_ids_[c];
+		const ChunkKey key{file_id_, static_cast<uint32_t>(row_group), static_cast<uint32_t>(id)};
+		auto load = [&](uint8_t *data) { reader_.DecodeChunk(row_group, id, data, direct); };
+		/** Pins of this row group's earlier columns are ours, a wait for them would never end */
+		scan.pins.push_back(buffers_->Pin(key, reader_.DecodedChunkSize(row_group, id), load,
+										  scan.token, scan.pins.size()));
+
+		const ColumnChunkMeta &chunk = group.columns[id];
+		const uint8_t *data = scan.pins.back().Data();
+		scan.views[c].ReferenceExternal(data + chunk.NullBitmapSize(group.row_count),
+										group.row_count);
+		MapNulls(chunk, data, 0, group.row_count, scan.views[c], 0);
+	}
+}
+
+const uint8_t *PhysicalFileScan::MappedValues(LocalSourceState &state, idx_t row_group,
+											  size_t c) const {
+	auto &scan = static_cast<FileScanState &>(state);
+	const RowGroupMeta &group = reader_.Metadata().row_groups[row_group];
+	const ColumnChunkMeta &chunk = group.columns[column_ids_[c]];
+	const uint8_t *data = mapping_.Data() + chunk.offset;
+	if (chunk.encoding == EncodingType::PLAIN)
+		return data + chunk.NullBitmapSize(group.row_count);
+
+	if (scan.columns.empty()) {
+		scan.columns = MakeChunk(types_, max_row_group_, scan.arena);
+		scan.decoded.assign(types_.size(), NO_ROW_GROUP);
+	}
+	if (scan.decoded[c] != row_group) {
+		scan.decoded[c] = NO_ROW_GROUP;
+		DecodeColumnChunk(chunk, group.row_count, data, scan.columns[c]);
+		scan.decoded[c] = row_group;
+	}
+	return scan.columns[c].RawData();
+}
+
+void PhysicalFileScan::MapData(LocalSourceState &state, uint64_t offset, idx_t count,
+							   std::vector<Vector> &out) const {
+	auto &scan = static_cast<FileScanState &>(state);
+	if (scan.capacity < count) {
+		scan.views = MakeChunk(types_, count, scan.arena);
+		scan.buffers = MakeChunk(types_, count, scan.arena);
+		scan.capacity = count;
+	}
+
+	const FileMetadata &metadata = reader_.Metadata();
+	const idx_t first = RowGroupOf(offset);
+	if (first != scan.row_group) {
+		/** Start paging in every chunk of the row group this worker is about to scan */
+		for (idx_t id : column_ids_) {
+			const ColumnChunkMeta &chunk = metadata.row_groups[first].columns[id];
+			mapping_.Advise(chunk.offset, chunk.size, AccessHint::WILLNEED);
+		}
+		scan.row_group = first;
+	}
+
+	/** A batch within one row group is a view of the mapping */
+	if (offset + count <= row_group_starts_[first + 1]) {
+		const RowGroupMeta &group = metadata.row_groups[first];
+		const auto row = static_cast<uint32_t>(offset - row_group_starts_[first]);
+		for (size_t c = 0; c < out.size(); c++) {
+			const ColumnChunkMeta &chunk = group.columns[column_ids_[c]];
+			const uint8_t *data = mapping_.Data() + chunk.offset;
+			const uint8_t *values = MappedValues(scan, first, c) +
+									static_cast<size_t>(row) * GetTypeSize(types_[c]);
+			scan.views[c].ReferenceExternal(values, count);
+			MapNulls(chunk, data, row, count, scan.views[c], 0);
+			out[c].Reference(scan.views[c]);
+		}
+		return;
+	}
+
+	/** A batch that spans row groups is copied together from the mapped pieces */
+	for (size_t c = 0; c < out.size(); c++) {
+		scan.buffers[c].SetSize(count);
+		scan.buffers[c].ClearNulls();
+	}
+	for (idx_t target = 0; target < count;) {
+		const idx_t index = RowGroupOf(offset + target);
+		const RowGroupMeta &group = metadata.row_groups[index];
+		const auto row = static_cast<uint32_t>(offset + target - row_group_starts_[index]);
+		const auto n = static_cast<idx_t>(
+				std::min<uint64_t>(count - target, row_group_starts_[index + 1] - offset - target));
+		for (size_t c = 0; c < out.size(); c++) {
+			const ColumnChunkMeta &chunk = group.columns[column_ids_[c]];
+			const uint8_t *data = mapping_.Data() + chunk.offset;
+			const size_t width = GetTypeSize(types_[c]);
+			std::memcpy(scan.buffers[c].RawData() + target * width,
+						MappedValues(scan, index, c) + row * width, n * width);
+			MapNulls(chunk, data, row, n, scan.buffers[c], target);
+		}
+		target += n;
+	}
+	for (size_t c = 0; c < out.size(); c++)
+		out[c].Reference(scan.buffers[c]);
+}
+
+idx_t PhysicalFileScan::SelectRowGroup(LocalSourceState &state, idx_t row_group) const {
+	auto &scan = static_cast<FileScanState &>(state);
+	const RowGroupMeta &group = reader_.Metadata().row_groups[row_group];
+	if (top_n_ && top_n_->CanSkipZone(group.columns[column_ids_[top_n_column_]].stats))
+		return 0;
+
+	sel_t *rows = scan.selection.Data();
+	if (filters_.empty()) {
+		for (uint32_t r = 0; r < group.row_count; r++)
+			rows[r] = static_cast<sel_t>(r);
+		return group.row_count;
+	}
+	idx_t selected = 0;
+	for (size_t f = 0; f < filters_.size(); f++) {
+		const ScanFilter &filter = filters_[f];
+		const idx_t id = column_ids_[filter.column];
+		if (f == 0) {
+			selected = reader_.SelectRows(row_group, id, filter.predicate, scan.selection);
+		} else {
+			const idx_t matches = reader_.SelectRows(row_group, id, filter.predicate, scan.matches);
+			/** Both lists ascend, intersect them in place */
+			const sel_t *other = scan.matches.Data();
+			idx_t kept = 0;
+			for (idx_t i = 0, j = 0; i < selected && j < matches;) {
+				if (rows[i] < other[j]) {
+					i++;
+				} else if (other[j] < rows[i]) {
+					j++;
+				} else {
+					rows[kept++] = rows[i];
+					i++;
+					j++;
+				}
+			}
+			selected = kept;
+		}
+		if (selected == 0)
+			break;
+	}
+	return selected;
+}
+
+void PhysicalFileScan::FilterData(LocalSourceState &state, uint64_t offset, idx_t count,
+								  std::vector<Vector> &out) const {
+	auto &scan = static_cast<FileScanState &>(state);
+	if (scan.capacity < count) {
+		scan.batch = SelectionVector(scan.arena, count);
+		scan.buffers = MakeChunk(types_, count, scan.arena);
+		scan.capacity = count;
+	}
+	for (auto &vec : out) {
+		vec.SetSize(count);
+		vec.ClearNulls();
+	}
+
+	idx_t produced = 0;
+	for (idx_t target = 0; target < count;) {
+		const idx_t group = RowGroupOf(offset + target);
+		const auto row = static_cast<uint32_t>(offset + target - row_group_starts_[group]);
+		const auto n = static_cast<idx_t>(
+				std::min<uint64_t>(count - target, row_group_starts_[group + 1] - offset - target));
+		target += n;
+
+		/** Row groups without qualifying rows, or ruled out by the Top-N, are never loaded */
+		if (group != scan.selected_group) {
+			scan.selected_group = NO_ROW_GROUP;
+			scan.selected = SelectRowGroup(scan, group);
+			scan.selected_group = group;
+		}
+		const sel_t *rows = scan.selection.Data();
+		const sel_t *begin = std::lower_bound(rows, rows + scan.selected, row);
+		const sel_t *end = std::lower_bound(begin, rows + scan.selected, row + n);
+		const auto k = static_cast<idx_t>(end - begin);
+		if (k == 0)
+			continue;
+
+		if (group != scan.row_group)
+			LoadRowGroup(scan, group);
+		std::copy(begin, end, scan.batch.Data());
+		const bool viewed = buffers_ || mode_ == FileScanMode::MMAP;
+		const std::vector<Vector> &columns = viewed ? scan.views : scan.columns;
+		/** A batch from a single piece is gathered in place, pieces are gathered and appended */
+		const bool whole = produced == 0 && target == count;
+		for (size_t c = 0; c < out.size(); c++) {
+			if (whole) {
+				out[c].Gather(columns[c], scan.batch, k);
+				continue;
+			}
+			scan.buffers[c].Gather(columns[c], scan.batch, k);
+			out[c].Copy(scan.buffers[c], 0, k, produced);
+		}
+		produced += k;
+	}
+	for (auto &vec : out)
+		vec.SetSize(produced);
+}
+
+} // namespace electricdb
@@ -0,0 +1,33 @@
+#include "electricdb/execution/operators/scan/scan.h"
+
+namespace electricdb {
+
+static std::vector<LogicalType> ColumnTypes(const std::vector<Vector> &columns) {
+	std::vector<LogicalType> types;
+	for (const auto &col : columns)
+		types.push_back(col.Type());
+	return types;
+}
+
+PhysicalColumnScan::PhysicalColumnScan(const std::vector<Vector> &columns)
+	: PhysicalOperator(PhysicalOperatorType::COLUMN_SCAN, ColumnTypes(columns)),
+	  columns_(columns) {}
+
+uint64_t PhysicalColumnScan::SourceRowCount() const {
+	return columns_.empty() ? 0 : columns_[0].Size();
+}
+
+void PhysicalColumnScan::GetData(ExecutionContext &ctx, LocalSourceState &, uint64_t offset,
+								 idx_t count, std::vector<Vector> &out) const {
+	uint64_t bytes = 0;
+	for (size_t c = 0; c < columns_.size(); c++) {
+		out[c].SetSize(count);
+		out[c].ClearNulls();
+		out[c].Copy(columns_[c], static_cast<uint32_t>(offset), count);
+		bytes += static_cast<uint64_t>(count) * GetTypeSize(columns_[c].Type());
+	}
+	if (auto *metrics = ctx.Metrics())
+		metrics->bytes_read += bytes;
+}
+
+} // namespace electricdb
@@ -0,0 +1,52 @@
+#include "electricdb/execution/operators/sort/physical_sort.h"
+
+namespace electricdb {
+
+struct SortSinkState : public LocalSinkState {
+	std::unique_ptr<SortLocalState> local;
+};
+
+struct SortSourceState : public LocalSourceState {
+	SortScanState scan;
+};
+
+PhysicalSort::PhysicalSort(std::vector<LogicalType> types, std::vector<SortKey> keys,
+						   uint64_t memory_limit, SpillManager *spill_manager)
+	: PhysicalOperator(PhysicalOperatorType::ORDER_BY, types),
+	  sort_(std::move(types), std::move(keys), memory_limit, spill_manager) {}
+
+std::unique_ptr<LocalSinkState> PhysicalSort::InitLocalSink() const {
+	auto state = std::make_unique<SortSinkState>();
+	state->local = sort_.InitLocal();
+	return state;
+}
+
+void PhysicalSort::Sink(ExecutionContext &, LocalSinkState &state,
+						const std::vector<Vector> &chunk) {
+	sort_.Sink(*static_cast<SortSinkState &>(state).local, chunk);
+}
+
+void PhysicalSort::Combine(LocalSinkState &state) {
+	sort_.Combine(*static_cast<SortSinkState &>(state).local);
+}
+
+void PhysicalSort::Finalize(Scheduler &scheduler, const CancellationToken *token) {
+	sort_.Finalize(scheduler, token);
+}
+
+std::unique_ptr<LocalSourceState> PhysicalSort::InitLocalSource() const {
+	return std::make_unique<SortSourceState>();
+}
+
+void PhysicalSort::GetData(ExecutionContext &, LocalSourceState &state, uint64_t offset,
+						   idx_t count, std::vector<Vector> &out) const {
+	SortScanState &scan = static_cast<SortSourceState &>(state).scan;
+	/** The spilled merge is sequential, only in-memory output can be read at any offset */
+	if (ParallelSource())
+		scan.position = offset;
+	/** Gather only the rows of this morsel, not the whole capacity of `out` */
+	sort_.Scan(scan, out, count);
+	scan.position = offset + count;
+}
+
+} // namespace electricdb
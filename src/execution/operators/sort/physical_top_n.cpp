@@ -0,0 +1,46 @@
+#include "electricdb/execution/operators/sort/physical_top_n.h"
+
+namespace electricdb {
+
+struct TopNSinkState : public LocalSinkState {
+	std::unique_ptr<TopNLocalState> local;
+};
+
+struct TopNSourceState : public LocalSourceState {
+	TopNScanState scan;
+};
+
+PhysicalTopN::PhysicalTopN(std::vector<LogicalType> types, std::vector<SortKey> keys,
+						   uint64_t limit, uint64_t offset)
+	: PhysicalOperator(PhysicalOperatorType::TOP_N, types),
+	  top_n_(std::move(types), std::move(keys), limit, offset) {}
+
+std::unique_ptr<LocalSinkState> PhysicalTopN::InitLocalSink() const {
+	auto state = std::make_unique<TopNSinkState>();
+	state->local = top_n_.InitLocal();
+	return state;
+}
+
+void PhysicalTopN::Sink(ExecutionContext &, LocalSinkState &state,
+						const std::vector<Vector> &chunk) {
+	top_n_.Sink(*static_cast<TopNSinkState &>(state).local, chunk);
+}
+
+void PhysicalTopN::Combine(LocalSinkState &state) {
+	top_n_.Combine(*static_cast<TopNSinkState &>(state).local);
+}
+
+void PhysicalTopN::Finalize(Scheduler &, const CancellationToken *) { top_n_.Finalize(); }
+
+std::unique_ptr<LocalSourceState> PhysicalTopN::InitLocalSource() const {
+	return std::make_unique<TopNSourceState>();
+}
+
+void PhysicalTopN::GetData(ExecutionContext &, LocalSourceState &state, uint64_t offset,
+						   idx_t count, std::vector<Vector> &out) const {
+	TopNScanState &scan = static_cast<TopNSourceState &>(state).scan;
+	scan.position = offset;
+	top_n_.Scan(scan, out, count);
+}
+
+} // namespace electricdb
@@ -0,0 +1,681 @@
+#include "electricdb/execution/operators/sort/sort.h"
+#include "electricdb/io/prefetch.h"
+#include "electricdb/util/trace.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace electricdb {
+
+/** @brief Do not split the merge into partitions smaller than this */
+static constexpr uint64_t MIN_ROWS_PER_PARTITION = 1 << 16;
+
+/** @brief Number of keys sampled per run and partition to pick merge splitters */
+static constexpr uint64_t SAMPLES_PER_PARTITION = 32;
+
+/** @brief Row references pack the run index above the row within the run */
+static constexpr uint32_t RUN_SHIFT = 32;
+static constexpr uint64_t ROW_MASK = (1ULL << RUN_SHIFT) - 1;
+
+/** @brief Spilled runs are written and read back in blocks of roughly this many bytes */
+static constexpr uint64_t SPILL_BLOCK_SIZE = 1 << 18;
+
+/** @brief Reads a merge keeps in flight at once, over all of its runs */
+static constexpr uint32_t MERGE_READ_DEPTH = 4;
+
+/** @brief Merges check for cancellation every this many rows, a power of two */
+static constexpr uint64_t CANCEL_CHECK_ROWS = 1 << 16;
+
+/**
+ * @brief Reads a spilled run block by block. While the records of one block are consumed, the
+ * next block is already being read by the merge's AsyncReader.
+ */
+class SpilledRunReader {
+  public:
+	SpilledRunReader(const SpilledRun &run, uint32_t record_width, AsyncReader &io)
+		: run_(run), record_width_(record_width), io_(io),
+		  block_records_(std::max<uint64_t>(1, SPILL_BLOCK_SIZE / record_width)) {
+		current_.resize(block_records_ * record_width_);
+		next_.resize(block_records_ * record_width_);
+
+		current_count_ = std::min(block_records_, run_.count);
+		const size_t bytes = current_count_ * record_width_;
+		if (run_.file->Read(current_.data(), bytes, 0) != bytes)
+			throw std::runtime_error("Spilled sort run is truncated!");
+		records_read_ = current_count_;
+		StartReadAhead();
+	}
+
+	~SpilledRunReader() {
+		/** `next_` must outlive the read into it */
+		if (pending_) {
+			try {
+				io_.Wait(pending_);
+			} catch (...) {
+			}
+		}
+	}
+
+	/** @brief Disable copy constructor */
+	SpilledRunReader(const SpilledRunReader &) = delete;
+
+	/** @brief Disable copy assignment */
+	SpilledRunReader &operator=(const SpilledRunReader &) = delete;
+
+	bool Empty() const noexcept { return current_count_ == 0; }
+
+	/** @brief Record under the cursor */
+	const uint8_t *Current() const noexcept { return current_.data() + pos_ * record_width_; }
+
+	/**
+	 * @brief Move to the next record
+	 *
+	 * @return false once the run is exhausted
+	 */
+	bool Advance() {
+		if (++pos_ < current_count_)
+			return true;
+		if (!pending_)
+			return false;
+
+		const size_t bytes = io_.Wait(pending_);
+		pending_ = 0;
+		if (bytes != pending_records_ * record_width_)
+			throw std::runtime_error("Spilled sort run is truncated!");
+		current_count_ = pending_records_;
+		std::swap(current_, next_);
+		pos_ = 0;
+		StartReadAhead();
+		return current_count_ > 0;
+	}
+
+  private:
+	void StartReadAhead() {
+		if (records_read_ >= run_.count)
+			return;
+
+		pending_records_ = std::min(block_records_, run_.count - records_read_);
+		pending_ = io_.Submit(run_.file->GetFile(), next_.data(), pending_records_ * record_width_,
+							  records_read_ * record_width_);
+		records_read_ += pending_records_;
+	}
+
+	const SpilledRun &run_;
+	uint32_t record_width_;
+	AsyncReader &io_;
+	uint64_t block_records_;
+	uint64_t records_read_ = 0;
+
+	std::vector<uint8_t> current_;
+	uint64_t current_count_ = 0;
+	uint64_t pos_ = 0;
+
+	std::vector<uint8_t> next_;
+	/** @brief Ticket of the read into `next_`, 0 if none is in flight */
+	uint64_t pending_ = 0;
+	uint64_t pending_records_ = 0;
+};
+
+/**
+ * @brief Streaming k-way merge over spilled runs of a SortOperator
+ *
+ */
+class SpilledRunMerger {
+  public:
+	SpilledRunMerger(const SortOperator &sort, const std::vector<const SpilledRun *> &runs)
+		: sort_(sort), io_(std::min<uint32_t>(MERGE_READ_DEPTH, std::max<size_t>(runs.size(), 1))) {
+		for (const SpilledRun *run : runs) {
+			auto reader = std::make_unique<SpilledRunReader>(*run, sort_.record_width_, io_);
+			if (!reader->Empty())
+				heap_.push_back(reader.get());
+			readers_.push_back(std::move(reader));
+		}
+		std::make_heap(heap_.begin(), heap_.end(), Greater{sort_.encoder_});
+	}
+
+	/** @brief Record with the smallest key, null once every run is exhausted */
+	const uint8_t *Top() const noexcept { return heap_.empty() ? nullptr : heap_[0]->Current(); }
+
+	/** @brief Move past the record returned by Top(), which becomes invalid */
+	void Pop() {
+		const Greater greater{sort_.encoder_};
+		std::pop_heap(heap_.begin(), heap_.end(), greater);
+		if (heap_.back()->Advance())
+			std::push_heap(heap_.begin(), heap_.end(), greater);
+		else
+			heap_.pop_back();
+	}
+
+	/**
+	 * @brief Merge the next records into `out`, at most `max_count`
+	 *
+	 * @return idx_t Number of rows emitted
+	 */
+	idx_t Next(std::vector<Vector> &out, idx_t max_count) {
+		const idx_t capacity = std::min(out[0].Capacity(), max_count);
+		const size_t num_columns = sort_.types_.size();
+
+		std::vector<uint8_t *> dst(num_columns);
+		std::vector<uint32_t> widths(num_columns);
+		for (size_t c = 0; c < num_columns; c++) {
+			out[c].SetSize(capacity);
+			out[c].ClearNulls();
+			dst[c] = out[c].RawData();
+			widths[c] = GetTypeSize(sort_.types_[c]);
+		}
+
+		idx_t count = 0;
+		for (const uint8_t *record = Top(); count < capacity && record; record = Top()) {
+			for (size_t c = 0; c < num_columns; c++) {
+				const uint8_t *field = record + sort_.record_offsets_[c];
+				std::memcpy(dst[c] + static_cast<size_t>(count) * widths[c], field + 1, widths[c]);
+				if (field[0])
+					out[c].SetNull(count);
+			}
+			count++;
+			Pop();
+		}
+
+		for (auto &vec : out)
+			vec.SetSize(count);
+		return count;
+	}
+
+  private:
+	/** @brief Orders readers so the heap top holds the smallest key */
+	struct Greater {
+		const SortKeyEncoder &encoder;
+		bool operator()(const SpilledRunReader *a, const SpilledRunReader *b) const noexcept {
+			return encoder.Compare(a->Current(), b->Current()) > 0;
+		}
+	};
+
+	const SortOperator &sort_;
+	/** @brief Declared before the readers, which wait for their reads when destroyed */
+	AsyncReader io_;
+	std::vector<std::unique_ptr<SpilledRunReader>> readers_;
+	std::vector<SpilledRunReader *> heap_;
+};
+
+SortScanState::SortScanState() = default;
+
+SortScanState::~SortScanState() = default;
+
+template <typename T>
+static void AppendColumn(std::vector<uint8_t> &dst, const Vector &src, idx_t count) {
+	const size_t old_size = dst.size();
+	dst.resize(old_size + count * sizeof(T));
+	std::memcpy(dst.data() + old_size, src.Data<T>(), count * sizeof(T));
+}
+
+template <typename T>
+static void GatherColumn(Vector &out, const std::vector<std::unique_ptr<SortRun>> &runs,
+						 const uint64_t *refs, idx_t count, size_t column) {
+	T *dst = out.Data<T>();
+	out.SetSize(count);
+	out.ClearNulls();
+
+	for (idx_t i = 0; i < count; i++) {
+		const SortRun &run = *runs[refs[i] >> RUN_SHIFT];
+		const uint64_t row = refs[i] & ROW_MASK;
+		std::memcpy(&dst[i], run.columns[column].data() + row * sizeof(T), sizeof(T));
+		if (run.nulls[column][row])
+			out.SetNull(i);
+	}
+}
+
+SortOperator::SortOperator(std::vector<LogicalType> types, std::vector<SortKey> keys,
+						   uint64_t memory_limit, SpillManager *spill_manager)
+	: types_(std::move(types)), encoder_(std::move(keys), types_), memory_limit_(memory_limit),
+	  spill_manager_(spill_manager) {
+	if (memory_limit_ > 0 && !spill_manager_)
+		throw std::runtime_error("A sort with a memory limit requires a SpillManager!");
+
+	record_width_ = encoder_.KeyWidth();
+	for (auto type : types_) {
+		record_offsets_.push_back(record_width_);
+		record_width_ += 1 + GetTypeSize(type);
+	}
+}
+
+uint64_t SortOperator::RowBytes() const noexcept {
+	/** The key entry twice: radix sorting a run takes a scratch copy of its entries */
+	return 2 * encoder_.EntryWidth() + (record_width_ - encoder_.KeyWidth());
+}
+
+std::unique_ptr<SortLocalState> SortOperator::InitLocal() const {
+	auto local = std::make_unique<SortLocalState>();
+	local->run.columns.resize(types_.size());
+	local->run.nulls.resize(types_.size());
+	return local;
+}
+
+void SortOperator::Sink(SortLocalState &local, const std::vector<Vector> &chunk) {
+#ifndef NDEBUG
+	assert(chunk.size() == types_.size());
+#endif
+	if (chunk.empty() || chunk[0].Size() == 0)
+		return;
+
+	SortRun &run = local.run;
+	const idx_t count = chunk[0].Size();
+
+	if (run.count + count > ROW_MASK)
+		throw std::runtime_error("Too many rows in a single sort run!");
+
+	/** Make room before buffering: spill the largest combined run first, then the own run */
+	bool alone = false;
+	if (memory_limit_ > 0) {
+		const uint64_t bytes = count * RowBytes();
+		while (!Reserve(bytes)) {
+			if (SpillLargestRun())
+				continue;
+			if (run.count > 0) {
+				SpillLocal(local);
+				continue;
+			}
+			/** All buffered rows belong to other workers, this chunk becomes a run on its own */
+			alone = true;
+			break;
+		}
+		if (!alone)
+			local.buffered_bytes += bytes;
+	}
+
+	for (size_t c = 0; c < types_.size(); c++) {
+		const Vector &col = chunk[c];
+		switch (types_[c]) {
+		case LogicalType::INT32:
+			AppendColumn<int32_t>(run.columns[c], col, count);
+			break;
+		case LogicalType::INT64:
+			AppendColumn<int64_t>(run.columns[c], col, count);
+			break;
+		case LogicalType::FLOAT:
+			AppendColumn<float>(run.columns[c], col, count);
+			break;
+		case LogicalType::DOUBLE:
+			AppendColumn<double>(run.columns[c], col, count);
+			break;
+		case LogicalType::BOOL:
+			AppendColumn<bool>(run.columns[c], col, count);
+			break;
+		default:
+			throw std::runtime_error("Unsupported type!");
+		}
+
+		auto &nulls = run.nulls[c];
+		const size_t old_size = nulls.size();
+		nulls.resize(old_size + count, 0);
+		if (col.HasNulls()) {
+			for (idx_t i = 0; i < count; i++)
+				nulls[old_size + i] = col.IsNull(i) ? 1 : 0;
+		}
+	}
+
+	const uint32_t entry_width = encoder_.EntryWidth();
+	const size_t old_size = run.keys.size();
+	run.keys.resize(old_size + static_cast<size_t>(count) * entry_width);
+	encoder_.Encode(chunk, count, run.keys.data() + old_size, run.count);
+
+	run.count += count;
+
+	if (alone)
+		SpillLocal(local);
+}
+
+bool SortOperator::Reserve(uint64_t bytes) {
+	uint64_t buffered = buffered_bytes_.load(std::memory_order_relaxed);
+	do {
+		if (buffered + bytes > memory_limit_)
+			return false;
+	} while (!buffered_bytes_.compare_exchange_weak(buffered, buffered + bytes,
+													std::memory_order_relaxed));
+
+	uint64_t peak = peak_buffered_bytes_.load(std::memory_order_relaxed);
+	while (peak < buffered + bytes &&
+		   !peak_buffered_bytes_.compare_exchange_weak(peak, buffered + bytes,
+													   std::memory_order_relaxed)) {
+	}
+	return true;
+}
+
+bool SortOperator::SpillLargestRun() {
+	std::unique_ptr<SortRun> run;
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		auto largest = std::max_element(
+				runs_.begin(), runs_.end(),
+				[](const auto &a, const auto &b) { return a->count < b->count; });
+		if (largest == runs_.end())
+			return false;
+		run = std::move(*largest);
+		runs_.erase(largest);
+	}
+	SortRunKeys(*run);
+	Spill(*run);
+	buffered_bytes_.fetch_sub(run->count * RowBytes(), std::memory_order_relaxed);
+	return true;
+}
+
+void SortOperator::SpillLocal(SortLocalState &local) {
+	SortRun &run = local.run;
+	SortRunKeys(run);
+	Spill(run);
+
+	buffered_bytes_.fetch_sub(local.buffered_bytes, std::memory_order_relaxed);
+	local.buffered_bytes = 0;
+	run = SortRun();
+	run.columns.resize(types_.size());
+	run.nulls.resize(types_.size());
+}
+
+void SortOperator::SortRunKeys(SortRun &run, const CancellationToken *token) const {
+	TRACE_SCOPE("sort", "sort_run", run.count);
+	std::vector<uint8_t> tmp(run.keys.size());
+	RadixSort(run.keys.data(), tmp.data(), run.count, encoder_.EntryWidth(), encoder_.KeyWidth(),
+			  token);
+}
+
+void SortOperator::Spill(const SortRun &run) {
+	TRACE_SCOPE("spill", "spill_run", run.count);
+	const uint32_t entry_width = encoder_.EntryWidth();
+	const uint32_t key_width = encoder_.KeyWidth();
+	const uint64_t block_records = std::max<uint64_t>(1, SPILL_BLOCK_SIZE / record_width_);
+
+	std::vector<uint32_t> widths;
+	for (auto type : types_)
+		widths.push_back(GetTypeSize(type));
+
+	auto file = spill_manager_->CreateSpillFile();
+	std::vector<uint8_t> block(block_records * record_width_);
+	uint64_t buffered = 0;
+
+	for (uint64_t i = 0; i < run.count; i++) {
+		const uint8_t *entry = run.keys.data() + i * entry_width;
+		const uint64_t row = encoder_.GetRef(entry);
+		uint8_t *record = block.data() + buffered * record_width_;
+
+		std::memcpy(record, entry, key_width);
+		for (size_t c = 0; c < types_.size(); c++) {
+			uint8_t *field = record + record_offsets_[c];
+			field[0] = run.nulls[c][row];
+			std::memcpy(field + 1, run.columns[c].data() + row * widths[c], widths[c]);
+		}
+
+		if (++buffered == block_records) {
+			file->Append(block.data(), buffered * record_width_);
+			buffered = 0;
+		}
+	}
+	if (buffered > 0)
+		file->Append(block.data(), buffered * record_width_);
+
+	std::lock_guard<std::mutex> guard(lock_);
+	spilled_runs_.push_back({std::move(file), run.count});
+}
+
+void SortOperator::Combine(SortLocalState &local) {
+	if (local.run.count == 0)
+		return;
+
+	/** Sorting is left to Finalize(), which runs the sorts of all runs in parallel */
+	local.buffered_bytes = 0;
+	auto run = std::make_unique<SortRun>(std::move(local.run));
+	local.run = SortRun();
+	local.run.columns.resize(types_.size());
+	local.run.nulls.resize(types_.size());
+
+	std::lock_guard<std::mutex> guard(lock_);
+	runs_.push_back(std::move(run));
+}
+
+void SortOperator::Finalize(Scheduler &scheduler, const CancellationToken *token) {
+	if (!spilled_runs_.empty()) {
+		/** Once anything is on disk, merge everything from disk */
+		scheduler.Run(
+				[this, token](ExecutionContext &, uint32_t, const Morsel &morsel) {
+					SortRun &run = *runs_[morsel.begin];
+					SortRunKeys(run, token);
+					Spill(run);
+					buffered_bytes_.fetch_sub(run.count * RowBytes(), std::memory_order_relaxed);
+					run = SortRun();
+				},
+				runs_.size(), 1, token);
+		runs_.clear();
+
+		count_ = 0;
+		for (const auto &run : spilled_runs_)
+			count_ += run.count;
+
+		/** Merge groups of runs into longer ones until a single merge can read all of them */
+		while (spilled_runs_.size() > MAX_MERGE_FAN_IN) {
+			const size_t groups = (spilled_runs_.size() + MAX_MERGE_FAN_IN - 1) / MAX_MERGE_FAN_IN;
+			std::vector<SpilledRun> merged(groups);
+			scheduler.Run(
+					[this, groups, &merged, token](ExecutionContext &, uint32_t,
+												   const Morsel &morsel) {
+						const size_t g = morsel.begin;
+						merged[g] = MergeRuns(spilled_runs_.size() * g / groups,
+											  spilled_runs_.size() * (g + 1) / groups, token);
+					},
+					groups, 1, token);
+			/** Destroying the merged runs deletes their files */
+			spilled_runs_ = std::move(merged);
+		}
+		return;
+	}
+
+	scheduler.Run(
+			[this, token](ExecutionContext &, uint32_t, const Morsel &morsel) {
+				SortRunKeys(*runs_[morsel.begin], token);
+			},
+			runs_.size(), 1, token);
+
+	const size_t num_runs = runs_.size();
+	const uint32_t entry_width = encoder_.EntryWidth();
+
+	uint64_t total = 0;
+	for (const auto &run : runs_)
+		total += run->count;
+	order_.resize(total);
+	count_ = total;
+
+	if (total == 0)
+		return;
+
+	const uint64_t partitions = std::max<uint64_t>(
+			1, std::min<uint64_t>(scheduler.WorkerCount(), total / MIN_ROWS_PER_PARTITION));
+
+	/** bounds[p][r] is the first entry of run r that belongs to partition p */
+	std::vector<std::vector<uint64_t>> bounds(partitions + 1, std::vector<uint64_t>(num_runs, 0));
+	for (size_t r = 0; r < num_runs; r++)
+		bounds[partitions][r] = runs_[r]->count;
+
+	if (partitions > 1) {
+		/** Pick splitters from evenly spaced samples of every run */
+		std::vector<const uint8_t *> samples;
+		for (const auto &run : runs_) {
+			const uint64_t step =
+					std::max<uint64_t>(1, run->count / (partitions * SAMPLES_PER_PARTITION));
+			for (uint64_t i = step / 2; i < run->count; i += step)
+				samples.push_back(run->keys.data() + i * entry_width);
+		}
+		std::sort(samples.begin(), samples.end(), [&](const uint8_t *a, const uint8_t *b) {
+			return encoder_.Compare(a, b) < 0;
+		});
+
+		for (uint64_t p = 1; p < partitions; p++) {
+			const uint8_t *splitter = samples[p * samples.size() / partitions];
+			for (size_t r = 0; r < num_runs; r++) {
+				/** lower_bound of the splitter inside run r */
+				const SortRun &run = *runs_[r];
+				uint64_t lo = 0;
+				uint64_t hi = run.count;
+				while (lo < hi) {
+					const uint64_t mid = lo + (hi - lo) / 2;
+					if (encoder_.Compare(run.keys.data() + mid * entry_width, splitter) < 0)
+						lo = mid + 1;
+					else
+						hi = mid;
+				}
+				bounds[p][r] = lo;
+			}
+		}
+	}
+
+	std::vector<uint64_t> out_offsets(partitions, 0);
+	for (uint64_t p = 0; p < partitions; p++) {
+		for (size_t r = 0; r < num_runs; r++)
+			out_offsets[p] += bounds[p][r];
+	}
+
+	scheduler.Run(
+			[this, &bounds, &out_offsets, token](ExecutionContext &, uint32_t,
+												 const Morsel &morsel) {
+				const uint64_t p = morsel.begin;
+				MergePartition(bounds[p], bounds[p + 1], out_offsets[p], token);
+			},
+			partitions, 1, token);
+}
+
+std::vector<const SpilledRun *> SortOperator::SpilledRunPointers(size_t begin,
+																size_t end) const {
+	std::vector<const SpilledRun *> runs;
+	for (size_t r = begin; r < end; r++)
+		runs.push_back(&spilled_runs_[r]);
+	return runs;
+}
+
+SpilledRun SortOperator::MergeRuns(size_t begin, size_t end,
+									const CancellationToken *token) const {
+	TRACE_SCOPE("spill", "merge_runs", end - begin);
+	SpilledRunMerger merger(*this, SpilledRunPointers(begin, end));
+	const uint64_t block_records = std::max<uint64_t>(1, SPILL_BLOCK_SIZE / record_width_);
+	std::vector<uint8_t> block(block_records * record_width_);
+
+	SpilledRun merged;
+	merged.file = spill_manager_->CreateSpillFile();
+	uint64_t buffered = 0;
+	for (const uint8_t *record = merger.Top(); record; record = merger.Top()) {
+		std::memcpy(block.data() + buffered * record_width_, record, record_width_);
+		merger.Pop();
+		merged.count++;
+		if (++buffered == block_records) {
+			if (token)
+				token->ThrowIfCancelled();
+			merged.file->Append(block.data(), buffered * record_width_);
+			buffered = 0;
+		}
+	}
+	if (buffered > 0)
+		merged.file->Append(block.data(), buffered * record_width_);
+	return merged;
+}
+
+void SortOperator::MergePartition(const std::vector<uint64_t> &begin,
+								  const std::vector<uint64_t> &end, uint64_t out,
+								  const CancellationToken *token) {
+	struct Cursor {
+		const uint8_t *pos;
+		const uint8_t *end;
+		uint64_t run;
+	};
+
+	const uint32_t entry_width = encoder_.EntryWidth();
+
+	std::vector<Cursor> heap;
+	for (size_t r = 0; r < runs_.size(); r++) {
+		if (begin[r] < end[r]) {
+			const uint8_t *keys = runs_[r]->keys.data();
+			heap.push_back({keys + begin[r] * entry_width, keys + end[r] * entry_width, r});
+		}
+	}
+
+	/** Min-heap on the normalized key of each cursor's current entry */
+	auto greater = [this](const Cursor &a, const Cursor &b) {
+		return encoder_.Compare(a.pos, b.pos) > 0;
+	};
+	std::make_heap(heap.begin(), heap.end(), greater);
+
+	while (heap.size() > 1) {
+		if (token && (out & (CANCEL_CHECK_ROWS - 1)) == 0)
+			token->ThrowIfCancelled();
+		std::pop_heap(heap.begin(), heap.end(), greater);
+		Cursor &top = heap.back();
+		order_[out++] = (top.run << RUN_SHIFT) | encoder_.GetRef(top.pos);
+		top.pos += entry_width;
+		if (top.pos == top.end)
+			heap.pop_back();
+		else
+			std::push_heap(heap.begin(), heap.end(), greater);
+	}
+
+	/** Only one run left, its remaining entries are already in order */
+	if (!heap.empty()) {
+		const Cursor &last = heap.back();
+		for (const uint8_t *pos = last.pos; pos != last.end; pos += entry_width)
+			order_[out++] = (last.run << RUN_SHIFT) | encoder_.GetRef(pos);
+	}
+}
+
+void SortOperator::Clear() {
+	runs_.clear();
+	/** Destroying the spill files deletes them from disk */
+	spilled_runs_.clear();
+	std::vector<uint64_t>().swap(order_);
+	buffered_bytes_.store(0, std::memory_order_relaxed);
+	count_ = 0;
+}
+
+idx_t SortOperator::Scan(SortScanState &state, std::vector<Vector> &out, idx_t max_count) const {
+#ifndef NDEBUG
+	assert(out.size() == types_.size());
+#endif
+	if (out.empty())
+		return 0;
+
+	if (!spilled_runs_.empty()) {
+		if (!state.merger)
+			state.merger = std::make_unique<SpilledRunMerger>(
+					*this, SpilledRunPointers(0, spilled_runs_.size()));
+		const idx_t count = state.merger->Next(out, max_count);
+		state.position += count;
+		return count;
+	}
+
+	if (state.position >= order_.size())
+		return 0;
+
+	const idx_t count = static_cast<idx_t>(
+			std::min<uint64_t>({out[0].Capacity(), max_count, order_.size() - state.position}));
+	const uint64_t *refs = order_.data() + state.position;
+
+	for (size_t c = 0; c < types_.size(); c++) {
+		switch (types_[c]) {
+		case LogicalType::INT32:
+			GatherColumn<int32_t>(out[c], runs_, refs, count, c);
+			break;
+		case LogicalType::INT64:
+			GatherColumn<int64_t>(out[c], runs_, refs, count, c);
+			break;
+		case LogicalType::FLOAT:
+			GatherColumn<float>(out[c], runs_, refs, count, c);
+			break;
+		case LogicalType::DOUBLE:
+			GatherColumn<double>(out[c], runs_, refs, count, c);
+			break;
+		case LogicalType::BOOL:
+			GatherColumn<bool>(out[c], runs_, refs, count, c);
+			break;
+		default:
+			throw std::runtime_error("Unsupported type!");
+		}
+	}
+
+	state.position += count;
+	return count;
+}
+
+} // namespace electricdb
@@ -0,0 +1,243 @@
+#include "electricdb/execution/operators/sort/sort_key.h"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace electricdb {
+
+/** @brief Buckets at or below this size are finished with an insertion sort */
+static constexpr uint64_t INSERTION_SORT_THRESHOLD = 24;
+
+/**
+ * @brief Write `v` into `dst` so that unsigned byte-wise comparison matches numeric order
+ *
+ */
+template <typename T>
+static inline void EncodeValue(T v, uint8_t *dst) {
+	if constexpr (std::is_same_v<T, int32_t>) {
+		uint32_t bits = __builtin_bswap32(static_cast<uint32_t>(v) ^ 0x80000000U);
+		std::memcpy(dst, &bits, sizeof(bits));
+	} else if constexpr (std::is_same_v<T, int64_t>) {
+		uint64_t bits = __builtin_bswap64(static_cast<uint64_t>(v) ^ 0x8000000000000000ULL);
+		std::memcpy(dst, &bits, sizeof(bits));
+	} else if constexpr (std::is_same_v<T, float>) {
+		/** -0.0 == 0.0, and every NaN sorts as one value above +inf */
+		if (v == 0.0F)
+			v = 0.0F;
+		uint32_t bits = std::isnan(v) ? 0x7fc00000U : std::bit_cast<uint32_t>(v);
+		bits = (bits & 0x80000000U) ? ~bits : bits ^ 0x80000000U;
+		bits = __builtin_bswap32(bits);
+		std::memcpy(dst, &bits, sizeof(bits));
+	} else if constexpr (std::is_same_v<T, double>) {
+		if (v == 0.0)
+			v = 0.0;
+		uint64_t bits = std::isnan(v) ? 0x7ff8000000000000ULL : std::bit_cast<uint64_t>(v);
+		bits = (bits & 0x8000000000000000ULL) ? ~bits : bits ^ 0x8000000000000000ULL;
+		bits = __builtin_bswap64(bits);
+		std::memcpy(dst, &bits, sizeof(bits));
+	} else if constexpr (std::is_same_v<T, bool>) {
+		dst[0] = v ? 1 : 0;
+	} else {
+		static_assert(sizeof(T) == 0, "Unsupported sort key type");
+	}
+}
+
+/**
+ * @brief Encode one key column for `count` rows, writing `1 + sizeof(T)` bytes per entry
+ *
+ */
+template <typename T, bool DESC>
+static void EncodeColumn(const Vector &col, idx_t count, uint8_t *dst, uint32_t entry_width,
+						 uint8_t valid_byte, uint8_t null_byte) {
+	const T *src = col.Data<T>();
+	const bool has_nulls = col.HasNulls();
+
+	for (idx_t i = 0; i < count; i++) {
+		uint8_t *entry = dst + static_cast<size_t>(i) * entry_width;
+		if (has_nulls && col.IsNull(i)) {
+			entry[0] = null_byte;
+			std::memset(entry + 1, 0, sizeof(T));
+			continue;
+		}
+		entry[0] = valid_byte;
+		EncodeValue<T>(src[i], entry + 1);
+		if constexpr (DESC) {
+			for (size_t b = 1; b <= sizeof(T); b++)
+				entry[b] = static_cast<uint8_t>(~entry[b]);
+		}
+	}
+}
+
+template <typename T>
+static void EncodeColumn(const Vector &col, idx_t count, uint8_t *dst, uint32_t entry_width,
+						 const SortKey &key) {
+	/** NULLS FIRST/LAST is absolute, so the null byte is never inverted for DESC */
+	const uint8_t null_byte = key.null_order == NullOrder::NULLS_FIRST ? 0 : 1;
+	const uint8_t valid_byte = 1 - null_byte;
+
+	if (key.order == OrderType::DESCENDING) {
+		EncodeColumn<T, true>(col, count, dst, entry_width, valid_byte, null_byte);
+	} else {
+		EncodeColumn<T, false>(col, count, dst, entry_width, valid_byte, null_byte);
+	}
+}
+
+SortKeyEncoder::SortKeyEncoder(std::vector<SortKey> keys, const std::vector<LogicalType> &types)
+	: keys_(std::move(keys)), key_width_(0) {
+	for (const auto &key : keys_) {
+		if (key.column_idx >= types.size())
+			throw std::runtime_error("Sort key refers to a column that does not exist!");
+
+		const LogicalType type = types[key.column_idx];
+		key_types_.push_back(type);
+		offsets_.push_back(key_width_);
+		key_width_ += 1 + GetTypeSize(type);
+	}
+}
+
+void SortKeyEncoder::Encode(const std::vector<Vector> &chunk, idx_t count, uint8_t *dst,
+							uint64_t first_ref) const {
+	const uint32_t entry_width = EntryWidth();
+
+	for (size_t k = 0; k < keys_.size(); k++) {
+		const Vector &col = chunk[keys_[k].column_idx];
+		uint8_t *col_dst = dst + offsets_[k];
+
+		switch (key_types_[k]) {
+		case LogicalType::INT32:
+			EncodeColumn<int32_t>(col, count, col_dst, entry_width, keys_[k]);
+			break;
+		case LogicalType::INT64:
+			EncodeColumn<int64_t>(col, count, col_dst, entry_width, keys_[k]);
+			break;
+		case LogicalType::FLOAT:
+			EncodeColumn<float>(col, count, col_dst, entry_width, keys_[k]);
+			break;
+		case LogicalType::DOUBLE:
+			EncodeColumn<double>(col, count, col_dst, entry_width, keys_[k]);
+			break;
+		case LogicalType::BOOL:
+			EncodeColumn<bool>(col, count, col_dst, entry_width, keys_[k]);
+			break;
+		default:
+			throw std::runtime_error("Unsupported type!");
+		}
+	}
+
+	for (idx_t i = 0; i < count; i++) {
+		const uint64_t ref = first_ref + i;
+		std::memcpy(dst + static_cast<size_t>(i) * entry_width + key_width_, &ref, sizeof(ref));
+	}
+}
+
+template <typename T>
+static void EncodeSingle(const Value &value, uint8_t *dst, const SortKey &key) {
+	const uint8_t null_byte = key.null_order == NullOrder::NULLS_FIRST ? 0 : 1;
+	if (value.IsNull()) {
+		dst[0] = null_byte;
+		std::memset(dst + 1, 0, sizeof(T));
+		return;
+	}
+	dst[0] = 1 - null_byte;
+	EncodeValue<T>(value.Get<T>(), dst + 1);
+	if (key.order == OrderType::DESCENDING) {
+		for (size_t b = 1; b <= sizeof(T); b++)
+			dst[b] = static_cast<uint8_t>(~dst[b]);
+	}
+}
+
+void SortKeyEncoder::EncodeValue(size_t key_idx, const Value &value, uint8_t *dst) const {
+	switch (key_types_[key_idx]) {
+	case LogicalType::INT32:
+		EncodeSingle<int32_t>(value, dst, keys_[key_idx]);
+		break;
+	case LogicalType::INT64:
+		EncodeSingle<int64_t>(value, dst, keys_[key_idx]);
+		break;
+	case LogicalType::FLOAT:
+		EncodeSingle<float>(value, dst, keys_[key_idx]);
+		break;
+	case LogicalType::DOUBLE:
+		EncodeSingle<double>(value, dst, keys_[key_idx]);
+		break;
+	case LogicalType::BOOL:
+		EncodeSingle<bool>(value, dst, keys_[key_idx]);
+		break;
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+/**
+ * @brief Insertion sort on entries whose first `offset` key bytes are already known to be equal
+ *
+ */
+static void InsertionSort(uint8_t *data, uint8_t *scratch, uint64_t count, uint32_t entry_width,
+						  uint32_t key_width, uint32_t offset) {
+	const uint32_t cmp_width = key_width - offset;
+
+	for (uint64_t i = 1; i < count; i++) {
+		std::memcpy(scratch, data + i * entry_width, entry_width);
+		uint64_t j = i;
+		while (j > 0 && std::memcmp(data + (j - 1) * entry_width + offset, scratch + offset,
+									cmp_width) > 0) {
+			std::memcpy(data + j * entry_width, data + (j - 1) * entry_width, entry_width);
+			j--;
+		}
+		std::memcpy(data + j * entry_width, scratch, entry_width);
+	}
+}
+
+static void MSDRadixSort(uint8_t *data, uint8_t *tmp, uint64_t count, uint32_t entry_width,
+						 uint32_t key_width, uint32_t offset, const CancellationToken *token) {
+	if (count <= INSERTION_SORT_THRESHOLD) {
+		InsertionSort(data, tmp, count, entry_width, key_width, offset);
+		return;
+	}
+	if (token)
+		token->ThrowIfCancelled();
+
+	for (; offset < key_width; offset++) {
+		std::array<uint64_t, 256> counts{};
+		for (uint64_t i = 0; i < count; i++)
+			counts[data[i * entry_width + offset]]++;
+
+		/** Every entry has the same byte here, nothing to scatter */
+		if (counts[data[offset]] == count)
+			continue;
+
+		std::array<uint64_t, 256> positions{};
+		uint64_t sum = 0;
+		for (size_t b = 0; b < counts.size(); b++) {
+			positions[b] = sum;
+			sum += counts[b];
+		}
+
+		for (uint64_t i = 0; i < count; i++) {
+			const uint8_t *entry = data + i * entry_width;
+			std::memcpy(tmp + positions[entry[offset]]++ * entry_width, entry, entry_width);
+		}
+		std::memcpy(data, tmp, count * entry_width);
+
+		uint64_t start = 0;
+		for (uint64_t bucket_count : counts) {
+			if (bucket_count > 1) {
+				MSDRadixSort(data + start * entry_width, tmp + start * entry_width, bucket_count,
+							 entry_width, key_width, offset + 1, token);
+			}
+			start += bucket_count;
+		}
+		return;
+	}
+}
+
+void RadixSort(uint8_t *data, uint8_t *tmp, uint64_t count, uint32_t entry_width,
+			   uint32_t key_width, const CancellationToken *token) {
+	if (count <= 1)
+		return;
+	MSDRadixSort(data, tmp, count, entry_width, key_width, 0, token);
+}
+
+} // namespace electricdb
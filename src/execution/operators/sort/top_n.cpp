@@ -0,0 +1,247 @@
+#include "electricdb/execution/operators/sort/top_n.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+namespace electricdb {
+
+/** @brief Upper bound on the heap memory reserved up front by InitLocal() */
+static constexpr uint64_t MAX_RESERVED_ROWS = 1 << 16;
+
+TopNOperator::TopNOperator(std::vector<LogicalType> types, std::vector<SortKey> keys,
+						   uint64_t limit, uint64_t offset)
+	: types_(std::move(types)), encoder_(std::move(keys), types_), limit_(limit), offset_(offset),
+	  heap_size_(limit + offset) {
+	if (encoder_.Keys().empty())
+		throw std::runtime_error("Top-N requires at least one sort key!");
+	if (heap_size_ > std::numeric_limits<uint32_t>::max())
+		throw std::runtime_error("Top-N limit is too large, use a sort instead!");
+
+	record_width_ = encoder_.KeyWidth();
+	for (auto type : types_) {
+		record_offsets_.push_back(record_width_);
+		record_width_ += 1 + GetTypeSize(type);
+	}
+}
+
+std::unique_ptr<TopNLocalState> TopNOperator::InitLocal() const {
+	auto local = std::make_unique<TopNLocalState>();
+	const uint64_t reserved = std::min(heap_size_, MAX_RESERVED_ROWS);
+	local->records.reserve(reserved * record_width_);
+	local->heap.reserve(reserved);
+	return local;
+}
+
+bool TopNOperator::CanSkip(const ZoneMap &zone, const uint8_t *boundary) const {
+	if (!zone.HasValues() && !zone.has_nulls && !zone.has_nan)
+		return true;
+
+	/** The best row of the zone starts with the smallest encoding of min, max or NULL */
+	const uint32_t width = encoder_.ColumnWidth(0);
+	std::vector<uint8_t> best(width, 0xFF);
+	std::vector<uint8_t> candidate(width);
+
+	auto consider = [&](const Value &value) {
+		encoder_.EncodeValue(0, value, candidate.data());
+		if (std::memcmp(candidate.data(), best.data(), width) < 0)
+			best = candidate;
+	};
+
+	if (zone.HasValues()) {
+		consider(zone.min);
+		consider(zone.max);
+	}
+	if (zone.has_nan) {
+		Value nan;
+		nan.SetType(zone.Type());
+		if (zone.Type() == LogicalType::FLOAT)
+			nan.Set<float>(std::numeric_limits<float>::quiet_NaN());
+		else
+			nan.Set<double>(std::numeric_limits<double>::quiet_NaN());
+		consider(nan);
+	}
+	if (zone.has_nulls) {
+		Value null_value;
+		null_value.SetType(zone.Type());
+		consider(null_value);
+	}
+
+	/** Ties on the first key may still win on a later key, so only skip if strictly worse */
+	return std::memcmp(best.data(), boundary, width) > 0;
+}
+
+bool TopNOperator::CanSkipZone(const ZoneMap &zone) const {
+	if (!has_boundary_.load(std::memory_order_acquire))
+		return false;
+
+	std::lock_guard<std::mutex> guard(lock_);
+	return CanSkip(zone, boundary_.data());
+}
+
+void TopNOperator::PublishBoundary(const uint8_t *key) {
+	std::lock_guard<std::mutex> guard(lock_);
+	if (!has_boundary_.load(std::memory_order_relaxed) ||
+		encoder_.Compare(key, boundary_.data()) < 0) {
+		boundary_.assign(key, key + encoder_.KeyWidth());
+		has_boundary_.store(true, std::memory_order_release);
+	}
+}
+
+void TopNOperator::WriteRecord(TopNLocalState &local, uint32_t slot, const uint8_t *entry,
+							   const std::vector<Vector> &chunk, idx_t row) const {
+	uint8_t *record = local.records.data() + static_cast<size_t>(slot) * record_width_;
+	std::memcpy(record, entry, encoder_.KeyWidth());
+
+	for (size_t c = 0; c < types_.size(); c++) {
+		const Vector &col = chunk[c];
+		const uint32_t width = GetTypeSize(types_[c]);
+		uint8_t *field = record + record_offsets_[c];
+		field[0] = (col.HasNulls() && col.IsNull(row)) ? 1 : 0;
+		std::memcpy(field + 1, col.RawData() + static_cast<size_t>(row) * width, width);
+	}
+}
+
+void TopNOperator::Sink(TopNLocalState &local, const std::vector<Vector> &chunk) {
+#ifndef NDEBUG
+	assert(chunk.size() == types_.size());
+#endif
+	if (chunk.empty() || chunk[0].Size() == 0 || heap_size_ == 0)
+		return;
+
+	const idx_t count = chunk[0].Size();
+	const uint32_t entry_width = encoder_.EntryWidth();
+	const uint32_t key_width = encoder_.KeyWidth();
+
+	auto less = [&](uint32_t a, uint32_t b) {
+		return encoder_.Compare(local.records.data() + static_cast<size_t>(a) * record_width_,
+								local.records.data() + static_cast<size_t>(b) * record_width_) < 0;
+	};
+
+	/** The published boundary is read once per chunk, the local heap top tracks every insert */
+	std::vector<uint8_t> global;
+	if (has_boundary_.load(std::memory_order_acquire)) {
+		std::lock_guard<std::mutex> guard(lock_);
+		global = boundary_;
+	}
+
+	/** Best boundary known to this worker: its own heap top or the published one */
+	std::vector<uint8_t> boundary;
+	auto refresh_boundary = [&]() {
+		boundary = global;
+		if (local.heap.size() < heap_size_)
+			return;
+		const uint8_t *top =
+				local.records.data() + static_cast<size_t>(local.heap.front()) * record_width_;
+		if (boundary.empty() || encoder_.Compare(top, boundary.data()) < 0)
+			boundary.assign(top, top + key_width);
+	};
+	refresh_boundary();
+
+	/** Discard the whole chunk if its first sort key cannot beat the boundary */
+	if (!boundary.empty()) {
+		const Vector &first = chunk[encoder_.Keys()[0].column_idx];
+		ZoneMap zone(first.Type());
+		zone.Update(first);
+		if (CanSkip(zone, boundary.data())) {
+			local.chunks_skipped++;
+			return;
+		}
+	}
+
+	local.keys.resize(static_cast<size_t>(count) * entry_width);
+	encoder_.Encode(chunk, count, local.keys.data(), 0);
+
+	for (idx_t i = 0; i < count; i++) {
+		const uint8_t *entry = local.keys.data() + static_cast<size_t>(i) * entry_width;
+
+		if (local.heap.size() < heap_size_) {
+			const auto slot = static_cast<uint32_t>(local.heap.size());
+			local.records.resize((static_cast<size_t>(slot) + 1) * record_width_);
+			WriteRecord(local, slot, entry, chunk, i);
+			local.heap.push_back(slot);
+			std::push_heap(local.heap.begin(), local.heap.end(), less);
+			if (local.heap.size() == heap_size_)
+				refresh_boundary();
+			continue;
+		}
+
+		if (encoder_.Compare(entry, boundary.data()) >= 0)
+			continue;
+
+		/** Replace the worst row with this one */
+		std::pop_heap(local.heap.begin(), local.heap.end(), less);
+		WriteRecord(local, local.heap.back(), entry, chunk, i);
+		std::push_heap(local.heap.begin(), local.heap.end(), less);
+		refresh_boundary();
+	}
+
+	if (local.heap.size() == heap_size_) {
+		PublishBoundary(local.records.data() +
+						static_cast<size_t>(local.heap.front()) * record_width_);
+	}
+}
+
+void TopNOperator::Combine(TopNLocalState &local) {
+	std::lock_guard<std::mutex> guard(lock_);
+	for (uint32_t slot : local.heap) {
+		const uint8_t *record = local.records.data() + static_cast<size_t>(slot) * record_width_;
+		result_.insert(result_.end(), record, record + record_width_);
+	}
+	local.heap.clear();
+	local.records.clear();
+}
+
+void TopNOperator::Clear() {
+	std::vector<uint8_t>().swap(result_);
+	boundary_.clear();
+	has_boundary_.store(false, std::memory_order_relaxed);
+}
+
+void TopNOperator::Finalize() {
+	const uint64_t count = result_.size() / record_width_;
+	std::vector<uint8_t> tmp(result_.size());
+	RadixSort(result_.data(), tmp.data(), count, record_width_, encoder_.KeyWidth());
+
+	const uint64_t first = std::min(offset_, count);
+	const uint64_t last = std::min(offset_ + limit_, count);
+	result_.erase(result_.begin() + static_cast<std::ptrdiff_t>(last * record_width_),
+				  result_.end());
+	result_.erase(result_.begin(),
+				  result_.begin() + static_cast<std::ptrdiff_t>(first * record_width_));
+}
+
+idx_t TopNOperator::Scan(TopNScanState &state, std::vector<Vector> &out,
+						 idx_t max_count) const {
+#ifndef NDEBUG
+	assert(out.size() == types_.size());
+#endif
+	const uint64_t total = Count();
+	if (out.empty() || state.position >= total)
+		return 0;
+
+	const idx_t count = static_cast<idx_t>(std::min<uint64_t>(
+			std::min<uint64_t>(out[0].Capacity(), max_count), total - state.position));
+
+	for (size_t c = 0; c < types_.size(); c++) {
+		Vector &vec = out[c];
+		const uint32_t width = GetTypeSize(types_[c]);
+		uint8_t *dst = vec.RawData();
+		vec.SetSize(count);
+		vec.ClearNulls();
+
+		for (idx_t i = 0; i < count; i++) {
+			const uint8_t *field = result_.data() + (state.position + i) * record_width_ +
+								   record_offsets_[c];
+			std::memcpy(dst + static_cast<size_t>(i) * width, field + 1, width);
+			if (field[0])
+				vec.SetNull(i);
+		}
+	}
+
+	state.position += count;
+	return count;
+}
+
+} // namespace electricdb
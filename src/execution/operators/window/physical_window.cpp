@@ -0,0 +1,53 @@
+#include "electricdb/execution/operators/window/physical_window.h"
+
+namespace electricdb {
+
+struct WindowSinkState : public LocalSinkState {
+	std::unique_ptr<SortLocalState> local;
+};
+
+struct WindowSourceState : public LocalSourceState {
+	WindowScanState scan;
+};
+
+PhysicalWindow::PhysicalWindow(std::vector<LogicalType> input_types,
+							   std::vector<uint32_t> partition_columns,
+							   std::vector<SortKey> order_keys,
+							   std::vector<WindowFunctionSpec> functions)
+	: PhysicalOperator(PhysicalOperatorType::WINDOW, {}),
+	  window_(std::move(input_types), std::move(partition_columns), std::move(order_keys),
+			  std::move(functions)) {
+	types_ = window_.OutputTypes();
+}
+
+std::unique_ptr<LocalSinkState> PhysicalWindow::InitLocalSink() const {
+	auto state = std::make_unique<WindowSinkState>();
+	state->local = window_.InitLocal();
+	return state;
+}
+
+void PhysicalWindow::Sink(ExecutionContext &, LocalSinkState &state,
+						  const std::vector<Vector> &chunk) {
+	window_.Sink(*static_cast<WindowSinkState &>(state).local, chunk);
+}
+
+void PhysicalWindow::Combine(LocalSinkState &state) {
+	window_.Combine(*static_cast<WindowSinkState &>(state).local);
+}
+
+void PhysicalWindow::Finalize(Scheduler &scheduler, const CancellationToken *token) {
+	window_.Finalize(scheduler, token);
+}
+
+std::unique_ptr<LocalSourceState> PhysicalWindow::InitLocalSource() const {
+	return std::make_unique<WindowSourceState>();
+}
+
+void PhysicalWindow::GetData(ExecutionContext &, LocalSourceState &state, uint64_t offset,
+							 idx_t count, std::vector<Vector> &out) const {
+	WindowScanState &scan = static_cast<WindowSourceState &>(state).scan;
+	scan.position = offset;
+	window_.Scan(scan, out, count);
+}
+
+} // namespace electricdb
@@ -0,0 +1,32 @@
+#include "electricdb/execution/operators/window/segment_tree.h"
+
+namespace electricdb {
+
+WindowSegmentTree::WindowSegmentTree(const AggregateFunction &function, const Vector &input,
+									 idx_t begin, idx_t end)
+	: function_(function), size_(end - begin), nodes_(2 * static_cast<size_t>(end - begin)) {
+	for (idx_t i = 0; i < size_; i++)
+		function_.Update(nodes_[size_ + i], input, begin + i, begin + i + 1);
+
+	for (idx_t i = size_ > 0 ? size_ - 1 : 0; i > 0; i--) {
+		nodes_[i] = nodes_[2 * i];
+		function_.Combine(nodes_[i], nodes_[2 * i + 1]);
+	}
+}
+
+AggregateState WindowSegmentTree::Query(idx_t first, idx_t last) const {
+	AggregateState result;
+	if (first >= last)
+		return result;
+
+	/** Bottom-up walk, collecting the nodes that hang off the range borders */
+	for (first += size_, last += size_; first < last; first >>= 1, last >>= 1) {
+		if (first & 1)
+			function_.Combine(result, nodes_[first++]);
+		if (last & 1)
+			function_.Combine(result, nodes_[--last]);
+	}
+	return result;
+}
+
+} // namespace electricdb
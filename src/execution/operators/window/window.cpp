@@ -0,0 +1,502 @@
+#include "electricdb/execution/operators/window/window.h"
+#include "electricdb/execution/operators/window/segment_tree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace electricdb {
+
+/**
+ * @brief Set flags[i] to 1 where row i of `col` differs from row i - 1
+ *
+ */
+template <typename T>
+static void MarkChangesTyped(const Vector &col, idx_t count, uint8_t *flags) {
+	const T *data = col.Data<T>();
+
+	if (!col.HasNulls()) {
+		for (idx_t i = 1; i < count; i++)
+			flags[i] |= static_cast<uint8_t>(!KeyEquals(data[i], data[i - 1]));
+		return;
+	}
+
+	for (idx_t i = 1; i < count; i++) {
+		const bool cur_null = col.IsNull(i);
+		const bool prev_null = col.IsNull(i - 1);
+		const bool differs =
+			cur_null != prev_null || (!cur_null && !KeyEquals(data[i], data[i - 1]));
+		flags[i] |= static_cast<uint8_t>(differs);
+	}
+}
+
+static void MarkChanges(const Vector &col, idx_t count, uint8_t *flags) {
+	switch (col.Type()) {
+	case LogicalType::INT32:
+		MarkChangesTyped<int32_t>(col, count, flags);
+		break;
+	case LogicalType::INT64:
+		MarkChangesTyped<int64_t>(col, count, flags);
+		break;
+	case LogicalType::FLOAT:
+		MarkChangesTyped<float>(col, count, flags);
+		break;
+	case LogicalType::DOUBLE:
+		MarkChangesTyped<double>(col, count, flags);
+		break;
+	case LogicalType::BOOL:
+		MarkChangesTyped<bool>(col, count, flags);
+		break;
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+/**
+ * @brief `value` moved by `delta` towards +inf (add) or -inf (!add), saturating for integers
+ *
+ */
+template <typename T>
+static T ShiftValue(T value, int64_t delta, bool add) {
+	if constexpr (std::is_floating_point_v<T>) {
+		return add ? value + static_cast<T>(delta) : value - static_cast<T>(delta);
+	} else {
+		const auto wide = static_cast<int64_t>(value);
+		int64_t result;
+		const bool overflow = add ? __builtin_add_overflow(wide, delta, &result)
+								  : __builtin_sub_overflow(wide, delta, &result);
+		if (overflow)
+			return add ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+		return static_cast<T>(std::clamp<int64_t>(result, std::numeric_limits<T>::min(),
+												  std::numeric_limits<T>::max()));
+	}
+}
+
+/**
+ * @brief Binary search for a RANGE frame border among sorted non-null rows [begin, end)
+ *
+ */
+template <typename T>
+static idx_t RangeSearch(const Vector &col, idx_t begin, idx_t end, idx_t row,
+						 const WindowBound &bound, bool is_start, bool descending) {
+	const T *data = col.Data<T>();
+	const bool preceding = bound.type == WindowBoundType::PRECEDING;
+
+	/** PRECEDING looks towards the start of the partition, i.e. smaller values when ascending */
+	const T target = ShiftValue<T>(data[row], bound.offset, preceding == descending);
+
+	const T *first = data + begin;
+	const T *last = data + end;
+	const T *found;
+	if (descending) {
+		found = is_start ? std::lower_bound(first, last, target, std::greater<T>())
+						 : std::upper_bound(first, last, target, std::greater<T>());
+	} else {
+		found = is_start ? std::lower_bound(first, last, target)
+						 : std::upper_bound(first, last, target);
+	}
+	return static_cast<idx_t>(found - data);
+}
+
+/** @brief Evaluation checks for cancellation every this many rows */
+static constexpr idx_t CANCEL_CHECK_ROWS = 1 << 16;
+
+/** @brief Call `f(i)` for every row in [begin, end), checking `token` between blocks of rows */
+template <typename F>
+static void ForEachRow(idx_t begin, idx_t end, const CancellationToken *token, F &&f) {
+	for (idx_t block = begin; block < end;) {
+		if (token)
+			token->ThrowIfCancelled();
+		const idx_t block_end = end - block > CANCEL_CHECK_ROWS ? block + CANCEL_CHECK_ROWS : end;
+		for (idx_t i = block; i < block_end; i++)
+			f(i);
+		block = block_end;
+	}
+}
+
+static std::vector<SortKey> MakeSortKeys(const std::vector<uint32_t> &partition_columns,
+										 const std::vector<SortKey> &order_keys) {
+	std::vector<SortKey> keys;
+	for (uint32_t column : partition_columns)
+		keys.push_back({column});
+	keys.insert(keys.end(), order_keys.begin(), order_keys.end());
+	return keys;
+}
+
+static bool IsAggregate(WindowFunctionType type) {
+	return type >= WindowFunctionType::COUNT_STAR;
+}
+
+static AggregateType ToAggregateType(WindowFunctionType type) {
+	switch (type) {
+	case WindowFunctionType::COUNT_STAR:
+		return AggregateType::COUNT_STAR;
+	case WindowFunctionType::COUNT:
+		return AggregateType::COUNT;
+	case WindowFunctionType::SUM:
+		return AggregateType::SUM;
+	case WindowFunctionType::MIN:
+		return AggregateType::MIN;
+	case WindowFunctionType::MAX:
+		return AggregateType::MAX;
+	case WindowFunctionType::AVG:
+		return AggregateType::AVG;
+	default:
+		throw std::runtime_error("Not an aggregate window function!");
+	}
+}
+
+WindowOperator::WindowOperator(std::vector<LogicalType> types,
+							   std::vector<uint32_t> partition_columns,
+							   std::vector<SortKey> order_keys,
+							   std::vector<WindowFunctionSpec> functions)
+	: types_(std::move(types)), partition_columns_(std::move(partition_columns)),
+	  order_keys_(std::move(order_keys)), output_types_(types_),
+	  sort_(types_, MakeSortKeys(partition_columns_, order_keys_)) {
+	for (const auto &spec : functions) {
+		const bool is_offset = spec.type == WindowFunctionType::LAG ||
+							   spec.type == WindowFunctionType::LEAD;
+		const bool is_counter = spec.type == WindowFunctionType::COUNT_STAR;
+		const bool has_input = is_offset || (IsAggregate(spec.type) && !is_counter);
+		if (has_input && spec.column_idx >= types_.size())
+			throw std::runtime_error("Window function input column does not exist!");
+
+		BoundFunction bound{spec, LogicalType::INT64, std::nullopt};
+		if (is_offset) {
+			if (spec.offset < 0)
+				throw std::runtime_error("LAG / LEAD offset must not be negative!");
+			bound.result_type = types_[spec.column_idx];
+		} else if (IsAggregate(spec.type)) {
+			const WindowFrame &frame = spec.frame;
+			if (frame.start.type == WindowBoundType::UNBOUNDED_FOLLOWING ||
+				frame.end.type == WindowBoundType::UNBOUNDED_PRECEDING)
+				throw std::runtime_error("Invalid window frame!");
+			if (frame.start.offset < 0 || frame.end.offset < 0)
+				throw std::runtime_error("Window frame offset must not be negative!");
+
+			auto has_offset = [](const WindowBound &b) {
+				return b.type == WindowBoundType::PRECEDING || b.type == WindowBoundType::FOLLOWING;
+			};
+			if (frame.type == WindowFrameType::RANGE &&
+				(has_offset(frame.start) || has_offset(frame.end))) {
+				if (order_keys_.size() != 1)
+					throw std::runtime_error(
+							"RANGE with an offset requires exactly one ORDER BY key!");
+				const LogicalType order_type = types_[order_keys_[0].column_idx];
+				if (order_type == LogicalType::BOOL || order_type == LogicalType::STRING)
+					throw std::runtime_error(
+							"RANGE with an offset requires a numeric ORDER BY key!");
+			}
+
+			const LogicalType input_type =
+					is_counter ? LogicalType::INVALID : types_[spec.column_idx];
+			bound.aggregate.emplace(AggregateSpec{ToAggregateType(spec.type), spec.column_idx},
+									input_type);
+			bound.result_type = bound.aggregate->ResultType();
+		}
+
+		output_types_.push_back(bound.result_type);
+		functions_.push_back(std::move(bound));
+	}
+}
+
+void WindowOperator::Finalize(Scheduler &scheduler, const CancellationToken *token) {
+	sort_.Finalize(scheduler, token);
+	if (sort_.Count() > std::numeric_limits<idx_t>::max())
+		throw std::runtime_error("Too many rows in a window operator!");
+
+	count_ = sort_.Count();
+	const auto count = static_cast<idx_t>(count_);
+	const idx_t capacity = std::max<idx_t>(count, 1);
+
+	/** Materialize the sorted input, a single scan fills the whole capacity */
+	columns_.clear();
+	results_.clear();
+	arena_.Reset();
+	for (auto type : types_)
+		columns_.emplace_back(type, capacity, arena_);
+	SortScanState scan;
+	[[maybe_unused]] const idx_t scanned = sort_.Scan(scan, columns_);
+#ifndef NDEBUG
+	assert(scanned == count);
+#endif
+
+	for (const auto &function : functions_) {
+		results_.emplace_back(function.result_type, capacity, arena_);
+		results_.back().SetSize(count);
+		results_.back().ClearNulls();
+	}
+	result_nulls_.assign(functions_.size(), std::vector<uint8_t>(count, 0));
+
+	/** A partition starts where a partition column changes, a peer group also on ORDER BY keys */
+	std::vector<uint8_t> flags(count, 0);
+	for (uint32_t column : partition_columns_)
+		MarkChanges(columns_[column], count, flags.data());
+
+	partitions_.clear();
+	for (idx_t i = 0; i < count; i++) {
+		if (i == 0 || flags[i]) {
+			if (!partitions_.empty())
+				partitions_.back().second = i;
+			partitions_.emplace_back(i, count);
+		}
+	}
+
+	for (const auto &key : order_keys_)
+		MarkChanges(columns_[key.column_idx], count, flags.data());
+
+	peer_begin_.resize(count);
+	peer_end_.resize(count);
+	for (idx_t i = 0; i < count; i++)
+		peer_begin_[i] = (i == 0 || flags[i]) ? i : peer_begin_[i - 1];
+	for (idx_t i = count; i-- > 0;)
+		peer_end_[i] = (i + 1 == count || flags[i + 1]) ? i + 1 : peer_end_[i + 1];
+
+	/** One partition per morsel, workers steal the rest so skewed partitions balance out */
+	scheduler.Run(
+			[this, token](ExecutionContext &, uint32_t, const Morsel &morsel) {
+				for (uint64_t p = morsel.begin; p < morsel.end; p++)
+					EvaluatePartition(partitions_[p].first, partitions_[p].second, token);
+			},
+			partitions_.size(), 1, token);
+
+	/** Null masks pack several rows per byte, so they are only written once the workers are done */
+	for (size_t f = 0; f < functions_.size(); f++) {
+		const uint8_t *nulls = result_nulls_[f].data();
+		for (idx_t i = 0; i < count; i++) {
+			if (nulls[i])
+				results_[f].SetNull(i);
+		}
+	}
+	result_nulls_.clear();
+}
+
+void WindowOperator::Clear() {
+	sort_.Clear();
+	columns_.clear();
+	results_.clear();
+	result_nulls_.clear();
+	partitions_.clear();
+	std::vector<idx_t>().swap(peer_begin_);
+	std::vector<idx_t>().swap(peer_end_);
+	arena_.Reset();
+	count_ = 0;
+}
+
+idx_t WindowOperator::RangeBound(const WindowBound &bound, bool is_start, idx_t begin, idx_t end,
+								 idx_t row) const {
+	const SortKey &key = order_keys_[0];
+	const Vector &col = columns_[key.column_idx];
+
+	/** NULL order values only have their peers in range */
+	if (col.HasNulls()) {
+		if (col.IsNull(row))
+			return is_start ? peer_begin_[row] : peer_end_[row];
+		/** The NULLs of a partition form one peer group at its start or its end */
+		if (col.IsNull(begin))
+			begin = peer_end_[begin];
+		if (col.IsNull(end - 1))
+			end = peer_begin_[end - 1];
+	}
+
+	/** NaN is not ordered against numbers, it only has its peers in range too */
+	auto is_nan = [&](idx_t i) {
+		if (col.Type() == LogicalType::FLOAT)
+			return std::isnan(col.Data<float>()[i]);
+		if (col.Type() == LogicalType::DOUBLE)
+			return std::isnan(col.Data<double>()[i]);
+		return false;
+	};
+	if (is_nan(row))
+		return is_start ? peer_begin_[row] : peer_end_[row];
+	/** The sort places the NaNs of a partition after (or, descending, before) its numbers */
+	if (is_nan(begin))
+		begin = peer_end_[begin];
+	if (is_nan(end - 1))
+		end = peer_begin_[end - 1];
+
+	const bool descending = key.order == OrderType::DESCENDING;
+	switch (col.Type()) {
+	case LogicalType::INT32:
+		return RangeSearch<int32_t>(col, begin, end, row, bound, is_start, descending);
+	case LogicalType::INT64:
+		return RangeSearch<int64_t>(col, begin, end, row, bound, is_start, descending);
+	case LogicalType::FLOAT:
+		return RangeSearch<float>(col, begin, end, row, bound, is_start, descending);
+	case LogicalType::DOUBLE:
+		return RangeSearch<double>(col, begin, end, row, bound, is_start, descending);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+void WindowOperator::FrameBounds(const WindowFrame &frame, idx_t begin, idx_t end, idx_t row,
+								 idx_t &first, idx_t &last) const {
+	const bool rows = frame.type == WindowFrameType::ROWS;
+	const auto before = static_cast<int64_t>(row - begin);
+	const auto after = static_cast<int64_t>(end - row - 1);
+
+	switch (frame.start.type) {
+	case WindowBoundType::UNBOUNDED_PRECEDING:
+		first = begin;
+		break;
+	case WindowBoundType::CURRENT_ROW:
+		first = rows ? row : peer_begin_[row];
+		break;
+	case WindowBoundType::PRECEDING:
+		if (!rows)
+			first = RangeBound(frame.start, true, begin, end, row);
+		else
+			first = frame.start.offset >= before ? begin
+												 : row - static_cast<idx_t>(frame.start.offset);
+		break;
+	case WindowBoundType::FOLLOWING:
+		if (!rows)
+			first = RangeBound(frame.start, true, begin, end, row);
+		else
+			first = frame.start.offset > after ? end : row + static_cast<idx_t>(frame.start.offset);
+		break;
+	case WindowBoundType::UNBOUNDED_FOLLOWING:
+		first = end;
+		break;
+	}
+
+	switch (frame.end.type) {
+	case WindowBoundType::UNBOUNDED_PRECEDING:
+		last = begin;
+		break;
+	case WindowBoundType::CURRENT_ROW:
+		last = rows ? row + 1 : peer_end_[row];
+		break;
+	case WindowBoundType::PRECEDING:
+		if (!rows)
+			last = RangeBound(frame.end, false, begin, end, row);
+		else
+			last = frame.end.offset > before ? begin
+											 : row - static_cast<idx_t>(frame.end.offset) + 1;
+		break;
+	case WindowBoundType::FOLLOWING:
+		if (!rows)
+			last = RangeBound(frame.end, false, begin, end, row);
+		else
+			last = frame.end.offset >= after ? end : row + static_cast<idx_t>(frame.end.offset) + 1;
+		break;
+	case WindowBoundType::UNBOUNDED_FOLLOWING:
+		last = end;
+		break;
+	}
+
+	last = std::max(first, last);
+}
+
+void WindowOperator::EvaluatePartition(idx_t begin, idx_t end, const CancellationToken *token) {
+	for (size_t f = 0; f < functions_.size(); f++) {
+		const BoundFunction &function = functions_[f];
+		const WindowFunctionSpec &spec = function.spec;
+		Vector &result = results_[f];
+		uint8_t *nulls = result_nulls_[f].data();
+
+		switch (spec.type) {
+		case WindowFunctionType::ROW_NUMBER: {
+			auto *data = result.Data<int64_t>();
+			ForEachRow(begin, end, token, [&](idx_t i) { data[i] = i - begin + 1; });
+			break;
+		}
+		case WindowFunctionType::RANK: {
+			auto *data = result.Data<int64_t>();
+			ForEachRow(begin, end, token, [&](idx_t i) { data[i] = peer_begin_[i] - begin + 1; });
+			break;
+		}
+		case WindowFunctionType::DENSE_RANK: {
+			auto *data = result.Data<int64_t>();
+			int64_t rank = 0;
+			ForEachRow(begin, end, token, [&](idx_t i) {
+				rank += peer_begin_[i] == i ? 1 : 0;
+				data[i] = rank;
+			});
+			break;
+		}
+		case WindowFunctionType::LAG:
+		case WindowFunctionType::LEAD: {
+			const Vector &input = columns_[spec.column_idx];
+			const uint32_t width = GetTypeSize(input.Type());
+			const int64_t shift = spec.type == WindowFunctionType::LAG ? -spec.offset : spec.offset;
+			ForEachRow(begin, end, token, [&](idx_t i) {
+				const int64_t source = static_cast<int64_t>(i) + shift;
+				if (source < static_cast<int64_t>(begin) || source >= static_cast<int64_t>(end)) {
+					nulls[i] = 1;
+					return;
+				}
+				std::memcpy(result.RawData() + static_cast<size_t>(i) * width,
+							input.RawData() + static_cast<size_t>(source) * width, width);
+				nulls[i] = (input.HasNulls() && input.IsNull(static_cast<idx_t>(source))) ? 1 : 0;
+			});
+			break;
+		}
+		case WindowFunctionType::COUNT_STAR: {
+			auto *data = result.Data<int64_t>();
+			idx_t first, last;
+			ForEachRow(begin, end, token, [&](idx_t i) {
+				FrameBounds(spec.frame, begin, end, i, first, last);
+				data[i] = last - first;
+			});
+			break;
+		}
+		default: {
+			const AggregateFunction &aggregate = *function.aggregate;
+			const WindowSegmentTree tree(aggregate, columns_[spec.column_idx], begin, end);
+			idx_t first, last;
+			ForEachRow(begin, end, token, [&](idx_t i) {
+				FrameBounds(spec.frame, begin, end, i, first, last);
+				const AggregateState state = tree.Query(first - begin, last - begin);
+				/** Finalize() would set the null bit itself, which is not safe across partitions */
+				if (state.count == 0 && spec.type != WindowFunctionType::COUNT) {
+					nulls[i] = 1;
+					return;
+				}
+				aggregate.Finalize(state, result, i);
+			});
+			break;
+		}
+		}
+	}
+}
+
+idx_t WindowOperator::Scan(WindowScanState &state, std::vector<Vector> &out,
+						   idx_t max_count) const {
+#ifndef NDEBUG
+	assert(out.size() == output_types_.size());
+#endif
+	if (out.empty() || state.position >= count_)
+		return 0;
+
+	const idx_t count = static_cast<idx_t>(std::min<uint64_t>(
+			std::min<uint64_t>(out[0].Capacity(), max_count), count_ - state.position));
+	const auto offset = static_cast<idx_t>(state.position);
+
+	for (size_t c = 0; c < out.size(); c++) {
+		const Vector &src = c < columns_.size() ? columns_[c] : results_[c - columns_.size()];
+		Vector &dst = out[c];
+		const uint32_t width = GetTypeSize(src.Type());
+		dst.SetSize(count);
+		dst.ClearNulls();
+		std::memcpy(dst.RawData(), src.RawData() + static_cast<size_t>(offset) * width,
+					static_cast<size_t>(count) * width);
+		if (!src.HasNulls())
+			continue;
+		for (idx_t i = 0; i < count; i++) {
+			if (src.IsNull(offset + i))
+				dst.SetNull(i);
+		}
+	}
+
+	state.position += count;
+	return count;
+}
+
+} // namespace electricdb
@@ -1,6 +1,8 @@
 #include "electricdb/execution/vector/vector.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 
@@ -32,13 +34,22 @@ Vector::Vector(LogicalType type, uint32_t capacity, Arena &arena) {
 		throw std::runtime_error("Unsupported type!");
 	}
 
+	buffer_ = data_;
 	null_count_ = 0;
 }
 
 Vector::Vector(Vector &&other) noexcept
 	: logical_type_(other.logical_type_), size_(other.size_), capacity_(other.capacity_),
-	  data_(other.data_), null_count_(other.null_count_), nulls_(std::move(other.nulls_)) {
+	  data_(other.data_), null_count_(other.null_count_), nulls_(std::move(other.nulls_)),
+	  buffer_(other.buffer_), dictionary_(other.dictionary_), codes_(other.codes_),
+	  run_values_(other.run_values_), run_lengths_(other.run_lengths_), external_(other.external_) {
 	other.data_ = nullptr;
+	other.buffer_ = nullptr;
+	other.dictionary_ = nullptr;
+	other.codes_ = nullptr;
+	other.run_values_ = nullptr;
+	other.run_lengths_ = nullptr;
+	other.external_ = false;
 	other.null_count_ = 0;
 	other.size_ = 0;
 }
@@ -51,8 +62,20 @@ auto Vector::operator=(Vector &&other) noexcept -> Vector & {
 		data_ = other.data_;
 		null_count_ = other.null_count_;
 		nulls_ = std::move(other.nulls_);
+		buffer_ = other.buffer_;
+		dictionary_ = other.dictionary_;
+		codes_ = other.codes_;
+		run_values_ = other.run_values_;
+		run_lengths_ = other.run_lengths_;
+		external_ = other.external_;
 
 		other.data_ = nullptr;
+		other.buffer_ = nullptr;
+		other.dictionary_ = nullptr;
+		other.codes_ = nullptr;
+		other.run_values_ = nullptr;
+		other.run_lengths_ = nullptr;
+		other.external_ = false;
 		other.size_ = 0;
 		other.null_count_ = 0;
 	}
@@ -62,6 +85,7 @@ auto Vector::operator=(Vector &&other) noexcept -> Vector & {
 void Vector::Slice(Vector &other, uint32_t offset, uint32_t count) {
 #ifndef NDEBUG
 	assert(!HasNulls());
+	assert(!IsRuns());
 	assert(offset <= size_);
 	assert(offset + count <= size_);
 #endif
@@ -75,6 +99,9 @@ void Vector::Slice(Vector &other, uint32_t offset, uint32_t count) {
 
 	other.nulls_ = nullptr;
 	other.null_count_ = 0;
+	other.dictionary_ = dictionary_;
+	other.codes_ = codes_ ? codes_ + offset : nullptr;
+	other.external_ = external_;
 }
 
 void Vector::Reference(const Vector &other) {
@@ -83,6 +110,200 @@ void Vector::Reference(const Vector &other) {
 	capacity_ = other.capacity_;
 	nulls_ = other.nulls_;
 	data_ = other.data_;
+	null_count_ = other.null_count_;
+	dictionary_ = other.dictionary_;
+	codes_ = other.codes_;
+	run_values_ = other.run_values_;
+	run_lengths_ = other.run_lengths_;
+	external_ = other.external_;
+}
+
+void Vector::ReferenceExternal(const void *data, uint32_t count) {
+#ifndef NDEBUG
+	assert(count <= capacity_);
+	assert(reinterpret_cast<uintptr_t>(data) % GetTypeSize(logical_type_) == 0);
+#endif
+	data_ = const_cast<void *>(data);
+	size_ = count;
+	dictionary_ = nullptr;
+	codes_ = nullptr;
+	run_values_ = nullptr;
+	run_lengths_ = nullptr;
+	external_ = true;
+	ClearNulls();
+}
+
+void Vector::ReferenceDictionary(const Vector &dictionary, const sel_t *codes, uint32_t count) {
+#ifndef NDEBUG
+	assert(dictionary.logical_type_ == logical_type_);
+	assert(!dictionary.IsDictionary());
+	assert(count <= capacity_);
+#endif
+	UseOwnBuffer();
+	dictionary_ = &dictionary;
+	codes_ = codes;
+	size_ = count;
+	ClearNulls();
+}
+
+void Vector::ReferenceRuns(const Vector &values, const uint32_t *lengths, uint32_t count) {
+#ifndef NDEBUG
+	assert(values.logical_type_ == logical_type_);
+	assert(!values.IsDictionary() && !values.IsRuns());
+	assert(count <= capacity_);
+#endif
+	UseOwnBuffer();
+	run_values_ = &values;
+	run_lengths_ = lengths;
+	size_ = count;
+	ClearNulls();
+	if (!values.HasNulls())
+		return;
+	for (uint32_t r = 0, start = 0; r < values.size_; start += lengths[r++]) {
+		if (!values.IsNull(r))
+			continue;
+		for (uint32_t i = start; i < start + lengths[r]; i++)
+			SetNull(i);
+	}
+}
+
+/**
+ * @brief Copy the values at positions index(0), ..., index(count - 1) of `src` to `dst`
+ *
+ */
+template <typename Index>
+static void CopyValues(uint8_t *dst, const uint8_t *src, uint32_t elem_size, uint32_t count,
+					   Index index) {
+	/** Typed copies for the common widths, the compiler turns these into plain loads/stores */
+	switch (elem_size) {
+	case 1:
+		for (uint32_t i = 0; i < count; i++)
+			dst[i] = src[index(i)];
+		break;
+	case 4:
+		for (uint32_t i = 0; i < count; i++)
+			std::memcpy(dst + static_cast<size_t>(i) * 4, src + static_cast<size_t>(index(i)) * 4,
+						4);
+		break;
+	case 8:
+		for (uint32_t i = 0; i < count; i++)
+			std::memcpy(dst + static_cast<size_t>(i) * 8, src + static_cast<size_t>(index(i)) * 8,
+						8);
+		break;
+	default:
+		for (uint32_t i = 0; i < count; i++)
+			std::memcpy(dst + static_cast<size_t>(i) * elem_size,
+						src + static_cast<size_t>(index(i)) * elem_size, elem_size);
+		break;
+	}
+}
+
+/**
+ * @brief Repeat the value of each run of `values` for the rows [offset, offset + count) the
+ * runs cover, into `dst`
+ *
+ */
+static void ExpandRuns(uint8_t *dst, const uint8_t *values, const uint32_t *lengths,
+					   size_t elem_size, uint32_t offset, uint32_t count) {
+	/** Skip to the run of row `offset` */
+	uint32_t run = 0;
+	uint32_t start = 0;
+	while (start + lengths[run] <= offset)
+		start += lengths[run++];
+	for (uint32_t i = 0; i < count; start += lengths[run++]) {
+		const uint32_t n = std::min(start + lengths[run] - (offset + i), count - i);
+		const uint8_t *value = values + run * elem_size;
+		for (uint32_t j = 0; j < n; j++)
+			std::memcpy(dst + static_cast<size_t>(i + j) * elem_size, value, elem_size);
+		i += n;
+	}
+}
+
+void Vector::Flatten() {
+	if (IsRuns()) {
+		ExpandRuns(static_cast<uint8_t *>(buffer_),
+				   static_cast<const uint8_t *>(run_values_->data_), run_lengths_,
+				   GetTypeSize(logical_type_), 0, size_);
+		data_ = buffer_;
+		run_values_ = nullptr;
+		run_lengths_ = nullptr;
+		return;
+	}
+	if (!IsDictionary())
+		return;
+	const sel_t *codes = codes_;
+	CopyValues(static_cast<uint8_t *>(buffer_), static_cast<const uint8_t *>(dictionary_->data_),
+			   GetTypeSize(logical_type_), size_, [codes](uint32_t i) { return codes[i]; });
+	data_ = buffer_;
+	dictionary_ = nullptr;
+	codes_ = nullptr;
+}
+
+void Vector::Copy(const Vector &source, uint32_t offset, uint32_t count, uint32_t target) {
+#ifndef NDEBUG
+	assert(source.logical_type_ == logical_type_);
+	assert(offset + count <= source.size_);
+	assert(target + count <= size_);
+	assert(!IsDictionary() && !IsRuns());
+#endif
+	const size_t elem_size = GetTypeSize(logical_type_);
+	/** The rows outside [target, target + count) are kept, so they move into our buffer first */
+	if (external_) {
+		std::memcpy(buffer_, data_, size_ * elem_size);
+		UseOwnBuffer();
+	}
+	auto *dst = static_cast<uint8_t *>(data_) + target * elem_size;
+	if (source.IsRuns()) {
+		ExpandRuns(dst, static_cast<const uint8_t *>(source.run_values_->data_),
+				   source.run_lengths_, elem_size, offset, count);
+	} else if (source.IsDictionary()) {
+		const sel_t *codes = source.codes_ + offset;
+		CopyValues(dst, static_cast<const uint8_t *>(source.dictionary_->data_),
+				   static_cast<uint32_t>(elem_size), count,
+				   [codes](uint32_t i) { return codes[i]; });
+	} else {
+		const auto *src = static_cast<const uint8_t *>(source.data_) + offset * elem_size;
+		std::memcpy(dst, src, count * elem_size);
+	}
+
+	if (!source.HasNulls() && !HasNulls())
+		return;
+	for (uint32_t i = 0; i < count; i++) {
+		if (source.HasNulls() && source.IsNull(offset + i))
+			SetNull(target + i);
+		else
+			ClearNull(target + i);
+	}
+}
+
+void Vector::Gather(const Vector &source, const SelectionVector &sel, uint32_t count) {
+#ifndef NDEBUG
+	assert(source.logical_type_ == logical_type_);
+	assert(!source.IsRuns());
+	assert(count <= capacity_);
+#endif
+	if (IsDictionary() || IsRuns() || external_)
+		UseOwnBuffer();
+	size_ = count;
+	ClearNulls();
+
+	const uint32_t elem_size = GetTypeSize(logical_type_);
+	auto *dst = static_cast<uint8_t *>(data_);
+	if (source.IsDictionary()) {
+		const sel_t *codes = source.codes_;
+		CopyValues(dst, static_cast<const uint8_t *>(source.dictionary_->data_), elem_size, count,
+				   [codes, &sel](uint32_t i) { return codes[sel.Get(i)]; });
+	} else {
+		CopyValues(dst, static_cast<const uint8_t *>(source.data_), elem_size, count,
+				   [&sel](uint32_t i) { return sel.Get(i); });
+	}
+
+	if (!source.HasNulls())
+		return;
+	for (uint32_t i = 0; i < count; i++) {
+		if (source.IsNull(sel.Get(i)))
+			SetNull(i);
+	}
 }
 
 LogicalType Vector::Type() const noexcept {
@@ -140,7 +361,18 @@ void Vector::ClearNulls() {
 	null_count_ = 0;
 }
 
+void Vector::UseOwnBuffer() noexcept {
+	data_ = buffer_;
+	dictionary_ = nullptr;
+	codes_ = nullptr;
+	run_values_ = nullptr;
+	run_lengths_ = nullptr;
+	external_ = false;
+}
+
 void Vector::Reset() {
+	if (IsDictionary() || IsRuns() || external_)
+		UseOwnBuffer();
 	size_ = 0;
 	null_count_ = 0;
 	nulls_->Reset();
@@ -2,4 +2,13 @@
 
 namespace electricdb {
 #define DEFAULT_VECTOR_SIZE 1024
+/** @brief Largest batch size a narrow pipeline may choose for itself, see GrowBatchSize() */
+#define MAX_VECTOR_SIZE 16384
+/** @brief Rows per unit of scheduled work, a multiple of the vector size */
+#define DEFAULT_MORSEL_SIZE (100 * DEFAULT_VECTOR_SIZE)
+/**
+ * @brief Rows per row group of a column file. File scans hand out one row group per morsel (see
+ * PhysicalOperator::SourceMorselSize()), so a row group is scanned by one worker.
+ */
+#define DEFAULT_ROW_GROUP_SIZE DEFAULT_MORSEL_SIZE
 } // namespace electricdb
\ No newline at end of file
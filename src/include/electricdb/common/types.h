@@ -41,6 +41,18 @@ bool TypeMatches(LogicalType type) {
 	return LogicalTypeTrait<std::remove_cv_t<T>>::type == type;
 }
 
+/**
+ * @brief Whether two key values fall in the same group. Floats compare like their sort keys:
+ * -0.0 equals 0.0 and every NaN equals every other NaN.
+ */
+template <typename T>
+inline bool KeyEquals(T a, T b) noexcept {
+	if constexpr (std::is_floating_point_v<T>)
+		return a == b || (a != a && b != b);
+	else
+		return a == b;
+}
+
 inline uint32_t GetTypeSize(LogicalType type) {
 	switch (type) {
 	case LogicalType::INT32:
@@ -3,6 +3,7 @@
 #include "electricdb/common/constants.h"
 #include "electricdb/execution/vector/selection_vector.h"
 #include "electricdb/execution/vector/vector.h"
+#include "electricdb/runtime/metrics.h"
 #include "electricdb/util/arena.h"
 
 #include <deque>
@@ -10,6 +11,8 @@
 
 namespace electricdb {
 
+class CancellationToken;
+
 /**
  * @brief ExecutionContext represents thread-local state for execution.
  *
@@ -35,6 +38,9 @@ class ExecutionContext {
 	/** @brief Default vector size (batch size) */
 	uint32_t VectorSize() const { return default_vector_size_; }
 
+	/** @brief Change the capacity of temporary vectors, e.g. to the batch size of a pipeline */
+	void SetVectorSize(uint32_t vector_size) { default_vector_size_ = vector_size; }
+
 	/** @brief Set input chunk for ColumnExpr */
 	void SetInput(const std::vector<Vector> *input) { input_ = input; }
 
@@ -46,6 +52,16 @@ class ExecutionContext {
 	/** @brief Return selection vector */
 	const SelectionVector *Selection() const { return selection_; }
 
+	/** @brief Counters of the operator being run, null unless the query is profiled */
+	OperatorMetrics *Metrics() const { return metrics_; }
+
+	void SetMetrics(OperatorMetrics *metrics) { metrics_ = metrics; }
+
+	/** @brief Token of the query being run, for operators that block, null if it has none */
+	const CancellationToken *Token() const { return token_; }
+
+	void SetToken(const CancellationToken *token) { token_ = token; }
+
 	/**
 	 * @brief Get index to a temporary vector owned by this context
 	 */
@@ -67,6 +83,10 @@ class ExecutionContext {
 
 	/** @brief Current selection vector */
 	const SelectionVector *selection_ = nullptr;
+
+	OperatorMetrics *metrics_ = nullptr;
+
+	const CancellationToken *token_ = nullptr;
 };
 
 } // namespace electricdb
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Bytes a pipeline may spend on the batches it keeps live at once
+ *
+ * Half of the per-core L2 cache, leaving room for hash tables, selection vectors and the code
+ * around them. Falls back to a conservative guess where the cache size cannot be queried.
+ */
+size_t BatchCacheBudget();
+
+/**
+ * @brief Bytes one row takes in every column of `types`, null mask bits included
+ */
+size_t RowWidth(const std::vector<LogicalType> &types);
+
+/**
+ * @brief Grow a narrow pipeline's batch size from DEFAULT_VECTOR_SIZE up to MAX_VECTOR_SIZE
+ *
+ * Doubles DEFAULT_VECTOR_SIZE while one batch of all live columns still fits into `cache_bytes`,
+ * to amortize the per-batch overhead. Never returns less than DEFAULT_VECTOR_SIZE, so from about
+ * 32 live INT64 columns on a batch takes more than `cache_bytes`: batch_size_bench measures
+ * smaller batches slower than DEFAULT_VECTOR_SIZE at every width.
+ *
+ * @param row_width Bytes per row summed over every live column of the pipeline
+ * @param cache_bytes Budget for the live batches
+ */
+uint32_t GrowBatchSize(size_t row_width, size_t cache_bytes = BatchCacheBudget());
+
+} // namespace electricdb
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/context/execution_context.h"
+#include "electricdb/execution/engine/scheduler.h"
+#include "electricdb/execution/vector/vector.h"
+#include "electricdb/util/arena.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace electricdb {
+
+enum class PhysicalOperatorType : uint8_t {
+	COLUMN_SCAN,
+	FILE_SCAN,
+	FILTER,
+	PROJECTION,
+	HASH_AGGREGATE,
+	HASH_JOIN,
+	ORDER_BY,
+	TOP_N,
+	STREAMING_AGGREGATE,
+	WINDOW,
+	RESULT_COLLECTOR
+};
+
+/** @brief Name of an operator type as shown in EXPLAIN ANALYZE */
+const char *PhysicalOperatorTypeName(PhysicalOperatorType type);
+
+/**
+ * @brief Result of pushing one chunk through a streaming operator
+ *
+ */
+enum class OperatorResult : uint8_t {
+	/** @brief The input chunk is consumed, push the next one */
+	NEED_MORE_INPUT,
+	/** @brief `output` is full, call Execute() again with the same input */
+	HAVE_MORE_OUTPUT
+};
+
+/**
+ * @brief Per-thread state of a streaming operator, e.g. the resume position of a join probe
+ *
+ */
+struct OperatorState {
+	virtual ~OperatorState() = default;
+};
+
+/**
+ * @brief Per-thread state a sink accumulates into before Combine()
+ *
+ */
+struct LocalSinkState {
+	virtual ~LocalSinkState() = default;
+
+	/** @brief Source offset of the chunk being sunk, lets order-preserving sinks restore order */
+	uint64_t batch_index = 0;
+	/** @brief Source offset of the morsel being sunk, a worker sinks one morsel at a time */
+	uint64_t morsel_index = 0;
+};
+
+/**
+ * @brief Per-thread read state of a source
+ *
+ */
+struct LocalSourceState {
+	virtual ~LocalSourceState() = default;
+};
+
+/**
+ * @brief Node of a physical plan in the push-based execution model.
+ *
+ * An operator takes part in pipelines in up to three roles:
+ * - source: produces rows [offset, offset + count) of its output on request, so a pipeline can
+ *   hand out disjoint row ranges (morsels) to workers,
+ * - streaming operator: transforms one chunk at a time without blocking,
+ * - sink: consumes every chunk into a thread-local state, then Combine() merges each local state
+ *   and Finalize() runs once all input has arrived.
+ *
+ * Pipeline breakers such as aggregates and sorts are sinks of one pipeline and the source of the
+ * next. A hash join is the sink of its build side (children[1]) and a streaming operator in the
+ * pipeline of its probe side (children[0]).
+ */
+class PhysicalOperator {
+  public:
+	PhysicalOperator(PhysicalOperatorType type, std::vector<LogicalType> types);
+	virtual ~PhysicalOperator() = default;
+
+	/** @brief Disable copy constructor */
+	PhysicalOperator(const PhysicalOperator &) = delete;
+
+	/** @brief Disable copy assignment */
+	PhysicalOperator &operator=(const PhysicalOperator &) = delete;
+
+	PhysicalOperatorType Type() const noexcept { return type_; }
+
+	/** @brief Types of the output columns */
+	const std::vector<LogicalType> &Types() const noexcept { return types_; }
+
+	const std::vector<PhysicalOperator *> &Children() const noexcept { return children_; }
+
+	/** @brief Append an input, children are not owned */
+	void AddChild(PhysicalOperator *child) { children_.push_back(child); }
+
+	/**
+	 * @brief Check if Execute() or Sink() takes column `column` of its input as a dictionary
+	 * vector (see Vector::ReferenceDictionary()). The pipeline flattens the dictionary vectors of
+	 * every other column before handing a chunk over.
+	 */
+	virtual bool AcceptsDictionary(idx_t) const { return false; }
+
+	/**
+	 * @brief Check if Execute() or Sink() takes column `column` of its input as a run vector (see
+	 * Vector::ReferenceRuns()). The pipeline flattens the run vectors of every other column.
+	 */
+	virtual bool AcceptsRuns(idx_t) const { return false; }
+
+	/**
+	 * @brief Functions below are for streaming operators
+	 *
+	 */
+	virtual std::unique_ptr<OperatorState> InitOperatorState() const;
+
+	/**
+	 * @brief Transform `input` into `output`
+	 *
+	 * @param ctx Context of the calling worker
+	 * @param input Chunk produced by the previous operator
+	 * @param output Chunk of Types() with a capacity of at least the pipeline's batch size
+	 * @param state State created by InitOperatorState() for the calling worker
+	 * @return OperatorResult Whether the same input has to be pushed again
+	 */
+	virtual OperatorResult Execute(ExecutionContext &ctx, const std::vector<Vector> &input,
+								   std::vector<Vector> &output, OperatorState &state) const;
+
+	/**
+	 * @brief Functions below are for sources
+	 *
+	 */
+	virtual bool IsSource() const { return false; }
+
+	/** @brief Number of rows this source produces, valid once its input pipelines are done */
+	virtual uint64_t SourceRowCount() const;
+
+	/** @brief Whether disjoint row ranges may be read concurrently and in any order */
+	virtual bool ParallelSource() const { return true; }
+
+	/**
+	 * @brief Rows per morsel that match how the source stores its rows, e.g. the row groups of a
+	 * file, so no batch spans two of them. 0 leaves the morsel size to the pipeline.
+	 */
+	virtual uint64_t SourceMorselSize() const { return 0; }
+
+	virtual std::unique_ptr<LocalSourceState> InitLocalSource() const;
+
+	/**
+	 * @brief Write rows [offset, offset + count) of the output into `out`
+	 *
+	 * @param ctx Context of the calling worker
+	 * @param state State created by InitLocalSource() for the calling worker
+	 * @param offset First row to emit
+	 * @param count Number of rows to emit, at most the capacity of `out`
+	 * @param out Chunk of Types()
+	 */
+	virtual void GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset,
+						 idx_t count, std::vector<Vector> &out) const;
+
+	/**
+	 * @brief Functions below are for sinks
+	 *
+	 */
+	virtual bool IsSink() const { return false; }
+
+	virtual std::unique_ptr<LocalSinkState> InitLocalSink() const;
+
+	/** @brief Consume a chunk into the local state of the calling worker */
+	virtual void Sink(ExecutionContext &ctx, LocalSinkState &state,
+					  const std::vector<Vector> &chunk);
+
+	/** @brief Merge a local state into the operator. Thread safe. */
+	virtual void Combine(LocalSinkState &state);
+
+	/**
+	 * @brief Called once after every local state has been combined, never from a worker
+	 *
+	 * @param scheduler Scheduler to run parallel work of the operator on as tasks
+	 * @param token Cancellation token of the query, may be null
+	 */
+	virtual void Finalize(Scheduler &scheduler, const CancellationToken *token);
+
+	/**
+	 * @brief Release everything the sink accumulated, e.g. after its query was cancelled
+	 *
+	 * Not called concurrently with any other function of the operator.
+	 */
+	virtual void Abort();
+
+	/**
+	 * @brief Allocate a chunk of `types` in `arena`
+	 *
+	 */
+	static std::vector<Vector> MakeChunk(const std::vector<LogicalType> &types, uint32_t capacity,
+										 Arena &arena);
+
+	/**
+	 * @brief Point `view` at the columns of `input`, except that dictionary vectors among
+	 * `columns` are flattened into `flat` first. Lets expressions that read `columns` run over a
+	 * chunk that keeps its other columns as dictionaries.
+	 *
+	 * @param input Chunk to view
+	 * @param columns Columns that must be flat
+	 * @param flat Chunk of the input types with a capacity of at least the input size
+	 * @param view Chunk of the input types
+	 */
+	static void FlattenColumns(const std::vector<Vector> &input,
+							   const std::vector<uint32_t> &columns, std::vector<Vector> &flat,
+							   std::vector<Vector> &view);
+
+  protected:
+	PhysicalOperatorType type_;
+	std::vector<LogicalType> types_;
+	std::vector<PhysicalOperator *> children_;
+};
+
+} // namespace electricdb
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/execution/engine/scheduler.h"
+#include "electricdb/runtime/metrics.h"
+#include "electricdb/runtime/perf_counters.h"
+#include "electricdb/util/stopwatch.h"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace electricdb {
+
+/** @brief Merged counters per operator of a profiled query */
+using OperatorProfile = std::unordered_map<const PhysicalOperator *, OperatorMetrics>;
+
+/**
+ * @brief A chain source -> streaming operators -> sink that runs without blocking.
+ *
+ * Workers pull morsels of the source's row range from the Scheduler and push every batch through
+ * the operators into their own LocalSinkState, without any virtual per-row or per-operator pull
+ * calls. Once all morsels ran, Finish() combines the local states into the sink and finalizes it,
+ * which makes the sink's output available to the pipelines that depend on it.
+ */
+class Pipeline {
+  public:
+	/** @brief Create a pipeline that ends in `sink` */
+	explicit Pipeline(PhysicalOperator *sink);
+
+	/** @brief Disable copy constructor */
+	Pipeline(const Pipeline &) = delete;
+
+	/** @brief Disable copy assignment */
+	Pipeline &operator=(const Pipeline &) = delete;
+
+	void SetSource(PhysicalOperator *source) { source_ = source; }
+
+	/** @brief Append a streaming operator, in the order batches pass through them */
+	void AddOperator(PhysicalOperator *op) { operators_.push_back(op); }
+
+	/** @brief Require `dependency` to finish before this pipeline is scheduled */
+	void AddDependency(Pipeline *dependency) { dependencies_.push_back(dependency); }
+
+	PhysicalOperator *Source() const noexcept { return source_; }
+
+	const std::vector<PhysicalOperator *> &Operators() const noexcept { return operators_; }
+
+	PhysicalOperator *Sink() const noexcept { return sink_; }
+
+	const std::vector<Pipeline *> &Dependencies() const noexcept { return dependencies_; }
+
+	/** @brief Check if every dependency has finished */
+	bool IsReady() const noexcept;
+
+	bool IsFinished() const noexcept { return finished_; }
+
+	/**
+	 * @brief Rows per batch pushed through the pipeline, set by Schedule()
+	 *
+	 * Narrow pipelines run batches of up to MAX_VECTOR_SIZE rows, which batch_size_bench measures
+	 * 1.03x-1.14x faster than DEFAULT_VECTOR_SIZE at 2-8 columns, on par at 1 and 16. Wide
+	 * pipelines keep DEFAULT_VECTOR_SIZE, larger batches no longer fit into L2 there.
+	 */
+	uint32_t BatchSize() const noexcept { return batch_size_; }
+
+	/**
+	 * @brief Push batches of `batch_size` rows instead of the size Schedule() grows from the live
+	 * columns with GrowBatchSize()
+	 */
+	void SetBatchSize(uint32_t batch_size);
+
+	/**
+	 * @brief Collect per-thread counters for every operator of the pipeline
+	 *
+	 * @param profile Receives the merged counters in Finish(), null to stop profiling
+	 * @param hardware_counters Also count cycles, instructions and cache and branch misses per
+	 * stage with PerfCounters, each read costs a system call
+	 */
+	void EnableProfiling(OperatorProfile *profile, bool hardware_counters = false) noexcept {
+		profile_ = profile;
+		hardware_counters_ = hardware_counters;
+	}
+
+	/**
+	 * @brief Bytes per row over the output columns of the source and every operator
+	 *
+	 * A worker keeps one batch of each of these chunks live while a batch travels up the pipeline.
+	 */
+	size_t LiveRowWidth() const;
+
+	/**
+	 * @brief Submit the morsels of the source to `scheduler`
+	 *
+	 * @param scheduler Scheduler to run the morsels on
+	 * @param token Checked before every batch, may be null. Must outlive the task.
+	 * @return std::shared_ptr<Task> Task to wait on before calling Finish()
+	 */
+	std::shared_ptr<Task> Schedule(Scheduler &scheduler, const CancellationToken *token = nullptr);
+
+	/**
+	 * @brief Combine the local sink states and finalize the sink
+	 *
+	 * @param scheduler Scheduler the sink runs the tasks of Finalize() on, must not be called
+	 * from one of its workers
+	 */
+	void Finish(Scheduler &scheduler);
+
+	/** @brief Drop the local states of the workers and release the sink's state */
+	void Abort();
+
+	/** @brief Schedule(), wait and Finish() */
+	void Execute(Scheduler &scheduler, const CancellationToken *token = nullptr);
+
+  private:
+	/** @brief Everything one worker needs to run the pipeline */
+	struct LocalState {
+		/** @brief Backs the intermediate chunks, which live across morsels */
+		Arena arena;
+		std::unique_ptr<LocalSourceState> source;
+		std::vector<std::unique_ptr<OperatorState>> states;
+		/** @brief chunks[0] holds the source output, chunks[i + 1] the output of operator i */
+		std::vector<std::vector<Vector>> chunks;
+		std::unique_ptr<LocalSinkState> sink;
+
+		/** @brief Profiling only. Stage 0 is the source, i + 1 operator i, the last the sink */
+		std::vector<OperatorMetrics> metrics;
+		std::vector<Stopwatch> wall;
+		std::vector<Stopwatch> cpu;
+		/** @brief Bytes used in the context's arena when the current stage started */
+		uint64_t arena_mark = 0;
+		/** @brief Counters of the worker's thread, null if disabled or refused by the kernel */
+		std::unique_ptr<PerfCounters> perf;
+		PerfSample perf_mark{};
+	};
+
+	/** @brief State of `worker_id`, created on its first morsel */
+	LocalState &GetLocalState(uint32_t worker_id);
+
+	void ExecuteMorsel(ExecutionContext &ctx, uint32_t worker_id, const Morsel &morsel);
+
+	/** @brief Push local.chunks[level] into operator `level`, or into the sink after the last */
+	void Push(ExecutionContext &ctx, LocalState &local, size_t level);
+
+	/** @brief Start attributing time and scratch memory to `stage`, a no-op unless profiling */
+	void BeginStage(ExecutionContext &ctx, LocalState &local, size_t stage) const;
+
+	/** @brief Stop attributing to `stage` */
+	void EndStage(ExecutionContext &ctx, LocalState &local, size_t stage) const;
+
+	/** @brief Operator of a profiling stage */
+	const PhysicalOperator *StageOperator(size_t stage) const;
+
+	/** @brief Merge the counters of all workers and of the sink's Combine()/Finalize() */
+	void MergeProfile(uint64_t finish_wall_ns, uint64_t finish_cpu_ns);
+
+	PhysicalOperator *source_ = nullptr;
+	std::vector<PhysicalOperator *> operators_;
+	PhysicalOperator *sink_;
+	std::vector<Pipeline *> dependencies_;
+
+	uint32_t batch_size_ = DEFAULT_VECTOR_SIZE;
+	/** @brief Set by SetBatchSize(), 0 lets Schedule() choose */
+	uint32_t requested_batch_size_ = 0;
+	const CancellationToken *token_ = nullptr;
+	OperatorProfile *profile_ = nullptr;
+	bool hardware_counters_ = false;
+	/** @brief One slot per scheduler worker, each only touched by its worker */
+	std::vector<std::unique_ptr<LocalState>> locals_;
+	bool finished_ = false;
+};
+
+} // namespace electricdb
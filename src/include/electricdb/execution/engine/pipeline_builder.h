@@ -0,0 +1,82 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/execution/engine/pipeline.h"
+#include "electricdb/execution/engine/scheduler.h"
+#include "electricdb/runtime/metrics.h"
+
+#include <memory>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Splits a physical plan into pipelines at its breakers.
+ *
+ * Starting at the root sink, operators are walked down towards the leaves. A streaming operator
+ * joins the current pipeline. An operator that is both sink and source (aggregate, sort) becomes
+ * the source of the current pipeline and the sink of a new one built from its child. A hash join
+ * stays in the current (probe) pipeline and becomes the sink of a new pipeline built from its
+ * build side. Every new pipeline is a dependency of the pipeline that reads its sink.
+ */
+class PipelineBuilder {
+  public:
+	/**
+	 * @brief Build the pipelines of the plan below `root`
+	 *
+	 * @param root Sink at the top of the plan, e.g. a result collector
+	 */
+	explicit PipelineBuilder(PhysicalOperator &root);
+
+	/** @brief Pipelines ordered so that every pipeline comes after its dependencies */
+	const std::vector<std::unique_ptr<Pipeline>> &Pipelines() const noexcept { return pipelines_; }
+
+	/**
+	 * @brief Run every pipeline. Pipelines whose dependencies are done run concurrently.
+	 *
+	 * If a pipeline fails or `token` is cancelled, the running pipelines stop at their next batch,
+	 * no further pipeline starts and every operator releases its state before the error
+	 * (QueryCancelled for a cancellation) is rethrown.
+	 *
+	 * @param scheduler Scheduler to run the pipelines on
+	 * @param token Cancellation token of the query, may be null
+	 */
+	void Execute(Scheduler &scheduler, const CancellationToken *token = nullptr);
+
+	/**
+	 * @brief Collect per-operator counters in the next Execute(), see Profile()
+	 *
+	 * @param hardware_counters Also read the CPU's performance counters around every operator.
+	 * Left at 0 where the kernel does not allow it.
+	 */
+	void EnableProfiling(bool hardware_counters = false);
+
+	/**
+	 * @brief Counters of every operator of the last profiled Execute(), shaped like the plan
+	 *
+	 * @return QueryProfile Profile to print as EXPLAIN ANALYZE or export as JSON
+	 */
+	QueryProfile Profile() const;
+
+  private:
+	/** @brief Build the pipeline that pushes the output of `input` into `sink` */
+	Pipeline *Build(PhysicalOperator &sink, PhysicalOperator &input);
+
+	/** @brief Run the pipelines in dependency order, Execute() cleans up if this throws */
+	void Run(Scheduler &scheduler, const CancellationToken *token);
+
+	/** @brief Add `op` and its inputs to `pipeline`, collecting streaming operators top-down */
+	void Walk(Pipeline &pipeline, PhysicalOperator &op, std::vector<PhysicalOperator *> &operators);
+
+	/** @brief Profile of `op` and its inputs */
+	ProfileNode ProfileOperator(const PhysicalOperator &op) const;
+
+	PhysicalOperator &root_;
+	std::vector<std::unique_ptr<Pipeline>> pipelines_;
+
+	/** @brief Merged counters per operator, only allocated when profiling */
+	std::unique_ptr<OperatorProfile> profile_;
+	uint64_t wall_ns_ = 0;
+};
+
+} // namespace electricdb
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "electricdb/common/constants.h"
+#include "electricdb/execution/context/execution_context.h"
+#include "electricdb/runtime/cancellation.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief A range of rows [begin, end) of a task's input, processed by one worker at a time
+ *
+ */
+struct Morsel {
+	uint64_t begin;
+	uint64_t end;
+};
+
+/**
+ * @brief Work done for one morsel
+ *
+ * @param context Context of the worker running the morsel, reset after every morsel
+ * @param worker_id Index of that worker, in [0, Scheduler::WorkerCount())
+ * @param morsel Rows to process
+ */
+using MorselFunction =
+		std::function<void(ExecutionContext &context, uint32_t worker_id, const Morsel &morsel)>;
+
+/**
+ * @brief A data-parallel job over rows [0, row count), split into morsels by the Scheduler
+ *
+ */
+class Task {
+  public:
+	/**
+	 * @brief Construct a new Task
+	 *
+	 * @param function Work done per morsel
+	 * @param row_count Number of rows of the input
+	 * @param morsel_size Upper bound on the rows of one morsel
+	 * @param token Morsels are skipped once it is cancelled, may be null. Must outlive the task.
+	 */
+	Task(MorselFunction function, uint64_t row_count, uint64_t morsel_size,
+		 const CancellationToken *token = nullptr);
+
+	/** @brief Disable copy constructor */
+	Task(const Task &) = delete;
+
+	/** @brief Disable copy assignment */
+	Task &operator=(const Task &) = delete;
+
+	/** @brief Block until every morsel has run, rethrows the first exception of a morsel */
+	void Wait();
+
+	/** @brief Check if every morsel has run */
+	bool IsDone() const noexcept { return remaining_.load(std::memory_order_acquire) == 0; }
+
+	uint64_t MorselSize() const noexcept { return morsel_size_; }
+
+  private:
+	friend class Scheduler;
+
+	/** @brief Run one morsel, or skip it if an earlier morsel failed or the task was cancelled */
+	void Execute(ExecutionContext &context, uint32_t worker_id, const Morsel &morsel);
+
+	/** @brief Check if the remaining morsels will be skipped */
+	bool Skipping() const noexcept {
+		return failed_.load(std::memory_order_relaxed) || (token_ && token_->IsCancelled());
+	}
+
+	MorselFunction function_;
+	uint64_t morsel_size_;
+	const CancellationToken *token_;
+	/** @brief Rows not processed yet, the task is done at 0 */
+	std::atomic<uint64_t> remaining_;
+	std::atomic<bool> failed_{false};
+
+	std::mutex lock_;
+	std::condition_variable done_;
+	std::exception_ptr error_;
+};
+
+/**
+ * @brief Fixed pool of workers executing morsel-driven tasks.
+ *
+ * Every worker owns an ExecutionContext and a deque of row ranges. A new task is cut into one
+ * contiguous range per worker; a worker carves one morsel at a time off the range at the front of
+ * its deque and then rotates that range to the back, so the tasks of concurrent queries take turns
+ * morsel by morsel. A worker whose deque is empty steals from the back of another worker's deque,
+ * taking half of the range if it is large, so a skewed task keeps every core busy until its last
+ * morsel.
+ */
+class Scheduler {
+  public:
+	/**
+	 * @brief Start the workers
+	 *
+	 * @param num_workers Number of worker threads, 0 for one per hardware thread
+	 */
+	explicit Scheduler(uint32_t num_workers = 0);
+
+	/** @brief Finish all submitted tasks and join the workers */
+	~Scheduler();
+
+	/** @brief Disable copy constructor */
+	Scheduler(const Scheduler &) = delete;
+
+	/** @brief Disable copy assignment */
+	Scheduler &operator=(const Scheduler &) = delete;
+
+	/**
+	 * @brief Schedule `function` over rows [0, row_count)
+	 *
+	 * Must not be waited on from inside a morsel, the waiting worker would be lost to the pool.
+	 *
+	 * @param function Work done per morsel
+	 * @param row_count Number of rows of the input
+	 * @param morsel_size Upper bound on the rows of one morsel
+	 * @param token Cancels the remaining morsels, Wait() then throws QueryCancelled. May be null.
+	 * @return std::shared_ptr<Task> Handle to wait on
+	 */
+	std::shared_ptr<Task> Submit(MorselFunction function, uint64_t row_count,
+								 uint64_t morsel_size = DEFAULT_MORSEL_SIZE,
+								 const CancellationToken *token = nullptr);
+
+	/** @brief Submit() and wait for the task */
+	void Run(MorselFunction function, uint64_t row_count,
+			 uint64_t morsel_size = DEFAULT_MORSEL_SIZE, const CancellationToken *token = nullptr);
+
+	uint32_t WorkerCount() const noexcept { return static_cast<uint32_t>(workers_.size()); }
+
+	/** @brief Number of ranges taken from another worker's deque so far */
+	uint64_t StealCount() const noexcept { return steals_.load(std::memory_order_relaxed); }
+
+  private:
+	/** @brief Rows [begin, end) of a task that are not assigned to a morsel yet */
+	struct Range {
+		std::shared_ptr<Task> task;
+		uint64_t begin;
+		uint64_t end;
+	};
+
+	struct Worker {
+		std::thread thread;
+		ExecutionContext context;
+		std::mutex lock;
+		std::deque<Range> queue;
+	};
+
+	void WorkerLoop(uint32_t id);
+
+	/** @brief Carve the next morsel off the front of the worker's own deque */
+	bool PopLocal(Worker &worker, std::shared_ptr<Task> &task, Morsel &morsel);
+
+	/** @brief Move work from another worker's deque into the deque of `id` */
+	bool Steal(uint32_t id);
+
+	/** @brief Append a range to a worker's deque */
+	void Push(Worker &worker, Range range);
+
+	/** @brief Wake one or all idle workers after new ranges were pushed */
+	void Wake(bool all);
+
+	std::vector<std::unique_ptr<Worker>> workers_;
+
+	/** @brief Ranges queued over all deques */
+	std::atomic<uint64_t> pending_{0};
+	std::atomic<uint64_t> steals_{0};
+	/** @brief Worker that receives the first range of the next task */
+	std::atomic<uint32_t> next_worker_{0};
+
+	std::mutex sleep_lock_;
+	std::condition_variable wake_;
+	bool stop_ = false;
+};
+
+} // namespace electricdb
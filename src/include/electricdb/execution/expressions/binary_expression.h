@@ -14,6 +14,7 @@ class AddExpr final : public Expression {
 
 	void Execute(ExecutionContext &ctx, Vector &result) override;
 	LogicalType Type() const override;
+	void CollectColumns(std::vector<uint32_t> &columns) const override;
 
   private:
 	Expression *left_;
@@ -41,6 +42,7 @@ class SubExpr final : public Expression {
 
 	void Execute(ExecutionContext &ctx, Vector &result) override;
 	LogicalType Type() const override;
+	void CollectColumns(std::vector<uint32_t> &columns) const override;
 
   private:
 	Expression *left_;
@@ -69,6 +71,7 @@ class MultExpr final : public Expression {
 
 	void Execute(ExecutionContext &ctx, Vector &result) override;
 	LogicalType Type() const override;
+	void CollectColumns(std::vector<uint32_t> &columns) const override;
 
   private:
 	Expression *left_;
@@ -96,6 +99,7 @@ class DivExpr final : public Expression {
 
 	void Execute(ExecutionContext &ctx, Vector &result) override;
 	LogicalType Type() const override;
+	void CollectColumns(std::vector<uint32_t> &columns) const override;
 
   private:
 	Expression *left_;
@@ -4,6 +4,9 @@
 #include "electricdb/execution/context/execution_context.h"
 #include "electricdb/execution/vector/vector.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace electricdb {
 
 /**
@@ -18,6 +21,8 @@ class Expression {
 	virtual ~Expression() = default;
 	/** @brief Get type returned by expression */
 	virtual LogicalType Type() const = 0;
+	/** @brief Add the input columns the expression reads to `columns` */
+	virtual void CollectColumns(std::vector<uint32_t> &columns) const = 0;
 };
 
 } // namespace electricdb
\ No newline at end of file
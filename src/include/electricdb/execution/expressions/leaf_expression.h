@@ -15,6 +15,7 @@ class ColumnExpr final : public Expression {
 
 	void Execute(ExecutionContext &ctx, Vector &result) override;
 	LogicalType Type() const override;
+	void CollectColumns(std::vector<uint32_t> &columns) const override;
 
   private:
 	/** @brief Index to read from */
@@ -28,6 +29,7 @@ class ConstantExpr final : public Expression {
 
 	void Execute(ExecutionContext &ctx, Vector &result) override;
 	LogicalType Type() const override;
+	void CollectColumns(std::vector<uint32_t> &columns) const override;
 
   private:
 	/** The constant value */
@@ -127,7 +127,7 @@ inline void BinaryTypeDispatch(ExecutionContext &ctx, Vector &out, const Vector
 #endif
 
 	auto sel = ctx.Selection();
-	auto n = out.Size();
+	idx_t n = sel ? sel->Size() : out.Size();
 
 	out.ClearNulls();
 
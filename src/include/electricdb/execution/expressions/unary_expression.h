@@ -15,6 +15,7 @@ class NotExpr final : public Expression {
 
 	void Execute(ExecutionContext &ctx, Vector &result) override;
 	LogicalType Type() const override;
+	void CollectColumns(std::vector<uint32_t> &columns) const override;
 
   private:
 	Expression *child_;
@@ -44,6 +45,7 @@ class NegateExpr final : public Expression {
 
 	void Execute(ExecutionContext &ctx, Vector &result) override;
 	LogicalType Type() const override;
+	void CollectColumns(std::vector<uint32_t> &columns) const override;
 
   private:
 	Expression *child_;
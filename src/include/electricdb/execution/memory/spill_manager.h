@@ -0,0 +1,97 @@
+#pragma once
+
+#include "electricdb/io/file.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace electricdb {
+
+class SpillManager;
+
+/**
+ * @brief A temporary file written by an operator that ran out of memory.
+ *
+ * Data is appended sequentially and read back with positional reads. The file is deleted when the
+ * SpillFile is destroyed.
+ */
+class SpillFile {
+  public:
+	SpillFile(SpillManager &manager, std::string path);
+	~SpillFile();
+
+	/** @brief Disable copy constructor */
+	SpillFile(const SpillFile &) = delete;
+
+	/** @brief Disable copy assignment */
+	SpillFile &operator=(const SpillFile &) = delete;
+
+	/**
+	 * @brief Append `size` bytes to the end of the file
+	 *
+	 * @param data Bytes to append
+	 * @param size Number of bytes to append
+	 */
+	void Append(const void *data, size_t size);
+
+	/**
+	 * @brief Read up to `size` bytes at `offset`. Safe to call from several threads
+	 *
+	 * @return size_t Number of bytes read
+	 */
+	size_t Read(void *buffer, size_t size, uint64_t offset) const {
+		return file_.Read(buffer, size, offset);
+	}
+
+	/** @brief The open file, e.g. to read it with an AsyncReader */
+	const File &GetFile() const noexcept { return file_; }
+
+	/** @brief Number of bytes appended so far */
+	uint64_t Size() const noexcept { return size_; }
+
+	const std::string &Path() const noexcept { return file_.Path(); }
+
+  private:
+	SpillManager &manager_;
+	File file_;
+	uint64_t size_ = 0;
+};
+
+/**
+ * @brief Hands out temporary files for one query and accounts for the bytes written to them
+ *
+ */
+class SpillManager {
+  public:
+	/**
+	 * @brief Construct a new SpillManager
+	 *
+	 * @param directory Directory the temporary files are created in
+	 */
+	explicit SpillManager(std::string directory);
+
+	/** @brief Create a new, empty temporary file */
+	std::unique_ptr<SpillFile> CreateSpillFile();
+
+	/** @brief Total bytes appended to spill files created by this manager */
+	uint64_t BytesSpilled() const noexcept {
+		return bytes_spilled_.load(std::memory_order_relaxed);
+	}
+
+	/** @brief Bytes held by spill files that have not been deleted yet */
+	uint64_t BytesOnDisk() const noexcept { return bytes_on_disk_.load(std::memory_order_relaxed); }
+
+	const std::string &Directory() const noexcept { return directory_; }
+
+  private:
+	friend class SpillFile;
+
+	std::string directory_;
+	std::atomic<uint64_t> next_id_{0};
+	std::atomic<uint64_t> bytes_spilled_{0};
+	std::atomic<uint64_t> bytes_on_disk_{0};
+};
+
+} // namespace electricdb
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/vector.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace electricdb {
+
+enum class AggregateType : uint8_t { COUNT_STAR, COUNT, SUM, MIN, MAX, AVG };
+
+/**
+ * @brief An aggregate call in a GROUP BY, e.g. SUM(column 2)
+ *
+ */
+struct AggregateSpec {
+	AggregateType type;
+	/** @brief Index of the input column, ignored for COUNT(*) */
+	uint32_t column_idx = 0;
+};
+
+/**
+ * @brief Running state of one aggregate for one group
+ *
+ * Integer SUM/MIN/MAX accumulate in `int_value`, floating point SUM/MIN/MAX and AVG in
+ * `double_value`. `count` is the number of non-null inputs (all rows for COUNT(*)).
+ */
+struct AggregateState {
+	int64_t count = 0;
+	int64_t int_value = 0;
+	double double_value = 0;
+};
+
+/**
+ * @brief Type-resolved implementation of an AggregateSpec.
+ *
+ * The type switch happens once per call, the loops over rows are typed and branch-free apart from
+ * null handling.
+ */
+class AggregateFunction {
+  public:
+	/**
+	 * @brief Construct a new AggregateFunction
+	 *
+	 * @param spec Aggregate to compute
+	 * @param input_type Type of the input column, ignored for COUNT(*)
+	 */
+	AggregateFunction(AggregateSpec spec, LogicalType input_type);
+
+	const AggregateSpec &Spec() const noexcept { return spec_; }
+
+	LogicalType InputType() const noexcept { return input_type_; }
+
+	/** @brief Type of the value produced by Finalize() */
+	LogicalType ResultType() const noexcept { return result_type_; }
+
+	/**
+	 * @brief Fold rows [begin, end) of `input` into `state`
+	 *
+	 * @param state State of the group the rows belong to
+	 * @param input Input column (ignored for COUNT(*))
+	 * @param begin First row
+	 * @param end One past the last row
+	 */
+	void Update(AggregateState &state, const Vector &input, idx_t begin, idx_t end) const;
+
+	/**
+	 * @brief Fold runs of equal values into `state`, e.g. the runs of an RLE column chunk. Every
+	 * value is taken once for all rows of its run: SUM adds it times the run length, MIN and MAX
+	 * compare it once.
+	 *
+	 * @param state State of the group the runs belong to
+	 * @param values Value of each run, NULL for a run of NULL rows (ignored for COUNT(*))
+	 * @param lengths Rows of each run
+	 * @param runs Number of runs
+	 */
+	void UpdateRuns(AggregateState &state, const Vector &values, const uint32_t *lengths,
+					idx_t runs) const;
+
+	/**
+	 * @brief Fold every row of `input` into the state of its own group
+	 *
+	 * @param states States of all groups, the state of group g is states[g * stride]
+	 * @param stride Distance between the states of two consecutive groups
+	 * @param groups Group of each row
+	 * @param input Input column (ignored for COUNT(*))
+	 * @param count Number of rows
+	 */
+	void Scatter(AggregateState *states, size_t stride, const uint32_t *groups, const Vector &input,
+				 idx_t count) const;
+
+	/** @brief Fold `source` into `target`, both states of the same group */
+	void Combine(AggregateState &target, const AggregateState &source) const;
+
+	/**
+	 * @brief Write the result of `state` into row `row` of `result`
+	 *
+	 * @param state Final state of the group
+	 * @param result Vector of type ResultType()
+	 * @param row Row to write
+	 */
+	void Finalize(const AggregateState &state, Vector &result, idx_t row) const;
+
+  private:
+	AggregateSpec spec_;
+	LogicalType input_type_;
+	LogicalType result_type_;
+};
+
+} // namespace electricdb
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/execution/operators/aggregate/aggregate.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace electricdb {
+
+struct GroupedAggregateTable;
+
+/**
+ * @brief GROUP BY over unordered input, a pipeline breaker.
+ *
+ * Every worker aggregates into its own open-addressing table of (group key -> aggregate states),
+ * Combine() merges the local tables into the global one. The finalized groups are the source of
+ * the next pipeline, one output row per group: the group columns followed by the aggregates.
+ * Without group columns the output is a single row, also for empty input.
+ *
+ * A single group column may arrive as a dictionary vector. Then the rows are grouped by code:
+ * each distinct code of a chunk is hashed and looked up once, every row takes the group of its
+ * code from an array, however wide or costly to compare the values are.
+ *
+ * Without group columns any input column may arrive as a run vector, e.g. straight from an RLE
+ * chunk. Each aggregate then folds a run at once (see AggregateFunction::UpdateRuns()) instead
+ * of its rows.
+ */
+class PhysicalHashAggregate final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalHashAggregate
+	 *
+	 * @param input_types Types of the input columns
+	 * @param group_columns Indices of the GROUP BY columns in the input
+	 * @param aggregates Aggregates to compute per group
+	 */
+	PhysicalHashAggregate(std::vector<LogicalType> input_types, std::vector<uint32_t> group_columns,
+						  std::vector<AggregateSpec> aggregates);
+	~PhysicalHashAggregate() override;
+
+	/** @brief Only a single group column, and only if no aggregate but COUNT reads its values */
+	bool AcceptsDictionary(idx_t column) const override;
+
+	/** @brief Every column, if there are no group columns */
+	bool AcceptsRuns(idx_t) const override { return group_columns_.empty(); }
+
+	bool IsSink() const override { return true; }
+
+	std::unique_ptr<LocalSinkState> InitLocalSink() const override;
+
+	void Sink(ExecutionContext &ctx, LocalSinkState &state,
+			  const std::vector<Vector> &chunk) override;
+
+	void Combine(LocalSinkState &state) override;
+
+	void Finalize(Scheduler &scheduler, const CancellationToken *token) override;
+
+	void Abort() override;
+
+	bool IsSource() const override { return true; }
+
+	/** @brief Number of groups, valid after Finalize() */
+	uint64_t SourceRowCount() const override;
+
+	void GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset, idx_t count,
+				 std::vector<Vector> &out) const override;
+
+  private:
+	/** @brief Fold the rows of `chunk` into the states of their groups */
+	void UpdateAggregates(GroupedAggregateTable &table, const std::vector<Vector> &chunk,
+						  const uint32_t *groups, idx_t count) const;
+
+	std::vector<LogicalType> input_types_;
+	std::vector<uint32_t> group_columns_;
+	std::vector<AggregateFunction> functions_;
+
+	std::mutex lock_;
+	std::unique_ptr<GroupedAggregateTable> table_;
+};
+
+} // namespace electricdb
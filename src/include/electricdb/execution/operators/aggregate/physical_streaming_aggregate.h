@@ -0,0 +1,84 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/execution/operators/aggregate/streaming_aggregate.h"
+#include "electricdb/util/arena.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief The part of the input of a PhysicalStreamingAggregate that one morsel holds
+ *
+ */
+struct StreamingAggregateRange {
+	/** @brief Source offset of the morsel */
+	uint64_t begin = 0;
+	/** @brief Holds the first group of the range, which may go on in the range before it */
+	StreamingAggregateState state;
+	/** @brief Groups completed after the first one, in input order. Only the last has room left. */
+	std::vector<std::vector<Vector>> chunks;
+};
+
+/**
+ * @brief GROUP BY over ordered input as a pipeline breaker: the sink of its input pipeline and
+ * the source of the next.
+ *
+ * Wraps a StreamingAggregateOperator. Morsels are aggregated in parallel, each into a range of its
+ * own. A range holds back its first group and keeps its last one open, either may belong to a
+ * group that spans morsels. Finalize() walks the ranges in input order and merges the groups at
+ * their boundaries. Each chunk's groups go through one scratch chunk per worker and are packed
+ * into chunks of the batch size, so the memory kept grows with the groups, not with the input.
+ * The groups can be read at any offset.
+ */
+class PhysicalStreamingAggregate final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalStreamingAggregate
+	 *
+	 * @param input_types Types of the input columns
+	 * @param group_columns Indices of the group columns in the input, which is ordered on them
+	 * @param aggregates Aggregates to compute per group
+	 */
+	PhysicalStreamingAggregate(std::vector<LogicalType> input_types,
+							   std::vector<uint32_t> group_columns,
+							   const std::vector<AggregateSpec> &aggregates);
+
+	bool IsSink() const override { return true; }
+
+	std::unique_ptr<LocalSinkState> InitLocalSink() const override;
+
+	void Sink(ExecutionContext &ctx, LocalSinkState &state,
+			  const std::vector<Vector> &chunk) override;
+
+	void Combine(LocalSinkState &state) override;
+
+	void Finalize(Scheduler &scheduler, const CancellationToken *token) override;
+
+	void Abort() override;
+
+	bool IsSource() const override { return true; }
+
+	uint64_t SourceRowCount() const override { return starts_.back(); }
+
+	void GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset, idx_t count,
+				 std::vector<Vector> &out) const override;
+
+  private:
+	StreamingAggregateOperator aggregate_;
+
+	std::mutex lock_;
+	/** @brief Ranges of the combined local states, until Finalize() */
+	std::vector<StreamingAggregateRange> ranges_;
+	/** @brief Arenas of the combined local states, they back `chunks_` */
+	std::vector<std::unique_ptr<Arena>> arenas_;
+	/** @brief Emitted groups, in input order */
+	std::vector<std::vector<Vector>> chunks_;
+	/** @brief First output row of every chunk, followed by the number of groups */
+	std::vector<uint64_t> starts_{0};
+};
+
+} // namespace electricdb
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "electricdb/execution/operators/aggregate/aggregate.h"
+#include "electricdb/execution/vector/vector.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief State of one input stream of a StreamingAggregateOperator: the group that is still open
+ * at the end of the last chunk
+ *
+ */
+struct StreamingAggregateState {
+	bool has_open_group = false;
+	/** @brief Raw key values of the open group, one fixed-width slot per group column */
+	std::vector<uint8_t> group_values;
+	std::vector<uint8_t> group_nulls;
+	std::vector<AggregateState> aggregates;
+	/** @brief Scratch: 1 where a row starts a new group */
+	std::vector<uint8_t> boundaries;
+
+	/**
+	 * @brief Keep the first group the stream completes instead of emitting it. Set for a range of
+	 * a larger input, whose first group may have started in the range before it, see Continue().
+	 */
+	bool hold_first_group = false;
+	bool has_first_group = false;
+	std::vector<uint8_t> first_values;
+	std::vector<uint8_t> first_nulls;
+	std::vector<AggregateState> first_aggregates;
+};
+
+/**
+ * @brief GROUP BY over input that is already ordered (or clustered) on the group columns.
+ *
+ * Group boundaries are found by comparing every key with its predecessor in a typed loop per
+ * group column. Each run of equal keys is folded into the aggregates with range updates and the
+ * group is emitted as soon as the next one starts. Only the open group is kept between chunks,
+ * so memory use does not depend on the number of groups.
+ *
+ * Output columns are the group columns followed by one column per aggregate.
+ */
+class StreamingAggregateOperator {
+  public:
+	/**
+	 * @brief Construct a new StreamingAggregateOperator
+	 *
+	 * @param types Types of the input columns
+	 * @param group_columns Indices of the group columns in the input
+	 * @param aggregates Aggregates to compute per group
+	 */
+	StreamingAggregateOperator(std::vector<LogicalType> types, std::vector<uint32_t> group_columns,
+							   const std::vector<AggregateSpec> &aggregates);
+
+	/** @brief Create the state for one ordered input stream */
+	StreamingAggregateState InitState() const;
+
+	/**
+	 * @brief Consume a chunk and emit every group that it completes
+	 *
+	 * @param state State of the input stream
+	 * @param chunk Input columns, ordered on the group columns
+	 * @param out Output columns with a capacity of at least the chunk size
+	 * @return idx_t Number of groups written to `out`
+	 */
+	idx_t Execute(StreamingAggregateState &state, const std::vector<Vector> &chunk,
+				  std::vector<Vector> &out) const;
+
+	/**
+	 * @brief Emit the group that is still open at the end of the input
+	 *
+	 * @return idx_t Number of groups written to `out` (0 or 1)
+	 */
+	idx_t Flush(StreamingAggregateState &state, std::vector<Vector> &out) const;
+
+	/**
+	 * @brief Continue the input of `state` with the range `next` consumed, which directly follows
+	 * it. Emits the groups completed at the boundary between the two: the open group of `state`
+	 * and the held first group of `next`, as one group if their keys are equal. The open group of
+	 * `next` becomes the open group of `state`, the groups `next` emitted come after these.
+	 *
+	 * @param state State of the input so far, must not hold its first group
+	 * @param next State of the following range, with hold_first_group set
+	 * @param out Output columns with a capacity of at least 2
+	 * @return idx_t Number of groups written to `out` (0 to 2)
+	 */
+	idx_t Continue(StreamingAggregateState &state, StreamingAggregateState &next,
+				   std::vector<Vector> &out) const;
+
+	/** @brief Types of the output columns: group columns, then aggregates */
+	const std::vector<LogicalType> &OutputTypes() const noexcept { return output_types_; }
+
+  private:
+	/** @brief Start a new open group from row `row` of `chunk` */
+	void OpenGroup(StreamingAggregateState &state, const std::vector<Vector> &chunk,
+				   idx_t row) const;
+
+	/** @brief Write the open group into row `row` of `out` */
+	void EmitGroup(const StreamingAggregateState &state, std::vector<Vector> &out, idx_t row) const;
+
+	/** @brief Emit the open group at row `emitted` of `out`, or hold it if it is the first one */
+	void CloseGroup(StreamingAggregateState &state, std::vector<Vector> &out,
+					idx_t &emitted) const;
+
+	/** @brief Check if the keys stored at `a` and `b` are equal, null equal to null */
+	bool StoredKeysEqual(const uint8_t *a_values, const uint8_t *a_nulls, const uint8_t *b_values,
+						 const uint8_t *b_nulls) const;
+
+	/** @brief Check if row 0 of `chunk` belongs to the open group */
+	bool ContinuesOpenGroup(const StreamingAggregateState &state,
+							const std::vector<Vector> &chunk) const;
+
+	/** @brief Mark rows whose group key differs from the previous row */
+	void MarkBoundaries(StreamingAggregateState &state, const std::vector<Vector> &chunk,
+						idx_t count) const;
+
+	std::vector<LogicalType> types_;
+	std::vector<uint32_t> group_columns_;
+	/** @brief Offset of each group column inside StreamingAggregateState::group_values */
+	std::vector<uint32_t> group_offsets_;
+	uint32_t group_width_ = 0;
+	std::vector<AggregateFunction> aggregates_;
+	std::vector<LogicalType> output_types_;
+};
+
+} // namespace electricdb
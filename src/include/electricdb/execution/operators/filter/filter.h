@@ -0,0 +1,50 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/execution/expressions/expression.h"
+
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Keeps the rows for which a BOOL predicate is true (NULL counts as false).
+ *
+ * The predicate is evaluated for the whole chunk, the qualifying rows are collected into a
+ * selection vector without branches and then gathered column by column.
+ *
+ * Dictionary vectors stay dictionaries: their codes are gathered, not their values. A predicate
+ * over a single dictionary column is evaluated once per dictionary entry, the rows then qualify
+ * by their code.
+ *
+ * Run vectors of the single column the predicate reads stay runs too: the predicate is evaluated
+ * once per run and the qualifying runs are passed on whole.
+ */
+class PhysicalFilter final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalFilter
+	 *
+	 * @param types Types of the input (and output) columns
+	 * @param predicate Expression of type BOOL over the input columns. Not owned.
+	 */
+	PhysicalFilter(std::vector<LogicalType> types, Expression *predicate);
+
+	bool AcceptsDictionary(idx_t) const override { return true; }
+
+	bool AcceptsRuns(idx_t column) const override {
+		return columns_.size() == 1 && columns_[0] == column;
+	}
+
+	std::unique_ptr<OperatorState> InitOperatorState() const override;
+
+	OperatorResult Execute(ExecutionContext &ctx, const std::vector<Vector> &input,
+						   std::vector<Vector> &output, OperatorState &state) const override;
+
+  private:
+	Expression *predicate_;
+	/** @brief Input columns the predicate reads, without duplicates */
+	std::vector<uint32_t> columns_;
+};
+
+} // namespace electricdb
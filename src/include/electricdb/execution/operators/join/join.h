@@ -0,0 +1,75 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Inner equi-join: sink of the build side (children[1]), streaming on the probe side.
+ *
+ * Build rows are stored row-wise (key, then a null byte and value per build column) and chained
+ * per hash bucket in Finalize(). Probing emits the probe columns followed by the build columns.
+ * A probe chunk whose matches do not fit into one output chunk is resumed on the next Execute().
+ * Rows with a null key never match.
+ */
+class PhysicalHashJoin final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalHashJoin
+	 *
+	 * @param probe_types Types of the probe side columns
+	 * @param build_types Types of the build side columns
+	 * @param probe_keys Indices of the join keys in the probe side
+	 * @param build_keys Indices of the join keys in the build side, of the same types
+	 */
+	PhysicalHashJoin(std::vector<LogicalType> probe_types, std::vector<LogicalType> build_types,
+					 std::vector<uint32_t> probe_keys, std::vector<uint32_t> build_keys);
+
+	bool IsSink() const override { return true; }
+
+	std::unique_ptr<LocalSinkState> InitLocalSink() const override;
+
+	void Sink(ExecutionContext &ctx, LocalSinkState &state,
+			  const std::vector<Vector> &chunk) override;
+
+	void Combine(LocalSinkState &state) override;
+
+	void Finalize(Scheduler &scheduler, const CancellationToken *token) override;
+
+	void Abort() override;
+
+	std::unique_ptr<OperatorState> InitOperatorState() const override;
+
+	OperatorResult Execute(ExecutionContext &ctx, const std::vector<Vector> &input,
+						   std::vector<Vector> &output, OperatorState &state) const override;
+
+	/** @brief Number of build rows with a non-null key, valid after Finalize() */
+	uint64_t BuildCount() const noexcept { return hashes_.size(); }
+
+  private:
+	static constexpr uint32_t EMPTY = UINT32_MAX;
+
+	/** @brief Write the keys of every row of `chunk` into `keys`, set `valid` for non-null keys */
+	void EncodeKeys(const std::vector<Vector> &chunk, const std::vector<uint32_t> &key_columns,
+					uint8_t *keys, uint8_t *valid) const;
+
+	std::vector<LogicalType> probe_types_;
+	std::vector<LogicalType> build_types_;
+	std::vector<uint32_t> probe_keys_;
+	std::vector<uint32_t> build_keys_;
+	size_t key_width_ = 0;
+	size_t row_width_ = 0;
+
+	std::mutex lock_;
+	std::vector<uint8_t> rows_;
+	std::vector<uint64_t> hashes_;
+	/** @brief First build row per bucket and next row in the same bucket, EMPTY ends a chain */
+	std::vector<uint32_t> heads_;
+	std::vector<uint32_t> next_;
+};
+
+} // namespace electricdb
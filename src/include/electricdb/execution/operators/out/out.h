@@ -0,0 +1,62 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/util/arena.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Final sink of a query, materializes every chunk that reaches it.
+ *
+ * Chunks are ordered by the source offset they were produced from, so the output of an ordered
+ * source (e.g. a sort) keeps its order even though its morsels ran on different workers.
+ */
+class PhysicalResultCollector final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalResultCollector
+	 *
+	 * @param types Types of the collected columns
+	 */
+	explicit PhysicalResultCollector(std::vector<LogicalType> types);
+
+	bool IsSink() const override { return true; }
+
+	std::unique_ptr<LocalSinkState> InitLocalSink() const override;
+
+	void Sink(ExecutionContext &ctx, LocalSinkState &state,
+			  const std::vector<Vector> &chunk) override;
+
+	void Combine(LocalSinkState &state) override;
+
+	void Finalize(Scheduler &scheduler, const CancellationToken *token) override;
+
+	void Abort() override;
+
+	/** @brief Number of collected rows, valid after Finalize() */
+	uint64_t Count() const noexcept { return count_; }
+
+	size_t ChunkCount() const noexcept { return batches_.size(); }
+
+	/** @brief Collected chunk `i`, in output order */
+	const std::vector<Vector> &Chunk(size_t i) const { return batches_[i].chunk; }
+
+  private:
+	/** @brief A copy of a sunk chunk and the source offset it came from */
+	struct Batch {
+		uint64_t batch_index;
+		std::vector<Vector> chunk;
+	};
+
+	std::mutex lock_;
+	/** @brief Arenas of the combined local states, they back the collected chunks */
+	std::vector<std::unique_ptr<Arena>> arenas_;
+	std::vector<Batch> batches_;
+	uint64_t count_ = 0;
+};
+
+} // namespace electricdb
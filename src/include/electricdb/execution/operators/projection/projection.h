@@ -0,0 +1,42 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/execution/expressions/expression.h"
+
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Computes one output column per expression over the input chunk.
+ *
+ * Column references are passed through without copying, computed columns are written into
+ * buffers owned by the operator state of the worker.
+ *
+ * An expression over a single dictionary column is evaluated once per dictionary entry and its
+ * result is a dictionary vector with the codes of the input, so dictionaries survive both
+ * column references and computed columns.
+ */
+class PhysicalProjection final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalProjection
+	 *
+	 * @param expressions One expression per output column. Not owned.
+	 */
+	explicit PhysicalProjection(std::vector<Expression *> expressions);
+
+	bool AcceptsDictionary(idx_t) const override { return true; }
+
+	std::unique_ptr<OperatorState> InitOperatorState() const override;
+
+	OperatorResult Execute(ExecutionContext &ctx, const std::vector<Vector> &input,
+						   std::vector<Vector> &output, OperatorState &state) const override;
+
+  private:
+	std::vector<Expression *> expressions_;
+	/** @brief Input columns every expression reads */
+	std::vector<std::vector<uint32_t>> columns_;
+};
+
+} // namespace electricdb
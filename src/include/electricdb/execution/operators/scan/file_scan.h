@@ -0,0 +1,209 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/io/mmap_file.h"
+#include "electricdb/storage/buffer/buffer_manager.h"
+#include "electricdb/storage/format/column_file.h"
+
+#include <memory>
+#include <vector>
+
+namespace electricdb {
+
+class PhysicalTopN;
+
+/** @brief How PhysicalFileScan gets column chunks into vectors */
+enum class FileScanMode : uint8_t {
+	/** @brief Read and verify the needed chunks of a row group, then copy batches out of them */
+	READ,
+	/**
+	 * @brief Map the file and point the output vectors at the mapped chunks, copying nothing.
+	 * Checksums are not verified, that would read every byte a second time. Encoded chunks
+	 * cannot be used in place, they are verified and decoded into per-worker buffers.
+	 */
+	MMAP,
+	/**
+	 * @brief As READ, but fetch with direct I/O into aligned buffers where the file system
+	 * supports it. Meant for scans too large to be worth caching: they neither evict the cached
+	 * working set nor pay for copying every byte through the page cache.
+	 */
+	DIRECT,
+	/** @brief DIRECT if the scanned chunks add up to the direct threshold, otherwise MMAP */
+	AUTO
+};
+
+/** @brief Bytes from which an AUTO scan reads with direct I/O */
+constexpr uint64_t DEFAULT_DIRECT_SCAN_BYTES = uint64_t{256} << 20;
+
+/**
+ * @brief Source over some columns of a column file.
+ *
+ * Only the chunks of the requested columns are touched. Pipelines cut morsels at the row groups
+ * (see SourceMorselSize()), so a worker loads (READ, DIRECT) or prefetches (MMAP) each row group
+ * once and no batch spans two of them. Other row ranges work too: a batch that spans row groups
+ * is copied together from both.
+ *
+ * Filters are pushed into the scan: a worker first selects the qualifying rows of a row group
+ * (see ColumnFileReader::SelectRows()) and loads the row group only if some row qualifies, then
+ * its batches carry just the qualifying rows of their range. A Top-N above the scan is checked
+ * the same way: row groups whose zone map cannot beat its current boundary are never loaded.
+ */
+class PhysicalFileScan final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalFileScan
+	 *
+	 * @param reader Open column file. Not owned, must outlive the scan.
+	 * @param column_ids Schema positions of the columns to produce, in output order
+	 * @param mode How chunks get into the output vectors
+	 * @param direct_threshold Scanned bytes from which AUTO picks DIRECT
+	 */
+	PhysicalFileScan(const ColumnFileReader &reader, std::vector<idx_t> column_ids,
+					 FileScanMode mode = FileScanMode::READ,
+					 uint64_t direct_threshold = DEFAULT_DIRECT_SCAN_BYTES);
+
+	/** @brief Mode the scan runs in, never AUTO */
+	FileScanMode Mode() const noexcept { return mode_; }
+
+	/** @brief Bytes of the chunks the scan reads */
+	uint64_t ScanBytes() const noexcept { return scan_bytes_; }
+
+	/**
+	 * @brief Read row groups ahead through `io` instead of one at a time, READ and DIRECT only
+	 *
+	 * @param io Backend for the reads. Not owned, must outlive the scan.
+	 * @param depth Row groups to read ahead
+	 * @param max_bytes Bound of the bytes the scan fetches ahead
+	 */
+	void EnablePrefetch(AsyncReader &io, uint32_t depth = DEFAULT_PREFETCH_DEPTH,
+						uint64_t max_bytes = DEFAULT_PREFETCH_BYTES);
+
+	/**
+	 * @brief Take decoded chunks from `buffers` instead of reading them per worker, READ and
+	 * DIRECT without prefetching only. A worker keeps the chunks of its current row group pinned
+	 * and its batches view them, so the budget must hold a row group per worker; throws if it
+	 * does not. Other scans may still take the room, a worker then waits for them until its query
+	 * is cancelled.
+	 *
+	 * @param buffers Cache shared with other scans. Not owned, must outlive the scan.
+	 * @param workers Workers that run the scan, see Scheduler::WorkerCount()
+	 */
+	void EnableBufferManager(BufferManager &buffers, uint32_t workers = 1);
+
+	/**
+	 * @brief Produce only rows that satisfy `predicate`, on top of the filters added before.
+	 * Not combinable with prefetching, which would read ahead the row groups filters skip.
+	 *
+	 * @param column Position of the filtered column in the scan's output
+	 * @param predicate Predicate that Fits() the column's type
+	 */
+	void AddFilter(idx_t column, ColumnPredicate predicate);
+
+	/**
+	 * @brief Skip row groups that cannot enter the result of `top_n`, judged by the zone map of
+	 * `column` against the boundary `top_n` publishes while it sinks. Not combinable with
+	 * prefetching, like filters.
+	 *
+	 * @param column Position in the scan's output of the first sort key of `top_n`
+	 * @param top_n Top-N the scan feeds. Not owned, must outlive the scan.
+	 */
+	void SetTopN(idx_t column, const PhysicalTopN &top_n);
+
+	/**
+	 * @brief Produce dictionary chunks as dictionary vectors (see Vector::ReferenceDictionary())
+	 * instead of expanding them, READ and DIRECT without prefetching or a buffer manager only.
+	 * A batch within one row group refers to the entries and codes of the worker's chunk; a batch
+	 * that spans row groups, or that a filter gathers, is expanded.
+	 */
+	void EnableDictionaryVectors();
+
+	/**
+	 * @brief Produce RLE chunks as run vectors (see Vector::ReferenceRuns()) instead of expanding
+	 * them, READ and DIRECT without prefetching or a buffer manager only. A batch within one row
+	 * group carries the runs it overlaps, trimmed to its rows; a batch that spans row groups, or
+	 * a scan with filters, is expanded.
+	 */
+	void EnableRunVectors();
+
+	bool IsSource() const override { return true; }
+
+	uint64_t SourceRowCount() const override { return row_group_starts_.back(); }
+
+	/** @brief Rows of the first row group, only the last one of a file may be smaller */
+	uint64_t SourceMorselSize() const override {
+		return row_group_starts_.size() > 1 ? row_group_starts_[1] : 0;
+	}
+
+	std::unique_ptr<LocalSourceState> InitLocalSource() const override;
+
+	void GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset, idx_t count,
+				 std::vector<Vector> &out) const override;
+
+  private:
+	struct ScanFilter {
+		/** @brief Position in `column_ids_` */
+		idx_t column;
+		ColumnPredicate predicate;
+	};
+
+	/** @brief Whether batches carry only the selected rows of their range */
+	bool Filtered() const noexcept { return !filters_.empty() || top_n_; }
+
+	/** @brief Row group that holds `row` */
+	idx_t RowGroupOf(uint64_t row) const;
+
+	void ReadData(LocalSourceState &state, uint64_t offset, idx_t count,
+				  std::vector<Vector> &out) const;
+
+	/**
+	 * @brief Make a whole row group available to the worker: decoded into its columns (READ,
+	 * DIRECT) or viewed by its views (buffer manager, MMAP)
+	 */
+	void LoadRowGroup(LocalSourceState &state, idx_t row_group) const;
+
+	/** @brief Pin the chunks of a row group and point the worker's views at them */
+	void PinRowGroup(LocalSourceState &state, idx_t row_group) const;
+
+	/** @brief Values of the `c`-th scanned chunk of a mapped row group, decoded if encoded */
+	const uint8_t *MappedValues(LocalSourceState &state, idx_t row_group, size_t c) const;
+
+	/**
+	 * @brief Rows of a row group that pass every filter, into the worker's selection. None if the
+	 * Top-N rules the row group out.
+	 */
+	idx_t SelectRowGroup(LocalSourceState &state, idx_t row_group) const;
+
+	void FilterData(LocalSourceState &state, uint64_t offset, idx_t count,
+					std::vector<Vector> &out) const;
+
+	void MapData(LocalSourceState &state, uint64_t offset, idx_t count,
+				 std::vector<Vector> &out) const;
+
+	const ColumnFileReader &reader_;
+	std::vector<idx_t> column_ids_;
+	FileScanMode mode_;
+	/** @brief First row of every row group, followed by the row count of the file */
+	std::vector<uint64_t> row_group_starts_;
+	/** @brief Rows of the largest row group */
+	uint32_t max_row_group_ = 0;
+	uint64_t scan_bytes_ = 0;
+	/** @brief Largest aligned fetch of one row group, DIRECT only */
+	uint64_t max_fetch_bytes_ = 0;
+	/** @brief The whole file, MMAP only */
+	MappedFile mapping_;
+	/** @brief Shared by the workers, null unless prefetching */
+	std::unique_ptr<ChunkPrefetcher> prefetcher_;
+	/** @brief Not owned, null unless the scan goes through a buffer manager */
+	BufferManager *buffers_ = nullptr;
+	/** @brief Id of the file in `buffers_` */
+	uint32_t file_id_ = 0;
+	std::vector<ScanFilter> filters_;
+	/** @brief Not owned, null unless the scan feeds a Top-N */
+	const PhysicalTopN *top_n_ = nullptr;
+	/** @brief Position in `column_ids_` of the first sort key of `top_n_` */
+	idx_t top_n_column_ = 0;
+	bool dictionary_vectors_ = false;
+	bool run_vectors_ = false;
+};
+
+} // namespace electricdb
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Source over columns that are already in memory, e.g. a materialized intermediate result.
+ *
+ * Any row range can be read independently, so the scan is split into morsels freely.
+ */
+class PhysicalColumnScan final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalColumnScan
+	 *
+	 * @param columns Columns to scan, all of the same size. Not owned, must outlive the scan.
+	 */
+	explicit PhysicalColumnScan(const std::vector<Vector> &columns);
+
+	bool IsSource() const override { return true; }
+
+	uint64_t SourceRowCount() const override;
+
+	void GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset, idx_t count,
+				 std::vector<Vector> &out) const override;
+
+  private:
+	const std::vector<Vector> &columns_;
+};
+
+} // namespace electricdb
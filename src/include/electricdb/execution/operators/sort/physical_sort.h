@@ -0,0 +1,58 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/execution/operators/sort/sort.h"
+
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief ORDER BY as a pipeline breaker: the sink of its input pipeline and the source of the next.
+ *
+ * Wraps a SortOperator. In-memory output can be read at any offset, so the next pipeline is split
+ * into morsels and an order-preserving sink restores the order from the batch indices. Spilled
+ * output is streamed from the run merge as a single morsel.
+ */
+class PhysicalSort final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalSort
+	 *
+	 * @param types Types of the input (and output) columns
+	 * @param keys ORDER BY terms, most significant first
+	 * @param memory_limit Bytes of buffered input after which runs are spilled, 0 for no limit
+	 * @param spill_manager Provides the files runs are spilled to, required for a memory limit
+	 */
+	PhysicalSort(std::vector<LogicalType> types, std::vector<SortKey> keys,
+				 uint64_t memory_limit = 0, SpillManager *spill_manager = nullptr);
+
+	bool IsSink() const override { return true; }
+
+	std::unique_ptr<LocalSinkState> InitLocalSink() const override;
+
+	void Sink(ExecutionContext &ctx, LocalSinkState &state,
+			  const std::vector<Vector> &chunk) override;
+
+	void Combine(LocalSinkState &state) override;
+
+	void Finalize(Scheduler &scheduler, const CancellationToken *token) override;
+
+	void Abort() override { sort_.Clear(); }
+
+	bool IsSource() const override { return true; }
+
+	uint64_t SourceRowCount() const override { return sort_.Count(); }
+
+	bool ParallelSource() const override { return sort_.SpilledRunCount() == 0; }
+
+	std::unique_ptr<LocalSourceState> InitLocalSource() const override;
+
+	void GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset, idx_t count,
+				 std::vector<Vector> &out) const override;
+
+  private:
+	SortOperator sort_;
+};
+
+} // namespace electricdb
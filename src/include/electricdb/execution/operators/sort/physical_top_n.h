@@ -0,0 +1,63 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/execution/operators/sort/top_n.h"
+
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief ORDER BY ... LIMIT as a pipeline breaker: the sink of its input pipeline and the source
+ * of the next.
+ *
+ * Wraps a TopNOperator. While the input pipeline runs, the boundary the workers publish lets a
+ * file scan below skip row groups through CanSkipZone() (see PhysicalFileScan::SetTopN()). The
+ * result can be read at any offset.
+ */
+class PhysicalTopN final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalTopN
+	 *
+	 * @param types Types of the input (and output) columns
+	 * @param keys ORDER BY terms, most significant first
+	 * @param limit Maximum number of rows to emit
+	 * @param offset Number of leading rows to skip
+	 */
+	PhysicalTopN(std::vector<LogicalType> types, std::vector<SortKey> keys, uint64_t limit,
+				 uint64_t offset = 0);
+
+	/** @brief Input column of the first sort key, the one CanSkipZone() takes zone maps of */
+	idx_t BoundaryColumn() const noexcept { return top_n_.Keys()[0].column_idx; }
+
+	/** @brief Check whether rows summarized by `zone` cannot enter the result. Thread safe. */
+	bool CanSkipZone(const ZoneMap &zone) const { return top_n_.CanSkipZone(zone); }
+
+	bool IsSink() const override { return true; }
+
+	std::unique_ptr<LocalSinkState> InitLocalSink() const override;
+
+	void Sink(ExecutionContext &ctx, LocalSinkState &state,
+			  const std::vector<Vector> &chunk) override;
+
+	void Combine(LocalSinkState &state) override;
+
+	void Finalize(Scheduler &scheduler, const CancellationToken *token) override;
+
+	void Abort() override { top_n_.Clear(); }
+
+	bool IsSource() const override { return true; }
+
+	uint64_t SourceRowCount() const override { return top_n_.Count(); }
+
+	std::unique_ptr<LocalSourceState> InitLocalSource() const override;
+
+	void GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset, idx_t count,
+				 std::vector<Vector> &out) const override;
+
+  private:
+	TopNOperator top_n_;
+};
+
+} // namespace electricdb
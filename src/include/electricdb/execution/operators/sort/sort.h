@@ -0,0 +1,223 @@
+#pragma once
+
+#include "electricdb/execution/engine/scheduler.h"
+#include "electricdb/execution/memory/spill_manager.h"
+#include "electricdb/execution/operators/sort/sort_key.h"
+#include "electricdb/execution/vector/vector.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Rows sunk by one thread, stored column by column, plus their normalized sort keys
+ *
+ */
+struct SortRun {
+	/** @brief Raw fixed-width values, one byte array per column */
+	std::vector<std::vector<uint8_t>> columns;
+	/** @brief One byte per row and column, non-zero if the value is NULL */
+	std::vector<std::vector<uint8_t>> nulls;
+	/** @brief Normalized key entries, sorted in Finalize() or before the run is spilled */
+	std::vector<uint8_t> keys;
+	uint64_t count = 0;
+};
+
+/**
+ * @brief Thread-local sink state of a SortOperator
+ *
+ */
+struct SortLocalState {
+	SortRun run;
+	/** @brief Bytes buffered in `run`, counted against the operator's memory limit */
+	uint64_t buffered_bytes = 0;
+};
+
+/**
+ * @brief A sorted run written to disk as fixed-width records: normalized key, then a null byte
+ * and the raw value of every column
+ *
+ */
+struct SpilledRun {
+	std::unique_ptr<SpillFile> file;
+	uint64_t count = 0;
+};
+
+class SpilledRunMerger;
+
+/**
+ * @brief Read position of a consumer of the sorted output
+ *
+ */
+struct SortScanState {
+	SortScanState();
+	~SortScanState();
+
+	/** @brief Disable copy constructor */
+	SortScanState(const SortScanState &) = delete;
+
+	/** @brief Disable copy assignment */
+	SortScanState &operator=(const SortScanState &) = delete;
+
+	uint64_t position = 0;
+	/** @brief Merge cursors over the spilled runs, created by the first Scan() */
+	std::unique_ptr<SpilledRunMerger> merger;
+};
+
+/**
+ * @brief ORDER BY over any number of columns.
+ *
+ * Each worker sinks chunks into its own SortLocalState, which encodes the key columns into
+ * normalized keys. Combine() hands the worker's run over, and Finalize() radix sorts all runs in
+ * parallel and merges them with a parallel k-way merge, both as tasks on the Scheduler. Scan()
+ * then gathers the payload columns in sorted order.
+ *
+ * With a memory limit and a SpillManager, a worker reserves the memory of every chunk before it
+ * buffers it. If the chunk does not fit, the worker spills the largest combined run, else sorts
+ * its own run and writes it to a temporary file; if it holds no rows either, the chunk is written
+ * as a run of its own. The buffered rows, and the scratch memory to sort them, so never exceed
+ * the limit. If anything was spilled, Finalize() spills the remaining in-memory runs
+ * as well and merges groups of MAX_MERGE_FAN_IN runs into longer runs until at most that many
+ * are left. Scan() then streams the output from a k-way merge over the run files, so the first
+ * batches are available long before the merge completes. Merges read ahead through one
+ * AsyncReader each.
+ */
+class SortOperator {
+  public:
+	/** @brief Spilled runs read by one merge at most, each holds two blocks of 256 KiB */
+	static constexpr size_t MAX_MERGE_FAN_IN = 32;
+
+	/**
+	 * @brief Construct a new SortOperator
+	 *
+	 * @param types Types of the input (and output) columns
+	 * @param keys ORDER BY terms, most significant first
+	 * @param memory_limit Bytes of buffered input after which runs are spilled, 0 for no limit
+	 * @param spill_manager Provides the files runs are spilled to, required for a memory limit
+	 */
+	SortOperator(std::vector<LogicalType> types, std::vector<SortKey> keys,
+				 uint64_t memory_limit = 0, SpillManager *spill_manager = nullptr);
+
+	/** @brief Create the state a worker sinks into */
+	std::unique_ptr<SortLocalState> InitLocal() const;
+
+	/**
+	 * @brief Append a chunk to the local state of a worker
+	 *
+	 * @param local Local state of the calling worker
+	 * @param chunk Input columns, all of the same size
+	 */
+	void Sink(SortLocalState &local, const std::vector<Vector> &chunk);
+
+	/**
+	 * @brief Hand the local run of a worker over to the operator. Thread safe.
+	 *
+	 * @param local Local state of the calling worker
+	 */
+	void Combine(SortLocalState &local);
+
+	/**
+	 * @brief Sort all combined runs and merge them into the final order
+	 *
+	 * @param scheduler Scheduler the sorts and the merge run on, must not be called from one of
+	 * its workers
+	 * @param token Cancels the sorts and the merge, which then throw QueryCancelled. May be null.
+	 */
+	void Finalize(Scheduler &scheduler, const CancellationToken *token = nullptr);
+
+	/**
+	 * @brief Emit the next rows of the sorted output
+	 *
+	 * @param state Read position, advanced by the number of rows emitted
+	 * @param out One vector per column; filled up to the capacity of out[0]
+	 * @param max_count Emit at most this many rows, even if out[0] has room for more
+	 * @return idx_t Number of rows emitted, 0 once the output is exhausted
+	 */
+	idx_t Scan(SortScanState &state, std::vector<Vector> &out,
+			   idx_t max_count = std::numeric_limits<idx_t>::max()) const;
+
+	/** @brief Drop all buffered runs, spill files and the sorted order. Not thread safe. */
+	void Clear();
+
+	/** @brief Number of rows in the sorted output, valid after Finalize() */
+	uint64_t Count() const noexcept { return count_; }
+
+	/** @brief Most bytes buffered at once under a memory limit, sort scratch included */
+	uint64_t PeakBufferedBytes() const noexcept {
+		return peak_buffered_bytes_.load(std::memory_order_relaxed);
+	}
+
+	/** @brief Number of runs written to disk */
+	size_t SpilledRunCount() const noexcept { return spilled_runs_.size(); }
+
+	const std::vector<LogicalType> &Types() const noexcept { return types_; }
+
+	const SortKeyEncoder &Encoder() const noexcept { return encoder_; }
+
+  private:
+	friend class SpilledRunMerger;
+
+	/**
+	 * @brief Merge the entries of runs_[r] in [begin[r], end[r]) into order_ from `out` on. Throws
+	 * QueryCancelled once `token` (may be null) is cancelled.
+	 */
+	void MergePartition(const std::vector<uint64_t> &begin, const std::vector<uint64_t> &end,
+						uint64_t out, const CancellationToken *token);
+
+	/** @brief Write a sorted run to a new spill file */
+	void Spill(const SortRun &run);
+
+	/** @brief Sort the run of a worker, spill it and release its memory */
+	void SpillLocal(SortLocalState &local);
+
+	/** @brief Add `bytes` to the buffered bytes if they stay within the memory limit */
+	bool Reserve(uint64_t bytes);
+
+	/**
+	 * @brief Sort, spill and release the largest run handed over by Combine()
+	 *
+	 * @return false if there is none
+	 */
+	bool SpillLargestRun();
+
+	/** @brief Pointers to spilled_runs_[begin, end) */
+	std::vector<const SpilledRun *> SpilledRunPointers(size_t begin, size_t end) const;
+
+	/** @brief Merge spilled_runs_[begin, end) into one new spilled run, `token` may be null */
+	SpilledRun MergeRuns(size_t begin, size_t end, const CancellationToken *token) const;
+
+	/** @brief Radix sort the key entries of a run, `token` may be null */
+	void SortRunKeys(SortRun &run, const CancellationToken *token = nullptr) const;
+
+	/** @brief Bytes buffered per row: key entry and its sort scratch, values and null flags */
+	uint64_t RowBytes() const noexcept;
+
+	std::vector<LogicalType> types_;
+	SortKeyEncoder encoder_;
+
+	uint64_t memory_limit_;
+	SpillManager *spill_manager_;
+	/** @brief Bytes currently buffered in local states and in-memory runs */
+	std::atomic<uint64_t> buffered_bytes_{0};
+	/** @brief Most bytes ever buffered at once */
+	std::atomic<uint64_t> peak_buffered_bytes_{0};
+
+	/** @brief Size of a spilled record and the offset of each column inside it */
+	uint32_t record_width_;
+	std::vector<uint32_t> record_offsets_;
+
+	std::mutex lock_;
+	std::vector<std::unique_ptr<SortRun>> runs_;
+	std::vector<SpilledRun> spilled_runs_;
+	uint64_t count_ = 0;
+
+	/** @brief Row references in sorted order: (run index << 32) | row within run */
+	std::vector<uint64_t> order_;
+};
+
+} // namespace electricdb
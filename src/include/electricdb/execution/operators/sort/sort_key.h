@@ -0,0 +1,119 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/vector.h"
+#include "electricdb/runtime/cancellation.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace electricdb {
+
+enum class OrderType : uint8_t { ASCENDING, DESCENDING };
+
+enum class NullOrder : uint8_t { NULLS_FIRST, NULLS_LAST };
+
+/**
+ * @brief A single ORDER BY term
+ *
+ */
+struct SortKey {
+	/** @brief Index of the column in the input chunk */
+	uint32_t column_idx;
+	OrderType order = OrderType::ASCENDING;
+	NullOrder null_order = NullOrder::NULLS_LAST;
+};
+
+/**
+ * @brief Encodes the ORDER BY columns of a row into a memcmp-comparable byte string.
+ *
+ * Every key column contributes one null byte followed by its value in big-endian order with the
+ * sign bit flipped (and every bit inverted for DESC). Comparing two entries with memcmp therefore
+ * gives the same result as comparing the rows column by column. Each entry is followed by an 8 byte
+ * row reference that travels with the key but is never compared.
+ */
+class SortKeyEncoder {
+  public:
+	/**
+	 * @brief Construct a new SortKeyEncoder
+	 *
+	 * @param keys ORDER BY terms, most significant first
+	 * @param types Types of all columns in the input chunk
+	 */
+	SortKeyEncoder(std::vector<SortKey> keys, const std::vector<LogicalType> &types);
+
+	/** @brief Number of bytes compared per entry */
+	uint32_t KeyWidth() const noexcept { return key_width_; }
+
+	/** @brief Number of bytes per entry (key + row reference) */
+	uint32_t EntryWidth() const noexcept { return key_width_ + sizeof(uint64_t); }
+
+	const std::vector<SortKey> &Keys() const noexcept { return keys_; }
+
+	/**
+	 * @brief Encode `count` rows of `chunk` into consecutive entries starting at `dst`
+	 *
+	 * @param chunk Input columns
+	 * @param count Number of rows to encode
+	 * @param dst Destination, must hold count * EntryWidth() bytes
+	 * @param first_ref Row reference stored with the first row, incremented for each following row
+	 */
+	void Encode(const std::vector<Vector> &chunk, idx_t count, uint8_t *dst,
+				uint64_t first_ref) const;
+
+	/**
+	 * @brief Encode a single value as key column `key_idx` would encode it
+	 *
+	 * @param key_idx Index into Keys()
+	 * @param value Value to encode, may be NULL
+	 * @param dst Destination, must hold ColumnWidth(key_idx) bytes
+	 */
+	void EncodeValue(size_t key_idx, const Value &value, uint8_t *dst) const;
+
+	/** @brief Byte offset of key column `key_idx` inside an entry */
+	uint32_t ColumnOffset(size_t key_idx) const noexcept { return offsets_[key_idx]; }
+
+	/** @brief Encoded width (null byte + value) of key column `key_idx` */
+	uint32_t ColumnWidth(size_t key_idx) const {
+		return 1 + GetTypeSize(key_types_[key_idx]);
+	}
+
+	/** @brief Read the row reference stored in an entry */
+	uint64_t GetRef(const uint8_t *entry) const noexcept {
+		uint64_t ref;
+		std::memcpy(&ref, entry + key_width_, sizeof(ref));
+		return ref;
+	}
+
+	/** @brief Compare the keys of two entries */
+	int Compare(const uint8_t *lhs, const uint8_t *rhs) const noexcept {
+		return std::memcmp(lhs, rhs, key_width_);
+	}
+
+  private:
+	std::vector<SortKey> keys_;
+	std::vector<LogicalType> key_types_;
+	/** @brief Byte offset of each key column inside an entry */
+	std::vector<uint32_t> offsets_;
+	uint32_t key_width_;
+};
+
+/**
+ * @brief Sort fixed-width entries by their first `key_width` bytes with an MSD radix sort.
+ *
+ * Buckets smaller than a small threshold finish with an insertion sort on memcmp. Bytes that are
+ * identical for every entry in a bucket (null bytes, high bytes of small integers) are skipped
+ * without a scatter pass.
+ *
+ * @param data Entries to sort
+ * @param tmp Scratch space of at least count * entry_width bytes
+ * @param count Number of entries
+ * @param entry_width Size of one entry in bytes
+ * @param key_width Number of leading bytes that make up the key
+ * @param token Checked before every scatter pass, which then throws QueryCancelled. May be null.
+ */
+void RadixSort(uint8_t *data, uint8_t *tmp, uint64_t count, uint32_t entry_width,
+			   uint32_t key_width, const CancellationToken *token = nullptr);
+
+} // namespace electricdb
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "electricdb/execution/operators/sort/sort_key.h"
+#include "electricdb/execution/vector/vector.h"
+#include "electricdb/storage/column/zone_map.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Thread-local sink state of a TopNOperator: a bounded max-heap of the best rows seen
+ *
+ */
+struct TopNLocalState {
+	/** @brief Fixed-width records: normalized key, then a null byte and value per column */
+	std::vector<uint8_t> records;
+	/** @brief Record slots ordered as a max-heap, the worst kept row is on top */
+	std::vector<uint32_t> heap;
+	/** @brief Scratch buffer for the key entries of the current chunk */
+	std::vector<uint8_t> keys;
+	/** @brief Number of chunks discarded without encoding a single key */
+	uint64_t chunks_skipped = 0;
+};
+
+/**
+ * @brief Read position of a consumer of the Top-N output
+ *
+ */
+struct TopNScanState {
+	uint64_t position = 0;
+};
+
+/**
+ * @brief ORDER BY ... LIMIT without a full sort.
+ *
+ * Every worker keeps the best `limit + offset` rows it has seen in a bounded heap. Once a heap is
+ * full its worst row is a boundary: no row that sorts after it can be part of the result. The
+ * best boundary of all workers is published so that every worker, and the scan through
+ * CanSkipZone(), can discard whole batches or chunks whose first sort key cannot beat it. The
+ * per-worker heaps are merged in Finalize().
+ */
+class TopNOperator {
+  public:
+	/**
+	 * @brief Construct a new TopNOperator
+	 *
+	 * @param types Types of the input (and output) columns
+	 * @param keys ORDER BY terms, most significant first
+	 * @param limit Maximum number of rows to emit
+	 * @param offset Number of leading rows to skip
+	 */
+	TopNOperator(std::vector<LogicalType> types, std::vector<SortKey> keys, uint64_t limit,
+				 uint64_t offset = 0);
+
+	/** @brief Create the state a worker sinks into */
+	std::unique_ptr<TopNLocalState> InitLocal() const;
+
+	/**
+	 * @brief Offer a chunk to the heap of a worker
+	 *
+	 * @param local Local state of the calling worker
+	 * @param chunk Input columns, all of the same size
+	 */
+	void Sink(TopNLocalState &local, const std::vector<Vector> &chunk);
+
+	/** @brief Hand the heap of a worker over to the operator. Thread safe. */
+	void Combine(TopNLocalState &local);
+
+	/** @brief Merge all worker heaps into the final result */
+	void Finalize();
+
+	/**
+	 * @brief Emit the next rows of the result
+	 *
+	 * @param state Read position, advanced by the number of rows emitted
+	 * @param out One vector per column; filled up to the capacity of out[0]
+	 * @param max_count Emit at most this many rows
+	 * @return idx_t Number of rows emitted, 0 once the output is exhausted
+	 */
+	idx_t Scan(TopNScanState &state, std::vector<Vector> &out,
+			   idx_t max_count = std::numeric_limits<idx_t>::max()) const;
+
+	/**
+	 * @brief Check whether a chunk can be skipped based on the zone map of the first sort key
+	 *
+	 * Thread safe. Returns true only if every row of the chunk sorts strictly after the current
+	 * global boundary.
+	 *
+	 * @param zone Zone map of the column referenced by the first sort key
+	 */
+	bool CanSkipZone(const ZoneMap &zone) const;
+
+	/** @brief Drop all kept rows and the published boundary. Not thread safe. */
+	void Clear();
+
+	/** @brief Number of rows in the result, valid after Finalize() */
+	uint64_t Count() const noexcept { return result_.size() / record_width_; }
+
+	const std::vector<LogicalType> &Types() const noexcept { return types_; }
+
+	/** @brief ORDER BY terms, most significant first */
+	const std::vector<SortKey> &Keys() const noexcept { return encoder_.Keys(); }
+
+  private:
+	/** @brief Check `zone` against the encoded first key column `boundary` */
+	bool CanSkip(const ZoneMap &zone, const uint8_t *boundary) const;
+
+	/** @brief Publish the boundary of a full local heap if it beats the global one */
+	void PublishBoundary(const uint8_t *key);
+
+	/** @brief Copy row `row` of `chunk` with key `entry` into record slot `slot` */
+	void WriteRecord(TopNLocalState &local, uint32_t slot, const uint8_t *entry,
+					 const std::vector<Vector> &chunk, idx_t row) const;
+
+	std::vector<LogicalType> types_;
+	SortKeyEncoder encoder_;
+	uint64_t limit_;
+	uint64_t offset_;
+	/** @brief Number of rows every heap keeps: limit + offset */
+	uint64_t heap_size_;
+
+	uint32_t record_width_;
+	std::vector<uint32_t> record_offsets_;
+
+	/** @brief Best boundary published by any worker, guarded by lock_ */
+	mutable std::mutex lock_;
+	std::vector<uint8_t> boundary_;
+	std::atomic<bool> has_boundary_{false};
+
+	/** @brief Records handed over by Combine(), the result after Finalize() */
+	std::vector<uint8_t> result_;
+};
+
+} // namespace electricdb
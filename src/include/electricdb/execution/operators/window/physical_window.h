@@ -0,0 +1,59 @@
+#pragma once
+
+#include "electricdb/execution/engine/operator.h"
+#include "electricdb/execution/operators/window/window.h"
+
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Window functions as a pipeline breaker: the sink of its input pipeline and the source of
+ * the next.
+ *
+ * Wraps a WindowOperator. Finalize() sorts the input and evaluates the partitions on the
+ * scheduler; the output, in window order, can be read at any offset.
+ */
+class PhysicalWindow final : public PhysicalOperator {
+  public:
+	/**
+	 * @brief Construct a new PhysicalWindow
+	 *
+	 * @param input_types Types of the input columns
+	 * @param partition_columns PARTITION BY columns
+	 * @param order_keys ORDER BY terms within a partition
+	 * @param functions Window functions to evaluate
+	 */
+	PhysicalWindow(std::vector<LogicalType> input_types, std::vector<uint32_t> partition_columns,
+				   std::vector<SortKey> order_keys, std::vector<WindowFunctionSpec> functions);
+
+	bool IsSink() const override { return true; }
+
+	std::unique_ptr<LocalSinkState> InitLocalSink() const override;
+
+	void Sink(ExecutionContext &ctx, LocalSinkState &state,
+			  const std::vector<Vector> &chunk) override;
+
+	void Combine(LocalSinkState &state) override;
+
+	void Finalize(Scheduler &scheduler, const CancellationToken *token) override;
+
+	void Abort() override { window_.Clear(); }
+
+	bool IsSource() const override { return true; }
+
+	uint64_t SourceRowCount() const override { return window_.Count(); }
+
+	std::unique_ptr<LocalSourceState> InitLocalSource() const override;
+
+	void GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset, idx_t count,
+				 std::vector<Vector> &out) const override;
+
+	/** @brief Number of partitions, valid after Finalize() */
+	size_t PartitionCount() const noexcept { return window_.PartitionCount(); }
+
+  private:
+	WindowOperator window_;
+};
+
+} // namespace electricdb
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "electricdb/execution/operators/aggregate/aggregate.h"
+#include "electricdb/execution/vector/vector.h"
+
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Segment tree over the aggregate states of a range of rows.
+ *
+ * Leaf i holds the state of row begin + i, every inner node the combined state of its children.
+ * Any frame [first, last) is then answered by combining at most 2 log n nodes, so moving windows
+ * cost O(log n) per row regardless of the frame size. Only valid for aggregates whose Combine() is
+ * commutative, which holds for every AggregateType.
+ */
+class WindowSegmentTree {
+  public:
+	/**
+	 * @brief Build the tree over rows [begin, end) of `input`
+	 *
+	 * @param function Aggregate to compute
+	 * @param input Input column of the aggregate (ignored for COUNT(*))
+	 * @param begin First row covered by the tree
+	 * @param end One past the last row covered by the tree
+	 */
+	WindowSegmentTree(const AggregateFunction &function, const Vector &input, idx_t begin,
+					  idx_t end);
+
+	/**
+	 * @brief Aggregate over rows [first, last), relative to the start of the tree
+	 *
+	 */
+	AggregateState Query(idx_t first, idx_t last) const;
+
+  private:
+	const AggregateFunction &function_;
+	idx_t size_;
+	/** @brief Node i has children 2i and 2i + 1, leaves start at size_ */
+	std::vector<AggregateState> nodes_;
+};
+
+} // namespace electricdb
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "electricdb/execution/operators/aggregate/aggregate.h"
+#include "electricdb/execution/operators/sort/sort.h"
+#include "electricdb/execution/vector/vector.h"
+#include "electricdb/util/arena.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace electricdb {
+
+enum class WindowFunctionType : uint8_t {
+	ROW_NUMBER,
+	RANK,
+	DENSE_RANK,
+	LAG,
+	LEAD,
+	COUNT_STAR,
+	COUNT,
+	SUM,
+	MIN,
+	MAX,
+	AVG
+};
+
+enum class WindowFrameType : uint8_t { ROWS, RANGE };
+
+enum class WindowBoundType : uint8_t {
+	UNBOUNDED_PRECEDING,
+	PRECEDING,
+	CURRENT_ROW,
+	FOLLOWING,
+	UNBOUNDED_FOLLOWING
+};
+
+/**
+ * @brief One end of a window frame, e.g. `7 PRECEDING`
+ *
+ * For ROWS frames `offset` counts rows, for RANGE frames it is a distance in the unit of the
+ * single ORDER BY column.
+ */
+struct WindowBound {
+	WindowBoundType type;
+	int64_t offset = 0;
+};
+
+/**
+ * @brief Frame of a framed aggregate, defaults to RANGE BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW
+ *
+ */
+struct WindowFrame {
+	WindowFrameType type = WindowFrameType::RANGE;
+	WindowBound start{WindowBoundType::UNBOUNDED_PRECEDING};
+	WindowBound end{WindowBoundType::CURRENT_ROW};
+};
+
+/**
+ * @brief A window function call, e.g. SUM(column 2) OVER (... ROWS 6 PRECEDING)
+ *
+ */
+struct WindowFunctionSpec {
+	WindowFunctionType type;
+	/** @brief Index of the input column, ignored for ranking functions and COUNT(*) */
+	uint32_t column_idx = 0;
+	/** @brief Row offset of LAG / LEAD */
+	int64_t offset = 1;
+	/** @brief Frame of aggregates, ignored by ranking functions and LAG / LEAD */
+	WindowFrame frame = {};
+};
+
+/**
+ * @brief Read position of a consumer of the window output
+ *
+ */
+struct WindowScanState {
+	uint64_t position = 0;
+};
+
+/**
+ * @brief Window functions sharing one OVER (PARTITION BY ... ORDER BY ...) clause.
+ *
+ * The input is sunk into a SortOperator ordered on the partition columns and then the ORDER BY
+ * keys. Finalize() materializes the sorted rows, finds partition and peer boundaries by comparing
+ * adjacent rows, and evaluates the partitions in parallel. Framed aggregates build a
+ * WindowSegmentTree per partition and answer every frame with one O(log n) query.
+ *
+ * Output columns are the input columns, in window order, followed by one column per function.
+ */
+class WindowOperator {
+  public:
+	/**
+	 * @brief Construct a new WindowOperator
+	 *
+	 * @param types Types of the input columns
+	 * @param partition_columns PARTITION BY columns
+	 * @param order_keys ORDER BY terms within a partition
+	 * @param functions Window functions to evaluate
+	 */
+	WindowOperator(std::vector<LogicalType> types, std::vector<uint32_t> partition_columns,
+				   std::vector<SortKey> order_keys, std::vector<WindowFunctionSpec> functions);
+
+	/** @brief Create the state a worker sinks into */
+	std::unique_ptr<SortLocalState> InitLocal() const { return sort_.InitLocal(); }
+
+	/** @brief Append a chunk to the local state of a worker */
+	void Sink(SortLocalState &local, const std::vector<Vector> &chunk) { sort_.Sink(local, chunk); }
+
+	/** @brief Hand the local state of a worker over to the operator. Thread safe. */
+	void Combine(SortLocalState &local) { sort_.Combine(local); }
+
+	/**
+	 * @brief Sort the input and evaluate all window functions
+	 *
+	 * @param scheduler Scheduler the sort and the evaluation run on, must not be called from one
+	 * of its workers
+	 * @param token Cancels the sort and the evaluation, which then throw QueryCancelled. May be
+	 * null.
+	 */
+	void Finalize(Scheduler &scheduler, const CancellationToken *token = nullptr);
+
+	/**
+	 * @brief Emit the next rows of the output
+	 *
+	 * @param state Read position, advanced by the number of rows emitted
+	 * @param out One vector per output column; filled up to the capacity of out[0]
+	 * @param max_count Emit at most this many rows
+	 * @return idx_t Number of rows emitted, 0 once the output is exhausted
+	 */
+	idx_t Scan(WindowScanState &state, std::vector<Vector> &out,
+			   idx_t max_count = std::numeric_limits<idx_t>::max()) const;
+
+	/** @brief Drop the buffered input and the output. Not thread safe. */
+	void Clear();
+
+	/** @brief Number of output rows, valid after Finalize() */
+	uint64_t Count() const noexcept { return count_; }
+
+	/** @brief Number of partitions, valid after Finalize() */
+	size_t PartitionCount() const noexcept { return partitions_.size(); }
+
+	/** @brief Types of the output columns: input columns, then window functions */
+	const std::vector<LogicalType> &OutputTypes() const noexcept { return output_types_; }
+
+  private:
+	/** @brief Window function with its resolved types */
+	struct BoundFunction {
+		WindowFunctionSpec spec;
+		LogicalType result_type;
+		/** @brief Set for framed aggregates */
+		std::optional<AggregateFunction> aggregate;
+	};
+
+	/**
+	 * @brief Evaluate every function over the sorted rows [begin, end) of one partition. Throws
+	 * QueryCancelled once `token` (may be null) is cancelled.
+	 */
+	void EvaluatePartition(idx_t begin, idx_t end, const CancellationToken *token);
+
+	/** @brief Compute [first, last) of the frame of `row`, inside the partition [begin, end) */
+	void FrameBounds(const WindowFrame &frame, idx_t begin, idx_t end, idx_t row, idx_t &first,
+					 idx_t &last) const;
+
+	/** @brief RANGE frame border for an offset bound, searched in the rows not NULL or NaN */
+	idx_t RangeBound(const WindowBound &bound, bool is_start, idx_t begin, idx_t end,
+					 idx_t row) const;
+
+	std::vector<LogicalType> types_;
+	std::vector<uint32_t> partition_columns_;
+	std::vector<SortKey> order_keys_;
+	std::vector<BoundFunction> functions_;
+	std::vector<LogicalType> output_types_;
+	SortOperator sort_;
+
+	uint64_t count_ = 0;
+	/** @brief Backs the materialized input and result columns */
+	Arena arena_;
+	/** @brief Input columns in window order */
+	std::vector<Vector> columns_;
+	/** @brief One result column per function */
+	std::vector<Vector> results_;
+	/** @brief Null flag per row of every result column, set concurrently by the partitions */
+	std::vector<std::vector<uint8_t>> result_nulls_;
+	/** @brief [begin, end) of every partition in sorted order */
+	std::vector<std::pair<idx_t, idx_t>> partitions_;
+	/** @brief First and one-past-last row of the peer group (equal ORDER BY keys) of each row */
+	std::vector<idx_t> peer_begin_;
+	std::vector<idx_t> peer_end_;
+};
+
+} // namespace electricdb
@@ -49,6 +49,122 @@ class Vector {
 	 */
 	void Reference(const Vector &other);
 
+	/**
+	 * @brief Point this vector at `count` values in memory it does not own, e.g. a mapped file.
+	 * zero-copy. The null flags stay in this vector's mask and are cleared.
+	 *
+	 * The memory must outlive every use of the values and may be read-only. Data() must not be
+	 * written through until the vector is flat in its own buffer again: Reset() and Gather()
+	 * return to that buffer, and Copy() first copies the referenced values into it.
+	 *
+	 * @param data Values of this vector's type, aligned for the type
+	 * @param count Number of values, at most the capacity of this vector
+	 */
+	void ReferenceExternal(const void *data, uint32_t count);
+
+	/**
+	 * @brief Make this a dictionary vector: row i holds the value dictionary[codes[i]]. zero-copy.
+	 * The null flags stay in this vector's mask and are cleared, they mark NULL rows whatever
+	 * their code.
+	 *
+	 * Operators that understand dictionary vectors work on the codes, e.g. evaluate a predicate
+	 * once per entry or group by code; everything else calls Flatten() first. Data() and
+	 * RawData() are not available until then. Both the dictionary and the codes must outlive
+	 * every use of this vector.
+	 *
+	 * @param dictionary Flat vector of this vector's type, its first Size() values are the entries
+	 * @param codes One code per row, each below dictionary.Size()
+	 * @param count Number of rows, at most the capacity of this vector
+	 */
+	void ReferenceDictionary(const Vector &dictionary, const sel_t *codes, uint32_t count);
+
+	/** @brief Check if this vector points at memory it does not own, see ReferenceExternal() */
+	bool IsExternal() const noexcept { return external_; }
+
+	/** @brief Check if this is a dictionary vector, see ReferenceDictionary() */
+	bool IsDictionary() const noexcept { return dictionary_ != nullptr; }
+
+	/** @brief Entries of a dictionary vector */
+	const Vector &Dictionary() const {
+#ifndef NDEBUG
+		assert(IsDictionary());
+#endif
+		return *dictionary_;
+	}
+
+	/** @brief Code of every row of a dictionary vector */
+	const sel_t *Codes() const {
+#ifndef NDEBUG
+		assert(IsDictionary());
+#endif
+		return codes_;
+	}
+
+	/**
+	 * @brief Make this a run vector: runs of rows that share a value, e.g. the runs of an RLE
+	 * column chunk. zero-copy. Run r covers the lengths[r] rows after those of the runs before it.
+	 * The null flags stay in this vector's mask: they are cleared, then set on the rows of runs
+	 * whose value is NULL.
+	 *
+	 * Like dictionary vectors, run vectors are only handed to operators that understand them
+	 * (e.g. fold a run into an aggregate at once); everything else calls Flatten() first. Both the
+	 * values and the lengths must outlive every use of this vector.
+	 *
+	 * @param values Flat vector of this vector's type, one value per run, NULL for NULL runs
+	 * @param lengths Rows of each run, they add up to `count`
+	 * @param count Number of rows, at most the capacity of this vector
+	 */
+	void ReferenceRuns(const Vector &values, const uint32_t *lengths, uint32_t count);
+
+	/** @brief Check if this is a run vector, see ReferenceRuns() */
+	bool IsRuns() const noexcept { return run_values_ != nullptr; }
+
+	/** @brief Value of every run of a run vector, RunValues().Size() is the number of runs */
+	const Vector &RunValues() const {
+#ifndef NDEBUG
+		assert(IsRuns());
+#endif
+		return *run_values_;
+	}
+
+	/** @brief Rows of every run of a run vector */
+	const uint32_t *RunLengths() const {
+#ifndef NDEBUG
+		assert(IsRuns());
+#endif
+		return run_lengths_;
+	}
+
+	/**
+	 * @brief Expand a dictionary or run vector into flat values, written to the buffer this
+	 * vector was constructed with (which must hold Size() values). The null flags are kept. No-op
+	 * for flat vectors.
+	 */
+	void Flatten();
+
+	/**
+	 * @brief Copy values and null flags of rows [offset, offset + count) of `source` into rows
+	 * [target, target + count) of this vector. The size of this vector must cover the target rows.
+	 * `source` may be a dictionary or run vector, this vector must be flat.
+	 *
+	 * @param source Vector of the same type to copy from
+	 * @param offset First row of `source` to copy
+	 * @param count Number of rows to copy
+	 * @param target First row of this vector to write
+	 */
+	void Copy(const Vector &source, uint32_t offset, uint32_t count, uint32_t target = 0);
+
+	/**
+	 * @brief Replace the contents of this vector with rows sel[0], ..., sel[count - 1] of `source`.
+	 * The result is flat, also if `source` is a dictionary vector. `source` must not be a run
+	 * vector.
+	 *
+	 * @param source Vector of the same type to copy from
+	 * @param sel Rows of `source` to copy
+	 * @param count Number of rows to copy
+	 */
+	void Gather(const Vector &source, const SelectionVector &sel, uint32_t count);
+
 	/**
 	 * @brief Functions below are for getting metadata
 	 *
@@ -77,6 +193,7 @@ class Vector {
 	T *Data() {
 #ifndef NDEBUG
 		assert(TypeMatches<T>(logical_type_));
+		assert(!IsDictionary() && !IsRuns());
 #endif
 		return reinterpret_cast<T *>(data_);
 	}
@@ -86,10 +203,26 @@ class Vector {
 	const T *Data() const {
 #ifndef NDEBUG
 		assert(TypeMatches<T>(logical_type_));
+		assert(!IsDictionary() && !IsRuns());
 #endif
 		return reinterpret_cast<const T *>(data_);
 	}
 
+	/** @brief Untyped access to the data buffer, for code that moves fixed-width values as bytes */
+	uint8_t *RawData() noexcept {
+#ifndef NDEBUG
+		assert(!IsDictionary() && !IsRuns());
+#endif
+		return static_cast<uint8_t *>(data_);
+	}
+
+	const uint8_t *RawData() const noexcept {
+#ifndef NDEBUG
+		assert(!IsDictionary() && !IsRuns());
+#endif
+		return static_cast<const uint8_t *>(data_);
+	}
+
 	/**
 	 * @brief Functions below are for null handling
 	 *
@@ -125,14 +258,31 @@ class Vector {
 
 	void ClearNulls();
 
+	/**
+	 * @brief Empty the vector: no rows, no nulls, and flat in its own buffer again if it was a
+	 * dictionary, runs or external
+	 */
 	void Reset();
 
   private:
+	/** @brief Point `data_` back at `buffer_`, dropping any dictionary, runs or external values */
+	void UseOwnBuffer() noexcept;
+
 	LogicalType logical_type_;
 	uint32_t size_;
 	uint32_t capacity_;
 	void *data_;
 	uint32_t null_count_;
 	NullMask *nulls_;
+	/** @brief Values allocated at construction, kept when `data_` points elsewhere */
+	void *buffer_;
+	/** @brief Entries and codes of a dictionary vector, null for flat vectors */
+	const Vector *dictionary_ = nullptr;
+	const sel_t *codes_ = nullptr;
+	/** @brief Values and lengths of the runs of a run vector, null for other vectors */
+	const Vector *run_values_ = nullptr;
+	const uint32_t *run_lengths_ = nullptr;
+	/** @brief `data_` points at memory this vector does not own and may not write */
+	bool external_ = false;
 };
 } // namespace electricdb
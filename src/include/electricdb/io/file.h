@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace electricdb {
+
+/** @brief Flags accepted by File, combine with | */
+enum FileFlags : uint32_t {
+	FILE_READ = 1U << 0,
+	FILE_WRITE = 1U << 1,
+	FILE_CREATE = 1U << 2,
+	FILE_TRUNCATE = 1U << 3,
+	/** @brief Bypass the page cache (O_DIRECT) where the filesystem supports it */
+	FILE_DIRECT = 1U << 4,
+};
+
+/**
+ * @brief Alignment of buffers, offsets and sizes of reads from a file opened with FILE_DIRECT
+ *
+ */
+constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+/**
+ * @brief RAII wrapper around a file descriptor with positional I/O.
+ *
+ * All reads and writes take an explicit offset (pread/pwrite), so a single File can be shared by
+ * several threads without coordinating a file position.
+ */
+class File {
+  public:
+	/** @brief Construct a closed file */
+	File() noexcept = default;
+
+	/**
+	 * @brief Open the file at `path`
+	 *
+	 * @param path Path of the file
+	 * @param flags Combination of FileFlags. With FILE_DIRECT on a filesystem that does not
+	 * support direct I/O (e.g. tmpfs) the file is opened buffered, see IsDirect().
+	 */
+	File(std::string path, uint32_t flags);
+
+	~File();
+
+	/** @brief Disable copy constructor */
+	File(const File &) = delete;
+
+	/** @brief Disable copy assignment */
+	File &operator=(const File &) = delete;
+
+	/** @brief Custom move constructor */
+	File(File &&other) noexcept;
+
+	/** @brief Custom move assignment */
+	auto operator=(File &&other) noexcept -> File &;
+
+	/**
+	 * @brief Read up to `size` bytes starting at `offset`
+	 *
+	 * @param buffer Destination buffer
+	 * @param size Number of bytes to read
+	 * @param offset Offset in the file to start reading from
+	 * @return size_t Number of bytes read, smaller than `size` only at end of file
+	 */
+	size_t Read(void *buffer, size_t size, uint64_t offset) const;
+
+	/**
+	 * @brief Write `size` bytes at `offset`, retrying short writes
+	 *
+	 * @param buffer Source buffer
+	 * @param size Number of bytes to write
+	 * @param offset Offset in the file to start writing at
+	 */
+	void Write(const void *buffer, size_t size, uint64_t offset);
+
+	/** @brief Current size of the file in bytes */
+	uint64_t Size() const;
+
+	/** @brief Resize the file to `size` bytes */
+	void Truncate(uint64_t size);
+
+	/** @brief Close the file. Closing a closed file is a no-op */
+	void Close() noexcept;
+
+	bool IsOpen() const noexcept { return fd_ >= 0; }
+
+	/**
+	 * @brief Check if I/O bypasses the page cache. Buffers, offsets and sizes of every read and
+	 * write must then be multiples of DIRECT_IO_ALIGNMENT; a read may end early at end of file.
+	 */
+	bool IsDirect() const noexcept { return direct_; }
+
+	/** @brief Underlying file descriptor */
+	int Handle() const noexcept { return fd_; }
+
+	const std::string &Path() const noexcept { return path_; }
+
+	/** @brief Delete the file at `path` if it exists */
+	static void Remove(const std::string &path) noexcept;
+
+  private:
+	int fd_ = -1;
+	bool direct_ = false;
+	std::string path_;
+};
+
+} // namespace electricdb
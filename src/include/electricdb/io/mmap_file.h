@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace electricdb {
+
+/** @brief Expected access pattern of mapped pages, passed to madvise() */
+enum class AccessHint : uint8_t {
+	NORMAL,
+	/** @brief Read ahead aggressively and drop pages soon after they were read */
+	SEQUENTIAL,
+	/** @brief Do not read ahead */
+	RANDOM,
+	/** @brief Start reading the pages in now, they will be needed soon */
+	WILLNEED,
+	/** @brief The pages will not be needed again for a while */
+	DONTNEED
+};
+
+/**
+ * @brief RAII read-only memory mapping of a whole file.
+ *
+ * Pages are loaded from the page cache on first touch and shared with every other mapping of the
+ * file, so reading through the mapping copies nothing. The file must not be truncated while it
+ * is mapped, touching pages beyond its end raises SIGBUS.
+ */
+class MappedFile {
+  public:
+	/** @brief Construct an empty mapping */
+	MappedFile() noexcept = default;
+
+	/** @brief Map the file at `path` read-only, an empty file maps to no memory */
+	explicit MappedFile(const std::string &path);
+
+	~MappedFile();
+
+	/** @brief Disable copy constructor */
+	MappedFile(const MappedFile &) = delete;
+
+	/** @brief Disable copy assignment */
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	/** @brief Custom move constructor */
+	MappedFile(MappedFile &&other) noexcept;
+
+	/** @brief Custom move assignment */
+	auto operator=(MappedFile &&other) noexcept -> MappedFile &;
+
+	/** @brief First byte of the file, null if nothing is mapped */
+	const uint8_t *Data() const noexcept { return data_; }
+
+	/** @brief Size of the mapped file in bytes */
+	uint64_t Size() const noexcept { return size_; }
+
+	bool IsMapped() const noexcept { return data_ != nullptr; }
+
+	/** @brief Advise the kernel about access to the whole mapping */
+	void Advise(AccessHint hint) const noexcept { Advise(0, size_, hint); }
+
+	/**
+	 * @brief Advise the kernel about access to bytes [offset, offset + length). Only a hint,
+	 * failures are ignored.
+	 */
+	void Advise(uint64_t offset, uint64_t length, AccessHint hint) const noexcept;
+
+	/** @brief Remove the mapping. Unmapping an empty mapping is a no-op */
+	void Unmap() noexcept;
+
+  private:
+	const uint8_t *data_ = nullptr;
+	uint64_t size_ = 0;
+};
+
+} // namespace electricdb
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "electricdb/io/file.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Asynchronous positional reads.
+ *
+ * Reads are submitted to an io_uring when the kernel allows it; otherwise, or when asked to, a
+ * small pool of threads issues them with pread(). Submit() returns at once with a ticket and Wait()
+ * blocks until that read completed, so callers can keep several reads in flight while they work on
+ * data that already arrived. All functions are thread safe.
+ */
+class AsyncReader {
+  public:
+	enum class Backend : uint8_t { IO_URING, THREAD_POOL };
+
+	/**
+	 * @brief Set up the backend
+	 *
+	 * @param queue_depth Reads in flight at once: the ring size, or the threads of the pool (at
+	 * most 16)
+	 * @param io_uring Use io_uring if the kernel supports it, the thread pool otherwise
+	 */
+	explicit AsyncReader(uint32_t queue_depth = 32, bool io_uring = true);
+
+	/** @brief Waits for every read still in flight, their buffers must be alive until then */
+	~AsyncReader();
+
+	/** @brief Disable copy constructor */
+	AsyncReader(const AsyncReader &) = delete;
+
+	/** @brief Disable copy assignment */
+	AsyncReader &operator=(const AsyncReader &) = delete;
+
+	Backend GetBackend() const noexcept { return ring_ ? Backend::IO_URING : Backend::THREAD_POOL; }
+
+	/**
+	 * @brief Start reading `size` bytes at `offset` of `file` into `buffer`
+	 *
+	 * @param file Open file, must stay open until the read was waited for
+	 * @param buffer Destination, must stay alive until the read was waited for
+	 * @param size Number of bytes to read
+	 * @param offset Offset in the file to start reading from
+	 * @return uint64_t Ticket to pass to Wait()
+	 */
+	uint64_t Submit(const File &file, void *buffer, size_t size, uint64_t offset);
+
+	/**
+	 * @brief Wait for a submitted read, every ticket must be waited for exactly once
+	 *
+	 * @return size_t Number of bytes read, smaller than requested only at end of file
+	 */
+	size_t Wait(uint64_t ticket);
+
+  private:
+	/** @brief A submitted read, kept until it completed in full */
+	struct Request {
+		const File *file;
+		uint8_t *buffer;
+		size_t size;
+		uint64_t offset;
+		/** @brief Bytes read so far */
+		size_t done = 0;
+	};
+
+	/** @brief Outcome of a finished read: bytes read, or -errno */
+	using Result = int64_t;
+
+	struct Ring;
+
+	/** @brief Push a read for the remaining bytes of `request` to the ring, lock_ held */
+	void SubmitToRing(uint64_t ticket, const Request &request);
+
+	/** @brief Block until the ring completed at least one read and collect all completions */
+	void ReapRing();
+
+	/** @brief Account a completion of `ticket`, resubmitting the rest of short reads */
+	void Complete(uint64_t ticket, int32_t res);
+
+	/** @brief Loop of a thread of the pool */
+	void Work();
+
+	std::unique_ptr<Ring> ring_;
+	uint32_t queue_depth_;
+
+	/** @brief Guards everything below */
+	std::mutex lock_;
+	std::condition_variable completed_;
+	uint64_t next_ticket_ = 1;
+	std::unordered_map<uint64_t, Request> requests_;
+	std::unordered_map<uint64_t, Result> results_;
+	/** @brief Reads in the ring, at most queue_depth_ */
+	uint32_t in_ring_ = 0;
+	/** @brief Only one thread at a time waits on the ring's completion queue */
+	bool reaping_ = false;
+
+	/** @brief Thread pool backend */
+	std::vector<std::thread> workers_;
+	std::condition_variable submitted_;
+	std::deque<uint64_t> queue_;
+	bool stop_ = false;
+};
+
+} // namespace electricdb
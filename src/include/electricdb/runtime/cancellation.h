@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+namespace electricdb {
+
+enum class CancelReason : uint8_t { NONE, USER, DEADLINE };
+
+/**
+ * @brief Thrown out of a query that noticed it was cancelled
+ *
+ */
+class QueryCancelled : public std::runtime_error {
+  public:
+	explicit QueryCancelled(CancelReason reason);
+
+	CancelReason Reason() const noexcept { return reason_; }
+
+  private:
+	CancelReason reason_;
+};
+
+/**
+ * @brief Cancellation flag of one query, checked cooperatively by the scheduler and the pipelines.
+ *
+ * IsCancelled() is a relaxed atomic load, cheap enough to call once per batch. Deadlines are
+ * enforced by a shared timer thread that cancels the token once its deadline passes, so checking
+ * for an expired deadline does not read the clock.
+ */
+class CancellationToken {
+  public:
+	using Clock = std::chrono::steady_clock;
+
+	CancellationToken() = default;
+	~CancellationToken();
+
+	/** @brief Disable copy constructor */
+	CancellationToken(const CancellationToken &) = delete;
+
+	/** @brief Disable copy assignment */
+	CancellationToken &operator=(const CancellationToken &) = delete;
+
+	bool IsCancelled() const noexcept {
+		return reason_.load(std::memory_order_relaxed) != CancelReason::NONE;
+	}
+
+	/** @brief Why the token was cancelled, NONE while it is not */
+	CancelReason Reason() const noexcept { return reason_.load(std::memory_order_acquire); }
+
+	/**
+	 * @brief Cancel the query. Thread safe, the first reason sticks.
+	 *
+	 * @return true if this call cancelled the token
+	 */
+	bool Cancel(CancelReason reason = CancelReason::USER) noexcept;
+
+	/** @brief Throw QueryCancelled if the token is cancelled */
+	void ThrowIfCancelled() const {
+		if (IsCancelled())
+			throw QueryCancelled(Reason());
+	}
+
+	/**
+	 * @brief Cancel the token with DEADLINE once `deadline` has passed
+	 *
+	 * @param deadline Point in time after which the query must stop, replaces an earlier deadline
+	 */
+	void SetDeadline(Clock::time_point deadline);
+
+	/** @brief Cancel the token with DEADLINE `timeout` from now */
+	void SetTimeout(Clock::duration timeout) { SetDeadline(Clock::now() + timeout); }
+
+  private:
+	std::atomic<CancelReason> reason_{CancelReason::NONE};
+	/** @brief Whether the deadline timer may hold a pointer to this token */
+	bool has_deadline_ = false;
+};
+
+} // namespace electricdb
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Counters of one operator, collected per thread and merged when a pipeline ends
+ *
+ * Operators that probe hash tables add the number of lookups to `probes` and the number of
+ * slots or chain entries they visited to `probe_steps`. The hardware counters stay 0 unless the
+ * query was profiled with PerfCounters and the kernel allowed opening them.
+ */
+struct OperatorMetrics {
+	uint64_t rows_in = 0;
+	uint64_t rows_out = 0;
+	uint64_t batches = 0;
+	uint64_t wall_ns = 0;
+	uint64_t cpu_ns = 0;
+	/** @brief Scratch memory taken from the worker's arena */
+	uint64_t bytes_allocated = 0;
+	uint64_t bytes_read = 0;
+	uint64_t probes = 0;
+	uint64_t probe_steps = 0;
+	uint64_t cycles = 0;
+	uint64_t instructions = 0;
+	uint64_t llc_misses = 0;
+	uint64_t branch_misses = 0;
+	/** @brief Number of threads that ran the operator */
+	uint32_t threads = 0;
+
+	/** @brief Add the counters of `other`, keeping the larger thread count */
+	void Merge(const OperatorMetrics &other);
+
+	/** @brief Average number of entries visited per hash table lookup */
+	double AverageProbeLength() const noexcept {
+		return probes ? static_cast<double>(probe_steps) / static_cast<double>(probes) : 0;
+	}
+
+	/** @brief Instructions per cycle */
+	double InstructionsPerCycle() const noexcept {
+		return cycles ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0;
+	}
+};
+
+/**
+ * @brief Profile of one operator and its inputs
+ *
+ */
+struct ProfileNode {
+	std::string name;
+	OperatorMetrics metrics;
+	std::vector<ProfileNode> children;
+};
+
+/**
+ * @brief Per-operator profile of an executed query, rendered as EXPLAIN ANALYZE or JSON
+ *
+ */
+class QueryProfile {
+  public:
+	/**
+	 * @brief Construct a new QueryProfile
+	 *
+	 * @param root Profile of the root operator
+	 * @param wall_ns Wall time of the whole query
+	 */
+	QueryProfile(ProfileNode root, uint64_t wall_ns);
+
+	const ProfileNode &Root() const noexcept { return root_; }
+
+	uint64_t WallTime() const noexcept { return wall_ns_; }
+
+	/** @brief Operator tree with the counters of every operator, one operator per line */
+	std::string ToText() const;
+
+	/** @brief The same tree as a JSON object */
+	std::string ToJson() const;
+
+  private:
+	ProfileNode root_;
+	uint64_t wall_ns_;
+};
+
+} // namespace electricdb
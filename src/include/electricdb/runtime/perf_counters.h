@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace electricdb {
+
+/** @brief Hardware events counted by PerfCounters */
+enum class PerfEvent : uint8_t { CYCLES, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES };
+
+constexpr size_t PERF_EVENT_COUNT = 4;
+
+/** @brief Running totals of every PerfEvent, indexed by the event */
+using PerfSample = std::array<uint64_t, PERF_EVENT_COUNT>;
+
+/**
+ * @brief Hardware performance counters of the calling thread, read through perf_event_open.
+ *
+ * The events are opened as one group in user space only, so a single read() returns all of them
+ * and unprivileged processes may count their own threads. Kernels that forbid perf events (a high
+ * perf_event_paranoid, seccomp, virtual machines without a PMU) leave the counters unavailable:
+ * nothing throws and every event reads 0. Counters are bound to the thread that created them.
+ */
+class PerfCounters {
+  public:
+	/** @brief Start counting on the calling thread, events the kernel refuses are left out */
+	PerfCounters();
+	~PerfCounters();
+
+	/** @brief Disable copy constructor */
+	PerfCounters(const PerfCounters &) = delete;
+
+	/** @brief Disable copy assignment */
+	PerfCounters &operator=(const PerfCounters &) = delete;
+
+	/** @brief Check if at least one event is counted */
+	bool Available() const noexcept { return leader_ >= 0; }
+
+	/** @brief Check if `event` is counted */
+	bool Counts(PerfEvent event) const noexcept;
+
+	/**
+	 * @brief Read the running totals, scaled up if the kernel multiplexed the counters
+	 *
+	 * @return PerfSample Totals since construction, 0 for events that are not counted
+	 */
+	PerfSample Read() const noexcept;
+
+  private:
+	/** @brief File descriptor of the group leader, -1 if nothing could be opened */
+	int leader_ = -1;
+	std::array<int, PERF_EVENT_COUNT> fds_;
+	/** @brief Events in the order they joined the group, which is the order read() reports */
+	std::array<PerfEvent, PERF_EVENT_COUNT> order_;
+	size_t opened_ = 0;
+};
+
+} // namespace electricdb
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace electricdb {
+
+/** @brief Bytes of one frame, the unit in which the buffer manager hands out memory */
+constexpr uint64_t DEFAULT_FRAME_SIZE = uint64_t{64} << 10;
+
+/** @brief Identifies a cached column chunk */
+struct ChunkKey {
+	/** @brief File the chunk belongs to, see BufferManager::RegisterFile() */
+	uint32_t file = 0;
+	uint32_t row_group = 0;
+	uint32_t column = 0;
+
+	bool operator==(const ChunkKey &other) const noexcept {
+		return file == other.file && row_group == other.row_group && column == other.column;
+	}
+};
+
+struct ChunkKeyHash {
+	size_t operator()(const ChunkKey &key) const noexcept;
+};
+
+/** @brief Counters of a BufferManager since its construction */
+struct BufferStats {
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t evictions = 0;
+	/** @brief Misses on keys that were evicted from probation recently, admitted as hot */
+	uint64_t promotions = 0;
+};
+
+class BufferManager;
+class CancellationToken;
+
+/**
+ * @brief A pinned chunk. The chunk stays resident and its bytes stay valid until the handle is
+ * destroyed or reset.
+ */
+class BufferHandle {
+  public:
+	BufferHandle() = default;
+	~BufferHandle() { Reset(); }
+
+	/** @brief Disable copy constructor */
+	BufferHandle(const BufferHandle &) = delete;
+
+	/** @brief Disable copy assignment */
+	BufferHandle &operator=(const BufferHandle &) = delete;
+
+	BufferHandle(BufferHandle &&other) noexcept;
+
+	BufferHandle &operator=(BufferHandle &&other) noexcept;
+
+	bool IsValid() const noexcept { return entry_ != nullptr; }
+
+	const uint8_t *Data() const noexcept;
+
+	uint64_t Size() const noexcept;
+
+	/** @brief Unpin the chunk */
+	void Reset() noexcept;
+
+  private:
+	friend class BufferManager;
+
+	struct Entry;
+
+	BufferHandle(BufferManager *manager, Entry *entry) noexcept
+		: manager_(manager), entry_(entry) {}
+
+	BufferManager *manager_ = nullptr;
+	Entry *entry_ = nullptr;
+};
+
+/**
+ * @brief Caches column chunks in memory under one budget, shared by every scan of the process.
+ *
+ * Memory is handed out in whole frames of a fixed size, so the budget counts exactly what the
+ * chunks hold and a chunk's frames are one contiguous, aligned allocation. Pin() returns a
+ * resident chunk or builds it with the caller's loader, evicting unpinned chunks until it fits;
+ * an evicted chunk is simply built again from disk by the next Pin().
+ *
+ * Eviction follows 2Q with a clock. A chunk seen for the first time enters a probation FIFO of
+ * about a quarter of the budget, so a one-off scan streams through probation without touching
+ * the rest of the cache. Keys evicted from probation are remembered (without their data) in a
+ * ghost list; a miss on a remembered key admits the chunk to the main queue, which a clock sweep
+ * evicts from, giving every chunk referenced since the last sweep another round. All functions
+ * are thread safe; a chunk being loaded is loaded once while other threads wait for it, and a
+ * chunk that only fits once another thread unpins waits for that. A caller that keeps several
+ * chunks pinned at once can still deadlock with another such caller, so waits observe the
+ * caller's cancellation token.
+ */
+class BufferManager {
+  public:
+	/** @brief Builds a chunk into its `size` bytes of frames, may throw to abandon the load */
+	using Loader = std::function<void(uint8_t *data)>;
+
+	/**
+	 * @brief Construct a new BufferManager
+	 *
+	 * @param memory_limit Bytes the cached chunks may use, rounded down to whole frames
+	 * @param frame_size Allocation unit, a power of two of at least DIRECT_IO_ALIGNMENT bytes
+	 */
+	explicit BufferManager(uint64_t memory_limit, uint64_t frame_size = DEFAULT_FRAME_SIZE);
+
+	/** @brief Frees every chunk, no handle may be alive */
+	~BufferManager();
+
+	/** @brief Disable copy constructor */
+	BufferManager(const BufferManager &) = delete;
+
+	/** @brief Disable copy assignment */
+	BufferManager &operator=(const BufferManager &) = delete;
+
+	/**
+	 * @brief Id of the file at `path`, for ChunkKey::file. The id stays the same as long as the
+	 * file does: once it was rewritten (other inode, size or modification time) it gets a new id
+	 * and the unpinned chunks of the old one are dropped.
+	 */
+	uint32_t RegisterFile(const std::string &path);
+
+	/**
+	 * @brief Pin a chunk, loading it on a miss
+	 *
+	 * @param key The chunk
+	 * @param size Bytes of the chunk, the same for every pin of `key`
+	 * @param load Called on a miss, without locks held, to fill the chunk's frames
+	 * @param token Checked while waiting, throws QueryCancelled once it is cancelled
+	 * @param held Handles the caller keeps pinned while it waits
+	 * @return BufferHandle Handle that keeps the chunk pinned. Throws if the chunk is larger than
+	 * the memory limit. While the pinned chunks leave no room, waits until another thread unpins;
+	 * throws instead if the caller's `held` handles are the only pins, as none would come.
+	 */
+	BufferHandle Pin(const ChunkKey &key, uint64_t size, const Loader &load,
+					 const CancellationToken *token = nullptr, size_t held = 0);
+
+	/** @brief Check if `key` is cached */
+	bool IsResident(const ChunkKey &key) const;
+
+	uint64_t MemoryLimit() const noexcept { return frame_limit_ * frame_size_; }
+
+	/** @brief Bytes of the frames held by cached chunks */
+	uint64_t MemoryUsed() const;
+
+	uint64_t FrameSize() const noexcept { return frame_size_; }
+
+	BufferStats Stats() const;
+
+  private:
+	friend class BufferHandle;
+
+	using Entry = BufferHandle::Entry;
+
+	void Unpin(Entry *entry) noexcept;
+
+	/** @brief Identity of a registered file, a new one means it was rewritten */
+	struct FileVersion {
+		uint32_t id = 0;
+		uint64_t inode = 0;
+		uint64_t size = 0;
+		int64_t modified_ns = 0;
+	};
+
+	/** @brief Drop the unpinned chunks of `file`, lock_ held */
+	void DropFile(uint32_t file);
+
+	/**
+	 * @brief Evict unpinned chunks until `frames` more frames fit, false if the remaining chunks
+	 * are all pinned, lock_ held
+	 */
+	bool Reserve(uint64_t frames);
+
+	/** @brief Evict the oldest unpinned probation chunk, false if there is none, lock_ held */
+	bool EvictProbation();
+
+	/** @brief Advance the clock hand until it evicts a main chunk, false if none is evictable */
+	bool EvictMain();
+
+	/** @brief Drop an unpinned entry and free its frames, lock_ held */
+	void Remove(Entry *entry);
+
+	/** @brief Wait for loaded_, throwing once `token` is cancelled */
+	void Wait(std::unique_lock<std::mutex> &guard, const CancellationToken *token);
+
+	/** @brief Remember an evicted probation key, lock_ held */
+	void AddGhost(const ChunkKey &key);
+
+	uint64_t frame_size_;
+	uint64_t frame_limit_;
+	/** @brief Frames probation may hold before it is evicted from first */
+	uint64_t probation_limit_;
+	/** @brief Keys the ghost list remembers at most */
+	size_t ghost_limit_;
+
+	mutable std::mutex lock_;
+	/** @brief Signalled whenever a load finished or failed, or a chunk got unpinned */
+	std::condition_variable loaded_;
+	std::unordered_map<ChunkKey, std::unique_ptr<Entry>, ChunkKeyHash> entries_;
+	/** @brief First-time chunks, oldest first */
+	std::list<Entry *> probation_;
+	/** @brief Chunks referenced again, in clock order: the hand is at the front */
+	std::list<Entry *> main_;
+	std::list<ChunkKey> ghosts_;
+	std::unordered_map<ChunkKey, std::list<ChunkKey>::iterator, ChunkKeyHash> ghost_index_;
+	std::unordered_map<std::string, FileVersion> files_;
+	uint32_t next_file_ = 0;
+	uint64_t frames_used_ = 0;
+	uint64_t probation_frames_ = 0;
+	/** @brief Pins over every entry, including the ones being loaded */
+	uint64_t pins_ = 0;
+	BufferStats stats_;
+};
+
+} // namespace electricdb
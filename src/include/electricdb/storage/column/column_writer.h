@@ -0,0 +1,83 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/vector.h"
+#include "electricdb/storage/encoding/encoding.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace electricdb {
+
+/** @brief How a ColumnWriter weighs the size of a chunk against the time to decode it */
+struct EncodingPolicy {
+	/**
+	 * @brief Blocks of ForEncoding::BLOCK_SIZE rows the sample is made of, spread evenly over the
+	 * chunk. Chunks of up to this many blocks are estimated exactly. Whole blocks are sampled, so
+	 * the runs, deltas and value ranges the encodings pack per block survive sampling.
+	 */
+	uint32_t sample_blocks = 8;
+	/** @brief Bandwidth at which chunks are read, in bytes per nanosecond (GB/s) */
+	double read_bytes_per_ns = 2.0;
+};
+
+/** @brief Estimated cost of storing one chunk in one encoding */
+struct EncodingEstimate {
+	EncodingType encoding = EncodingType::PLAIN;
+	/** @brief Bytes of the encoded values */
+	size_t size = 0;
+	/** @brief Nanoseconds to decode the chunk */
+	double decode_ns = 0;
+
+	/** @brief Nanoseconds to read the chunk at `read_bytes_per_ns` and decode it */
+	double Cost(double read_bytes_per_ns) const noexcept {
+		return static_cast<double>(size) / read_bytes_per_ns + decode_ns;
+	}
+};
+
+/**
+ * @brief Picks the encoding of every chunk of one column from a sample of its values.
+ *
+ * Each encoding that supports the column's type is tried on the sample: its encoded size is
+ * computed exactly and scaled to the chunk (a dictionary holds the sample's distinct values and
+ * a code for every row of the chunk), its decode time is estimated from measured per-value (and
+ * for RLE per-run) costs. The encoding that reads and decodes fastest under the policy wins.
+ * The encodings already cascade where it pays off: dictionary codes and deltas are bit-packed with
+ * ForEncoding, so DICTIONARY and DELTA are estimated as those cascades.
+ *
+ * As the choice is made per chunk, a column follows its data: a chunk of few distinct values is
+ * stored as a dictionary, the next one with a steady step as deltas.
+ */
+class ColumnWriter {
+  public:
+	/**
+	 * @brief Construct a new ColumnWriter
+	 *
+	 * @param type Type of the column, fixed-width
+	 * @param policy How size and decode time are weighed
+	 */
+	explicit ColumnWriter(LogicalType type, EncodingPolicy policy = {});
+
+	LogicalType Type() const noexcept { return type_; }
+
+	const EncodingPolicy &Policy() const noexcept { return policy_; }
+
+	/**
+	 * @brief Estimate every encoding that can store the sampled values of `chunk`
+	 *
+	 * @param chunk Values of the chunk, of the column's type
+	 * @return std::vector<EncodingEstimate> One estimate per encoding, PLAIN always included,
+	 * cheapest first
+	 */
+	std::vector<EncodingEstimate> Estimate(const Vector &chunk) const;
+
+	/** @brief Encoding of the estimate of `chunk` with the lowest cost */
+	EncodingType Choose(const Vector &chunk) const;
+
+  private:
+	LogicalType type_;
+	EncodingPolicy policy_;
+};
+
+} // namespace electricdb
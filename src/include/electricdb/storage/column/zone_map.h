@@ -0,0 +1,43 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/vector.h"
+
+#include <cstdint>
+
+namespace electricdb {
+
+/**
+ * @brief Min/max summary of a run of values of one column (a batch, a chunk, a row group).
+ *
+ * Operators use zone maps to rule out whole chunks without reading them. `min` and `max` are NULL
+ * while no non-null value has been seen. NaN is left out of `min` and `max`, which it would not
+ * order against, and recorded in `has_nan` instead. Zeros are kept as +0.0, which compares equal
+ * to -0.0.
+ */
+struct ZoneMap {
+	explicit ZoneMap(LogicalType type = LogicalType::INVALID) {
+		min.SetType(type);
+		max.SetType(type);
+	}
+
+	Value min;
+	Value max;
+	bool has_nulls = false;
+	/** @brief Whether a FLOAT or DOUBLE NaN was seen */
+	bool has_nan = false;
+	uint64_t count = 0;
+
+	LogicalType Type() const noexcept { return min.Type(); }
+
+	/** @brief Check if at least one non-null value other than NaN was seen */
+	bool HasValues() const noexcept { return !min.IsNull(); }
+
+	/** @brief Widen the zone map with the first `vec.Size()` values of `vec` */
+	void Update(const Vector &vec);
+
+	/** @brief Widen the zone map with another zone map of the same type */
+	void Merge(const ZoneMap &other);
+};
+
+} // namespace electricdb
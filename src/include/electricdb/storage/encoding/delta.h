@@ -0,0 +1,114 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/selection_vector.h"
+#include "electricdb/execution/vector/vector.h"
+#include "electricdb/storage/encoding/encoding.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace electricdb {
+
+/**
+ * @brief Delta encoding of INT32 and INT64 columns that grow steadily, such as event timestamps:
+ * each value is stored as its difference to the previous one (order 1) or as the change of that
+ * difference (order 2, delta-of-delta), whichever packs smaller. Regular timestamps have a
+ * delta-of-delta of 0 and pack at a width of a few bits.
+ *
+ * Rows are split into pages of PAGE_SIZE. Every page starts from its own base, the page's first
+ * value (and its first delta for order 2), so any page decodes without the ones before it and a
+ * scan can start in the middle of a chunk. The differences of all pages are bit-packed with
+ * ForEncoding, a page per block. Decoding unpacks a block and runs one prefix sum per order over
+ * it, with AVX2 instructions where the CPU has them.
+ *
+ * The layout is the order (1 byte), the bytes per value (1 byte), a flag that is set if the values
+ * never decrease (1 byte, 5 reserved), the page bases as 8 byte integers, then the packed
+ * differences. Null rows continue the last delta (leading ones repeat the first non-null value),
+ * nulls are stored next to the encoded values.
+ */
+class DeltaEncoding {
+  public:
+	/** @brief Rows per page, one ForEncoding block */
+	static constexpr uint32_t PAGE_SIZE = 1024;
+
+	/** @brief Bytes before the page bases: the order, the value width and the sorted flag */
+	static constexpr size_t HEADER_SIZE = 8;
+
+	/** @brief Check if columns of `type` can be encoded */
+	static bool Supports(LogicalType type) noexcept {
+		return type == LogicalType::INT32 || type == LogicalType::INT64;
+	}
+
+	/** @brief Order (1 for deltas, 2 for delta-of-deltas) that packs the values of `vec` smaller */
+	static uint8_t BestOrder(const Vector &vec);
+
+	/** @brief Bytes Encode() writes for the values of `vec` at `order` */
+	static size_t EncodedSize(const Vector &vec, uint8_t order);
+
+	/** @brief Bytes Encode() writes for the values of `vec` */
+	static size_t EncodedSize(const Vector &vec) { return EncodedSize(vec, BestOrder(vec)); }
+
+	/**
+	 * @brief Encode the first `vec.Size()` values of `vec` at BestOrder()
+	 *
+	 * @param vec Values to encode, of a supported type
+	 * @param out Destination of EncodedSize() bytes, aligned to 8 bytes
+	 */
+	static void Encode(const Vector &vec, uint8_t *out);
+
+	/** @brief Check that `size` bytes are exactly an encoding of `count` values of `type` */
+	static bool CheckSize(const uint8_t *data, size_t size, LogicalType type, uint32_t count);
+
+	/** @brief Order of an encoded chunk */
+	static uint8_t Order(const uint8_t *data) noexcept { return data[0]; }
+
+	/** @brief Check if the values of an encoded chunk never decrease, NULL rows aside */
+	static bool Sorted(const uint8_t *data) noexcept { return data[2] != 0; }
+
+	/**
+	 * @brief Decode `count` values into rows [0, count) of `out`
+	 *
+	 * @param data Encoded values, aligned to 8 bytes
+	 * @param count Number of values
+	 * @param out Vector of the encoded type with a capacity of at least `count`
+	 */
+	static void Decode(const uint8_t *data, uint32_t count, Vector &out);
+
+	/**
+	 * @brief Decode rows [begin, end) only, starting at the page of `begin`
+	 *
+	 * @param data Encoded values, aligned to 8 bytes
+	 * @param count Number of values of the chunk
+	 * @param begin First row to decode
+	 * @param end One past the last row to decode, at most `count`
+	 * @param out Vector of the encoded type with a capacity of at least `end - begin`, row i
+	 * receives the value of row begin + i
+	 */
+	static void DecodeRange(const uint8_t *data, uint32_t count, uint32_t begin, uint32_t end,
+							Vector &out);
+
+	/**
+	 * @brief Select the rows that satisfy `predicate`. In a sorted chunk the page bases bound the
+	 * values of every page, and only pages that may hold a qualifying value are decoded.
+	 *
+	 * @param data Encoded values of `type`, aligned to 8 bytes
+	 * @param type Type of the column
+	 * @param count Number of values
+	 * @param predicate Predicate that Fits() `type`
+	 * @param nulls Null bitmap of the chunk (bit i set if row i is NULL), or null without nulls
+	 * @param sel Receives the qualifying rows in ascending order, a capacity of `count` suffices
+	 * @return idx_t Number of qualifying rows
+	 */
+	static idx_t Select(const uint8_t *data, LogicalType type, uint32_t count,
+						const ColumnPredicate &predicate, const uint8_t *nulls,
+						SelectionVector &sel);
+
+	/**
+	 * @brief Running sum in place: values[i] becomes values[0] + ... + values[i], wrapping on
+	 * overflow. The decoding kernel, exposed for benchmarks.
+	 */
+	static void PrefixSum(uint64_t *values, uint32_t count);
+};
+
+} // namespace electricdb
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/selection_vector.h"
+#include "electricdb/execution/vector/vector.h"
+#include "electricdb/storage/encoding/encoding.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace electricdb {
+
+/** @brief Codes of a dictionary chunk that satisfy a predicate */
+struct CodeSet {
+	/** @brief One flag per dictionary entry, 1 if the entry qualifies */
+	std::vector<uint8_t> qualifies;
+	/** @brief Number of qualifying entries */
+	uint32_t count = 0;
+
+	bool None() const noexcept { return count == 0; }
+
+	bool All() const noexcept { return count == qualifies.size(); }
+};
+
+/**
+ * @brief The dictionary of a chunk: its distinct non-null values, sorted. Built once per chunk,
+ * it both sizes and encodes the chunk (see DictionaryEncoding::BuildEntries()).
+ */
+struct DictionaryEntries {
+	LogicalType type = LogicalType::INVALID;
+	/** @brief Distinct values of the chunk, counting stops at MAX_ENTRIES + 1 */
+	uint32_t count = 0;
+	/** @brief The `count` entries as values of `type`, in the order of the encoded dictionary */
+	std::vector<uint8_t> values;
+};
+
+/**
+ * @brief Dictionary encoding for columns with few distinct values: every distinct non-null value
+ * is stored once, and each row as the code of its value, bit-packed with ForEncoding.
+ *
+ * The layout is the number of entries (4 bytes), the bytes per entry (1 byte, 3 reserved), the
+ * entries sorted by value and padded to 8 bytes, then the codes. As the entries are sorted, codes
+ * order like the values they stand for, so a range of values is a range of codes. Null rows get
+ * code 0, nulls are stored next to the encoded values.
+ *
+ * Filters run on the codes: a predicate is evaluated once per dictionary entry (QualifyingCodes()),
+ * then Select() compares the unpacked codes of every row against that set without looking up a
+ * single value.
+ */
+class DictionaryEncoding {
+  public:
+	/** @brief Distinct values a chunk may have, codes are at most 16 bits wide */
+	static constexpr uint32_t MAX_ENTRIES = 1 << 16;
+
+	/** @brief Bytes before the entries: their number and width */
+	static constexpr size_t HEADER_SIZE = 8;
+
+	/** @brief Check if columns of `type` can be encoded */
+	static bool Supports(LogicalType type) noexcept {
+		return type != LogicalType::STRING && type != LogicalType::INVALID;
+	}
+
+	/** @brief Distinct non-null values of `vec`, counting stops at MAX_ENTRIES + 1 */
+	static uint32_t DistinctCount(const Vector &vec);
+
+	/** @brief Check if `vec` has few enough distinct values to be encoded */
+	static bool CanEncode(const Vector &vec) {
+		return Supports(vec.Type()) && DistinctCount(vec) <= MAX_ENTRIES;
+	}
+
+	/** @brief Collect the dictionary of `vec`, once for CanEncode(), EncodedSize() and Encode() */
+	static DictionaryEntries BuildEntries(const Vector &vec);
+
+	/** @brief Check if the chunk of `entries` has few enough distinct values to be encoded */
+	static bool CanEncode(const DictionaryEntries &entries) noexcept {
+		return Supports(entries.type) && entries.count <= MAX_ENTRIES;
+	}
+
+	/** @brief Bytes Encode() writes for the values of `vec` */
+	static size_t EncodedSize(const Vector &vec);
+
+	/** @brief Bytes Encode() writes for `count` values of `type` with `entries` distinct ones */
+	static size_t EncodedSize(LogicalType type, uint32_t count, uint32_t entries);
+
+	/**
+	 * @brief Encode the first `vec.Size()` values of `vec`
+	 *
+	 * @param vec Values to encode, with at most MAX_ENTRIES distinct values
+	 * @param out Destination of EncodedSize() bytes, aligned to 8 bytes
+	 */
+	static void Encode(const Vector &vec, uint8_t *out);
+
+	/**
+	 * @brief Encode the values of `vec` with its dictionary, built before
+	 *
+	 * @param vec Values to encode
+	 * @param entries BuildEntries() of `vec`, which CanEncode()
+	 * @param out Destination of EncodedSize() bytes, aligned to 8 bytes
+	 */
+	static void Encode(const Vector &vec, const DictionaryEntries &entries, uint8_t *out);
+
+	/** @brief Check that `size` bytes are exactly an encoding of `count` values of `type` */
+	static bool CheckSize(const uint8_t *data, size_t size, LogicalType type, uint32_t count);
+
+	/** @brief Number of dictionary entries of an encoded chunk */
+	static uint32_t EntryCount(const uint8_t *data) noexcept;
+
+	/**
+	 * @brief Decode `count` values into rows [0, count) of `out`
+	 *
+	 * @param data Encoded values, aligned to 8 bytes
+	 * @param count Number of values
+	 * @param out Vector of the encoded type with a capacity of at least `count`
+	 */
+	static void Decode(const uint8_t *data, uint32_t count, Vector &out);
+
+	/**
+	 * @brief Decode the entries and the code of every row instead of the values
+	 *
+	 * @param data Encoded values, aligned to 8 bytes
+	 * @param count Number of values
+	 * @param entries Vector of the encoded type with a capacity of at least EntryCount(),
+	 * receives the entries
+	 * @param codes Receives `count` codes
+	 */
+	static void DecodeCodes(const uint8_t *data, uint32_t count, Vector &entries, sel_t *codes);
+
+	/**
+	 * @brief Evaluate a predicate on every dictionary entry
+	 *
+	 * @param data Encoded values of `type`, aligned to 8 bytes
+	 * @param type Type of the column
+	 * @param predicate Predicate that Fits() `type`
+	 */
+	static CodeSet QualifyingCodes(const uint8_t *data, LogicalType type,
+								   const ColumnPredicate &predicate);
+
+	/**
+	 * @brief Select the rows whose code qualifies, working on the packed codes a block at a time
+	 *
+	 * @param data Encoded values, aligned to 8 bytes
+	 * @param count Number of values
+	 * @param codes QualifyingCodes() of the chunk
+	 * @param nulls Null bitmap of the chunk (bit i set if row i is NULL), or null without nulls
+	 * @param sel Receives the qualifying rows in ascending order, a capacity of `count` suffices
+	 * @return idx_t Number of qualifying rows
+	 */
+	static idx_t Select(const uint8_t *data, uint32_t count, const CodeSet &codes,
+						const uint8_t *nulls, SelectionVector &sel);
+};
+
+/**
+ * @brief A dictionary chunk decoded without looking up its values: the entries and the code of
+ * every row, which a dictionary vector (see Vector::ReferenceDictionary()) refers to
+ */
+struct DictionaryChunk {
+	/**
+	 * @brief Construct a new DictionaryChunk
+	 *
+	 * @param type Type of the column
+	 * @param rows Rows of the largest chunk it has to hold
+	 * @param arena Backs the entries and codes
+	 */
+	DictionaryChunk(LogicalType type, uint32_t rows, Arena &arena)
+		: entries(type, std::max(std::min(rows, DictionaryEncoding::MAX_ENTRIES), 1U), arena),
+		  codes(arena, std::max(rows, 1U)) {}
+
+	Vector entries;
+	SelectionVector codes;
+};
+
+} // namespace electricdb
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace electricdb {
+
+/** @brief How the values of a stored column chunk are laid out, recorded per chunk */
+enum class EncodingType : uint8_t {
+	/** @brief Fixed-width values exactly as in a Vector, usable in place */
+	PLAIN,
+	/** @brief Integers as bit-packed offsets from the chunk minimum, see ForEncoding */
+	FOR,
+	/** @brief The distinct values once, then a bit-packed code per row, see DictionaryEncoding */
+	DICTIONARY,
+	/** @brief Each run of equal values once, with the row it ends at, see RleEncoding */
+	RLE,
+	/** @brief Integers as bit-packed differences (or delta-of-deltas), see DeltaEncoding */
+	DELTA
+};
+
+/** @brief Name of an encoding as shown in diagnostics */
+const char *EncodingTypeName(EncodingType type);
+
+/** @brief Check if `encoding` can store columns of `type` at all */
+bool EncodingSupports(EncodingType encoding, LogicalType type) noexcept;
+
+/**
+ * @brief Check if `encoding` can store the values of `vec`. PLAIN always can, DICTIONARY only up
+ * to DictionaryEncoding::MAX_ENTRIES distinct values.
+ */
+bool CanEncode(EncodingType encoding, const Vector &vec);
+
+/** @brief Bytes EncodeValues() writes for the values of `vec`, which CanEncode() */
+size_t EncodedSize(EncodingType encoding, const Vector &vec);
+
+/**
+ * @brief Encode the first `vec.Size()` values of `vec`
+ *
+ * @param encoding Encoding that CanEncode() the values
+ * @param vec Values to encode
+ * @param out Destination of EncodedSize() bytes, aligned to 8 bytes
+ */
+void EncodeValues(EncodingType encoding, const Vector &vec, uint8_t *out);
+
+/**
+ * @brief Check that `size` bytes are exactly the encoding of `count` values of `type`, going by
+ * the headers of the encoded data. Run before decoding data that came from disk.
+ */
+bool CheckEncodedSize(EncodingType encoding, LogicalType type, const uint8_t *data, size_t size,
+					  uint32_t count);
+
+/**
+ * @brief Decode `count` values into rows [0, count) of `out`
+ *
+ * @param encoding Encoding of the data
+ * @param data Encoded values, aligned to 8 bytes
+ * @param count Number of values
+ * @param out Vector of the encoded type with a capacity of at least `count`
+ */
+void DecodeValues(EncodingType encoding, const uint8_t *data, uint32_t count, Vector &out);
+
+/**
+ * @brief A filter on one stored column that storage evaluates itself, against zone maps before
+ * a chunk is read and on the codes of dictionary chunks instead of their values. NULL rows never
+ * qualify.
+ */
+struct ColumnPredicate {
+	enum class Kind : uint8_t {
+		/** @brief value == values[0] */
+		EQUAL,
+		/** @brief value is one of `values` */
+		IN,
+		/** @brief values[0] <= value <= values[1], a NULL bound leaves that side open */
+		RANGE
+	};
+
+	Kind kind = Kind::EQUAL;
+	std::vector<Value> values;
+
+	static ColumnPredicate Equal(Value value) { return {Kind::EQUAL, {value}}; }
+
+	static ColumnPredicate In(std::vector<Value> values) { return {Kind::IN, std::move(values)}; }
+
+	static ColumnPredicate Range(Value lower, Value upper) {
+		return {Kind::RANGE, {lower, upper}};
+	}
+
+	/** @brief Check if the predicate applies to columns of `type`, NULL values fit any type */
+	bool Fits(LogicalType type) const noexcept {
+		const size_t arity = kind == Kind::EQUAL ? 1 : kind == Kind::RANGE ? 2 : values.size();
+		return values.size() == arity &&
+			   std::all_of(values.begin(), values.end(), [type](const Value &value) {
+				   return value.IsNull() || value.Type() == type;
+			   });
+	}
+
+	/** @brief Check if a non-null value qualifies */
+	template <typename T>
+	bool Matches(T value) const {
+		switch (kind) {
+		case Kind::EQUAL:
+			return !values[0].IsNull() && value == values[0].Get<T>();
+		case Kind::IN:
+			return std::any_of(values.begin(), values.end(), [value](const Value &v) {
+				return !v.IsNull() && value == v.Get<T>();
+			});
+		case Kind::RANGE:
+			return (values[0].IsNull() || value >= values[0].Get<T>()) &&
+				   (values[1].IsNull() || value <= values[1].Get<T>());
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Check if some value in [min, max] may qualify, false if `min` is NULL (no values).
+	 * Bounds are never NaN: zone maps keep NaN out of them (see ZoneMap::has_nan).
+	 */
+	bool MayMatch(const Value &min, const Value &max) const;
+};
+
+} // namespace electricdb
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/selection_vector.h"
+#include "electricdb/execution/vector/vector.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace electricdb {
+
+/**
+ * @brief Frame-of-reference encoding of INT32 and INT64 columns: the minimum of the chunk (the
+ * reference), then every value's offset from it bit-packed at the smallest width that fits the
+ * largest offset, anywhere from 0 bits (all values equal) to the full width of the type.
+ *
+ * Offsets are packed in blocks of BLOCK_SIZE values laid out in interleaved lanes: a word of the
+ * type's width holds bits of one lane, and rows of consecutive values are spread over the lanes.
+ * Unpacking a row is then the same shift and mask on every lane, which the kernels do with SIMD
+ * instructions (AVX2 where the CPU has it) straight into the output vector.
+ *
+ * Null rows are packed as the reference, nulls are stored next to the encoded values.
+ */
+class ForEncoding {
+  public:
+	/** @brief Values per bit-packed block, the last block of a chunk is padded */
+	static constexpr uint32_t BLOCK_SIZE = 1024;
+
+	/** @brief Bytes before the packed blocks: the reference and the bit width */
+	static constexpr size_t HEADER_SIZE = 16;
+
+	/** @brief Check if columns of `type` can be encoded */
+	static bool Supports(LogicalType type) noexcept {
+		return type == LogicalType::INT32 || type == LogicalType::INT64;
+	}
+
+	/** @brief Bits per packed value for the non-null values of `vec` */
+	static uint8_t BitWidth(const Vector &vec);
+
+	/** @brief Bytes Encode() writes for `count` values packed at `width` bits */
+	static size_t EncodedSize(uint32_t count, uint8_t width) noexcept;
+
+	/** @brief Bytes Encode() writes for the values of `vec` */
+	static size_t EncodedSize(const Vector &vec) { return EncodedSize(vec.Size(), BitWidth(vec)); }
+
+	/**
+	 * @brief Encode the first `vec.Size()` values of `vec`
+	 *
+	 * @param vec Values to encode, of a supported type
+	 * @param out Destination of EncodedSize() bytes, aligned to 8 bytes
+	 */
+	static void Encode(const Vector &vec, uint8_t *out);
+
+	/** @brief Check that `size` bytes are exactly an encoding of `count` values of `type` */
+	static bool CheckSize(const uint8_t *data, size_t size, LogicalType type, uint32_t count);
+
+	/**
+	 * @brief Decode `count` values into rows [0, count) of `out`
+	 *
+	 * @param data Encoded values, aligned to 8 bytes
+	 * @param count Number of values
+	 * @param out Vector of the encoded type with a capacity of at least `count`
+	 */
+	static void Decode(const uint8_t *data, uint32_t count, Vector &out);
+
+	/**
+	 * @brief Decode only some rows, without unpacking the others
+	 *
+	 * @param data Encoded values, aligned to 8 bytes
+	 * @param sel Rows to decode
+	 * @param count Number of entries of `sel`
+	 * @param out Vector of the encoded type, row i receives the value of row sel.Get(i)
+	 */
+	static void DecodeSelected(const uint8_t *data, const SelectionVector &sel, idx_t count,
+							   Vector &out);
+
+	/**
+	 * @brief Decode one block of BLOCK_SIZE values, the padding of a partial last block included.
+	 * Lets callers work through a chunk a block at a time without a vector for all of it.
+	 *
+	 * @param data Encoded INT32 or INT64 values (matching `out`), aligned to 8 bytes
+	 * @param block Index of the block
+	 * @param out Receives BLOCK_SIZE values
+	 */
+	static void DecodeBlock(const uint8_t *data, uint32_t block, int32_t *out);
+
+	static void DecodeBlock(const uint8_t *data, uint32_t block, int64_t *out);
+};
+
+} // namespace electricdb
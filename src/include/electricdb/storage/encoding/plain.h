@@ -0,0 +1,39 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/vector.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace electricdb {
+
+/**
+ * @brief Plain encoding: the values back to back in their in-memory representation.
+ *
+ * Null rows keep whatever their slot holds, nulls are stored next to the encoded values.
+ */
+class PlainEncoding {
+  public:
+	/** @brief Bytes Encode() writes for `count` values of `type` */
+	static size_t EncodedSize(LogicalType type, uint32_t count);
+
+	/**
+	 * @brief Encode the first `vec.Size()` values of `vec`
+	 *
+	 * @param vec Values to encode
+	 * @param out Destination of EncodedSize() bytes
+	 */
+	static void Encode(const Vector &vec, uint8_t *out);
+
+	/**
+	 * @brief Decode `count` values into rows [0, count) of `out`
+	 *
+	 * @param data Encoded values
+	 * @param count Number of values
+	 * @param out Vector of the encoded type with a capacity of at least `count`
+	 */
+	static void Decode(const uint8_t *data, uint32_t count, Vector &out);
+};
+
+} // namespace electricdb
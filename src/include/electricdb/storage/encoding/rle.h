@@ -0,0 +1,127 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/selection_vector.h"
+#include "electricdb/execution/vector/vector.h"
+#include "electricdb/storage/encoding/encoding.h"
+#include "electricdb/util/arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace electricdb {
+
+/**
+ * @brief Run-length encoding for sorted and slowly changing columns: every run of equal
+ * consecutive values is stored once, with the row at which it ends.
+ *
+ * The layout is the number of runs (4 bytes), the bytes per value (1 byte, 3 reserved), the run
+ * values padded to 8 bytes, then the end of every run as a 4 byte row number. Run ends ascend, so
+ * the run of any row is found with a binary search and a scan can start in the middle of a chunk.
+ *
+ * Values are compared by their bits, so 0.0 and -0.0 are separate runs. A NULL row never shares a
+ * run with a non-null one and null runs hold a zero value; nulls are stored next to the encoded
+ * values. Filters and aggregates can therefore work on whole runs, see Select() and
+ * AggregateFunction::UpdateRuns().
+ */
+class RleEncoding {
+  public:
+	/** @brief Bytes before the run values: their number and width */
+	static constexpr size_t HEADER_SIZE = 8;
+
+	/** @brief Check if columns of `type` can be encoded */
+	static bool Supports(LogicalType type) noexcept {
+		return type != LogicalType::STRING && type != LogicalType::INVALID;
+	}
+
+	/** @brief Runs of the first `vec.Size()` values of `vec` */
+	static uint32_t RunCount(const Vector &vec);
+
+	/** @brief Number of runs of an encoded chunk */
+	static uint32_t RunCount(const uint8_t *data) noexcept;
+
+	/** @brief Bytes Encode() writes for `runs` runs of values of `type` */
+	static size_t EncodedSize(LogicalType type, uint32_t runs) noexcept;
+
+	/** @brief Bytes Encode() writes for the values of `vec` */
+	static size_t EncodedSize(const Vector &vec) {
+		return EncodedSize(vec.Type(), RunCount(vec));
+	}
+
+	/**
+	 * @brief Encode the first `vec.Size()` values of `vec`
+	 *
+	 * @param vec Values to encode, of a supported type
+	 * @param out Destination of EncodedSize() bytes, aligned to 8 bytes
+	 */
+	static void Encode(const Vector &vec, uint8_t *out);
+
+	/**
+	 * @brief Check that `size` bytes are exactly an encoding of `count` values of `type`, with
+	 * non-empty runs that end at `count`
+	 */
+	static bool CheckSize(const uint8_t *data, size_t size, LogicalType type, uint32_t count);
+
+	/**
+	 * @brief Decode `count` values into rows [0, count) of `out`
+	 *
+	 * @param data Encoded values, aligned to 8 bytes
+	 * @param count Number of values
+	 * @param out Vector of the encoded type with a capacity of at least `count`
+	 */
+	static void Decode(const uint8_t *data, uint32_t count, Vector &out);
+
+	/**
+	 * @brief Decode the runs instead of the values
+	 *
+	 * @param data Encoded values, aligned to 8 bytes
+	 * @param values Vector of the encoded type with a capacity of at least RunCount(), receives
+	 * the value of every run
+	 * @param lengths Receives the number of rows of every run
+	 */
+	static void DecodeRuns(const uint8_t *data, Vector &values, uint32_t *lengths);
+
+	/** @brief Run that row `row` belongs to, found by a binary search over the run ends */
+	static uint32_t FindRun(const uint8_t *data, uint32_t row) noexcept;
+
+	/**
+	 * @brief Select the rows of the runs that satisfy `predicate`. The predicate is evaluated
+	 * once per run and every row of a qualifying run is selected without decoding it.
+	 *
+	 * @param data Encoded values of `type`, aligned to 8 bytes
+	 * @param type Type of the column
+	 * @param predicate Predicate that Fits() `type`
+	 * @param nulls Null bitmap of the chunk (bit i set if row i is NULL), or null without nulls
+	 * @param sel Receives the qualifying rows in ascending order, a capacity of the chunk's row
+	 * count suffices
+	 * @return idx_t Number of qualifying rows
+	 */
+	static idx_t Select(const uint8_t *data, LogicalType type, const ColumnPredicate &predicate,
+						const uint8_t *nulls, SelectionVector &sel);
+};
+
+/**
+ * @brief A column chunk as (value, run length) pairs, which aggregates fold without expanding
+ * the runs (see AggregateFunction::UpdateRuns()). Null runs are NULL in `values`.
+ */
+struct RunChunk {
+	/**
+	 * @brief Construct a new RunChunk
+	 *
+	 * @param type Type of the column
+	 * @param rows Rows of the largest chunk it has to hold, a chunk has at most one run per row
+	 * @param arena Backs the values and lengths
+	 */
+	RunChunk(LogicalType type, uint32_t rows, Arena &arena)
+		: values(type, std::max(rows, 1U), arena),
+		  lengths(arena.Allocate<uint32_t>(std::max(rows, 1U))) {}
+
+	/** @brief Number of runs */
+	uint32_t Size() const noexcept { return values.Size(); }
+
+	Vector values;
+	uint32_t *lengths;
+};
+
+} // namespace electricdb
@@ -0,0 +1,417 @@
+#pragma once
+
+#include "electricdb/common/constants.h"
+#include "electricdb/common/types.h"
+#include "electricdb/execution/vector/selection_vector.h"
+#include "electricdb/execution/vector/vector.h"
+#include "electricdb/io/file.h"
+#include "electricdb/io/prefetch.h"
+#include "electricdb/storage/column/column_writer.h"
+#include "electricdb/storage/encoding/dictionary.h"
+#include "electricdb/storage/encoding/encoding.h"
+#include "electricdb/storage/encoding/rle.h"
+#include "electricdb/storage/format/file_header.h"
+#include "electricdb/storage/format/metadata.h"
+#include "electricdb/util/arena.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief Writes a column file: rows are buffered into row groups, each row group is stored as one
+ * page-aligned chunk per column, and Finish() appends the footer indexing every chunk.
+ */
+class ColumnFileWriter {
+  public:
+	/**
+	 * @brief Create (or truncate) the column file at `path`
+	 *
+	 * @param path Path of the file
+	 * @param schema Columns of the file, fixed-width types only
+	 * @param row_group_size Rows per row group, the last one may be smaller
+	 */
+	ColumnFileWriter(const std::string &path, std::vector<ColumnSchema> schema,
+					 uint32_t row_group_size = DEFAULT_ROW_GROUP_SIZE);
+
+	/** @brief Disable copy constructor */
+	ColumnFileWriter(const ColumnFileWriter &) = delete;
+
+	/** @brief Disable copy assignment */
+	ColumnFileWriter &operator=(const ColumnFileWriter &) = delete;
+
+	/**
+	 * @brief Store the chunks of a column with `encoding` instead of PLAIN. Chunks the encoding
+	 * cannot hold (e.g. too many distinct values for a dictionary) are stored PLAIN.
+	 *
+	 * @param column Schema position of the column
+	 * @param encoding Encoding that supports the column's type
+	 */
+	void SetEncoding(idx_t column, EncodingType encoding);
+
+	/**
+	 * @brief Pick the encoding of every chunk of a column with a ColumnWriter, from a sample of
+	 * the chunk's values. The choice is recorded in the chunk's metadata. If the sample hid that
+	 * the chunk has too many distinct values for a dictionary, the next cheapest estimate wins.
+	 *
+	 * @param column Schema position of the column
+	 * @param policy How the ColumnWriter weighs size against decode time
+	 */
+	void SetAdaptiveEncoding(idx_t column, EncodingPolicy policy = {});
+
+	/**
+	 * @brief Append rows, flushing every row group that fills up
+	 *
+	 * @param columns One vector per schema column, all of the same size
+	 */
+	void Append(const std::vector<Vector> &columns);
+
+	/** @brief Flush the last row group and write the footer. The file is readable afterwards. */
+	void Finish();
+
+	const FileMetadata &Metadata() const noexcept { return metadata_; }
+
+  private:
+	/** @brief Write the buffered rows as one row group */
+	void FlushRowGroup();
+
+	/**
+	 * @brief Encoding of the buffered chunk of column `c`: the cheapest estimate of its
+	 * ColumnWriter, or the requested one, that can hold every value, otherwise PLAIN
+	 *
+	 * @param dictionary Receives the dictionary of the chunk if it is stored as one
+	 */
+	EncodingType ChunkEncoding(size_t c, DictionaryEntries &dictionary) const;
+
+	File file_;
+	FileMetadata metadata_;
+	uint32_t row_group_size_;
+	Arena arena_;
+	/** @brief Rows of the row group being filled, one vector per column */
+	std::vector<Vector> buffer_;
+	/** @brief Encoding requested per column */
+	std::vector<EncodingType> encodings_;
+	/** @brief Writer choosing the encoding per chunk, for columns set to adaptive encoding */
+	std::vector<std::optional<ColumnWriter>> writers_;
+	uint32_t buffered_ = 0;
+	/** @brief Page-aligned offset of the next row group */
+	uint64_t offset_ = COLUMN_FILE_PAGE_SIZE;
+	/** @brief The encoded row group, written with a single call */
+	std::vector<uint8_t> scratch_;
+	bool finished_ = false;
+};
+
+/** @brief One contiguous byte range of a row group, covering the chunks of some columns */
+struct ChunkRead {
+	uint64_t offset = 0;
+	uint64_t size = 0;
+	/** @brief Positions in the requested column list of the chunks inside the range */
+	std::vector<size_t> columns;
+};
+
+/**
+ * @brief Reads a finished column file.
+ *
+ * Opening reads the header, trailer and footer. Afterwards every read fetches only the byte
+ * ranges of the requested chunks, so the I/O of a scan scales with the columns it touches rather
+ * than the width of the table. Reads use positional I/O, a reader can be shared by threads.
+ *
+ * Where the filesystem supports it the file is also opened for direct I/O, so large scans can
+ * stream through their chunks without evicting the page cache that smaller queries rely on.
+ */
+class ColumnFileReader {
+  public:
+	/** @brief Open the column file at `path`, throws if it is not a valid, finished file */
+	explicit ColumnFileReader(const std::string &path);
+
+	/** @brief Disable copy constructor */
+	ColumnFileReader(const ColumnFileReader &) = delete;
+
+	/** @brief Disable copy assignment */
+	ColumnFileReader &operator=(const ColumnFileReader &) = delete;
+
+	const FileMetadata &Metadata() const noexcept { return metadata_; }
+
+	size_t RowGroupCount() const noexcept { return metadata_.row_groups.size(); }
+
+	const std::string &Path() const noexcept { return file_.Path(); }
+
+	/** @brief Check if direct reads bypass the page cache, otherwise they are buffered reads */
+	bool DirectIO() const noexcept { return direct_.IsOpen(); }
+
+	/**
+	 * @brief Read some columns of a row group
+	 *
+	 * Chunks that are adjacent in the file are fetched with one read.
+	 *
+	 * @param row_group Row group to read
+	 * @param column_ids Schema positions of the columns to read
+	 * @param out One vector per entry of `column_ids`, of the column's type and with a capacity
+	 * of at least the row count of the row group
+	 * @param dictionaries One per entry of `column_ids` to keep dictionary chunks encoded in, see
+	 * DecodeColumnChunk(), or null to expand every chunk
+	 * @param runs One per entry of `column_ids` to keep RLE chunks as runs in, see
+	 * DecodeColumnChunk(), or null to expand every chunk
+	 */
+	void ReadColumns(idx_t row_group, const std::vector<idx_t> &column_ids,
+					 std::vector<Vector> &out,
+					 std::vector<DictionaryChunk> *dictionaries = nullptr,
+					 std::vector<RunChunk> *runs = nullptr) const;
+
+	/**
+	 * @brief Read some columns of a row group, as above, fetching into aligned buffers
+	 *
+	 * @param buffers Backs the fetched ranges, reset it once the row group was read
+	 * @param direct Bypass the page cache if DirectIO()
+	 */
+	void ReadColumns(idx_t row_group, const std::vector<idx_t> &column_ids,
+					 std::vector<Vector> &out, Arena &buffers, bool direct,
+					 std::vector<DictionaryChunk> *dictionaries = nullptr,
+					 std::vector<RunChunk> *runs = nullptr) const;
+
+	/**
+	 * @brief Byte ranges that hold some columns of a row group, in file order. Chunks that are
+	 * adjacent in the file share a range.
+	 */
+	std::vector<ChunkRead> PlanReads(idx_t row_group, const std::vector<idx_t> &column_ids) const;
+
+	/**
+	 * @brief Verify and decode the chunks of a fetched range
+	 *
+	 * @param row_group Row group the range was planned for
+	 * @param column_ids Columns the range was planned for
+	 * @param read The range
+	 * @param data The read.size bytes of the range
+	 * @param out As for ReadColumns(), only the vectors of read.columns are written
+	 * @param dictionaries As for ReadColumns()
+	 * @param runs As for ReadColumns()
+	 */
+	void DecodeRead(idx_t row_group, const std::vector<idx_t> &column_ids, const ChunkRead &read,
+					const uint8_t *data, std::vector<Vector> &out,
+					std::vector<DictionaryChunk> *dictionaries = nullptr,
+					std::vector<RunChunk> *runs = nullptr) const;
+
+	/**
+	 * @brief Select the rows of a chunk that satisfy `predicate`. Chunks whose zone map rules the
+	 * predicate out are not read; dictionary chunks are filtered on their codes, RLE chunks a run
+	 * at a time and sorted delta chunks only decode the pages that may qualify.
+	 *
+	 * @param row_group Row group of the chunk
+	 * @param column Schema position of the chunk's column
+	 * @param predicate Predicate that Fits() the column's type
+	 * @param sel Receives the qualifying rows in ascending order, with a capacity of at least the
+	 * row count of the row group
+	 * @return idx_t Number of qualifying rows
+	 */
+	idx_t SelectRows(idx_t row_group, idx_t column, const ColumnPredicate &predicate,
+					 SelectionVector &sel) const;
+
+	/**
+	 * @brief Read one chunk as runs, see DecodeColumnRuns()
+	 *
+	 * @param row_group Row group of the chunk
+	 * @param column Schema position of the chunk's column
+	 * @param runs Of the column's type, holds a chunk of at least the row count of the row group
+	 */
+	void ReadRuns(idx_t row_group, idx_t column, RunChunk &runs) const;
+
+	/** @brief Bytes of a chunk decoded by DecodeChunk() */
+	uint64_t DecodedChunkSize(idx_t row_group, idx_t column) const;
+
+	/**
+	 * @brief Fetch, verify and decode one chunk into the layout of a PLAIN chunk: the null bitmap
+	 * if the chunk has nulls (see ColumnChunkMeta::NullBitmapSize()), then the values. This is
+	 * the form in which a BufferManager caches decoded chunks. PLAIN chunks are fetched straight
+	 * into `out`, others are fetched aside and decoded into it.
+	 *
+	 * @param row_group Row group of the chunk
+	 * @param column Schema position of the chunk's column
+	 * @param out Receives DecodedChunkSize() bytes. Aligned to DIRECT_IO_ALIGNMENT and with room
+	 * for the size rounded up to it if `direct`.
+	 * @param direct Bypass the page cache if DirectIO()
+	 */
+	void DecodeChunk(idx_t row_group, idx_t column, uint8_t *out, bool direct = false) const;
+
+	/**
+	 * @brief Fetch the bytes of a planned range
+	 *
+	 * @param read The range
+	 * @param buffer Receives the range. Holds read.size bytes, or DirectReadSize(read) bytes
+	 * aligned to DIRECT_IO_ALIGNMENT if `direct`.
+	 * @param direct Bypass the page cache if DirectIO()
+	 */
+	void FetchRead(const ChunkRead &read, uint8_t *buffer, bool direct) const;
+
+	/**
+	 * @brief Bytes a direct fetch of `read` transfers. Ranges start on a page, only their size is
+	 * rounded up; the padding after the last chunk keeps the extra bytes inside the file.
+	 */
+	static uint64_t DirectReadSize(const ChunkRead &read) noexcept {
+		return (read.size + DIRECT_IO_ALIGNMENT - 1) & ~uint64_t{DIRECT_IO_ALIGNMENT - 1};
+	}
+
+	/** @brief The buffered file, or the direct one if `direct` and DirectIO() */
+	const File &GetFile(bool direct = false) const noexcept {
+		return direct && DirectIO() ? direct_ : file_;
+	}
+
+	/** @brief Bytes fetched from the file since it was opened, footer included */
+	uint64_t BytesRead() const noexcept { return bytes_read_.load(std::memory_order_relaxed); }
+
+	/** @brief Account bytes fetched without ReadColumns(), e.g. by a ChunkPrefetcher */
+	void AddBytesRead(uint64_t bytes) const noexcept {
+		bytes_read_.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+  private:
+	File file_;
+	/** @brief Second descriptor opened with FILE_DIRECT, closed if direct I/O is unsupported */
+	File direct_;
+	FileMetadata metadata_;
+	mutable std::atomic<uint64_t> bytes_read_{0};
+};
+
+/** @brief Row groups a ChunkPrefetcher reads ahead by default */
+constexpr uint32_t DEFAULT_PREFETCH_DEPTH = 4;
+
+/** @brief Bytes a ChunkPrefetcher keeps in flight by default */
+constexpr uint64_t DEFAULT_PREFETCH_BYTES = uint64_t{64} << 20;
+
+/**
+ * @brief Reads some columns of a column file ahead of a scan that moves through the row groups
+ * in roughly ascending order.
+ *
+ * Read() queues the reads of the next `depth` row groups on an AsyncReader before it waits for the
+ * requested one, so the I/O of upcoming row groups overlaps with decoding and processing the
+ * current one. Row groups that are fetched or being fetched but not yet consumed count against
+ * `max_bytes`, which bounds the memory and I/O a scan holds in flight. Thread safe.
+ */
+class ChunkPrefetcher {
+  public:
+	/**
+	 * @brief Construct a new ChunkPrefetcher
+	 *
+	 * @param reader Open column file. Not owned, must outlive the prefetcher.
+	 * @param column_ids Schema positions of the columns to read
+	 * @param io Backend for the reads. Not owned, must outlive the prefetcher.
+	 * @param depth Row groups to read ahead of the latest requested one
+	 * @param max_bytes Bound of the bytes fetched ahead, the requested row group is always read
+	 * @param direct Read into aligned buffers, bypassing the page cache if the reader's DirectIO()
+	 */
+	ChunkPrefetcher(const ColumnFileReader &reader, std::vector<idx_t> column_ids, AsyncReader &io,
+					uint32_t depth = DEFAULT_PREFETCH_DEPTH,
+					uint64_t max_bytes = DEFAULT_PREFETCH_BYTES, bool direct = false);
+
+	/** @brief Waits for the reads still in flight */
+	~ChunkPrefetcher();
+
+	/** @brief Disable copy constructor */
+	ChunkPrefetcher(const ChunkPrefetcher &) = delete;
+
+	/** @brief Disable copy assignment */
+	ChunkPrefetcher &operator=(const ChunkPrefetcher &) = delete;
+
+	/**
+	 * @brief Read the columns of a row group, as ColumnFileReader::ReadColumns()
+	 *
+	 * A prefetched row group is handed out once; reading it again fetches it again.
+	 */
+	void Read(idx_t row_group, std::vector<Vector> &out);
+
+	/** @brief Bytes fetched or being fetched and not yet consumed */
+	uint64_t InFlightBytes() const;
+
+  private:
+	/** @brief The reads of one row group */
+	struct Fetch {
+		std::vector<ChunkRead> reads;
+		/** @brief Backs `buffers`, aligned to DIRECT_IO_ALIGNMENT */
+		Arena arena;
+		std::vector<uint8_t *> buffers;
+		std::vector<uint64_t> tickets;
+		uint64_t bytes = 0;
+	};
+
+	/** @brief Submit the reads of `fetch`, lock_ held */
+	void Start(Fetch &fetch);
+
+	/** @brief Wait for every read of `fetch`, rethrowing the first failure after all finished */
+	void Finish(Fetch &fetch);
+
+	const ColumnFileReader &reader_;
+	std::vector<idx_t> column_ids_;
+	AsyncReader &io_;
+	uint32_t depth_;
+	uint64_t max_bytes_;
+	bool direct_;
+
+	mutable std::mutex lock_;
+	/** @brief Row groups read ahead and not yet consumed */
+	std::unordered_map<idx_t, std::unique_ptr<Fetch>> pending_;
+	/** @brief Next row group to read ahead */
+	idx_t next_ = 0;
+	uint64_t in_flight_ = 0;
+};
+
+/**
+ * @brief Verify the bytes of a column chunk: its checksum, and that its encoded values have
+ * the size their encoding implies
+ *
+ * @param chunk Footer entry of the chunk
+ * @param row_count Rows of the chunk's row group
+ * @param type Type of the chunk's column
+ * @param data The chunk.size bytes of the chunk
+ */
+void VerifyColumnChunk(const ColumnChunkMeta &chunk, uint32_t row_count, LogicalType type,
+					   const uint8_t *data);
+
+/**
+ * @brief Verify and decode the bytes of a column chunk
+ *
+ * @param chunk Footer entry of the chunk
+ * @param row_count Rows of the chunk's row group
+ * @param data The chunk.size bytes of the chunk
+ * @param out Vector of the column's type with a capacity of at least `row_count`
+ */
+void DecodeColumnChunk(const ColumnChunkMeta &chunk, uint32_t row_count, const uint8_t *data,
+					   Vector &out);
+
+/**
+ * @brief Verify and decode the bytes of a column chunk as above, but leave a dictionary chunk
+ * encoded: its entries and codes go to `dictionary` and `out` becomes a dictionary vector over
+ * them, with the null flags of the chunk
+ *
+ * @param dictionary Holds a chunk of at least `row_count` rows
+ */
+void DecodeColumnChunk(const ColumnChunkMeta &chunk, uint32_t row_count, const uint8_t *data,
+					   Vector &out, DictionaryChunk &dictionary);
+
+/**
+ * @brief Verify and decode the bytes of a column chunk as above, but leave an RLE chunk encoded:
+ * its runs go to `runs` (see DecodeColumnRuns()) and `out` becomes a run vector over them
+ *
+ * @param runs Holds a chunk of at least `row_count` rows
+ */
+void DecodeColumnChunk(const ColumnChunkMeta &chunk, uint32_t row_count, const uint8_t *data,
+					   Vector &out, RunChunk &runs);
+
+/**
+ * @brief Verify the bytes of a column chunk and decode them as runs. An RLE chunk hands out its
+ * runs as stored, a chunk of any other encoding is decoded into runs of one row.
+ *
+ * @param chunk Footer entry of the chunk
+ * @param row_count Rows of the chunk's row group
+ * @param data The chunk.size bytes of the chunk
+ * @param runs Of the column's type, holds a chunk of at least `row_count` rows
+ */
+void DecodeColumnRuns(const ColumnChunkMeta &chunk, uint32_t row_count, const uint8_t *data,
+					  RunChunk &runs);
+
+} // namespace electricdb
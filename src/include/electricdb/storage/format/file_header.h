@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace electricdb {
+
+/** @brief "EDBCOLF1" in file byte order, at the start and at the end of every column file */
+constexpr uint64_t COLUMN_FILE_MAGIC = 0x31464c4f43424445ULL;
+
+/** @brief Version 2 records whether a chunk holds NaN next to its min/max */
+constexpr uint32_t COLUMN_FILE_VERSION = 2;
+
+/**
+ * @brief Alignment of column chunks in the file. Every chunk starts on a page boundary, so a chunk
+ * can be mapped or read with O_DIRECT on its own.
+ */
+constexpr uint64_t COLUMN_FILE_PAGE_SIZE = 4096;
+
+/** @brief Round `offset` up to the next page boundary */
+constexpr uint64_t AlignToPage(uint64_t offset) {
+	return (offset + COLUMN_FILE_PAGE_SIZE - 1) & ~(COLUMN_FILE_PAGE_SIZE - 1);
+}
+
+/**
+ * @brief First bytes of a column file, the rest of the first page is zero.
+ *
+ * Layout of a column file:
+ *
+ *   [header page] [row group 0: chunk of column 0, chunk of column 1, ...] [row group 1] ...
+ *   [footer: FileMetadata] [FileTrailer]
+ *
+ * Chunks start on page boundaries. All integers are little-endian.
+ */
+struct FileHeader {
+	static constexpr size_t SIZE = 16;
+
+	uint64_t magic = COLUMN_FILE_MAGIC;
+	uint32_t version = COLUMN_FILE_VERSION;
+	uint32_t page_size = COLUMN_FILE_PAGE_SIZE;
+
+	void Serialize(uint8_t *out) const;
+
+	/** @brief Parse and validate SIZE bytes, throws if they are not a supported header */
+	static FileHeader Deserialize(const uint8_t *data);
+};
+
+/**
+ * @brief Last bytes of a column file, locating the footer. Readers start here, so a file is only
+ * valid once the writer has finished it.
+ */
+struct FileTrailer {
+	static constexpr size_t SIZE = 32;
+
+	uint64_t footer_offset = 0;
+	uint64_t footer_size = 0;
+	/** @brief Hash::crc32c of the footer */
+	uint32_t footer_checksum = 0;
+	uint32_t version = COLUMN_FILE_VERSION;
+	uint64_t magic = COLUMN_FILE_MAGIC;
+
+	void Serialize(uint8_t *out) const;
+
+	/** @brief Parse and validate SIZE bytes, throws if they are not a supported trailer */
+	static FileTrailer Deserialize(const uint8_t *data);
+};
+
+} // namespace electricdb
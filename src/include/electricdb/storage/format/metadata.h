@@ -0,0 +1,69 @@
+#pragma once
+
+#include "electricdb/common/types.h"
+#include "electricdb/storage/column/zone_map.h"
+#include "electricdb/storage/encoding/encoding.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace electricdb {
+
+/** @brief Name and type of a stored column */
+struct ColumnSchema {
+	std::string name;
+	LogicalType type = LogicalType::INVALID;
+};
+
+/**
+ * @brief Location and summary of the values of one column in one row group.
+ *
+ * The chunk is `size` bytes at `offset`: a null bitmap of NullBitmapSize() bytes if the chunk has
+ * nulls, followed by the encoded values.
+ */
+struct ColumnChunkMeta {
+	/** @brief Absolute file offset, a multiple of COLUMN_FILE_PAGE_SIZE */
+	uint64_t offset = 0;
+	/** @brief Bytes of the chunk without the padding up to the next page */
+	uint64_t size = 0;
+	EncodingType encoding = EncodingType::PLAIN;
+	uint32_t null_count = 0;
+	/** @brief Hash::crc32c of the `size` bytes */
+	uint32_t checksum = 0;
+	/** @brief Min/max of the chunk and whether it holds NaN, lets scans skip it unread */
+	ZoneMap stats;
+
+	/** @brief Bytes of the null bitmap in front of the values, 0 without nulls */
+	size_t NullBitmapSize(uint32_t row_count) const noexcept;
+};
+
+struct RowGroupMeta {
+	uint32_t row_count = 0;
+	/** @brief One chunk per column of the schema */
+	std::vector<ColumnChunkMeta> columns;
+};
+
+/**
+ * @brief Footer of a column file: the schema and an index of every column chunk.
+ *
+ * Readers load the footer once and then fetch the byte ranges of exactly the chunks they need.
+ */
+struct FileMetadata {
+	std::vector<ColumnSchema> columns;
+	std::vector<RowGroupMeta> row_groups;
+
+	uint64_t RowCount() const noexcept;
+
+	/** @brief Position of the column `name` in the schema, -1 if there is none */
+	int ColumnIndex(const std::string &name) const noexcept;
+
+	/** @brief Encode the footer */
+	std::vector<uint8_t> Serialize() const;
+
+	/** @brief Decode a footer written by Serialize(), throws if it is malformed */
+	static FileMetadata Deserialize(const uint8_t *data, size_t size);
+};
+
+} // namespace electricdb
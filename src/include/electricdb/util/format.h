@@ -0,0 +1,21 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace electricdb {
+
+/**
+ * @brief Append a printf-style formatted string to `out`, cut off after 255 characters
+ *
+ */
+template <typename... Args>
+inline void AppendFormat(std::string &out, const char *format, Args... args) {
+	char buffer[256];
+	const int length = std::snprintf(buffer, sizeof(buffer), format, args...);
+	if (length > 0)
+		out.append(buffer, static_cast<size_t>(std::min<int>(length, sizeof(buffer) - 1)));
+}
+
+} // namespace electricdb
@@ -21,6 +21,15 @@ class Hash {
 	 */
 	static uint64_t bytes(const void *data, size_t len);
 
+	/**
+	 * @brief Hash a fixed-width row key 8 bytes at a time, faster than bytes() for wide keys
+	 *
+	 * @param data Key bytes
+	 * @param width Width of the key in bytes
+	 * @return uint64_t A lookup key
+	 */
+	static uint64_t key(const void *data, size_t width);
+
 	/**
 	 * @brief Hash string bytes (no null terminator)
 	 *
@@ -38,6 +47,17 @@ class Hash {
 	/** Combine two hash values */
 	static uint64_t combine(uint64_t h1, uint64_t h2);
 
+	/**
+	 * @brief CRC-32C (Castagnoli) of raw bytes, for detecting corruption of stored data. Uses the
+	 * SSE4.2 crc32 instruction when the CPU has it.
+	 *
+	 * @param data Bytes to checksum
+	 * @param len Number of bytes
+	 * @param crc Checksum of the preceding bytes, to checksum data in pieces
+	 * @return uint32_t Checksum of everything so far
+	 */
+	static uint32_t crc32c(const void *data, size_t len, uint32_t crc = 0);
+
   private:
 	/**
 	 * @brief Taken straight from DuckDB
@@ -4,9 +4,20 @@
 
 namespace electricdb {
 
+enum class StopwatchClock : uint8_t {
+	/** @brief Monotonic wall-clock time */
+	WALL,
+	/** @brief CPU time consumed by the calling thread, start() and stop() on the same thread */
+	THREAD_CPU
+};
+
+/**
+ * @brief Accumulates the time between start() and stop() over any number of intervals
+ *
+ */
 class Stopwatch {
   public:
-	Stopwatch();
+	explicit Stopwatch(StopwatchClock clock = StopwatchClock::WALL);
 
 	void start();
 	void stop();
@@ -19,7 +30,11 @@ class Stopwatch {
 
 	bool running() const;
 
+	/** @brief Current time of `clock` in nanoseconds, only differences are meaningful */
+	static uint64_t now_ns(StopwatchClock clock = StopwatchClock::WALL);
+
   private:
+	StopwatchClock clock_;
 	uint64_t start_ns_ = 0;
 	uint64_t accumulated_ns_ = 0;
 	bool running_ = false;
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief One recorded trace event, phases follow the Chrome trace-event format
+ *
+ * Names and categories must be string literals (or outlive the tracer), only the pointer is kept.
+ */
+struct TraceEvent {
+	/** @brief Tracer::Now() ticks */
+	uint64_t timestamp;
+	/** @brief Ticks, complete events ('X') only */
+	uint64_t duration;
+	/** @brief Payload of the event, e.g. rows or bytes. The id of async events ('b' / 'e') */
+	uint64_t arg;
+	const char *category;
+	const char *name;
+	char phase;
+};
+
+/**
+ * @brief Process-wide timeline of trace events in per-thread ring buffers.
+ *
+ * Each thread records into its own ring of BUFFER_EVENTS events without locks or atomic
+ * read-modify-writes; once full, the oldest events are overwritten. Timestamps are TSC ticks
+ * (steady_clock nanoseconds where there is no TSC) and are converted to microseconds when the
+ * timeline is exported as Chrome trace-event JSON, viewable in chrome://tracing or Perfetto.
+ *
+ * Trace points are compiled in with TRACING_ENABLED (ENABLE_TRACING in CMake) and record only
+ * while the tracer is enabled at runtime, otherwise they cost one relaxed load. Export and Clear()
+ * are meant to run while nothing records, an export concurrent with recording threads may contain
+ * events that were being overwritten.
+ */
+class Tracer {
+  public:
+	/** @brief Events kept per thread, a power of two */
+	static constexpr size_t BUFFER_EVENTS = 1 << 14;
+
+	static void Enable();
+	static void Disable() noexcept;
+
+	static bool IsEnabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+	/** @brief Current timestamp in ticks */
+	static uint64_t Now() noexcept;
+
+	/** @brief Record an event into the calling thread's buffer */
+	static void Record(const TraceEvent &event);
+
+	/** @brief Record a span that started at `begin` (Now() ticks) and ends now */
+	static void Complete(const char *category, const char *name, uint64_t begin, uint64_t arg = 0);
+
+	/** @brief Record a point in time */
+	static void Instant(const char *category, const char *name, uint64_t arg = 0);
+
+	/** @brief Open an async span identified by `id`, which may end on another thread */
+	static void AsyncBegin(const char *category, const char *name, uint64_t id);
+
+	/** @brief Close the async span opened with the same name and `id` */
+	static void AsyncEnd(const char *category, const char *name, uint64_t id);
+
+	/**
+	 * @brief Label the calling thread in exported timelines, records nothing. Works while the
+	 * tracer is disabled, so long-lived threads can be named once at start for a tracer that is
+	 * only enabled later.
+	 */
+	static void SetThreadName(const std::string &name);
+
+	/** @brief Events of every thread still held by the buffers, oldest first per thread */
+	static std::vector<TraceEvent> Events();
+
+	/** @brief Export the buffers as a Chrome trace-event JSON object */
+	static std::string ToChromeJson();
+
+	/** @brief Write ToChromeJson() to the file at `path` */
+	static void WriteChromeJson(const std::string &path);
+
+	/** @brief Drop every recorded event */
+	static void Clear() noexcept;
+
+  private:
+	static std::atomic<bool> enabled_;
+};
+
+/**
+ * @brief Records a complete event from construction to destruction, if the tracer is enabled
+ *
+ */
+class TraceScope {
+  public:
+	TraceScope(const char *category, const char *name, uint64_t arg = 0) noexcept
+		: category_(category), name_(name), arg_(arg),
+		  begin_(Tracer::IsEnabled() ? Tracer::Now() : 0) {}
+
+	~TraceScope() {
+		if (begin_)
+			Tracer::Complete(category_, name_, begin_, arg_);
+	}
+
+	/** @brief Disable copy constructor */
+	TraceScope(const TraceScope &) = delete;
+
+	/** @brief Disable copy assignment */
+	TraceScope &operator=(const TraceScope &) = delete;
+
+	/** @brief Change the payload, e.g. once the number of bytes read is known */
+	void SetArg(uint64_t arg) noexcept { arg_ = arg; }
+
+  private:
+	const char *category_;
+	const char *name_;
+	uint64_t arg_;
+	uint64_t begin_;
+};
+
+} // namespace electricdb
+
+#define ELECTRICDB_TRACE_CONCAT_(a, b) a##b
+#define ELECTRICDB_TRACE_CONCAT(a, b) ELECTRICDB_TRACE_CONCAT_(a, b)
+
+#ifdef TRACING_ENABLED
+#define TRACE_SCOPE(category, name, arg)                                                          \
+	::electricdb::TraceScope ELECTRICDB_TRACE_CONCAT(trace_scope_, __LINE__)(category, name, arg)
+#define TRACE_INSTANT(category, name, arg)                                                        \
+	do {                                                                                          \
+		if (::electricdb::Tracer::IsEnabled())                                                    \
+			::electricdb::Tracer::Instant(category, name, arg);                                   \
+	} while (0)
+#define TRACE_ASYNC_BEGIN(category, name, id)                                                     \
+	do {                                                                                          \
+		if (::electricdb::Tracer::IsEnabled())                                                    \
+			::electricdb::Tracer::AsyncBegin(category, name, id);                                 \
+	} while (0)
+#define TRACE_ASYNC_END(category, name, id)                                                       \
+	do {                                                                                          \
+		if (::electricdb::Tracer::IsEnabled())                                                    \
+			::electricdb::Tracer::AsyncEnd(category, name, id);                                   \
+	} while (0)
+#define TRACE_THREAD_NAME(name) ::electricdb::Tracer::SetThreadName(name)
+#else
+#define TRACE_SCOPE(category, name, arg) ((void)0)
+#define TRACE_INSTANT(category, name, arg) ((void)0)
+#define TRACE_ASYNC_BEGIN(category, name, id) ((void)0)
+#define TRACE_ASYNC_END(category, name, id) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -0,0 +1,138 @@
+#include "electricdb/io/file.h"
+#include "electricdb/util/trace.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace electricdb {
+
+/**
+ * @brief Build an exception that carries errno
+ *
+ */
+static std::runtime_error IOError(const char *what, const std::string &path) {
+	return std::runtime_error(std::string(what) + " '" + path + "': " + std::strerror(errno));
+}
+
+File::File(std::string path, uint32_t flags) : path_(std::move(path)) {
+	int open_flags = O_CLOEXEC;
+
+	if ((flags & FILE_READ) && (flags & FILE_WRITE))
+		open_flags |= O_RDWR;
+	else if (flags & FILE_WRITE)
+		open_flags |= O_WRONLY;
+	else
+		open_flags |= O_RDONLY;
+
+	if (flags & FILE_CREATE)
+		open_flags |= O_CREAT;
+	if (flags & FILE_TRUNCATE)
+		open_flags |= O_TRUNC;
+
+	if (flags & FILE_DIRECT) {
+		fd_ = ::open(path_.c_str(), open_flags | O_DIRECT, 0644);
+		direct_ = fd_ >= 0;
+		/** EINVAL: the filesystem has no direct I/O, fall back to the page cache */
+		if (fd_ < 0 && errno != EINVAL)
+			throw IOError("Could not open file", path_);
+	}
+	if (fd_ < 0)
+		fd_ = ::open(path_.c_str(), open_flags, 0644);
+	if (fd_ < 0)
+		throw IOError("Could not open file", path_);
+}
+
+File::~File() {
+	Close();
+}
+
+File::File(File &&other) noexcept
+	: fd_(other.fd_), direct_(other.direct_), path_(std::move(other.path_)) {
+	other.fd_ = -1;
+	other.direct_ = false;
+}
+
+auto File::operator=(File &&other) noexcept -> File & {
+	if (this != &other) {
+		Close();
+		fd_ = other.fd_;
+		direct_ = other.direct_;
+		path_ = std::move(other.path_);
+		other.fd_ = -1;
+		other.direct_ = false;
+	}
+
+	return *this;
+}
+
+size_t File::Read(void *buffer, size_t size, uint64_t offset) const {
+	/** Synchronous, the span runs from submission to completion */
+	TRACE_SCOPE("io", "read", size);
+	auto *dst = static_cast<uint8_t *>(buffer);
+	size_t total = 0;
+
+	while (total < size) {
+		const ssize_t n =
+				::pread(fd_, dst + total, size - total, static_cast<off_t>(offset + total));
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			throw IOError("Could not read from file", path_);
+		}
+		if (n == 0)
+			break;
+		total += static_cast<size_t>(n);
+		/** A direct read only ends unaligned at end of file, the next pread would fail */
+		if (direct_ && total % DIRECT_IO_ALIGNMENT != 0)
+			break;
+	}
+
+	return total;
+}
+
+void File::Write(const void *buffer, size_t size, uint64_t offset) {
+	TRACE_SCOPE("io", "write", size);
+	const auto *src = static_cast<const uint8_t *>(buffer);
+	size_t total = 0;
+
+	while (total < size) {
+		const ssize_t n =
+				::pwrite(fd_, src + total, size - total, static_cast<off_t>(offset + total));
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			throw IOError("Could not write to file", path_);
+		}
+		total += static_cast<size_t>(n);
+	}
+}
+
+uint64_t File::Size() const {
+	struct stat st{};
+	if (::fstat(fd_, &st) != 0)
+		throw IOError("Could not stat file", path_);
+	return static_cast<uint64_t>(st.st_size);
+}
+
+void File::Truncate(uint64_t size) {
+	if (::ftruncate(fd_, static_cast<off_t>(size)) != 0)
+		throw IOError("Could not truncate file", path_);
+}
+
+void File::Close() noexcept {
+	if (fd_ >= 0) {
+		::close(fd_);
+		fd_ = -1;
+		direct_ = false;
+	}
+}
+
+void File::Remove(const std::string &path) noexcept {
+	::unlink(path.c_str());
+}
+
+} // namespace electricdb
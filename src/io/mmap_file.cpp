@@ -0,0 +1,83 @@
+#include "electricdb/io/mmap_file.h"
+#include "electricdb/io/file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace electricdb {
+
+MappedFile::MappedFile(const std::string &path) {
+	File file(path, FILE_READ);
+	size_ = file.Size();
+	if (size_ == 0)
+		return;
+
+	/** The mapping keeps the file referenced, the descriptor can be closed right away */
+	void *data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, file.Handle(), 0);
+	if (data == MAP_FAILED) {
+		size_ = 0;
+		throw std::runtime_error("Could not map file '" + path + "': " + std::strerror(errno));
+	}
+	data_ = static_cast<const uint8_t *>(data);
+}
+
+MappedFile::~MappedFile() {
+	Unmap();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept : data_(other.data_), size_(other.size_) {
+	other.data_ = nullptr;
+	other.size_ = 0;
+}
+
+auto MappedFile::operator=(MappedFile &&other) noexcept -> MappedFile & {
+	if (this != &other) {
+		Unmap();
+		data_ = other.data_;
+		size_ = other.size_;
+		other.data_ = nullptr;
+		other.size_ = 0;
+	}
+
+	return *this;
+}
+
+static int AdviceFlag(AccessHint hint) {
+	switch (hint) {
+	case AccessHint::SEQUENTIAL:
+		return MADV_SEQUENTIAL;
+	case AccessHint::RANDOM:
+		return MADV_RANDOM;
+	case AccessHint::WILLNEED:
+		return MADV_WILLNEED;
+	case AccessHint::DONTNEED:
+		return MADV_DONTNEED;
+	default:
+		return MADV_NORMAL;
+	}
+}
+
+void MappedFile::Advise(uint64_t offset, uint64_t length, AccessHint hint) const noexcept {
+	if (!data_ || offset >= size_ || length == 0)
+		return;
+	length = std::min(length, size_ - offset);
+
+	/** madvise() wants a page-aligned start */
+	static const uint64_t page_size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+	const uint64_t start = offset & ~(page_size - 1);
+	::madvise(const_cast<uint8_t *>(data_) + start, length + (offset - start), AdviceFlag(hint));
+}
+
+void MappedFile::Unmap() noexcept {
+	if (data_) {
+		::munmap(const_cast<uint8_t *>(data_), size_);
+		data_ = nullptr;
+		size_ = 0;
+	}
+}
+
+} // namespace electricdb
@@ -0,0 +1,305 @@
+#include "electricdb/io/prefetch.h"
+#include "electricdb/util/trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace electricdb {
+
+/** @brief Largest single read, io_uring lengths are 32 bit */
+static constexpr size_t MAX_READ_SIZE = size_t{1} << 30;
+
+/** @brief Threads of the pool backend at most */
+static constexpr uint32_t MAX_POOL_THREADS = 16;
+
+/**
+ * @brief An io_uring set up through the raw system calls, with its rings mapped into memory.
+ * The submission queue is only touched under AsyncReader::lock_, the completion queue only by the
+ * thread that is reaping.
+ */
+struct AsyncReader::Ring {
+	int fd = -1;
+	void *sq_ring = MAP_FAILED;
+	size_t sq_ring_size = 0;
+	void *cq_ring = MAP_FAILED;
+	size_t cq_ring_size = 0;
+	io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+	size_t sqes_size = 0;
+
+	unsigned *sq_tail = nullptr;
+	unsigned *sq_mask = nullptr;
+	unsigned *sq_array = nullptr;
+	unsigned *cq_head = nullptr;
+	unsigned *cq_tail = nullptr;
+	unsigned *cq_mask = nullptr;
+	io_uring_cqe *cqes = nullptr;
+
+	~Ring() {
+		if (sqes != MAP_FAILED)
+			::munmap(sqes, sqes_size);
+		if (cq_ring != MAP_FAILED && cq_ring != sq_ring)
+			::munmap(cq_ring, cq_ring_size);
+		if (sq_ring != MAP_FAILED)
+			::munmap(sq_ring, sq_ring_size);
+		if (fd >= 0)
+			::close(fd);
+	}
+
+	/** @brief Set up a ring of `entries`, false if the kernel cannot provide one with reads */
+	bool Setup(uint32_t entries);
+
+	/** @brief io_uring_enter(), retried when interrupted */
+	int Enter(unsigned to_submit, unsigned min_complete, unsigned flags) const {
+		int ret;
+		do {
+			ret = static_cast<int>(
+					::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+		} while (ret < 0 && errno == EINTR);
+		return ret;
+	}
+};
+
+/** @brief Check that the kernel implements IORING_OP_READ (5.6 and later) */
+static bool SupportsRead(int ring_fd) {
+	constexpr unsigned ops = 256;
+	std::vector<uint8_t> storage(sizeof(io_uring_probe) + ops * sizeof(io_uring_probe_op), 0);
+	auto *probe = reinterpret_cast<io_uring_probe *>(storage.data());
+	if (::syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, ops) < 0)
+		return false;
+	return probe->last_op >= IORING_OP_READ &&
+		   (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED);
+}
+
+bool AsyncReader::Ring::Setup(uint32_t entries) {
+	io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+	fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+	/** Kernels without io_uring, seccomp filters and io_uring_disabled all end up here */
+	if (fd < 0 || !SupportsRead(fd))
+		return false;
+
+	sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+		sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+	sq_ring = ::mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+					 IORING_OFF_SQ_RING);
+	if (sq_ring == MAP_FAILED)
+		return false;
+	if (params.features & IORING_FEAT_SINGLE_MMAP) {
+		cq_ring = sq_ring;
+	} else {
+		cq_ring = ::mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+						 fd, IORING_OFF_CQ_RING);
+		if (cq_ring == MAP_FAILED)
+			return false;
+	}
+	sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+	sqes = static_cast<io_uring_sqe *>(::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+											  MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+	if (sqes == MAP_FAILED)
+		return false;
+
+	auto *sq = static_cast<uint8_t *>(sq_ring);
+	auto *cq = static_cast<uint8_t *>(cq_ring);
+	sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+	sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+	sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+	cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+	cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+	cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+	cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+	return true;
+}
+
+AsyncReader::AsyncReader(uint32_t queue_depth, bool io_uring)
+	: queue_depth_(std::max<uint32_t>(queue_depth, 1)) {
+	if (io_uring) {
+		ring_ = std::make_unique<Ring>();
+		if (!ring_->Setup(queue_depth_))
+			ring_.reset();
+	}
+	if (ring_)
+		return;
+
+	const uint32_t threads = std::min(queue_depth_, MAX_POOL_THREADS);
+	for (uint32_t i = 0; i < threads; i++)
+		workers_.emplace_back([this]() { Work(); });
+}
+
+AsyncReader::~AsyncReader() {
+	if (ring_) {
+		/** The kernel may still write into the buffers of unfinished reads */
+		std::unique_lock<std::mutex> guard(lock_);
+		while (!requests_.empty()) {
+			guard.unlock();
+			ReapRing();
+			guard.lock();
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		stop_ = true;
+	}
+	submitted_.notify_all();
+	for (auto &worker : workers_)
+		worker.join();
+}
+
+uint64_t AsyncReader::Submit(const File &file, void *buffer, size_t size, uint64_t offset) {
+	TRACE_INSTANT("io", "submit", size);
+	std::lock_guard<std::mutex> guard(lock_);
+	const uint64_t ticket = next_ticket_++;
+	const Request &request =
+			requests_.emplace(ticket, Request{&file, static_cast<uint8_t *>(buffer), size, offset})
+					.first->second;
+
+	if (ring_ && size == 0) {
+		requests_.erase(ticket);
+		results_.emplace(ticket, 0);
+	} else if (ring_ && in_ring_ < queue_depth_) {
+		SubmitToRing(ticket, request);
+	} else {
+		/** Waits for a free slot in the ring, or for a thread of the pool */
+		queue_.push_back(ticket);
+		submitted_.notify_one();
+	}
+	return ticket;
+}
+
+void AsyncReader::SubmitToRing(uint64_t ticket, const Request &request) {
+	const unsigned tail = *ring_->sq_tail;
+	const unsigned index = tail & *ring_->sq_mask;
+	io_uring_sqe &sqe = ring_->sqes[index];
+	std::memset(&sqe, 0, sizeof(sqe));
+	sqe.opcode = IORING_OP_READ;
+	sqe.fd = request.file->Handle();
+	sqe.addr = reinterpret_cast<uint64_t>(request.buffer + request.done);
+	sqe.len = static_cast<uint32_t>(std::min(request.size - request.done, MAX_READ_SIZE));
+	sqe.off = request.offset + request.done;
+	sqe.user_data = ticket;
+	ring_->sq_array[index] = index;
+	/** Publishes the entry to the kernel */
+	__atomic_store_n(ring_->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	in_ring_++;
+
+	if (ring_->Enter(1, 0, 0) < 0)
+		throw std::runtime_error(std::string("Could not submit read: ") + std::strerror(errno));
+}
+
+void AsyncReader::ReapRing() {
+	if (ring_->Enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EAGAIN && errno != EBUSY)
+		throw std::runtime_error(std::string("Could not wait for reads: ") + std::strerror(errno));
+
+	const unsigned tail = __atomic_load_n(ring_->cq_tail, __ATOMIC_ACQUIRE);
+	unsigned head = *ring_->cq_head;
+	std::vector<std::pair<uint64_t, int32_t>> completions;
+	for (; head != tail; head++) {
+		const io_uring_cqe &cqe = ring_->cqes[head & *ring_->cq_mask];
+		completions.emplace_back(cqe.user_data, cqe.res);
+	}
+	/** Hands the entries back to the kernel */
+	__atomic_store_n(ring_->cq_head, head, __ATOMIC_RELEASE);
+
+	std::lock_guard<std::mutex> guard(lock_);
+	for (const auto &[ticket, res] : completions)
+		Complete(ticket, res);
+}
+
+void AsyncReader::Complete(uint64_t ticket, int32_t res) {
+	in_ring_--;
+	auto it = requests_.find(ticket);
+	Request &request = it->second;
+
+	const bool retry = res == -EINTR || res == -EAGAIN;
+	if (res > 0)
+		request.done += static_cast<size_t>(res);
+	if (retry || (res > 0 && request.done < request.size)) {
+		/** Interrupted or short, read the rest */
+		SubmitToRing(ticket, request);
+	} else {
+		results_.emplace(ticket, res < 0 ? Result{res} : static_cast<Result>(request.done));
+		requests_.erase(it);
+	}
+
+	while (in_ring_ < queue_depth_ && !queue_.empty()) {
+		const uint64_t next = queue_.front();
+		queue_.pop_front();
+		SubmitToRing(next, requests_.at(next));
+	}
+}
+
+size_t AsyncReader::Wait(uint64_t ticket) {
+	TRACE_SCOPE("io", "wait", 0);
+	std::unique_lock<std::mutex> guard(lock_);
+	for (;;) {
+		auto it = results_.find(ticket);
+		if (it != results_.end()) {
+			const Result result = it->second;
+			results_.erase(it);
+			if (result < 0)
+				throw std::runtime_error(std::string("Could not read from file: ") +
+										 std::strerror(static_cast<int>(-result)));
+			return static_cast<size_t>(result);
+		}
+		if (!requests_.count(ticket))
+			throw std::runtime_error("Unknown read ticket!");
+
+		if (!ring_ || reaping_) {
+			completed_.wait(guard);
+			continue;
+		}
+
+		/** Become the reaper, completions of other waiters are handed to them */
+		reaping_ = true;
+		guard.unlock();
+		try {
+			ReapRing();
+		} catch (...) {
+			guard.lock();
+			reaping_ = false;
+			completed_.notify_all();
+			throw;
+		}
+		guard.lock();
+		reaping_ = false;
+		completed_.notify_all();
+	}
+}
+
+void AsyncReader::Work() {
+	std::unique_lock<std::mutex> guard(lock_);
+	for (;;) {
+		submitted_.wait(guard, [this]() { return stop_ || !queue_.empty(); });
+		if (queue_.empty())
+			return;
+		const uint64_t ticket = queue_.front();
+		queue_.pop_front();
+		const Request request = requests_.at(ticket);
+		guard.unlock();
+
+		Result result;
+		try {
+			result = static_cast<Result>(
+					request.file->Read(request.buffer, request.size, request.offset));
+		} catch (const std::runtime_error &) {
+			result = -(errno ? errno : EIO);
+		}
+
+		guard.lock();
+		requests_.erase(ticket);
+		results_.emplace(ticket, result);
+		completed_.notify_all();
+	}
+}
+
+} // namespace electricdb
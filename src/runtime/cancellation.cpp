@@ -0,0 +1,113 @@
+#include "electricdb/runtime/cancellation.h"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace electricdb {
+
+static const char *CancelMessage(CancelReason reason) {
+	return reason == CancelReason::DEADLINE ? "Query exceeded its deadline!"
+											: "Query was cancelled!";
+}
+
+QueryCancelled::QueryCancelled(CancelReason reason)
+	: std::runtime_error(CancelMessage(reason)), reason_(reason) {}
+
+/**
+ * @brief Background thread that cancels tokens whose deadline has passed.
+ *
+ * Tokens are cancelled while holding the timer lock, and a token removes itself under the same
+ * lock before it is destroyed, so the timer never touches a destroyed token.
+ */
+class DeadlineTimer {
+  public:
+	DeadlineTimer() : thread_([this]() { Loop(); }) {}
+
+	~DeadlineTimer() {
+		{
+			std::lock_guard<std::mutex> guard(lock_);
+			stop_ = true;
+		}
+		wake_.notify_all();
+		thread_.join();
+	}
+
+	void Add(CancellationToken *token, CancellationToken::Clock::time_point deadline) {
+		{
+			std::lock_guard<std::mutex> guard(lock_);
+			EraseLocked(token);
+			deadlines_.emplace(deadline, token);
+		}
+		wake_.notify_all();
+	}
+
+	void Remove(CancellationToken *token) {
+		std::lock_guard<std::mutex> guard(lock_);
+		EraseLocked(token);
+	}
+
+  private:
+	void EraseLocked(CancellationToken *token) {
+		for (auto it = deadlines_.begin(); it != deadlines_.end(); ++it) {
+			if (it->second == token) {
+				deadlines_.erase(it);
+				return;
+			}
+		}
+	}
+
+	void Loop() {
+		std::unique_lock<std::mutex> lock(lock_);
+		while (!stop_) {
+			if (deadlines_.empty()) {
+				wake_.wait(lock);
+				continue;
+			}
+
+			const auto next = deadlines_.begin();
+			if (CancellationToken::Clock::now() < next->first) {
+				wake_.wait_until(lock, next->first);
+				continue;
+			}
+			next->second->Cancel(CancelReason::DEADLINE);
+			deadlines_.erase(next);
+		}
+	}
+
+	std::mutex lock_;
+	std::condition_variable wake_;
+	std::multimap<CancellationToken::Clock::time_point, CancellationToken *> deadlines_;
+	bool stop_ = false;
+	/** @brief Started last, after the members it uses */
+	std::thread thread_;
+};
+
+static DeadlineTimer &Timer() {
+	static DeadlineTimer timer;
+	return timer;
+}
+
+CancellationToken::~CancellationToken() {
+	if (has_deadline_)
+		Timer().Remove(this);
+}
+
+bool CancellationToken::Cancel(CancelReason reason) noexcept {
+	CancelReason expected = CancelReason::NONE;
+	return reason_.compare_exchange_strong(expected, reason, std::memory_order_acq_rel);
+}
+
+void CancellationToken::SetDeadline(Clock::time_point deadline) {
+	if (IsCancelled())
+		return;
+	if (deadline <= Clock::now()) {
+		Cancel(CancelReason::DEADLINE);
+		return;
+	}
+	has_deadline_ = true;
+	Timer().Add(this, deadline);
+}
+
+} // namespace electricdb
@@ -0,0 +1,117 @@
+#include "electricdb/runtime/metrics.h"
+#include "electricdb/util/format.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace electricdb {
+
+void OperatorMetrics::Merge(const OperatorMetrics &other) {
+	rows_in += other.rows_in;
+	rows_out += other.rows_out;
+	batches += other.batches;
+	wall_ns += other.wall_ns;
+	cpu_ns += other.cpu_ns;
+	bytes_allocated += other.bytes_allocated;
+	bytes_read += other.bytes_read;
+	probes += other.probes;
+	probe_steps += other.probe_steps;
+	cycles += other.cycles;
+	instructions += other.instructions;
+	llc_misses += other.llc_misses;
+	branch_misses += other.branch_misses;
+	threads = std::max(threads, other.threads);
+}
+
+QueryProfile::QueryProfile(ProfileNode root, uint64_t wall_ns)
+	: root_(std::move(root)), wall_ns_(wall_ns) {}
+
+static double Milliseconds(uint64_t ns) {
+	return static_cast<double>(ns) / 1e6;
+}
+
+static void RenderText(const ProfileNode &node, const std::string &prefix, bool last, bool root,
+					   std::string &out) {
+	const OperatorMetrics &m = node.metrics;
+	out += prefix;
+	if (!root)
+		out += last ? "`- " : "|- ";
+	out += node.name;
+	AppendFormat(out, "  rows_in=%llu rows_out=%llu batches=%llu wall=%.3fms cpu=%.3fms threads=%u",
+				 static_cast<unsigned long long>(m.rows_in),
+				 static_cast<unsigned long long>(m.rows_out),
+				 static_cast<unsigned long long>(m.batches), Milliseconds(m.wall_ns),
+				 Milliseconds(m.cpu_ns), m.threads);
+	if (m.bytes_allocated)
+		AppendFormat(out, " allocated=%lluB", static_cast<unsigned long long>(m.bytes_allocated));
+	if (m.bytes_read)
+		AppendFormat(out, " read=%lluB", static_cast<unsigned long long>(m.bytes_read));
+	if (m.probes)
+		AppendFormat(out, " probes=%llu probe_len=%.2f", static_cast<unsigned long long>(m.probes),
+					 m.AverageProbeLength());
+	if (m.cycles || m.instructions)
+		AppendFormat(out,
+					 " cycles=%llu instructions=%llu ipc=%.2f llc_misses=%llu branch_misses=%llu",
+					 static_cast<unsigned long long>(m.cycles),
+					 static_cast<unsigned long long>(m.instructions), m.InstructionsPerCycle(),
+					 static_cast<unsigned long long>(m.llc_misses),
+					 static_cast<unsigned long long>(m.branch_misses));
+	out += '\n';
+
+	const std::string child_prefix = root ? prefix : prefix + (last ? "   " : "|  ");
+	for (size_t i = 0; i < node.children.size(); i++)
+		RenderText(node.children[i], child_prefix, i + 1 == node.children.size(), false, out);
+}
+
+std::string QueryProfile::ToText() const {
+	std::string out;
+	AppendFormat(out, "EXPLAIN ANALYZE (total %.3fms)\n", Milliseconds(wall_ns_));
+	RenderText(root_, "", true, true, out);
+	return out;
+}
+
+static void RenderJson(const ProfileNode &node, std::string &out) {
+	const OperatorMetrics &m = node.metrics;
+	/** Operator names are identifiers, nothing to escape */
+	AppendFormat(out, "{\"name\":\"%s\"", node.name.c_str());
+	AppendFormat(out, ",\"rows_in\":%llu,\"rows_out\":%llu,\"batches\":%llu",
+				 static_cast<unsigned long long>(m.rows_in),
+				 static_cast<unsigned long long>(m.rows_out),
+				 static_cast<unsigned long long>(m.batches));
+	AppendFormat(out, ",\"wall_ns\":%llu,\"cpu_ns\":%llu,\"threads\":%u",
+				 static_cast<unsigned long long>(m.wall_ns),
+				 static_cast<unsigned long long>(m.cpu_ns), m.threads);
+	AppendFormat(out, ",\"bytes_allocated\":%llu,\"bytes_read\":%llu",
+				 static_cast<unsigned long long>(m.bytes_allocated),
+				 static_cast<unsigned long long>(m.bytes_read));
+	AppendFormat(out, ",\"probes\":%llu,\"probe_steps\":%llu",
+				 static_cast<unsigned long long>(m.probes),
+				 static_cast<unsigned long long>(m.probe_steps));
+	/** Only where the kernel let the query count them */
+	if (m.cycles || m.instructions) {
+		AppendFormat(out, ",\"cycles\":%llu,\"instructions\":%llu",
+					 static_cast<unsigned long long>(m.cycles),
+					 static_cast<unsigned long long>(m.instructions));
+		AppendFormat(out, ",\"llc_misses\":%llu,\"branch_misses\":%llu",
+					 static_cast<unsigned long long>(m.llc_misses),
+					 static_cast<unsigned long long>(m.branch_misses));
+	}
+
+	out += ",\"children\":[";
+	for (size_t i = 0; i < node.children.size(); i++) {
+		if (i)
+			out += ',';
+		RenderJson(node.children[i], out);
+	}
+	out += "]}";
+}
+
+std::string QueryProfile::ToJson() const {
+	std::string out;
+	AppendFormat(out, "{\"wall_ns\":%llu,\"plan\":", static_cast<unsigned long long>(wall_ns_));
+	RenderJson(root_, out);
+	out += '}';
+	return out;
+}
+
+} // namespace electricdb
@@ -0,0 +1,96 @@
+#include "electricdb/runtime/perf_counters.h"
+
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace electricdb {
+
+/** @brief perf_event_attr type and config of an event */
+static void Describe(PerfEvent event, perf_event_attr &attr) {
+	attr.type = PERF_TYPE_HARDWARE;
+	switch (event) {
+	case PerfEvent::CYCLES:
+		attr.config = PERF_COUNT_HW_CPU_CYCLES;
+		break;
+	case PerfEvent::INSTRUCTIONS:
+		attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+		break;
+	case PerfEvent::LLC_MISSES:
+		attr.type = PERF_TYPE_HW_CACHE;
+		attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+					  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		break;
+	case PerfEvent::BRANCH_MISSES:
+		attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+		break;
+	}
+}
+
+static int OpenEvent(PerfEvent event, int group_fd) {
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	Describe(event, attr);
+	/** User space only, which perf_event_paranoid <= 2 allows for a process's own threads */
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format =
+			PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	/** pid 0 and cpu -1: the calling thread on whichever CPU it runs */
+	const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+	return static_cast<int>(fd);
+}
+
+PerfCounters::PerfCounters() {
+	fds_.fill(-1);
+	for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+		const auto event = static_cast<PerfEvent>(i);
+		const int fd = OpenEvent(event, leader_);
+		if (fd < 0)
+			continue;
+		if (leader_ < 0)
+			leader_ = fd;
+		fds_[i] = fd;
+		order_[opened_++] = event;
+	}
+}
+
+PerfCounters::~PerfCounters() {
+	for (int fd : fds_) {
+		if (fd >= 0)
+			close(fd);
+	}
+}
+
+bool PerfCounters::Counts(PerfEvent event) const noexcept {
+	return fds_[static_cast<size_t>(event)] >= 0;
+}
+
+PerfSample PerfCounters::Read() const noexcept {
+	PerfSample sample{};
+	if (leader_ < 0)
+		return sample;
+
+	/** PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, then one value per event */
+	uint64_t buffer[3 + PERF_EVENT_COUNT];
+	const ssize_t bytes = read(leader_, buffer, sizeof(buffer));
+	if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t)))
+		return sample;
+
+	const uint64_t enabled = buffer[1];
+	const uint64_t running = buffer[2];
+	const size_t count = buffer[0] < opened_ ? buffer[0] : opened_;
+	for (size_t i = 0; i < count; i++) {
+		uint64_t value = buffer[3 + i];
+		/** The group shared the PMU with other groups for part of the time, extrapolate */
+		if (running && running < enabled)
+			value = static_cast<uint64_t>(static_cast<double>(value) * enabled / running);
+		sample[static_cast<size_t>(order_[i])] = value;
+	}
+	return sample;
+}
+
+} // namespace electricdb
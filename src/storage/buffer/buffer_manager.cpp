@@ -0,0 +1,300 @@
+#include "electricdb/storage/buffer/buffer_manager.h"
+#include "electricdb/io/file.h"
+#include "electricdb/runtime/cancellation.h"
+#include "electricdb/util/hash.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <vector>
+
+namespace electricdb {
+
+/** @brief How long a waiting Pin() may take to notice that its query was cancelled */
+static constexpr std::chrono::milliseconds CANCEL_POLL_INTERVAL{10};
+
+/** @brief A cached chunk, owned by BufferManager::entries_ */
+struct BufferHandle::Entry {
+	ChunkKey key;
+	uint8_t *data = nullptr;
+	uint64_t size = 0;
+	uint64_t frames = 0;
+	uint32_t pins = 0;
+	/** @brief Set until the loader filled the frames, nobody else may pin the entry before */
+	bool loading = true;
+	/** @brief In main_, otherwise in probation_ */
+	bool hot = false;
+	/** @brief Pinned since the clock hand last passed, main_ only */
+	bool referenced = false;
+	std::list<Entry *>::iterator position;
+};
+
+size_t ChunkKeyHash::operator()(const ChunkKey &key) const noexcept {
+	return Hash::combine(Hash::u32(key.file),
+						 Hash::combine(Hash::u32(key.row_group), Hash::u32(key.column)));
+}
+
+BufferHandle::BufferHandle(BufferHandle &&other) noexcept
+	: manager_(other.manager_), entry_(other.entry_) {
+	other.entry_ = nullptr;
+}
+
+BufferHandle &BufferHandle::operator=(BufferHandle &&other) noexcept {
+	if (this != &other) {
+		Reset();
+		manager_ = other.manager_;
+		entry_ = other.entry_;
+		other.entry_ = nullptr;
+	}
+	return *this;
+}
+
+const uint8_t *BufferHandle::Data() const noexcept {
+	return entry_ ? entry_->data : nullptr;
+}
+
+uint64_t BufferHandle::Size() const noexcept {
+	return entry_ ? entry_->size : 0;
+}
+
+void BufferHandle::Reset() noexcept {
+	if (entry_) {
+		manager_->Unpin(entry_);
+		entry_ = nullptr;
+	}
+}
+
+BufferManager::BufferManager(uint64_t memory_limit, uint64_t frame_size)
+	: frame_size_(frame_size), frame_limit_(memory_limit / std::max<uint64_t>(frame_size, 1)) {
+	if (frame_size_ < DIRECT_IO_ALIGNMENT || (frame_size_ & (frame_size_ - 1)) != 0)
+		throw std::runtime_error("Frame size must be a power of two of at least 4 KB!");
+	/** The split of the 2Q paper: probation holds a quarter, ghosts cover half the frames */
+	probation_limit_ = std::max<uint64_t>(frame_limit_ / 4, 1);
+	ghost_limit_ = static_cast<size_t>(std::max<uint64_t>(frame_limit_ / 2, 1));
+}
+
+BufferManager::~BufferManager() {
+	for (auto &[key, entry] : entries_)
+		std::free(entry->data);
+}
+
+uint32_t BufferManager::RegisterFile(const std::string &path) {
+	struct stat st{};
+	if (::stat(path.c_str(), &st) != 0)
+		throw std::runtime_error("Could not stat file '" + path + "': " + std::strerror(errno));
+	FileVersion version;
+	version.inode = static_cast<uint64_t>(st.st_ino);
+	version.size = static_cast<uint64_t>(st.st_size);
+	version.modified_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+
+	std::lock_guard<std::mutex> guard(lock_);
+	auto [it, inserted] = files_.try_emplace(path);
+	FileVersion &registered = it->second;
+	if (!inserted && registered.inode == version.inode && registered.size == version.size &&
+		registered.modified_ns == version.modified_ns)
+		return registered.id;
+
+	/** A rewritten file must not be served the chunks of its previous contents */
+	if (!inserted)
+		DropFile(registered.id);
+	version.id = next_file_++;
+	registered = version;
+	return version.id;
+}
+
+void BufferManager::DropFile(uint32_t file) {
+	std::vector<Entry *> dropped;
+	for (auto &[key, entry] : entries_) {
+		if (key.file == file && !entry->pins && !entry->loading)
+			dropped.push_back(entry.get());
+	}
+	for (Entry *entry : dropped)
+		Remove(entry);
+}
+
+BufferHandle BufferManager::Pin(const ChunkKey &key, uint64_t size, const Loader &load,
+								const CancellationToken *token, size_t held) {
+	const uint64_t frames = std::max<uint64_t>((size + frame_size_ - 1) / frame_size_, 1);
+	if (frames > frame_limit_)
+		throw std::runtime_error("Chunk does not fit the buffer manager's memory limit!");
+
+	std::unique_lock<std::mutex> guard(lock_);
+	for (;;) {
+		auto it = entries_.find(key);
+		if (it == entries_.end()) {
+			if (Reserve(frames))
+				break;
+			if (pins_ <= held)
+				throw std::runtime_error("Chunks pinned by the caller leave no room for this one!");
+			/** Every chunk is pinned: wait for an unpin, then look again, as for a load */
+			Wait(guard, token);
+			continue;
+		}
+		Entry *entry = it->second.get();
+		/** Wait for the other load, then look again: it may have failed */
+		if (entry->loading) {
+			Wait(guard, token);
+			continue;
+		}
+		entry->pins++;
+		pins_++;
+		entry->referenced = true;
+		stats_.hits++;
+		return BufferHandle(this, entry);
+	}
+
+	stats_.misses++;
+	auto *data = static_cast<uint8_t *>(std::aligned_alloc(DIRECT_IO_ALIGNMENT,
+														   frames * frame_size_));
+	if (!data)
+		throw std::bad_alloc();
+
+	auto owned = std::make_unique<Entry>();
+	Entry *entry = owned.get();
+	entry->key = key;
+	entry->data = data;
+	entry->size = size;
+	entry->frames = frames;
+	entry->pins = 1;
+	pins_++;
+
+	/** A key evicted from probation is wanted again, so it is more than a one-off */
+	auto ghost = ghost_index_.find(key);
+	if (ghost != ghost_index_.end()) {
+		ghosts_.erase(ghost->second);
+		ghost_index_.erase(ghost);
+		entry->hot = true;
+		entry->position = main_.insert(main_.end(), entry);
+		stats_.promotions++;
+	} else {
+		entry->position = probation_.insert(probation_.end(), entry);
+		probation_frames_ += frames;
+	}
+	frames_used_ += frames;
+	entries_.emplace(key, std::move(owned));
+	guard.unlock();
+
+	try {
+		load(data);
+	} catch (...) {
+		guard.lock();
+		pins_--;
+		Remove(entry);
+		guard.unlock();
+		loaded_.notify_all();
+		throw;
+	}
+
+	guard.lock();
+	entry->loading = false;
+	guard.unlock();
+	loaded_.notify_all();
+	return BufferHandle(this, entry);
+}
+
+void BufferManager::Unpin(Entry *entry) noexcept {
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		pins_--;
+		if (--entry->pins > 0)
+			return;
+	}
+	/** The chunk may be evicted now, which a Pin() waiting for room needs */
+	loaded_.notify_all();
+}
+
+void BufferManager::Wait(std::unique_lock<std::mutex> &guard, const CancellationToken *token) {
+	if (!token) {
+		loaded_.wait(guard);
+		return;
+	}
+	/** Cancelling does not signal loaded_, so wake up now and then to look at the token */
+	loaded_.wait_for(guard, CANCEL_POLL_INTERVAL);
+	token->ThrowIfCancelled();
+}
+
+bool BufferManager::Reserve(uint64_t frames) {
+	while (frames_used_ + frames > frame_limit_) {
+		/** Probation gives way first once it outgrew its share, so hot chunks survive scans */
+		if (probation_frames_ > probation_limit_ && EvictProbation())
+			continue;
+		if (EvictMain() || EvictProbation())
+			continue;
+		return false;
+	}
+	return true;
+}
+
+bool BufferManager::EvictProbation() {
+	for (Entry *entry : probation_) {
+		if (entry->pins)
+			continue;
+		AddGhost(entry->key);
+		Remove(entry);
+		stats_.evictions++;
+		return true;
+	}
+	return false;
+}
+
+bool BufferManager::EvictMain() {
+	/** Two rounds: the first may only clear reference bits */
+	for (size_t step = 0, steps = 2 * main_.size(); step < steps; step++) {
+		Entry *entry = main_.front();
+		if (!entry->pins && !entry->referenced) {
+			Remove(entry);
+			stats_.evictions++;
+			return true;
+		}
+		entry->referenced = false;
+		main_.splice(main_.end(), main_, main_.begin());
+	}
+	return false;
+}
+
+void BufferManager::Remove(Entry *entry) {
+	if (entry->hot) {
+		main_.erase(entry->position);
+	} else {
+		probation_.erase(entry->position);
+		probation_frames_ -= entry->frames;
+	}
+	frames_used_ -= entry->frames;
+	std::free(entry->data);
+	/** Destroys the entry, so the key must not be a reference into it */
+	const ChunkKey key = entry->key;
+	entries_.erase(key);
+}
+
+void BufferManager::AddGhost(const ChunkKey &key) {
+	if (ghost_index_.count(key))
+		return;
+	ghost_index_.emplace(key, ghosts_.insert(ghosts_.end(), key));
+	if (ghosts_.size() > ghost_limit_) {
+		ghost_index_.erase(ghosts_.front());
+		ghosts_.pop_front();
+	}
+}
+
+bool BufferManager::IsResident(const ChunkKey &key) const {
+	std::lock_guard<std::mutex> guard(lock_);
+	auto it = entries_.find(key);
+	return it != entries_.end() && !it->second->loading;
+}
+
+uint64_t BufferManager::MemoryUsed() const {
+	std::lock_guard<std::mutex> guard(lock_);
+	return frames_used_ * frame_size_;
+}
+
+BufferStats BufferManager::Stats() const {
+	std::lock_guard<std::mutex> guard(lock_);
+	return stats_;
+}
+
+} // namespace electricdb
@@ -0,0 +1,137 @@
+#include "electricdb/storage/column/column_writer.h"
+#include "electricdb/storage/encoding/dictionary.h"
+#include "electricdb/storage/encoding/for.h"
+#include "electricdb/storage/encoding/plain.h"
+#include "electricdb/storage/encoding/rle.h"
+#include "electricdb/util/arena.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace electricdb {
+
+/**
+ * @brief Decode costs in nanoseconds per value, measured on 64K-row INT64 chunks on an AVX2 CPU.
+ * RLE also pays per run, for the loop that fills it.
+ */
+static constexpr double PLAIN_DECODE_NS = 0.25;
+static constexpr double FOR_DECODE_NS = 0.45;
+static constexpr double DICTIONARY_DECODE_NS = 1.0;
+static constexpr double RLE_DECODE_NS = 0.45;
+static constexpr double RLE_RUN_DECODE_NS = 1.2;
+static constexpr double DELTA_DECODE_NS = 1.8;
+
+static constexpr EncodingType CANDIDATES[] = {EncodingType::PLAIN, EncodingType::FOR,
+											  EncodingType::DICTIONARY, EncodingType::RLE,
+											  EncodingType::DELTA};
+
+/**
+ * @brief Distinct non-null values of a chunk, estimated from a sample of it (GEE estimator).
+ * Values the sample holds more than once are taken to be all there are of them, each value it
+ * holds once stands for sqrt(rows / sample rows) values of the chunk. Exact for an unsampled
+ * chunk. Values are told apart by their bits, as in a dictionary.
+ */
+static uint32_t EstimateEntries(const Vector &sample, uint32_t rows) {
+	const size_t elem_size = GetTypeSize(sample.Type());
+	const uint8_t *data = sample.RawData();
+	std::unordered_map<uint64_t, uint32_t> counts;
+	for (uint32_t i = 0; i < sample.Size(); i++) {
+		if (sample.HasNulls() && sample.IsNull(i))
+			continue;
+		uint64_t key = 0;
+		std::memcpy(&key, data + i * elem_size, elem_size);
+		counts[key]++;
+	}
+	uint32_t once = 0;
+	for (const auto &entry : counts)
+		once += entry.second == 1 ? 1 : 0;
+	const double entries = std::sqrt(static_cast<double>(rows) / sample.Size()) * once +
+						   static_cast<double>(counts.size() - once);
+	return static_cast<uint32_t>(std::min(std::round(entries), static_cast<double>(rows)));
+}
+
+ColumnWriter::ColumnWriter(LogicalType type, EncodingPolicy policy)
+	: type_(type), policy_(policy) {
+	/** Throws for types without a fixed width */
+	GetTypeSize(type_);
+	if (policy_.read_bytes_per_ns <= 0)
+		throw std::runtime_error("Read bandwidth must be positive!");
+}
+
+std::vector<EncodingEstimate> ColumnWriter::Estimate(const Vector &chunk) const {
+	if (chunk.Type() != type_)
+		throw std::runtime_error("Chunk does not match the column type!");
+	const uint32_t rows = chunk.Size();
+	std::vector<EncodingEstimate> estimates;
+	estimates.push_back({EncodingType::PLAIN, PlainEncoding::EncodedSize(type_, rows),
+						 PLAIN_DECODE_NS * rows});
+	if (rows == 0)
+		return estimates;
+
+	/** Blocks spread over the chunk, or the whole chunk if it is small */
+	Arena arena;
+	const uint32_t blocks = (rows + ForEncoding::BLOCK_SIZE - 1) / ForEncoding::BLOCK_SIZE;
+	const bool sampled = policy_.sample_blocks > 0 && blocks > policy_.sample_blocks;
+	const uint32_t sample_rows = sampled ? policy_.sample_blocks * ForEncoding::BLOCK_SIZE : 1;
+	Vector sampled_values(type_, sample_rows, arena);
+	if (sampled) {
+		sampled_values.SetSize(sample_rows);
+		for (uint32_t s = 0; s < policy_.sample_blocks; s++) {
+			/** Only the last block of the chunk may be partial, and it is never sampled */
+			const uint64_t block = uint64_t{blocks - 1} * s / policy_.sample_blocks;
+			sampled_values.Copy(chunk, static_cast<uint32_t>(block * ForEncoding::BLOCK_SIZE),
+								ForEncoding::BLOCK_SIZE, s * ForEncoding::BLOCK_SIZE);
+		}
+	}
+	const Vector *sample = sampled ? &sampled_values : &chunk;
+	const double scale = static_cast<double>(rows) / sample->Size();
+
+	for (EncodingType encoding : CANDIDATES) {
+		if (encoding == EncodingType::PLAIN || !EncodingSupports(encoding, type_))
+			continue;
+		EncodingEstimate estimate;
+		estimate.encoding = encoding;
+		if (encoding != EncodingType::DICTIONARY)
+			estimate.size = static_cast<size_t>(EncodedSize(encoding, *sample) * scale);
+		switch (encoding) {
+		case EncodingType::FOR:
+			estimate.decode_ns = FOR_DECODE_NS * rows;
+			break;
+		case EncodingType::DICTIONARY: {
+			/** The entries do not grow with the rows like the codes do */
+			const uint32_t entries = EstimateEntries(*sample, rows);
+			if (entries > DictionaryEncoding::MAX_ENTRIES)
+				continue;
+			estimate.size = DictionaryEncoding::EncodedSize(type_, rows, entries);
+			estimate.decode_ns = DICTIONARY_DECODE_NS * rows;
+			break;
+		}
+		case EncodingType::RLE:
+			estimate.decode_ns = RLE_DECODE_NS * rows +
+								 RLE_RUN_DECODE_NS * RleEncoding::RunCount(*sample) * scale;
+			break;
+		case EncodingType::DELTA:
+			estimate.decode_ns = DELTA_DECODE_NS * rows;
+			break;
+		default:
+			break;
+		}
+		estimates.push_back(estimate);
+	}
+	/** Stable, so of equal costs the earlier candidate (PLAIN first) wins */
+	std::stable_sort(estimates.begin(), estimates.end(),
+					 [this](const EncodingEstimate &a, const EncodingEstimate &b) {
+						 return a.Cost(policy_.read_bytes_per_ns) <
+								b.Cost(policy_.read_bytes_per_ns);
+					 });
+	return estimates;
+}
+
+EncodingType ColumnWriter::Choose(const Vector &chunk) const {
+	return Estimate(chunk).front().encoding;
+}
+
+} // namespace electricdb
@@ -0,0 +1,120 @@
+#include "electricdb/storage/column/zone_map.h"
+
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace electricdb {
+
+template <typename T>
+static void UpdateTyped(ZoneMap &zone, const Vector &vec) {
+	const T *data = vec.Data<T>();
+	const idx_t n = vec.Size();
+	const bool has_nulls = vec.HasNulls();
+
+	bool found = zone.HasValues();
+	T lo = found ? zone.min.Get<T>() : T{};
+	T hi = found ? zone.max.Get<T>() : T{};
+
+	for (idx_t i = 0; i < n; i++) {
+		if (has_nulls && vec.IsNull(i)) {
+			zone.has_nulls = true;
+			continue;
+		}
+		T value = data[i];
+		if constexpr (std::is_floating_point_v<T>) {
+			if (std::isnan(value)) {
+				zone.has_nan = true;
+				continue;
+			}
+			/** -0.0 == 0.0, keep the zero the sort key encoding also uses */
+			if (value == T(0))
+				value = T(0);
+		}
+		if (!found) {
+			lo = hi = value;
+			found = true;
+			continue;
+		}
+		lo = value < lo ? value : lo;
+		hi = value > hi ? value : hi;
+	}
+
+	if (found) {
+		zone.min.Set<T>(lo);
+		zone.max.Set<T>(hi);
+	}
+	zone.count += n;
+}
+
+void ZoneMap::Update(const Vector &vec) {
+#ifndef NDEBUG
+	assert(vec.Type() == Type());
+#endif
+	switch (vec.Type()) {
+	case LogicalType::INT32:
+		UpdateTyped<int32_t>(*this, vec);
+		break;
+	case LogicalType::INT64:
+		UpdateTyped<int64_t>(*this, vec);
+		break;
+	case LogicalType::FLOAT:
+		UpdateTyped<float>(*this, vec);
+		break;
+	case LogicalType::DOUBLE:
+		UpdateTyped<double>(*this, vec);
+		break;
+	case LogicalType::BOOL:
+		UpdateTyped<bool>(*this, vec);
+		break;
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+template <typename T>
+static void MergeTyped(ZoneMap &zone, const ZoneMap &other) {
+	if (!zone.HasValues()) {
+		zone.min = other.min;
+		zone.max = other.max;
+		return;
+	}
+	if (other.min.Get<T>() < zone.min.Get<T>())
+		zone.min.Set<T>(other.min.Get<T>());
+	if (other.max.Get<T>() > zone.max.Get<T>())
+		zone.max.Set<T>(other.max.Get<T>());
+}
+
+void ZoneMap::Merge(const ZoneMap &other) {
+#ifndef NDEBUG
+	assert(other.Type() == Type());
+#endif
+	has_nulls = has_nulls || other.has_nulls;
+	has_nan = has_nan || other.has_nan;
+	count += other.count;
+	if (!other.HasValues())
+		return;
+
+	switch (Type()) {
+	case LogicalType::INT32:
+		MergeTyped<int32_t>(*this, other);
+		break;
+	case LogicalType::INT64:
+		MergeTyped<int64_t>(*this, other);
+		break;
+	case LogicalType::FLOAT:
+		MergeTyped<float>(*this, other);
+		break;
+	case LogicalType::DOUBLE:
+		MergeTyped<double>(*this, other);
+		break;
+	case LogicalType::BOOL:
+		MergeTyped<bool>(*this, other);
+		break;
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+} // namespace electricdb
@@ -0,0 +1,321 @@
+#include "electricdb/storage/encoding/delta.h"
+#include "electricdb/storage/encoding/for.h"
+#include "electricdb/util/arena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace electricdb {
+
+static_assert(DeltaEncoding::PAGE_SIZE == ForEncoding::BLOCK_SIZE,
+			  "A page of deltas is packed as one block");
+
+static uint32_t PageCount(uint32_t count) {
+	return (count + DeltaEncoding::PAGE_SIZE - 1) / DeltaEncoding::PAGE_SIZE;
+}
+
+/** @brief Offset of the packed differences, behind the header and the page bases */
+static size_t PackedOffset(uint8_t order, uint32_t count) {
+	return DeltaEncoding::HEADER_SIZE + size_t{order} * PageCount(count) * sizeof(uint64_t);
+}
+
+/**
+ * @brief The values of `vec` widened to 64 bits. NULL rows continue the last delta and leading
+ * ones repeat the first non-null value, so they add no differences of their own.
+ */
+template <typename T>
+static std::vector<uint64_t> FilledValues(const Vector &vec) {
+	const T *data = vec.Data<T>();
+	std::vector<uint64_t> values(vec.Size());
+	uint64_t first = 0;
+	for (uint32_t i = 0; i < vec.Size(); i++) {
+		if (!vec.HasNulls() || !vec.IsNull(i)) {
+			first = static_cast<uint64_t>(static_cast<int64_t>(data[i]));
+			break;
+		}
+	}
+	for (uint32_t i = 0; i < vec.Size(); i++) {
+		if (!vec.HasNulls() || !vec.IsNull(i))
+			values[i] = static_cast<uint64_t>(static_cast<int64_t>(data[i]));
+		else if (i >= 2)
+			values[i] = 2 * values[i - 1] - values[i - 2];
+		else
+			values[i] = i == 1 ? values[0] : first;
+	}
+	return values;
+}
+
+static std::vector<uint64_t> FilledValues(const Vector &vec) {
+	switch (vec.Type()) {
+	case LogicalType::INT32:
+		return FilledValues<int32_t>(vec);
+	case LogicalType::INT64:
+		return FilledValues<int64_t>(vec);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+/** @brief Check if the values, read back as T, never decrease */
+template <typename T>
+static bool NonDecreasing(const std::vector<uint64_t> &values) {
+	for (size_t i = 1; i < values.size(); i++) {
+		if (static_cast<T>(static_cast<int64_t>(values[i])) <
+			static_cast<T>(static_cast<int64_t>(values[i - 1])))
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Differences of `order` of every page. The first row of a page (and for order 2 the
+ * second row) is covered by the page bases.
+ *
+ * @param bases Receives `order` bases per page, the first value and for order 2 the first delta
+ */
+static void Differences(const std::vector<uint64_t> &values, uint8_t order, Vector &out,
+						uint64_t *bases) {
+	const auto count = static_cast<uint32_t>(values.size());
+	auto *diffs = reinterpret_cast<uint64_t *>(out.Data<int64_t>());
+	for (uint32_t page = 0; page < PageCount(count); page++) {
+		const uint32_t start = page * DeltaEncoding::PAGE_SIZE;
+		const uint32_t end = std::min(count, start + DeltaEncoding::PAGE_SIZE);
+		/** Rows covered by the bases repeat the next difference, they must not widen the rest */
+		const uint32_t first = std::min(start + order, end);
+		if (order == 1) {
+			bases[page] = values[start];
+			for (uint32_t i = first; i < end; i++)
+				diffs[i] = values[i] - values[i - 1];
+		} else {
+			bases[2 * page] = values[start];
+			bases[2 * page + 1] = end - start > 1 ? values[start + 1] - values[start] : 0;
+			for (uint32_t i = first; i < end; i++)
+				diffs[i] = (values[i] - values[i - 1]) - (values[i - 1] - values[i - 2]);
+		}
+		for (uint32_t i = start; i < first; i++)
+			diffs[i] = first < end ? diffs[first] : 0;
+	}
+	out.SetSize(count);
+}
+
+/** @brief Packed size of the differences of `order` */
+static size_t PackedSize(const std::vector<uint64_t> &values, uint8_t order) {
+	Arena arena;
+	const auto count = static_cast<uint32_t>(values.size());
+	Vector diffs(LogicalType::INT64, std::max<uint32_t>(count, 1), arena);
+	std::vector<uint64_t> bases(size_t{order} * PageCount(count));
+	Differences(values, order, diffs, bases.data());
+	return ForEncoding::EncodedSize(diffs);
+}
+
+static void PrefixSumPortable(uint64_t *values, uint32_t count) {
+	for (uint32_t i = 1; i < count; i++)
+		values[i] += values[i - 1];
+}
+
+#if defined(__x86_64__)
+/**
+ * @brief Running sum four values at a time: two shifted adds turn a register into its own prefix
+ * sums, then the total of everything before it is added from the last lane of the previous one
+ */
+__attribute__((target("avx2"))) static void PrefixSumAvx2(uint64_t *values, uint32_t count) {
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i carry = zero;
+	uint32_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		auto *p = reinterpret_cast<__m256i *>(values + i);
+		__m256i x = _mm256_loadu_si256(p);
+		/** [a, b, c, d] + [0, a, b, c] */
+		x = _mm256_add_epi64(
+				x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x90), zero, 0x03));
+		/** + [0, 0, a, a + b] */
+		x = _mm256_add_epi64(
+				x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x40), zero, 0x0F));
+		x = _mm256_add_epi64(x, carry);
+		_mm256_storeu_si256(p, x);
+		carry = _mm256_permute4x64_epi64(x, 0xFF);
+	}
+	uint64_t total = i ? values[i - 1] : 0;
+	for (; i < count; i++) {
+		total += values[i];
+		values[i] = total;
+	}
+}
+#endif
+
+void DeltaEncoding::PrefixSum(uint64_t *values, uint32_t count) {
+#if defined(__x86_64__)
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	if (avx2)
+		return PrefixSumAvx2(values, count);
+#endif
+	PrefixSumPortable(values, count);
+}
+
+/**
+ * @brief Decode the first `rows` values of page `page` into `out`, which holds PAGE_SIZE values:
+ * unpack the differences, put the bases in front and sum up once per order
+ */
+static void DecodePage(const uint8_t *data, uint32_t count, uint32_t page, uint32_t rows,
+					   uint64_t *out) {
+	const uint8_t order = DeltaEncoding::Order(data);
+	const auto *bases = reinterpret_cast<const uint64_t *>(data + DeltaEncoding::HEADER_SIZE);
+	ForEncoding::DecodeBlock(data + PackedOffset(order, count), page,
+							 reinterpret_cast<int64_t *>(out));
+	if (order == 2) {
+		/** Sum the delta-of-deltas up to deltas: d[0] = 0, d[1] = the base delta */
+		out[0] = 0;
+		if (rows > 1)
+			out[1] = bases[2 * page + 1];
+		DeltaEncoding::PrefixSum(out, rows);
+		out[0] = bases[2 * page];
+	} else {
+		out[0] = bases[page];
+	}
+	DeltaEncoding::PrefixSum(out, rows);
+}
+
+template <typename T>
+static void DecodeRows(const uint8_t *data, uint32_t count, uint32_t begin, uint32_t end,
+					   Vector &out) {
+	T *values = out.Data<T>();
+	uint64_t page_values[DeltaEncoding::PAGE_SIZE];
+	uint32_t row = begin;
+	while (row < end) {
+		const uint32_t page = row / DeltaEncoding::PAGE_SIZE;
+		const uint32_t start = page * DeltaEncoding::PAGE_SIZE;
+		const uint32_t stop = std::min(end, start + DeltaEncoding::PAGE_SIZE);
+		DecodePage(data, count, page, stop - start, page_values);
+		for (; row < stop; row++)
+			values[row - begin] = static_cast<T>(static_cast<int64_t>(page_values[row - start]));
+	}
+	out.SetSize(end - begin);
+}
+
+template <typename T>
+static Value MakeValue(T v) {
+	Value value;
+	value.SetType(LogicalTypeTrait<T>::type);
+	value.Set<T>(v);
+	return value;
+}
+
+template <typename T>
+static idx_t SelectRows(const uint8_t *data, uint32_t count, const ColumnPredicate &predicate,
+						const uint8_t *nulls, SelectionVector &sel) {
+	const auto *bases = reinterpret_cast<const uint64_t *>(data + DeltaEncoding::HEADER_SIZE);
+	const uint8_t order = DeltaEncoding::Order(data);
+	const bool sorted = DeltaEncoding::Sorted(data);
+	const uint32_t pages = PageCount(count);
+	sel_t *rows = sel.Data();
+	uint64_t page_values[DeltaEncoding::PAGE_SIZE];
+	idx_t selected = 0;
+	for (uint32_t page = 0; page < pages; page++) {
+		/** Sorted pages hold values between their base and the base of the next page */
+		if (sorted) {
+			const auto min = static_cast<T>(static_cast<int64_t>(bases[order * page]));
+			const T max = page + 1 < pages
+								  ? static_cast<T>(static_cast<int64_t>(bases[order * (page + 1)]))
+								  : std::numeric_limits<T>::max();
+			if (!predicate.MayMatch(MakeValue(min), MakeValue(max)))
+				continue;
+		}
+		const uint32_t start = page * DeltaEncoding::PAGE_SIZE;
+		const uint32_t n = std::min(DeltaEncoding::PAGE_SIZE, count - start);
+		DecodePage(data, count, page, n, page_values);
+		for (uint32_t i = 0; i < n; i++) {
+			const uint32_t row = start + i;
+			const bool null = nulls && (nulls[row / 8] & (1U << (row % 8)));
+			rows[selected] = row;
+			const auto value = static_cast<T>(static_cast<int64_t>(page_values[i]));
+			selected += !null && predicate.Matches(value) ? 1 : 0;
+		}
+	}
+	return selected;
+}
+
+uint8_t DeltaEncoding::BestOrder(const Vector &vec) {
+	const std::vector<uint64_t> values = FilledValues(vec);
+	/** Order 2 stores a second base per page */
+	const size_t second = PackedSize(values, 2) + PageCount(vec.Size()) * sizeof(uint64_t);
+	return second < PackedSize(values, 1) ? 2 : 1;
+}
+
+size_t DeltaEncoding::EncodedSize(const Vector &vec, uint8_t order) {
+	if (order != 1 && order != 2)
+		throw std::runtime_error("Delta order must be 1 or 2!");
+	return PackedOffset(order, vec.Size()) + PackedSize(FilledValues(vec), order);
+}
+
+void DeltaEncoding::Encode(const Vector &vec, uint8_t *out) {
+	const std::vector<uint64_t> values = FilledValues(vec);
+	const uint8_t order = BestOrder(vec);
+	const uint32_t count = vec.Size();
+
+	const bool sorted = vec.Type() == LogicalType::INT32 ? NonDecreasing<int32_t>(values)
+														 : NonDecreasing<int64_t>(values);
+
+	std::memset(out, 0, HEADER_SIZE);
+	out[0] = order;
+	out[1] = static_cast<uint8_t>(GetTypeSize(vec.Type()));
+	out[2] = sorted ? 1 : 0;
+
+	Arena arena;
+	Vector diffs(LogicalType::INT64, std::max<uint32_t>(count, 1), arena);
+	Differences(values, order, diffs, reinterpret_cast<uint64_t *>(out + HEADER_SIZE));
+	ForEncoding::Encode(diffs, out + PackedOffset(order, count));
+}
+
+bool DeltaEncoding::CheckSize(const uint8_t *data, size_t size, LogicalType type,
+							  uint32_t count) {
+	if (!Supports(type) || size < HEADER_SIZE)
+		return false;
+	const uint8_t order = Order(data);
+	if ((order != 1 && order != 2) || data[1] != GetTypeSize(type) || data[2] > 1)
+		return false;
+	const size_t offset = PackedOffset(order, count);
+	return size >= offset &&
+		   ForEncoding::CheckSize(data + offset, size - offset, LogicalType::INT64, count);
+}
+
+void DeltaEncoding::Decode(const uint8_t *data, uint32_t count, Vector &out) {
+	DecodeRange(data, count, 0, count, out);
+}
+
+void DeltaEncoding::DecodeRange(const uint8_t *data, uint32_t count, uint32_t begin,
+								uint32_t end, Vector &out) {
+#ifndef NDEBUG
+	assert(begin <= end && end <= count && end - begin <= out.Capacity());
+#endif
+	switch (out.Type()) {
+	case LogicalType::INT32:
+		return DecodeRows<int32_t>(data, count, begin, end, out);
+	case LogicalType::INT64:
+		return DecodeRows<int64_t>(data, count, begin, end, out);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+idx_t DeltaEncoding::Select(const uint8_t *data, LogicalType type, uint32_t count,
+							const ColumnPredicate &predicate, const uint8_t *nulls,
+							SelectionVector &sel) {
+	if (!predicate.Fits(type))
+		throw std::runtime_error("Predicate does not match the column type!");
+	switch (type) {
+	case LogicalType::INT32:
+		return SelectRows<int32_t>(data, count, predicate, nulls, sel);
+	case LogicalType::INT64:
+		return SelectRows<int64_t>(data, count, predicate, nulls, sel);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+} // namespace electricdb
@@ -0,0 +1,355 @@
+#include "electricdb/storage/encoding/dictionary.h"
+#include "electricdb/storage/encoding/for.h"
+#include "electricdb/util/arena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_set>
+
+namespace electricdb {
+
+template <typename T>
+using KeyType = std::conditional_t<sizeof(T) == 8, uint64_t,
+								   std::conditional_t<sizeof(T) == 4, uint32_t, uint8_t>>;
+
+/**
+ * @brief Unsigned key that orders like the value (ignoring NaN) and that is equal only for values
+ * with identical bits, so 0.0 and -0.0 stay apart
+ */
+template <typename T>
+static KeyType<T> SortKey(T value) {
+	using K = KeyType<T>;
+	K bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	if constexpr (std::is_same_v<T, bool>) {
+		return bits;
+	} else {
+		constexpr K sign = K{1} << (8 * sizeof(K) - 1);
+		if constexpr (std::is_integral_v<T>)
+			return bits ^ sign;
+		else
+			/** Negative floats order reversed by their bits, flip all of them */
+			return (bits & sign) ? static_cast<K>(~bits) : static_cast<K>(bits | sign);
+	}
+}
+
+/** @brief Distinct non-null values of `vec` sorted by SortKey(), at most `limit` of them */
+template <typename T>
+static std::vector<T> BuildDictionary(const Vector &vec, uint32_t limit) {
+	const T *values = vec.Data<T>();
+	std::unordered_set<KeyType<T>> seen;
+	std::vector<T> entries;
+	for (uint32_t i = 0; i < vec.Size() && entries.size() < limit; i++) {
+		if (vec.HasNulls() && vec.IsNull(i))
+			continue;
+		if (seen.insert(SortKey(values[i])).second)
+			entries.push_back(values[i]);
+	}
+	std::sort(entries.begin(), entries.end(),
+			  [](T a, T b) { return SortKey(a) < SortKey(b); });
+	return entries;
+}
+
+/** @brief Bits of the codes of a dictionary of `entries` entries */
+static uint8_t CodeWidth(uint32_t entries) {
+	uint8_t width = 0;
+	for (uint32_t rest = entries > 1 ? entries - 1 : 0; rest; rest >>= 1)
+		width++;
+	return width;
+}
+
+/** @brief Offset of the packed codes, behind the header and the padded entries */
+static size_t CodesOffset(uint32_t entries, size_t entry_size) {
+	return DictionaryEncoding::HEADER_SIZE + ((entries * entry_size + 7) & ~size_t{7});
+}
+
+static const uint8_t *CodesOf(const uint8_t *data) {
+	return data + CodesOffset(DictionaryEncoding::EntryCount(data), data[sizeof(uint32_t)]);
+}
+
+template <typename T>
+static DictionaryEntries CollectEntries(const Vector &vec) {
+	const std::vector<T> values = BuildDictionary<T>(vec, DictionaryEncoding::MAX_ENTRIES + 1);
+	DictionaryEntries entries;
+	entries.type = vec.Type();
+	entries.count = static_cast<uint32_t>(values.size());
+	/** One entry at a time, std::vector<bool> has no contiguous data */
+	entries.values.resize(values.size() * sizeof(T));
+	for (size_t i = 0; i < values.size(); i++) {
+		const T value = values[i];
+		std::memcpy(entries.values.data() + i * sizeof(T), &value, sizeof(T));
+	}
+	return entries;
+}
+
+template <typename T>
+static void EncodeValues(const Vector &vec, const DictionaryEntries &dictionary, uint8_t *out) {
+	const uint32_t size = dictionary.count;
+	const size_t offset = CodesOffset(size, sizeof(T));
+	std::memset(out, 0, offset);
+	std::memcpy(out, &size, sizeof(size));
+	out[sizeof(size)] = sizeof(T);
+
+	std::memcpy(out + DictionaryEncoding::HEADER_SIZE, dictionary.values.data(),
+				dictionary.values.size());
+	std::vector<KeyType<T>> keys;
+	keys.reserve(size);
+	for (uint32_t i = 0; i < size; i++) {
+		T entry;
+		std::memcpy(&entry, dictionary.values.data() + i * sizeof(T), sizeof(T));
+		keys.push_back(SortKey(entry));
+	}
+
+	Arena arena;
+	const uint32_t count = vec.Size();
+	Vector codes(LogicalType::INT32, std::max<uint32_t>(count, 1), arena);
+	int32_t *code = codes.Data<int32_t>();
+	const T *values = vec.Data<T>();
+	for (uint32_t i = 0; i < count; i++) {
+		if (vec.HasNulls() && vec.IsNull(i)) {
+			code[i] = 0;
+			continue;
+		}
+		const auto it = std::lower_bound(keys.begin(), keys.end(), SortKey(values[i]));
+		code[i] = static_cast<int32_t>(it - keys.begin());
+	}
+	codes.SetSize(count);
+	ForEncoding::Encode(codes, out + offset);
+}
+
+template <typename T>
+static void DecodeValues(const uint8_t *data, uint32_t count, Vector &out) {
+	const auto *entries = reinterpret_cast<const T *>(data + DictionaryEncoding::HEADER_SIZE);
+	const uint8_t *packed = CodesOf(data);
+	T *values = out.Data<T>();
+
+	int32_t codes[ForEncoding::BLOCK_SIZE];
+	for (uint32_t start = 0; start < count; start += ForEncoding::BLOCK_SIZE) {
+		ForEncoding::DecodeBlock(packed, start / ForEncoding::BLOCK_SIZE, codes);
+		const uint32_t n = std::min(ForEncoding::BLOCK_SIZE, count - start);
+		for (uint32_t i = 0; i < n; i++)
+			values[start + i] = entries[codes[i]];
+	}
+	out.SetSize(count);
+}
+
+template <typename T>
+static void DecodeEntries(const uint8_t *data, Vector &entries) {
+	const uint32_t size = DictionaryEncoding::EntryCount(data);
+	std::memcpy(entries.Data<T>(), data + DictionaryEncoding::HEADER_SIZE, size * sizeof(T));
+	entries.SetSize(size);
+}
+
+template <typename T>
+static CodeSet QualifyingEntries(const uint8_t *data, const ColumnPredicate &predicate) {
+	const auto *entries = reinterpret_cast<const T *>(data + DictionaryEncoding::HEADER_SIZE);
+	CodeSet codes;
+	codes.qualifies.resize(DictionaryEncoding::EntryCount(data));
+	for (size_t i = 0; i < codes.qualifies.size(); i++) {
+		codes.qualifies[i] = predicate.Matches(entries[i]) ? 1 : 0;
+		codes.count += codes.qualifies[i];
+	}
+	return codes;
+}
+
+uint32_t DictionaryEncoding::DistinctCount(const Vector &vec) {
+	switch (vec.Type()) {
+	case LogicalType::INT32:
+		return BuildDictionary<int32_t>(vec, MAX_ENTRIES + 1).size();
+	case LogicalType::INT64:
+		return BuildDictionary<int64_t>(vec, MAX_ENTRIES + 1).size();
+	case LogicalType::FLOAT:
+		return BuildDictionary<float>(vec, MAX_ENTRIES + 1).size();
+	case LogicalType::DOUBLE:
+		return BuildDictionary<double>(vec, MAX_ENTRIES + 1).size();
+	case LogicalType::BOOL:
+		return BuildDictionary<bool>(vec, MAX_ENTRIES + 1).size();
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+DictionaryEntries DictionaryEncoding::BuildEntries(const Vector &vec) {
+	switch (vec.Type()) {
+	case LogicalType::INT32:
+		return CollectEntries<int32_t>(vec);
+	case LogicalType::INT64:
+		return CollectEntries<int64_t>(vec);
+	case LogicalType::FLOAT:
+		return CollectEntries<float>(vec);
+	case LogicalType::DOUBLE:
+		return CollectEntries<double>(vec);
+	case LogicalType::BOOL:
+		return CollectEntries<bool>(vec);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+size_t DictionaryEncoding::EncodedSize(const Vector &vec) {
+	return EncodedSize(vec.Type(), vec.Size(), DistinctCount(vec));
+}
+
+size_t DictionaryEncoding::EncodedSize(LogicalType type, uint32_t count, uint32_t entries) {
+	return CodesOffset(entries, GetTypeSize(type)) +
+		   ForEncoding::EncodedSize(count, CodeWidth(entries));
+}
+
+void DictionaryEncoding::Encode(const Vector &vec, uint8_t *out) {
+	Encode(vec, BuildEntries(vec), out);
+}
+
+void DictionaryEncoding::Encode(const Vector &vec, const DictionaryEntries &entries,
+								uint8_t *out) {
+	if (entries.type != vec.Type())
+		throw std::runtime_error("Dictionary does not match the column type!");
+	if (entries.count > MAX_ENTRIES)
+		throw std::runtime_error("Too many distinct values for a dictionary!");
+	switch (vec.Type()) {
+	case LogicalType::INT32:
+		return EncodeValues<int32_t>(vec, entries, out);
+	case LogicalType::INT64:
+		return EncodeValues<int64_t>(vec, entries, out);
+	case LogicalType::FLOAT:
+		return EncodeValues<float>(vec, entries, out);
+	case LogicalType::DOUBLE:
+		return EncodeValues<double>(vec, entries, out);
+	case LogicalType::BOOL:
+		return EncodeValues<bool>(vec, entries, out);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+bool DictionaryEncoding::CheckSize(const uint8_t *data, size_t size, LogicalType type,
+								   uint32_t count) {
+	if (!Supports(type) || size < HEADER_SIZE)
+		return false;
+	const uint32_t entries = EntryCount(data);
+	if (entries > MAX_ENTRIES || data[sizeof(uint32_t)] != GetTypeSize(type))
+		return false;
+	const size_t offset = CodesOffset(entries, GetTypeSize(type));
+	return size >= offset &&
+		   ForEncoding::CheckSize(data + offset, size - offset, LogicalType::INT32, count);
+}
+
+uint32_t DictionaryEncoding::EntryCount(const uint8_t *data) noexcept {
+	uint32_t entries;
+	std::memcpy(&entries, data, sizeof(entries));
+	return entries;
+}
+
+void DictionaryEncoding::Decode(const uint8_t *data, uint32_t count, Vector &out) {
+#ifndef NDEBUG
+	assert(count <= out.Capacity());
+#endif
+	switch (out.Type()) {
+	case LogicalType::INT32:
+		return DecodeValues<int32_t>(data, count, out);
+	case LogicalType::INT64:
+		return DecodeValues<int64_t>(data, count, out);
+	case LogicalType::FLOAT:
+		return DecodeValues<float>(data, count, out);
+	case LogicalType::DOUBLE:
+		return DecodeValues<double>(data, count, out);
+	case LogicalType::BOOL:
+		return DecodeValues<bool>(data, count, out);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+void DictionaryEncoding::DecodeCodes(const uint8_t *data, uint32_t count, Vector &entries,
+									 sel_t *codes) {
+#ifndef NDEBUG
+	assert(EntryCount(data) <= entries.Capacity());
+#endif
+	entries.Reset();
+	switch (entries.Type()) {
+	case LogicalType::INT32:
+		DecodeEntries<int32_t>(data, entries);
+		break;
+	case LogicalType::INT64:
+		DecodeEntries<int64_t>(data, entries);
+		break;
+	case LogicalType::FLOAT:
+		DecodeEntries<float>(data, entries);
+		break;
+	case LogicalType::DOUBLE:
+		DecodeEntries<double>(data, entries);
+		break;
+	case LogicalType::BOOL:
+		DecodeEntries<bool>(data, entries);
+		break;
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+
+	const uint8_t *packed = CodesOf(data);
+	int32_t block[ForEncoding::BLOCK_SIZE];
+	for (uint32_t start = 0; start < count; start += ForEncoding::BLOCK_SIZE) {
+		ForEncoding::DecodeBlock(packed, start / ForEncoding::BLOCK_SIZE, block);
+		const uint32_t n = std::min(ForEncoding::BLOCK_SIZE, count - start);
+		for (uint32_t i = 0; i < n; i++)
+			codes[start + i] = static_cast<sel_t>(block[i]);
+	}
+}
+
+CodeSet DictionaryEncoding::QualifyingCodes(const uint8_t *data, LogicalType type,
+											const ColumnPredicate &predicate) {
+	if (!predicate.Fits(type))
+		throw std::runtime_error("Predicate does not match the column type!");
+	switch (type) {
+	case LogicalType::INT32:
+		return QualifyingEntries<int32_t>(data, predicate);
+	case LogicalType::INT64:
+		return QualifyingEntries<int64_t>(data, predicate);
+	case LogicalType::FLOAT:
+		return QualifyingEntries<float>(data, predicate);
+	case LogicalType::DOUBLE:
+		return QualifyingEntries<double>(data, predicate);
+	case LogicalType::BOOL:
+		return QualifyingEntries<bool>(data, predicate);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+idx_t DictionaryEncoding::Select(const uint8_t *data, uint32_t count, const CodeSet &codes,
+								 const uint8_t *nulls, SelectionVector &sel) {
+	sel_t *rows = sel.Data();
+	if (codes.None())
+		return 0;
+	if (codes.All() && !nulls) {
+		for (uint32_t i = 0; i < count; i++)
+			rows[i] = i;
+		return count;
+	}
+
+	const uint8_t *packed = CodesOf(data);
+	const uint8_t *qualifies = codes.qualifies.data();
+	int32_t block[ForEncoding::BLOCK_SIZE];
+	idx_t selected = 0;
+	for (uint32_t start = 0; start < count; start += ForEncoding::BLOCK_SIZE) {
+		ForEncoding::DecodeBlock(packed, start / ForEncoding::BLOCK_SIZE, block);
+		const uint32_t n = std::min(ForEncoding::BLOCK_SIZE, count - start);
+		/** Every row is written, only qualifying ones are kept: no branch per row */
+		if (nulls) {
+			for (uint32_t i = 0; i < n; i++) {
+				const uint32_t row = start + i;
+				rows[selected] = row;
+				selected += qualifies[block[i]] & ~(nulls[row / 8] >> (row % 8)) & 1;
+			}
+		} else {
+			for (uint32_t i = 0; i < n; i++) {
+				rows[selected] = start + i;
+				selected += qualifies[block[i]];
+			}
+		}
+	}
+	return selected;
+}
+
+} // namespace electricdb
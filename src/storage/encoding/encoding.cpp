@@ -0,0 +1,151 @@
+#include "electricdb/storage/encoding/encoding.h"
+#include "electricdb/storage/encoding/delta.h"
+#include "electricdb/storage/encoding/dictionary.h"
+#include "electricdb/storage/encoding/for.h"
+#include "electricdb/storage/encoding/plain.h"
+#include "electricdb/storage/encoding/rle.h"
+
+#include <stdexcept>
+
+namespace electricdb {
+
+const char *EncodingTypeName(EncodingType type) {
+	switch (type) {
+	case EncodingType::PLAIN:
+		return "plain";
+	case EncodingType::FOR:
+		return "for";
+	case EncodingType::DICTIONARY:
+		return "dictionary";
+	case EncodingType::RLE:
+		return "rle";
+	case EncodingType::DELTA:
+		return "delta";
+	}
+	return "unknown";
+}
+
+bool EncodingSupports(EncodingType encoding, LogicalType type) noexcept {
+	switch (encoding) {
+	case EncodingType::PLAIN:
+		return type != LogicalType::STRING && type != LogicalType::INVALID;
+	case EncodingType::FOR:
+		return ForEncoding::Supports(type);
+	case EncodingType::DICTIONARY:
+		return DictionaryEncoding::Supports(type);
+	case EncodingType::RLE:
+		return RleEncoding::Supports(type);
+	case EncodingType::DELTA:
+		return DeltaEncoding::Supports(type);
+	}
+	return false;
+}
+
+bool CanEncode(EncodingType encoding, const Vector &vec) {
+	if (!EncodingSupports(encoding, vec.Type()))
+		return false;
+	return encoding != EncodingType::DICTIONARY || DictionaryEncoding::CanEncode(vec);
+}
+
+size_t EncodedSize(EncodingType encoding, const Vector &vec) {
+	switch (encoding) {
+	case EncodingType::PLAIN:
+		return PlainEncoding::EncodedSize(vec.Type(), vec.Size());
+	case EncodingType::FOR:
+		return ForEncoding::EncodedSize(vec);
+	case EncodingType::DICTIONARY:
+		return DictionaryEncoding::EncodedSize(vec);
+	case EncodingType::RLE:
+		return RleEncoding::EncodedSize(vec);
+	case EncodingType::DELTA:
+		return DeltaEncoding::EncodedSize(vec);
+	}
+	throw std::runtime_error("Unknown encoding!");
+}
+
+void EncodeValues(EncodingType encoding, const Vector &vec, uint8_t *out) {
+	switch (encoding) {
+	case EncodingType::PLAIN:
+		return PlainEncoding::Encode(vec, out);
+	case EncodingType::FOR:
+		return ForEncoding::Encode(vec, out);
+	case EncodingType::DICTIONARY:
+		return DictionaryEncoding::Encode(vec, out);
+	case EncodingType::RLE:
+		return RleEncoding::Encode(vec, out);
+	case EncodingType::DELTA:
+		return DeltaEncoding::Encode(vec, out);
+	}
+	throw std::runtime_error("Unknown encoding!");
+}
+
+bool CheckEncodedSize(EncodingType encoding, LogicalType type, const uint8_t *data, size_t size,
+					  uint32_t count) {
+	switch (encoding) {
+	case EncodingType::PLAIN:
+		return EncodingSupports(encoding, type) &&
+			   size == PlainEncoding::EncodedSize(type, count);
+	case EncodingType::FOR:
+		return ForEncoding::CheckSize(data, size, type, count);
+	case EncodingType::DICTIONARY:
+		return DictionaryEncoding::CheckSize(data, size, type, count);
+	case EncodingType::RLE:
+		return RleEncoding::CheckSize(data, size, type, count);
+	case EncodingType::DELTA:
+		return DeltaEncoding::CheckSize(data, size, type, count);
+	}
+	return false;
+}
+
+void DecodeValues(EncodingType encoding, const uint8_t *data, uint32_t count, Vector &out) {
+	switch (encoding) {
+	case EncodingType::PLAIN:
+		return PlainEncoding::Decode(data, count, out);
+	case EncodingType::FOR:
+		return ForEncoding::Decode(data, count, out);
+	case EncodingType::DICTIONARY:
+		return DictionaryEncoding::Decode(data, count, out);
+	case EncodingType::RLE:
+		return RleEncoding::Decode(data, count, out);
+	case EncodingType::DELTA:
+		return DeltaEncoding::Decode(data, count, out);
+	}
+	throw std::runtime_error("Unknown encoding!");
+}
+
+template <typename T>
+static bool MayMatchTyped(const ColumnPredicate &predicate, T min, T max) {
+	switch (predicate.kind) {
+	case ColumnPredicate::Kind::EQUAL:
+	case ColumnPredicate::Kind::IN:
+		return std::any_of(predicate.values.begin(), predicate.values.end(),
+						   [&](const Value &v) {
+							   return !v.IsNull() && v.Get<T>() >= min && v.Get<T>() <= max;
+						   });
+	case ColumnPredicate::Kind::RANGE:
+		return (predicate.values[0].IsNull() || predicate.values[0].Get<T>() <= max) &&
+			   (predicate.values[1].IsNull() || predicate.values[1].Get<T>() >= min);
+	}
+	return true;
+}
+
+bool ColumnPredicate::MayMatch(const Value &min, const Value &max) const {
+	if (min.IsNull() || max.IsNull())
+		return false;
+	switch (min.Type()) {
+	case LogicalType::INT32:
+		return MayMatchTyped(*this, min.Get<int32_t>(), max.Get<int32_t>());
+	case LogicalType::INT64:
+		return MayMatchTyped(*this, min.Get<int64_t>(), max.Get<int64_t>());
+	case LogicalType::FLOAT:
+		return MayMatchTyped(*this, min.Get<float>(), max.Get<float>());
+	case LogicalType::DOUBLE:
+		return MayMatchTyped(*this, min.Get<double>(), max.Get<double>());
+	case LogicalType::BOOL:
+		return MayMatchTyped(*this, min.Get<bool>(), max.Get<bool>());
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+} // namespace electricdb
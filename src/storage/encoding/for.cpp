@@ -0,0 +1,324 @@
+#include "electricdb/storage/encoding/for.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace electricdb {
+
+/**
+ * @brief Block layout for words of type U with B bits: LANES = BLOCK_SIZE / B lanes of B values.
+ * Value i sits in lane i % LANES at row i / LANES, and the bits of row r of a lane start at bit
+ * r * width of the lane. Word w of a lane is stored at w * LANES + lane, so a block packed at
+ * `width` bits is width * LANES words.
+ */
+template <typename U>
+struct PackedLayout {
+	static constexpr unsigned BITS = 8 * sizeof(U);
+	static constexpr unsigned LANES = ForEncoding::BLOCK_SIZE / BITS;
+	static constexpr unsigned ROWS = BITS;
+};
+
+/** @brief Lowest `width` bits set */
+template <typename U>
+static constexpr U LowMask(unsigned width) {
+	return width >= 8 * sizeof(U) ? ~U{0} : static_cast<U>((U{1} << width) - 1);
+}
+
+template <typename U>
+static void PackBlock(const U *in, unsigned width, U *out) {
+	using Layout = PackedLayout<U>;
+	std::memset(out, 0, static_cast<size_t>(width) * Layout::LANES * sizeof(U));
+	if (width == 0)
+		return;
+	for (unsigned r = 0; r < Layout::ROWS; r++) {
+		const unsigned bit = r * width;
+		U *word = out + (bit / Layout::BITS) * Layout::LANES;
+		const unsigned shift = bit % Layout::BITS;
+		for (unsigned lane = 0; lane < Layout::LANES; lane++) {
+			const U value = in[r * Layout::LANES + lane];
+			word[lane] |= static_cast<U>(value << shift);
+			if (shift + width > Layout::BITS)
+				word[lane + Layout::LANES] |= static_cast<U>(value >> (Layout::BITS - shift));
+		}
+	}
+}
+
+/**
+ * @brief Unpack a block at a fixed width and add the reference. Every statement of the lane loops
+ * applies to all lanes alike, so the compiler turns them into SIMD shifts, masks and adds of the
+ * instruction set the caller is compiled for. The restrict pointers spare the vectorizer the
+ * runtime overlap checks that -O2 would otherwise not vectorize for.
+ */
+template <typename U, unsigned W>
+__attribute__((always_inline)) static inline void UnpackBlock(const U *__restrict in, U base,
+															  U *__restrict out) {
+	using Layout = PackedLayout<U>;
+	if constexpr (W == 0) {
+		for (unsigned i = 0; i < ForEncoding::BLOCK_SIZE; i++)
+			out[i] = base;
+	} else {
+		constexpr U mask = LowMask<U>(W);
+		for (unsigned r = 0; r < Layout::ROWS; r++) {
+			const unsigned bit = r * W;
+			const U *word = in + (bit / Layout::BITS) * Layout::LANES;
+			const unsigned shift = bit % Layout::BITS;
+			U *dst = out + r * Layout::LANES;
+			if (shift + W <= Layout::BITS) {
+				for (unsigned lane = 0; lane < Layout::LANES; lane++)
+					dst[lane] = static_cast<U>(base + ((word[lane] >> shift) & mask));
+			} else {
+				/** The row straddles two words of the lane */
+				const unsigned carry = Layout::BITS - shift;
+				for (unsigned lane = 0; lane < Layout::LANES; lane++) {
+					const U value = static_cast<U>((word[lane] >> shift) |
+												   (word[lane + Layout::LANES] << carry));
+					dst[lane] = static_cast<U>(base + (value & mask));
+				}
+			}
+		}
+	}
+}
+
+template <typename U>
+using UnpackFunction = void (*)(const U *, U, U *);
+
+template <typename U, unsigned W>
+static void UnpackPortable(const U *in, U base, U *out) {
+	UnpackBlock<U, W>(in, base, out);
+}
+
+template <typename U, unsigned... W>
+static std::array<UnpackFunction<U>, sizeof...(W)> PortableKernels(
+		std::integer_sequence<unsigned, W...>) {
+	return {&UnpackPortable<U, W>...};
+}
+
+#if defined(__x86_64__)
+template <typename U, unsigned W>
+__attribute__((target("avx2"))) static void UnpackAvx2(const U *in, U base, U *out) {
+	UnpackBlock<U, W>(in, base, out);
+}
+
+template <typename U, unsigned... W>
+static std::array<UnpackFunction<U>, sizeof...(W)> Avx2Kernels(
+		std::integer_sequence<unsigned, W...>) {
+	return {&UnpackAvx2<U, W>...};
+}
+#endif
+
+/** @brief Unpack kernel for every width 0..B, chosen once for the CPU */
+template <typename U>
+static const std::array<UnpackFunction<U>, PackedLayout<U>::BITS + 1> &Kernels() {
+	using Widths = std::make_integer_sequence<unsigned, PackedLayout<U>::BITS + 1>;
+#if defined(__x86_64__)
+	static const auto kernels = __builtin_cpu_supports("avx2") ? Avx2Kernels<U>(Widths{})
+															   : PortableKernels<U>(Widths{});
+#else
+	static const auto kernels = PortableKernels<U>(Widths{});
+#endif
+	return kernels;
+}
+
+/** @brief Packed offset of value `index` of a block */
+template <typename U>
+static U Extract(const U *block, unsigned width, unsigned index) {
+	using Layout = PackedLayout<U>;
+	if (width == 0)
+		return 0;
+	const unsigned bit = (index / Layout::LANES) * width;
+	const unsigned lane = index % Layout::LANES;
+	const U *word = block + (bit / Layout::BITS) * Layout::LANES + lane;
+	const unsigned shift = bit % Layout::BITS;
+	U value = static_cast<U>(word[0] >> shift);
+	if (shift + width > Layout::BITS)
+		value |= static_cast<U>(word[Layout::LANES] << (Layout::BITS - shift));
+	return value & LowMask<U>(width);
+}
+
+/** @brief Reference and width of an encoded chunk */
+template <typename U>
+static std::pair<U, unsigned> ReadHeader(const uint8_t *data) {
+	int64_t reference;
+	std::memcpy(&reference, data, sizeof(reference));
+	const unsigned width = data[sizeof(reference)];
+	if (width > PackedLayout<U>::BITS)
+		throw std::runtime_error("Corrupt frame-of-reference chunk!");
+	return {static_cast<U>(reference), width};
+}
+
+/** @brief Reference (minimum) and bit width of the non-null values of `vec` */
+template <typename T>
+static std::pair<T, uint8_t> FrameOf(const Vector &vec) {
+	using U = std::make_unsigned_t<T>;
+	const T *values = vec.Data<T>();
+	bool any = false;
+	T min = 0;
+	T max = 0;
+	for (uint32_t i = 0; i < vec.Size(); i++) {
+		if (vec.HasNulls() && vec.IsNull(i))
+			continue;
+		min = any ? std::min(min, values[i]) : values[i];
+		max = any ? std::max(max, values[i]) : values[i];
+		any = true;
+	}
+	const U range = static_cast<U>(static_cast<U>(max) - static_cast<U>(min));
+	uint8_t width = 0;
+	for (U rest = range; rest; rest >>= 1)
+		width++;
+	return {min, width};
+}
+
+template <typename T>
+static void EncodeValues(const Vector &vec, uint8_t *out) {
+	using U = std::make_unsigned_t<T>;
+	const T *values = vec.Data<T>();
+	const uint32_t count = vec.Size();
+	const auto [reference, width] = FrameOf<T>(vec);
+
+	std::memset(out, 0, ForEncoding::HEADER_SIZE);
+	const auto reference64 = static_cast<int64_t>(reference);
+	std::memcpy(out, &reference64, sizeof(reference64));
+	out[sizeof(reference64)] = width;
+
+	auto *packed = reinterpret_cast<U *>(out + ForEncoding::HEADER_SIZE);
+	U offsets[ForEncoding::BLOCK_SIZE];
+	for (uint32_t start = 0; start < count; start += ForEncoding::BLOCK_SIZE) {
+		for (uint32_t i = 0; i < ForEncoding::BLOCK_SIZE; i++) {
+			const uint32_t row = start + i;
+			const bool present = row < count && !(vec.HasNulls() && vec.IsNull(row));
+			offsets[i] = present ? static_cast<U>(static_cast<U>(values[row]) -
+												  static_cast<U>(reference))
+								 : 0;
+		}
+		PackBlock(offsets, width, packed);
+		packed += static_cast<size_t>(width) * PackedLayout<U>::LANES;
+	}
+}
+
+template <typename T>
+static void DecodeValues(const uint8_t *data, uint32_t count, Vector &out) {
+	using U = std::make_unsigned_t<T>;
+	const auto [reference, width] = ReadHeader<U>(data);
+	const UnpackFunction<U> unpack = Kernels<U>()[width];
+	const auto *packed = reinterpret_cast<const U *>(data + ForEncoding::HEADER_SIZE);
+	const size_t block_words = static_cast<size_t>(width) * PackedLayout<U>::LANES;
+	/** Same size and representation, the signed values are written through their unsigned type */
+	auto *values = reinterpret_cast<U *>(out.RawData());
+
+	uint32_t row = 0;
+	for (; row + ForEncoding::BLOCK_SIZE <= count; row += ForEncoding::BLOCK_SIZE) {
+		unpack(packed, reference, values + row);
+		packed += block_words;
+	}
+	if (row < count) {
+		/** The padded last block does not fit the vector, unpack it aside */
+		U tail[ForEncoding::BLOCK_SIZE];
+		unpack(packed, reference, tail);
+		std::memcpy(values + row, tail, (count - row) * sizeof(U));
+	}
+	out.SetSize(count);
+}
+
+template <typename U>
+static void DecodeBlockOf(const uint8_t *data, uint32_t block, U *out) {
+	const auto [reference, width] = ReadHeader<U>(data);
+	const auto *packed = reinterpret_cast<const U *>(data + ForEncoding::HEADER_SIZE);
+	Kernels<U>()[width](packed + static_cast<size_t>(block) * width * PackedLayout<U>::LANES,
+						reference, out);
+}
+
+template <typename T>
+static void DecodeSelectedValues(const uint8_t *data, const SelectionVector &sel, idx_t count,
+								 Vector &out) {
+	using U = std::make_unsigned_t<T>;
+	const auto [reference, width] = ReadHeader<U>(data);
+	const auto *packed = reinterpret_cast<const U *>(data + ForEncoding::HEADER_SIZE);
+	const size_t block_words = static_cast<size_t>(width) * PackedLayout<U>::LANES;
+	auto *values = reinterpret_cast<U *>(out.RawData());
+
+	for (idx_t i = 0; i < count; i++) {
+		const idx_t row = sel.Get(i);
+		const U *block = packed + (row / ForEncoding::BLOCK_SIZE) * block_words;
+		values[i] = static_cast<U>(reference +
+								   Extract(block, width, row % ForEncoding::BLOCK_SIZE));
+	}
+	out.SetSize(count);
+}
+
+uint8_t ForEncoding::BitWidth(const Vector &vec) {
+	switch (vec.Type()) {
+	case LogicalType::INT32:
+		return FrameOf<int32_t>(vec).second;
+	case LogicalType::INT64:
+		return FrameOf<int64_t>(vec).second;
+	default:
+		throw std::runtime_error("Frame-of-reference encoding supports integers only!");
+	}
+}
+
+size_t ForEncoding::EncodedSize(uint32_t count, uint8_t width) noexcept {
+	const size_t blocks = (static_cast<size_t>(count) + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	return HEADER_SIZE + blocks * (BLOCK_SIZE / 8) * width;
+}
+
+bool ForEncoding::CheckSize(const uint8_t *data, size_t size, LogicalType type, uint32_t count) {
+	if (!Supports(type) || size < HEADER_SIZE)
+		return false;
+	const unsigned width = data[sizeof(int64_t)];
+	return width <= 8 * GetTypeSize(type) &&
+		   size == EncodedSize(count, static_cast<uint8_t>(width));
+}
+
+void ForEncoding::Encode(const Vector &vec, uint8_t *out) {
+	switch (vec.Type()) {
+	case LogicalType::INT32:
+		return EncodeValues<int32_t>(vec, out);
+	case LogicalType::INT64:
+		return EncodeValues<int64_t>(vec, out);
+	default:
+		throw std::runtime_error("Frame-of-reference encoding supports integers only!");
+	}
+}
+
+void ForEncoding::Decode(const uint8_t *data, uint32_t count, Vector &out) {
+#ifndef NDEBUG
+	assert(count <= out.Capacity());
+#endif
+	switch (out.Type()) {
+	case LogicalType::INT32:
+		return DecodeValues<int32_t>(data, count, out);
+	case LogicalType::INT64:
+		return DecodeValues<int64_t>(data, count, out);
+	default:
+		throw std::runtime_error("Frame-of-reference encoding supports integers only!");
+	}
+}
+
+void ForEncoding::DecodeSelected(const uint8_t *data, const SelectionVector &sel, idx_t count,
+								 Vector &out) {
+#ifndef NDEBUG
+	assert(count <= out.Capacity());
+#endif
+	switch (out.Type()) {
+	case LogicalType::INT32:
+		return DecodeSelectedValues<int32_t>(data, sel, count, out);
+	case LogicalType::INT64:
+		return DecodeSelectedValues<int64_t>(data, sel, count, out);
+	default:
+		throw std::runtime_error("Frame-of-reference encoding supports integers only!");
+	}
+}
+
+void ForEncoding::DecodeBlock(const uint8_t *data, uint32_t block, int32_t *out) {
+	DecodeBlockOf(data, block, reinterpret_cast<uint32_t *>(out));
+}
+
+void ForEncoding::DecodeBlock(const uint8_t *data, uint32_t block, int64_t *out) {
+	DecodeBlockOf(data, block, reinterpret_cast<uint64_t *>(out));
+}
+
+} // namespace electricdb
@@ -0,0 +1,23 @@
+#include "electricdb/storage/encoding/plain.h"
+
+#include <cstring>
+
+namespace electricdb {
+
+size_t PlainEncoding::EncodedSize(LogicalType type, uint32_t count) {
+	return static_cast<size_t>(count) * GetTypeSize(type);
+}
+
+void PlainEncoding::Encode(const Vector &vec, uint8_t *out) {
+	std::memcpy(out, vec.RawData(), EncodedSize(vec.Type(), vec.Size()));
+}
+
+void PlainEncoding::Decode(const uint8_t *data, uint32_t count, Vector &out) {
+#ifndef NDEBUG
+	assert(count <= out.Capacity());
+#endif
+	std::memcpy(out.RawData(), data, EncodedSize(out.Type(), count));
+	out.SetSize(count);
+}
+
+} // namespace electricdb
@@ -0,0 +1,223 @@
+#include "electricdb/storage/encoding/rle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace electricdb {
+
+/** @brief Offset of the run ends, behind the header and the padded run values */
+static size_t EndsOffset(uint32_t runs, size_t value_size) {
+	return RleEncoding::HEADER_SIZE + ((runs * value_size + 7) & ~size_t{7});
+}
+
+static const uint32_t *EndsOf(const uint8_t *data) {
+	return reinterpret_cast<const uint32_t *>(
+			data + EndsOffset(RleEncoding::RunCount(data), data[sizeof(uint32_t)]));
+}
+
+/** @brief Check if row `i` starts a new run: its nullness or the bits of its value differ */
+template <typename T>
+static bool StartsRun(const Vector &vec, uint32_t i) {
+	const bool null = vec.HasNulls() && vec.IsNull(i);
+	const bool prev_null = vec.HasNulls() && vec.IsNull(i - 1);
+	if (null || prev_null)
+		return null != prev_null;
+	const T *values = vec.Data<T>();
+	return std::memcmp(&values[i], &values[i - 1], sizeof(T)) != 0;
+}
+
+template <typename T>
+static uint32_t CountRuns(const Vector &vec) {
+	uint32_t runs = vec.Size() ? 1 : 0;
+	for (uint32_t i = 1; i < vec.Size(); i++)
+		runs += StartsRun<T>(vec, i) ? 1 : 0;
+	return runs;
+}
+
+template <typename T>
+static void EncodeRuns(const Vector &vec, uint8_t *out) {
+	const uint32_t runs = CountRuns<T>(vec);
+	const size_t offset = EndsOffset(runs, sizeof(T));
+	std::memset(out, 0, offset);
+	std::memcpy(out, &runs, sizeof(runs));
+	out[sizeof(runs)] = sizeof(T);
+
+	auto *values = reinterpret_cast<T *>(out + RleEncoding::HEADER_SIZE);
+	auto *ends = reinterpret_cast<uint32_t *>(out + offset);
+	const T *data = vec.Data<T>();
+	uint32_t run = 0;
+	for (uint32_t i = 0; i < vec.Size(); i++) {
+		if (i == 0 || StartsRun<T>(vec, i)) {
+			if (i > 0)
+				ends[run++] = i;
+			values[run] = (vec.HasNulls() && vec.IsNull(i)) ? T{} : data[i];
+		}
+	}
+	if (runs)
+		ends[run] = vec.Size();
+}
+
+template <typename T>
+static void DecodeRows(const uint8_t *data, uint32_t count, Vector &out) {
+	const auto *values = reinterpret_cast<const T *>(data + RleEncoding::HEADER_SIZE);
+	const uint32_t *ends = EndsOf(data);
+	T *rows = out.Data<T>();
+	uint32_t start = 0;
+	for (uint32_t r = 0; start < count; r++) {
+		const uint32_t end = std::min(ends[r], count);
+		std::fill(rows + start, rows + end, values[r]);
+		start = end;
+	}
+	out.SetSize(count);
+}
+
+template <typename T>
+static idx_t SelectRuns(const uint8_t *data, const ColumnPredicate &predicate,
+						const uint8_t *nulls, SelectionVector &sel) {
+	const auto *values = reinterpret_cast<const T *>(data + RleEncoding::HEADER_SIZE);
+	const uint32_t *ends = EndsOf(data);
+	sel_t *rows = sel.Data();
+	idx_t selected = 0;
+	uint32_t start = 0;
+	for (uint32_t r = 0; r < RleEncoding::RunCount(data); r++) {
+		const uint32_t end = ends[r];
+		/** Runs are null throughout or not at all, the first row tells which */
+		const bool null = nulls && (nulls[start / 8] & (1U << (start % 8)));
+		if (!null && predicate.Matches(values[r])) {
+			for (uint32_t row = start; row < end; row++)
+				rows[selected++] = row;
+		}
+		start = end;
+	}
+	return selected;
+}
+
+uint32_t RleEncoding::RunCount(const Vector &vec) {
+	switch (vec.Type()) {
+	case LogicalType::INT32:
+		return CountRuns<int32_t>(vec);
+	case LogicalType::INT64:
+		return CountRuns<int64_t>(vec);
+	case LogicalType::FLOAT:
+		return CountRuns<float>(vec);
+	case LogicalType::DOUBLE:
+		return CountRuns<double>(vec);
+	case LogicalType::BOOL:
+		return CountRuns<bool>(vec);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+uint32_t RleEncoding::RunCount(const uint8_t *data) noexcept {
+	uint32_t runs;
+	std::memcpy(&runs, data, sizeof(runs));
+	return runs;
+}
+
+size_t RleEncoding::EncodedSize(LogicalType type, uint32_t runs) noexcept {
+	return EndsOffset(runs, GetTypeSize(type)) + runs * sizeof(uint32_t);
+}
+
+void RleEncoding::Encode(const Vector &vec, uint8_t *out) {
+	switch (vec.Type()) {
+	case LogicalType::INT32:
+		return EncodeRuns<int32_t>(vec, out);
+	case LogicalType::INT64:
+		return EncodeRuns<int64_t>(vec, out);
+	case LogicalType::FLOAT:
+		return EncodeRuns<float>(vec, out);
+	case LogicalType::DOUBLE:
+		return EncodeRuns<double>(vec, out);
+	case LogicalType::BOOL:
+		return EncodeRuns<bool>(vec, out);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+bool RleEncoding::CheckSize(const uint8_t *data, size_t size, LogicalType type, uint32_t count) {
+	if (!Supports(type) || size < HEADER_SIZE)
+		return false;
+	const uint32_t runs = RunCount(data);
+	if (runs > count || data[sizeof(uint32_t)] != GetTypeSize(type) ||
+		size != EncodedSize(type, runs))
+		return false;
+
+	/** Decoding trusts the run ends, every run must hold at least one row */
+	const uint32_t *ends = EndsOf(data);
+	uint32_t start = 0;
+	for (uint32_t r = 0; r < runs; r++) {
+		if (ends[r] <= start)
+			return false;
+		start = ends[r];
+	}
+	return start == count;
+}
+
+void RleEncoding::Decode(const uint8_t *data, uint32_t count, Vector &out) {
+#ifndef NDEBUG
+	assert(count <= out.Capacity());
+#endif
+	switch (out.Type()) {
+	case LogicalType::INT32:
+		return DecodeRows<int32_t>(data, count, out);
+	case LogicalType::INT64:
+		return DecodeRows<int64_t>(data, count, out);
+	case LogicalType::FLOAT:
+		return DecodeRows<float>(data, count, out);
+	case LogicalType::DOUBLE:
+		return DecodeRows<double>(data, count, out);
+	case LogicalType::BOOL:
+		return DecodeRows<bool>(data, count, out);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+void RleEncoding::DecodeRuns(const uint8_t *data, Vector &values, uint32_t *lengths) {
+	const uint32_t runs = RunCount(data);
+#ifndef NDEBUG
+	assert(runs <= values.Capacity());
+#endif
+	if (!Supports(values.Type()))
+		throw std::runtime_error("Unsupported type!");
+	values.Reset();
+	std::memcpy(values.RawData(), data + HEADER_SIZE, runs * GetTypeSize(values.Type()));
+	values.SetSize(runs);
+
+	const uint32_t *ends = EndsOf(data);
+	uint32_t start = 0;
+	for (uint32_t r = 0; r < runs; r++) {
+		lengths[r] = ends[r] - start;
+		start = ends[r];
+	}
+}
+
+uint32_t RleEncoding::FindRun(const uint8_t *data, uint32_t row) noexcept {
+	const uint32_t *ends = EndsOf(data);
+	return static_cast<uint32_t>(std::upper_bound(ends, ends + RunCount(data), row) - ends);
+}
+
+idx_t RleEncoding::Select(const uint8_t *data, LogicalType type, const ColumnPredicate &predicate,
+						  const uint8_t *nulls, SelectionVector &sel) {
+	if (!predicate.Fits(type))
+		throw std::runtime_error("Predicate does not match the column type!");
+	switch (type) {
+	case LogicalType::INT32:
+		return SelectRuns<int32_t>(data, predicate, nulls, sel);
+	case LogicalType::INT64:
+		return SelectRuns<int64_t>(data, predicate, nulls, sel);
+	case LogicalType::FLOAT:
+		return SelectRuns<float>(data, predicate, nulls, sel);
+	case LogicalType::DOUBLE:
+		return SelectRuns<double>(data, predicate, nulls, sel);
+	case LogicalType::BOOL:
+		return SelectRuns<bool>(data, predicate, nulls, sel);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+} // namespace electricdb
@@ -0,0 +1,622 @@
+#include "electricdb/storage/format/column_file.h"
+#include "electricdb/storage/encoding/delta.h"
+#include "electricdb/storage/encoding/dictionary.h"
+#include "electricdb/storage/encoding/plain.h"
+#include "electricdb/storage/encoding/rle.h"
+#include "electricdb/util/hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
+namespace electricdb {
+
+/**
+ * @brief Chunks whose gap is at most this many bytes are fetched with one read. Chunks of a row
+ * group are only separated by page padding, so this merges runs of neighbouring columns.
+ */
+static constexpr uint64_t READ_COALESCE_GAP = COLUMN_FILE_PAGE_SIZE;
+
+ColumnFileWriter::ColumnFileWriter(const std::string &path, std::vector<ColumnSchema> schema,
+								   uint32_t row_group_size)
+	: file_(path, FILE_WRITE | FILE_CREATE | FILE_TRUNCATE), row_group_size_(row_group_size) {
+	if (row_group_size_ == 0)
+		throw std::runtime_error("Row groups must hold at least one row!");
+
+	metadata_.columns = std::move(schema);
+	for (const auto &column : metadata_.columns) {
+		/** Throws for types without a fixed width */
+		GetTypeSize(column.type);
+		buffer_.emplace_back(column.type, row_group_size_, arena_);
+	}
+	encodings_.assign(metadata_.columns.size(), EncodingType::PLAIN);
+	writers_.resize(metadata_.columns.size());
+
+	uint8_t header[COLUMN_FILE_PAGE_SIZE] = {};
+	FileHeader().Serialize(header);
+	file_.Write(header, sizeof(header), 0);
+}
+
+void ColumnFileWriter::SetEncoding(idx_t column, EncodingType encoding) {
+	if (column >= encodings_.size())
+		throw std::runtime_error("Column out of range!");
+	if (!EncodingSupports(encoding, metadata_.columns[column].type))
+		throw std::runtime_error("Encoding does not support the column type!");
+	encodings_[column] = encoding;
+	writers_[column].reset();
+}
+
+void ColumnFileWriter::SetAdaptiveEncoding(idx_t column, EncodingPolicy policy) {
+	if (column >= writers_.size())
+		throw std::runtime_error("Column out of range!");
+	writers_[column].emplace(metadata_.columns[column].type, policy);
+}
+
+void ColumnFileWriter::Append(const std::vector<Vector> &columns) {
+	if (finished_)
+		throw std::runtime_error("Column file is already finished!");
+	if (columns.size() != buffer_.size())
+		throw std::runtime_error("Column count does not match the schema!");
+
+	const uint32_t rows = columns.empty() ? 0 : columns[0].Size();
+	uint32_t appended = 0;
+	while (appended < rows) {
+		const uint32_t count = std::min(rows - appended, row_group_size_ - buffered_);
+		for (size_t c = 0; c < buffer_.size(); c++) {
+#ifndef NDEBUG
+			assert(columns[c].Type() == buffer_[c].Type());
+			assert(columns[c].Size() == rows);
+#endif
+			buffer_[c].SetSize(buffered_ + count);
+			buffer_[c].Copy(columns[c], appended, count, buffered_);
+		}
+		buffered_ += count;
+		appended += count;
+		if (buffered_ == row_group_size_)
+			FlushRowGroup();
+	}
+}
+
+EncodingType ColumnFileWriter::ChunkEncoding(size_t c, DictionaryEntries &dictionary) const {
+	const Vector &column = buffer_[c];
+	std::vector<EncodingType> candidates;
+	if (writers_[c]) {
+		for (const EncodingEstimate &estimate : writers_[c]->Estimate(column))
+			candidates.push_back(estimate.encoding);
+	} else {
+		candidates = {encodings_[c], EncodingType::PLAIN};
+	}
+	for (EncodingType encoding : candidates) {
+		if (encoding != EncodingType::DICTIONARY) {
+			if (EncodingSupports(encoding, column.Type()))
+				return encoding;
+			continue;
+		}
+		/** Only a dictionary depends on the values, the sample may have missed some */
+		dictionary = DictionaryEncoding::BuildEntries(column);
+		if (DictionaryEncoding::CanEncode(dictionary))
+			return encoding;
+	}
+	return EncodingType::PLAIN;
+}
+
+void ColumnFileWriter::FlushRowGroup() {
+	if (buffered_ == 0)
+		return;
+
+	RowGroupMeta row_group;
+	row_group.row_count = buffered_;
+
+	/** Lay out the chunks first, so the row group can be encoded into one buffer */
+	uint64_t end = offset_;
+	std::vector<DictionaryEntries> dictionaries(buffer_.size());
+	for (size_t c = 0; c < buffer_.size(); c++) {
+		const Vector &column = buffer_[c];
+		ColumnChunkMeta chunk;
+		chunk.offset = end;
+		chunk.encoding = ChunkEncoding(c, dictionaries[c]);
+		if (column.HasNulls()) {
+			for (uint32_t i = 0; i < buffered_; i++)
+				chunk.null_count += column.IsNull(i) ? 1 : 0;
+		}
+		/** The dictionary was collected once, for both the size and the encoding */
+		chunk.size = chunk.NullBitmapSize(buffered_);
+		if (chunk.encoding == EncodingType::DICTIONARY)
+			chunk.size += DictionaryEncoding::EncodedSize(column.Type(), buffered_,
+														  dictionaries[c].count);
+		else
+			chunk.size += EncodedSize(chunk.encoding, column);
+		chunk.stats = ZoneMap(column.Type());
+		chunk.stats.Update(column);
+		end = AlignToPage(chunk.offset + chunk.size);
+		row_group.columns.push_back(std::move(chunk));
+	}
+
+	scratch_.resize(end - offset_);
+	for (size_t c = 0; c < buffer_.size(); c++) {
+		ColumnChunkMeta &chunk = row_group.columns[c];
+		uint8_t *data = scratch_.data() + (chunk.offset - offset_);
+		const size_t bitmap = chunk.NullBitmapSize(buffered_);
+
+		std::memset(data, 0, bitmap);
+		if (chunk.null_count) {
+			for (uint32_t i = 0; i < buffered_; i++) {
+				if (buffer_[c].IsNull(i))
+					data[i / 8] |= static_cast<uint8_t>(1U << (i % 8));
+			}
+		}
+		if (chunk.encoding == EncodingType::DICTIONARY)
+			DictionaryEncoding::Encode(buffer_[c], dictionaries[c], data + bitmap);
+		else
+			EncodeValues(chunk.encoding, buffer_[c], data + bitmap);
+		chunk.checksum = Hash::crc32c(data, chunk.size);
+
+		/** Zero the padding, so the same rows always produce the same file */
+		const uint64_t padded = AlignToPage(chunk.offset + chunk.size) - chunk.offset;
+		std::memset(data + chunk.size, 0, padded - chunk.size);
+
+		buffer_[c].Reset();
+	}
+
+	file_.Write(scratch_.data(), scratch_.size(), offset_);
+	offset_ = end;
+	buffered_ = 0;
+	metadata_.row_groups.push_back(std::move(row_group));
+}
+
+void ColumnFileWriter::Finish() {
+	if (finished_)
+		return;
+	FlushRowGroup();
+
+	const std::vector<uint8_t> footer = metadata_.Serialize();
+	FileTrailer trailer;
+	trailer.footer_offset = offset_;
+	trailer.footer_size = footer.size();
+	trailer.footer_checksum = Hash::crc32c(footer.data(), footer.size());
+
+	uint8_t trailer_bytes[FileTrailer::SIZE];
+	trailer.Serialize(trailer_bytes);
+	file_.Write(footer.data(), footer.size(), offset_);
+	file_.Write(trailer_bytes, sizeof(trailer_bytes), offset_ + footer.size());
+	file_.Close();
+	finished_ = true;
+}
+
+ColumnFileReader::ColumnFileReader(const std::string &path) : file_(path, FILE_READ) {
+	/** A second descriptor, so buffered reads of the same reader keep using the page cache */
+	direct_ = File(path, FILE_READ | FILE_DIRECT);
+	if (!direct_.IsDirect())
+		direct_.Close();
+
+	const uint64_t file_size = file_.Size();
+	if (file_size < COLUMN_FILE_PAGE_SIZE + FileTrailer::SIZE)
+		throw std::runtime_error("Not a column file!");
+
+	uint8_t header[FileHeader::SIZE];
+	file_.Read(header, sizeof(header), 0);
+	FileHeader::Deserialize(header);
+
+	uint8_t trailer_bytes[FileTrailer::SIZE];
+	file_.Read(trailer_bytes, sizeof(trailer_bytes), file_size - FileTrailer::SIZE);
+	const FileTrailer trailer = FileTrailer::Deserialize(trailer_bytes);
+	if (trailer.footer_offset < COLUMN_FILE_PAGE_SIZE ||
+		trailer.footer_offset + trailer.footer_size + FileTrailer::SIZE != file_size)
+		throw std::runtime_error("Corrupt column file trailer!");
+
+	std::vector<uint8_t> footer(trailer.footer_size);
+	if (file_.Read(footer.data(), footer.size(), trailer.footer_offset) != footer.size())
+		throw std::runtime_error("Column file is truncated!");
+	if (Hash::crc32c(footer.data(), footer.size()) != trailer.footer_checksum)
+		throw std::runtime_error("Column file metadata checksum mismatch!");
+	metadata_ = FileMetadata::Deserialize(footer.data(), footer.size());
+	bytes_read_ = sizeof(header) + sizeof(trailer_bytes) + footer.size();
+
+	/**
+	 * Chunks must lie between the header page and the footer, with room for their values. The
+	 * size of encoded values depends on their data, it is checked when they are decoded.
+	 */
+	for (const auto &row_group : metadata_.row_groups) {
+		for (size_t c = 0; c < row_group.columns.size(); c++) {
+			const ColumnChunkMeta &chunk = row_group.columns[c];
+			const LogicalType type = metadata_.columns[c].type;
+			const uint64_t bitmap = chunk.NullBitmapSize(row_group.row_count);
+			const bool sized =
+					chunk.encoding == EncodingType::PLAIN
+							? chunk.size ==
+									  bitmap + PlainEncoding::EncodedSize(type, row_group.row_count)
+							: chunk.size > bitmap;
+			if (chunk.offset % COLUMN_FILE_PAGE_SIZE != 0 || chunk.offset < COLUMN_FILE_PAGE_SIZE ||
+				chunk.offset + chunk.size > trailer.footer_offset ||
+				!EncodingSupports(chunk.encoding, type) || !sized)
+				throw std::runtime_error("Corrupt column file metadata!");
+		}
+	}
+}
+
+std::vector<ChunkRead> ColumnFileReader::PlanReads(idx_t row_group,
+												   const std::vector<idx_t> &column_ids) const {
+	if (row_group >= metadata_.row_groups.size())
+		throw std::runtime_error("Row group out of range!");
+	const RowGroupMeta &group = metadata_.row_groups[row_group];
+
+	/** Requested chunks in file order */
+	std::vector<size_t> order(column_ids.size());
+	for (size_t i = 0; i < order.size(); i++) {
+		if (column_ids[i] >= metadata_.columns.size())
+			throw std::runtime_error("Column out of range!");
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		return group.columns[column_ids[a]].offset < group.columns[column_ids[b]].offset;
+	});
+
+	std::vector<ChunkRead> reads;
+	for (size_t i : order) {
+		const ColumnChunkMeta &chunk = group.columns[column_ids[i]];
+		/** Extend the previous read over every chunk that starts close enough */
+		if (!reads.empty() && chunk.offset <= reads.back().offset + reads.back().size +
+													  READ_COALESCE_GAP) {
+			ChunkRead &read = reads.back();
+			read.size = std::max(read.size, chunk.offset + chunk.size - read.offset);
+			read.columns.push_back(i);
+			continue;
+		}
+		reads.push_back({chunk.offset, chunk.size, {i}});
+	}
+	return reads;
+}
+
+void ColumnFileReader::DecodeRead(idx_t row_group, const std::vector<idx_t> &column_ids,
+								  const ChunkRead &read, const uint8_t *data,
+								  std::vector<Vector> &out,
+								  std::vector<DictionaryChunk> *dictionaries,
+								  std::vector<RunChunk> *runs) const {
+	const RowGroupMeta &group = metadata_.row_groups[row_group];
+	for (size_t i : read.columns) {
+		const ColumnChunkMeta &chunk = group.columns[column_ids[i]];
+		if (out[i].Type() != metadata_.columns[column_ids[i]].type ||
+			out[i].Capacity() < group.row_count)
+			throw std::runtime_error("Vector does not fit the column chunk!");
+		const uint8_t *bytes = data + (chunk.offset - read.offset);
+		if (runs && chunk.encoding == EncodingType::RLE)
+			DecodeColumnChunk(chunk, group.row_count, bytes, out[i], (*runs)[i]);
+		else if (dictionaries)
+			DecodeColumnChunk(chunk, group.row_count, bytes, out[i], (*dictionaries)[i]);
+		else
+			DecodeColumnChunk(chunk, group.row_count, bytes, out[i]);
+	}
+}
+
+template <typename T>
+static idx_t SelectValues(const Vector &values, const uint8_t *nulls,
+						  const ColumnPredicate &predicate, SelectionVector &sel) {
+	const T *data = values.Data<T>();
+	sel_t *rows = sel.Data();
+	idx_t selected = 0;
+	for (uint32_t i = 0; i < values.Size(); i++) {
+		const bool null = nulls && (nulls[i / 8] & (1U << (i % 8)));
+		rows[selected] = i;
+		selected += !null && predicate.Matches(data[i]) ? 1 : 0;
+	}
+	return selected;
+}
+
+idx_t ColumnFileReader::SelectRows(idx_t row_group, idx_t column,
+								   const ColumnPredicate &predicate, SelectionVector &sel) const {
+	if (row_group >= metadata_.row_groups.size() || column >= metadata_.columns.size())
+		throw std::runtime_error("Column chunk out of range!");
+	const LogicalType type = metadata_.columns[column].type;
+	if (!predicate.Fits(type))
+		throw std::runtime_error("Predicate does not match the column type!");
+	const RowGroupMeta &group = metadata_.row_groups[row_group];
+	if (sel.Size() < group.row_count)
+		throw std::runtime_error("Selection vector does not fit the row group!");
+
+	const ColumnChunkMeta &chunk = group.columns[column];
+	if (!predicate.MayMatch(chunk.stats.min, chunk.stats.max))
+		return 0;
+
+	std::vector<uint8_t> data(chunk.size);
+	FetchRead({chunk.offset, chunk.size, {0}}, data.data(), false);
+	VerifyColumnChunk(chunk, group.row_count, type, data.data());
+	const uint8_t *values = data.data() + chunk.NullBitmapSize(group.row_count);
+	const uint8_t *nulls = chunk.null_count ? data.data() : nullptr;
+
+	/** A dictionary chunk is filtered on its codes, its values are never materialized */
+	if (chunk.encoding == EncodingType::DICTIONARY) {
+		const CodeSet codes = DictionaryEncoding::QualifyingCodes(values, type, predicate);
+		return DictionaryEncoding::Select(values, group.row_count, codes, nulls, sel);
+	}
+	/** An RLE chunk is filtered once per run, qualifying runs select all of their rows */
+	if (chunk.encoding == EncodingType::RLE)
+		return RleEncoding::Select(values, type, predicate, nulls, sel);
+	/** A sorted delta chunk decodes only the pages whose bases admit a qualifying value */
+	if (chunk.encoding == EncodingType::DELTA)
+		return DeltaEncoding::Select(values, type, group.row_count, predicate, nulls, sel);
+
+	Arena arena;
+	Vector decoded(type, group.row_count, arena);
+	DecodeValues(chunk.encoding, values, group.row_count, decoded);
+	switch (type) {
+	case LogicalType::INT32:
+		return SelectValues<int32_t>(decoded, nulls, predicate, sel);
+	case LogicalType::INT64:
+		return SelectValues<int64_t>(decoded, nulls, predicate, sel);
+	case LogicalType::FLOAT:
+		return SelectValues<float>(decoded, nulls, predicate, sel);
+	case LogicalType::DOUBLE:
+		return SelectValues<double>(decoded, nulls, predicate, sel);
+	case LogicalType::BOOL:
+		return SelectValues<bool>(decoded, nulls, predicate, sel);
+	default:
+		throw std::runtime_error("Unsupported type!");
+	}
+}
+
+void ColumnFileReader::ReadRuns(idx_t row_group, idx_t column, RunChunk &runs) const {
+	if (row_group >= metadata_.row_groups.size() || column >= metadata_.columns.size())
+		throw std::runtime_error("Column chunk out of range!");
+	const RowGroupMeta &group = metadata_.row_groups[row_group];
+	const ColumnChunkMeta &chunk = group.columns[column];
+	if (runs.values.Type() != metadata_.columns[column].type)
+		throw std::runtime_error("Runs do not fit the column chunk!");
+
+	std::vector<uint8_t> data(chunk.size);
+	FetchRead({chunk.offset, chunk.size, {0}}, data.data(), false);
+	DecodeColumnRuns(chunk, group.row_count, data.data(), runs);
+}
+
+uint64_t ColumnFileReader::DecodedChunkSize(idx_t row_group, idx_t column) const {
+	if (row_group >= metadata_.row_groups.size() || column >= metadata_.columns.size())
+		throw std::runtime_error("Column chunk out of range!");
+	const RowGroupMeta &group = metadata_.row_groups[row_group];
+	return group.columns[column].NullBitmapSize(group.row_count) +
+		   PlainEncoding::EncodedSize(metadata_.columns[column].type, group.row_count);
+}
+
+void ColumnFileReader::DecodeChunk(idx_t row_group, idx_t column, uint8_t *out,
+								   bool direct) const {
+	const uint64_t size = DecodedChunkSize(row_group, column);
+	const RowGroupMeta &group = metadata_.row_groups[row_group];
+	const ColumnChunkMeta &chunk = group.columns[column];
+	const LogicalType type = metadata_.columns[column].type;
+	const ChunkRead read{chunk.offset, chunk.size, {0}};
+
+	/** PLAIN chunks are stored decoded: fetch straight into `out` */
+	if (chunk.encoding == EncodingType::PLAIN) {
+		FetchRead(read, out, direct);
+		VerifyColumnChunk(chunk, group.row_count, type, out);
+		return;
+	}
+
+	Arena arena;
+	auto *data = static_cast<uint8_t *>(arena.Allocate(DirectReadSize(read), DIRECT_IO_ALIGNMENT));
+	FetchRead(read, data, direct);
+	VerifyColumnChunk(chunk, group.row_count, type, data);
+	const size_t bitmap = chunk.NullBitmapSize(group.row_count);
+	Vector values(type, group.row_count, arena);
+	DecodeValues(chunk.encoding, data + bitmap, group.row_count, values);
+	std::memcpy(out, data, bitmap);
+	std::memcpy(out + bitmap, values.RawData(), size - bitmap);
+}
+
+void ColumnFileReader::ReadColumns(idx_t row_group, const std::vector<idx_t> &column_ids,
+								   std::vector<Vector> &out,
+								   std::vector<DictionaryChunk> *dictionaries,
+								   std::vector<RunChunk> *runs) const {
+	std::vector<uint8_t> buffer;
+	for (const ChunkRead &read : PlanReads(row_group, column_ids)) {
+		buffer.resize(read.size);
+		FetchRead(read, buffer.data(), false);
+		DecodeRead(row_group, column_ids, read, buffer.data(), out, dictionaries, runs);
+	}
+}
+
+void ColumnFileReader::ReadColumns(idx_t row_group, const std::vector<idx_t> &column_ids,
+								   std::vector<Vector> &out, Arena &buffers, bool direct,
+								   std::vector<DictionaryChunk> *dictionaries,
+								   std::vector<RunChunk> *runs) const {
+	for (const ChunkRead &read : PlanReads(row_group, column_ids)) {
+		auto *buffer = static_cast<uint8_t *>(
+				buffers.Allocate(DirectReadSize(read), DIRECT_IO_ALIGNMENT));
+		FetchRead(read, buffer, direct);
+		DecodeRead(row_group, column_ids, read, buffer, out, dictionaries, runs);
+	}
+}
+
+void ColumnFileReader::FetchRead(const ChunkRead &read, uint8_t *buffer, bool direct) const {
+	const File &file = GetFile(direct);
+	const uint64_t size = file.IsDirect() ? DirectReadSize(read) : read.size;
+	if (file.Read(buffer, size, read.offset) < read.size)
+		throw std::runtime_error("Column file is truncated!");
+	AddBytesRead(read.size);
+}
+
+ChunkPrefetcher::ChunkPrefetcher(const ColumnFileReader &reader, std::vector<idx_t> column_ids,
+								 AsyncReader &io, uint32_t depth, uint64_t max_bytes, bool direct)
+	: reader_(reader), column_ids_(std::move(column_ids)), io_(io), depth_(depth),
+	  max_bytes_(max_bytes), direct_(direct) {}
+
+ChunkPrefetcher::~ChunkPrefetcher() {
+	for (auto &[row_group, fetch] : pending_) {
+		try {
+			Finish(*fetch);
+		} catch (const std::runtime_error &) {
+			/** Nobody consumes the row group, its read error does not matter */
+		}
+	}
+}
+
+void ChunkPrefetcher::Start(Fetch &fetch) {
+	const File &file = reader_.GetFile(direct_);
+	fetch.buffers.reserve(fetch.reads.size());
+	for (const ChunkRead &read : fetch.reads) {
+		const uint64_t size =
+				file.IsDirect() ? ColumnFileReader::DirectReadSize(read) : read.size;
+		auto *buffer = static_cast<uint8_t *>(fetch.arena.Allocate(size, DIRECT_IO_ALIGNMENT));
+		fetch.buffers.push_back(buffer);
+		fetch.tickets.push_back(io_.Submit(file, buffer, size, read.offset));
+	}
+	in_flight_ += fetch.bytes;
+}
+
+void ChunkPrefetcher::Finish(Fetch &fetch) {
+	std::exception_ptr error;
+	for (size_t i = 0; i < fetch.tickets.size(); i++) {
+		try {
+			if (io_.Wait(fetch.tickets[i]) < fetch.reads[i].size)
+				throw std::runtime_error("Column file is truncated!");
+		} catch (const std::runtime_error &) {
+			if (!error)
+				error = std::current_exception();
+		}
+	}
+	fetch.tickets.clear();
+	if (error)
+		std::rethrow_exception(error);
+}
+
+/** @brief Total bytes of a row group's reads */
+static uint64_t ReadBytes(const std::vector<ChunkRead> &reads) {
+	uint64_t bytes = 0;
+	for (const ChunkRead &read : reads)
+		bytes += read.size;
+	return bytes;
+}
+
+void ChunkPrefetcher::Read(idx_t row_group, std::vector<Vector> &out) {
+	std::unique_ptr<Fetch> fetch;
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		auto it = pending_.find(row_group);
+		if (it != pending_.end()) {
+			fetch = std::move(it->second);
+			pending_.erase(it);
+		} else {
+			fetch = std::make_unique<Fetch>();
+			fetch->reads = reader_.PlanReads(row_group, column_ids_);
+			fetch->bytes = ReadBytes(fetch->reads);
+			Start(*fetch);
+		}
+
+		/** Read ahead, as far as depth and the byte budget allow */
+		next_ = std::max<idx_t>(next_, row_group + 1);
+		const idx_t last = std::min<idx_t>(row_group + depth_, reader_.RowGroupCount() - 1);
+		for (; next_ <= last; next_++) {
+			auto ahead = std::make_unique<Fetch>();
+			ahead->reads = reader_.PlanReads(next_, column_ids_);
+			ahead->bytes = ReadBytes(ahead->reads);
+			if (in_flight_ + ahead->bytes > max_bytes_)
+				break;
+			Start(*ahead);
+			pending_.emplace(next_, std::move(ahead));
+		}
+	}
+
+	/** The row group's bytes are released however decoding ends */
+	struct Release {
+		ChunkPrefetcher &prefetcher;
+		uint64_t bytes;
+		~Release() {
+			std::lock_guard<std::mutex> guard(prefetcher.lock_);
+			prefetcher.in_flight_ -= bytes;
+		}
+	} release{*this, fetch->bytes};
+
+	Finish(*fetch);
+	reader_.AddBytesRead(fetch->bytes);
+	for (size_t i = 0; i < fetch->reads.size(); i++)
+		reader_.DecodeRead(row_group, column_ids_, fetch->reads[i], fetch->buffers[i], out);
+}
+
+uint64_t ChunkPrefetcher::InFlightBytes() const {
+	std::lock_guard<std::mutex> guard(lock_);
+	return in_flight_;
+}
+
+void VerifyColumnChunk(const ColumnChunkMeta &chunk, uint32_t row_count, LogicalType type,
+					   const uint8_t *data) {
+	if (Hash::crc32c(data, chunk.size) != chunk.checksum)
+		throw std::runtime_error("Column chunk checksum mismatch!");
+	const size_t bitmap = chunk.NullBitmapSize(row_count);
+	if (!CheckEncodedSize(chunk.encoding, type, data + bitmap, chunk.size - bitmap, row_count))
+		throw std::runtime_error("Corrupt column chunk!");
+}
+
+/**
+ * @brief Set the null flags of a chunk's rows on `out`, from its null bitmap
+ *
+ */
+static void SetChunkNulls(const ColumnChunkMeta &chunk, uint32_t row_count, const uint8_t *data,
+						  Vector &out) {
+	if (!chunk.null_count)
+		return;
+	for (uint32_t i = 0; i < row_count; i++) {
+		if (data[i / 8] & (1U << (i % 8)))
+			out.SetNull(i);
+	}
+}
+
+void DecodeColumnChunk(const ColumnChunkMeta &chunk, uint32_t row_count, const uint8_t *data,
+					   Vector &out) {
+	VerifyColumnChunk(chunk, row_count, out.Type(), data);
+
+	out.Reset();
+	DecodeValues(chunk.encoding, data + chunk.NullBitmapSize(row_count), row_count, out);
+	SetChunkNulls(chunk, row_count, data, out);
+}
+
+void DecodeColumnChunk(const ColumnChunkMeta &chunk, uint32_t row_count, const uint8_t *data,
+					   Vector &out, DictionaryChunk &dictionary) {
+	if (chunk.encoding != EncodingType::DICTIONARY)
+		return DecodeColumnChunk(chunk, row_count, data, out);
+
+	VerifyColumnChunk(chunk, row_count, out.Type(), data);
+	const uint8_t *values = data + chunk.NullBitmapSize(row_count);
+	if (dictionary.entries.Type() != out.Type() ||
+		dictionary.entries.Capacity() < DictionaryEncoding::EntryCount(values) ||
+		dictionary.codes.Size() < row_count)
+		throw std::runtime_error("Dictionary does not fit the column chunk!");
+	DictionaryEncoding::DecodeCodes(values, row_count, dictionary.entries,
+									dictionary.codes.Data());
+	out.ReferenceDictionary(dictionary.entries, dictionary.codes.Data(), row_count);
+	SetChunkNulls(chunk, row_count, data, out);
+}
+
+void DecodeColumnChunk(const ColumnChunkMeta &chunk, uint32_t row_count, const uint8_t *data,
+					   Vector &out, RunChunk &runs) {
+	if (chunk.encoding != EncodingType::RLE)
+		return DecodeColumnChunk(chunk, row_count, data, out);
+
+	if (runs.values.Type() != out.Type())
+		throw std::runtime_error("Runs do not fit the column chunk!");
+	DecodeColumnRuns(chunk, row_count, data, runs);
+	out.ReferenceRuns(runs.values, runs.lengths, row_count);
+}
+
+void DecodeColumnRuns(const ColumnChunkMeta &chunk, uint32_t row_count, const uint8_t *data,
+					  RunChunk &runs) {
+	if (runs.values.Capacity() < row_count)
+		throw std::runtime_error("Runs do not fit the column chunk!");
+	if (chunk.encoding != EncodingType::RLE) {
+		DecodeColumnChunk(chunk, row_count, data, runs.values);
+		std::fill(runs.lengths, runs.lengths + row_count, 1U);
+		return;
+	}
+
+	VerifyColumnChunk(chunk, row_count, runs.values.Type(), data);
+	RleEncoding::DecodeRuns(data + chunk.NullBitmapSize(row_count), runs.values, runs.lengths);
+	if (!chunk.null_count)
+		return;
+	/** Runs are null throughout or not at all, the first row tells which */
+	uint32_t start = 0;
+	for (uint32_t r = 0; r < runs.Size(); r++) {
+		if (data[start / 8] & (1U << (start % 8)))
+			runs.values.SetNull(r);
+		start += runs.lengths[r];
+	}
+}
+
+} // namespace electricdb
@@ -0,0 +1,69 @@
+#include "electricdb/storage/format/file_header.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace electricdb {
+
+/** Fields are copied in host order, which the format requires to be little-endian */
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Column files are little-endian!");
+
+template <typename T>
+static void Put(uint8_t *&out, T value) {
+	std::memcpy(out, &value, sizeof(T));
+	out += sizeof(T);
+}
+
+template <typename T>
+static T Take(const uint8_t *&data) {
+	T value;
+	std::memcpy(&value, data, sizeof(T));
+	data += sizeof(T);
+	return value;
+}
+
+void FileHeader::Serialize(uint8_t *out) const {
+	Put(out, magic);
+	Put(out, version);
+	Put(out, page_size);
+}
+
+FileHeader FileHeader::Deserialize(const uint8_t *data) {
+	FileHeader header;
+	header.magic = Take<uint64_t>(data);
+	header.version = Take<uint32_t>(data);
+	header.page_size = Take<uint32_t>(data);
+
+	if (header.magic != COLUMN_FILE_MAGIC)
+		throw std::runtime_error("Not a column file!");
+	if (header.version != COLUMN_FILE_VERSION)
+		throw std::runtime_error("Unsupported column file version!");
+	if (header.page_size != COLUMN_FILE_PAGE_SIZE)
+		throw std::runtime_error("Unsupported column file page size!");
+	return header;
+}
+
+void FileTrailer::Serialize(uint8_t *out) const {
+	Put(out, footer_offset);
+	Put(out, footer_size);
+	Put(out, footer_checksum);
+	Put(out, version);
+	Put(out, magic);
+}
+
+FileTrailer FileTrailer::Deserialize(const uint8_t *data) {
+	FileTrailer trailer;
+	trailer.footer_offset = Take<uint64_t>(data);
+	trailer.footer_size = Take<uint64_t>(data);
+	trailer.footer_checksum = Take<uint32_t>(data);
+	trailer.version = Take<uint32_t>(data);
+	trailer.magic = Take<uint64_t>(data);
+
+	if (trailer.magic != COLUMN_FILE_MAGIC)
+		throw std::runtime_error("Column file is truncated or was not finished!");
+	if (trailer.version != COLUMN_FILE_VERSION)
+		throw std::runtime_error("Unsupported column file version!");
+	return trailer;
+}
+
+} // namespace electricdb
@@ -0,0 +1,232 @@
+#include "electricdb/storage/format/metadata.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace electricdb {
+
+size_t ColumnChunkMeta::NullBitmapSize(uint32_t row_count) const noexcept {
+	/** Padded to 8 bytes so the values after it stay aligned */
+	return null_count ? ((static_cast<size_t>(row_count) + 63) / 64) * 8 : 0;
+}
+
+uint64_t FileMetadata::RowCount() const noexcept {
+	uint64_t rows = 0;
+	for (const auto &row_group : row_groups)
+		rows += row_group.row_count;
+	return rows;
+}
+
+int FileMetadata::ColumnIndex(const std::string &name) const noexcept {
+	for (size_t i = 0; i < columns.size(); i++) {
+		if (columns[i].name == name)
+			return static_cast<int>(i);
+	}
+	return -1;
+}
+
+namespace {
+
+/** @brief Appends little-endian fields to a growing buffer */
+class MetadataWriter {
+  public:
+	explicit MetadataWriter(std::vector<uint8_t> &out) : out_(out) {}
+
+	template <typename T>
+	void Put(T value) {
+		const size_t at = out_.size();
+		out_.resize(at + sizeof(T));
+		std::memcpy(out_.data() + at, &value, sizeof(T));
+	}
+
+	void PutString(const std::string &str) {
+		Put(static_cast<uint32_t>(str.size()));
+		out_.insert(out_.end(), str.begin(), str.end());
+	}
+
+	/** @brief A value of a known type: null flag, then 8 bytes */
+	void PutValue(const Value &value) {
+		Put<uint8_t>(value.IsNull() ? 1 : 0);
+		int64_t bits = 0;
+		if (!value.IsNull()) {
+			switch (value.Type()) {
+			case LogicalType::INT32:
+				bits = value.Get<int32_t>();
+				break;
+			case LogicalType::INT64:
+				bits = value.Get<int64_t>();
+				break;
+			case LogicalType::FLOAT: {
+				const double widened = value.Get<float>();
+				std::memcpy(&bits, &widened, sizeof(bits));
+				break;
+			}
+			case LogicalType::DOUBLE: {
+				const double d = value.Get<double>();
+				std::memcpy(&bits, &d, sizeof(bits));
+				break;
+			}
+			case LogicalType::BOOL:
+				bits = value.Get<bool>() ? 1 : 0;
+				break;
+			default:
+				throw std::runtime_error("Unsupported type!");
+			}
+		}
+		Put(bits);
+	}
+
+  private:
+	std::vector<uint8_t> &out_;
+};
+
+/** @brief Reads the fields written by MetadataWriter, throwing instead of reading past the end */
+class MetadataReader {
+  public:
+	MetadataReader(const uint8_t *data, size_t size) : data_(data), end_(data + size) {}
+
+	template <typename T>
+	T Take() {
+		Need(sizeof(T));
+		T value;
+		std::memcpy(&value, data_, sizeof(T));
+		data_ += sizeof(T);
+		return value;
+	}
+
+	std::string TakeString() {
+		const uint32_t length = Take<uint32_t>();
+		Need(length);
+		std::string str(reinterpret_cast<const char *>(data_), length);
+		data_ += length;
+		return str;
+	}
+
+	void TakeValue(Value &value) {
+		const bool is_null = Take<uint8_t>() != 0;
+		const int64_t bits = Take<int64_t>();
+		if (is_null)
+			return;
+		switch (value.Type()) {
+		case LogicalType::INT32:
+			value.Set<int32_t>(static_cast<int32_t>(bits));
+			break;
+		case LogicalType::INT64:
+			value.Set<int64_t>(bits);
+			break;
+		case LogicalType::FLOAT: {
+			double widened;
+			std::memcpy(&widened, &bits, sizeof(widened));
+			value.Set<float>(static_cast<float>(widened));
+			break;
+		}
+		case LogicalType::DOUBLE: {
+			double d;
+			std::memcpy(&d, &bits, sizeof(d));
+			value.Set<double>(d);
+			break;
+		}
+		case LogicalType::BOOL:
+			value.Set<bool>(bits != 0);
+			break;
+		default:
+			throw std::runtime_error("Corrupt column file metadata!");
+		}
+	}
+
+	/** @brief Check that at least `count` more entries of `bytes` each can follow */
+	void NeedEntries(uint64_t count, size_t bytes) const {
+		if (count > static_cast<uint64_t>(end_ - data_) / bytes)
+			throw std::runtime_error("Corrupt column file metadata!");
+	}
+
+	bool AtEnd() const noexcept { return data_ == end_; }
+
+  private:
+	void Need(size_t bytes) const {
+		if (bytes > static_cast<size_t>(end_ - data_))
+			throw std::runtime_error("Corrupt column file metadata!");
+	}
+
+	const uint8_t *data_;
+	const uint8_t *end_;
+};
+
+} // namespace
+
+std::vector<uint8_t> FileMetadata::Serialize() const {
+	std::vector<uint8_t> out;
+	MetadataWriter writer(out);
+
+	writer.Put(static_cast<uint32_t>(columns.size()));
+	for (const auto &column : columns) {
+		writer.PutString(column.name);
+		writer.Put(static_cast<uint8_t>(column.type));
+	}
+
+	writer.Put(static_cast<uint32_t>(row_groups.size()));
+	for (const auto &row_group : row_groups) {
+		writer.Put(row_group.row_count);
+		for (const auto &chunk : row_group.columns) {
+			writer.Put(chunk.offset);
+			writer.Put(chunk.size);
+			writer.Put(static_cast<uint8_t>(chunk.encoding));
+			writer.Put(chunk.null_count);
+			writer.Put(chunk.checksum);
+			writer.Put(static_cast<uint8_t>(chunk.stats.has_nan ? 1 : 0));
+			writer.PutValue(chunk.stats.min);
+			writer.PutValue(chunk.stats.max);
+		}
+	}
+	return out;
+}
+
+FileMetadata FileMetadata::Deserialize(const uint8_t *data, size_t size) {
+	/** Bytes of the smallest possible column and chunk entries */
+	constexpr size_t column_bytes = sizeof(uint32_t) + sizeof(uint8_t);
+	constexpr size_t chunk_bytes = 8 + 8 + 1 + 4 + 4 + 1 + 2 * (1 + 8);
+
+	MetadataReader reader(data, size);
+	FileMetadata metadata;
+
+	const auto column_count = reader.Take<uint32_t>();
+	reader.NeedEntries(column_count, column_bytes);
+	metadata.columns.resize(column_count);
+	for (auto &column : metadata.columns) {
+		column.name = reader.TakeString();
+		column.type = static_cast<LogicalType>(reader.Take<uint8_t>());
+		if (column.type >= LogicalType::INVALID || column.type == LogicalType::STRING)
+			throw std::runtime_error("Corrupt column file metadata!");
+	}
+
+	const auto row_group_count = reader.Take<uint32_t>();
+	reader.NeedEntries(row_group_count, sizeof(uint32_t) + column_count * chunk_bytes);
+	metadata.row_groups.resize(row_group_count);
+	for (auto &row_group : metadata.row_groups) {
+		row_group.row_count = reader.Take<uint32_t>();
+		row_group.columns.reserve(column_count);
+		for (const auto &column : metadata.columns) {
+			ColumnChunkMeta chunk;
+			chunk.offset = reader.Take<uint64_t>();
+			chunk.size = reader.Take<uint64_t>();
+			chunk.encoding = static_cast<EncodingType>(reader.Take<uint8_t>());
+			chunk.null_count = reader.Take<uint32_t>();
+			chunk.checksum = reader.Take<uint32_t>();
+			chunk.stats = ZoneMap(column.type);
+			chunk.stats.has_nan = reader.Take<uint8_t>() != 0;
+			reader.TakeValue(chunk.stats.min);
+			reader.TakeValue(chunk.stats.max);
+			chunk.stats.has_nulls = chunk.null_count > 0;
+			chunk.stats.count = row_group.row_count;
+			if (chunk.null_count > row_group.row_count)
+				throw std::runtime_error("Corrupt column file metadata!");
+			row_group.columns.push_back(std::move(chunk));
+		}
+	}
+
+	if (!reader.AtEnd())
+		throw std::runtime_error("Corrupt column file metadata!");
+	return metadata;
+}
+
+} // namespace electricdb
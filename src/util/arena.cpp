@@ -97,7 +97,7 @@ void *Arena::Allocate(size_t size, size_t alignment) {
 		block = &blocks_.back();
 		base = reinterpret_cast<uintptr_t>(block->data);
 		aligned = align_up(base, alignment);
-		padding = aligned - current;
+		padding = aligned - base;
 		total = padding + size;
 	}
 
@@ -1,5 +1,13 @@
 #include "electricdb/util/hash.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
 namespace electricdb {
 
 uint64_t Hash::u64(uint64_t v) {
@@ -30,6 +38,19 @@ uint64_t Hash::bytes(const void *data, size_t len) {
 	return h;
 }
 
+uint64_t Hash::key(const void *data, size_t width) {
+	const uint8_t *p = static_cast<const uint8_t *>(data);
+	uint64_t h = 0;
+
+	for (size_t i = 0; i < width; i += sizeof(uint64_t)) {
+		uint64_t word = 0;
+		std::memcpy(&word, p + i, std::min(sizeof(uint64_t), width - i));
+		h = combine(h, u64(word));
+	}
+
+	return h;
+}
+
 uint64_t Hash::string(std::string_view str) {
 	return bytes(str.data(), str.size());
 }
@@ -39,4 +60,51 @@ uint64_t Hash::combine(uint64_t h1, uint64_t h2) {
 	return MurmurHash64(x);
 }
 
+/** @brief Byte-at-a-time lookup table of the reflected CRC-32C polynomial */
+static std::array<uint32_t, 256> Crc32cTable() {
+	std::array<uint32_t, 256> table{};
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; bit++)
+			crc = (crc >> 1) ^ (0x82f63b78U & (0U - (crc & 1U)));
+		table[i] = crc;
+	}
+	return table;
+}
+
+static uint32_t Crc32cPortable(const uint8_t *p, size_t len, uint32_t crc) {
+	static const std::array<uint32_t, 256> table = Crc32cTable();
+	for (size_t i = 0; i < len; i++)
+		crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+	return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) static uint32_t Crc32cHardware(const uint8_t *p, size_t len,
+																 uint32_t crc) {
+	uint64_t crc64 = crc;
+	for (; len >= 8; p += 8, len -= 8) {
+		uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		crc64 = _mm_crc32_u64(crc64, word);
+	}
+	crc = static_cast<uint32_t>(crc64);
+	for (; len > 0; p++, len--)
+		crc = _mm_crc32_u8(crc, *p);
+	return crc;
+}
+#endif
+
+uint32_t Hash::crc32c(const void *data, size_t len, uint32_t crc) {
+	const auto *p = static_cast<const uint8_t *>(data);
+	crc = ~crc;
+#if defined(__x86_64__)
+	static const bool hardware = __builtin_cpu_supports("sse4.2");
+	crc = hardware ? Crc32cHardware(p, len, crc) : Crc32cPortable(p, len, crc);
+#else
+	crc = Crc32cPortable(p, len, crc);
+#endif
+	return ~crc;
+}
+
 } // namespace electricdb
@@ -0,0 +1,50 @@
+#include "electricdb/util/stopwatch.h"
+
+#include <time.h>
+
+namespace electricdb {
+
+Stopwatch::Stopwatch(StopwatchClock clock) : clock_(clock) {}
+
+uint64_t Stopwatch::now_ns(StopwatchClock clock) {
+	timespec ts{};
+	clock_gettime(clock == StopwatchClock::WALL ? CLOCK_MONOTONIC : CLOCK_THREAD_CPUTIME_ID, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+void Stopwatch::start() {
+	if (running_)
+		return;
+	start_ns_ = now_ns(clock_);
+	running_ = true;
+}
+
+void Stopwatch::stop() {
+	if (!running_)
+		return;
+	accumulated_ns_ += now_ns(clock_) - start_ns_;
+	running_ = false;
+}
+
+void Stopwatch::reset() {
+	accumulated_ns_ = 0;
+	running_ = false;
+}
+
+uint64_t Stopwatch::elapsed_ns() const {
+	return running_ ? accumulated_ns_ + (now_ns(clock_) - start_ns_) : accumulated_ns_;
+}
+
+double Stopwatch::elapsed_ms() const {
+	return static_cast<double>(elapsed_ns()) / 1e6;
+}
+
+double Stopwatch::elapsed_sec() const {
+	return static_cast<double>(elapsed_ns()) / 1e9;
+}
+
+bool Stopwatch::running() const {
+	return running_;
+}
+
+} // namespace electricdb
@@ -0,0 +1,236 @@
+#include "electricdb/util/trace.h"
+#include "electricdb/util/stopwatch.h"
+#include "electricdb/util/format.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace electricdb {
+
+std::atomic<bool> Tracer::enabled_{false};
+
+namespace {
+
+/**
+ * @brief Ring of one thread. Only the owning thread writes `events` and `head`, `events` is
+ * allocated by the first recorded event so naming an idle thread costs no ring.
+ */
+struct TraceBuffer {
+	uint32_t tid = 0;
+	std::string thread_name;
+	/** @brief Number of events ever recorded, the next one goes to head % BUFFER_EVENTS */
+	std::atomic<uint64_t> head{0};
+	std::unique_ptr<TraceEvent[]> events;
+};
+
+/**
+ * @brief Every thread's buffer. Buffers live as long as the process, so a thread's events can
+ * still be exported after it exited.
+ */
+struct TraceRegistry {
+	std::mutex lock;
+	std::vector<std::unique_ptr<TraceBuffer>> buffers;
+	/** @brief Now() and steady_clock at the first Enable(), to convert ticks to time */
+	uint64_t origin_ticks = 0;
+	uint64_t origin_ns = 0;
+};
+
+TraceRegistry &Registry() {
+	static TraceRegistry registry;
+	return registry;
+}
+
+TraceBuffer &LocalBuffer() {
+	thread_local TraceBuffer *buffer = nullptr;
+	if (!buffer) {
+		TraceRegistry &registry = Registry();
+		std::lock_guard<std::mutex> guard(registry.lock);
+		registry.buffers.push_back(std::make_unique<TraceBuffer>());
+		buffer = registry.buffers.back().get();
+		buffer->tid = static_cast<uint32_t>(registry.buffers.size());
+	}
+	return *buffer;
+}
+
+} // namespace
+
+void Tracer::Enable() {
+	TraceRegistry &registry = Registry();
+	{
+		std::lock_guard<std::mutex> guard(registry.lock);
+		if (!registry.origin_ns) {
+			registry.origin_ticks = Now();
+			registry.origin_ns = Stopwatch::now_ns();
+		}
+	}
+	enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::Disable() noexcept {
+	enabled_.store(false, std::memory_order_relaxed);
+}
+
+uint64_t Tracer::Now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return Stopwatch::now_ns();
+#endif
+}
+
+void Tracer::Record(const TraceEvent &event) {
+	TraceBuffer &buffer = LocalBuffer();
+	if (!buffer.events)
+		buffer.events.reset(new TraceEvent[BUFFER_EVENTS]);
+	const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+	buffer.events[head & (BUFFER_EVENTS - 1)] = event;
+	/** Publishes the event to an exporting thread */
+	buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::Complete(const char *category, const char *name, uint64_t begin, uint64_t arg) {
+	const uint64_t end = Now();
+	Record({begin, end > begin ? end - begin : 0, arg, category, name, 'X'});
+}
+
+void Tracer::Instant(const char *category, const char *name, uint64_t arg) {
+	Record({Now(), 0, arg, category, name, 'i'});
+}
+
+void Tracer::AsyncBegin(const char *category, const char *name, uint64_t id) {
+	Record({Now(), 0, id, category, name, 'b'});
+}
+
+void Tracer::AsyncEnd(const char *category, const char *name, uint64_t id) {
+	Record({Now(), 0, id, category, name, 'e'});
+}
+
+void Tracer::SetThreadName(const std::string &name) {
+	TraceBuffer &buffer = LocalBuffer();
+	std::lock_guard<std::mutex> guard(Registry().lock);
+	buffer.thread_name = name;
+}
+
+/**
+ * @brief Call `visit(buffer, event)` for every held event, oldest first per buffer
+ *
+ */
+template <typename Visitor>
+static void ForEachEvent(TraceRegistry &registry, Visitor &&visit) {
+	for (auto &buffer : registry.buffers) {
+		const uint64_t head = buffer->head.load(std::memory_order_acquire);
+		const uint64_t first = head > Tracer::BUFFER_EVENTS ? head - Tracer::BUFFER_EVENTS : 0;
+		for (uint64_t i = first; i < head; i++)
+			visit(*buffer, buffer->events[i & (Tracer::BUFFER_EVENTS - 1)]);
+	}
+}
+
+std::vector<TraceEvent> Tracer::Events() {
+	TraceRegistry &registry = Registry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	std::vector<TraceEvent> events;
+	ForEachEvent(registry, [&](const TraceBuffer &, const TraceEvent &event) {
+		events.push_back(event);
+	});
+	return events;
+}
+
+/**
+ * @brief Ticks per nanosecond, measured against steady_clock since the first Enable()
+ *
+ */
+static double TicksPerNanosecond(const TraceRegistry &registry) {
+#if defined(__x86_64__) || defined(__i386__)
+	/** A short interval gives a poor estimate, measure for at least 10ms */
+	const uint64_t min_interval_ns = 10000000;
+	const uint64_t elapsed = Stopwatch::now_ns() - registry.origin_ns;
+	if (elapsed < min_interval_ns)
+		std::this_thread::sleep_for(std::chrono::nanoseconds(min_interval_ns - elapsed));
+
+	const uint64_t ticks = Tracer::Now() - registry.origin_ticks;
+	const uint64_t ns = Stopwatch::now_ns() - registry.origin_ns;
+	return ns ? static_cast<double>(ticks) / static_cast<double>(ns) : 1.0;
+#else
+	(void)registry;
+	return 1.0;
+#endif
+}
+
+std::string Tracer::ToChromeJson() {
+	TraceRegistry &registry = Registry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	const double ticks_per_us = TicksPerNanosecond(registry) * 1000.0;
+	auto micros = [&](uint64_t ticks) { return static_cast<double>(ticks) / ticks_per_us; };
+
+	std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	bool first = true;
+	auto separate = [&]() {
+		if (!first)
+			out += ',';
+		first = false;
+	};
+
+	for (auto &buffer : registry.buffers) {
+		if (buffer->thread_name.empty())
+			continue;
+		separate();
+		/** Thread names are set by the engine, nothing to escape */
+		AppendFormat(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,",
+					 buffer->tid);
+		AppendFormat(out, "\"args\":{\"name\":\"%s\"}}", buffer->thread_name.c_str());
+	}
+
+	ForEachEvent(registry, [&](const TraceBuffer &buffer, const TraceEvent &event) {
+		/** Events recorded before the first Enable() have no timeline to go on */
+		if (event.timestamp < registry.origin_ticks)
+			return;
+		separate();
+		AppendFormat(out, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%u",
+					 event.name, event.category, event.phase, buffer.tid);
+		AppendFormat(out, ",\"ts\":%.3f", micros(event.timestamp - registry.origin_ticks));
+		switch (event.phase) {
+		case 'X':
+			AppendFormat(out, ",\"dur\":%.3f,\"args\":{\"arg\":%llu}}", micros(event.duration),
+						 static_cast<unsigned long long>(event.arg));
+			break;
+		case 'b':
+		case 'e':
+			AppendFormat(out, ",\"id\":\"0x%llx\"}", static_cast<unsigned long long>(event.arg));
+			break;
+		default:
+			AppendFormat(out, ",\"s\":\"t\",\"args\":{\"arg\":%llu}}",
+						 static_cast<unsigned long long>(event.arg));
+			break;
+		}
+	});
+	out += "]}";
+	return out;
+}
+
+void Tracer::WriteChromeJson(const std::string &path) {
+	const std::string json = ToChromeJson();
+	std::FILE *file = std::fopen(path.c_str(), "w");
+	if (!file)
+		throw std::runtime_error("Failed to open trace file!");
+	const size_t written = std::fwrite(json.data(), 1, json.size(), file);
+	const bool closed = std::fclose(file) == 0;
+	if (written != json.size() || !closed)
+		throw std::runtime_error("Failed to write trace file!");
+}
+
+void Tracer::Clear() noexcept {
+	TraceRegistry &registry = Registry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	for (auto &buffer : registry.buffers)
+		buffer->head.store(0, std::memory_order_relaxed);
+}
+
+} // namespace electricdb
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "electricdb/common/constants.h"
+#include "electricdb/execution/engine/batch_size.h"
+#include "electricdb/execution/engine/pipeline_builder.h"
+#include "electricdb/execution/operators/aggregate/hash_aggregate.h"
+#include "electricdb/execution/operators/out/out.h"
+#include "electricdb/execution/operators/scan/scan.h"
+
+#include <cstring>
+
+namespace electricdb {
+class BatchSizeTest : public testing::Test {
+  protected:
+    Arena arena;
+};
+
+TEST_F(BatchSizeTest, GrowthStopsAtTheCacheBudget) {
+    const size_t budget = 256 * 1024;
+    EXPECT_EQ(GrowBatchSize(1, budget), static_cast<uint32_t>(MAX_VECTOR_SIZE));
+    EXPECT_EQ(GrowBatchSize(64, budget), 4096u);
+    EXPECT_EQ(GrowBatchSize(65, budget), 2048u);
+    EXPECT_EQ(GrowBatchSize(256, budget), static_cast<uint32_t>(DEFAULT_VECTOR_SIZE));
+    EXPECT_EQ(GrowBatchSize(1 << 20, budget), static_cast<uint32_t>(DEFAULT_VECTOR_SIZE));
+
+    uint32_t previous = MAX_VECTOR_SIZE;
+    for (size_t width = 1; width < 4096; width++) {
+        const uint32_t size = GrowBatchSize(width, budget);
+        ASSERT_LE(size, previous);
+        ASSERT_GE(size, static_cast<uint32_t>(DEFAULT_VECTOR_SIZE));
+        ASSERT_EQ(size & (size - 1), 0u);
+        previous = size;
+    }
+}
+
+TEST_F(BatchSizeTest, RowWidthCountsNullBits) {
+    EXPECT_EQ(RowWidth({}), 0u);
+    EXPECT_EQ(RowWidth({LogicalType::INT64}), 9u);
+    EXPECT_EQ(RowWidth({LogicalType::INT32, LogicalType::BOOL}), 6u);
+}
+
+TEST_F(BatchSizeTest, PipelinesChooseTheirOwnBatchSize) {
+    const uint32_t rows = 200000;
+    std::vector<Vector> narrow;
+    narrow.emplace_back(LogicalType::INT32, rows, arena);
+    std::vector<Vector> wide;
+    for (int c = 0; c < 64; c++) {
+        wide.emplace_back(LogicalType::INT64, rows, arena);
+    }
+    for (auto *table : {&narrow, &wide}) {
+        for (auto &vec : *table) {
+            vec.SetSize(rows);
+            std::memset(vec.RawData(), 0, rows * GetTypeSize(vec.Type()));
+        }
+    }
+
+    PhysicalColumnScan narrow_scan(narrow);
+    PhysicalHashAggregate narrow_count(narrow_scan.Types(), {}, {{AggregateType::COUNT_STAR}});
+    narrow_count.AddChild(&narrow_scan);
+    PhysicalResultCollector narrow_result(narrow_count.Types());
+    narrow_result.AddChild(&narrow_count);
+
+    PhysicalColumnScan wide_scan(wide);
+    PhysicalHashAggregate wide_count(wide_scan.Types(), {}, {{AggregateType::COUNT_STAR}});
+    wide_count.AddChild(&wide_scan);
+    PhysicalResultCollector wide_result(wide_count.Types());
+    wide_result.AddChild(&wide_count);
+
+    Scheduler scheduler(2);
+    PipelineBuilder narrow_plan(narrow_result);
+    PipelineBuilder wide_plan(wide_result);
+    narrow_plan.Execute(scheduler);
+    wide_plan.Execute(scheduler);
+
+    const uint32_t narrow_size = narrow_plan.Pipelines()[0]->BatchSize();
+    const uint32_t wide_size = wide_plan.Pipelines()[0]->BatchSize();
+    EXPECT_GE(narrow_size, wide_size);
+    EXPECT_EQ(narrow_size, GrowBatchSize(narrow_plan.Pipelines()[0]->LiveRowWidth()));
+    EXPECT_EQ(wide_size, GrowBatchSize(wide_plan.Pipelines()[0]->LiveRowWidth()));
+
+    ASSERT_EQ(narrow_result.Count(), 1u);
+    EXPECT_EQ(narrow_result.Chunk(0)[0].Data<int64_t>()[0], rows);
+    ASSERT_EQ(wide_result.Count(), 1u);
+    EXPECT_EQ(wide_result.Chunk(0)[0].Data<int64_t>()[0], rows);
+}
+
+TEST_F(BatchSizeTest, FixedBatchSizeIsKept) {
+    const uint32_t rows = 10000;
+    std::vector<Vector> table;
+    table.emplace_back(LogicalType::INT64, rows, arena);
+    table[0].SetSize(rows);
+    for (uint32_t i = 0; i < rows; i++) {
+        table[0].Data<int64_t>()[i] = i;
+    }
+
+    PhysicalColumnScan scan(table);
+    PhysicalResultCollector result(scan.Types());
+    result.AddChild(&scan);
+
+    Scheduler scheduler(3);
+    PhysicalResultCollector default_result(scan.Types());
+    default_result.AddChild(&scan);
+    PipelineBuilder default_plan(default_result);
+    default_plan.Execute(scheduler);
+    EXPECT_EQ(default_plan.Pipelines()[0]->BatchSize(),
+              GrowBatchSize(default_plan.Pipelines()[0]->LiveRowWidth()));
+
+    PipelineBuilder builder(result);
+    builder.Pipelines()[0]->SetBatchSize(300);
+    builder.Execute(scheduler);
+
+    EXPECT_THROW(builder.Pipelines()[0]->SetBatchSize(0), std::runtime_error);
+    EXPECT_EQ(builder.Pipelines()[0]->BatchSize(), 300u);
+    ASSERT_EQ(result.Count(), rows);
+    uint64_t row = 0;
+    for (size_t i = 0; i < result.ChunkCount(); i++) {
+        const Vector &vec = result.Chunk(i)[0];
+        ASSERT_LE(vec.Size(), 300u);
+        for (idx_t j = 0; j < vec.Size(); j++, row++) {
+            ASSERT_EQ(vec.Data<int64_t>()[j], static_cast<int64_t>(row));
+        }
+    }
+}
+} // namespace electricdb
\ No newline at end of file
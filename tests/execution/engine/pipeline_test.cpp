@@ -0,0 +1,674 @@
+#include <gtest/gtest.h>
+#include "electricdb/execution/engine/pipeline_builder.h"
+#include "electricdb/execution/expressions/binary_expression.h"
+#include "electricdb/execution/expressions/leaf_expression.h"
+#include "electricdb/execution/operators/aggregate/hash_aggregate.h"
+#include "electricdb/execution/operators/filter/filter.h"
+#include "electricdb/execution/operators/join/join.h"
+#include "electricdb/execution/operators/out/out.h"
+#include "electricdb/execution/operators/projection/projection.h"
+#include "electricdb/execution/operators/scan/scan.h"
+#include "electricdb/execution/operators/sort/physical_sort.h"
+#include "electricdb/util/trace.h"
+
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+
+namespace electricdb {
+class PipelineTest : public testing::Test {
+  protected:
+    Arena arena;
+
+    template <typename T>
+    static T Get(const PhysicalResultCollector &result, size_t column, uint64_t row) {
+        for (size_t i = 0; i < result.ChunkCount(); i++) {
+            const auto &chunk = result.Chunk(i);
+            if (row < chunk[column].Size()) {
+                return chunk[column].Data<T>()[row];
+            }
+            row -= chunk[column].Size();
+        }
+        ADD_FAILURE() << "row out of range";
+        return T();
+    }
+};
+
+TEST_F(PipelineTest, FilterProjectAggregateSort) {
+    const uint32_t rows = 300000;
+    std::vector<Vector> table;
+    table.emplace_back(LogicalType::INT32, rows, arena);
+    table.emplace_back(LogicalType::INT64, rows, arena);
+    table.emplace_back(LogicalType::BOOL, rows, arena);
+    for (auto &vec : table) {
+        vec.SetSize(rows);
+    }
+
+    std::map<int32_t, std::pair<int64_t, int64_t>> expected;
+    for (uint32_t i = 0; i < rows; i++) {
+        const auto key = static_cast<int32_t>(i % 7);
+        table[0].Data<int32_t>()[i] = key;
+        table[1].Data<int64_t>()[i] = i;
+        table[2].Data<bool>()[i] = i % 3 != 0;
+        if (i % 3 != 0) {
+            expected[key].first += 2 * static_cast<int64_t>(i);
+            expected[key].second++;
+        }
+    }
+
+    PhysicalColumnScan scan(table);
+    ColumnExpr flag(2, LogicalType::BOOL);
+    PhysicalFilter filter({LogicalType::INT32, LogicalType::INT64, LogicalType::BOOL}, &flag);
+    filter.AddChild(&scan);
+
+    ColumnExpr key(0, LogicalType::INT32);
+    ColumnExpr value(1, LogicalType::INT64);
+    AddExpr doubled(&value, &value);
+    PhysicalProjection projection({&key, &doubled});
+    projection.AddChild(&filter);
+
+    PhysicalHashAggregate aggregate({LogicalType::INT32, LogicalType::INT64}, {0},
+                                    {{AggregateType::SUM, 1}, {AggregateType::COUNT_STAR}});
+    aggregate.AddChild(&projection);
+
+    PhysicalSort sort(aggregate.Types(), {{0, OrderType::DESCENDING}});
+    sort.AddChild(&aggregate);
+
+    PhysicalResultCollector result(sort.Types());
+    result.AddChild(&sort);
+
+    PipelineBuilder builder(result);
+    const auto &pipelines = builder.Pipelines();
+    ASSERT_EQ(pipelines.size(), 3u);
+    EXPECT_EQ(pipelines[0]->Source(), &scan);
+    EXPECT_EQ(pipelines[0]->Operators().size(), 2u);
+    EXPECT_EQ(pipelines[0]->Sink(), &aggregate);
+    EXPECT_EQ(pipelines[1]->Source(), &aggregate);
+    EXPECT_EQ(pipelines[1]->Sink(), &sort);
+    EXPECT_EQ(pipelines[2]->Source(), &sort);
+    EXPECT_EQ(pipelines[2]->Sink(), &result);
+    ASSERT_EQ(pipelines[2]->Dependencies().size(), 1u);
+    EXPECT_EQ(pipelines[2]->Dependencies()[0], pipelines[1].get());
+    EXPECT_FALSE(pipelines[2]->IsReady());
+
+    Scheduler scheduler(4);
+    builder.Execute(scheduler);
+
+    ASSERT_EQ(result.Count(), expected.size());
+    uint64_t row = 0;
+    for (auto it = expected.rbegin(); it != expected.rend(); ++it, row++) {
+        EXPECT_EQ(Get<int32_t>(result, 0, row), it->first);
+        EXPECT_EQ(Get<int64_t>(result, 1, row), it->second.first);
+        EXPECT_EQ(Get<int64_t>(result, 2, row), it->second.second);
+    }
+}
+
+TEST_F(PipelineTest, SortOutputKeepsOrderAcrossWorkers) {
+    const uint32_t rows = 500000;
+    std::vector<Vector> table;
+    table.emplace_back(LogicalType::INT64, rows, arena);
+    table[0].SetSize(rows);
+    std::mt19937_64 rng(7);
+    for (uint32_t i = 0; i < rows; i++) {
+        table[0].Data<int64_t>()[i] = static_cast<int64_t>(rng() % 1000000);
+    }
+
+    PhysicalColumnScan scan(table);
+    PhysicalSort sort({LogicalType::INT64}, {{0}});
+    sort.AddChild(&scan);
+    PhysicalResultCollector result({LogicalType::INT64});
+    result.AddChild(&sort);
+
+    PipelineBuilder builder(result);
+    ASSERT_EQ(builder.Pipelines().size(), 2u);
+    Scheduler scheduler(4);
+    builder.Execute(scheduler);
+
+    ASSERT_EQ(result.Count(), rows);
+    int64_t previous = -1;
+    for (size_t i = 0; i < result.ChunkCount(); i++) {
+        const Vector &vec = result.Chunk(i)[0];
+        for (idx_t j = 0; j < vec.Size(); j++) {
+            ASSERT_LE(previous, vec.Data<int64_t>()[j]);
+            previous = vec.Data<int64_t>()[j];
+        }
+    }
+}
+
+TEST_F(PipelineTest, HashJoinBuildsBeforeProbe) {
+    const uint32_t build_rows = 1000;
+    const uint32_t probe_rows = 250000;
+    std::vector<Vector> build;
+    build.emplace_back(LogicalType::INT32, build_rows, arena);
+    build.emplace_back(LogicalType::INT64, build_rows, arena);
+    for (auto &vec : build) {
+        vec.SetSize(build_rows);
+    }
+    for (uint32_t i = 0; i < build_rows; i++) {
+        build[0].Data<int32_t>()[i] = static_cast<int32_t>(i);
+        build[1].Data<int64_t>()[i] = 10 * static_cast<int64_t>(i);
+    }
+    build[1].SetNull(5);
+
+    std::vector<Vector> probe;
+    probe.emplace_back(LogicalType::INT32, probe_rows, arena);
+    probe[0].SetSize(probe_rows);
+    for (uint32_t i = 0; i < probe_rows; i++) {
+        probe[0].Data<int32_t>()[i] = static_cast<int32_t>(i % 2000);
+    }
+    probe[0].SetNull(1);
+
+    PhysicalColumnScan probe_scan(probe);
+    PhysicalColumnScan build_scan(build);
+    PhysicalHashJoin join({LogicalType::INT32}, {LogicalType::INT32, LogicalType::INT64}, {0}, {0});
+    join.AddChild(&probe_scan);
+    join.AddChild(&build_scan);
+    PhysicalResultCollector result(join.Types());
+    result.AddChild(&join);
+
+    PipelineBuilder builder(result);
+    const auto &pipelines = builder.Pipelines();
+    ASSERT_EQ(pipelines.size(), 2u);
+    EXPECT_EQ(pipelines[0]->Source(), &build_scan);
+    EXPECT_EQ(pipelines[0]->Sink(), &join);
+    EXPECT_EQ(pipelines[1]->Source(), &probe_scan);
+    ASSERT_EQ(pipelines[1]->Operators().size(), 1u);
+    EXPECT_EQ(pipelines[1]->Operators()[0], &join);
+    ASSERT_EQ(pipelines[1]->Dependencies().size(), 1u);
+    EXPECT_EQ(pipelines[1]->Dependencies()[0], pipelines[0].get());
+
+    Scheduler scheduler(4);
+    builder.Execute(scheduler);
+
+    /** Keys below 1000 match once, except the null probe row */
+    const uint64_t expected = probe_rows / 2 - 1;
+    ASSERT_EQ(result.Count(), expected);
+    uint64_t nulls = 0;
+    for (size_t i = 0; i < result.ChunkCount(); i++) {
+        const auto &chunk = result.Chunk(i);
+        for (idx_t j = 0; j < chunk[0].Size(); j++) {
+            const int32_t key = chunk[0].Data<int32_t>()[j];
+            ASSERT_EQ(chunk[1].Data<int32_t>()[j], key);
+            if (chunk[2].IsNull(j)) {
+                ASSERT_EQ(key, 5);
+                nulls++;
+            } else {
+                ASSERT_EQ(chunk[2].Data<int64_t>()[j], 10 * static_cast<int64_t>(key));
+            }
+        }
+    }
+    EXPECT_EQ(nulls, probe_rows / 2000);
+}
+
+TEST_F(PipelineTest, HashJoinResumesWhenOutputIsFull) {
+    const uint32_t build_rows = 5000;
+    const uint32_t probe_rows = 3000;
+    std::vector<Vector> build;
+    build.emplace_back(LogicalType::INT64, build_rows, arena);
+    build[0].SetSize(build_rows);
+    for (uint32_t i = 0; i < build_rows; i++) {
+        build[0].Data<int64_t>()[i] = i % 10;
+    }
+    std::vector<Vector> probe;
+    probe.emplace_back(LogicalType::INT64, probe_rows, arena);
+    probe[0].SetSize(probe_rows);
+    for (uint32_t i = 0; i < probe_rows; i++) {
+        probe[0].Data<int64_t>()[i] = i % 20;
+    }
+
+    PhysicalColumnScan probe_scan(probe);
+    PhysicalColumnScan build_scan(build);
+    PhysicalHashJoin join({LogicalType::INT64}, {LogicalType::INT64}, {0}, {0});
+    join.AddChild(&probe_scan);
+    join.AddChild(&build_scan);
+    PhysicalHashAggregate count(join.Types(), {}, {{AggregateType::COUNT_STAR}});
+    count.AddChild(&join);
+    PhysicalResultCollector result(count.Types());
+    result.AddChild(&count);
+
+    PipelineBuilder builder(result);
+    ASSERT_EQ(builder.Pipelines().size(), 3u);
+    Scheduler scheduler(2);
+    builder.Execute(scheduler);
+
+    /** Every probe row with a key below 10 matches 500 build rows */
+    ASSERT_EQ(result.Count(), 1u);
+    EXPECT_EQ(Get<int64_t>(result, 0, 0), static_cast<int64_t>(probe_rows / 2 * 500));
+}
+
+TEST_F(PipelineTest, AggregateWithoutGroupsOverEmptyInput) {
+    std::vector<Vector> table;
+    table.emplace_back(LogicalType::DOUBLE, 16, arena);
+
+    PhysicalColumnScan scan(table);
+    PhysicalHashAggregate aggregate({LogicalType::DOUBLE}, {},
+                                    {{AggregateType::COUNT_STAR}, {AggregateType::SUM, 0}});
+    aggregate.AddChild(&scan);
+    PhysicalResultCollector result(aggregate.Types());
+    result.AddChild(&aggregate);
+
+    Scheduler scheduler(2);
+    PipelineBuilder(result).Execute(scheduler);
+
+    ASSERT_EQ(result.Count(), 1u);
+    EXPECT_EQ(Get<int64_t>(result, 0, 0), 0);
+    EXPECT_TRUE(result.Chunk(0)[1].IsNull(0));
+}
+
+TEST_F(PipelineTest, AggregateGroupsFloatsLikeTheSort) {
+    /** -0.0 groups with 0.0, NaNs of any sign and payload form one group */
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double payload_nan = std::bit_cast<double>(uint64_t{0x7ff8000000000001});
+    const std::vector<double> values = {0.0, -0.0, nan, -nan, payload_nan, 1.0, -0.0, nan};
+
+    /** Flat keys, then dictionaries grouped by code and row by row */
+    for (uint32_t entries : {0u, 8u, 100u}) {
+        const idx_t count = values.size();
+        Arena chunk_arena;
+        std::vector<Vector> chunk;
+        chunk.emplace_back(LogicalType::DOUBLE, count, chunk_arena);
+        Vector dictionary(LogicalType::DOUBLE, std::max<uint32_t>(entries, 1), chunk_arena);
+        SelectionVector codes(chunk_arena, count);
+        if (entries == 0) {
+            chunk[0].SetSize(count);
+            std::copy(values.begin(), values.end(), chunk[0].Data<double>());
+        } else {
+            dictionary.SetSize(entries);
+            for (uint32_t e = 0; e < entries; e++) {
+                dictionary.Data<double>()[e] = e < count ? values[e] : 2.0 + e;
+            }
+            for (idx_t i = 0; i < count; i++) {
+                codes.Data()[i] = static_cast<sel_t>(i);
+            }
+            chunk[0].ReferenceDictionary(dictionary, codes.Data(), count);
+        }
+
+        PhysicalHashAggregate aggregate({LogicalType::DOUBLE}, {0}, {{AggregateType::COUNT_STAR}});
+        ExecutionContext ctx;
+        auto local = aggregate.InitLocalSink();
+        aggregate.Sink(ctx, *local, chunk);
+        aggregate.Combine(*local);
+        Scheduler scheduler(1);
+        aggregate.Finalize(scheduler, nullptr);
+
+        ASSERT_EQ(aggregate.SourceRowCount(), 3u) << entries << " entries";
+        auto out = PhysicalOperator::MakeChunk(aggregate.Types(), 3, arena);
+        auto source = aggregate.InitLocalSource();
+        aggregate.GetData(ctx, *source, 0, 3, out);
+        std::map<std::string, int64_t> groups;
+        for (idx_t i = 0; i < 3; i++) {
+            const double key = out[0].Data<double>()[i];
+            EXPECT_FALSE(std::signbit(key));
+            groups[std::isnan(key) ? "nan" : std::to_string(key)] = out[1].Data<int64_t>()[i];
+        }
+        const std::map<std::string, int64_t> expected = {
+                {"0.000000", 3}, {"1.000000", 1}, {"nan", 4}};
+        EXPECT_EQ(groups, expected) << entries << " entries";
+    }
+}
+
+/** @brief Column scan that cancels `token` as soon as the sort above it has spilled */
+class CancelAfterSpillScan final : public PhysicalOperator {
+    public:
+        CancelAfterSpillScan(const std::vector<Vector> &columns, const SpillManager &spill,
+                             CancellationToken &token)
+            : PhysicalOperator(PhysicalOperatorType::COLUMN_SCAN, {LogicalType::INT64}),
+              scan_(columns), spill_(spill), token_(token) {}
+
+        bool IsSource() const override { return true; }
+
+        uint64_t SourceRowCount() const override { return scan_.SourceRowCount(); }
+
+        void GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset, idx_t count,
+                     std::vector<Vector> &out) const override {
+            if (spill_.BytesSpilled() > 0) {
+                token_.Cancel();
+            }
+            scan_.GetData(ctx, state, offset, count, out);
+        }
+
+    private:
+        PhysicalColumnScan scan_;
+        const SpillManager &spill_;
+        CancellationToken &token_;
+};
+
+/** @brief Column scan that cancels `token` in its second batch and throws from inside GetData() */
+class CancellingScan final : public PhysicalOperator {
+    public:
+        CancellingScan(const std::vector<Vector> &columns, CancellationToken &token)
+            : PhysicalOperator(PhysicalOperatorType::COLUMN_SCAN, {LogicalType::INT64}),
+              scan_(columns), token_(token) {}
+
+        bool IsSource() const override { return true; }
+
+        uint64_t SourceRowCount() const override { return scan_.SourceRowCount(); }
+
+        void GetData(ExecutionContext &ctx, LocalSourceState &state, uint64_t offset, idx_t count,
+                     std::vector<Vector> &out) const override {
+            if (offset > 0) {
+                token_.Cancel();
+                token_.ThrowIfCancelled();
+            }
+            scan_.GetData(ctx, state, offset, count, out);
+        }
+
+    private:
+        PhysicalColumnScan scan_;
+        CancellationToken &token_;
+};
+
+/**
+ * @brief Source of dictionary vectors (key INT32, flag BOOL, value INT64) over `entries` entries:
+ * row i has code i % entries in every column, key entry e is 3 * e, flag entry e is e % 3 != 0
+ * and value entry e is e. Every 11th key is NULL.
+ */
+class DictionaryScan final : public PhysicalOperator {
+    public:
+        DictionaryScan(uint32_t entries, uint32_t rows)
+            : PhysicalOperator(PhysicalOperatorType::COLUMN_SCAN,
+                               {LogicalType::INT32, LogicalType::BOOL, LogicalType::INT64}),
+              rows_(rows), codes_(arena_, rows) {
+            for (LogicalType type : types_) {
+                dictionaries_.emplace_back(type, entries, arena_);
+                dictionaries_.back().SetSize(entries);
+            }
+            for (uint32_t e = 0; e < entries; e++) {
+                dictionaries_[0].Data<int32_t>()[e] = static_cast<int32_t>(3 * e);
+                dictionaries_[1].Data<bool>()[e] = e % 3 != 0;
+                dictionaries_[2].Data<int64_t>()[e] = e;
+            }
+            for (uint32_t i = 0; i < rows; i++) {
+                codes_.Data()[i] = static_cast<sel_t>(i % entries);
+            }
+        }
+
+        bool IsSource() const override { return true; }
+
+        uint64_t SourceRowCount() const override { return rows_; }
+
+        void GetData(ExecutionContext &, LocalSourceState &, uint64_t offset, idx_t count,
+                     std::vector<Vector> &out) const override {
+            for (size_t c = 0; c < out.size(); c++) {
+                out[c].ReferenceDictionary(dictionaries_[c], codes_.Data() + offset, count);
+            }
+            for (idx_t i = 0; i < count; i++) {
+                if ((offset + i) % 11 == 0) {
+                    out[0].SetNull(i);
+                }
+            }
+        }
+
+    private:
+        uint32_t rows_;
+        Arena arena_;
+        SelectionVector codes_;
+        std::vector<Vector> dictionaries_;
+};
+
+TEST_F(PipelineTest, DictionaryVectorsFlowThroughFilterProjectionAndAggregate) {
+    /** Dictionaries smaller than a batch are evaluated by code, larger ones row by row */
+    for (uint32_t entries : {7u, 5000u}) {
+        const uint32_t rows = 20000;
+        DictionaryScan scan(entries, rows);
+        ColumnExpr flag(1, LogicalType::BOOL);
+        PhysicalFilter filter(scan.Types(), &flag);
+        filter.AddChild(&scan);
+        ColumnExpr key(0, LogicalType::INT32);
+        ColumnExpr value(2, LogicalType::INT64);
+        AddExpr doubled(&value, &value);
+        PhysicalProjection projection({&key, &doubled});
+        projection.AddChild(&filter);
+        PhysicalHashAggregate aggregate(projection.Types(), {0},
+                                        {{AggregateType::SUM, 1}, {AggregateType::COUNT_STAR}});
+        aggregate.AddChild(&projection);
+        PhysicalResultCollector result(aggregate.Types());
+        result.AddChild(&aggregate);
+
+        PipelineBuilder builder(result);
+        Scheduler scheduler(2);
+        builder.Execute(scheduler);
+
+        /** Key -1 stands for NULL */
+        std::map<int32_t, std::pair<int64_t, int64_t>> expected;
+        for (uint32_t i = 0; i < rows; i++) {
+            const uint32_t e = i % entries;
+            if (e % 3 != 0) {
+                const int32_t group = i % 11 == 0 ? -1 : static_cast<int32_t>(3 * e);
+                expected[group].first += 2 * static_cast<int64_t>(e);
+                expected[group].second++;
+            }
+        }
+        std::map<int32_t, std::pair<int64_t, int64_t>> groups;
+        for (size_t i = 0; i < result.ChunkCount(); i++) {
+            const auto &chunk = result.Chunk(i);
+            for (uint32_t r = 0; r < chunk[0].Size(); r++) {
+                const int32_t group = chunk[0].IsNull(r) ? -1 : chunk[0].Data<int32_t>()[r];
+                groups[group] = {chunk[1].Data<int64_t>()[r], chunk[2].Data<int64_t>()[r]};
+            }
+        }
+        EXPECT_EQ(groups, expected) << entries << " entries";
+    }
+}
+
+TEST_F(PipelineTest, CancelStopsPipelinesAndReleasesState) {
+    const uint32_t rows = 4000000;
+    std::vector<Vector> table;
+    table.emplace_back(LogicalType::INT64, rows, arena);
+    table[0].SetSize(rows);
+    std::mt19937_64 rng(11);
+    for (uint32_t i = 0; i < rows; i++) {
+        table[0].Data<int64_t>()[i] = static_cast<int64_t>(rng());
+    }
+
+    /** The scan cancels the query once the sort has spilled, however fast the machine is */
+    SpillManager spill(testing::TempDir());
+    CancellationToken token;
+    CancelAfterSpillScan scan(table, spill, token);
+    PhysicalSort sort({LogicalType::INT64}, {{0}}, 1 << 20, &spill);
+    sort.AddChild(&scan);
+    PhysicalResultCollector result({LogicalType::INT64});
+    result.AddChild(&sort);
+
+    Scheduler scheduler(2);
+    PipelineBuilder builder(result);
+
+    try {
+        builder.Execute(scheduler, &token);
+        FAIL() << "expected QueryCancelled";
+    } catch (const QueryCancelled &e) {
+        EXPECT_EQ(e.Reason(), CancelReason::USER);
+    }
+
+    EXPECT_GT(spill.BytesSpilled(), 0u);
+    EXPECT_EQ(spill.BytesOnDisk(), 0u);
+    EXPECT_EQ(sort.SourceRowCount(), 0u);
+    EXPECT_EQ(result.Count(), 0u);
+}
+
+TEST_F(PipelineTest, CancelledMorselRestoresTheWorkerContext) {
+    const uint32_t rows = 10000;
+    std::vector<Vector> table;
+    table.emplace_back(LogicalType::INT64, rows, arena);
+    table[0].SetSize(rows);
+
+    /** One worker, so the query after the cancelled one runs on the same context */
+    Scheduler scheduler(1);
+    {
+        CancellationToken token;
+        CancellingScan scan(table, token);
+        PhysicalResultCollector result({LogicalType::INT64});
+        result.AddChild(&scan);
+        PipelineBuilder builder(result);
+        builder.Pipelines()[0]->SetBatchSize(300);
+        builder.EnableProfiling();
+        EXPECT_THROW(builder.Execute(scheduler, &token), QueryCancelled);
+    }
+
+    std::atomic<bool> restored{false};
+    scheduler.Run(
+            [&](ExecutionContext &ctx, uint32_t, const Morsel &) {
+                restored = ctx.VectorSize() == DEFAULT_VECTOR_SIZE && ctx.Token() == nullptr &&
+                           ctx.Metrics() == nullptr;
+            },
+            1);
+    EXPECT_TRUE(restored.load());
+}
+
+TEST_F(PipelineTest, CancelledTaskSkipsRemainingMorsels) {
+    Scheduler scheduler(2);
+    CancellationToken token;
+    std::atomic<uint64_t> morsels{0};
+    auto task = scheduler.Submit(
+            [&](ExecutionContext &, uint32_t, const Morsel &) {
+                if (morsels.fetch_add(1) == 10) {
+                    token.Cancel();
+                }
+            },
+            1000000, 100, &token);
+
+    EXPECT_THROW(task->Wait(), QueryCancelled);
+    EXPECT_TRUE(task->IsDone());
+    EXPECT_LT(morsels.load(), 100u);
+}
+
+TEST_F(PipelineTest, ProfileCountsRowsPerOperator) {
+    const uint32_t rows = 250000;
+    std::vector<Vector> table;
+    table.emplace_back(LogicalType::INT32, rows, arena);
+    table.emplace_back(LogicalType::BOOL, rows, arena);
+    uint64_t selected = 0;
+    for (auto &vec : table) {
+        vec.SetSize(rows);
+    }
+    for (uint32_t i = 0; i < rows; i++) {
+        table[0].Data<int32_t>()[i] = static_cast<int32_t>(i % 100);
+        table[1].Data<bool>()[i] = i % 4 == 0;
+        selected += i % 4 == 0 ? 1 : 0;
+    }
+
+    PhysicalColumnScan scan(table);
+    ColumnExpr flag(1, LogicalType::BOOL);
+    PhysicalFilter filter(scan.Types(), &flag);
+    filter.AddChild(&scan);
+    PhysicalHashAggregate aggregate(filter.Types(), {0}, {{AggregateType::COUNT_STAR}});
+    aggregate.AddChild(&filter);
+    PhysicalResultCollector result(aggregate.Types());
+    result.AddChild(&aggregate);
+
+    Scheduler scheduler(2);
+    PipelineBuilder builder(result);
+    builder.Execute(scheduler);
+    EXPECT_EQ(builder.Profile().Root().metrics.rows_in, 0u);
+
+    builder.EnableProfiling();
+    builder.Execute(scheduler);
+    const QueryProfile profile = builder.Profile();
+
+    const ProfileNode &collector = profile.Root();
+    EXPECT_EQ(collector.name, "RESULT_COLLECTOR");
+    EXPECT_EQ(collector.metrics.rows_in, 25u);
+
+    ASSERT_EQ(collector.children.size(), 1u);
+    const ProfileNode &agg = collector.children[0];
+    EXPECT_EQ(agg.name, "HASH_AGGREGATE");
+    EXPECT_EQ(agg.metrics.rows_in, selected);
+    EXPECT_EQ(agg.metrics.rows_out, 25u);
+    EXPECT_EQ(agg.metrics.probes, selected);
+    EXPECT_GE(agg.metrics.AverageProbeLength(), 1.0);
+
+    ASSERT_EQ(agg.children.size(), 1u);
+    const ProfileNode &filter_node = agg.children[0];
+    EXPECT_EQ(filter_node.metrics.rows_in, rows);
+    EXPECT_EQ(filter_node.metrics.rows_out, selected);
+    EXPECT_GT(filter_node.metrics.batches, 0u);
+    EXPECT_GT(filter_node.metrics.bytes_allocated, 0u);
+    EXPECT_GE(filter_node.metrics.threads, 1u);
+    EXPECT_LE(filter_node.metrics.threads, 2u);
+
+    ASSERT_EQ(filter_node.children.size(), 1u);
+    const ProfileNode &scan_node = filter_node.children[0];
+    EXPECT_EQ(scan_node.metrics.rows_out, rows);
+    EXPECT_EQ(scan_node.metrics.bytes_read, rows * (sizeof(int32_t) + sizeof(bool)));
+    EXPECT_GT(scan_node.metrics.wall_ns, 0u);
+    EXPECT_GT(profile.WallTime(), 0u);
+
+    EXPECT_NE(profile.ToText().find("COLUMN_SCAN"), std::string::npos);
+    EXPECT_NE(profile.ToJson().find("\"name\":\"FILTER\""), std::string::npos);
+}
+
+TEST_F(PipelineTest, HardwareCountersAreOptional) {
+    const uint32_t rows = 50000;
+    std::vector<Vector> table;
+    table.emplace_back(LogicalType::INT64, rows, arena);
+    table[0].SetSize(rows);
+    for (uint32_t i = 0; i < rows; i++) {
+        table[0].Data<int64_t>()[i] = i;
+    }
+
+    PhysicalColumnScan scan(table);
+    PhysicalHashAggregate aggregate(scan.Types(), {}, {{AggregateType::SUM, 0}});
+    aggregate.AddChild(&scan);
+    PhysicalResultCollector result(aggregate.Types());
+    result.AddChild(&aggregate);
+
+    Scheduler scheduler(2);
+    PipelineBuilder builder(result);
+    builder.EnableProfiling(true);
+    builder.Execute(scheduler);
+    ASSERT_EQ(result.Count(), 1u);
+    EXPECT_EQ(Get<int64_t>(result, 0, 0), int64_t(rows) * (rows - 1) / 2);
+
+    /** Counted where the kernel allows it, otherwise the profile is just missing them */
+    const QueryProfile profile = builder.Profile();
+    const ProfileNode &agg = profile.Root().children[0];
+    EXPECT_EQ(agg.metrics.rows_in, rows);
+    if (PerfCounters().Counts(PerfEvent::INSTRUCTIONS)) {
+        EXPECT_GT(agg.metrics.instructions, 0u);
+        EXPECT_NE(profile.ToText().find("ipc="), std::string::npos);
+    } else {
+        EXPECT_EQ(agg.metrics.instructions, 0u);
+    }
+}
+
+#ifdef TRACING_ENABLED
+TEST_F(PipelineTest, TracesPipelinesAndMorsels) {
+    const uint32_t rows = 300000;
+    std::vector<Vector> table;
+    table.emplace_back(LogicalType::INT64, rows, arena);
+    table[0].SetSize(rows);
+
+    PhysicalColumnScan scan(table);
+    PhysicalHashAggregate aggregate(scan.Types(), {}, {{AggregateType::COUNT_STAR}});
+    aggregate.AddChild(&scan);
+    PhysicalResultCollector result(aggregate.Types());
+    result.AddChild(&aggregate);
+
+    Scheduler scheduler(2);
+    Tracer::Clear();
+    Tracer::Enable();
+    PipelineBuilder(result).Execute(scheduler);
+    Tracer::Disable();
+
+    uint64_t morsel_rows = 0;
+    size_t pipeline_begins = 0;
+    size_t pipeline_ends = 0;
+    for (const auto &event : Tracer::Events()) {
+        const std::string name = event.name;
+        morsel_rows += name == "morsel" ? event.arg : 0;
+        pipeline_begins += name == "pipeline" && event.phase == 'b' ? 1 : 0;
+        pipeline_ends += name == "pipeline" && event.phase == 'e' ? 1 : 0;
+    }
+    Tracer::Clear();
+
+    /** The aggregate's input and output pipelines */
+    EXPECT_EQ(pipeline_begins, 2u);
+    EXPECT_EQ(pipeline_ends, 2u);
+    EXPECT_EQ(morsel_rows, rows + 1);
+}
+#endif
+} // namespace electricdb
\ No newline at end of file
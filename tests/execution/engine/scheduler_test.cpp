@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "electricdb/execution/engine/scheduler.h"
+#include "electricdb/util/trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace electricdb {
+class SchedulerTest : public testing::Test {};
+
+TEST_F(SchedulerTest, EveryRowRunsExactlyOnce) {
+    Scheduler scheduler(4);
+    ASSERT_EQ(scheduler.WorkerCount(), 4u);
+
+    const uint64_t rows = 1000003;
+    std::vector<std::atomic<uint8_t>> seen(rows);
+    std::vector<std::atomic<uint64_t>> per_worker(scheduler.WorkerCount());
+
+    scheduler.Run(
+            [&](ExecutionContext &context, uint32_t worker_id, const Morsel &morsel) {
+                EXPECT_LE(morsel.end - morsel.begin, 10000u);
+                EXPECT_EQ(context.VectorSize(), static_cast<uint32_t>(DEFAULT_VECTOR_SIZE));
+                for (uint64_t i = morsel.begin; i < morsel.end; i++) {
+                    seen[i].fetch_add(1);
+                }
+                per_worker[worker_id].fetch_add(morsel.end - morsel.begin);
+            },
+            rows, 10000);
+
+    for (uint64_t i = 0; i < rows; i++) {
+        ASSERT_EQ(seen[i].load(), 1) << i;
+    }
+    uint64_t total = 0;
+    for (auto &count : per_worker) {
+        total += count.load();
+    }
+    EXPECT_EQ(total, rows);
+}
+
+TEST_F(SchedulerTest, IdleWorkersStealFromSkewedRanges) {
+    Scheduler scheduler(4);
+
+    /** The first quarter of the rows is 50x more expensive than the rest */
+    std::vector<std::atomic<uint64_t>> per_worker(scheduler.WorkerCount());
+    scheduler.Run(
+            [&](ExecutionContext &, uint32_t worker_id, const Morsel &morsel) {
+                if (morsel.begin < 2500) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+                per_worker[worker_id].fetch_add(morsel.end - morsel.begin);
+            },
+            10000, 100);
+
+    EXPECT_GT(scheduler.StealCount(), 0u);
+    for (auto &count : per_worker) {
+        EXPECT_GT(count.load(), 0u);
+    }
+}
+
+TEST_F(SchedulerTest, ConcurrentTasksShareWorkers) {
+    Scheduler scheduler(2);
+
+    /** A long task must not hold back a short one submitted after it */
+    std::atomic<bool> short_done{false};
+    std::atomic<uint64_t> long_morsels_after{0};
+    auto long_task = scheduler.Submit(
+            [&](ExecutionContext &, uint32_t, const Morsel &) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                if (short_done.load()) {
+                    long_morsels_after.fetch_add(1);
+                }
+            },
+            400, 1);
+    auto short_task = scheduler.Submit(
+            [&](ExecutionContext &, uint32_t, const Morsel &) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            },
+            10, 1);
+
+    short_task->Wait();
+    short_done.store(true);
+    long_task->Wait();
+    EXPECT_TRUE(long_task->IsDone());
+    EXPECT_GT(long_morsels_after.load(), 300u);
+}
+
+TEST_F(SchedulerTest, MorselExceptionIsRethrown) {
+    Scheduler scheduler(3);
+    std::atomic<uint64_t> executed{0};
+    auto task = scheduler.Submit(
+            [&](ExecutionContext &, uint32_t, const Morsel &morsel) {
+                executed.fetch_add(1);
+                if (morsel.begin <= 500 && 500 < morsel.end) {
+                    throw std::runtime_error("morsel failed");
+                }
+            },
+            100000, 100);
+    EXPECT_THROW(task->Wait(), std::runtime_error);
+    EXPECT_TRUE(task->IsDone());
+    EXPECT_LE(executed.load(), 1000u);
+}
+
+TEST_F(SchedulerTest, EmptyTaskIsDone) {
+    Scheduler scheduler(1);
+    bool called = false;
+    scheduler.Run([&](ExecutionContext &, uint32_t, const Morsel &) { called = true; }, 0);
+    EXPECT_FALSE(called);
+}
+
+#ifdef TRACING_ENABLED
+TEST_F(SchedulerTest, WorkersAreNamedForATracerEnabledLater) {
+    {
+        Scheduler scheduler(2);
+        /** Both morsels wait for each other, so both workers have started before tracing does */
+        std::atomic<uint32_t> started{0};
+        scheduler.Run(
+                [&](ExecutionContext &, uint32_t, const Morsel &) {
+                    started.fetch_add(1);
+                    while (started.load() < 2) {
+                        std::this_thread::yield();
+                    }
+                },
+                2, 1);
+
+        Tracer::Clear();
+        Tracer::Enable();
+        scheduler.Run([](ExecutionContext &, uint32_t, const Morsel &) {}, 1000, 10);
+    }
+    Tracer::Disable();
+
+    const std::string json = Tracer::ToChromeJson();
+    Tracer::Clear();
+    EXPECT_NE(json.find("\"args\":{\"name\":\"worker 0\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"worker 1\"}"), std::string::npos);
+}
+#endif
+} // namespace electricdb
\ No newline at end of file
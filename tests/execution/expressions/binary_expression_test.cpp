@@ -74,4 +74,42 @@ TEST(BinaryExpressionTest, AddExprNullPropagation) {
     ASSERT_FALSE(result.IsNull(0));
     ASSERT_TRUE(result.IsNull(1));
 }
+
+TEST(BinaryExpressionTest, AddExprOnlyVisitsSelectedRows) {
+    ExecutionContext ctx;
+    Arena &arena = ctx.GetArena();
+
+    std::vector<Vector> input;
+    input.emplace_back(LogicalType::INT64, 4, arena);
+    input.emplace_back(LogicalType::INT64, 4, arena);
+    for (auto &vec : input) {
+        vec.SetSize(4);
+        for (int64_t i = 0; i < 4; i++) {
+            vec.Data<int64_t>()[i] = i + 1;
+        }
+    }
+
+    SelectionVector sel(arena, 2);
+    sel.Set(0, 1);
+    sel.Set(1, 3);
+    ctx.SetInput(&input);
+    ctx.SetSelection(&sel);
+
+    ColumnExpr left(0, LogicalType::INT64);
+    ColumnExpr right(1, LogicalType::INT64);
+    AddExpr add(&left, &right);
+
+    Vector &result = ctx.GetTempVector(LogicalType::INT64);
+    result.SetSize(4);
+    result.Data<int64_t>()[0] = -1;
+    result.Data<int64_t>()[2] = -1;
+
+    add.Execute(ctx, result);
+
+    auto out = result.Data<int64_t>();
+    EXPECT_EQ(out[0], -1);
+    EXPECT_EQ(out[1], 4);
+    EXPECT_EQ(out[2], -1);
+    EXPECT_EQ(out[3], 8);
+}
 } // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "electricdb/execution/operators/aggregate/aggregate.h"
+#include "electricdb/storage/format/column_file.h"
+#include "electricdb/util/arena.h"
+#include "temp_path.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace electricdb {
+class AggregateFunctionTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            path = TempPath(".edb");
+        }
+
+        void TearDown() override { File::Remove(path); }
+
+        /**
+         * @brief Write rows (day INT32, price DOUBLE) sorted on day, 250 rows per day, stored RLE.
+         * The price changes every 100 rows and rows [300, 420) have no price.
+         */
+        void WriteDays(uint32_t rows, uint32_t row_group_size) {
+            ColumnFileWriter writer(
+                    path, {{"day", LogicalType::INT32}, {"price", LogicalType::DOUBLE}},
+                    row_group_size);
+            writer.SetEncoding(0, EncodingType::RLE);
+            writer.SetEncoding(1, EncodingType::RLE);
+            std::vector<Vector> columns;
+            columns.emplace_back(LogicalType::INT32, rows, arena);
+            columns.emplace_back(LogicalType::DOUBLE, rows, arena);
+            columns[0].SetSize(rows);
+            columns[1].SetSize(rows);
+            for (uint32_t i = 0; i < rows; i++) {
+                columns[0].Data<int32_t>()[i] = 20000 + static_cast<int32_t>(i / 250);
+                columns[1].Data<double>()[i] = 0.25 * static_cast<double>((i / 100) % 7);
+                if (i >= 300 && i < 420) {
+                    columns[1].SetNull(i);
+                }
+            }
+            writer.Append(columns);
+            writer.Finish();
+        }
+
+        /** @brief Aggregate every row group of `column` once by runs and once by rows */
+        void ExpectRunsMatchRows(AggregateSpec spec, LogicalType type) {
+            ColumnFileReader reader(path);
+            const AggregateFunction function(spec, type);
+            AggregateState by_runs;
+            AggregateState by_rows;
+            uint32_t runs_total = 0;
+            for (idx_t g = 0; g < reader.RowGroupCount(); g++) {
+                const uint32_t rows = reader.Metadata().row_groups[g].row_count;
+                RunChunk runs(type, rows, arena);
+                reader.ReadRuns(g, spec.column_idx, runs);
+                function.UpdateRuns(by_runs, runs.values, runs.lengths, runs.Size());
+                runs_total += runs.Size();
+
+                std::vector<Vector> out;
+                out.emplace_back(type, rows, arena);
+                reader.ReadColumns(g, {spec.column_idx}, out);
+                function.Update(by_rows, out[0], 0, rows);
+            }
+            EXPECT_LT(runs_total, 100u);
+            EXPECT_EQ(by_runs.count, by_rows.count);
+            EXPECT_EQ(by_runs.int_value, by_rows.int_value);
+            EXPECT_DOUBLE_EQ(by_runs.double_value, by_rows.double_value);
+        }
+
+        Arena arena;
+        std::string path;
+};
+
+TEST_F(AggregateFunctionTest, FoldsRunsLikeTheirRows) {
+    WriteDays(5000, 2048);
+    for (auto type : {AggregateType::COUNT_STAR, AggregateType::COUNT, AggregateType::SUM,
+                      AggregateType::MIN, AggregateType::MAX, AggregateType::AVG}) {
+        ExpectRunsMatchRows({type, 0}, LogicalType::INT32);
+        ExpectRunsMatchRows({type, 1}, LogicalType::DOUBLE);
+    }
+}
+
+TEST_F(AggregateFunctionTest, SkipsNullRuns) {
+    Vector values(LogicalType::INT64, 3, arena);
+    values.SetSize(3);
+    values.Data<int64_t>()[0] = 7;
+    values.Data<int64_t>()[2] = -2;
+    values.SetNull(1);
+    const uint32_t lengths[] = {1000, 50, 10};
+
+    AggregateState count;
+    AggregateFunction({AggregateType::COUNT, 0}, LogicalType::INT64)
+            .UpdateRuns(count, values, lengths, 3);
+    EXPECT_EQ(count.count, 1010);
+
+    AggregateState sum;
+    AggregateFunction({AggregateType::SUM, 0}, LogicalType::INT64)
+            .UpdateRuns(sum, values, lengths, 3);
+    EXPECT_EQ(sum.int_value, 7000 - 20);
+
+    AggregateState min;
+    AggregateFunction({AggregateType::MIN, 0}, LogicalType::INT64)
+            .UpdateRuns(min, values, lengths, 3);
+    EXPECT_EQ(min.int_value, -2);
+
+    AggregateState rows;
+    AggregateFunction({AggregateType::COUNT_STAR, 0}, LogicalType::INT64)
+            .UpdateRuns(rows, values, lengths, 3);
+    EXPECT_EQ(rows.count, 1060);
+}
+} // namespace electricdb
\ No newline at end of file
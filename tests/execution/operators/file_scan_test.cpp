@@ -0,0 +1,625 @@
+#include <gtest/gtest.h>
+#include "electricdb/execution/engine/pipeline_builder.h"
+#include "electricdb/execution/expressions/binary_expression.h"
+#include "electricdb/execution/expressions/leaf_expression.h"
+#include "electricdb/execution/operators/aggregate/hash_aggregate.h"
+#include "electricdb/execution/operators/filter/filter.h"
+#include "electricdb/execution/operators/out/out.h"
+#include "electricdb/execution/operators/projection/projection.h"
+#include "electricdb/execution/operators/scan/file_scan.h"
+#include "electricdb/execution/operators/sort/physical_top_n.h"
+#include "temp_path.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace electricdb {
+class FileScanTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            path = TempPath(".edb");
+            WriteTable(EncodingType::PLAIN);
+        }
+
+        /** @brief Write the table, with price and qty stored in `encoding` */
+        void WriteTable(EncodingType encoding) {
+            /** Row groups of 1000 rows, not a multiple of the batch size */
+            ColumnFileWriter writer(path,
+                                    {{"id", LogicalType::INT64},
+                                     {"price", LogicalType::DOUBLE},
+                                     {"qty", LogicalType::INT32}},
+                                    1000);
+            writer.SetEncoding(1, encoding);
+            writer.SetEncoding(2, encoding);
+            std::vector<Vector> columns;
+            columns.emplace_back(LogicalType::INT64, ROWS, arena);
+            columns.emplace_back(LogicalType::DOUBLE, ROWS, arena);
+            columns.emplace_back(LogicalType::INT32, ROWS, arena);
+            for (auto &column : columns) {
+                column.SetSize(ROWS);
+            }
+            for (uint32_t i = 0; i < ROWS; i++) {
+                columns[0].Data<int64_t>()[i] = i;
+                columns[1].Data<double>()[i] = i * 0.25;
+                columns[2].Data<int32_t>()[i] = static_cast<int32_t>(i % 10);
+                if (i % 5 == 0) {
+                    columns[1].SetNull(i);
+                }
+            }
+            writer.Append(columns);
+            writer.Finish();
+        }
+
+        void TearDown() override { File::Remove(path); }
+
+        /** @brief Scan columns (qty, price) and check every row, in order */
+        void ScanAndCheck(FileScanMode mode, AsyncReader *io = nullptr,
+                          BufferManager *buffers = nullptr) {
+            ColumnFileReader reader(path);
+            PhysicalFileScan scan(reader, {2, 1}, mode);
+            EXPECT_EQ(scan.Mode(), mode);
+            if (io) {
+                scan.EnablePrefetch(*io, 2);
+            }
+            if (buffers) {
+                scan.EnableBufferManager(*buffers);
+            }
+            PhysicalResultCollector result(scan.Types());
+            result.AddChild(&scan);
+
+            PipelineBuilder builder(result);
+            Scheduler scheduler(2);
+            builder.Execute(scheduler);
+            ASSERT_EQ(result.Count(), ROWS);
+
+            uint32_t row = 0;
+            for (size_t i = 0; i < result.ChunkCount(); i++) {
+                const auto &chunk = result.Chunk(i);
+                for (uint32_t r = 0; r < chunk[0].Size(); r++, row++) {
+                    EXPECT_EQ(chunk[0].Data<int32_t>()[r], static_cast<int32_t>(row % 10));
+                    ASSERT_EQ(chunk[1].IsNull(r), row % 5 == 0);
+                    if (row % 5 != 0) {
+                        EXPECT_EQ(chunk[1].Data<double>()[r], row * 0.25);
+                    }
+                }
+            }
+            EXPECT_EQ(row, ROWS);
+        }
+
+        /** @brief Predicates on positions of the scanned columns */
+        using Filters = std::vector<std::pair<idx_t, ColumnPredicate>>;
+
+        /** @brief Ids produced by a scan of (id, qty) with `filters` on its columns, sorted */
+        std::vector<int64_t> FilteredIds(FileScanMode mode, const Filters &filters,
+                                         BufferManager *buffers = nullptr) {
+            ColumnFileReader reader(path);
+            PhysicalFileScan scan(reader, {0, 2}, mode);
+            for (const auto &[column, predicate] : filters) {
+                scan.AddFilter(column, predicate);
+            }
+            if (buffers) {
+                scan.EnableBufferManager(*buffers);
+            }
+            PhysicalResultCollector result(scan.Types());
+            result.AddChild(&scan);
+
+            PipelineBuilder builder(result);
+            Scheduler scheduler(2);
+            builder.Execute(scheduler);
+
+            std::vector<int64_t> ids;
+            for (size_t i = 0; i < result.ChunkCount(); i++) {
+                const auto &chunk = result.Chunk(i);
+                for (uint32_t r = 0; r < chunk[0].Size(); r++) {
+                    ids.push_back(chunk[0].Data<int64_t>()[r]);
+                    EXPECT_EQ(chunk[1].Data<int32_t>()[r], chunk[0].Data<int64_t>()[r] % 10);
+                }
+            }
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        }
+
+        /** @brief Flags in runs of 50 rows, values in runs of 30 with every ninth run NULL */
+        static bool RunFlag(uint32_t row) { return row / 50 % 2 == 0; }
+        static bool RunIsNull(uint32_t row) { return row / 30 % 9 == 0; }
+        static int64_t RunValue(uint32_t row) { return static_cast<int64_t>(row / 30 % 13) - 4; }
+
+        /** @brief Write (flag, value) as RLE chunks, in row groups of 1000 rows */
+        void WriteRunTable() {
+            File::Remove(path);
+            ColumnFileWriter writer(path,
+                                    {{"flag", LogicalType::BOOL}, {"value", LogicalType::INT64}},
+                                    1000);
+            writer.SetEncoding(0, EncodingType::RLE);
+            writer.SetEncoding(1, EncodingType::RLE);
+            std::vector<Vector> columns;
+            columns.emplace_back(LogicalType::BOOL, ROWS, arena);
+            columns.emplace_back(LogicalType::INT64, ROWS, arena);
+            for (auto &column : columns) {
+                column.SetSize(ROWS);
+            }
+            for (uint32_t i = 0; i < ROWS; i++) {
+                columns[0].Data<bool>()[i] = RunFlag(i);
+                columns[1].Data<int64_t>()[i] = RunValue(i);
+                if (RunIsNull(i)) {
+                    columns[1].SetNull(i);
+                }
+            }
+            writer.Append(columns);
+            writer.Finish();
+        }
+
+        template <typename T>
+        static Value MakeValue(T v) {
+            Value value;
+            value.SetType(LogicalTypeTrait<T>::type);
+            value.Set<T>(v);
+            return value;
+        }
+
+        static constexpr uint32_t ROWS = 3500;
+        Arena arena;
+        std::string path;
+};
+
+TEST_F(FileScanTest, ReadModeProducesEveryRow) {
+    ScanAndCheck(FileScanMode::READ);
+}
+
+TEST_F(FileScanTest, MmapModeProducesEveryRow) {
+    ScanAndCheck(FileScanMode::MMAP);
+}
+
+TEST_F(FileScanTest, MorselsFollowRowGroups) {
+    ColumnFileReader reader(path);
+    PhysicalFileScan scan(reader, {0}, FileScanMode::MMAP);
+    EXPECT_EQ(scan.SourceMorselSize(), 1000u);
+    PhysicalResultCollector result(scan.Types());
+    result.AddChild(&scan);
+
+    PipelineBuilder builder(result);
+    Scheduler scheduler(2);
+    builder.Execute(scheduler);
+
+    /** Every batch is one row group, none is copied together from two */
+    ASSERT_EQ(result.ChunkCount(), 4u);
+    for (size_t i = 0; i < result.ChunkCount(); i++) {
+        const auto &chunk = result.Chunk(i);
+        EXPECT_EQ(chunk[0].Size(), i < 3 ? 1000u : 500u);
+        EXPECT_EQ(chunk[0].Data<int64_t>()[0], static_cast<int64_t>(i * 1000));
+    }
+}
+
+TEST_F(FileScanTest, MmapBatchesSpanningRowGroupsAreCopied) {
+    ColumnFileReader reader(path);
+    PhysicalFileScan scan(reader, {2, 1}, FileScanMode::MMAP);
+    auto state = scan.InitLocalSource();
+    std::vector<Vector> out = PhysicalOperator::MakeChunk(scan.Types(), 200, arena);
+    ExecutionContext ctx;
+    scan.GetData(ctx, *state, 900, 200, out);
+    ASSERT_EQ(out[0].Size(), 200u);
+    for (uint32_t r = 0; r < 200; r++) {
+        const uint32_t row = 900 + r;
+        EXPECT_EQ(out[0].Data<int32_t>()[r], static_cast<int32_t>(row % 10));
+        ASSERT_EQ(out[1].IsNull(r), row % 5 == 0);
+        if (row % 5 != 0) {
+            EXPECT_EQ(out[1].Data<double>()[r], row * 0.25);
+        }
+    }
+}
+
+TEST_F(FileScanTest, PrefetchingReadModeProducesEveryRow) {
+    AsyncReader io;
+    ScanAndCheck(FileScanMode::READ, &io);
+    AsyncReader pool(4, false);
+    ScanAndCheck(FileScanMode::READ, &pool);
+}
+
+TEST_F(FileScanTest, DirectModeProducesEveryRow) {
+    ScanAndCheck(FileScanMode::DIRECT);
+    AsyncReader io;
+    ScanAndCheck(FileScanMode::DIRECT, &io);
+    AsyncReader pool(4, false);
+    ScanAndCheck(FileScanMode::DIRECT, &pool);
+}
+
+TEST_F(FileScanTest, BufferManagerServesRepeatedScans) {
+    BufferManager buffers(uint64_t{4} << 20);
+    ScanAndCheck(FileScanMode::READ, nullptr, &buffers);
+    const BufferStats first = buffers.Stats();
+    /** Two columns of four row groups, each loaded once */
+    EXPECT_EQ(first.misses, 8u);
+
+    ScanAndCheck(FileScanMode::DIRECT, nullptr, &buffers);
+    EXPECT_EQ(buffers.Stats().misses, first.misses);
+    EXPECT_GE(buffers.Stats().hits, 8u);
+
+    ColumnFileReader reader(path);
+    PhysicalFileScan scan(reader, {0}, FileScanMode::MMAP);
+    EXPECT_THROW(scan.EnableBufferManager(buffers), std::runtime_error);
+}
+
+TEST_F(FileScanTest, BufferManagerMustHoldARowGroupPerWorker) {
+    /** A row group of (qty, price) takes one frame per column */
+    BufferManager buffers(4 * DEFAULT_FRAME_SIZE);
+    ColumnFileReader reader(path);
+    PhysicalFileScan fits(reader, {2, 1}, FileScanMode::READ);
+    fits.EnableBufferManager(buffers, 2);
+    PhysicalFileScan too_many(reader, {2, 1}, FileScanMode::READ);
+    EXPECT_THROW(too_many.EnableBufferManager(buffers, 3), std::runtime_error);
+
+    /** Two workers never wait for each other within the budget */
+    PhysicalResultCollector result(fits.Types());
+    result.AddChild(&fits);
+    PipelineBuilder builder(result);
+    Scheduler scheduler(2);
+    builder.Execute(scheduler);
+    EXPECT_EQ(result.Count(), ROWS);
+    EXPECT_LE(buffers.MemoryUsed(), buffers.MemoryLimit());
+}
+
+TEST_F(FileScanTest, AutoModeReadsLargeScansDirectly) {
+    ColumnFileReader reader(path);
+    PhysicalFileScan small(reader, {2, 1}, FileScanMode::AUTO);
+    EXPECT_EQ(small.Mode(), FileScanMode::MMAP);
+
+    PhysicalFileScan large(reader, {2, 1}, FileScanMode::AUTO, small.ScanBytes());
+    EXPECT_EQ(large.Mode(), FileScanMode::DIRECT);
+
+    uint64_t bytes = 0;
+    for (const auto &group : reader.Metadata().row_groups) {
+        bytes += group.columns[2].size + group.columns[1].size;
+    }
+    EXPECT_EQ(large.ScanBytes(), bytes);
+}
+
+TEST_F(FileScanTest, ReadModeFetchesOnlyScannedColumns) {
+    ColumnFileReader reader(path);
+    const uint64_t opened = reader.BytesRead();
+    PhysicalFileScan scan(reader, {2});
+    PhysicalResultCollector result(scan.Types());
+    result.AddChild(&scan);
+
+    PipelineBuilder builder(result);
+    Scheduler scheduler(1);
+    builder.Execute(scheduler);
+    EXPECT_EQ(result.Count(), ROWS);
+    EXPECT_EQ(reader.BytesRead() - opened, ROWS * sizeof(int32_t));
+}
+
+TEST_F(FileScanTest, EncodedChunksProduceEveryRow) {
+    WriteTable(EncodingType::DICTIONARY);
+    ScanAndCheck(FileScanMode::READ);
+    ScanAndCheck(FileScanMode::MMAP);
+    BufferManager buffers(uint64_t{4} << 20);
+    ScanAndCheck(FileScanMode::DIRECT, nullptr, &buffers);
+}
+
+TEST_F(FileScanTest, FiltersProduceOnlyQualifyingRows) {
+    WriteTable(EncodingType::DICTIONARY);
+    const Filters filters = {
+            {1, ColumnPredicate::In({MakeValue<int32_t>(3), MakeValue<int32_t>(7)})},
+            {0, ColumnPredicate::Range(MakeValue<int64_t>(900), MakeValue<int64_t>(2504))},
+    };
+    std::vector<int64_t> expected;
+    for (int64_t id = 900; id <= 2504; id++) {
+        if (id % 10 == 3 || id % 10 == 7) {
+            expected.push_back(id);
+        }
+    }
+
+    EXPECT_EQ(FilteredIds(FileScanMode::READ, filters), expected);
+    EXPECT_EQ(FilteredIds(FileScanMode::MMAP, filters), expected);
+    EXPECT_EQ(FilteredIds(FileScanMode::DIRECT, filters), expected);
+    BufferManager buffers(uint64_t{4} << 20);
+    EXPECT_EQ(FilteredIds(FileScanMode::READ, filters, &buffers), expected);
+}
+
+TEST_F(FileScanTest, FiltersSkipRowGroupsWithoutMatches) {
+    ColumnFileReader reader(path);
+    const uint64_t opened = reader.BytesRead();
+    PhysicalFileScan scan(reader, {0, 2});
+    scan.AddFilter(0, ColumnPredicate::Range(MakeValue<int64_t>(1200), MakeValue<int64_t>(1300)));
+    PhysicalResultCollector result(scan.Types());
+    result.AddChild(&scan);
+
+    PipelineBuilder builder(result);
+    Scheduler scheduler(1);
+    builder.Execute(scheduler);
+    EXPECT_EQ(result.Count(), 101u);
+    /** The zone maps rule out three row groups; of the fourth, ids to filter, then both columns */
+    EXPECT_EQ(reader.BytesRead() - opened, 1000 * (2 * sizeof(int64_t) + sizeof(int32_t)));
+
+    EXPECT_THROW(scan.AddFilter(1, ColumnPredicate::Equal(MakeValue<int64_t>(1))),
+                 std::runtime_error);
+    AsyncReader io;
+    EXPECT_THROW(scan.EnablePrefetch(io), std::runtime_error);
+}
+
+TEST_F(FileScanTest, TopNSkipsRowGroupsItCannotUse) {
+    ColumnFileReader reader(path);
+    const uint64_t opened = reader.BytesRead();
+    PhysicalFileScan scan(reader, {0, 2});
+    PhysicalTopN top_n(scan.Types(), {{0}}, 10);
+    top_n.AddChild(&scan);
+    scan.SetTopN(0, top_n);
+    PhysicalResultCollector result(top_n.Types());
+    result.AddChild(&top_n);
+
+    PipelineBuilder builder(result);
+    Scheduler scheduler(1);
+    builder.Execute(scheduler);
+    ASSERT_EQ(result.Count(), 10u);
+    int64_t id = 0;
+    for (size_t c = 0; c < result.ChunkCount(); c++) {
+        const auto &chunk = result.Chunk(c);
+        for (idx_t i = 0; i < chunk[0].Size(); i++) {
+            EXPECT_EQ(chunk[0].Data<int64_t>()[i], id);
+            EXPECT_EQ(chunk[1].Data<int32_t>()[i], id % 10);
+            id++;
+        }
+    }
+    /** The first row group fills the heap, the ids of every later one sort after its boundary */
+    EXPECT_EQ(reader.BytesRead() - opened, 1000 * (sizeof(int64_t) + sizeof(int32_t)));
+
+    EXPECT_THROW(scan.SetTopN(1, top_n), std::runtime_error);
+    AsyncReader io;
+    EXPECT_THROW(scan.EnablePrefetch(io), std::runtime_error);
+}
+
+TEST_F(FileScanTest, DictionaryVectorsReferToChunkCodes) {
+    WriteTable(EncodingType::DICTIONARY);
+    ColumnFileReader reader(path);
+    PhysicalFileScan scan(reader, {2, 1});
+    scan.EnableDictionaryVectors();
+    ExecutionContext ctx;
+    auto state = scan.InitLocalSource();
+    std::vector<Vector> out = PhysicalOperator::MakeChunk(scan.Types(), 1024, arena);
+
+    /** Rows 100 to 599 lie in the first row group */
+    scan.GetData(ctx, *state, 100, 500, out);
+    ASSERT_TRUE(out[0].IsDictionary());
+    ASSERT_TRUE(out[1].IsDictionary());
+    EXPECT_EQ(out[0].Size(), 500u);
+    EXPECT_EQ(out[0].Dictionary().Size(), 10u);
+    for (uint32_t r = 0; r < 500; r++) {
+        const uint32_t row = 100 + r;
+        EXPECT_EQ(out[0].Dictionary().Data<int32_t>()[out[0].Codes()[r]],
+                  static_cast<int32_t>(row % 10));
+        ASSERT_EQ(out[1].IsNull(r), row % 5 == 0);
+    }
+    out[1].Flatten();
+    for (uint32_t r = 0; r < 500; r++) {
+        if ((100 + r) % 5 != 0) {
+            EXPECT_EQ(out[1].Data<double>()[r], (100 + r) * 0.25);
+        }
+    }
+
+    /** Rows 900 to 1923 span two row groups and are expanded */
+    scan.GetData(ctx, *state, 900, 1024, out);
+    ASSERT_FALSE(out[0].IsDictionary());
+    ASSERT_FALSE(out[1].IsDictionary());
+    for (uint32_t r = 0; r < 1024; r++) {
+        EXPECT_EQ(out[0].Data<int32_t>()[r], static_cast<int32_t>((900 + r) % 10));
+        ASSERT_EQ(out[1].IsNull(r), (900 + r) % 5 == 0);
+    }
+
+    AsyncReader io;
+    EXPECT_THROW(scan.EnablePrefetch(io), std::runtime_error);
+    PhysicalFileScan mapped(reader, {2}, FileScanMode::MMAP);
+    EXPECT_THROW(mapped.EnableDictionaryVectors(), std::runtime_error);
+}
+
+TEST_F(FileScanTest, DictionaryVectorsFlowThroughFilterProjectionAndAggregate) {
+    File::Remove(path);
+    {
+        ColumnFileWriter writer(path,
+                                {{"key", LogicalType::INT32},
+                                 {"flag", LogicalType::BOOL},
+                                 {"value", LogicalType::INT64}},
+                                1000);
+        writer.SetEncoding(0, EncodingType::DICTIONARY);
+        writer.SetEncoding(1, EncodingType::DICTIONARY);
+        std::vector<Vector> columns;
+        columns.emplace_back(LogicalType::INT32, ROWS, arena);
+        columns.emplace_back(LogicalType::BOOL, ROWS, arena);
+        columns.emplace_back(LogicalType::INT64, ROWS, arena);
+        for (auto &column : columns) {
+            column.SetSize(ROWS);
+        }
+        for (uint32_t i = 0; i < ROWS; i++) {
+            columns[0].Data<int32_t>()[i] = static_cast<int32_t>(i % 7);
+            columns[1].Data<bool>()[i] = i % 3 != 0;
+            columns[2].Data<int64_t>()[i] = i;
+            if (i % 11 == 0) {
+                columns[0].SetNull(i);
+            }
+        }
+        writer.Append(columns);
+        writer.Finish();
+    }
+
+    /** Key -1 stands for NULL */
+    std::map<int32_t, std::pair<int64_t, int64_t>> expected;
+    for (uint32_t i = 0; i < ROWS; i++) {
+        if (i % 3 != 0) {
+            const int32_t key = i % 11 == 0 ? -1 : static_cast<int32_t>(i % 7);
+            expected[key].first += 2 * static_cast<int64_t>(i);
+            expected[key].second++;
+        }
+    }
+
+    ColumnFileReader reader(path);
+    PhysicalFileScan scan(reader, {0, 1, 2});
+    scan.EnableDictionaryVectors();
+    ColumnExpr flag(1, LogicalType::BOOL);
+    PhysicalFilter filter(scan.Types(), &flag);
+    filter.AddChild(&scan);
+    ColumnExpr key(0, LogicalType::INT32);
+    ColumnExpr value(2, LogicalType::INT64);
+    AddExpr doubled(&value, &value);
+    PhysicalProjection projection({&key, &doubled});
+    projection.AddChild(&filter);
+    PhysicalHashAggregate aggregate(projection.Types(), {0},
+                                    {{AggregateType::SUM, 1}, {AggregateType::COUNT_STAR}});
+    aggregate.AddChild(&projection);
+    PhysicalResultCollector result(aggregate.Types());
+    result.AddChild(&aggregate);
+
+    /** The filter and the projection keep the dictionaries */
+    ExecutionContext ctx;
+    auto source = scan.InitLocalSource();
+    std::vector<Vector> chunk = PhysicalOperator::MakeChunk(scan.Types(), 1000, arena);
+    scan.GetData(ctx, *source, 0, 1000, chunk);
+    auto filter_state = filter.InitOperatorState();
+    std::vector<Vector> filtered = PhysicalOperator::MakeChunk(filter.Types(), 1000, arena);
+    filter.Execute(ctx, chunk, filtered, *filter_state);
+    EXPECT_EQ(filtered[0].Size(), 666u);
+    EXPECT_TRUE(filtered[0].IsDictionary());
+    EXPECT_TRUE(filtered[1].IsDictionary());
+    EXPECT_FALSE(filtered[2].IsDictionary());
+    auto projection_state = projection.InitOperatorState();
+    std::vector<Vector> projected = PhysicalOperator::MakeChunk(projection.Types(), 1000, arena);
+    projection.Execute(ctx, filtered, projected, *projection_state);
+    EXPECT_TRUE(projected[0].IsDictionary());
+    EXPECT_EQ(projected[0].Dictionary().Data<int32_t>(), filtered[0].Dictionary().Data<int32_t>());
+    EXPECT_FALSE(projected[1].IsDictionary());
+
+    PipelineBuilder builder(result);
+    Scheduler scheduler(2);
+    builder.Execute(scheduler);
+    ASSERT_EQ(result.Count(), expected.size());
+    std::map<int32_t, std::pair<int64_t, int64_t>> actual;
+    for (size_t i = 0; i < result.ChunkCount(); i++) {
+        const auto &out = result.Chunk(i);
+        for (uint32_t r = 0; r < out[0].Size(); r++) {
+            const int32_t group = out[0].IsNull(r) ? -1 : out[0].Data<int32_t>()[r];
+            actual[group] = {out[1].Data<int64_t>()[r], out[2].Data<int64_t>()[r]};
+        }
+    }
+    EXPECT_EQ(actual, expected);
+}
+TEST_F(FileScanTest, RunVectorsCarryTheRunsOfTheBatch) {
+    WriteRunTable();
+    ColumnFileReader reader(path);
+    PhysicalFileScan scan(reader, {1});
+    scan.EnableRunVectors();
+    ExecutionContext ctx;
+    auto state = scan.InitLocalSource();
+    std::vector<Vector> out = PhysicalOperator::MakeChunk(scan.Types(), 1024, arena);
+
+    /** Rows 100 to 599 lie in the first row group, in runs 3 (trimmed) to 19 */
+    scan.GetData(ctx, *state, 100, 500, out);
+    ASSERT_TRUE(out[0].IsRuns());
+    EXPECT_EQ(out[0].Size(), 500u);
+    ASSERT_EQ(out[0].RunValues().Size(), 17u);
+    EXPECT_EQ(out[0].RunLengths()[0], 20u);
+    EXPECT_EQ(out[0].RunLengths()[16], 30u);
+    out[0].Flatten();
+    for (uint32_t r = 0; r < 500; r++) {
+        const uint32_t row = 100 + r;
+        ASSERT_EQ(out[0].IsNull(r), RunIsNull(row));
+        if (!RunIsNull(row)) {
+            EXPECT_EQ(out[0].Data<int64_t>()[r], RunValue(row));
+        }
+    }
+
+    /** Rows 900 to 1923 span two row groups and are expanded */
+    scan.GetData(ctx, *state, 900, 1024, out);
+    ASSERT_FALSE(out[0].IsRuns());
+    for (uint32_t r = 0; r < 1024; r++) {
+        ASSERT_EQ(out[0].IsNull(r), RunIsNull(900 + r));
+    }
+
+    AsyncReader io;
+    EXPECT_THROW(scan.EnablePrefetch(io), std::runtime_error);
+    PhysicalFileScan mapped(reader, {1}, FileScanMode::MMAP);
+    EXPECT_THROW(mapped.EnableRunVectors(), std::runtime_error);
+}
+
+TEST_F(FileScanTest, RunVectorsFlowThroughFilterAndAggregate) {
+    WriteRunTable();
+    int64_t sum = 0;
+    int64_t count = 0;
+    int64_t min = 0;
+    int64_t max = 0;
+    int64_t flagged = 0;
+    for (uint32_t i = 0; i < ROWS; i++) {
+        if (!RunFlag(i)) {
+            continue;
+        }
+        flagged++;
+        if (!RunIsNull(i)) {
+            min = count == 0 ? RunValue(i) : std::min(min, RunValue(i));
+            max = count == 0 ? RunValue(i) : std::max(max, RunValue(i));
+            sum += RunValue(i);
+            count++;
+        }
+    }
+
+    ColumnFileReader reader(path);
+    PhysicalFileScan scan(reader, {0, 1});
+    scan.EnableRunVectors();
+    ColumnExpr flag(0, LogicalType::BOOL);
+    PhysicalFilter filter(scan.Types(), &flag);
+    filter.AddChild(&scan);
+    PhysicalHashAggregate aggregate(filter.Types(), {},
+                                    {{AggregateType::COUNT_STAR},
+                                     {AggregateType::SUM, 1},
+                                     {AggregateType::COUNT, 1},
+                                     {AggregateType::MIN, 1},
+                                     {AggregateType::MAX, 1}});
+    aggregate.AddChild(&filter);
+    PhysicalResultCollector result(aggregate.Types());
+    result.AddChild(&aggregate);
+
+    /** The filter keeps the runs of its predicate column and passes whole runs on */
+    ExecutionContext ctx;
+    auto source = scan.InitLocalSource();
+    std::vector<Vector> chunk = PhysicalOperator::MakeChunk(scan.Types(), 1000, arena);
+    scan.GetData(ctx, *source, 0, 1000, chunk);
+    ASSERT_TRUE(chunk[0].IsRuns());
+    ASSERT_TRUE(chunk[1].IsRuns());
+    chunk[1].Flatten();
+    auto filter_state = filter.InitOperatorState();
+    std::vector<Vector> filtered = PhysicalOperator::MakeChunk(filter.Types(), 1000, arena);
+    filter.Execute(ctx, chunk, filtered, *filter_state);
+    EXPECT_EQ(filtered[0].Size(), 500u);
+    ASSERT_TRUE(filtered[0].IsRuns());
+    EXPECT_EQ(filtered[0].RunValues().Size(), 10u);
+    EXPECT_FALSE(filtered[1].IsRuns());
+
+    PipelineBuilder builder(result);
+    Scheduler scheduler(2);
+    builder.Execute(scheduler);
+    ASSERT_EQ(result.Count(), 1u);
+    const auto &out = result.Chunk(0);
+    EXPECT_EQ(out[0].Data<int64_t>()[0], flagged);
+    EXPECT_EQ(out[1].Data<int64_t>()[0], sum);
+    EXPECT_EQ(out[2].Data<int64_t>()[0], count);
+    EXPECT_EQ(out[3].Data<int64_t>()[0], min);
+    EXPECT_EQ(out[4].Data<int64_t>()[0], max);
+
+    /** Ungrouped, the aggregate folds the runs of the scan as they are */
+    PhysicalFileScan values(reader, {1});
+    values.EnableRunVectors();
+    PhysicalHashAggregate total(values.Types(), {},
+                                {{AggregateType::SUM, 0}, {AggregateType::COUNT_STAR}});
+    total.AddChild(&values);
+    PhysicalResultCollector totals(total.Types());
+    totals.AddChild(&total);
+    PipelineBuilder total_builder(totals);
+    total_builder.Execute(scheduler);
+    int64_t expected = 0;
+    for (uint32_t i = 0; i < ROWS; i++) {
+        expected += RunIsNull(i) ? 0 : RunValue(i);
+    }
+    ASSERT_EQ(totals.Count(), 1u);
+    EXPECT_EQ(totals.Chunk(0)[0].Data<int64_t>()[0], expected);
+    EXPECT_EQ(totals.Chunk(0)[1].Data<int64_t>()[0], ROWS);
+}
+} // namespace electricdb
\ No newline at end of file
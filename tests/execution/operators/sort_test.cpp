@@ -0,0 +1,406 @@
+#include <gtest/gtest.h>
+#include "electricdb/execution/operators/sort/sort.h"
+#include "electricdb/util/arena.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <thread>
+#include <tuple>
+
+namespace electricdb {
+class SortTest : public testing::Test {
+    protected:
+        Arena arena;
+
+        std::vector<Vector> MakeChunk(const std::vector<LogicalType> &types, uint32_t capacity) {
+            std::vector<Vector> chunk;
+            for (auto type : types) {
+                chunk.emplace_back(type, capacity, arena);
+            }
+            return chunk;
+        }
+
+        /** @brief Sink `rows` random (v, v * 0.5) rows into `local` and record v in `expected` */
+        static void SinkRandom(SortOperator &sort, SortLocalState &local, uint32_t rows,
+                               std::mt19937_64 &rng, std::vector<int64_t> &expected) {
+            Arena chunk_arena;
+            std::vector<Vector> chunk;
+            chunk.emplace_back(LogicalType::INT64, rows, chunk_arena);
+            chunk.emplace_back(LogicalType::DOUBLE, rows, chunk_arena);
+            chunk[0].SetSize(rows);
+            chunk[1].SetSize(rows);
+            for (uint32_t i = 0; i < rows; i++) {
+                const int64_t v = static_cast<int64_t>(rng() % 1000000) - 500000;
+                chunk[0].Data<int64_t>()[i] = v;
+                chunk[1].Data<double>()[i] = static_cast<double>(v) * 0.5;
+                expected.push_back(v);
+            }
+            sort.Sink(local, chunk);
+        }
+
+        /** @brief Scan `sort` to the end and compare column 0 with the sorted `expected` */
+        void ExpectSorted(const SortOperator &sort, std::vector<int64_t> expected,
+                          idx_t max_count = std::numeric_limits<idx_t>::max()) {
+            std::sort(expected.begin(), expected.end());
+            auto out = MakeChunk({LogicalType::INT64, LogicalType::DOUBLE}, 1000);
+            SortScanState state;
+            size_t row = 0;
+            idx_t n;
+            while ((n = sort.Scan(state, out, max_count)) > 0) {
+                ASSERT_LE(n, max_count);
+                ASSERT_EQ(out[0].Size(), n);
+                for (idx_t i = 0; i < n; i++, row++) {
+                    ASSERT_EQ(out[0].Data<int64_t>()[i], expected[row]);
+                    ASSERT_EQ(out[1].Data<double>()[i], static_cast<double>(expected[row]) * 0.5);
+                }
+            }
+            EXPECT_EQ(row, expected.size());
+        }
+};
+
+TEST_F(SortTest, NormalizedKeyOrdersSignedAndFloatingValues) {
+    std::vector<LogicalType> types = {LogicalType::INT32, LogicalType::DOUBLE};
+    SortKeyEncoder int_encoder({{0}}, types);
+    SortKeyEncoder double_encoder({{1}}, types);
+
+    auto chunk = MakeChunk(types, 4);
+    chunk[0].SetSize(4);
+    chunk[1].SetSize(4);
+    int32_t ints[] = {-5, 3, std::numeric_limits<int32_t>::min(), 0};
+    double doubles[] = {-0.5, -0.0, 2.25, -std::numeric_limits<double>::infinity()};
+    for (int i = 0; i < 4; i++) {
+        chunk[0].Data<int32_t>()[i] = ints[i];
+        chunk[1].Data<double>()[i] = doubles[i];
+    }
+
+    std::vector<uint8_t> int_keys(4 * int_encoder.EntryWidth());
+    std::vector<uint8_t> double_keys(4 * double_encoder.EntryWidth());
+    int_encoder.Encode(chunk, 4, int_keys.data(), 0);
+    double_encoder.Encode(chunk, 4, double_keys.data(), 0);
+
+    auto int_key = [&](int i) { return int_keys.data() + i * int_encoder.EntryWidth(); };
+    auto double_key = [&](int i) { return double_keys.data() + i * double_encoder.EntryWidth(); };
+
+    EXPECT_LT(int_encoder.Compare(int_key(2), int_key(0)), 0);
+    EXPECT_LT(int_encoder.Compare(int_key(0), int_key(3)), 0);
+    EXPECT_LT(int_encoder.Compare(int_key(3), int_key(1)), 0);
+
+    EXPECT_LT(double_encoder.Compare(double_key(3), double_key(0)), 0);
+    EXPECT_LT(double_encoder.Compare(double_key(0), double_key(1)), 0);
+    EXPECT_LT(double_encoder.Compare(double_key(1), double_key(2)), 0);
+
+    EXPECT_EQ(int_encoder.GetRef(int_key(2)), 2u);
+}
+
+TEST_F(SortTest, RadixSortMatchesMemcmpOrder) {
+    std::mt19937_64 rng(42);
+    const uint32_t entry_width = 12;
+    const uint32_t key_width = 4;
+    const uint64_t count = 5000;
+
+    std::vector<uint8_t> data(count * entry_width);
+    for (auto &b : data) {
+        b = static_cast<uint8_t>(rng() % 4);
+    }
+    std::vector<uint8_t> tmp(data.size());
+
+    RadixSort(data.data(), tmp.data(), count, entry_width, key_width);
+
+    for (uint64_t i = 1; i < count; i++) {
+        EXPECT_LE(std::memcmp(data.data() + (i - 1) * entry_width, data.data() + i * entry_width,
+                              key_width),
+                  0);
+    }
+}
+
+TEST_F(SortTest, RadixSortStopsOnCancel) {
+    const uint32_t entry_width = 8;
+    const uint64_t count = 1000;
+    std::vector<uint8_t> data(count * entry_width);
+    std::vector<uint8_t> tmp(data.size());
+    for (uint64_t i = 0; i < count; i++) {
+        data[i * entry_width] = static_cast<uint8_t>(i);
+    }
+
+    CancellationToken token;
+    token.Cancel();
+    EXPECT_THROW(RadixSort(data.data(), tmp.data(), count, entry_width, 4, &token), QueryCancelled);
+}
+
+TEST_F(SortTest, MultiColumnWithNullsAndDescending) {
+    std::vector<LogicalType> types = {LogicalType::INT32, LogicalType::INT64};
+    SortOperator sort(types, {{0, OrderType::ASCENDING, NullOrder::NULLS_FIRST},
+                              {1, OrderType::DESCENDING, NullOrder::NULLS_LAST}});
+
+    auto chunk = MakeChunk(types, 6);
+    for (auto &vec : chunk) {
+        vec.SetSize(6);
+    }
+    int32_t a[] = {2, 1, 2, 0, 1, 2};
+    int64_t b[] = {10, 5, 30, 0, 7, 0};
+    for (int i = 0; i < 6; i++) {
+        chunk[0].Data<int32_t>()[i] = a[i];
+        chunk[1].Data<int64_t>()[i] = b[i];
+    }
+    chunk[0].SetNull(3);
+    chunk[1].SetNull(5);
+
+    auto local = sort.InitLocal();
+    sort.Sink(*local, chunk);
+    sort.Combine(*local);
+    Scheduler scheduler(1);
+    sort.Finalize(scheduler);
+    ASSERT_EQ(sort.Count(), 6u);
+
+    auto out = MakeChunk(types, 16);
+    SortScanState state;
+    ASSERT_EQ(sort.Scan(state, out), 6u);
+    EXPECT_EQ(sort.Scan(state, out), 0u);
+
+    /** NULL first on column 0, then (1, 7), (1, 5), (2, 30), (2, 10), (2, NULL) */
+    EXPECT_TRUE(out[0].IsNull(0));
+    int32_t expected_a[] = {1, 1, 2, 2, 2};
+    int64_t expected_b[] = {7, 5, 30, 10};
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(out[0].Data<int32_t>()[i + 1], expected_a[i]);
+    }
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(out[1].Data<int64_t>()[i + 1], expected_b[i]);
+    }
+    EXPECT_TRUE(out[1].IsNull(5));
+}
+
+TEST_F(SortTest, ParallelRunsMatchStdSort) {
+    std::vector<LogicalType> types = {LogicalType::INT32, LogicalType::FLOAT};
+    SortOperator sort(types, {{0, OrderType::DESCENDING}, {1}});
+
+    const uint32_t num_threads = 4;
+    const uint32_t chunks_per_thread = 80;
+    const uint32_t chunk_size = 1024;
+
+    std::vector<std::pair<int32_t, float>> expected;
+    std::vector<std::vector<std::pair<int32_t, float>>> inputs(num_threads);
+    std::mt19937 rng(7);
+    for (uint32_t t = 0; t < num_threads; t++) {
+        for (uint32_t i = 0; i < chunks_per_thread * chunk_size; i++) {
+            auto row = std::make_pair(static_cast<int32_t>(rng() % 1000) - 500,
+                                      static_cast<float>(rng() % 10000) / 7.0f - 700.0f);
+            inputs[t].push_back(row);
+            expected.push_back(row);
+        }
+    }
+
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < num_threads; t++) {
+        workers.emplace_back([&, t]() {
+            Arena local_arena;
+            auto local = sort.InitLocal();
+            for (uint32_t c = 0; c < chunks_per_thread; c++) {
+                std::vector<Vector> chunk;
+                chunk.emplace_back(LogicalType::INT32, chunk_size, local_arena);
+                chunk.emplace_back(LogicalType::FLOAT, chunk_size, local_arena);
+                chunk[0].SetSize(chunk_size);
+                chunk[1].SetSize(chunk_size);
+                for (uint32_t i = 0; i < chunk_size; i++) {
+                    chunk[0].Data<int32_t>()[i] = inputs[t][c * chunk_size + i].first;
+                    chunk[1].Data<float>()[i] = inputs[t][c * chunk_size + i].second;
+                }
+                sort.Sink(*local, chunk);
+            }
+            sort.Combine(*local);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    Scheduler scheduler(num_threads);
+    sort.Finalize(scheduler);
+
+    std::sort(expected.begin(), expected.end(), [](const auto &l, const auto &r) {
+        return std::make_tuple(-l.first, l.second) < std::make_tuple(-r.first, r.second);
+    });
+
+    auto out = MakeChunk(types, 1024);
+    SortScanState state;
+    size_t row = 0;
+    idx_t n;
+    while ((n = sort.Scan(state, out)) > 0) {
+        for (idx_t i = 0; i < n; i++, row++) {
+            ASSERT_EQ(out[0].Data<int32_t>()[i], expected[row].first);
+            ASSERT_EQ(out[1].Data<float>()[i], expected[row].second);
+        }
+    }
+    EXPECT_EQ(row, expected.size());
+}
+
+TEST_F(SortTest, ExternalSortSpillsAndMerges) {
+    std::vector<LogicalType> types = {LogicalType::INT64, LogicalType::DOUBLE};
+    SpillManager spill(testing::TempDir());
+
+    const uint32_t chunk_size = 1024;
+    const uint32_t num_chunks = 64;
+    std::vector<int64_t> expected;
+    {
+        SortOperator sort(types, {{0}}, 128 * 1024, &spill);
+        auto local = sort.InitLocal();
+        std::mt19937_64 rng(3);
+
+        for (uint32_t c = 0; c < num_chunks; c++) {
+            Arena chunk_arena;
+            std::vector<Vector> chunk;
+            chunk.emplace_back(LogicalType::INT64, chunk_size, chunk_arena);
+            chunk.emplace_back(LogicalType::DOUBLE, chunk_size, chunk_arena);
+            chunk[0].SetSize(chunk_size);
+            chunk[1].SetSize(chunk_size);
+            for (uint32_t i = 0; i < chunk_size; i++) {
+                int64_t v = static_cast<int64_t>(rng() % 1000000) - 500000;
+                chunk[0].Data<int64_t>()[i] = v;
+                chunk[1].Data<double>()[i] = static_cast<double>(v) * 0.5;
+                expected.push_back(v);
+            }
+            chunk[1].SetNull(c % chunk_size);
+            sort.Sink(*local, chunk);
+        }
+        sort.Combine(*local);
+        Scheduler scheduler(2);
+        sort.Finalize(scheduler);
+
+        EXPECT_GT(sort.SpilledRunCount(), 1u);
+        EXPECT_GT(spill.BytesOnDisk(), 0u);
+        EXPECT_EQ(sort.Count(), expected.size());
+
+        std::sort(expected.begin(), expected.end());
+
+        auto out = MakeChunk(types, 1000);
+        SortScanState state;
+        size_t row = 0;
+        size_t nulls = 0;
+        idx_t n;
+        while ((n = sort.Scan(state, out)) > 0) {
+            for (idx_t i = 0; i < n; i++, row++) {
+                ASSERT_EQ(out[0].Data<int64_t>()[i], expected[row]);
+                if (out[1].IsNull(i)) {
+                    nulls++;
+                } else {
+                    ASSERT_EQ(out[1].Data<double>()[i], static_cast<double>(expected[row]) * 0.5);
+                }
+            }
+        }
+        EXPECT_EQ(row, expected.size());
+        EXPECT_EQ(nulls, num_chunks);
+    }
+
+    /** Spill files are deleted with the operator */
+    EXPECT_EQ(spill.BytesOnDisk(), 0u);
+    EXPECT_GT(spill.BytesSpilled(), 0u);
+}
+
+TEST_F(SortTest, CombinedRunsSpillBeforeLocalOnes) {
+    SpillManager spill(testing::TempDir());
+    SortOperator sort({LogicalType::INT64, LogicalType::DOUBLE}, {{0}}, 256 * 1024, &spill);
+    std::mt19937_64 rng(5);
+    std::vector<int64_t> expected;
+
+    /** One worker hands most of the limit over, the other then sinks small batches past it */
+    auto large = sort.InitLocal();
+    auto small = sort.InitLocal();
+    for (int c = 0; c < 4; c++) {
+        SinkRandom(sort, *large, 1000, rng, expected);
+    }
+    sort.Combine(*large);
+    EXPECT_EQ(sort.SpilledRunCount(), 0u);
+    for (int c = 0; c < 40; c++) {
+        SinkRandom(sort, *small, 64, rng, expected);
+    }
+    /** The combined run makes room, a run per batch would be 40 runs */
+    EXPECT_EQ(sort.SpilledRunCount(), 1u);
+    EXPECT_LE(sort.PeakBufferedBytes(), 256u * 1024);
+
+    sort.Combine(*small);
+    Scheduler scheduler(2);
+    sort.Finalize(scheduler);
+    EXPECT_EQ(sort.Count(), expected.size());
+    ExpectSorted(sort, expected);
+}
+
+TEST_F(SortTest, ManyWorkersStayWithinTheLimit) {
+    SpillManager spill(testing::TempDir());
+    const uint64_t limit = 256 * 1024;
+    SortOperator sort({LogicalType::INT64, LogicalType::DOUBLE}, {{0}}, limit, &spill);
+
+    const uint32_t num_threads = 16;
+    std::vector<std::vector<int64_t>> inputs(num_threads);
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < num_threads; t++) {
+        workers.emplace_back([&, t]() {
+            std::mt19937_64 rng(t);
+            auto local = sort.InitLocal();
+            for (int c = 0; c < 20; c++) {
+                SinkRandom(sort, *local, 500, rng, inputs[t]);
+            }
+            sort.Combine(*local);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    EXPECT_GT(sort.SpilledRunCount(), 0u);
+    EXPECT_GT(sort.PeakBufferedBytes(), 0u);
+    EXPECT_LE(sort.PeakBufferedBytes(), limit);
+
+    std::vector<int64_t> expected;
+    for (auto &input : inputs) {
+        expected.insert(expected.end(), input.begin(), input.end());
+    }
+    Scheduler scheduler(4);
+    sort.Finalize(scheduler);
+    EXPECT_EQ(sort.Count(), expected.size());
+    ExpectSorted(sort, expected);
+}
+
+TEST_F(SortTest, MergesManySpilledRunsInPasses) {
+    SpillManager spill(testing::TempDir());
+    SortOperator sort({LogicalType::INT64, LogicalType::DOUBLE}, {{0}}, 16 * 1024, &spill);
+    std::mt19937_64 rng(9);
+    std::vector<int64_t> expected;
+
+    /** Every chunk exceeds the limit on its own and becomes a run */
+    auto local = sort.InitLocal();
+    const size_t num_chunks = 3 * SortOperator::MAX_MERGE_FAN_IN + 5;
+    for (size_t c = 0; c < num_chunks; c++) {
+        SinkRandom(sort, *local, 1024, rng, expected);
+    }
+    EXPECT_EQ(sort.SpilledRunCount(), num_chunks);
+
+    sort.Combine(*local);
+    Scheduler scheduler(4);
+    sort.Finalize(scheduler);
+    EXPECT_LE(sort.SpilledRunCount(), SortOperator::MAX_MERGE_FAN_IN);
+    EXPECT_EQ(sort.Count(), expected.size());
+    ExpectSorted(sort, expected);
+}
+
+TEST_F(SortTest, ScanEmitsAtMostMaxCount) {
+    std::mt19937_64 rng(13);
+    std::vector<int64_t> expected;
+
+    SortOperator in_memory({LogicalType::INT64, LogicalType::DOUBLE}, {{0}});
+    auto local = in_memory.InitLocal();
+    SinkRandom(in_memory, *local, 3000, rng, expected);
+    in_memory.Combine(*local);
+    Scheduler scheduler(2);
+    in_memory.Finalize(scheduler);
+    ExpectSorted(in_memory, expected, 7);
+
+    SpillManager spill(testing::TempDir());
+    SortOperator spilled({LogicalType::INT64, LogicalType::DOUBLE}, {{0}}, 16 * 1024, &spill);
+    local = spilled.InitLocal();
+    expected.clear();
+    SinkRandom(spilled, *local, 3000, rng, expected);
+    spilled.Combine(*local);
+    spilled.Finalize(scheduler);
+    ASSERT_GT(spilled.SpilledRunCount(), 0u);
+    ExpectSorted(spilled, expected, 7);
+}
+} // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include "electricdb/execution/engine/pipeline_builder.h"
+#include "electricdb/execution/operators/aggregate/physical_streaming_aggregate.h"
+#include "electricdb/execution/operators/aggregate/streaming_aggregate.h"
+#include "electricdb/execution/operators/out/out.h"
+#include "electricdb/execution/operators/scan/scan.h"
+#include "electricdb/util/arena.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace electricdb {
+class StreamingAggregateTest : public testing::Test {
+    protected:
+        Arena arena;
+
+        /** @brief Chunk of (key, value) rows */
+        std::vector<Vector> MakeChunk(Arena &chunk_arena, const std::vector<int32_t> &keys,
+                                      const std::vector<int64_t> &values) {
+            std::vector<Vector> chunk;
+            chunk.emplace_back(LogicalType::INT32, keys.size(), chunk_arena);
+            chunk.emplace_back(LogicalType::INT64, keys.size(), chunk_arena);
+            chunk[0].SetSize(keys.size());
+            chunk[1].SetSize(keys.size());
+            for (size_t i = 0; i < keys.size(); i++) {
+                chunk[0].Data<int32_t>()[i] = keys[i];
+                chunk[1].Data<int64_t>()[i] = values[i];
+            }
+            return chunk;
+        }
+
+        std::vector<Vector> MakeOutput(const StreamingAggregateOperator &op, uint32_t capacity) {
+            std::vector<Vector> out;
+            for (auto type : op.OutputTypes()) {
+                out.emplace_back(type, capacity, arena);
+            }
+            return out;
+        }
+
+        /** @brief GROUP BY over `rows` sorted keys in runs of `run` rows, through a pipeline */
+        void ExpectPipelineRuns(uint32_t rows, uint32_t run) {
+            std::vector<Vector> table;
+            table.emplace_back(LogicalType::INT32, rows, arena);
+            table.emplace_back(LogicalType::INT64, rows, arena);
+            for (auto &column : table) {
+                column.SetSize(rows);
+            }
+            for (uint32_t i = 0; i < rows; i++) {
+                table[0].Data<int32_t>()[i] = static_cast<int32_t>(i / run);
+                table[1].Data<int64_t>()[i] = i;
+            }
+
+            PhysicalColumnScan scan(table);
+            PhysicalStreamingAggregate aggregate(
+                    scan.Types(), {0}, {{AggregateType::COUNT_STAR}, {AggregateType::SUM, 1}});
+            aggregate.AddChild(&scan);
+            PhysicalResultCollector result(aggregate.Types());
+            result.AddChild(&aggregate);
+
+            PipelineBuilder builder(result);
+            Scheduler scheduler(4);
+            builder.Execute(scheduler);
+
+            const uint32_t groups = (rows + run - 1) / run;
+            ASSERT_EQ(result.Count(), groups);
+            int32_t key = 0;
+            for (size_t c = 0; c < result.ChunkCount(); c++) {
+                const auto &chunk = result.Chunk(c);
+                for (idx_t i = 0; i < chunk[0].Size(); i++) {
+                    const int64_t first = static_cast<int64_t>(key) * run;
+                    const int64_t last = std::min<int64_t>(first + run, rows) - 1;
+                    EXPECT_EQ(chunk[0].Data<int32_t>()[i], key);
+                    EXPECT_EQ(chunk[1].Data<int64_t>()[i], last - first + 1);
+                    EXPECT_EQ(chunk[2].Data<int64_t>()[i], (first + last) * (last - first + 1) / 2);
+                    key++;
+                }
+            }
+        }
+};
+
+TEST_F(StreamingAggregateTest, GroupsSpanChunkBoundaries) {
+    StreamingAggregateOperator op({LogicalType::INT32, LogicalType::INT64}, {0},
+                                  {{AggregateType::COUNT_STAR},
+                                   {AggregateType::SUM, 1},
+                                   {AggregateType::MIN, 1},
+                                   {AggregateType::AVG, 1}});
+    ASSERT_EQ(op.OutputTypes().size(), 5u);
+    EXPECT_EQ(op.OutputTypes()[2], LogicalType::INT64);
+    EXPECT_EQ(op.OutputTypes()[4], LogicalType::DOUBLE);
+
+    /** Sorted keys with run lengths 1..20, fed in chunks of 37 rows */
+    std::vector<int32_t> keys;
+    std::vector<int64_t> values;
+    std::map<int32_t, std::pair<int64_t, int64_t>> expected;
+    for (int32_t k = 1; k <= 20; k++) {
+        for (int32_t r = 0; r < k; r++) {
+            keys.push_back(k);
+            values.push_back(k * 100 + r);
+            expected[k].first++;
+            expected[k].second += k * 100 + r;
+        }
+    }
+
+    auto state = op.InitState();
+    auto out = MakeOutput(op, 64);
+    std::vector<int32_t> seen_keys;
+    auto collect = [&](idx_t count) {
+        for (idx_t i = 0; i < count; i++) {
+            const int32_t key = out[0].Data<int32_t>()[i];
+            seen_keys.push_back(key);
+            EXPECT_EQ(out[1].Data<int64_t>()[i], expected[key].first);
+            EXPECT_EQ(out[2].Data<int64_t>()[i], expected[key].second);
+            EXPECT_EQ(out[3].Data<int64_t>()[i], key * 100);
+            EXPECT_DOUBLE_EQ(out[4].Data<double>()[i],
+                             static_cast<double>(expected[key].second) / expected[key].first);
+        }
+    };
+
+    for (size_t begin = 0; begin < keys.size(); begin += 37) {
+        const size_t end = std::min(keys.size(), begin + 37);
+        Arena chunk_arena;
+        auto chunk = MakeChunk(chunk_arena, {keys.begin() + begin, keys.begin() + end},
+                               {values.begin() + begin, values.begin() + end});
+        collect(op.Execute(state, chunk, out));
+    }
+    collect(op.Flush(state, out));
+    EXPECT_EQ(op.Flush(state, out), 0u);
+
+    ASSERT_EQ(seen_keys.size(), 20u);
+    for (int32_t k = 1; k <= 20; k++) {
+        EXPECT_EQ(seen_keys[k - 1], k);
+    }
+}
+
+TEST_F(StreamingAggregateTest, NullKeysFormOneGroup) {
+    StreamingAggregateOperator op({LogicalType::INT32, LogicalType::INT64}, {0},
+                                  {{AggregateType::COUNT, 1}, {AggregateType::MAX, 1}});
+
+    auto chunk = MakeChunk(arena, {0, 0, 0, 5, 5}, {1, 2, 3, 4, 5});
+    /** Rows 0-1 have a NULL key, row 2 has key 0; row 4 has a NULL value */
+    chunk[0].SetNull(0);
+    chunk[0].SetNull(1);
+    chunk[1].SetNull(4);
+
+    auto state = op.InitState();
+    auto out = MakeOutput(op, 8);
+    ASSERT_EQ(op.Execute(state, chunk, out), 2u);
+    EXPECT_TRUE(out[0].IsNull(0));
+    EXPECT_EQ(out[1].Data<int64_t>()[0], 2);
+    EXPECT_EQ(out[2].Data<int64_t>()[0], 2);
+    EXPECT_FALSE(out[0].IsNull(1));
+    EXPECT_EQ(out[0].Data<int32_t>()[1], 0);
+    EXPECT_EQ(out[2].Data<int64_t>()[1], 3);
+
+    ASSERT_EQ(op.Flush(state, out), 1u);
+    EXPECT_EQ(out[0].Data<int32_t>()[0], 5);
+    EXPECT_EQ(out[1].Data<int64_t>()[0], 1);
+    EXPECT_EQ(out[2].Data<int64_t>()[0], 4);
+}
+
+TEST_F(StreamingAggregateTest, AllNullInputYieldsNullAggregate) {
+    StreamingAggregateOperator op({LogicalType::INT32, LogicalType::INT64}, {0},
+                                  {{AggregateType::SUM, 1}});
+
+    auto chunk = MakeChunk(arena, {7, 7}, {1, 2});
+    chunk[1].SetNull(0);
+    chunk[1].SetNull(1);
+
+    auto state = op.InitState();
+    auto out = MakeOutput(op, 4);
+    EXPECT_EQ(op.Execute(state, chunk, out), 0u);
+    ASSERT_EQ(op.Flush(state, out), 1u);
+    EXPECT_EQ(out[0].Data<int32_t>()[0], 7);
+    EXPECT_TRUE(out[1].IsNull(0));
+}
+
+TEST_F(StreamingAggregateTest, MultipleGroupColumns) {
+    StreamingAggregateOperator op({LogicalType::INT32, LogicalType::INT64}, {0, 1},
+                                  {{AggregateType::COUNT_STAR}});
+
+    auto chunk = MakeChunk(arena, {1, 1, 1, 2, 2}, {10, 10, 20, 20, 20});
+    auto state = op.InitState();
+    auto out = MakeOutput(op, 8);
+    ASSERT_EQ(op.Execute(state, chunk, out), 2u);
+    EXPECT_EQ(out[2].Data<int64_t>()[0], 2);
+    EXPECT_EQ(out[1].Data<int64_t>()[1], 20);
+    EXPECT_EQ(out[2].Data<int64_t>()[1], 1);
+    ASSERT_EQ(op.Flush(state, out), 1u);
+    EXPECT_EQ(out[0].Data<int32_t>()[0], 2);
+    EXPECT_EQ(out[2].Data<int64_t>()[0], 2);
+}
+
+TEST_F(StreamingAggregateTest, FloatKeysGroupLikeTheirSortOrder) {
+    StreamingAggregateOperator op({LogicalType::DOUBLE}, {0}, {{AggregateType::COUNT_STAR}});
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    /** -0.0 and 0.0 are one group, and so is every NaN, also across chunks and sign bits */
+    auto make = [&](const std::vector<double> &keys) {
+        std::vector<Vector> chunk;
+        chunk.emplace_back(LogicalType::DOUBLE, keys.size(), arena);
+        chunk[0].SetSize(keys.size());
+        std::copy(keys.begin(), keys.end(), chunk[0].Data<double>());
+        return chunk;
+    };
+    auto first = make({-1.0, -0.0, 0.0, nan});
+    auto second = make({-nan, nan});
+
+    auto state = op.InitState();
+    auto out = MakeOutput(op, 8);
+    ASSERT_EQ(op.Execute(state, first, out), 2u);
+    EXPECT_EQ(out[0].Data<double>()[0], -1.0);
+    EXPECT_EQ(out[1].Data<int64_t>()[0], 1);
+    EXPECT_EQ(out[0].Data<double>()[1], 0.0);
+    EXPECT_EQ(out[1].Data<int64_t>()[1], 2);
+
+    EXPECT_EQ(op.Execute(state, second, out), 0u);
+    ASSERT_EQ(op.Flush(state, out), 1u);
+    EXPECT_TRUE(std::isnan(out[0].Data<double>()[0]));
+    EXPECT_EQ(out[1].Data<int64_t>()[0], 3);
+}
+
+TEST_F(StreamingAggregateTest, RejectsUnknownColumn) {
+    EXPECT_THROW(StreamingAggregateOperator({LogicalType::INT32}, {3}, {}), std::runtime_error);
+    EXPECT_THROW(StreamingAggregateOperator({LogicalType::INT32}, {0}, {{AggregateType::SUM, 4}}),
+                 std::runtime_error);
+}
+
+TEST_F(StreamingAggregateTest, ContinueMergesGroupsAcrossRanges) {
+    StreamingAggregateOperator op({LogicalType::INT32, LogicalType::INT64}, {0},
+                                  {{AggregateType::COUNT_STAR}, {AggregateType::SUM, 1}});
+    auto out = MakeOutput(op, 8);
+
+    /** Three consecutive ranges of 1 1 2 2 | 2 2 | 2 3 4 */
+    auto range = [&](const std::vector<int32_t> &keys, const std::vector<int64_t> &values,
+                     idx_t emitted) {
+        auto state = op.InitState();
+        state.hold_first_group = true;
+        auto chunk = MakeChunk(arena, keys, values);
+        EXPECT_EQ(op.Execute(state, chunk, out), emitted);
+        return state;
+    };
+    auto first = range({1, 1, 2, 2}, {1, 2, 3, 4}, 0);
+    auto middle = range({2, 2}, {5, 6}, 0);
+    auto last = range({2, 3, 4}, {7, 8, 9}, 1);
+    EXPECT_EQ(out[0].Data<int32_t>()[0], 3);
+
+    auto state = op.InitState();
+    ASSERT_EQ(op.Continue(state, first, out), 1u);
+    EXPECT_EQ(out[0].Data<int32_t>()[0], 1);
+    EXPECT_EQ(out[1].Data<int64_t>()[0], 2);
+    EXPECT_EQ(out[2].Data<int64_t>()[0], 3);
+
+    EXPECT_EQ(op.Continue(state, middle, out), 0u);
+    ASSERT_EQ(op.Continue(state, last, out), 1u);
+    EXPECT_EQ(out[0].Data<int32_t>()[0], 2);
+    EXPECT_EQ(out[1].Data<int64_t>()[0], 5);
+    EXPECT_EQ(out[2].Data<int64_t>()[0], 25);
+
+    ASSERT_EQ(op.Flush(state, out), 1u);
+    EXPECT_EQ(out[0].Data<int32_t>()[0], 4);
+    EXPECT_EQ(out[2].Data<int64_t>()[0], 9);
+}
+
+TEST_F(StreamingAggregateTest, PipelineGroupsSpanMorsels) {
+    /** Several morsels of sorted keys, with groups across every morsel boundary */
+    ExpectPipelineRuns(3 * DEFAULT_MORSEL_SIZE + 77, 1000);
+}
+
+TEST_F(StreamingAggregateTest, PipelineGroupsSpanWholeMorsels) {
+    /** Groups longer than a morsel, so some morsels hold a single group open at both ends */
+    ExpectPipelineRuns(5 * DEFAULT_MORSEL_SIZE + 77, 2 * DEFAULT_MORSEL_SIZE + 5);
+}
+
+} // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "electricdb/execution/operators/sort/top_n.h"
+#include "electricdb/util/arena.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+namespace electricdb {
+class TopNTest : public testing::Test {
+    protected:
+        Arena arena;
+
+        /** @brief Chunk of (ts, id) rows */
+        std::vector<Vector> MakeChunk(Arena &chunk_arena, const std::vector<int64_t> &ts,
+                                      int32_t first_id) {
+            std::vector<Vector> chunk;
+            chunk.emplace_back(LogicalType::INT64, ts.size(), chunk_arena);
+            chunk.emplace_back(LogicalType::INT32, ts.size(), chunk_arena);
+            chunk[0].SetSize(ts.size());
+            chunk[1].SetSize(ts.size());
+            for (size_t i = 0; i < ts.size(); i++) {
+                chunk[0].Data<int64_t>()[i] = ts[i];
+                chunk[1].Data<int32_t>()[i] = first_id + static_cast<int32_t>(i);
+            }
+            return chunk;
+        }
+
+        std::vector<Vector> MakeOutput(uint32_t capacity) {
+            std::vector<Vector> out;
+            out.emplace_back(LogicalType::INT64, capacity, arena);
+            out.emplace_back(LogicalType::INT32, capacity, arena);
+            return out;
+        }
+};
+
+TEST_F(TopNTest, LatestEventsSkipOlderChunks) {
+    TopNOperator top_n({LogicalType::INT64, LogicalType::INT32}, {{0, OrderType::DESCENDING}}, 50);
+    auto local = top_n.InitLocal();
+
+    /** Chunks arrive newest first, so after the first chunk every other one is skipped */
+    for (int c = 0; c < 20; c++) {
+        std::vector<int64_t> ts(1024);
+        for (int i = 0; i < 1024; i++) {
+            ts[i] = (20 - c) * 10000 + i;
+        }
+        Arena chunk_arena;
+        top_n.Sink(*local, MakeChunk(chunk_arena, ts, c * 1024));
+    }
+    EXPECT_EQ(local->chunks_skipped, 19u);
+
+    top_n.Combine(*local);
+    top_n.Finalize();
+    ASSERT_EQ(top_n.Count(), 50u);
+
+    auto out = MakeOutput(64);
+    TopNScanState state;
+    ASSERT_EQ(top_n.Scan(state, out), 50u);
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(out[0].Data<int64_t>()[i], 200000 + 1023 - i);
+        EXPECT_EQ(out[1].Data<int32_t>()[i], 1023 - i);
+    }
+    EXPECT_EQ(top_n.Scan(state, out), 0u);
+}
+
+TEST_F(TopNTest, ZoneMapSkipUsesPublishedBoundary) {
+    TopNOperator top_n({LogicalType::INT64, LogicalType::INT32}, {{0}}, 10);
+    auto local = top_n.InitLocal();
+
+    std::vector<int64_t> ts(100);
+    for (int i = 0; i < 100; i++) {
+        ts[i] = i;
+    }
+    Arena chunk_arena;
+    top_n.Sink(*local, MakeChunk(chunk_arena, ts, 0));
+
+    /** Boundary is 9: a chunk with min 10 cannot contribute, a chunk with min 9 may tie */
+    ZoneMap above(LogicalType::INT64);
+    above.min.Set<int64_t>(10);
+    above.max.Set<int64_t>(500);
+    EXPECT_TRUE(top_n.CanSkipZone(above));
+
+    ZoneMap tie(LogicalType::INT64);
+    tie.min.Set<int64_t>(9);
+    tie.max.Set<int64_t>(500);
+    EXPECT_FALSE(top_n.CanSkipZone(tie));
+
+    /** NULLS LAST: a chunk of only NULLs never beats a full heap */
+    ZoneMap nulls(LogicalType::INT64);
+    nulls.has_nulls = true;
+    EXPECT_TRUE(top_n.CanSkipZone(nulls));
+}
+
+TEST_F(TopNTest, ZoneWithNanIsNotSkippedWhenNanSortsFirst) {
+    TopNOperator top_n({LogicalType::DOUBLE}, {{0, OrderType::DESCENDING}}, 1);
+    auto local = top_n.InitLocal();
+
+    Arena chunk_arena;
+    std::vector<Vector> chunk;
+    chunk.emplace_back(LogicalType::DOUBLE, 1, chunk_arena);
+    chunk[0].SetSize(1);
+    chunk[0].Data<double>()[0] = 100.0;
+    top_n.Sink(*local, chunk);
+
+    /** NaN sorts above every number, so descending it beats the boundary of 100 */
+    ZoneMap zone(LogicalType::DOUBLE);
+    zone.min.Set<double>(1.0);
+    zone.max.Set<double>(2.0);
+    EXPECT_TRUE(top_n.CanSkipZone(zone));
+    zone.has_nan = true;
+    EXPECT_FALSE(top_n.CanSkipZone(zone));
+
+    ZoneMap only_nan(LogicalType::DOUBLE);
+    only_nan.has_nan = true;
+    EXPECT_FALSE(top_n.CanSkipZone(only_nan));
+}
+
+TEST_F(TopNTest, ParallelWorkersWithOffsetMatchSort) {
+    const uint64_t limit = 100;
+    const uint64_t offset = 25;
+    TopNOperator top_n({LogicalType::INT64, LogicalType::INT32}, {{0}, {1}}, limit, offset);
+
+    const int num_threads = 4;
+    std::vector<std::pair<int64_t, int32_t>> expected;
+    std::vector<std::vector<int64_t>> inputs(num_threads);
+    std::mt19937_64 rng(11);
+    for (int t = 0; t < num_threads; t++) {
+        for (int i = 0; i < 50 * 1024; i++) {
+            inputs[t].push_back(static_cast<int64_t>(rng() % 1000000));
+            expected.emplace_back(inputs[t].back(), t * 1000000 + i);
+        }
+    }
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; t++) {
+        workers.emplace_back([&, t]() {
+            auto local = top_n.InitLocal();
+            for (size_t c = 0; c < inputs[t].size(); c += 1024) {
+                Arena chunk_arena;
+                std::vector<int64_t> ts(inputs[t].begin() + c, inputs[t].begin() + c + 1024);
+                top_n.Sink(*local, MakeChunk(chunk_arena, ts, t * 1000000 + c));
+            }
+            top_n.Combine(*local);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    top_n.Finalize();
+
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(top_n.Count(), limit);
+
+    auto out = MakeOutput(1024);
+    TopNScanState state;
+    ASSERT_EQ(top_n.Scan(state, out), limit);
+    for (uint64_t i = 0; i < limit; i++) {
+        EXPECT_EQ(out[0].Data<int64_t>()[i], expected[offset + i].first);
+        EXPECT_EQ(out[1].Data<int32_t>()[i], expected[offset + i].second);
+    }
+}
+} // namespace electricdb
\ No newline at end of file
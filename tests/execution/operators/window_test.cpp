@@ -0,0 +1,353 @@
+#include <gtest/gtest.h>
+#include "electricdb/execution/engine/pipeline_builder.h"
+#include "electricdb/execution/operators/out/out.h"
+#include "electricdb/execution/operators/scan/scan.h"
+#include "electricdb/execution/operators/window/physical_window.h"
+#include "electricdb/execution/operators/window/window.h"
+#include "electricdb/util/arena.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <tuple>
+
+namespace electricdb {
+using WindowRow = std::tuple<int32_t, int64_t, int64_t>;
+
+class WindowTest : public testing::Test {
+    protected:
+        Arena arena;
+
+        /** @brief Chunk of (user, day, amount) rows */
+        std::vector<Vector> MakeChunk(Arena &chunk_arena, const std::vector<WindowRow> &rows) {
+            std::vector<Vector> chunk;
+            chunk.emplace_back(LogicalType::INT32, rows.size(), chunk_arena);
+            chunk.emplace_back(LogicalType::INT64, rows.size(), chunk_arena);
+            chunk.emplace_back(LogicalType::INT64, rows.size(), chunk_arena);
+            for (auto &vec : chunk) {
+                vec.SetSize(rows.size());
+            }
+            for (size_t i = 0; i < rows.size(); i++) {
+                chunk[0].Data<int32_t>()[i] = std::get<0>(rows[i]);
+                chunk[1].Data<int64_t>()[i] = std::get<1>(rows[i]);
+                chunk[2].Data<int64_t>()[i] = std::get<2>(rows[i]);
+            }
+            return chunk;
+        }
+
+        std::vector<Vector> MakeOutput(const WindowOperator &op, uint32_t capacity) {
+            std::vector<Vector> out;
+            for (auto type : op.OutputTypes()) {
+                out.emplace_back(type, capacity, arena);
+            }
+            return out;
+        }
+
+        /** @brief Feed `rows` through `op` from two workers and finalize it */
+        void Run(WindowOperator &op, const std::vector<WindowRow> &rows, uint32_t num_threads) {
+            auto first = op.InitLocal();
+            auto second = op.InitLocal();
+            Arena chunk_arena;
+            const size_t half = rows.size() / 2;
+            op.Sink(*first, MakeChunk(chunk_arena, {rows.begin(), rows.begin() + half}));
+            op.Sink(*second, MakeChunk(chunk_arena, {rows.begin() + half, rows.end()}));
+            op.Combine(*first);
+            op.Combine(*second);
+            Scheduler scheduler(num_threads);
+            op.Finalize(scheduler);
+        }
+};
+
+TEST_F(WindowTest, RankingAndOffsetFunctions) {
+    WindowOperator op({LogicalType::INT32, LogicalType::INT64, LogicalType::INT64}, {0}, {{1}},
+                      {{WindowFunctionType::ROW_NUMBER},
+                       {WindowFunctionType::RANK},
+                       {WindowFunctionType::DENSE_RANK},
+                       {WindowFunctionType::LAG, 2},
+                       {WindowFunctionType::LEAD, 2, 2}});
+
+    Run(op, {{2, 5, 50}, {1, 3, 30}, {1, 1, 10}, {1, 3, 31}, {1, 4, 40}, {2, 6, 60}}, 2);
+    ASSERT_EQ(op.Count(), 6u);
+    EXPECT_EQ(op.PartitionCount(), 2u);
+
+    auto out = MakeOutput(op, 16);
+    WindowScanState state;
+    ASSERT_EQ(op.Scan(state, out), 6u);
+    EXPECT_EQ(op.Scan(state, out), 0u);
+
+    const std::vector<int32_t> users = {1, 1, 1, 1, 2, 2};
+    const std::vector<int64_t> row_numbers = {1, 2, 3, 4, 1, 2};
+    const std::vector<int64_t> ranks = {1, 2, 2, 4, 1, 2};
+    const std::vector<int64_t> dense_ranks = {1, 2, 2, 3, 1, 2};
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(out[0].Data<int32_t>()[i], users[i]);
+        EXPECT_EQ(out[3].Data<int64_t>()[i], row_numbers[i]);
+        EXPECT_EQ(out[4].Data<int64_t>()[i], ranks[i]);
+        EXPECT_EQ(out[5].Data<int64_t>()[i], dense_ranks[i]);
+    }
+
+    /** LAG(amount, 1) and LEAD(amount, 2) stay inside the partition */
+    EXPECT_TRUE(out[6].IsNull(0));
+    EXPECT_EQ(out[6].Data<int64_t>()[1], 10);
+    EXPECT_EQ(out[6].Data<int64_t>()[3], out[2].Data<int64_t>()[2]);
+    EXPECT_TRUE(out[6].IsNull(4));
+    EXPECT_EQ(out[6].Data<int64_t>()[5], 50);
+    EXPECT_EQ(out[7].Data<int64_t>()[1], 40);
+    EXPECT_TRUE(out[7].IsNull(2));
+    EXPECT_TRUE(out[7].IsNull(3));
+    EXPECT_TRUE(out[7].IsNull(4));
+}
+
+TEST_F(WindowTest, FramedAggregatesMatchBruteForce) {
+    WindowFrame rows_frame{WindowFrameType::ROWS,
+                           {WindowBoundType::PRECEDING, 6},
+                           {WindowBoundType::CURRENT_ROW}};
+    WindowFrame centered{WindowFrameType::ROWS,
+                         {WindowBoundType::PRECEDING, 3},
+                         {WindowBoundType::FOLLOWING, 3}};
+    /** Rolling 7-day window over sparse days */
+    WindowFrame range_frame{WindowFrameType::RANGE,
+                            {WindowBoundType::PRECEDING, 6},
+                            {WindowBoundType::CURRENT_ROW}};
+
+    WindowOperator op({LogicalType::INT32, LogicalType::INT64, LogicalType::INT64}, {0}, {{1}},
+                      {{WindowFunctionType::SUM, 2, 0, rows_frame},
+                       {WindowFunctionType::MIN, 2, 0, centered},
+                       {WindowFunctionType::MAX, 2, 0, range_frame},
+                       {WindowFunctionType::COUNT_STAR, 0, 0, range_frame},
+                       {WindowFunctionType::SUM, 2, 0, range_frame}});
+
+    std::mt19937 rng(7);
+    std::vector<WindowRow> rows;
+    for (int32_t user = 0; user < 50; user++) {
+        int64_t day = 0;
+        const int days = 1 + static_cast<int>(rng() % 200);
+        for (int d = 0; d < days; d++) {
+            day += 1 + static_cast<int64_t>(rng() % 4);
+            rows.emplace_back(user, day, static_cast<int64_t>(rng() % 1000) - 500);
+        }
+    }
+    std::vector<WindowRow> sorted = rows;
+    std::sort(sorted.begin(), sorted.end());
+    std::shuffle(rows.begin(), rows.end(), rng);
+
+    Run(op, rows, 4);
+    ASSERT_EQ(op.Count(), sorted.size());
+    EXPECT_EQ(op.PartitionCount(), 50u);
+
+    auto out = MakeOutput(op, 1024);
+    WindowScanState state;
+    size_t row = 0;
+    while (idx_t count = op.Scan(state, out)) {
+        for (idx_t i = 0; i < count; i++, row++) {
+            const auto [user, day, amount] = sorted[row];
+            ASSERT_EQ(out[0].Data<int32_t>()[i], user);
+            ASSERT_EQ(out[1].Data<int64_t>()[i], day);
+
+            int64_t rows_sum = 0, centered_min = INT64_MAX, range_max = INT64_MIN;
+            int64_t range_count = 0, range_sum = 0;
+            for (size_t j = 0; j < sorted.size(); j++) {
+                if (std::get<0>(sorted[j]) != user) {
+                    continue;
+                }
+                const int64_t value = std::get<2>(sorted[j]);
+                const auto distance = static_cast<int64_t>(j) - static_cast<int64_t>(row);
+                if (distance >= -6 && distance <= 0) {
+                    rows_sum += value;
+                }
+                if (distance >= -3 && distance <= 3) {
+                    centered_min = std::min(centered_min, value);
+                }
+                const int64_t other_day = std::get<1>(sorted[j]);
+                if (other_day >= day - 6 && other_day <= day) {
+                    range_max = std::max(range_max, value);
+                    range_count++;
+                    range_sum += value;
+                }
+            }
+            EXPECT_EQ(out[3].Data<int64_t>()[i], rows_sum);
+            EXPECT_EQ(out[4].Data<int64_t>()[i], centered_min);
+            EXPECT_EQ(out[5].Data<int64_t>()[i], range_max);
+            EXPECT_EQ(out[6].Data<int64_t>()[i], range_count);
+            EXPECT_EQ(out[7].Data<int64_t>()[i], range_sum);
+        }
+    }
+    EXPECT_EQ(row, sorted.size());
+}
+
+TEST_F(WindowTest, DescendingRangeAndEmptyFrames) {
+    /** RANGE BETWEEN 1 FOLLOWING AND 2 FOLLOWING over days in descending order */
+    WindowFrame frame{WindowFrameType::RANGE,
+                      {WindowBoundType::FOLLOWING, 1},
+                      {WindowBoundType::FOLLOWING, 2}};
+    WindowOperator op({LogicalType::INT32, LogicalType::INT64, LogicalType::INT64}, {},
+                      {{1, OrderType::DESCENDING}},
+                      {{WindowFunctionType::SUM, 2, 0, frame},
+                       {WindowFunctionType::COUNT, 2, 0, frame}});
+
+    Run(op, {{0, 10, 1}, {0, 9, 2}, {0, 8, 4}, {0, 5, 8}, {0, 4, 16}}, 1);
+    auto out = MakeOutput(op, 8);
+    WindowScanState state;
+    ASSERT_EQ(op.Scan(state, out), 5u);
+
+    /** Days 10, 9, 8, 5, 4: frames cover days [d - 2, d - 1] */
+    EXPECT_EQ(out[3].Data<int64_t>()[0], 2 + 4);
+    EXPECT_EQ(out[3].Data<int64_t>()[1], 4);
+    EXPECT_TRUE(out[3].IsNull(2));
+    EXPECT_EQ(out[4].Data<int64_t>()[2], 0);
+    EXPECT_EQ(out[3].Data<int64_t>()[3], 16);
+    EXPECT_TRUE(out[3].IsNull(4));
+}
+
+TEST_F(WindowTest, WholeInputIsOnePeerGroup) {
+    WindowOperator op({LogicalType::INT32, LogicalType::INT64, LogicalType::INT64}, {}, {},
+                      {{WindowFunctionType::AVG, 2}, {WindowFunctionType::RANK}});
+
+    Run(op, {{0, 0, 1}, {0, 0, 2}, {0, 0, 3}, {0, 0, 6}}, 2);
+    auto out = MakeOutput(op, 8);
+    WindowScanState state;
+    ASSERT_EQ(op.Scan(state, out), 4u);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_DOUBLE_EQ(out[3].Data<double>()[i], 3.0);
+        EXPECT_EQ(out[4].Data<int64_t>()[i], 1);
+    }
+}
+
+TEST_F(WindowTest, FloatPeersFollowSortOrder) {
+    WindowOperator op({LogicalType::DOUBLE}, {}, {{0}}, {{WindowFunctionType::RANK}});
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    /** -0.0 ties with 0.0 and every NaN ties with every other NaN, like in the sort */
+    const std::vector<double> keys = {nan, -0.0, 1.0, 0.0, -nan};
+    std::vector<Vector> chunk;
+    chunk.emplace_back(LogicalType::DOUBLE, keys.size(), arena);
+    chunk[0].SetSize(keys.size());
+    std::copy(keys.begin(), keys.end(), chunk[0].Data<double>());
+
+    auto local = op.InitLocal();
+    op.Sink(*local, chunk);
+    op.Combine(*local);
+    Scheduler scheduler(1);
+    op.Finalize(scheduler);
+
+    auto out = MakeOutput(op, 8);
+    WindowScanState state;
+    ASSERT_EQ(op.Scan(state, out), 5u);
+    const std::vector<int64_t> ranks = {1, 1, 3, 4, 4};
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(out[1].Data<int64_t>()[i], ranks[i]);
+    }
+}
+
+TEST_F(WindowTest, NanRangeFramesHoldOnlyTheirPeers) {
+    /** COUNT(*) OVER (ORDER BY key RANGE BETWEEN 1 PRECEDING AND 1 FOLLOWING) */
+    WindowFrame frame{WindowFrameType::RANGE,
+                      {WindowBoundType::PRECEDING, 1},
+                      {WindowBoundType::FOLLOWING, 1}};
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<double> keys = {3.0, nan, 1.0, 0.0, -nan, 2.0, 0.0};
+
+    for (OrderType order : {OrderType::ASCENDING, OrderType::DESCENDING}) {
+        WindowOperator op({LogicalType::DOUBLE}, {}, {{0, order}},
+                          {{WindowFunctionType::COUNT_STAR, 0, 0, frame}});
+        std::vector<Vector> chunk;
+        chunk.emplace_back(LogicalType::DOUBLE, keys.size() + 1, arena);
+        chunk[0].SetSize(keys.size() + 1);
+        std::copy(keys.begin(), keys.end(), chunk[0].Data<double>());
+        chunk[0].SetNull(keys.size());
+
+        auto local = op.InitLocal();
+        op.Sink(*local, chunk);
+        op.Combine(*local);
+        Scheduler scheduler(1);
+        op.Finalize(scheduler);
+
+        auto out = MakeOutput(op, 16);
+        WindowScanState state;
+        ASSERT_EQ(op.Scan(state, out), keys.size() + 1);
+        for (idx_t i = 0; i < keys.size() + 1; i++) {
+            const int64_t count = out[1].Data<int64_t>()[i];
+            if (out[0].IsNull(i)) {
+                EXPECT_EQ(count, 1);
+                continue;
+            }
+            const double key = out[0].Data<double>()[i];
+            if (std::isnan(key)) {
+                EXPECT_EQ(count, 2);
+                continue;
+            }
+            /** Keys 0, 0, 1, 2, 3: the numbers within 1 of `key` */
+            const int64_t expected = key == 0.0 ? 3 : key == 1.0 ? 4 : key == 2.0 ? 3 : 2;
+            EXPECT_EQ(count, expected) << "key " << key;
+        }
+    }
+}
+
+TEST_F(WindowTest, PhysicalWindowRunsInAPipeline) {
+    const uint32_t rows = 50000;
+    const int32_t users = 7;
+    std::vector<Vector> table;
+    table.emplace_back(LogicalType::INT32, rows, arena);
+    table.emplace_back(LogicalType::INT64, rows, arena);
+    for (auto &column : table) {
+        column.SetSize(rows);
+    }
+    for (uint32_t i = 0; i < rows; i++) {
+        table[0].Data<int32_t>()[i] = static_cast<int32_t>(i % users);
+        table[1].Data<int64_t>()[i] = static_cast<int64_t>(rows - i);
+    }
+
+    PhysicalColumnScan scan(table);
+    PhysicalWindow window(scan.Types(), {0}, {{1}}, {{WindowFunctionType::ROW_NUMBER}});
+    window.AddChild(&scan);
+    PhysicalResultCollector result(window.Types());
+    result.AddChild(&window);
+
+    PipelineBuilder builder(result);
+    Scheduler scheduler(4);
+    builder.Execute(scheduler);
+    ASSERT_EQ(result.Count(), rows);
+    EXPECT_EQ(window.PartitionCount(), static_cast<size_t>(users));
+
+    /** Partitions in user order, each in ascending day order and numbered from 1 */
+    int32_t user = 0;
+    int64_t row_number = 0;
+    int64_t previous = 0;
+    for (size_t c = 0; c < result.ChunkCount(); c++) {
+        const auto &chunk = result.Chunk(c);
+        for (idx_t i = 0; i < chunk[0].Size(); i++) {
+            if (chunk[0].Data<int32_t>()[i] != user) {
+                EXPECT_EQ(chunk[0].Data<int32_t>()[i], user + 1);
+                user = chunk[0].Data<int32_t>()[i];
+                row_number = 0;
+            } else if (row_number > 0) {
+                EXPECT_GT(chunk[1].Data<int64_t>()[i], previous);
+            }
+            previous = chunk[1].Data<int64_t>()[i];
+            EXPECT_EQ(chunk[2].Data<int64_t>()[i], ++row_number);
+        }
+    }
+    EXPECT_EQ(user, users - 1);
+}
+
+TEST_F(WindowTest, RejectsInvalidSpecs) {
+    const std::vector<LogicalType> types = {LogicalType::INT32, LogicalType::INT64};
+    WindowFrame range_frame{WindowFrameType::RANGE,
+                            {WindowBoundType::PRECEDING, 1},
+                            {WindowBoundType::CURRENT_ROW}};
+    WindowFrame backwards{WindowFrameType::ROWS,
+                          {WindowBoundType::UNBOUNDED_FOLLOWING},
+                          {WindowBoundType::CURRENT_ROW}};
+
+    EXPECT_THROW(WindowOperator(types, {}, {{0}, {1}},
+                                {{WindowFunctionType::SUM, 1, 0, range_frame}}),
+                 std::runtime_error);
+    EXPECT_THROW(WindowOperator(types, {}, {{0}}, {{WindowFunctionType::SUM, 1, 0, backwards}}),
+                 std::runtime_error);
+    EXPECT_THROW(WindowOperator(types, {}, {}, {{WindowFunctionType::LAG, 5}}),
+                 std::runtime_error);
+    EXPECT_THROW(WindowOperator(types, {}, {}, {{WindowFunctionType::LEAD, 1, -1}}),
+                 std::runtime_error);
+}
+} // namespace electricdb
\ No newline at end of file
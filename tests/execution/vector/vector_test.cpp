@@ -4,6 +4,8 @@
 #include "electricdb/execution/vector/selection_vector.h"
 #include "electricdb/util/arena.h"
 
+#include <sys/mman.h>
+
 namespace electricdb {
 class VectorTest : public ::testing::Test {
   protected:
@@ -76,6 +78,67 @@ TEST_F(VectorTest, ResetClearsState) {
 	EXPECT_FALSE(vec.HasNulls());
 }
 
+TEST_F(VectorTest, ReferenceExternalViewsForeignMemory) {
+	const int64_t external[4] = {10, 20, 30, 40};
+	Vector vec(LogicalType::INT64, 4, arena);
+	vec.SetSize(2);
+	vec.SetNull(1);
+
+	vec.ReferenceExternal(external + 1, 3);
+
+	EXPECT_EQ(vec.Size(), 3u);
+	EXPECT_FALSE(vec.HasNulls());
+	EXPECT_EQ(vec.Data<int64_t>()[0], 20);
+	EXPECT_EQ(static_cast<const Vector &>(vec).Data<int64_t>(), external + 1);
+
+	vec.SetNull(2);
+	EXPECT_TRUE(vec.IsNull(2));
+	EXPECT_EQ(external[3], 40);
+}
+
+TEST_F(VectorTest, WritesNeverGoThroughExternalMemory) {
+	/** Read-only like a mapped column file, so a write through it faults */
+	const size_t page = 4096;
+	void *mapping = mmap(nullptr, page, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	ASSERT_NE(mapping, MAP_FAILED);
+	const auto *external = static_cast<const int64_t *>(mapping);
+
+	Vector source(LogicalType::INT64, 4, arena);
+	source.SetSize(4);
+	for (int64_t i = 0; i < 4; i++) {
+		source.Data<int64_t>()[i] = 100 + i;
+	}
+
+	Vector vec(LogicalType::INT64, 4, arena);
+	vec.ReferenceExternal(external, 4);
+	EXPECT_TRUE(vec.IsExternal());
+	vec.Copy(source, 1, 2, 1);
+	EXPECT_FALSE(vec.IsExternal());
+	EXPECT_EQ(vec.Data<int64_t>()[0], 0);
+	EXPECT_EQ(vec.Data<int64_t>()[1], 101);
+	EXPECT_EQ(vec.Data<int64_t>()[2], 102);
+	EXPECT_EQ(vec.Data<int64_t>()[3], 0);
+
+	vec.ReferenceExternal(external, 4);
+	vec.Reset();
+	EXPECT_FALSE(vec.IsExternal());
+	vec.SetSize(4);
+	vec.Copy(source, 0, 4, 0);
+	EXPECT_EQ(vec.Data<int64_t>()[3], 103);
+
+	vec.ReferenceExternal(external, 4);
+	SelectionVector sel(arena, 4);
+	sel.Set(0, 3);
+	sel.Set(1, 0);
+	vec.Gather(source, sel, 2);
+	EXPECT_FALSE(vec.IsExternal());
+	EXPECT_EQ(vec.Data<int64_t>()[0], 103);
+	EXPECT_EQ(vec.Data<int64_t>()[1], 100);
+
+	EXPECT_EQ(external[1], 0);
+	munmap(mapping, page);
+}
+
 TEST_F(VectorTest, MoveConstructor) {
 	Vector vec(LogicalType::INT32, 8, arena);
 	vec.SetSize(3);
@@ -106,6 +169,110 @@ TEST_F(VectorTest, MoveAssignment) {
 	EXPECT_EQ(vec2.Data<int32_t>()[1], 2);
 }
 
+TEST_F(VectorTest, DictionaryVectorFlattensThroughCodes) {
+	Vector dictionary(LogicalType::INT64, 3, arena);
+	dictionary.SetSize(3);
+	dictionary.Data<int64_t>()[0] = 100;
+	dictionary.Data<int64_t>()[1] = 200;
+	dictionary.Data<int64_t>()[2] = 300;
+	const sel_t codes[5] = {2, 0, 0, 1, 2};
+
+	Vector vec(LogicalType::INT64, 5, arena);
+	vec.ReferenceDictionary(dictionary, codes, 5);
+	vec.SetNull(3);
+	EXPECT_TRUE(vec.IsDictionary());
+	EXPECT_EQ(&vec.Dictionary(), &dictionary);
+	EXPECT_EQ(vec.Codes(), codes);
+	EXPECT_EQ(vec.Size(), 5u);
+
+	vec.Flatten();
+	EXPECT_FALSE(vec.IsDictionary());
+	EXPECT_EQ(vec.Size(), 5u);
+	EXPECT_EQ(vec.Data<int64_t>()[0], 300);
+	EXPECT_EQ(vec.Data<int64_t>()[1], 100);
+	EXPECT_EQ(vec.Data<int64_t>()[2], 100);
+	EXPECT_EQ(vec.Data<int64_t>()[4], 300);
+	EXPECT_TRUE(vec.IsNull(3));
+	EXPECT_EQ(dictionary.Data<int64_t>()[0], 100);
+}
+
+TEST_F(VectorTest, DictionaryVectorCopiesAndGathersValues) {
+	Vector dictionary(LogicalType::INT32, 2, arena);
+	dictionary.SetSize(2);
+	dictionary.Data<int32_t>()[0] = 7;
+	dictionary.Data<int32_t>()[1] = 9;
+	const sel_t codes[4] = {1, 0, 0, 1};
+
+	Vector vec(LogicalType::INT32, 4, arena);
+	vec.ReferenceDictionary(dictionary, codes, 4);
+	vec.SetNull(2);
+
+	Vector copy(LogicalType::INT32, 4, arena);
+	copy.SetSize(3);
+	copy.Copy(vec, 1, 3);
+	EXPECT_EQ(copy.Data<int32_t>()[0], 7);
+	EXPECT_TRUE(copy.IsNull(1));
+	EXPECT_EQ(copy.Data<int32_t>()[2], 9);
+
+	SelectionVector sel(arena, 2);
+	sel.Set(0, 3);
+	sel.Set(1, 1);
+	Vector gathered(LogicalType::INT32, 4, arena);
+	gathered.ReferenceDictionary(dictionary, codes, 4);
+	gathered.Gather(vec, sel, 2);
+	EXPECT_FALSE(gathered.IsDictionary());
+	EXPECT_EQ(gathered.Size(), 2u);
+	EXPECT_EQ(gathered.Data<int32_t>()[0], 9);
+	EXPECT_EQ(gathered.Data<int32_t>()[1], 7);
+	EXPECT_FALSE(gathered.HasNulls());
+
+	vec.Reset();
+	EXPECT_FALSE(vec.IsDictionary());
+	EXPECT_EQ(vec.Size(), 0u);
+}
+
+TEST_F(VectorTest, RunVectorExpandsItsRuns) {
+	Vector values(LogicalType::INT64, 3, arena);
+	values.SetSize(3);
+	values.Data<int64_t>()[0] = 5;
+	values.Data<int64_t>()[2] = 8;
+	values.SetNull(1);
+	const uint32_t lengths[3] = {2, 3, 2};
+
+	Vector vec(LogicalType::INT64, 7, arena);
+	vec.ReferenceRuns(values, lengths, 7);
+	EXPECT_TRUE(vec.IsRuns());
+	EXPECT_EQ(&vec.RunValues(), &values);
+	EXPECT_EQ(vec.RunLengths(), lengths);
+	EXPECT_EQ(vec.Size(), 7u);
+	for (uint32_t i = 0; i < 7; i++) {
+		EXPECT_EQ(vec.IsNull(i), i >= 2 && i < 5);
+	}
+
+	/** Rows 1 to 5 start and end inside a run */
+	Vector copy(LogicalType::INT64, 7, arena);
+	copy.SetSize(6);
+	copy.Copy(vec, 1, 5, 1);
+	EXPECT_EQ(copy.Data<int64_t>()[1], 5);
+	EXPECT_TRUE(copy.IsNull(2));
+	EXPECT_TRUE(copy.IsNull(4));
+	EXPECT_EQ(copy.Data<int64_t>()[5], 8);
+
+	vec.Flatten();
+	EXPECT_FALSE(vec.IsRuns());
+	EXPECT_EQ(vec.Size(), 7u);
+	EXPECT_EQ(vec.Data<int64_t>()[0], 5);
+	EXPECT_EQ(vec.Data<int64_t>()[1], 5);
+	EXPECT_EQ(vec.Data<int64_t>()[5], 8);
+	EXPECT_EQ(vec.Data<int64_t>()[6], 8);
+	EXPECT_TRUE(vec.IsNull(3));
+
+	vec.ReferenceRuns(values, lengths, 7);
+	vec.Reset();
+	EXPECT_FALSE(vec.IsRuns());
+	EXPECT_EQ(vec.Size(), 0u);
+}
+
 TEST_F(VectorTest, SetSizeShrinkDoesNotInvalidateAccess) {
 	Vector vec(LogicalType::INT32, 8, arena);
 	vec.SetSize(6);
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "electricdb/io/file.h"
+#include "temp_path.h"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+namespace electricdb {
+class FileTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            path = TempPath(".bin");
+        }
+
+        void TearDown() override { File::Remove(path); }
+
+        std::string path;
+};
+
+TEST_F(FileTest, WriteThenReadAtOffsets) {
+    File file(path, FILE_READ | FILE_WRITE | FILE_CREATE);
+    ASSERT_TRUE(file.IsOpen());
+
+    std::vector<uint32_t> values(1000);
+    for (uint32_t i = 0; i < values.size(); i++) {
+        values[i] = i * 3;
+    }
+    file.Write(values.data(), values.size() * sizeof(uint32_t), 0);
+    EXPECT_EQ(file.Size(), values.size() * sizeof(uint32_t));
+
+    uint32_t out[10];
+    EXPECT_EQ(file.Read(out, sizeof(out), 500 * sizeof(uint32_t)), sizeof(out));
+    for (uint32_t i = 0; i < 10; i++) {
+        EXPECT_EQ(out[i], (500 + i) * 3);
+    }
+}
+
+TEST_F(FileTest, ShortReadAtEndOfFile) {
+    File file(path, FILE_READ | FILE_WRITE | FILE_CREATE);
+    const char data[] = "electric";
+    file.Write(data, 8, 0);
+
+    char out[16];
+    EXPECT_EQ(file.Read(out, sizeof(out), 4), 4u);
+    EXPECT_EQ(file.Read(out, sizeof(out), 8), 0u);
+}
+
+TEST_F(FileTest, TruncateAndMove) {
+    File file(path, FILE_READ | FILE_WRITE | FILE_CREATE);
+    std::vector<uint8_t> data(4096, 7);
+    file.Write(data.data(), data.size(), 0);
+    file.Truncate(100);
+    EXPECT_EQ(file.Size(), 100u);
+
+    File moved(std::move(file));
+    EXPECT_FALSE(file.IsOpen());
+    EXPECT_TRUE(moved.IsOpen());
+    EXPECT_EQ(moved.Path(), path);
+
+    moved.Close();
+    EXPECT_FALSE(moved.IsOpen());
+}
+
+TEST_F(FileTest, DirectReadsIntoAlignedBuffers) {
+    std::vector<uint32_t> values(3000);
+    for (uint32_t i = 0; i < values.size(); i++) {
+        values[i] = i;
+    }
+    {
+        File file(path, FILE_WRITE | FILE_CREATE);
+        file.Write(values.data(), values.size() * sizeof(uint32_t), 0);
+    }
+
+    File file(path, FILE_READ | FILE_DIRECT);
+    if (!file.IsDirect()) {
+        GTEST_SKIP() << "File system does not support direct I/O";
+    }
+    auto *buffer = static_cast<uint32_t *>(std::aligned_alloc(DIRECT_IO_ALIGNMENT, 8192));
+    /** The second page ends the file early, the read stops there */
+    EXPECT_EQ(file.Read(buffer, 8192, 4096), values.size() * sizeof(uint32_t) - 4096);
+    EXPECT_EQ(buffer[0], 1024u);
+    EXPECT_EQ(buffer[1975], 2999u);
+    std::free(buffer);
+
+    File moved(std::move(file));
+    EXPECT_TRUE(moved.IsDirect());
+    EXPECT_FALSE(file.IsDirect());
+}
+
+TEST_F(FileTest, OpenMissingFileThrows) {
+    EXPECT_THROW(File(path, FILE_READ), std::runtime_error);
+}
+} // namespace electricdb
\ No newline at end of file
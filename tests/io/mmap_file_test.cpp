@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "electricdb/io/file.h"
+#include "electricdb/io/mmap_file.h"
+#include "temp_path.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace electricdb {
+class MappedFileTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            path = TempPath(".bin");
+        }
+
+        void TearDown() override { File::Remove(path); }
+
+        std::string path;
+};
+
+TEST_F(MappedFileTest, MapsFileContents) {
+    std::vector<uint64_t> values(10000);
+    for (uint64_t i = 0; i < values.size(); i++) {
+        values[i] = i * i;
+    }
+    {
+        File file(path, FILE_WRITE | FILE_CREATE);
+        file.Write(values.data(), values.size() * sizeof(uint64_t), 0);
+    }
+
+    MappedFile mapping(path);
+    ASSERT_TRUE(mapping.IsMapped());
+    ASSERT_EQ(mapping.Size(), values.size() * sizeof(uint64_t));
+    mapping.Advise(AccessHint::SEQUENTIAL);
+    mapping.Advise(12345, 8000, AccessHint::WILLNEED);
+    EXPECT_EQ(std::memcmp(mapping.Data(), values.data(), mapping.Size()), 0);
+}
+
+TEST_F(MappedFileTest, MoveTransfersMapping) {
+    {
+        File file(path, FILE_WRITE | FILE_CREATE);
+        file.Write("mapped", 6, 0);
+    }
+
+    MappedFile first(path);
+    MappedFile second(std::move(first));
+    EXPECT_FALSE(first.IsMapped());
+    ASSERT_TRUE(second.IsMapped());
+    EXPECT_EQ(std::memcmp(second.Data(), "mapped", 6), 0);
+
+    second.Unmap();
+    EXPECT_FALSE(second.IsMapped());
+    EXPECT_EQ(second.Size(), 0u);
+}
+
+TEST_F(MappedFileTest, EmptyFileMapsNothing) {
+    { File file(path, FILE_WRITE | FILE_CREATE); }
+
+    MappedFile mapping(path);
+    EXPECT_FALSE(mapping.IsMapped());
+    mapping.Advise(AccessHint::WILLNEED);
+}
+
+TEST_F(MappedFileTest, MissingFileThrows) {
+    EXPECT_THROW(MappedFile mapping(path), std::runtime_error);
+}
+} // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "electricdb/io/prefetch.h"
+#include "temp_path.h"
+
+#include <cstring>
+#include <vector>
+
+namespace electricdb {
+/** @brief Runs every test with io_uring (where the kernel allows it) and with the thread pool */
+class AsyncReaderTest : public testing::TestWithParam<bool> {
+    protected:
+        void SetUp() override {
+            path = TempPath();
+            values.resize(1 << 16);
+            for (uint32_t i = 0; i < values.size(); i++) {
+                values[i] = i * 2654435761u;
+            }
+            File file(path, FILE_WRITE | FILE_CREATE);
+            file.Write(values.data(), values.size() * sizeof(uint32_t), 0);
+        }
+
+        void TearDown() override { File::Remove(path); }
+
+        std::string path;
+        std::vector<uint32_t> values;
+};
+
+TEST_P(AsyncReaderTest, ReadsManyRangesOutOfOrder) {
+    File file(path, FILE_READ);
+    AsyncReader io(4, GetParam());
+    if (!GetParam()) {
+        EXPECT_EQ(io.GetBackend(), AsyncReader::Backend::THREAD_POOL);
+    }
+
+    /** More reads than the queue depth, so some wait for a free slot */
+    const uint32_t reads = 64;
+    const uint32_t per_read = static_cast<uint32_t>(values.size()) / reads;
+    std::vector<std::vector<uint32_t>> buffers(reads, std::vector<uint32_t>(per_read));
+    std::vector<uint64_t> tickets;
+    for (uint32_t r = 0; r < reads; r++) {
+        tickets.push_back(io.Submit(file, buffers[r].data(), per_read * sizeof(uint32_t),
+                                    uint64_t{r} * per_read * sizeof(uint32_t)));
+    }
+    for (uint32_t r = reads; r-- > 0;) {
+        ASSERT_EQ(io.Wait(tickets[r]), per_read * sizeof(uint32_t));
+        EXPECT_EQ(std::memcmp(buffers[r].data(), values.data() + r * per_read,
+                              per_read * sizeof(uint32_t)),
+                  0);
+    }
+}
+
+TEST_P(AsyncReaderTest, ShortReadAtEndOfFile) {
+    File file(path, FILE_READ);
+    AsyncReader io(2, GetParam());
+    std::vector<uint32_t> buffer(100);
+    const uint64_t size = values.size() * sizeof(uint32_t);
+    const uint64_t ticket = io.Submit(file, buffer.data(), 400, size - 40);
+    EXPECT_EQ(io.Wait(ticket), 40u);
+    EXPECT_EQ(buffer[9], values.back());
+}
+
+TEST_P(AsyncReaderTest, UnknownTicketThrows) {
+    AsyncReader io(2, GetParam());
+    EXPECT_THROW(io.Wait(12345), std::runtime_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, AsyncReaderTest, testing::Values(true, false));
+} // namespace electricdb
\ No newline at end of file
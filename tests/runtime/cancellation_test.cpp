@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "electricdb/runtime/cancellation.h"
+
+#include <memory>
+#include <thread>
+
+namespace electricdb {
+class CancellationTest : public testing::Test {};
+
+TEST_F(CancellationTest, FirstReasonSticks) {
+    CancellationToken token;
+    EXPECT_FALSE(token.IsCancelled());
+    EXPECT_EQ(token.Reason(), CancelReason::NONE);
+    EXPECT_NO_THROW(token.ThrowIfCancelled());
+
+    EXPECT_TRUE(token.Cancel());
+    EXPECT_FALSE(token.Cancel(CancelReason::DEADLINE));
+    EXPECT_TRUE(token.IsCancelled());
+    EXPECT_EQ(token.Reason(), CancelReason::USER);
+
+    try {
+        token.ThrowIfCancelled();
+        FAIL() << "expected QueryCancelled";
+    } catch (const QueryCancelled &e) {
+        EXPECT_EQ(e.Reason(), CancelReason::USER);
+    }
+}
+
+TEST_F(CancellationTest, DeadlineCancelsToken) {
+    CancellationToken token;
+    const auto start = CancellationToken::Clock::now();
+    token.SetTimeout(std::chrono::milliseconds(20));
+    EXPECT_FALSE(token.IsCancelled());
+
+    while (!token.IsCancelled()) {
+        ASSERT_LT(CancellationToken::Clock::now() - start, std::chrono::seconds(5));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(token.Reason(), CancelReason::DEADLINE);
+    EXPECT_GE(CancellationToken::Clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST_F(CancellationTest, PassedDeadlineCancelsImmediately) {
+    CancellationToken token;
+    token.SetDeadline(CancellationToken::Clock::now() - std::chrono::seconds(1));
+    EXPECT_EQ(token.Reason(), CancelReason::DEADLINE);
+}
+
+TEST_F(CancellationTest, DestroyedTokensLeaveTheTimer) {
+    for (int i = 0; i < 100; i++) {
+        auto token = std::make_unique<CancellationToken>();
+        token->SetTimeout(std::chrono::microseconds(i * 50));
+    }
+
+    CancellationToken later;
+    later.SetTimeout(std::chrono::hours(1));
+    later.SetTimeout(std::chrono::milliseconds(5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(later.Reason(), CancelReason::DEADLINE);
+}
+} // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "electricdb/runtime/metrics.h"
+
+namespace electricdb {
+class MetricsTest : public testing::Test {
+  protected:
+    static ProfileNode Node(const char *name, uint64_t rows) {
+        ProfileNode node;
+        node.name = name;
+        node.metrics.rows_in = rows;
+        node.metrics.rows_out = rows / 2;
+        node.metrics.batches = 3;
+        node.metrics.wall_ns = 1500000;
+        node.metrics.threads = 2;
+        return node;
+    }
+};
+
+TEST_F(MetricsTest, MergeAddsCountersAndKeepsMaxThreads) {
+    OperatorMetrics a;
+    a.rows_in = 10;
+    a.probes = 4;
+    a.probe_steps = 6;
+    a.threads = 3;
+    OperatorMetrics b;
+    b.rows_in = 5;
+    b.probes = 4;
+    b.probe_steps = 10;
+    b.threads = 2;
+
+    a.Merge(b);
+    EXPECT_EQ(a.rows_in, 15u);
+    EXPECT_EQ(a.threads, 3u);
+    EXPECT_DOUBLE_EQ(a.AverageProbeLength(), 2.0);
+    EXPECT_DOUBLE_EQ(OperatorMetrics().AverageProbeLength(), 0.0);
+}
+
+TEST_F(MetricsTest, RendersTreeAsTextAndJson) {
+    ProfileNode root = Node("RESULT_COLLECTOR", 10);
+    ProfileNode join = Node("HASH_JOIN", 100);
+    join.metrics.probes = 100;
+    join.metrics.probe_steps = 150;
+    join.children.push_back(Node("COLUMN_SCAN", 1000));
+    join.children.push_back(Node("COLUMN_SCAN", 50));
+    root.children.push_back(join);
+    QueryProfile profile(root, 2000000);
+
+    const std::string text = profile.ToText();
+    EXPECT_EQ(text.rfind("EXPLAIN ANALYZE (total 2.000ms)\n", 0), 0u);
+    EXPECT_NE(text.find("RESULT_COLLECTOR  rows_in=10 rows_out=5 batches=3 wall=1.500ms"),
+              std::string::npos);
+    EXPECT_NE(text.find("`- HASH_JOIN"), std::string::npos);
+    EXPECT_NE(text.find("probes=100 probe_len=1.50"), std::string::npos);
+    EXPECT_NE(text.find("   |- COLUMN_SCAN  rows_in=1000"), std::string::npos);
+    EXPECT_NE(text.find("   `- COLUMN_SCAN  rows_in=50"), std::string::npos);
+
+    const std::string json = profile.ToJson();
+    EXPECT_EQ(json.rfind("{\"wall_ns\":2000000,\"plan\":{\"name\":\"RESULT_COLLECTOR\"", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"HASH_JOIN\",\"rows_in\":100,\"rows_out\":50"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"probes\":100,\"probe_steps\":150,\"children\":[{\"name\":\"COLUMN_SCAN\""),
+              std::string::npos);
+    EXPECT_EQ(json.back(), '}');
+
+    int depth = 0;
+    for (char c : json) {
+        depth += c == '{' || c == '[' ? 1 : (c == '}' || c == ']' ? -1 : 0);
+        ASSERT_GE(depth, 0);
+    }
+    EXPECT_EQ(depth, 0);
+}
+} // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "electricdb/runtime/metrics.h"
+#include "electricdb/runtime/perf_counters.h"
+
+#include <thread>
+
+namespace electricdb {
+class PerfCountersTest : public testing::Test {};
+
+TEST_F(PerfCountersTest, UnavailableCountersReadZero) {
+    PerfCounters counters;
+    const PerfSample sample = counters.Read();
+    for (size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+        const bool counted = counters.Counts(static_cast<PerfEvent>(i));
+        EXPECT_TRUE(counters.Available() || !counted);
+        if (!counted) {
+            EXPECT_EQ(sample[i], 0u);
+        }
+    }
+}
+
+TEST_F(PerfCountersTest, CountsOnlyTheOwningThread) {
+    PerfCounters counters;
+    if (!counters.Counts(PerfEvent::INSTRUCTIONS)) {
+        GTEST_SKIP() << "perf_event_open is not allowed here";
+    }
+    const auto index = static_cast<size_t>(PerfEvent::INSTRUCTIONS);
+
+    const PerfSample before = counters.Read();
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < 1000000; i++) {
+        sum = sum + i;
+    }
+    const PerfSample after = counters.Read();
+    EXPECT_GT(after[index] - before[index], 1000000u);
+
+    /** Work on another thread does not show up */
+    std::thread([]() {
+        volatile uint64_t other = 0;
+        for (uint64_t i = 0; i < 10000000; i++) {
+            other = other + i;
+        }
+    }).join();
+    EXPECT_LT(counters.Read()[index] - after[index], 5000000u);
+}
+
+TEST_F(PerfCountersTest, MetricsRenderHardwareCountersWhenPresent) {
+    ProfileNode node;
+    node.name = "FILTER";
+    EXPECT_EQ(QueryProfile(node, 0).ToText().find("ipc="), std::string::npos);
+    EXPECT_EQ(QueryProfile(node, 0).ToJson().find("cycles"), std::string::npos);
+
+    node.metrics.cycles = 2000;
+    node.metrics.instructions = 3000;
+    node.metrics.llc_misses = 7;
+    node.metrics.branch_misses = 9;
+    EXPECT_DOUBLE_EQ(node.metrics.InstructionsPerCycle(), 1.5);
+    QueryProfile profile(node, 0);
+    EXPECT_NE(profile.ToText().find(
+                  "cycles=2000 instructions=3000 ipc=1.50 llc_misses=7 branch_misses=9"),
+              std::string::npos);
+    EXPECT_NE(profile.ToJson().find("\"cycles\":2000,\"instructions\":3000,\"llc_misses\":7"),
+              std::string::npos);
+}
+} // namespace electricdb
\ No newline at end of file
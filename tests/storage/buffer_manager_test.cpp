@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include "electricdb/io/file.h"
+#include "electricdb/runtime/cancellation.h"
+#include "electricdb/storage/buffer/buffer_manager.h"
+#include "temp_path.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace electricdb {
+class BufferManagerTest : public testing::Test {
+    protected:
+        static constexpr uint64_t FRAME = 4096;
+
+        /** @brief Pin a one-frame chunk of column 0 whose bytes are its row group */
+        BufferHandle PinChunk(BufferManager &buffers, uint32_t row_group) {
+            return buffers.Pin({0, row_group, 0}, FRAME, [&](uint8_t *data) {
+                loads++;
+                std::memset(data, static_cast<int>(row_group & 0xff), FRAME);
+            });
+        }
+
+        bool Resident(const BufferManager &buffers, uint32_t row_group) {
+            return buffers.IsResident({0, row_group, 0});
+        }
+
+        int loads = 0;
+};
+
+TEST_F(BufferManagerTest, LoadsOnceAndHitsAfterwards) {
+    BufferManager buffers(16 * FRAME, FRAME);
+    {
+        BufferHandle handle = PinChunk(buffers, 7);
+        ASSERT_TRUE(handle.IsValid());
+        EXPECT_EQ(handle.Size(), FRAME);
+        EXPECT_EQ(handle.Data()[FRAME - 1], 7);
+    }
+    BufferHandle again = PinChunk(buffers, 7);
+    EXPECT_EQ(again.Data()[0], 7);
+    EXPECT_EQ(loads, 1);
+    EXPECT_EQ(buffers.Stats().hits, 1u);
+    EXPECT_EQ(buffers.Stats().misses, 1u);
+    EXPECT_EQ(buffers.MemoryUsed(), FRAME);
+}
+
+TEST_F(BufferManagerTest, CountsMemoryInWholeFrames) {
+    BufferManager buffers(16 * FRAME, FRAME);
+    BufferHandle handle = buffers.Pin({1, 0, 0}, FRAME + 1, [](uint8_t *data) { data[FRAME] = 1; });
+    EXPECT_EQ(buffers.MemoryUsed(), 2 * FRAME);
+    EXPECT_THROW(buffers.Pin({1, 1, 0}, 17 * FRAME, [](uint8_t *) {}), std::runtime_error);
+    EXPECT_THROW(BufferManager(FRAME, 1000), std::runtime_error);
+}
+
+TEST_F(BufferManagerTest, RebuildsEvictedChunks) {
+    BufferManager buffers(4 * FRAME, FRAME);
+    for (uint32_t g = 0; g < 10; g++) {
+        PinChunk(buffers, g);
+        EXPECT_LE(buffers.MemoryUsed(), buffers.MemoryLimit());
+    }
+    EXPECT_FALSE(Resident(buffers, 0));
+    EXPECT_EQ(buffers.Stats().evictions, 6u);
+
+    BufferHandle handle = PinChunk(buffers, 0);
+    EXPECT_EQ(handle.Data()[0], 0);
+    EXPECT_EQ(loads, 11);
+}
+
+TEST_F(BufferManagerTest, NeverEvictsPinnedChunks) {
+    BufferManager buffers(4 * FRAME, FRAME);
+    std::vector<BufferHandle> pinned;
+    for (uint32_t g = 0; g < 4; g++) {
+        pinned.push_back(PinChunk(buffers, g));
+    }
+
+    /** Every chunk is pinned, so the next pin waits until one is unpinned */
+    std::atomic<bool> done{false};
+    std::thread waiter([&]() {
+        PinChunk(buffers, 4);
+        done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(done.load());
+    for (uint32_t g = 0; g < 4; g++) {
+        EXPECT_TRUE(Resident(buffers, g));
+        EXPECT_EQ(pinned[g].Data()[0], static_cast<uint8_t>(g));
+    }
+
+    pinned[2].Reset();
+    waiter.join();
+    EXPECT_TRUE(done.load());
+    EXPECT_FALSE(Resident(buffers, 2));
+    EXPECT_TRUE(Resident(buffers, 4));
+}
+
+TEST_F(BufferManagerTest, PinsOfTheCallerDoNotWaitForThemselves) {
+    BufferManager buffers(4 * FRAME, FRAME);
+    std::vector<BufferHandle> pinned;
+    for (uint32_t g = 0; g < 4; g++) {
+        pinned.push_back(PinChunk(buffers, g));
+    }
+    auto load = [](uint8_t *) {};
+    EXPECT_THROW(buffers.Pin({0, 4, 0}, FRAME, load, nullptr, pinned.size()),
+                 std::runtime_error);
+    EXPECT_FALSE(Resident(buffers, 4));
+
+    /** A chunk the caller holds is a hit, there is nothing to wait for */
+    BufferHandle again = buffers.Pin({0, 0, 0}, FRAME, load, nullptr, pinned.size());
+    EXPECT_EQ(again.Data()[0], 0);
+}
+
+TEST_F(BufferManagerTest, WaitsObserveCancellation) {
+    BufferManager buffers(4 * FRAME, FRAME);
+    std::vector<BufferHandle> pinned;
+    for (uint32_t g = 0; g < 4; g++) {
+        pinned.push_back(PinChunk(buffers, g));
+    }
+
+    /** Nobody unpins, so only the token ends the wait */
+    CancellationToken token;
+    std::atomic<bool> cancelled{false};
+    std::thread waiter([&]() {
+        try {
+            buffers.Pin({0, 4, 0}, FRAME, [](uint8_t *) {}, &token);
+        } catch (const QueryCancelled &) {
+            cancelled = true;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(cancelled.load());
+    token.Cancel();
+    waiter.join();
+    EXPECT_TRUE(cancelled.load());
+    EXPECT_FALSE(Resident(buffers, 4));
+    EXPECT_EQ(buffers.MemoryUsed(), 4 * FRAME);
+}
+
+TEST_F(BufferManagerTest, RewrittenFilesGetNewIds) {
+    const std::string path = TempPath();
+    auto write = [&](size_t size) {
+        File file(path, FILE_WRITE | FILE_CREATE | FILE_TRUNCATE);
+        const std::vector<uint8_t> bytes(size, 1);
+        file.Write(bytes.data(), bytes.size(), 0);
+    };
+    write(100);
+
+    BufferManager buffers(4 * FRAME, FRAME);
+    const uint32_t id = buffers.RegisterFile(path);
+    EXPECT_EQ(buffers.RegisterFile(path), id);
+    buffers.Pin({id, 0, 0}, FRAME, [](uint8_t *) {});
+    EXPECT_TRUE(buffers.IsResident({id, 0, 0}));
+
+    /** The cached chunk holds the old contents, it must not be found under the new id */
+    write(200);
+    const uint32_t rewritten = buffers.RegisterFile(path);
+    EXPECT_NE(rewritten, id);
+    EXPECT_FALSE(buffers.IsResident({id, 0, 0}));
+    EXPECT_FALSE(buffers.IsResident({rewritten, 0, 0}));
+    EXPECT_EQ(buffers.MemoryUsed(), 0u);
+    File::Remove(path);
+}
+
+TEST_F(BufferManagerTest, HotChunksSurviveOneOffScans) {
+    BufferManager buffers(16 * FRAME, FRAME);
+    /** Seen once, pushed out of probation, then wanted again: hot */
+    for (uint32_t g = 0; g < 4; g++) {
+        PinChunk(buffers, g);
+    }
+    for (uint32_t g = 100; g < 116; g++) {
+        PinChunk(buffers, g);
+    }
+    for (uint32_t g = 0; g < 4; g++) {
+        PinChunk(buffers, g);
+    }
+    EXPECT_EQ(buffers.Stats().promotions, 4u);
+
+    /** A scan many times the budget streams through probation only */
+    for (uint32_t g = 1000; g < 1200; g++) {
+        PinChunk(buffers, g);
+    }
+    for (uint32_t g = 0; g < 4; g++) {
+        EXPECT_TRUE(Resident(buffers, g));
+    }
+    EXPECT_LE(buffers.MemoryUsed(), buffers.MemoryLimit());
+}
+
+TEST_F(BufferManagerTest, FailedLoadsAreNotCached) {
+    BufferManager buffers(4 * FRAME, FRAME);
+    EXPECT_THROW(buffers.Pin({0, 1, 0}, FRAME,
+                             [](uint8_t *) { throw std::runtime_error("Read failed!"); }),
+                 std::runtime_error);
+    EXPECT_FALSE(Resident(buffers, 1));
+    EXPECT_EQ(buffers.MemoryUsed(), 0u);
+
+    BufferHandle handle = PinChunk(buffers, 1);
+    EXPECT_EQ(handle.Data()[0], 1);
+}
+
+TEST_F(BufferManagerTest, ConcurrentPinsLoadEachChunkOnce) {
+    BufferManager buffers(64 * FRAME, FRAME);
+    std::atomic<int> shared_loads{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            for (uint32_t g = 0; g < 32; g++) {
+                BufferHandle handle = buffers.Pin({0, g, 0}, FRAME, [&](uint8_t *data) {
+                    shared_loads++;
+                    std::this_thread::yield();
+                    std::memset(data, static_cast<int>(g), FRAME);
+                });
+                EXPECT_EQ(handle.Data()[FRAME / 2], static_cast<uint8_t>(g));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(shared_loads.load(), 32);
+    EXPECT_EQ(buffers.Stats().hits, 3u * 32);
+}
+} // namespace electricdb
\ No newline at end of file
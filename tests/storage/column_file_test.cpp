@@ -0,0 +1,418 @@
+#include <gtest/gtest.h>
+#include "electricdb/storage/format/column_file.h"
+#include "electricdb/util/arena.h"
+#include "temp_path.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace electricdb {
+class ColumnFileTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            path = TempPath(".edb");
+        }
+
+        void TearDown() override { File::Remove(path); }
+
+        /**
+         * @brief Write rows (id INT64, value DOUBLE, flag INT32), every 7th value is NULL. The
+         * columns are stored in `encodings`, PLAIN if empty.
+         */
+        void WriteTable(uint32_t rows, uint32_t row_group_size,
+                        const std::vector<EncodingType> &encodings = {}) {
+            ColumnFileWriter writer(path,
+                                    {{"id", LogicalType::INT64},
+                                     {"value", LogicalType::DOUBLE},
+                                     {"flag", LogicalType::INT32}},
+                                    row_group_size);
+            for (idx_t c = 0; c < encodings.size(); c++) {
+                writer.SetEncoding(c, encodings[c]);
+            }
+            const uint32_t batch = 1000;
+            for (uint32_t start = 0; start < rows; start += batch) {
+                const uint32_t count = std::min(batch, rows - start);
+                std::vector<Vector> columns;
+                columns.emplace_back(LogicalType::INT64, count, arena);
+                columns.emplace_back(LogicalType::DOUBLE, count, arena);
+                columns.emplace_back(LogicalType::INT32, count, arena);
+                for (auto &column : columns) {
+                    column.SetSize(count);
+                }
+                for (uint32_t i = 0; i < count; i++) {
+                    const uint32_t row = start + i;
+                    columns[0].Data<int64_t>()[i] = row;
+                    columns[1].Data<double>()[i] = row * 0.5;
+                    columns[2].Data<int32_t>()[i] = static_cast<int32_t>(row % 3);
+                    if (row % 7 == 0) {
+                        columns[1].SetNull(i);
+                    }
+                }
+                writer.Append(columns);
+            }
+            writer.Finish();
+        }
+
+        template <typename T>
+        static Value MakeValue(T v) {
+            Value value;
+            value.SetType(LogicalTypeTrait<T>::type);
+            value.Set<T>(v);
+            return value;
+        }
+
+        Arena arena;
+        std::string path;
+};
+
+TEST_F(ColumnFileTest, RoundTripsRowGroupsWithNulls) {
+    WriteTable(2500, 1024);
+
+    ColumnFileReader reader(path);
+    const FileMetadata &metadata = reader.Metadata();
+    ASSERT_EQ(metadata.columns.size(), 3u);
+    EXPECT_EQ(metadata.ColumnIndex("value"), 1);
+    EXPECT_EQ(metadata.ColumnIndex("missing"), -1);
+    ASSERT_EQ(reader.RowGroupCount(), 3u);
+    EXPECT_EQ(metadata.row_groups[2].row_count, 2500u - 2048u);
+    EXPECT_EQ(metadata.RowCount(), 2500u);
+
+    uint64_t row = 0;
+    for (idx_t g = 0; g < reader.RowGroupCount(); g++) {
+        std::vector<Vector> out;
+        out.emplace_back(LogicalType::INT64, 1024, arena);
+        out.emplace_back(LogicalType::DOUBLE, 1024, arena);
+        reader.ReadColumns(g, {0, 1}, out);
+
+        const uint32_t count = metadata.row_groups[g].row_count;
+        ASSERT_EQ(out[0].Size(), count);
+        for (uint32_t i = 0; i < count; i++, row++) {
+            EXPECT_EQ(out[0].Data<int64_t>()[i], static_cast<int64_t>(row));
+            EXPECT_EQ(out[1].IsNull(i), row % 7 == 0);
+            if (row % 7 != 0) {
+                EXPECT_EQ(out[1].Data<double>()[i], row * 0.5);
+            }
+        }
+    }
+    EXPECT_EQ(row, 2500u);
+}
+
+TEST_F(ColumnFileTest, FooterKeepsChunkStatistics) {
+    WriteTable(2048, 1024);
+
+    ColumnFileReader reader(path);
+    const ColumnChunkMeta &ids = reader.Metadata().row_groups[1].columns[0];
+    EXPECT_EQ(ids.offset % COLUMN_FILE_PAGE_SIZE, 0u);
+    EXPECT_EQ(ids.stats.min.Get<int64_t>(), 1024);
+    EXPECT_EQ(ids.stats.max.Get<int64_t>(), 2047);
+    EXPECT_FALSE(ids.stats.has_nulls);
+
+    const ColumnChunkMeta &values = reader.Metadata().row_groups[0].columns[1];
+    EXPECT_TRUE(values.stats.has_nulls);
+    EXPECT_EQ(values.null_count, 147u);
+    EXPECT_EQ(values.stats.max.Get<double>(), 1023 * 0.5);
+}
+
+TEST_F(ColumnFileTest, ReadsOnlyRequestedColumns) {
+    WriteTable(4096, 4096);
+
+    ColumnFileReader reader(path);
+    const uint64_t opened = reader.BytesRead();
+    std::vector<Vector> out;
+    out.emplace_back(LogicalType::INT32, 4096, arena);
+    reader.ReadColumns(0, {2}, out);
+
+    EXPECT_EQ(reader.BytesRead() - opened, 4096u * sizeof(int32_t));
+    EXPECT_EQ(out[0].Data<int32_t>()[4095], 4095 % 3);
+}
+
+TEST_F(ColumnFileTest, DirectReadsMatchBufferedReads) {
+    WriteTable(5000, 2000);
+
+    ColumnFileReader reader(path);
+    Arena buffers;
+    std::vector<Vector> buffered;
+    std::vector<Vector> direct;
+    buffered.emplace_back(LogicalType::DOUBLE, 2000, arena);
+    direct.emplace_back(LogicalType::DOUBLE, 2000, arena);
+    for (idx_t g = 0; g < reader.RowGroupCount(); g++) {
+        reader.ReadColumns(g, {1}, buffered);
+        const uint64_t before = reader.BytesRead();
+        reader.ReadColumns(g, {1}, direct, buffers, true);
+        buffers.Reset();
+
+        /** Only the chunk is accounted, not the alignment padding */
+        EXPECT_EQ(reader.BytesRead() - before, reader.Metadata().row_groups[g].columns[1].size);
+        ASSERT_EQ(direct[0].Size(), buffered[0].Size());
+        for (uint32_t i = 0; i < direct[0].Size(); i++) {
+            ASSERT_EQ(direct[0].IsNull(i), buffered[0].IsNull(i));
+            EXPECT_EQ(direct[0].Data<double>()[i], buffered[0].Data<double>()[i]);
+        }
+    }
+}
+
+TEST_F(ColumnFileTest, PrefetcherReadsAheadWithinBudget) {
+    WriteTable(10000, 1000);
+
+    ColumnFileReader reader(path);
+    AsyncReader io(8);
+    /** Room for the requested row group and two more of the INT64 column */
+    ChunkPrefetcher prefetcher(reader, {0}, io, 4, 3 * 1000 * sizeof(int64_t));
+
+    std::vector<Vector> out;
+    out.emplace_back(LogicalType::INT64, 1000, arena);
+    for (idx_t g = 0; g < reader.RowGroupCount(); g++) {
+        prefetcher.Read(g, out);
+        EXPECT_LE(prefetcher.InFlightBytes(), 2 * 1000 * sizeof(int64_t));
+        ASSERT_EQ(out[0].Size(), 1000u);
+        EXPECT_EQ(out[0].Data<int64_t>()[0], static_cast<int64_t>(g * 1000));
+        EXPECT_EQ(out[0].Data<int64_t>()[999], static_cast<int64_t>(g * 1000 + 999));
+    }
+    EXPECT_EQ(prefetcher.InFlightBytes(), 0u);
+
+    /** Row groups handed out already are fetched again */
+    prefetcher.Read(3, out);
+    EXPECT_EQ(out[0].Data<int64_t>()[0], 3000);
+}
+
+TEST_F(ColumnFileTest, RoundTripsEncodedChunks) {
+    WriteTable(2500, 1024,
+               {EncodingType::FOR, EncodingType::DICTIONARY, EncodingType::DICTIONARY});
+
+    ColumnFileReader reader(path);
+    const RowGroupMeta &first = reader.Metadata().row_groups[0];
+    EXPECT_EQ(first.columns[0].encoding, EncodingType::FOR);
+    EXPECT_EQ(first.columns[1].encoding, EncodingType::DICTIONARY);
+    EXPECT_EQ(first.columns[2].encoding, EncodingType::DICTIONARY);
+    EXPECT_LT(first.columns[2].size, 1024u * sizeof(int32_t) / 8);
+
+    uint64_t row = 0;
+    for (idx_t g = 0; g < reader.RowGroupCount(); g++) {
+        std::vector<Vector> out;
+        out.emplace_back(LogicalType::INT64, 1024, arena);
+        out.emplace_back(LogicalType::DOUBLE, 1024, arena);
+        out.emplace_back(LogicalType::INT32, 1024, arena);
+        reader.ReadColumns(g, {0, 1, 2}, out);
+        for (uint32_t i = 0; i < out[0].Size(); i++, row++) {
+            EXPECT_EQ(out[0].Data<int64_t>()[i], static_cast<int64_t>(row));
+            EXPECT_EQ(out[1].IsNull(i), row % 7 == 0);
+            if (row % 7 != 0) {
+                EXPECT_EQ(out[1].Data<double>()[i], row * 0.5);
+            }
+            EXPECT_EQ(out[2].Data<int32_t>()[i], static_cast<int32_t>(row % 3));
+        }
+    }
+    EXPECT_EQ(row, 2500u);
+
+    /** Decoded for a buffer manager: bitmap, then the plain values */
+    std::vector<uint8_t> chunk(reader.DecodedChunkSize(1, 1));
+    reader.DecodeChunk(1, 1, chunk.data());
+    const size_t bitmap = reader.Metadata().row_groups[1].columns[1].NullBitmapSize(1024);
+    EXPECT_EQ(chunk.size(), bitmap + 1024 * sizeof(double));
+    EXPECT_EQ(chunk[(1029 - 1024) / 8] & (1U << ((1029 - 1024) % 8)), 1U << 5);
+    double value;
+    std::memcpy(&value, chunk.data() + bitmap + 3 * sizeof(double), sizeof(value));
+    EXPECT_EQ(value, 1027 * 0.5);
+}
+
+TEST_F(ColumnFileTest, SelectsRowsWithoutReadingRuledOutChunks) {
+    WriteTable(4096, 2048, {EncodingType::PLAIN, EncodingType::PLAIN, EncodingType::DICTIONARY});
+
+    ColumnFileReader reader(path);
+    SelectionVector sel(arena, 2048);
+
+    /** Dictionary chunk, filtered on codes */
+    const idx_t ones = reader.SelectRows(1, 2, ColumnPredicate::Equal(MakeValue<int32_t>(1)), sel);
+    EXPECT_EQ(ones, 682u);
+    for (idx_t i = 0; i < ones; i++) {
+        ASSERT_EQ((2048 + sel.Get(i)) % 3, 1u);
+    }
+
+    /** Plain chunks, filtered on values; nulls never qualify */
+    EXPECT_EQ(reader.SelectRows(0, 0,
+                                ColumnPredicate::Range(MakeValue<int64_t>(10),
+                                                       MakeValue<int64_t>(19)),
+                                sel),
+              10u);
+    EXPECT_EQ(sel.Get(0), 10u);
+    EXPECT_EQ(reader.SelectRows(0, 1, ColumnPredicate::Range(Value(), Value()), sel),
+              2048u - 293u);
+
+    /** The zone map rules the chunk out, nothing is read */
+    const uint64_t before = reader.BytesRead();
+    EXPECT_EQ(reader.SelectRows(0, 0, ColumnPredicate::Equal(MakeValue<int64_t>(3000)), sel), 0u);
+    EXPECT_EQ(reader.BytesRead(), before);
+
+    EXPECT_THROW(reader.SelectRows(0, 0, ColumnPredicate::Equal(MakeValue<int32_t>(1)), sel),
+                 std::runtime_error);
+}
+
+TEST_F(ColumnFileTest, FiltersAndReadsRleChunksByRun) {
+    WriteTable(2500, 1024, {EncodingType::PLAIN, EncodingType::RLE, EncodingType::RLE});
+
+    ColumnFileReader reader(path);
+    EXPECT_EQ(reader.Metadata().row_groups[0].columns[1].encoding, EncodingType::RLE);
+    std::vector<Vector> out;
+    out.emplace_back(LogicalType::DOUBLE, 1024, arena);
+    out.emplace_back(LogicalType::INT32, 1024, arena);
+    reader.ReadColumns(1, {1, 2}, out);
+    for (uint32_t i = 0; i < out[0].Size(); i++) {
+        const uint32_t row = 1024 + i;
+        ASSERT_EQ(out[0].IsNull(i), row % 7 == 0);
+        if (row % 7 != 0) {
+            ASSERT_EQ(out[0].Data<double>()[i], row * 0.5);
+        }
+        ASSERT_EQ(out[1].Data<int32_t>()[i], static_cast<int32_t>(row % 3));
+    }
+
+    SelectionVector sel(arena, 1024);
+    EXPECT_EQ(reader.SelectRows(1, 2, ColumnPredicate::Equal(MakeValue<int32_t>(1)), sel), 342u);
+    EXPECT_EQ((1024 + sel.Get(0)) % 3, 1u);
+
+    /** Every value differs, so each row is a run of its own and NULL runs stay NULL */
+    RunChunk runs(LogicalType::DOUBLE, 1024, arena);
+    reader.ReadRuns(1, 1, runs);
+    ASSERT_EQ(runs.Size(), 1024u);
+    for (uint32_t r = 0; r < runs.Size(); r++) {
+        ASSERT_EQ(runs.lengths[r], 1u);
+        ASSERT_EQ(runs.values.IsNull(r), (1024 + r) % 7 == 0);
+    }
+
+    /** Chunks of other encodings read as runs of one row */
+    RunChunk ids(LogicalType::INT64, 1024, arena);
+    reader.ReadRuns(0, 0, ids);
+    ASSERT_EQ(ids.Size(), 1024u);
+    EXPECT_EQ(ids.values.Data<int64_t>()[1023], 1023);
+    EXPECT_EQ(ids.lengths[1023], 1u);
+    EXPECT_THROW(reader.ReadRuns(0, 1, ids), std::runtime_error);
+}
+
+TEST_F(ColumnFileTest, SelectsRowsOfSortedDeltaChunksByPage) {
+    WriteTable(2500, 2048, {EncodingType::DELTA, EncodingType::PLAIN, EncodingType::DELTA});
+
+    ColumnFileReader reader(path);
+    EXPECT_EQ(reader.Metadata().row_groups[0].columns[0].encoding, EncodingType::DELTA);
+    std::vector<Vector> out;
+    out.emplace_back(LogicalType::INT64, 2048, arena);
+    out.emplace_back(LogicalType::INT32, 2048, arena);
+    reader.ReadColumns(0, {0, 2}, out);
+    for (uint32_t i = 0; i < out[0].Size(); i++) {
+        ASSERT_EQ(out[0].Data<int64_t>()[i], static_cast<int64_t>(i));
+        ASSERT_EQ(out[1].Data<int32_t>()[i], static_cast<int32_t>(i % 3));
+    }
+
+    SelectionVector sel(arena, 2048);
+    const idx_t ids = reader.SelectRows(
+            0, 0, ColumnPredicate::Range(MakeValue<int64_t>(1100), MakeValue<int64_t>(1199)), sel);
+    EXPECT_EQ(ids, 100u);
+    EXPECT_EQ(sel.Get(0), 1100u);
+    EXPECT_EQ(reader.SelectRows(0, 2, ColumnPredicate::Equal(MakeValue<int32_t>(2)), sel), 682u);
+}
+
+TEST_F(ColumnFileTest, PicksEncodingsPerChunkAdaptively) {
+    /** A low-cardinality row group, then one of timestamps */
+    {
+        ColumnFileWriter writer(path, {{"ts", LogicalType::INT64}}, 8192);
+        writer.SetAdaptiveEncoding(0);
+        std::vector<Vector> columns;
+        columns.emplace_back(LogicalType::INT64, 16384, arena);
+        columns[0].SetSize(16384);
+        for (uint32_t i = 0; i < 16384; i++) {
+            columns[0].Data<int64_t>()[i] = i < 8192 ? (i * 7 % 16) * int64_t{1000000007}
+                                                     : 1700000000000000 + int64_t{1000000} * i;
+        }
+        writer.Append(columns);
+        writer.Finish();
+    }
+
+    ColumnFileReader reader(path);
+    ASSERT_EQ(reader.RowGroupCount(), 2u);
+    EXPECT_EQ(reader.Metadata().row_groups[0].columns[0].encoding, EncodingType::DICTIONARY);
+    EXPECT_EQ(reader.Metadata().row_groups[1].columns[0].encoding, EncodingType::DELTA);
+    std::vector<Vector> out;
+    out.emplace_back(LogicalType::INT64, 8192, arena);
+    for (idx_t group = 0; group < 2; group++) {
+        reader.ReadColumns(group, {0}, out);
+        for (uint32_t i = 0; i < 8192; i++) {
+            const uint32_t row = static_cast<uint32_t>(group) * 8192 + i;
+            ASSERT_EQ(out[0].Data<int64_t>()[i],
+                      row < 8192 ? (row * 7 % 16) * int64_t{1000000007}
+                                 : 1700000000000000 + int64_t{1000000} * row);
+        }
+    }
+}
+
+TEST_F(ColumnFileTest, FallsBackToTheNextCheapestEncoding) {
+    /**
+     * Pairs of 40-bit values: each sampled block sees a dictionary's worth of them, the chunk
+     * holds more than a dictionary may
+     */
+    constexpr uint32_t rows = 140000;
+    auto value = [](uint32_t i) {
+        return static_cast<int64_t>(uint64_t{i / 2} * 2654435761 % (uint64_t{1} << 40));
+    };
+    std::vector<Vector> columns;
+    columns.emplace_back(LogicalType::INT64, rows, arena);
+    columns[0].SetSize(rows);
+    for (uint32_t i = 0; i < rows; i++) {
+        columns[0].Data<int64_t>()[i] = value(i);
+    }
+    const auto estimates = ColumnWriter(LogicalType::INT64).Estimate(columns[0]);
+    ASSERT_EQ(estimates[0].encoding, EncodingType::DICTIONARY);
+    ASSERT_EQ(estimates[1].encoding, EncodingType::FOR);
+    {
+        ColumnFileWriter writer(path, {{"id", LogicalType::INT64}}, rows);
+        writer.SetAdaptiveEncoding(0);
+        writer.Append(columns);
+        writer.Finish();
+    }
+
+    ColumnFileReader reader(path);
+    EXPECT_EQ(reader.Metadata().row_groups[0].columns[0].encoding, EncodingType::FOR);
+    std::vector<Vector> out;
+    out.emplace_back(LogicalType::INT64, rows, arena);
+    reader.ReadColumns(0, {0}, out);
+    for (uint32_t i = 0; i < rows; i++) {
+        ASSERT_EQ(out[0].Data<int64_t>()[i], value(i));
+    }
+}
+
+TEST_F(ColumnFileTest, DetectsCorruptChunk) {
+    WriteTable(1000, 1000);
+    {
+        ColumnFileReader reader(path);
+        const uint64_t offset = reader.Metadata().row_groups[0].columns[0].offset;
+        File file(path, FILE_READ | FILE_WRITE);
+        const int64_t garbage = -1;
+        file.Write(&garbage, sizeof(garbage), offset + 80);
+    }
+
+    ColumnFileReader reader(path);
+    std::vector<Vector> out;
+    out.emplace_back(LogicalType::INT64, 1000, arena);
+    EXPECT_THROW(reader.ReadColumns(0, {0}, out), std::runtime_error);
+}
+
+TEST_F(ColumnFileTest, RejectsUnfinishedFile) {
+    {
+        ColumnFileWriter writer(path, {{"id", LogicalType::INT64}});
+    }
+    EXPECT_THROW(ColumnFileReader reader(path), std::runtime_error);
+}
+
+TEST_F(ColumnFileTest, MetadataRejectsTruncatedFooter) {
+    FileMetadata metadata;
+    metadata.columns = {{"a", LogicalType::INT32}};
+    metadata.row_groups.resize(1);
+    metadata.row_groups[0].row_count = 10;
+    metadata.row_groups[0].columns.resize(1);
+    metadata.row_groups[0].columns[0].stats = ZoneMap(LogicalType::INT32);
+
+    const std::vector<uint8_t> bytes = metadata.Serialize();
+    const FileMetadata decoded = FileMetadata::Deserialize(bytes.data(), bytes.size());
+    EXPECT_EQ(decoded.row_groups[0].row_count, 10u);
+    EXPECT_THROW(FileMetadata::Deserialize(bytes.data(), bytes.size() - 1), std::runtime_error);
+}
+} // namespace electricdb
\ No newline at end of file
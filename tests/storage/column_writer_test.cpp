@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "electricdb/storage/column/column_writer.h"
+#include "electricdb/util/arena.h"
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace electricdb {
+class ColumnWriterTest : public testing::Test {
+    protected:
+        /** @brief INT64 chunk of `count` rows, row i holding `value(i)` */
+        template <typename F>
+        Vector Int64Chunk(uint32_t count, F value) {
+            Vector vec(LogicalType::INT64, count, arena);
+            vec.SetSize(count);
+            for (uint32_t i = 0; i < count; i++) {
+                vec.Data<int64_t>()[i] = value(i);
+            }
+            return vec;
+        }
+
+        /** @brief Estimate of `encoding` for `chunk`, fails if there is none */
+        static EncodingEstimate Find(const std::vector<EncodingEstimate> &estimates,
+                                     EncodingType encoding) {
+            for (const auto &estimate : estimates) {
+                if (estimate.encoding == encoding) {
+                    return estimate;
+                }
+            }
+            ADD_FAILURE() << "No estimate for " << EncodingTypeName(encoding);
+            return {};
+        }
+
+        Arena arena;
+        std::mt19937_64 rng{11};
+};
+
+TEST_F(ColumnWriterTest, ChoosesRleForLongRuns) {
+    std::vector<int64_t> run_values(64);
+    for (auto &value : run_values) {
+        value = static_cast<int64_t>(rng());
+    }
+    const Vector chunk = Int64Chunk(16384, [&](uint32_t i) { return run_values[i / 256]; });
+    EXPECT_EQ(ColumnWriter(LogicalType::INT64).Choose(chunk), EncodingType::RLE);
+}
+
+TEST_F(ColumnWriterTest, ChoosesDeltaForTimestamps) {
+    const Vector chunk = Int64Chunk(16384, [&](uint32_t i) {
+        return 1700000000000000 + int64_t{1000000} * i +
+               (i % 50 == 0 ? static_cast<int64_t>(rng() % 8) : 0);
+    });
+    EXPECT_EQ(ColumnWriter(LogicalType::INT64).Choose(chunk), EncodingType::DELTA);
+}
+
+TEST_F(ColumnWriterTest, ChoosesDictionaryForFewWidelySpreadValues) {
+    std::vector<int64_t> distinct(16);
+    for (auto &value : distinct) {
+        value = static_cast<int64_t>(rng());
+    }
+    const Vector chunk = Int64Chunk(16384, [&](uint32_t) { return distinct[rng() % 16]; });
+    EXPECT_EQ(ColumnWriter(LogicalType::INT64).Choose(chunk), EncodingType::DICTIONARY);
+}
+
+TEST_F(ColumnWriterTest, ChoosesForForANarrowRange) {
+    const Vector chunk =
+            Int64Chunk(16384, [&](uint32_t) { return static_cast<int64_t>(rng() % 1000); });
+    EXPECT_EQ(ColumnWriter(LogicalType::INT64).Choose(chunk), EncodingType::FOR);
+}
+
+TEST_F(ColumnWriterTest, KeepsRandomDoublesPlain) {
+    std::uniform_real_distribution<double> uniform(-1e6, 1e6);
+    Vector chunk(LogicalType::DOUBLE, 16384, arena);
+    chunk.SetSize(16384);
+    for (uint32_t i = 0; i < 16384; i++) {
+        chunk.Data<double>()[i] = uniform(rng);
+    }
+    EXPECT_EQ(ColumnWriter(LogicalType::DOUBLE).Choose(chunk), EncodingType::PLAIN);
+}
+
+TEST_F(ColumnWriterTest, SampledSizesStayCloseToExactSizes) {
+    std::vector<int64_t> distinct(16);
+    for (auto &value : distinct) {
+        value = static_cast<int64_t>(rng());
+    }
+    const Vector timestamps = Int64Chunk(65536, [&](uint32_t i) {
+        return 1700000000000000 + int64_t{1000000} * i +
+               (i % 50 == 0 ? static_cast<int64_t>(rng() % 8) : 0);
+    });
+    const Vector categories = Int64Chunk(65536, [&](uint32_t) { return distinct[rng() % 16]; });
+
+    const ColumnWriter writer(LogicalType::INT64);
+    for (const auto &[chunk, encoding] :
+         {std::pair<const Vector *, EncodingType>{&timestamps, EncodingType::DELTA},
+          {&timestamps, EncodingType::FOR},
+          {&categories, EncodingType::DICTIONARY}}) {
+        const double exact = static_cast<double>(EncodedSize(encoding, *chunk));
+        const double sampled = static_cast<double>(Find(writer.Estimate(*chunk), encoding).size);
+        EXPECT_NEAR(sampled, exact, exact * 0.1) << EncodingTypeName(encoding);
+    }
+}
+
+TEST_F(ColumnWriterTest, EstimatesDictionariesAsEntriesPlusCodes) {
+    /** Every sampled block holds all 1000 values, so only the codes grow with the chunk */
+    std::vector<int64_t> distinct(1000);
+    for (auto &value : distinct) {
+        value = static_cast<int64_t>(rng());
+    }
+    const Vector chunk = Int64Chunk(65536, [&](uint32_t i) { return distinct[i % 1000]; });
+    const auto estimates = ColumnWriter(LogicalType::INT64).Estimate(chunk);
+    EXPECT_EQ(Find(estimates, EncodingType::DICTIONARY).size,
+              EncodedSize(EncodingType::DICTIONARY, chunk));
+}
+
+TEST_F(ColumnWriterTest, OrdersEstimatesByCost) {
+    const Vector chunk =
+            Int64Chunk(16384, [&](uint32_t) { return static_cast<int64_t>(rng() % 1000); });
+    const ColumnWriter writer(LogicalType::INT64);
+    const auto estimates = writer.Estimate(chunk);
+    ASSERT_EQ(estimates.size(), 5u);
+    for (size_t i = 1; i < estimates.size(); i++) {
+        EXPECT_LE(estimates[i - 1].Cost(writer.Policy().read_bytes_per_ns),
+                  estimates[i].Cost(writer.Policy().read_bytes_per_ns));
+    }
+    EXPECT_EQ(estimates[0].encoding, writer.Choose(chunk));
+}
+
+TEST_F(ColumnWriterTest, EstimatesSmallChunksExactly) {
+    const Vector chunk = Int64Chunk(1000, [](uint32_t i) { return int64_t{i} % 10; });
+    const auto estimates = ColumnWriter(LogicalType::INT64).Estimate(chunk);
+    for (const auto &estimate : estimates) {
+        EXPECT_EQ(estimate.size, EncodedSize(estimate.encoding, chunk))
+                << EncodingTypeName(estimate.encoding);
+    }
+    EXPECT_EQ(Find(estimates, EncodingType::PLAIN).size, 1000u * sizeof(int64_t));
+}
+
+TEST_F(ColumnWriterTest, ChoosesPlainForEmptyChunks) {
+    const Vector chunk(LogicalType::INT32, 16, arena);
+    EXPECT_EQ(ColumnWriter(LogicalType::INT32).Estimate(chunk).size(), 1u);
+    EXPECT_EQ(ColumnWriter(LogicalType::INT32).Choose(chunk), EncodingType::PLAIN);
+}
+
+TEST_F(ColumnWriterTest, RejectsMismatchedChunksAndPolicies) {
+    const Vector chunk(LogicalType::INT32, 16, arena);
+    EXPECT_THROW(ColumnWriter(LogicalType::INT64).Estimate(chunk), std::runtime_error);
+    EncodingPolicy policy;
+    policy.read_bytes_per_ns = 0;
+    EXPECT_THROW(ColumnWriter(LogicalType::INT64, policy), std::runtime_error);
+}
+} // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "electricdb/storage/encoding/delta.h"
+#include "electricdb/util/arena.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace electricdb {
+class DeltaEncodingTest : public testing::Test {
+    protected:
+        /** @brief Encode `vec` into `buffer` and return the encoded bytes */
+        const uint8_t *Encode(const Vector &vec) {
+            buffer.assign((DeltaEncoding::EncodedSize(vec) + 7) / 8, 0);
+            auto *data = reinterpret_cast<uint8_t *>(buffer.data());
+            DeltaEncoding::Encode(vec, data);
+            return data;
+        }
+
+        /**
+         * @brief `count` event timestamps in microseconds, one per second, every 50th a few
+         * microseconds late and every 13th row NULL
+         */
+        Vector Timestamps(uint32_t count) {
+            Vector vec(LogicalType::INT64, count, arena);
+            vec.SetSize(count);
+            for (uint32_t i = 0; i < count; i++) {
+                vec.Data<int64_t>()[i] = 1700000000000000 + int64_t{1000000} * i +
+                                         (i % 50 == 0 ? static_cast<int64_t>(rng() % 8) : 0);
+                if (i % 13 == 5) {
+                    vec.SetNull(i);
+                }
+            }
+            return vec;
+        }
+
+        /** @brief Decode `data` and compare every non-null row with `vec` */
+        void ExpectDecodes(const uint8_t *data, const Vector &vec) {
+            Vector out(vec.Type(), vec.Size(), arena);
+            DeltaEncoding::Decode(data, vec.Size(), out);
+            ASSERT_EQ(out.Size(), vec.Size());
+            for (uint32_t i = 0; i < vec.Size(); i++) {
+                if (vec.IsNull(i)) {
+                    continue;
+                }
+                if (vec.Type() == LogicalType::INT32) {
+                    ASSERT_EQ(out.Data<int32_t>()[i], vec.Data<int32_t>()[i]) << i;
+                } else {
+                    ASSERT_EQ(out.Data<int64_t>()[i], vec.Data<int64_t>()[i]) << i;
+                }
+            }
+        }
+
+        static Value Int64(int64_t v) {
+            Value value;
+            value.SetType(LogicalType::INT64);
+            value.Set<int64_t>(v);
+            return value;
+        }
+
+        Arena arena;
+        std::mt19937_64 rng{7};
+        /** @brief 8-byte aligned encoding buffer */
+        std::vector<uint64_t> buffer;
+};
+
+TEST_F(DeltaEncodingTest, PacksTimestampsAtAFewBits) {
+    const Vector vec = Timestamps(5000);
+    const uint8_t *data = Encode(vec);
+    EXPECT_TRUE(DeltaEncoding::Sorted(data));
+    /** The deltas differ by the jitter only, against 64 bits per value for plain */
+    EXPECT_LT(DeltaEncoding::EncodedSize(vec), 5000u * sizeof(int64_t) / 10);
+    EXPECT_TRUE(DeltaEncoding::CheckSize(data, DeltaEncoding::EncodedSize(vec),
+                                         LogicalType::INT64, 5000));
+    EXPECT_FALSE(DeltaEncoding::CheckSize(data, DeltaEncoding::EncodedSize(vec),
+                                          LogicalType::INT32, 5000));
+    EXPECT_FALSE(DeltaEncoding::CheckSize(data, DeltaEncoding::EncodedSize(vec),
+                                          LogicalType::INT64, 6000));
+    ExpectDecodes(data, vec);
+}
+
+TEST_F(DeltaEncodingTest, PacksSteadilyGrowingDeltasAsDeltaOfDeltas) {
+    /** Deltas of 3 * i: all delta-of-deltas are 3 and pack at 0 bits */
+    Vector vec(LogicalType::INT64, 4000, arena);
+    vec.SetSize(4000);
+    for (uint32_t i = 0; i < 4000; i++) {
+        vec.Data<int64_t>()[i] = 3 * (int64_t{i} * (i + 1) / 2);
+    }
+    EXPECT_EQ(DeltaEncoding::BestOrder(vec), 2);
+    const uint8_t *data = Encode(vec);
+    EXPECT_EQ(DeltaEncoding::Order(data), 2);
+    EXPECT_LT(DeltaEncoding::EncodedSize(vec), 200u);
+    ExpectDecodes(data, vec);
+}
+
+TEST_F(DeltaEncodingTest, PacksIrregularDeltasAtFirstOrder) {
+    Vector vec(LogicalType::INT64, 3000, arena);
+    vec.SetSize(3000);
+    int64_t value = -5000;
+    for (uint32_t i = 0; i < 3000; i++) {
+        value += static_cast<int64_t>(rng() % 1000);
+        vec.Data<int64_t>()[i] = value;
+    }
+    EXPECT_EQ(DeltaEncoding::BestOrder(vec), 1);
+    const uint8_t *data = Encode(vec);
+    EXPECT_EQ(DeltaEncoding::Order(data), 1);
+    EXPECT_LT(DeltaEncoding::EncodedSize(vec), 3000u * 2);
+    ExpectDecodes(data, vec);
+}
+
+TEST_F(DeltaEncodingTest, RoundTripsExtremeValues) {
+    Vector ints(LogicalType::INT32, 2100, arena);
+    Vector longs(LogicalType::INT64, 2100, arena);
+    ints.SetSize(2100);
+    longs.SetSize(2100);
+    for (uint32_t i = 0; i < 2100; i++) {
+        ints.Data<int32_t>()[i] = i % 2 ? std::numeric_limits<int32_t>::max()
+                                        : std::numeric_limits<int32_t>::min();
+        longs.Data<int64_t>()[i] = i % 3 ? std::numeric_limits<int64_t>::max()
+                                         : std::numeric_limits<int64_t>::min() + i;
+    }
+    /** Leading NULL rows take the first value */
+    ints.SetNull(0);
+    ints.SetNull(1);
+    ExpectDecodes(Encode(ints), ints);
+    EXPECT_FALSE(DeltaEncoding::Sorted(reinterpret_cast<uint8_t *>(buffer.data())));
+    ExpectDecodes(Encode(longs), longs);
+}
+
+TEST_F(DeltaEncodingTest, DecodesFromTheMiddleOfAChunk) {
+    const Vector vec = Timestamps(5000);
+    const uint8_t *data = Encode(vec);
+
+    Vector out(LogicalType::INT64, 5000, arena);
+    for (auto [begin, end] : {std::pair<uint32_t, uint32_t>{0, 1}, {1000, 1030}, {1023, 1025},
+                              {2047, 4500}, {4999, 5000}, {3000, 3000}}) {
+        DeltaEncoding::DecodeRange(data, 5000, begin, end, out);
+        ASSERT_EQ(out.Size(), end - begin);
+        for (uint32_t row = begin; row < end; row++) {
+            if (!vec.IsNull(row)) {
+                ASSERT_EQ(out.Data<int64_t>()[row - begin], vec.Data<int64_t>()[row]) << row;
+            }
+        }
+    }
+}
+
+TEST_F(DeltaEncodingTest, PrefixSumWraps) {
+    for (uint32_t count : {0u, 1u, 3u, 4u, 7u, 1024u}) {
+        std::vector<uint64_t> values(count);
+        std::vector<uint64_t> expected(count);
+        uint64_t total = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            values[i] = rng();
+            total += values[i];
+            expected[i] = total;
+        }
+        DeltaEncoding::PrefixSum(values.data(), count);
+        EXPECT_EQ(values, expected);
+    }
+}
+
+TEST_F(DeltaEncodingTest, SelectsOnlyFromPagesThatMayQualify) {
+    const Vector vec = Timestamps(5000);
+    const uint8_t *data = Encode(vec);
+    std::vector<uint8_t> nulls((5000 + 7) / 8, 0);
+    for (uint32_t i = 0; i < 5000; i++) {
+        if (vec.IsNull(i)) {
+            nulls[i / 8] |= static_cast<uint8_t>(1U << (i % 8));
+        }
+    }
+
+    SelectionVector sel(arena, 5000);
+    const int64_t start = 1700000000000000;
+    const ColumnPredicate range = ColumnPredicate::Range(Int64(start + int64_t{1000000} * 1500),
+                                                         Int64(start + int64_t{1000000} * 2600));
+    const idx_t selected =
+            DeltaEncoding::Select(data, LogicalType::INT64, 5000, range, nulls.data(), sel);
+    std::vector<idx_t> expected;
+    for (uint32_t i = 0; i < 5000; i++) {
+        if (!vec.IsNull(i) && range.Matches(vec.Data<int64_t>()[i])) {
+            expected.push_back(i);
+        }
+    }
+    ASSERT_EQ(selected, expected.size());
+    for (idx_t i = 0; i < selected; i++) {
+        ASSERT_EQ(sel.Get(i), expected[i]);
+    }
+
+    EXPECT_EQ(DeltaEncoding::Select(data, LogicalType::INT64, 5000,
+                                    ColumnPredicate::Equal(Int64(start - 1)), nulls.data(), sel),
+              0u);
+    EXPECT_THROW(DeltaEncoding::Select(data, LogicalType::INT32, 5000, range, nullptr, sel),
+                 std::runtime_error);
+}
+} // namespace electricdb
\ No newline at end of file
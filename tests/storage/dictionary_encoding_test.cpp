@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "electricdb/storage/encoding/dictionary.h"
+#include "electricdb/storage/encoding/for.h"
+#include "electricdb/util/arena.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace electricdb {
+class DictionaryEncodingTest : public testing::Test {
+    protected:
+        /** @brief Encode `vec` into `buffer` and return the encoded bytes */
+        const uint8_t *Encode(const Vector &vec) {
+            buffer.assign((DictionaryEncoding::EncodedSize(vec) + 7) / 8, 0);
+            auto *data = reinterpret_cast<uint8_t *>(buffer.data());
+            DictionaryEncoding::Encode(vec, data);
+            return data;
+        }
+
+        /** @brief `count` status codes out of `distinct` values, every 9th row NULL */
+        Vector StatusValues(uint32_t count, int64_t distinct) {
+            Vector vec(LogicalType::INT64, count, arena);
+            vec.SetSize(count);
+            for (uint32_t i = 0; i < count; i++) {
+                vec.Data<int64_t>()[i] = 100 * static_cast<int64_t>(rng() % distinct) - 1000;
+                if (i % 9 == 0) {
+                    vec.SetNull(i);
+                }
+            }
+            return vec;
+        }
+
+        static Value Int64(int64_t v) {
+            Value value;
+            value.SetType(LogicalType::INT64);
+            value.Set<int64_t>(v);
+            return value;
+        }
+
+        /** @brief Rows of `vec` that satisfy `predicate`, the slow way */
+        static std::vector<idx_t> Expected(const Vector &vec, const ColumnPredicate &predicate) {
+            std::vector<idx_t> rows;
+            for (uint32_t i = 0; i < vec.Size(); i++) {
+                if (!vec.IsNull(i) && predicate.Matches(vec.Data<int64_t>()[i])) {
+                    rows.push_back(i);
+                }
+            }
+            return rows;
+        }
+
+        Arena arena;
+        std::mt19937_64 rng{7};
+        /** @brief 8-byte aligned encoding buffer */
+        std::vector<uint64_t> buffer;
+};
+
+TEST_F(DictionaryEncodingTest, RoundTripsLowCardinalityColumns) {
+    const Vector vec = StatusValues(5000, 60);
+    EXPECT_EQ(DictionaryEncoding::DistinctCount(vec), 60u);
+    const uint8_t *data = Encode(vec);
+    EXPECT_EQ(DictionaryEncoding::EntryCount(data), 60u);
+    EXPECT_TRUE(DictionaryEncoding::CheckSize(data, DictionaryEncoding::EncodedSize(vec),
+                                              LogicalType::INT64, 5000));
+
+    Vector out(LogicalType::INT64, 5000, arena);
+    DictionaryEncoding::Decode(data, 5000, out);
+    ASSERT_EQ(out.Size(), 5000u);
+    for (uint32_t i = 0; i < vec.Size(); i++) {
+        if (!vec.IsNull(i)) {
+            ASSERT_EQ(out.Data<int64_t>()[i], vec.Data<int64_t>()[i]);
+        }
+    }
+}
+
+TEST_F(DictionaryEncodingTest, PacksCodesAtTheWidthOfTheDictionary) {
+    const Vector vec = StatusValues(2048, 100);
+    /** Header, 100 entries of 8 bytes, then codes of 7 bits behind their own header */
+    EXPECT_EQ(DictionaryEncoding::EncodedSize(vec),
+              DictionaryEncoding::HEADER_SIZE + 800u + ForEncoding::EncodedSize(2048, 7));
+}
+
+TEST_F(DictionaryEncodingTest, KeepsDistinctFloatBitPatterns) {
+    Vector vec(LogicalType::DOUBLE, 6, arena);
+    vec.SetSize(6);
+    const double values[] = {0.0, -0.0, -2.5, 1e300, -2.5, -1e300};
+    for (uint32_t i = 0; i < 6; i++) {
+        vec.Data<double>()[i] = values[i];
+    }
+    EXPECT_EQ(DictionaryEncoding::DistinctCount(vec), 5u);
+    const uint8_t *data = Encode(vec);
+
+    Vector out(LogicalType::DOUBLE, 6, arena);
+    DictionaryEncoding::Decode(data, 6, out);
+    for (uint32_t i = 0; i < 6; i++) {
+        EXPECT_EQ(out.Data<double>()[i], values[i]);
+        EXPECT_EQ(std::signbit(out.Data<double>()[i]), std::signbit(values[i]));
+    }
+
+    /** Sorted entries: a range of values is a range of codes */
+    const CodeSet codes = DictionaryEncoding::QualifyingCodes(
+            data, LogicalType::DOUBLE, ColumnPredicate::Range(Value(), Value()));
+    EXPECT_TRUE(codes.All());
+}
+
+TEST_F(DictionaryEncodingTest, SelectsRowsOnCodes) {
+    const Vector vec = StatusValues(3000, 40);
+    const uint8_t *data = Encode(vec);
+    const ColumnPredicate predicates[] = {
+            ColumnPredicate::Equal(Int64(-700)),
+            ColumnPredicate::In({Int64(-1000), Int64(500), Int64(12345)}),
+            ColumnPredicate::Range(Int64(-300), Int64(1200)),
+            ColumnPredicate::Range(Value(), Int64(-800)),
+            ColumnPredicate::Equal(Int64(-650)),
+    };
+
+    SelectionVector sel(arena, 3000);
+    for (const ColumnPredicate &predicate : predicates) {
+        const CodeSet codes = DictionaryEncoding::QualifyingCodes(data, LogicalType::INT64,
+                                                                  predicate);
+        const idx_t count = DictionaryEncoding::Select(data, 3000, codes, nullptr, sel);
+        const std::vector<idx_t> expected = Expected(vec, predicate);
+
+        /** Without the bitmap, null rows (code 0) count as the first entry */
+        std::vector<idx_t> rows;
+        for (idx_t i = 0; i < count; i++) {
+            if (!vec.IsNull(sel.Get(i))) {
+                rows.push_back(sel.Get(i));
+            }
+        }
+        EXPECT_EQ(rows, expected);
+    }
+
+    /** With the bitmap the nulls drop out */
+    std::vector<uint8_t> nulls(3000 / 8 + 1, 0);
+    for (uint32_t i = 0; i < 3000; i++) {
+        if (vec.IsNull(i)) {
+            nulls[i / 8] |= static_cast<uint8_t>(1U << (i % 8));
+        }
+    }
+    const ColumnPredicate all = ColumnPredicate::Range(Value(), Value());
+    const CodeSet codes = DictionaryEncoding::QualifyingCodes(data, LogicalType::INT64, all);
+    EXPECT_EQ(DictionaryEncoding::Select(data, 3000, codes, nulls.data(), sel),
+              Expected(vec, all).size());
+}
+
+TEST_F(DictionaryEncodingTest, RefusesTooManyDistinctValues) {
+    Vector vec(LogicalType::INT32, DictionaryEncoding::MAX_ENTRIES + 10, arena);
+    vec.SetSize(vec.Capacity());
+    for (uint32_t i = 0; i < vec.Size(); i++) {
+        vec.Data<int32_t>()[i] = static_cast<int32_t>(i);
+    }
+    EXPECT_FALSE(DictionaryEncoding::CanEncode(vec));
+    EXPECT_FALSE(CanEncode(EncodingType::DICTIONARY, vec));
+    EXPECT_TRUE(CanEncode(EncodingType::PLAIN, vec));
+
+    vec.SetSize(1000);
+    EXPECT_TRUE(DictionaryEncoding::CanEncode(vec));
+    const uint8_t *data = Encode(vec);
+    const size_t size = DictionaryEncoding::EncodedSize(vec);
+    EXPECT_FALSE(DictionaryEncoding::CheckSize(data, size - 8, LogicalType::INT32, 1000));
+    EXPECT_FALSE(DictionaryEncoding::CheckSize(data, size, LogicalType::INT64, 1000));
+}
+} // namespace electricdb
\ No newline at end of file
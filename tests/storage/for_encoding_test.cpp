@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "electricdb/storage/encoding/for.h"
+#include "electricdb/util/arena.h"
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace electricdb {
+class ForEncodingTest : public testing::Test {
+    protected:
+        /** @brief Encode `vec` and decode it again */
+        Vector RoundTrip(const Vector &vec) {
+            buffer.assign((ForEncoding::EncodedSize(vec) + 7) / 8, 0);
+            auto *data = reinterpret_cast<uint8_t *>(buffer.data());
+            ForEncoding::Encode(vec, data);
+            Vector out(vec.Type(), vec.Size(), arena);
+            ForEncoding::Decode(data, vec.Size(), out);
+            return out;
+        }
+
+        /** @brief `count` values `base + r` with r below 2^width (any 64-bit value if 64) */
+        Vector Int64Values(uint32_t count, int64_t base, unsigned width) {
+            Vector vec(LogicalType::INT64, count, arena);
+            vec.SetSize(count);
+            for (uint32_t i = 0; i < count; i++) {
+                uint64_t offset = rng();
+                if (width < 64) {
+                    offset &= (uint64_t{1} << width) - 1;
+                }
+                vec.Data<int64_t>()[i] = static_cast<int64_t>(static_cast<uint64_t>(base) + offset);
+            }
+            return vec;
+        }
+
+        Arena arena;
+        std::mt19937_64 rng{42};
+        /** @brief 8-byte aligned encoding buffer */
+        std::vector<uint64_t> buffer;
+};
+
+TEST_F(ForEncodingTest, RoundTripsInt64AtEveryWidth) {
+    for (unsigned width = 0; width <= 64; width++) {
+        const Vector vec = Int64Values(3000, -123456789, width);
+        EXPECT_LE(ForEncoding::BitWidth(vec), width);
+        const Vector out = RoundTrip(vec);
+        ASSERT_EQ(out.Size(), vec.Size());
+        for (uint32_t i = 0; i < vec.Size(); i++) {
+            ASSERT_EQ(out.Data<int64_t>()[i], vec.Data<int64_t>()[i]) << "width " << width;
+        }
+    }
+}
+
+TEST_F(ForEncodingTest, RoundTripsInt32AtEveryWidth) {
+    for (unsigned width = 0; width <= 32; width++) {
+        Vector vec(LogicalType::INT32, 2500, arena);
+        vec.SetSize(2500);
+        for (uint32_t i = 0; i < vec.Size(); i++) {
+            const uint32_t offset =
+                    width == 32 ? static_cast<uint32_t>(rng())
+                                : static_cast<uint32_t>(rng()) & ((uint32_t{1} << width) - 1);
+            vec.Data<int32_t>()[i] = static_cast<int32_t>(uint32_t{0x80000000U} + offset);
+        }
+        const Vector out = RoundTrip(vec);
+        for (uint32_t i = 0; i < vec.Size(); i++) {
+            ASSERT_EQ(out.Data<int32_t>()[i], vec.Data<int32_t>()[i]) << "width " << width;
+        }
+    }
+}
+
+TEST_F(ForEncodingTest, PacksAtTheWidthOfTheRange) {
+    Vector vec(LogicalType::INT64, 2048, arena);
+    vec.SetSize(2048);
+    for (uint32_t i = 0; i < vec.Size(); i++) {
+        vec.Data<int64_t>()[i] = 1000000 + (i % 200);
+    }
+    EXPECT_EQ(ForEncoding::BitWidth(vec), 8);
+    /** Two blocks of 1024 one-byte offsets */
+    EXPECT_EQ(ForEncoding::EncodedSize(vec), ForEncoding::HEADER_SIZE + 2048u);
+
+    vec.Data<int64_t>()[5] = INT64_MAX;
+    vec.SetNull(5);
+    EXPECT_EQ(ForEncoding::BitWidth(vec), 8);
+    const Vector out = RoundTrip(vec);
+    EXPECT_EQ(out.Data<int64_t>()[2047], 1000000 + 2047 % 200);
+}
+
+TEST_F(ForEncodingTest, DecodesOnlySelectedRows) {
+    const Vector vec = Int64Values(5000, 77, 13);
+    buffer.assign((ForEncoding::EncodedSize(vec) + 7) / 8, 0);
+    auto *data = reinterpret_cast<uint8_t *>(buffer.data());
+    ForEncoding::Encode(vec, data);
+
+    SelectionVector sel(arena, 6);
+    const idx_t rows[] = {0, 31, 1023, 1024, 2500, 4999};
+    for (idx_t i = 0; i < 6; i++) {
+        sel.Set(i, rows[i]);
+    }
+    Vector out(LogicalType::INT64, 6, arena);
+    ForEncoding::DecodeSelected(data, sel, 6, out);
+    ASSERT_EQ(out.Size(), 6u);
+    for (idx_t i = 0; i < 6; i++) {
+        EXPECT_EQ(out.Data<int64_t>()[i], vec.Data<int64_t>()[rows[i]]);
+    }
+}
+
+TEST_F(ForEncodingTest, RejectsUnsupportedTypes) {
+    Vector vec(LogicalType::DOUBLE, 4, arena);
+    vec.SetSize(4);
+    EXPECT_FALSE(ForEncoding::Supports(LogicalType::DOUBLE));
+    EXPECT_THROW(ForEncoding::BitWidth(vec), std::runtime_error);
+}
+} // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "electricdb/storage/encoding/rle.h"
+#include "electricdb/util/arena.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace electricdb {
+class RleEncodingTest : public testing::Test {
+    protected:
+        /** @brief Encode `vec` into `buffer` and return the encoded bytes */
+        const uint8_t *Encode(const Vector &vec) {
+            buffer.assign((RleEncoding::EncodedSize(vec) + 7) / 8, 0);
+            auto *data = reinterpret_cast<uint8_t *>(buffer.data());
+            RleEncoding::Encode(vec, data);
+            return data;
+        }
+
+        /**
+         * @brief `count` sorted tenant ids, tenant t owning 100 + t rows, and rows [50, 60) NULL
+         * in between
+         */
+        Vector TenantIds(uint32_t count) {
+            Vector vec(LogicalType::INT32, count, arena);
+            vec.SetSize(count);
+            int32_t tenant = 0;
+            uint32_t left = 100;
+            for (uint32_t i = 0; i < count; i++) {
+                vec.Data<int32_t>()[i] = tenant;
+                if (--left == 0) {
+                    tenant++;
+                    left = 100 + tenant;
+                }
+                if (i >= 50 && i < 60) {
+                    vec.SetNull(i);
+                }
+            }
+            return vec;
+        }
+
+        static Value Int32(int32_t v) {
+            Value value;
+            value.SetType(LogicalType::INT32);
+            value.Set<int32_t>(v);
+            return value;
+        }
+
+        /** @brief Null bitmap of `vec` as stored next to the encoded values */
+        static std::vector<uint8_t> Nulls(const Vector &vec) {
+            std::vector<uint8_t> nulls((vec.Size() + 7) / 8, 0);
+            for (uint32_t i = 0; i < vec.Size(); i++) {
+                if (vec.IsNull(i)) {
+                    nulls[i / 8] |= static_cast<uint8_t>(1U << (i % 8));
+                }
+            }
+            return nulls;
+        }
+
+        Arena arena;
+        /** @brief 8-byte aligned encoding buffer */
+        std::vector<uint64_t> buffer;
+};
+
+TEST_F(RleEncodingTest, RoundTripsRunsWithNulls) {
+    const Vector vec = TenantIds(5000);
+    /** Tenant 0 is split by its NULL rows into three runs */
+    const uint32_t runs = RleEncoding::RunCount(vec);
+    EXPECT_EQ(runs, vec.Data<int32_t>()[4999] + 3u);
+    const uint8_t *data = Encode(vec);
+    EXPECT_EQ(RleEncoding::RunCount(data), runs);
+    EXPECT_EQ(RleEncoding::EncodedSize(vec),
+              RleEncoding::HEADER_SIZE + (runs * 4 + 7) / 8 * 8 + runs * 4);
+    EXPECT_TRUE(RleEncoding::CheckSize(data, RleEncoding::EncodedSize(vec), LogicalType::INT32,
+                                       5000));
+    EXPECT_FALSE(RleEncoding::CheckSize(data, RleEncoding::EncodedSize(vec), LogicalType::INT32,
+                                        4999));
+    EXPECT_FALSE(RleEncoding::CheckSize(data, RleEncoding::EncodedSize(vec), LogicalType::INT64,
+                                        5000));
+
+    Vector out(LogicalType::INT32, 5000, arena);
+    RleEncoding::Decode(data, 5000, out);
+    ASSERT_EQ(out.Size(), 5000u);
+    for (uint32_t i = 0; i < vec.Size(); i++) {
+        if (!vec.IsNull(i)) {
+            ASSERT_EQ(out.Data<int32_t>()[i], vec.Data<int32_t>()[i]);
+        }
+    }
+}
+
+TEST_F(RleEncodingTest, DecodesRunsAndFindsTheRunOfARow) {
+    const Vector vec = TenantIds(1000);
+    const uint8_t *data = Encode(vec);
+
+    Vector values(LogicalType::INT32, 1000, arena);
+    std::vector<uint32_t> lengths(1000);
+    RleEncoding::DecodeRuns(data, values, lengths.data());
+    ASSERT_EQ(values.Size(), RleEncoding::RunCount(data));
+    EXPECT_EQ(lengths[0], 50u);
+    EXPECT_EQ(lengths[1], 10u);
+    EXPECT_EQ(lengths[2], 40u);
+    EXPECT_EQ(values.Data<int32_t>()[1], 0);
+    EXPECT_EQ(values.Data<int32_t>()[3], 1);
+    EXPECT_EQ(lengths[3], 101u);
+
+    uint32_t row = 0;
+    for (uint32_t r = 0; r < values.Size(); r++) {
+        EXPECT_EQ(RleEncoding::FindRun(data, row), r);
+        EXPECT_EQ(RleEncoding::FindRun(data, row + lengths[r] - 1), r);
+        row += lengths[r];
+    }
+    EXPECT_EQ(row, 1000u);
+}
+
+TEST_F(RleEncodingTest, SelectsWholeRuns) {
+    const Vector vec = TenantIds(5000);
+    const uint8_t *data = Encode(vec);
+    const std::vector<uint8_t> nulls = Nulls(vec);
+    SelectionVector sel(arena, 5000);
+
+    /** Tenants 3 to 5 own rows [100 + 101 + 102, 100 + ... + 105) */
+    const ColumnPredicate tenants = ColumnPredicate::Range(Int32(3), Int32(5));
+    const idx_t selected =
+            RleEncoding::Select(data, LogicalType::INT32, tenants, nulls.data(), sel);
+    ASSERT_EQ(selected, 103u + 104u + 105u);
+    for (idx_t i = 0; i < selected; i++) {
+        ASSERT_EQ(sel.Get(i), 303 + i);
+    }
+
+    /** NULL rows hold 0 but never qualify */
+    EXPECT_EQ(RleEncoding::Select(data, LogicalType::INT32, ColumnPredicate::Equal(Int32(0)),
+                                  nulls.data(), sel),
+              90u);
+    EXPECT_EQ(sel.Get(49), 49u);
+    EXPECT_EQ(sel.Get(50), 60u);
+    EXPECT_EQ(RleEncoding::Select(data, LogicalType::INT32, ColumnPredicate::Equal(Int32(0)),
+                                  nullptr, sel),
+              100u);
+    EXPECT_EQ(RleEncoding::Select(data, LogicalType::INT32, ColumnPredicate::Equal(Int32(-1)),
+                                  nulls.data(), sel),
+              0u);
+}
+
+TEST_F(RleEncodingTest, KeepsSignedZerosApart) {
+    Vector vec(LogicalType::DOUBLE, 4, arena);
+    vec.SetSize(4);
+    vec.Data<double>()[0] = 0.0;
+    vec.Data<double>()[1] = -0.0;
+    vec.Data<double>()[2] = -0.0;
+    vec.Data<double>()[3] = 1.5;
+    EXPECT_EQ(RleEncoding::RunCount(vec), 3u);
+
+    Vector out(LogicalType::DOUBLE, 4, arena);
+    RleEncoding::Decode(Encode(vec), 4, out);
+    EXPECT_FALSE(std::signbit(out.Data<double>()[0]));
+    EXPECT_TRUE(std::signbit(out.Data<double>()[2]));
+    EXPECT_EQ(out.Data<double>()[3], 1.5);
+}
+
+TEST_F(RleEncodingTest, RejectsEmptyRuns) {
+    const Vector vec = TenantIds(1000);
+    const size_t size = RleEncoding::EncodedSize(vec);
+    const uint8_t *data = Encode(vec);
+    ASSERT_TRUE(RleEncoding::CheckSize(data, size, LogicalType::INT32, 1000));
+
+    /** The second run ends where the first one does */
+    auto *ends = reinterpret_cast<uint8_t *>(buffer.data()) + size -
+                 RleEncoding::RunCount(data) * sizeof(uint32_t);
+    std::memcpy(ends + sizeof(uint32_t), ends, sizeof(uint32_t));
+    EXPECT_FALSE(RleEncoding::CheckSize(data, size, LogicalType::INT32, 1000));
+}
+} // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "electricdb/storage/column/zone_map.h"
+#include "electricdb/util/arena.h"
+
+#include <cmath>
+#include <limits>
+
+namespace electricdb {
+class ZoneMapTest : public testing::Test {
+    protected:
+        Arena arena;
+};
+
+TEST_F(ZoneMapTest, EmptyZoneHasNoValues) {
+    ZoneMap zone(LogicalType::INT32);
+    EXPECT_FALSE(zone.HasValues());
+    EXPECT_FALSE(zone.has_nulls);
+    EXPECT_EQ(zone.count, 0u);
+}
+
+TEST_F(ZoneMapTest, UpdateTracksMinMaxAndNulls) {
+    Vector vec(LogicalType::INT64, 5, arena);
+    vec.SetSize(5);
+    int64_t values[] = {7, -3, 100, 42, -50};
+    for (int i = 0; i < 5; i++) {
+        vec.Data<int64_t>()[i] = values[i];
+    }
+    vec.SetNull(4);
+
+    ZoneMap zone(LogicalType::INT64);
+    zone.Update(vec);
+
+    ASSERT_TRUE(zone.HasValues());
+    EXPECT_EQ(zone.min.Get<int64_t>(), -3);
+    EXPECT_EQ(zone.max.Get<int64_t>(), 100);
+    EXPECT_TRUE(zone.has_nulls);
+    EXPECT_EQ(zone.count, 5u);
+}
+
+TEST_F(ZoneMapTest, MergeWidensRange) {
+    Vector a(LogicalType::DOUBLE, 2, arena);
+    Vector b(LogicalType::DOUBLE, 2, arena);
+    a.SetSize(2);
+    b.SetSize(2);
+    a.Data<double>()[0] = 1.5;
+    a.Data<double>()[1] = 2.5;
+    b.Data<double>()[0] = -1.0;
+    b.Data<double>()[1] = 0.5;
+
+    ZoneMap left(LogicalType::DOUBLE);
+    ZoneMap right(LogicalType::DOUBLE);
+    ZoneMap empty(LogicalType::DOUBLE);
+    left.Update(a);
+    right.Update(b);
+
+    empty.Merge(left);
+    EXPECT_EQ(empty.min.Get<double>(), 1.5);
+
+    left.Merge(right);
+    EXPECT_EQ(left.min.Get<double>(), -1.0);
+    EXPECT_EQ(left.max.Get<double>(), 2.5);
+    EXPECT_EQ(left.count, 4u);
+}
+
+TEST_F(ZoneMapTest, NanIsKeptOutOfMinMax) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    Vector vec(LogicalType::DOUBLE, 3, arena);
+    vec.SetSize(3);
+    vec.Data<double>()[0] = nan;
+    vec.Data<double>()[1] = 3.0;
+    vec.Data<double>()[2] = -1.0;
+
+    ZoneMap zone(LogicalType::DOUBLE);
+    zone.Update(vec);
+    ASSERT_TRUE(zone.HasValues());
+    EXPECT_EQ(zone.min.Get<double>(), -1.0);
+    EXPECT_EQ(zone.max.Get<double>(), 3.0);
+    EXPECT_TRUE(zone.has_nan);
+
+    Vector only_nan(LogicalType::FLOAT, 2, arena);
+    only_nan.SetSize(2);
+    only_nan.Data<float>()[0] = std::numeric_limits<float>::quiet_NaN();
+    only_nan.Data<float>()[1] = std::numeric_limits<float>::quiet_NaN();
+    ZoneMap nan_zone(LogicalType::FLOAT);
+    nan_zone.Update(only_nan);
+    EXPECT_FALSE(nan_zone.HasValues());
+    EXPECT_TRUE(nan_zone.has_nan);
+
+    ZoneMap merged(LogicalType::FLOAT);
+    merged.Merge(nan_zone);
+    EXPECT_TRUE(merged.has_nan);
+}
+
+TEST_F(ZoneMapTest, NegativeZeroIsStoredAsZero) {
+    Vector vec(LogicalType::DOUBLE, 3, arena);
+    vec.SetSize(1);
+    vec.Data<double>()[0] = -0.0;
+
+    ZoneMap zone(LogicalType::DOUBLE);
+    zone.Update(vec);
+    EXPECT_EQ(zone.min.Get<double>(), 0.0);
+    EXPECT_FALSE(std::signbit(zone.min.Get<double>()));
+    EXPECT_FALSE(std::signbit(zone.max.Get<double>()));
+
+    vec.SetSize(3);
+    vec.Data<double>()[0] = 0.0;
+    vec.Data<double>()[1] = -0.0;
+    vec.Data<double>()[2] = -1.0;
+    ZoneMap mixed(LogicalType::DOUBLE);
+    mixed.Update(vec);
+    EXPECT_EQ(mixed.min.Get<double>(), -1.0);
+    EXPECT_EQ(mixed.max.Get<double>(), 0.0);
+    EXPECT_FALSE(std::signbit(mixed.max.Get<double>()));
+}
+} // namespace electricdb
\ No newline at end of file
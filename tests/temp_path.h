@@ -0,0 +1,28 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace electricdb {
+
+/**
+ * @brief Path of a temporary file named after the running test, removed if it already exists
+ *
+ * ctest runs the tests of one binary in parallel, so every test needs a path of its own.
+ *
+ * @param extension Appended to the name, e.g. ".edb"
+ */
+inline std::string TempPath(const std::string &extension = ".bin") {
+    const auto *info = testing::UnitTest::GetInstance()->current_test_info();
+    std::string name = std::string(info->test_suite_name()) + "_" + info->name();
+    /** Parameterized tests are named Prefix/Suite.Test/Param */
+    std::replace(name.begin(), name.end(), '/', '_');
+    const std::string path = testing::TempDir() + "electricdb_" + name + extension;
+    std::remove(path.c_str());
+    return path;
+}
+
+} // namespace electricdb
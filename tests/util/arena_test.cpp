@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "electricdb/util/arena.h"
 
+#include <cstring>
+
 namespace electricdb {
 class ArenaTest : public testing::Test {
     protected:
@@ -19,4 +21,20 @@ TEST_F(ArenaTest, AllocateTest) {
     EXPECT_GE(arena.bytes_used(), (num_ints + 1) * sizeof(int));
     EXPECT_GE(arena.bytes_reserved(), 1 << 21);
 }
+
+TEST_F(ArenaTest, OversizedAllocationsDoNotOverlap) {
+    const size_t size = 3 << 20;
+    uint8_t *first = reinterpret_cast<uint8_t *>(arena.Allocate(size, 8));
+    uint8_t *second = reinterpret_cast<uint8_t *>(arena.Allocate(size, 8));
+    uint8_t *third = reinterpret_cast<uint8_t *>(arena.Allocate(16, 8));
+
+    EXPECT_TRUE(first + size <= second || second + size <= first);
+    EXPECT_TRUE(third + 16 <= second || second + size <= third);
+    EXPECT_TRUE(third + 16 <= first || first + size <= third);
+    std::memset(first, 1, size);
+    std::memset(second, 2, size);
+    std::memset(third, 3, 16);
+    EXPECT_EQ(first[size - 1], 1);
+    EXPECT_EQ(second[0], 2);
+}
 } // namespace electricdb
\ No newline at end of file
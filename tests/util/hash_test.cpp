@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include "electricdb/util/hash.h"
+
+#include <cstring>
+#include <vector>
+
+namespace electricdb {
+class HashTest : public testing::Test {};
+
+TEST_F(HashTest, Crc32cMatchesKnownValues) {
+    const char *check = "123456789";
+    EXPECT_EQ(Hash::crc32c(check, std::strlen(check)), 0xe3069283u);
+    EXPECT_EQ(Hash::crc32c(nullptr, 0), 0u);
+
+    std::vector<uint8_t> zeros(32, 0);
+    EXPECT_EQ(Hash::crc32c(zeros.data(), zeros.size()), 0x8a9136aau);
+}
+
+TEST_F(HashTest, Crc32cCanBeComputedInPieces) {
+    std::vector<uint8_t> data(1001);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 31);
+    }
+    const uint32_t whole = Hash::crc32c(data.data(), data.size());
+    const uint32_t head = Hash::crc32c(data.data(), 333);
+    EXPECT_EQ(Hash::crc32c(data.data() + 333, data.size() - 333, head), whole);
+}
+} // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "electricdb/util/stopwatch.h"
+
+#include <chrono>
+#include <thread>
+
+namespace electricdb {
+class StopwatchTest : public testing::Test {};
+
+TEST_F(StopwatchTest, AccumulatesIntervals) {
+    Stopwatch watch;
+    EXPECT_FALSE(watch.running());
+    EXPECT_EQ(watch.elapsed_ns(), 0u);
+
+    watch.start();
+    EXPECT_TRUE(watch.running());
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    watch.stop();
+    const uint64_t first = watch.elapsed_ns();
+    EXPECT_GE(first, 5000000u);
+
+    /** Time between stop() and start() is not counted */
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(watch.elapsed_ns(), first);
+
+    watch.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    watch.stop();
+    EXPECT_GE(watch.elapsed_ns(), first + 5000000u);
+    EXPECT_LT(watch.elapsed_ms(), 20.0 + 10.0 + 1000.0);
+    EXPECT_DOUBLE_EQ(watch.elapsed_sec() * 1e3, watch.elapsed_ms());
+
+    watch.reset();
+    EXPECT_EQ(watch.elapsed_ns(), 0u);
+}
+
+TEST_F(StopwatchTest, ThreadCpuTimeExcludesSleep) {
+    Stopwatch cpu(StopwatchClock::THREAD_CPU);
+    Stopwatch wall;
+    cpu.start();
+    wall.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    volatile uint64_t sink = 0;
+    for (uint64_t i = 0; i < 1000000; i++) {
+        sink = sink + i;
+    }
+    cpu.stop();
+    wall.stop();
+
+    EXPECT_GT(cpu.elapsed_ns(), 0u);
+    EXPECT_LT(cpu.elapsed_ns(), wall.elapsed_ns());
+    EXPECT_GE(wall.elapsed_ns(), 30000000u);
+}
+} // namespace electricdb
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "electricdb/util/trace.h"
+
+#include <cstring>
+#include <thread>
+
+namespace electricdb {
+class TraceTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        Tracer::Clear();
+        Tracer::Enable();
+    }
+
+    void TearDown() override {
+        Tracer::Disable();
+        Tracer::Clear();
+    }
+
+    static size_t CountNamed(const char *name) {
+        size_t count = 0;
+        for (const auto &event : Tracer::Events()) {
+            count += std::strcmp(event.name, name) == 0 ? 1 : 0;
+        }
+        return count;
+    }
+};
+
+TEST_F(TraceTest, RecordsOnlyWhileEnabled) {
+    { TraceScope scope("test", "enabled", 1); }
+    Tracer::Disable();
+    { TraceScope scope("test", "disabled", 2); }
+    Tracer::Enable();
+
+    EXPECT_EQ(CountNamed("enabled"), 1u);
+    EXPECT_EQ(CountNamed("disabled"), 0u);
+}
+
+TEST_F(TraceTest, ScopeMeasuresItsDuration) {
+    const uint64_t before = Tracer::Now();
+    {
+        TraceScope scope("test", "sleep");
+        scope.SetArg(42);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    const auto events = Tracer::Events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].phase, 'X');
+    EXPECT_EQ(events[0].arg, 42u);
+    EXPECT_GE(events[0].timestamp, before);
+    EXPECT_GT(events[0].duration, 0u);
+    EXPECT_LE(events[0].timestamp + events[0].duration, Tracer::Now());
+}
+
+TEST_F(TraceTest, RingKeepsTheNewestEvents) {
+    const uint64_t total = Tracer::BUFFER_EVENTS + 100;
+    for (uint64_t i = 0; i < total; i++) {
+        Tracer::Instant("test", "tick", i);
+    }
+    const auto events = Tracer::Events();
+    ASSERT_EQ(events.size(), Tracer::BUFFER_EVENTS);
+    EXPECT_EQ(events.front().arg, 100u);
+    EXPECT_EQ(events.back().arg, total - 1);
+}
+
+TEST_F(TraceTest, ThreadsRecordIntoTheirOwnBuffers) {
+    const uint64_t per_thread = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            for (uint64_t i = 0; i < per_thread; i++) {
+                Tracer::Instant("test", "concurrent", i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(CountNamed("concurrent"), 4 * per_thread);
+}
+
+TEST_F(TraceTest, ExportsChromeTraceJson) {
+    Tracer::SetThreadName("main");
+    Tracer::AsyncBegin("pipeline", "pipeline", 0x10);
+    { TraceScope scope("io", "read", 4096); }
+    Tracer::AsyncEnd("pipeline", "pipeline", 0x10);
+    Tracer::Instant("scheduler", "steal", 7);
+
+    const std::string json = Tracer::ToChromeJson();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"ph\":\"M\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"main\"}"), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"read\",\"cat\":\"io\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"arg\":4096}"), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"b\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"e\""), std::string::npos);
+    EXPECT_NE(json.find("\"id\":\"0x10\""), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"steal\",\"cat\":\"scheduler\",\"ph\":\"i\""),
+              std::string::npos);
+    EXPECT_EQ(json.substr(json.size() - 2), "]}");
+}
+
+#ifdef TRACING_ENABLED
+TEST_F(TraceTest, MacrosRecordWhenCompiledIn) {
+    { TRACE_SCOPE("test", "macro_scope", 1); }
+    TRACE_INSTANT("test", "macro_instant", 2);
+    EXPECT_EQ(CountNamed("macro_scope"), 1u);
+    EXPECT_EQ(CountNamed("macro_instant"), 1u);
+}
+#endif
+} // namespace electricdb
\ No newline at end of file
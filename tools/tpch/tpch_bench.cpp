@@ -0,0 +1,276 @@
+/**
+ * @brief End-to-end benchmark over generated TPC-H-like data.
+ *
+ * Generates the database in memory, runs every query of the fixed set once to warm up and then
+ * --repeat times, and reports per query the latency percentiles, rows scanned per second and the
+ * peak memory the query used on top of the resident database. With --baseline it compares the
+ * median latencies against a file written earlier by --save-baseline and exits with status 1 if
+ * any query got slower than the tolerance allows.
+ *
+ * With --write it instead streams the database into one column file per table in DIR and reports
+ * the size of the files and the peak memory of the generator.
+ *
+ * Usage: tpch_bench [--sf=0.1] [--repeat=10] [--threads=0] [--query=NAME] [--tolerance=0.10]
+ *                   [--baseline=FILE] [--save-baseline=FILE] [--write=DIR]
+ */
+
+#include "tpch_gen.h"
+#include "tpch_queries.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+using namespace electricdb;
+
+struct Options {
+	double scale_factor = 0.1;
+	int repeat = 10;
+	uint32_t threads = 0;
+	double tolerance = 0.10;
+	std::string query;
+	std::string baseline;
+	std::string save_baseline;
+	std::string write;
+};
+
+/**
+ * @brief Summary of the runs of one query
+ *
+ */
+struct QueryStats {
+	double p50_ms = 0;
+	double p90_ms = 0;
+	double p99_ms = 0;
+	double max_ms = 0;
+	double rows_per_sec = 0;
+	double peak_mb = 0;
+};
+
+static void Usage() {
+	std::fprintf(stderr, "usage: tpch_bench [--sf=0.1] [--repeat=10] [--threads=0] [--query=NAME]"
+						 " [--tolerance=0.10] [--baseline=FILE] [--save-baseline=FILE]"
+						 " [--write=DIR]\n");
+}
+
+static bool ParseOptions(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		const char *value = std::strchr(arg, '=');
+		if (std::strncmp(arg, "--", 2) != 0 || !value)
+			return false;
+		const std::string key(arg + 2, value++);
+		if (key == "sf")
+			options.scale_factor = std::atof(value);
+		else if (key == "repeat")
+			options.repeat = std::max(1, std::atoi(value));
+		else if (key == "threads")
+			options.threads = static_cast<uint32_t>(std::atoi(value));
+		else if (key == "tolerance")
+			options.tolerance = std::atof(value);
+		else if (key == "query")
+			options.query = value;
+		else if (key == "baseline")
+			options.baseline = value;
+		else if (key == "save-baseline")
+			options.save_baseline = value;
+		else if (key == "write")
+			options.write = value;
+		else
+			return false;
+	}
+	return options.scale_factor > 0;
+}
+
+/** @brief Forget the peak resident set size so far, false if the kernel does not support it */
+static bool ResetPeakMemory() {
+	std::ofstream clear_refs("/proc/self/clear_refs");
+	clear_refs << "5";
+	clear_refs.flush();
+	return static_cast<bool>(clear_refs);
+}
+
+/** @brief Field `field` (e.g. "VmHWM:") of /proc/self/status in MB, negative if it is missing */
+static double StatusMB(const char *field) {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.rfind(field, 0) == 0)
+			return std::atof(line.c_str() + std::strlen(field)) / 1024.0;
+	}
+	return -1;
+}
+
+/** @brief Peak resident set size in MB, since the last ResetPeakMemory() if it succeeded */
+static double PeakMemoryMB() {
+	const double peak = StatusMB("VmHWM:");
+	if (peak >= 0)
+		return peak;
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+/** @brief Current resident set size in MB */
+static double ResidentMemoryMB() { return std::max(0.0, StatusMB("VmRSS:")); }
+
+/** @brief Nearest-rank percentile of sorted `values` */
+static double Percentile(const std::vector<double> &values, double percentile) {
+	const auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * values.size()));
+	return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+}
+
+static QueryStats RunQuery(const TpchQuery &query, const TpchDatabase &db, Scheduler &scheduler,
+						   int repeat) {
+	const TpchRun warmup = query.run(db, scheduler);
+	std::vector<double> latencies;
+	QueryStats stats;
+
+	for (int i = 0; i < repeat; i++) {
+		/** The database and the scheduler stay resident, only count what the query adds */
+		ResetPeakMemory();
+		const double resident = ResidentMemoryMB();
+		const auto start = std::chrono::steady_clock::now();
+		const TpchRun run = query.run(db, scheduler);
+		const auto end = std::chrono::steady_clock::now();
+		latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+		stats.peak_mb = std::max(stats.peak_mb, PeakMemoryMB() - resident);
+
+		/** Parallel floating point sums may differ in the last bits, nothing more */
+		const double drift = std::abs(run.checksum - warmup.checksum);
+		if (run.rows_out != warmup.rows_out || drift > 1e-9 * std::abs(warmup.checksum) + 1e-6) {
+			std::fprintf(stderr, "%s: result changed between runs!\n", query.name);
+			std::exit(1);
+		}
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	stats.p50_ms = Percentile(latencies, 50);
+	stats.p90_ms = Percentile(latencies, 90);
+	stats.p99_ms = Percentile(latencies, 99);
+	stats.max_ms = latencies.back();
+	stats.rows_per_sec = static_cast<double>(warmup.rows_scanned) / (stats.p50_ms / 1000.0);
+	std::printf("%-6s %-20s %10llu %10.2f %10.2f %10.2f %10.2f %12.1f %10.1f\n", query.name,
+				query.description, static_cast<unsigned long long>(warmup.rows_out), stats.p50_ms,
+				stats.p90_ms, stats.p99_ms, stats.max_ms, stats.rows_per_sec / 1e6, stats.peak_mb);
+	return stats;
+}
+
+static void SaveBaseline(const std::string &path, double scale_factor,
+						 const std::map<std::string, QueryStats> &results) {
+	std::ofstream out(path);
+	out << "# electricdb tpch_bench baseline: query p50_ms p90_ms rows_per_sec peak_mb\n";
+	out << "sf " << scale_factor << "\n";
+	for (const auto &[name, stats] : results)
+		out << name << ' ' << stats.p50_ms << ' ' << stats.p90_ms << ' ' << stats.rows_per_sec
+			<< ' ' << stats.peak_mb << "\n";
+	if (!out)
+		throw std::runtime_error("Failed to write baseline " + path + "!");
+}
+
+/**
+ * @brief Compare median latencies against the baseline at `path`
+ *
+ * @return int Number of queries slower than the baseline by more than `tolerance`
+ */
+static int CompareBaseline(const std::string &path, double scale_factor, double tolerance,
+						   const std::map<std::string, QueryStats> &results) {
+	std::ifstream in(path);
+	if (!in)
+		throw std::runtime_error("Failed to read baseline " + path + "!");
+
+	std::printf("\n%-6s %12s %12s %9s\n", "query", "base_p50", "p50", "change");
+	int regressions = 0;
+	std::string line;
+	while (std::getline(in, line)) {
+		if (line.empty() || line[0] == '#')
+			continue;
+		std::istringstream fields(line);
+		std::string name;
+		fields >> name;
+		if (name == "sf") {
+			double baseline_sf = 0;
+			fields >> baseline_sf;
+			if (std::abs(baseline_sf - scale_factor) > 1e-9)
+				throw std::runtime_error("Baseline was recorded at a different scale factor!");
+			continue;
+		}
+
+		QueryStats baseline;
+		fields >> baseline.p50_ms >> baseline.p90_ms >> baseline.rows_per_sec >> baseline.peak_mb;
+		auto it = results.find(name);
+		if (it == results.end() || baseline.p50_ms <= 0)
+			continue;
+
+		const double change = it->second.p50_ms / baseline.p50_ms - 1.0;
+		const bool regressed = change > tolerance;
+		regressions += regressed ? 1 : 0;
+		std::printf("%-6s %12.2f %12.2f %+8.1f%% %s\n", name.c_str(), baseline.p50_ms,
+					it->second.p50_ms, change * 100.0, regressed ? "REGRESSION" : "ok");
+	}
+	return regressions;
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		Usage();
+		return 2;
+	}
+
+	try {
+		if (!options.write.empty()) {
+			ResetPeakMemory();
+			const auto start = std::chrono::steady_clock::now();
+			const uint64_t bytes = WriteTpch(options.write, options.scale_factor);
+			const auto end = std::chrono::steady_clock::now();
+			std::printf("sf=%g files=%.1fMB written to %s in %.0fms, generator peak %.1fMB\n",
+						options.scale_factor, static_cast<double>(bytes) / (1 << 20),
+						options.write.c_str(),
+						std::chrono::duration<double, std::milli>(end - start).count(),
+						PeakMemoryMB());
+			return 0;
+		}
+
+		Scheduler scheduler(options.threads);
+		TpchDatabase db;
+		ResetPeakMemory();
+		const auto start = std::chrono::steady_clock::now();
+		GenerateTpch(db, options.scale_factor);
+		const auto end = std::chrono::steady_clock::now();
+		std::printf("sf=%g threads=%u repeat=%d lineitem=%llu rows data=%.1fMB generated in "
+					"%.0fms, generator peak %.1fMB\n\n",
+					options.scale_factor, scheduler.WorkerCount(), options.repeat,
+					static_cast<unsigned long long>(db.lineitem.RowCount()),
+					static_cast<double>(db.DataBytes()) / (1 << 20),
+					std::chrono::duration<double, std::milli>(end - start).count(),
+					PeakMemoryMB());
+
+		std::printf("%-6s %-20s %10s %10s %10s %10s %10s %12s %10s\n", "query", "description",
+					"rows", "p50_ms", "p90_ms", "p99_ms", "max_ms", "Mrows/s", "peak_mb");
+		std::map<std::string, QueryStats> results;
+		for (const auto &query : TpchQueries()) {
+			if (options.query.empty() || options.query == query.name)
+				results[query.name] = RunQuery(query, db, scheduler, options.repeat);
+		}
+
+		if (!options.save_baseline.empty())
+			SaveBaseline(options.save_baseline, options.scale_factor, results);
+		if (!options.baseline.empty() &&
+			CompareBaseline(options.baseline, options.scale_factor, options.tolerance, results) > 0)
+			return 1;
+	} catch (const std::exception &e) {
+		std::fprintf(stderr, "tpch_bench: %s\n", e.what());
+		return 2;
+	}
+	return 0;
+}
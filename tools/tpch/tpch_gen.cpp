@@ -0,0 +1,225 @@
+#include "tpch_gen.h"
+
+#include "electricdb/storage/format/column_file.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+namespace electricdb {
+
+uint32_t TpchTable::ColumnIndex(const std::string &column) const {
+	for (uint32_t i = 0; i < column_names.size(); i++) {
+		if (column_names[i] == column)
+			return i;
+	}
+	throw std::runtime_error("Unknown column " + column + " in table " + name + "!");
+}
+
+uint64_t TpchTable::DataBytes() const noexcept {
+	uint64_t bytes = 0;
+	for (const auto &column : columns)
+		bytes += uint64_t(column.Size()) * GetTypeSize(column.Type());
+	return bytes;
+}
+
+/**
+ * @brief Give `table` the columns `names` of `types`, each sized to `rows`
+ *
+ */
+static void InitTable(TpchTable &table, const char *name, std::vector<std::string> names,
+					  const std::vector<LogicalType> &types, uint64_t rows) {
+	if (rows > UINT32_MAX)
+		throw std::runtime_error("Scale factor too large for a single in-memory table!");
+	table.name = name;
+	table.column_names = std::move(names);
+	for (auto type : types) {
+		Vector &column = table.columns.emplace_back(type, static_cast<uint32_t>(rows), table.arena);
+		column.SetSize(static_cast<uint32_t>(rows));
+	}
+}
+
+/**
+ * @brief Fills the rows of one table batch by batch, handing every full batch to `flush`
+ *
+ * Without `flush` the table is sized to all of its rows and keeps them.
+ */
+class TableBatch {
+  public:
+	TableBatch(TpchTable &table, const TpchFlush *flush)
+		: table_(table), flush_(flush), capacity_(table.columns[0].Capacity()) {}
+
+	/** @brief Row of the table to write the next generated row to */
+	uint32_t Next() {
+		if (size_ == capacity_)
+			Flush();
+		return size_++;
+	}
+
+	/** @brief Hand the rows generated since the last flush over */
+	void Flush() {
+		if (size_ == 0)
+			return;
+		for (auto &column : table_.columns)
+			column.SetSize(size_);
+		if (flush_)
+			(*flush_)(table_);
+		size_ = 0;
+	}
+
+  private:
+	TpchTable &table_;
+	const TpchFlush *flush_;
+	uint32_t capacity_;
+	uint32_t size_ = 0;
+};
+
+/** @brief Retail price of a part in TPC-H, in dollars */
+static double PartPrice(int32_t partkey) {
+	return (90000 + (partkey / 10) % 20001 + 100 * (partkey % 1000)) / 100.0;
+}
+
+/**
+ * @brief Generate the database at `scale_factor` into tables of at most `batch_rows` rows
+ *
+ */
+static void Generate(TpchDatabase &db, double scale_factor, uint64_t seed, uint64_t batch_rows,
+					 const TpchFlush *flush) {
+	if (scale_factor <= 0)
+		throw std::runtime_error("Scale factor must be positive!");
+
+	std::mt19937_64 rng(seed);
+	auto uniform = [&](int64_t low, int64_t high) {
+		return low + static_cast<int64_t>(rng() % static_cast<uint64_t>(high - low + 1));
+	};
+
+	const auto customers = std::max<uint64_t>(1, static_cast<uint64_t>(150000 * scale_factor));
+	const auto orders = std::max<uint64_t>(1, static_cast<uint64_t>(1500000 * scale_factor));
+	const auto parts = std::max<int64_t>(1, static_cast<int64_t>(200000 * scale_factor));
+	const auto suppliers = std::max<int64_t>(1, static_cast<int64_t>(10000 * scale_factor));
+
+	InitTable(db.customer, "customer", {"c_custkey", "c_nationkey", "c_acctbal", "c_mktsegment"},
+			  {LogicalType::INT32, LogicalType::INT32, LogicalType::DOUBLE, LogicalType::INT32},
+			  std::min(customers, batch_rows));
+	TableBatch customer(db.customer, flush);
+	auto *c_custkey = db.customer.columns[0].Data<int32_t>();
+	auto *c_nationkey = db.customer.columns[1].Data<int32_t>();
+	auto *c_acctbal = db.customer.columns[2].Data<double>();
+	auto *c_mktsegment = db.customer.columns[3].Data<int32_t>();
+	for (uint64_t i = 0; i < customers; i++) {
+		const uint32_t row = customer.Next();
+		c_custkey[row] = static_cast<int32_t>(i + 1);
+		c_nationkey[row] = static_cast<int32_t>(uniform(0, 24));
+		c_acctbal[row] = static_cast<double>(uniform(-99999, 999999)) / 100.0;
+		c_mktsegment[row] = static_cast<int32_t>(uniform(0, TPCH_SEGMENTS - 1));
+	}
+	customer.Flush();
+
+	/** Between 1 and 7 line items per order, the line item count is only known afterwards */
+	std::vector<uint8_t> lines(orders);
+	uint64_t lineitems = 0;
+	for (auto &count : lines) {
+		count = static_cast<uint8_t>(uniform(1, 7));
+		lineitems += count;
+	}
+
+	InitTable(db.orders, "orders",
+			  {"o_orderkey", "o_custkey", "o_orderdate", "o_totalprice", "o_orderpriority"},
+			  {LogicalType::INT64, LogicalType::INT32, LogicalType::INT32, LogicalType::DOUBLE,
+			   LogicalType::INT32},
+			  std::min(orders, batch_rows));
+	InitTable(db.lineitem, "lineitem",
+			  {"l_orderkey", "l_partkey", "l_suppkey", "l_quantity", "l_extendedprice",
+			   "l_discount", "l_tax", "l_returnflag", "l_linestatus", "l_shipdate"},
+			  {LogicalType::INT64, LogicalType::INT32, LogicalType::INT32, LogicalType::INT32,
+			   LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::INT32,
+			   LogicalType::INT32, LogicalType::INT32},
+			  std::min(lineitems, batch_rows));
+	TableBatch order_batch(db.orders, flush);
+	TableBatch line_batch(db.lineitem, flush);
+
+	auto &o = db.orders.columns;
+	auto &l = db.lineitem.columns;
+	for (uint64_t i = 0; i < orders; i++) {
+		const auto orderkey = static_cast<int64_t>(i + 1);
+		const auto orderdate = static_cast<int32_t>(uniform(TPCH_START_DATE, TPCH_END_DATE - 151));
+		double total = 0;
+
+		for (uint8_t j = 0; j < lines[i]; j++) {
+			const auto partkey = static_cast<int32_t>(uniform(1, parts));
+			const auto quantity = static_cast<int32_t>(uniform(1, 50));
+			const double price = quantity * PartPrice(partkey);
+			const double discount = static_cast<double>(uniform(0, 10)) / 100.0;
+			const double tax = static_cast<double>(uniform(0, 8)) / 100.0;
+			const auto shipdate = static_cast<int32_t>(orderdate + uniform(1, 121));
+			const auto receiptdate = static_cast<int32_t>(shipdate + uniform(1, 30));
+
+			const uint32_t line = line_batch.Next();
+			l[0].Data<int64_t>()[line] = orderkey;
+			l[1].Data<int32_t>()[line] = partkey;
+			l[2].Data<int32_t>()[line] = static_cast<int32_t>(uniform(1, suppliers));
+			l[3].Data<int32_t>()[line] = quantity;
+			l[4].Data<double>()[line] = price;
+			l[5].Data<double>()[line] = discount;
+			l[6].Data<double>()[line] = tax;
+			l[7].Data<int32_t>()[line] =
+					receiptdate <= TPCH_CURRENT_DATE
+							? (uniform(0, 1) ? RETURN_FLAG_R : RETURN_FLAG_A)
+							: RETURN_FLAG_N;
+			l[8].Data<int32_t>()[line] = shipdate > TPCH_CURRENT_DATE ? 1 : 0;
+			l[9].Data<int32_t>()[line] = shipdate;
+			total += price * (1 + tax) * (1 - discount);
+		}
+
+		const uint32_t row = order_batch.Next();
+		o[0].Data<int64_t>()[row] = orderkey;
+		o[1].Data<int32_t>()[row] =
+				static_cast<int32_t>(uniform(1, static_cast<int64_t>(customers)));
+		o[2].Data<int32_t>()[row] = orderdate;
+		o[3].Data<double>()[row] = total;
+		o[4].Data<int32_t>()[row] = static_cast<int32_t>(uniform(0, TPCH_PRIORITIES - 1));
+	}
+	order_batch.Flush();
+	line_batch.Flush();
+}
+
+void GenerateTpch(TpchDatabase &db, double scale_factor, uint64_t seed) {
+	Generate(db, scale_factor, seed, UINT64_MAX, nullptr);
+}
+
+std::string TpchTablePath(const std::string &directory, const std::string &table) {
+	return directory + "/" + table + ".edb";
+}
+
+uint64_t WriteTpch(const std::string &directory, double scale_factor, uint64_t seed) {
+	std::map<std::string, std::unique_ptr<ColumnFileWriter>> writers;
+	const TpchFlush flush = [&](TpchTable &table) {
+		auto &writer = writers[table.name];
+		if (!writer) {
+			std::vector<ColumnSchema> schema;
+			for (size_t c = 0; c < table.columns.size(); c++)
+				schema.push_back({table.column_names[c], table.columns[c].Type()});
+			writer = std::make_unique<ColumnFileWriter>(TpchTablePath(directory, table.name),
+														std::move(schema));
+			for (idx_t c = 0; c < table.columns.size(); c++)
+				writer->SetAdaptiveEncoding(c);
+		}
+		writer->Append(table.columns);
+	};
+
+	/** Only one row group per table is held in memory at a time */
+	TpchDatabase batches;
+	Generate(batches, scale_factor, seed, DEFAULT_ROW_GROUP_SIZE, &flush);
+
+	uint64_t bytes = 0;
+	for (auto &[name, writer] : writers) {
+		writer->Finish();
+		bytes += std::filesystem::file_size(TpchTablePath(directory, name));
+	}
+	return bytes;
+}
+
+} // namespace electricdb
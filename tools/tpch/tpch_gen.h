@@ -0,0 +1,98 @@
+#pragma once
+
+#include "electricdb/execution/vector/vector.h"
+#include "electricdb/util/arena.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace electricdb {
+
+/**
+ * @brief A generated table: named columns held fully in memory
+ *
+ */
+struct TpchTable {
+	std::string name;
+	std::vector<std::string> column_names;
+	/** @brief Backs the column data, declared before `columns` so it outlives them */
+	Arena arena;
+	std::vector<Vector> columns;
+
+	/** @brief Index of the column called `column`, throws if there is none */
+	uint32_t ColumnIndex(const std::string &column) const;
+
+	uint64_t RowCount() const noexcept { return columns.empty() ? 0 : columns[0].Size(); }
+
+	/** @brief Bytes of column data, excluding null masks */
+	uint64_t DataBytes() const noexcept;
+};
+
+/**
+ * @brief The tables of a TPC-H-like schema.
+ *
+ * The shape follows TPC-H (cardinalities per scale factor, value domains and the correlations
+ * between dates, flags and prices) with fixed-width columns only: dates are days since
+ * 1970-01-01 and the short categorical strings (flags, segments, priorities) are small integer
+ * codes. Comment, name and address columns are left out.
+ */
+struct TpchDatabase {
+	/** @brief c_custkey, c_nationkey, c_acctbal, c_mktsegment */
+	TpchTable customer;
+	/** @brief o_orderkey, o_custkey, o_orderdate, o_totalprice, o_orderpriority */
+	TpchTable orders;
+	/**
+	 * @brief l_orderkey, l_partkey, l_suppkey, l_quantity, l_extendedprice, l_discount, l_tax,
+	 * l_returnflag, l_linestatus, l_shipdate
+	 */
+	TpchTable lineitem;
+
+	uint64_t DataBytes() const noexcept {
+		return customer.DataBytes() + orders.DataBytes() + lineitem.DataBytes();
+	}
+};
+
+/** @brief Day numbers (since 1970-01-01) of dates used by the generator and the queries */
+constexpr int32_t TPCH_START_DATE = 8035; // 1992-01-01
+constexpr int32_t TPCH_CURRENT_DATE = 9298; // 1995-06-17
+constexpr int32_t TPCH_END_DATE = 10591; // 1998-12-31
+
+/** @brief Codes of l_returnflag */
+enum TpchReturnFlag : int32_t { RETURN_FLAG_A, RETURN_FLAG_N, RETURN_FLAG_R };
+
+/** @brief Number of distinct c_mktsegment and o_orderpriority codes */
+constexpr int32_t TPCH_SEGMENTS = 5;
+constexpr int32_t TPCH_PRIORITIES = 5;
+
+/**
+ * @brief Generate the database at `scale_factor`
+ *
+ * Scale factor 1 has 150,000 customers, 1,500,000 orders and about 6,000,000 line items. The
+ * output only depends on the scale factor and `seed`.
+ *
+ * @param db Database to fill, its tables must be empty
+ * @param scale_factor Size relative to TPC-H scale factor 1, e.g. 0.01 or 10
+ * @param seed Seed of the random generator
+ */
+void GenerateTpch(TpchDatabase &db, double scale_factor, uint64_t seed = 42);
+
+/** @brief Receives a batch of generated rows of one table */
+using TpchFlush = std::function<void(TpchTable &table)>;
+
+/** @brief Path of the column file `table` is written to in `directory` */
+std::string TpchTablePath(const std::string &directory, const std::string &table);
+
+/**
+ * @brief Generate the database at `scale_factor` as one column file per table in `directory`
+ *
+ * Rows are generated one row group at a time and appended to a ColumnFileWriter with adaptive
+ * encoding, so memory stays at a row group per table (and a byte per order) whatever the scale
+ * factor. The rows are the ones GenerateTpch produces with the same seed.
+ *
+ * @return uint64_t Bytes of the written files
+ */
+uint64_t WriteTpch(const std::string &directory, double scale_factor, uint64_t seed = 42);
+
+} // namespace electricdb
@@ -0,0 +1,277 @@
+#include "tpch_queries.h"
+
+#include "electricdb/execution/engine/pipeline_builder.h"
+#include "electricdb/execution/expressions/binary_expression.h"
+#include "electricdb/execution/expressions/leaf_expression.h"
+#include "electricdb/execution/operators/aggregate/hash_aggregate.h"
+#include "electricdb/execution/operators/filter/filter.h"
+#include "electricdb/execution/operators/join/join.h"
+#include "electricdb/execution/operators/out/out.h"
+#include "electricdb/execution/operators/projection/projection.h"
+#include "electricdb/execution/operators/scan/scan.h"
+#include "electricdb/execution/operators/sort/physical_sort.h"
+
+#include <initializer_list>
+#include <stdexcept>
+
+namespace electricdb {
+
+RangePredicate::RangePredicate(std::vector<ColumnRange> ranges) : ranges_(std::move(ranges)) {
+	if (ranges_.empty())
+		throw std::runtime_error("RangePredicate needs at least one range!");
+}
+
+template <typename T>
+static void AndRange(const Vector &column, const ColumnRange &range, bool *out, idx_t count) {
+	const T *values = column.Data<T>();
+	for (idx_t i = 0; i < count; i++) {
+		const auto value = static_cast<double>(values[i]);
+		out[i] = out[i] && value >= range.low && value <= range.high;
+	}
+	if (column.HasNulls()) {
+		for (idx_t i = 0; i < count; i++)
+			out[i] = out[i] && !column.IsNull(i);
+	}
+}
+
+void RangePredicate::Execute(ExecutionContext &ctx, Vector &result) {
+	const auto &input = *ctx.Input();
+	const idx_t count = result.Size();
+	bool *out = result.Data<bool>();
+	result.ClearNulls();
+	std::fill(out, out + count, true);
+
+	for (const auto &range : ranges_) {
+		const Vector &column = input[range.column_idx];
+		switch (column.Type()) {
+		case LogicalType::INT32:
+			AndRange<int32_t>(column, range, out, count);
+			break;
+		case LogicalType::INT64:
+			AndRange<int64_t>(column, range, out, count);
+			break;
+		case LogicalType::FLOAT:
+			AndRange<float>(column, range, out, count);
+			break;
+		case LogicalType::DOUBLE:
+			AndRange<double>(column, range, out, count);
+			break;
+		default:
+			throw std::runtime_error("RangePredicate supports numeric columns only!");
+		}
+	}
+}
+
+/**
+ * @brief Zero-copy views of the columns `names` of `table`, in that order
+ *
+ */
+static std::vector<Vector> Columns(const TpchTable &table,
+								   std::initializer_list<const char *> names, Arena &arena) {
+	std::vector<Vector> columns;
+	for (const char *name : names) {
+		const Vector &column = table.columns[table.ColumnIndex(name)];
+		columns.emplace_back(column.Type(), 0, arena).Reference(column);
+	}
+	return columns;
+}
+
+/** @brief Sum of every value of the result, the same for any order of the rows */
+static double Checksum(const PhysicalResultCollector &result) {
+	double sum = 0;
+	for (size_t c = 0; c < result.ChunkCount(); c++) {
+		for (const auto &column : result.Chunk(c)) {
+			for (idx_t i = 0; i < column.Size(); i++) {
+				if (column.IsNull(i))
+					continue;
+				switch (column.Type()) {
+				case LogicalType::INT32:
+					sum += column.Data<int32_t>()[i];
+					break;
+				case LogicalType::INT64:
+					sum += static_cast<double>(column.Data<int64_t>()[i]);
+					break;
+				case LogicalType::DOUBLE:
+					sum += column.Data<double>()[i];
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+	return sum;
+}
+
+static TpchRun Finish(PhysicalResultCollector &result, Scheduler &scheduler, uint64_t scanned) {
+	PipelineBuilder(result).Execute(scheduler);
+	return {scanned, result.Count(), Checksum(result)};
+}
+
+/**
+ * @brief Pricing summary (TPC-H Q1): aggregates most of lineitem into 4 groups
+ *
+ */
+static TpchRun PricingSummary(const TpchDatabase &db, Scheduler &scheduler) {
+	Arena arena;
+	const auto columns = Columns(db.lineitem,
+								 {"l_returnflag", "l_linestatus", "l_quantity", "l_extendedprice",
+								  "l_discount", "l_shipdate"},
+								 arena);
+	PhysicalColumnScan scan(columns);
+	RangePredicate shipped({{5, -1e300, 10471}}); // 1998-09-02
+	PhysicalFilter filter(scan.Types(), &shipped);
+	filter.AddChild(&scan);
+	PhysicalHashAggregate aggregate(filter.Types(), {0, 1},
+									{{AggregateType::SUM, 2},
+									 {AggregateType::SUM, 3},
+									 {AggregateType::AVG, 4},
+									 {AggregateType::COUNT_STAR}});
+	aggregate.AddChild(&filter);
+	PhysicalSort sort(aggregate.Types(), {{0}, {1}});
+	sort.AddChild(&aggregate);
+	PhysicalResultCollector result(sort.Types());
+	result.AddChild(&sort);
+	return Finish(result, scheduler, db.lineitem.RowCount());
+}
+
+/**
+ * @brief Forecasting revenue change (TPC-H Q6): a selective scan into one SUM
+ *
+ */
+static TpchRun RevenueChange(const TpchDatabase &db, Scheduler &scheduler) {
+	Arena arena;
+	const auto columns = Columns(
+			db.lineitem, {"l_shipdate", "l_discount", "l_quantity", "l_extendedprice"}, arena);
+	PhysicalColumnScan scan(columns);
+	RangePredicate predicate({{0, 8766, 9130}, {1, 0.05, 0.07}, {2, -1e300, 23}}); // 1994
+	PhysicalFilter filter(scan.Types(), &predicate);
+	filter.AddChild(&scan);
+	ColumnExpr price(3, LogicalType::DOUBLE);
+	ColumnExpr discount(1, LogicalType::DOUBLE);
+	MultExpr revenue(&price, &discount);
+	PhysicalProjection projection({&revenue});
+	projection.AddChild(&filter);
+	PhysicalHashAggregate aggregate(projection.Types(), {}, {{AggregateType::SUM, 0}});
+	aggregate.AddChild(&projection);
+	PhysicalResultCollector result(aggregate.Types());
+	result.AddChild(&aggregate);
+	return Finish(result, scheduler, db.lineitem.RowCount());
+}
+
+/**
+ * @brief Shipping priority (TPC-H Q3): lineitem joined with orders and customers, grouped by
+ * order and sorted by revenue
+ *
+ */
+static TpchRun ShippingPriority(const TpchDatabase &db, Scheduler &scheduler) {
+	Arena arena;
+	const int32_t date = 9204; // 1995-03-15
+
+	const auto customer = Columns(db.customer, {"c_custkey", "c_mktsegment"}, arena);
+	PhysicalColumnScan customer_scan(customer);
+	RangePredicate segment({{1, 1, 1}});
+	PhysicalFilter customer_filter(customer_scan.Types(), &segment);
+	customer_filter.AddChild(&customer_scan);
+
+	const auto orders = Columns(db.orders, {"o_orderkey", "o_custkey", "o_orderdate"}, arena);
+	PhysicalColumnScan orders_scan(orders);
+	RangePredicate ordered({{2, -1e300, date - 1}});
+	PhysicalFilter orders_filter(orders_scan.Types(), &ordered);
+	orders_filter.AddChild(&orders_scan);
+
+	const auto lineitem = Columns(
+			db.lineitem, {"l_orderkey", "l_extendedprice", "l_discount", "l_shipdate"}, arena);
+	PhysicalColumnScan lineitem_scan(lineitem);
+	RangePredicate shipped({{3, date + 1, 1e300}});
+	PhysicalFilter lineitem_filter(lineitem_scan.Types(), &shipped);
+	lineitem_filter.AddChild(&lineitem_scan);
+
+	/** l_orderkey, l_extendedprice, l_discount, l_shipdate, o_orderkey, o_custkey, o_orderdate */
+	PhysicalHashJoin order_join(lineitem_filter.Types(), orders_filter.Types(), {0}, {0});
+	order_join.AddChild(&lineitem_filter);
+	order_join.AddChild(&orders_filter);
+	/** ... then c_custkey, c_mktsegment */
+	PhysicalHashJoin customer_join(order_join.Types(), customer_filter.Types(), {5}, {0});
+	customer_join.AddChild(&order_join);
+	customer_join.AddChild(&customer_filter);
+
+	ColumnExpr orderkey(0, LogicalType::INT64);
+	ColumnExpr orderdate(6, LogicalType::INT32);
+	ColumnExpr price(1, LogicalType::DOUBLE);
+	ColumnExpr discount(2, LogicalType::DOUBLE);
+	Value one;
+	one.SetType(LogicalType::DOUBLE);
+	one.Set(1.0);
+	ConstantExpr constant(one);
+	SubExpr keep(&constant, &discount);
+	MultExpr revenue(&price, &keep);
+	PhysicalProjection projection({&orderkey, &orderdate, &revenue});
+	projection.AddChild(&customer_join);
+
+	PhysicalHashAggregate aggregate(projection.Types(), {0, 1}, {{AggregateType::SUM, 2}});
+	aggregate.AddChild(&projection);
+	PhysicalSort sort(aggregate.Types(), {{2, OrderType::DESCENDING}, {1}});
+	sort.AddChild(&aggregate);
+	PhysicalResultCollector result(sort.Types());
+	result.AddChild(&sort);
+	return Finish(result, scheduler,
+				  db.customer.RowCount() + db.orders.RowCount() + db.lineitem.RowCount());
+}
+
+/**
+ * @brief Order priority counts over the line items of one year (after TPC-H Q4/Q12): a
+ * selective probe into a join built over all orders
+ *
+ */
+static TpchRun PriorityCount(const TpchDatabase &db, Scheduler &scheduler) {
+	Arena arena;
+	const auto orders = Columns(db.orders, {"o_orderkey", "o_orderpriority"}, arena);
+	PhysicalColumnScan orders_scan(orders);
+
+	const auto lineitem = Columns(db.lineitem, {"l_orderkey", "l_shipdate"}, arena);
+	PhysicalColumnScan lineitem_scan(lineitem);
+	RangePredicate year({{1, 8766, 9130}}); // 1994
+	PhysicalFilter lineitem_filter(lineitem_scan.Types(), &year);
+	lineitem_filter.AddChild(&lineitem_scan);
+
+	PhysicalHashJoin join(lineitem_filter.Types(), orders_scan.Types(), {0}, {0});
+	join.AddChild(&lineitem_filter);
+	join.AddChild(&orders_scan);
+	PhysicalHashAggregate aggregate(join.Types(), {3}, {{AggregateType::COUNT_STAR}});
+	aggregate.AddChild(&join);
+	PhysicalSort sort(aggregate.Types(), {{0}});
+	sort.AddChild(&aggregate);
+	PhysicalResultCollector result(sort.Types());
+	result.AddChild(&sort);
+	return Finish(result, scheduler, db.orders.RowCount() + db.lineitem.RowCount());
+}
+
+/**
+ * @brief Quantity per part: a GROUP BY with as many groups as there are parts
+ *
+ */
+static TpchRun PartVolume(const TpchDatabase &db, Scheduler &scheduler) {
+	Arena arena;
+	const auto columns = Columns(db.lineitem, {"l_partkey", "l_quantity"}, arena);
+	PhysicalColumnScan scan(columns);
+	PhysicalHashAggregate aggregate(scan.Types(), {0},
+									{{AggregateType::SUM, 1}, {AggregateType::COUNT_STAR}});
+	aggregate.AddChild(&scan);
+	PhysicalResultCollector result(aggregate.Types());
+	result.AddChild(&aggregate);
+	return Finish(result, scheduler, db.lineitem.RowCount());
+}
+
+const std::vector<TpchQuery> &TpchQueries() {
+	static const std::vector<TpchQuery> queries = {
+			{"Q1", "pricing summary", PricingSummary},
+			{"Q3", "shipping priority", ShippingPriority},
+			{"Q6", "revenue change", RevenueChange},
+			{"Q12", "priority count", PriorityCount},
+			{"QAGG", "part volume", PartVolume},
+	};
+	return queries;
+}
+
+} // namespace electricdb
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "tpch_gen.h"
+
+#include "electricdb/execution/engine/scheduler.h"
+#include "electricdb/execution/expressions/expression.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace electricdb {
+
+/** @brief Closed range a numeric column must fall into, null never does */
+struct ColumnRange {
+	uint32_t column_idx;
+	double low = -std::numeric_limits<double>::infinity();
+	double high = std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief BOOL conjunction of column ranges, e.g. `a BETWEEN 1 AND 5 AND b <= 3`
+ *
+ * The engine has no comparison expressions yet. Every numeric type compares through double,
+ * exact for the integers the generator produces.
+ */
+class RangePredicate final : public Expression {
+  public:
+	explicit RangePredicate(std::vector<ColumnRange> ranges);
+
+	void Execute(ExecutionContext &ctx, Vector &result) override;
+
+	LogicalType Type() const override { return LogicalType::BOOL; }
+
+	void CollectColumns(std::vector<uint32_t> &columns) const override {
+		for (const auto &range : ranges_)
+			columns.push_back(range.column_idx);
+	}
+
+  private:
+	std::vector<ColumnRange> ranges_;
+};
+
+/**
+ * @brief Outcome of one query run
+ *
+ */
+struct TpchRun {
+	/** @brief Rows read by all scans of the query */
+	uint64_t rows_scanned = 0;
+	/** @brief Rows of the query result */
+	uint64_t rows_out = 0;
+	/** @brief Order-independent checksum of the result, equal across runs of the same data */
+	double checksum = 0;
+};
+
+/**
+ * @brief A query of the benchmark, built as a physical plan over the generated tables
+ *
+ */
+struct TpchQuery {
+	const char *name;
+	const char *description;
+	TpchRun (*run)(const TpchDatabase &db, Scheduler &scheduler);
+};
+
+/** @brief The fixed query set, in the order the harness runs it */
+const std::vector<TpchQuery> &TpchQueries();
+
+} // namespace electricdb